@@ -31,7 +31,34 @@ using std::stringstream;
 namespace palo {
 
 FileDownloader::FileDownloader(const FileDownloaderParam& param) :
-        _downloader_param(param) {
+        _downloader_param(param),
+        _max_download_speed_kbps(config::max_download_speed_kbps) {
+}
+
+size_t FileDownloader::_write_range_callback(
+        void* buffer, size_t size, size_t nmemb, void* param) {
+    size_t len = size * nmemb;
+    RangeWriter* writer = static_cast<RangeWriter*>(param);
+    if (writer == NULL) {
+        OLAP_LOG_WARNING("File downloader range writer is NULL pointer.");
+        return 0;
+    }
+
+    // Server not supporting range sends the whole file
+    if (writer->offset + len > writer->end) {
+        OLAP_LOG_WARNING("File downloader received more data than range. "
+                         "[offset=%lu len=%lu end=%lu]",
+                         writer->offset, len, writer->end);
+        return 0;
+    }
+
+    if (writer->file_handler->pwrite(buffer, len, writer->offset) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("File downloader callback write range failed.");
+        return 0;
+    }
+    writer->offset += len;
+
+    return len;
 }
 
 size_t FileDownloader::_write_file_callback(
@@ -148,7 +175,8 @@ AgentStatus FileDownloader::_install_opt(
     // Set max recv speed(bytes/s)
     if (status == PALO_SUCCESS) {
         curl_ret = curl_easy_setopt(
-                curl, CURLOPT_MAX_RECV_SPEED_LARGE, config::max_download_speed_kbps * 1024);
+                curl, CURLOPT_MAX_RECV_SPEED_LARGE,
+                static_cast<curl_off_t>(_max_download_speed_kbps * 1024));
 
         if (curl_ret != CURLE_OK) {
             status = PALO_FILE_DOWNLOAD_INSTALL_OPT_FAILED;
@@ -391,6 +419,90 @@ AgentStatus FileDownloader::download_file() {
     return status;
 }
 
+AgentStatus FileDownloader::download_range(uint64_t offset, uint64_t length) {
+    AgentStatus status = PALO_SUCCESS;
+    CURL* curl = NULL;
+    CURLcode curl_ret = CURLE_OK;
+    curl = curl_easy_init();
+
+    if (curl == NULL) {
+        status = PALO_FILE_DOWNLOAD_CURL_INIT_FAILED;
+        OLAP_LOG_WARNING("internal error to get NULL curl");
+    }
+
+    FileHandler file_handler;
+    if (status == PALO_SUCCESS) {
+        OLAPStatus olap_status = file_handler.open_with_mode(
+                _downloader_param.local_file_path, O_CREAT | O_WRONLY, S_IRUSR | S_IWUSR);
+        if (olap_status != OLAP_SUCCESS) {
+            status = PALO_FILE_DOWNLOAD_INVALID_PARAM;
+            OLAP_LOG_WARNING("open loacal file failed.[file_path=%s]",
+                   _downloader_param.local_file_path.c_str());
+        }
+    }
+
+    char errbuf[CURL_ERROR_SIZE];
+    if (status == PALO_SUCCESS) {
+        status = _install_opt(OutputType::FILE, curl, errbuf, NULL, &file_handler);
+
+        if (PALO_SUCCESS != status) {
+            OLAP_LOG_WARNING("install curl opt failed.");
+        }
+    }
+
+    // Write to the position of range instead of appending
+    RangeWriter writer;
+    writer.file_handler = &file_handler;
+    writer.offset = offset;
+    writer.end = offset + length;
+    stringstream range;
+    range << offset << "-" << offset + length - 1;
+    string range_str = range.str();
+    if (status == PALO_SUCCESS) {
+        if (curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION,
+                             &FileDownloader::_write_range_callback) != CURLE_OK
+                || curl_easy_setopt(curl, CURLOPT_WRITEDATA,
+                                    static_cast<void*>(&writer)) != CURLE_OK
+                || curl_easy_setopt(curl, CURLOPT_RANGE, range_str.c_str()) != CURLE_OK) {
+            status = PALO_FILE_DOWNLOAD_INSTALL_OPT_FAILED;
+            OLAP_LOG_WARNING("curl setopt RANGE failed.[range=%s]", range_str.c_str());
+        }
+    }
+
+    if (status == PALO_SUCCESS) {
+        curl_ret = curl_easy_perform(curl);
+
+        if (curl_ret != CURLE_OK) {
+            status = PALO_FILE_DOWNLOAD_FAILED;
+            OLAP_LOG_WARNING(
+                "curl easy perform failed.[path=%s range=%s]",
+                _downloader_param.remote_file_path.c_str(), range_str.c_str());
+            _get_err_info(errbuf, curl_ret);
+        }
+    }
+
+    // Check every range is complete, so that broken range is retried alone
+    if (status == PALO_SUCCESS) {
+        long response_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+        if (response_code != 206 || writer.offset != writer.end) {
+            status = PALO_FILE_DOWNLOAD_FAILED;
+            OLAP_LOG_WARNING("download range incomplete. "
+                             "[path=%s range=%s response_code=%ld received_end=%lu]",
+                             _downloader_param.remote_file_path.c_str(), range_str.c_str(),
+                             response_code, writer.offset);
+        }
+    }
+
+    file_handler.close();
+
+    if (curl != NULL) {
+        curl_easy_cleanup(curl);
+    }
+
+    return status;
+}
+
 AgentStatus FileDownloader::list_file_dir(string* file_list_string) {
     AgentStatus status = PALO_SUCCESS;
     CURL* curl = NULL;
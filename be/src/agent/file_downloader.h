@@ -53,6 +53,16 @@ public:
     // Download file from remote server
     virtual AgentStatus download_file();
 
+    // Download [offset, offset + length) of remote file by http range request,
+    // and write it to the same position of local file. Local file is not
+    // truncated, so several ranges can be downloaded in parallel.
+    virtual AgentStatus download_range(uint64_t offset, uint64_t length);
+
+    // Default is config max_download_speed_kbps
+    void set_max_download_speed_kbps(int64_t max_download_speed_kbps) {
+        _max_download_speed_kbps = max_download_speed_kbps;
+    }
+
     // List remote dir file
     virtual AgentStatus list_file_dir(std::string* file_list_string);
     
@@ -62,6 +72,14 @@ public:
     // * length: The pointer of size of remote file 
     virtual AgentStatus get_length(uint64_t* length);
 private:
+    struct RangeWriter {
+        FileHandler* file_handler;
+        uint64_t offset;
+        uint64_t end;
+    };
+
+    static size_t _write_range_callback(
+            void* buffer, size_t size, size_t nmemb, void* writer);
     static size_t _write_file_callback(
             void* buffer, size_t size, size_t nmemb, void* downloader);    
     static size_t _write_stream_callback(
@@ -74,6 +92,7 @@ private:
     void _get_err_info(char * errbuf, CURLcode res);
     
     const FileDownloaderParam& _downloader_param;
+    int64_t _max_download_speed_kbps;
     
     DISALLOW_COPY_AND_ASSIGN(FileDownloader);
 };  // class FileDownloader
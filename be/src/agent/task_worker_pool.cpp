@@ -14,8 +14,10 @@
 // under the License.
 
 #include "agent/task_worker_pool.h"
+#include <fcntl.h>
 #include <pthread.h>
 #include <sys/stat.h>
+#include <algorithm>
 #include <atomic>
 #include <csignal>
 #include <ctime>
@@ -33,6 +35,7 @@
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/Types_types.h"
 #include "olap/olap_common.h"
+#include "olap/io_governor.h"
 #include "olap/olap_engine.h"
 #include "olap/olap_table.h"
 #include "olap/utils.h"
@@ -820,6 +823,7 @@ void* TaskWorkerPool::_clone_worker_thread_callback(void* arg_this) {
         }
         // Try to register to cgroups_mgr
         CgroupsMgr::apply_system_cgroup();
+        IOPriorityScope io_priority(IO_PRIORITY_CLONE);
         OLAP_LOG_INFO("get clone task. signature: %ld", agent_task_req.signature);
 
         vector<string> error_msgs;
@@ -827,7 +831,27 @@ void* TaskWorkerPool::_clone_worker_thread_callback(void* arg_this) {
         SmartOLAPTable tablet =
                 worker_pool_this->_command_executor->get_table(
                 clone_req.tablet_id, clone_req.schema_hash);
-        if (tablet.get() != NULL) {
+        // If local tablet is behind committed version, clone it again and
+        // reuse its files, only missing versions are downloaded.
+        string reuse_data_path;
+        if (tablet.get() != NULL && clone_req.__isset.committed_version) {
+            tablet->obtain_header_rdlock();
+            const FileVersionMessage* latest_version = tablet->latest_version();
+            if (latest_version != NULL
+                    && latest_version->end_version() < clone_req.committed_version) {
+                reuse_data_path = boost::filesystem::path(
+                        tablet->header_file_name()).parent_path().string();
+                OLAP_LOG_INFO("clone tablet exist but is behind, clone missing versions. "
+                              "tablet_id: %ld, schema_hash: %ld, version: %d, "
+                              "committed_version: %ld, signature: %ld",
+                              clone_req.tablet_id, clone_req.schema_hash,
+                              latest_version->end_version(), clone_req.committed_version,
+                              agent_task_req.signature);
+            }
+            tablet->release_header_lock();
+        }
+
+        if (tablet.get() != NULL && reuse_data_path.empty()) {
             OLAP_LOG_INFO("clone tablet exist yet. tablet_id: %ld, schema_hash: %ld, "
                           "signature: %ld",
                           clone_req.tablet_id, clone_req.schema_hash,
@@ -838,7 +862,17 @@ void* TaskWorkerPool::_clone_worker_thread_callback(void* arg_this) {
 
         // Get local disk from olap
         string local_shard_root_path;
-        if (status == PALO_SUCCESS) {
+        if (status == PALO_SUCCESS && !reuse_data_path.empty()) {
+            OLAPStatus olap_status =
+                    worker_pool_this->_command_executor->obtain_shard_path_for_clone(
+                            tablet, &local_shard_root_path);
+            if (olap_status != OLAP_SUCCESS) {
+                OLAP_LOG_WARNING("clone get local shard path failed. signature: %ld",
+                                 agent_task_req.signature);
+                error_msgs.push_back("clone get local shard path failed.");
+                status = PALO_ERROR;
+            }
+        } else if (status == PALO_SUCCESS) {
             OLAPStatus olap_status = worker_pool_this->_command_executor->obtain_shard_path(
                     clone_req.storage_medium, &local_shard_root_path);
             if (olap_status != OLAP_SUCCESS) {
@@ -856,6 +890,7 @@ void* TaskWorkerPool::_clone_worker_thread_callback(void* arg_this) {
                     clone_req,
                     agent_task_req.signature,
                     local_shard_root_path,
+                    reuse_data_path,
                     &src_host,
                     &src_file_path,
                     &error_msgs);
@@ -997,6 +1032,7 @@ AgentStatus TaskWorkerPool::_clone_copy(
         const TCloneReq& clone_req,
         int64_t signature,
         const string& local_data_path,
+        const string& reuse_data_path,
         TBackend* src_host,
         string* src_file_path,
         vector<string>* error_msgs) {
@@ -1178,6 +1214,20 @@ AgentStatus TaskWorkerPool::_clone_copy(
                 + HTTP_REQUEST_FILE_PARAM + src_file_full_path + file_name;
             downloader_param.local_file_path = local_file_full_path + file_name;
 
+            // Link index and data files of local tablet, delete bitmaps may be
+            // changed by later deletes, so they are always downloaded.
+            string file_suffix = file_name.size() > 4
+                    ? file_name.substr(file_name.size() - 4, 4) : "";
+            if (!reuse_data_path.empty() && (file_suffix == ".idx" || file_suffix == ".dat")) {
+                string reuse_file_path = reuse_data_path + "/" + file_name;
+                if (boost::filesystem::exists(reuse_file_path)
+                        && link(reuse_file_path.c_str(),
+                                downloader_param.local_file_path.c_str()) == 0) {
+                    OLAP_LOG_DEBUG("clone link local file. [file=%s]", file_name.c_str());
+                    continue;
+                }
+            }
+
             // Get file length
             uint64_t file_size = 0;
             uint64_t estimate_time_out = 0;
@@ -1236,6 +1286,10 @@ AgentStatus TaskWorkerPool::_clone_copy(
             // Download the file
             download_retry_time = 0;
             downloader_param.curl_opt_timeout = estimate_time_out;
+            // Large file is downloaded by range requests in parallel, and by one
+            // request if it fails, in case remote backend doesn't support range.
+            bool download_in_ranges = config::download_range_num_threads > 1
+                    && static_cast<int64_t>(file_size) >= config::download_range_min_bytes;
 #ifndef BE_TEST
             file_downloader_ptr = new FileDownloader(downloader_param);
             if (file_downloader_ptr == NULL) {
@@ -1246,7 +1300,12 @@ AgentStatus TaskWorkerPool::_clone_copy(
 #endif
             while (download_retry_time < DOWNLOAD_FILE_MAX_RETRY) {
 #ifndef BE_TEST
-                download_status = file_downloader_ptr->download_file();
+                if (download_in_ranges) {
+                    download_status = _download_file_in_ranges(downloader_param, file_size);
+                    download_in_ranges = false;
+                } else {
+                    download_status = file_downloader_ptr->download_file();
+                }
 #else
                 download_status = _file_downloader_ptr->download_file();
 #endif
@@ -1320,6 +1379,88 @@ AgentStatus TaskWorkerPool::_clone_copy(
     return status;
 }
 
+AgentStatus TaskWorkerPool::_download_file_in_ranges(
+        const FileDownloader::FileDownloaderParam& downloader_param,
+        uint64_t file_size) {
+    uint32_t num_ranges = config::download_range_num_threads;
+    uint64_t range_size = (file_size + num_ranges - 1) / num_ranges;
+    // max download speed is shared by all ranges
+    int64_t max_download_speed_kbps = config::max_download_speed_kbps / num_ranges;
+    if (max_download_speed_kbps < 1) {
+        max_download_speed_kbps = 1;
+    }
+
+    // Ranges are written to their positions, truncate the file first
+    int fd = open(downloader_param.local_file_path.c_str(),
+                  O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        OLAP_LOG_WARNING("open local file failed. [file_path=%s]",
+                         downloader_param.local_file_path.c_str());
+        return PALO_FILE_DOWNLOAD_INVALID_PARAM;
+    }
+    close(fd);
+
+    vector<DownloadRangeContext> contexts;
+    for (uint64_t offset = 0; offset < file_size; offset += range_size) {
+        DownloadRangeContext context;
+        context.downloader_param = &downloader_param;
+        context.offset = offset;
+        context.length = std::min(range_size, file_size - offset);
+        context.max_download_speed_kbps = max_download_speed_kbps;
+        context.status = PALO_SUCCESS;
+        contexts.push_back(context);
+    }
+
+    vector<pthread_t> threads(contexts.size());
+    vector<bool> started(contexts.size(), false);
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        if (0 == pthread_create(&threads[i], NULL,
+                                _download_range_thread_callback, &contexts[i])) {
+            started[i] = true;
+        } else {
+            // download it in current thread
+            OLAP_LOG_WARNING("failed to start download range thread.");
+            _download_range_thread_callback(&contexts[i]);
+        }
+    }
+
+    AgentStatus status = PALO_SUCCESS;
+    for (size_t i = 0; i < contexts.size(); ++i) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+        if (contexts[i].status != PALO_SUCCESS) {
+            status = contexts[i].status;
+        }
+    }
+
+    return status;
+}
+
+void* TaskWorkerPool::_download_range_thread_callback(void* arg) {
+    DownloadRangeContext* context = static_cast<DownloadRangeContext*>(arg);
+    CgroupsMgr::apply_system_cgroup();
+    IOPriorityScope io_priority(IO_PRIORITY_CLONE);
+
+    FileDownloader file_downloader(*context->downloader_param);
+    file_downloader.set_max_download_speed_kbps(context->max_download_speed_kbps);
+    // Broken range is retried alone
+    for (uint32_t retry_time = 0; retry_time < DOWNLOAD_FILE_MAX_RETRY; ++retry_time) {
+        if (retry_time > 0) {
+            sleep(retry_time);
+        }
+        context->status = file_downloader.download_range(context->offset, context->length);
+        if (context->status == PALO_SUCCESS) {
+            break;
+        }
+        OLAP_LOG_WARNING("download range failed. src_file_path: %s, offset: %lu, length: %lu",
+                         context->downloader_param->remote_file_path.c_str(),
+                         context->offset, context->length);
+    }
+
+    return NULL;
+}
+
 void* TaskWorkerPool::_storage_medium_migrate_worker_thread_callback(void* arg_this) {
     TaskWorkerPool* worker_pool_this = (TaskWorkerPool*)arg_this;
 
@@ -99,14 +99,33 @@ private:
     static void* _make_snapshot_thread_callback(void* arg_this);
     static void* _release_snapshot_thread_callback(void* arg_this);
 
+    // Download files of remote snapshot to local_data_path. Index and data
+    // files existing in reuse_data_path are hard linked instead, they are
+    // the same if their names are the same.
     AgentStatus _clone_copy(
             const TCloneReq& clone_req,
             int64_t signature,
             const std::string& local_data_path,
+            const std::string& reuse_data_path,
             TBackend* src_host,
             std::string* src_file_path,
             std::vector<std::string>* error_msgs);
 
+    struct DownloadRangeContext {
+        const FileDownloader::FileDownloaderParam* downloader_param;
+        uint64_t offset;
+        uint64_t length;
+        int64_t max_download_speed_kbps;
+        AgentStatus status;
+    };
+
+    static void* _download_range_thread_callback(void* arg);
+
+    // Download a large file with several range requests in parallel
+    AgentStatus _download_file_in_ranges(
+            const FileDownloader::FileDownloaderParam& downloader_param,
+            uint64_t file_size);
+
     void _alter_table(
             const TAlterTabletReq& create_rollup_request,
             int64_t signature,
@@ -104,6 +104,11 @@ namespace config {
     CONF_Int32(download_low_speed_limit_kbps, "50");
     // download low speed time(seconds)
     CONF_Int32(download_low_speed_time, "300");
+    // files larger than this are downloaded by clone with several range
+    // requests in parallel, max download speed is shared by them
+    CONF_Int64(download_range_min_bytes, "67108864");
+    // the count of range requests downloading one file in parallel
+    CONF_Int32(download_range_num_threads, "4");
     // curl verbose mode
     CONF_Int64(curl_verbose_mode, "1");
     // seconds to sleep for each time check table status
@@ -188,8 +193,6 @@ namespace config {
     CONF_Int32(insertion_threadhold, "16");
     // the block_size every block allocate for sorter
     CONF_Int32(sorter_block_size, "8388608");
-    // push_write_mbytes_per_sec
-    CONF_Int32(push_write_mbytes_per_sec, "10");
 
     CONF_Int64(column_dictionary_key_ration_threshold, "0");
     CONF_Int64(column_dictionary_key_size_threshold, "0");
@@ -197,8 +200,14 @@ namespace config {
     CONF_Bool(dump_ir, "false");
     // if set, saves the generated IR to the output file.
     CONF_String(module_output, "");
-    // memory_limiation_per_thread_for_schema_change unit GB
+    // memory_limiation_per_thread_for_schema_change unit GB, it's the limitation
+    // of one tablet and split evenly across its converting threads
     CONF_Int32(memory_limiation_per_thread_for_schema_change, "2");
+    // number of threads converting history versions of one tablet in parallel
+    CONF_Int32(schema_change_num_threads, "4");
+    // number of threads writing sorted runs of one version when schema change
+    // needs sorting, 0 means writing in the converting thread
+    CONF_Int32(schema_change_sorting_num_threads, "2");
 
     CONF_Int64(max_unpacked_row_block_size, "104857600");
 
@@ -221,25 +230,51 @@ namespace config {
     CONF_Bool(row_nums_check, "true")
     //file descriptors cache, by default, cache 30720 descriptors
     CONF_Int32(file_descriptor_cache_capacity, "30720");
+    // number of threads to load tablet headers of each root path on start
+    CONF_Int32(load_tablet_num_threads_per_disk, "4");
+    // save tablet headers into header store of each root path. Header files
+    // are still written along with the store until migration is finalized,
+    // so that versions without header store can load tablets after rollback
+    CONF_Bool(enable_header_store, "false");
+    // remove header files once headers are saved into header store. Only
+    // set it after all BEs run with header store and no rollback is needed
+    CONF_Bool(header_store_migration_finalized, "false");
+    // size of header store log of each root path to trigger checkpoint
+    CONF_Int64(header_store_checkpoint_log_mbytes, "64");
     CONF_Int64(index_stream_cache_capacity, "10737418240");
+    // memory limit of short key index entries, least recently used ones are evicted
+    CONF_Int64(mem_index_cache_capacity, "4294967296");
     CONF_Int64(max_packed_row_block_size, "20971520");
+    // mark rows matching delete condition in delete bitmaps of existing
+    // segments in background after it's pushed, instead of evaluating it
+    // on every read
+    CONF_Bool(enable_delete_bitmap, "false");
 
     // be policy
     CONF_Int64(base_compaction_start_hour, "20");
     CONF_Int64(base_compaction_end_hour, "7");
     CONF_Int32(base_compaction_check_interval_seconds, "60");
     CONF_Int64(base_compaction_num_cumulative_deltas, "5");
-    CONF_Int32(base_compaction_num_threads, "1");
     CONF_Double(base_cumulative_delta_ratio, "0.3");
     CONF_Int64(base_compaction_interval_seconds_since_last_operation, "604800");
-    CONF_Int32(base_compaction_write_mbytes_per_sec, "5");
 
     // cumulative compaction policy: max delta file's size unit:B
-    CONF_Int32(cumulative_compaction_check_interval_seconds, "10");
     CONF_Int64(cumulative_compaction_num_singleton_deltas, "5");
-    CONF_Int32(cumulative_compaction_num_threads, "1");
     CONF_Int64(cumulative_compaction_budgeted_bytes, "104857600");
-    CONF_Int32(cumulative_compaction_write_mbytes_per_sec, "100");
+    // merge compaction input with CompactionMerger instead of Reader
+    CONF_Bool(enable_compaction_merger, "true");
+    // number of threads to run base and cumulative compactions
+    CONF_Int32(compaction_num_threads, "2");
+    // max number of running compactions of each data directory
+    CONF_Int32(compaction_task_num_per_disk, "2");
+    // max total size of data being merged by running compactions, unit:B
+    CONF_Int64(compaction_running_bytes_budget, "10737418240");
+
+    // io limits of each data directory shared by push, compaction, schema
+    // change and clone, query io is not limited but counted. 0 means no limit
+    CONF_Int64(disk_read_mbytes_per_sec, "0");
+    CONF_Int64(disk_write_mbytes_per_sec, "0");
+    CONF_Int64(disk_iops, "0");
 
     CONF_Int32(delete_delta_expire_time, "1440");
     // Port to start debug webserver on
@@ -263,6 +298,20 @@ namespace config {
     CONF_Int64(load_data_reserve_hours, "24");
     CONF_Int64(mini_load_max_mb, "2048");
 
+    // Used for broker load
+    // decompress compressed load files in a separate thread, so that
+    // decompressing is pipelined with parsing
+    CONF_Bool(enable_load_prefetch_decompress, "true");
+    // max bytes of decompressed data buffered for each load file
+    CONF_Int64(load_decompress_buffer_bytes, "16777216");
+
+    // sort and aggregate rows of pushed files in memory, so that files
+    // need not be sorted by etl
+    CONF_Bool(enable_push_memtable, "false");
+    // max bytes of rows of one push kept in memory before they are
+    // flushed into a sorted temporary run
+    CONF_Int64(write_buffer_size, "104857600");
+
     // Fragment thread pool
     CONF_Int32(fragment_pool_thread_num, "64");
     CONF_Int32(fragment_pool_queue_size, "1024");
@@ -295,6 +344,9 @@ namespace config {
     // Enable quadratic probing hash table
     CONF_Bool(enable_quadratic_probing, "false");
 
+    // max number of compiled regexes of LIKE and REGEXP cached in process
+    CONF_Int32(regex_cache_capacity, "1024");
+
     // for pprof
     CONF_String(pprof_profile_dir, "${PALO_HOME}/log")
 
@@ -47,9 +47,11 @@
 #include "exprs/encryption_functions.h"
 #include "exprs/timestamp_functions.h"
 #include "exprs/decimal_operators.h"
+#include "exprs/decimalv2_operators.h"
 #include "exprs/utility_functions.h"
 #include "exprs/json_functions.h"
 #include "exprs/hll_hash_function.h"
+#include "exprs/bitmap_function.h"
 #include "olap/olap_rootpath.h"
 
 namespace palo {
@@ -157,10 +159,12 @@ void init_daemon(int argc, char** argv) {
     EncryptionFunctions::init();
     TimestampFunctions::init();
     DecimalOperators::init();
+    DecimalV2Operators::init();
     UtilityFunctions::init();
     CompoundPredicate::init();
     JsonFunctions::init();
     HllHashFunctions::init();
+    BitmapFunctions::init();
 
     pthread_t tc_malloc_pid;
     pthread_create(&tc_malloc_pid, NULL, tcmalloc_gc_thread, NULL);
@@ -637,6 +637,7 @@ llvm::Function* AggregationNode::codegen_update_slot(
     if (input_expr->type().type == TYPE_DATETIME
             || input_expr->type().type == TYPE_DATE
             || input_expr->type().type == TYPE_DECIMAL
+            || input_expr->type().type == TYPE_DECIMALV2
             || input_expr->type().is_string_type()) {
         return NULL;
     }
@@ -857,6 +858,7 @@ Function* AggregationNode::codegen_update_tuple(RuntimeState* state) {
         if (slot_desc->type().type == TYPE_DATETIME || slot_desc->type().type == TYPE_CHAR ||
             (evaluator->agg_op() != AggFnEvaluator::NDV &&
              (slot_desc->type().type == TYPE_DECIMAL ||
+              slot_desc->type().type == TYPE_DECIMALV2 ||
               slot_desc->type().type == TYPE_CHAR ||
               slot_desc->type().type == TYPE_VARCHAR))) {
             LOG(INFO) << "Could not codegen UpdateIntermediateTuple because "
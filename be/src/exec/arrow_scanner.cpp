@@ -0,0 +1,518 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec/arrow_scanner.h"
+
+#include <stdio.h>
+
+#include <limits>
+#include <sstream>
+
+#include <arrow/api.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/ipc/reader.h>
+
+#include "exec/file_reader.h"
+#include "runtime/datetime_value.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "runtime/string_value.h"
+#include "runtime/tuple.h"
+
+namespace palo {
+
+// Adapt FileReader to arrow's input stream. Arrow IPC stream is read
+// sequentially, so broker files and stream load pipes can all be read.
+class ArrowInputStream : public arrow::io::InputStream {
+public:
+    ArrowInputStream(FileReader* file_reader) :
+            _file_reader(file_reader), _pos(0), _closed(false) {
+    }
+
+    virtual ~ArrowInputStream() {
+    }
+
+    arrow::Status Close() override {
+        _closed = true;
+        return arrow::Status::OK();
+    }
+
+    bool closed() const {
+        return _closed;
+    }
+
+    arrow::Status Tell(int64_t* position) const override {
+        *position = _pos;
+        return arrow::Status::OK();
+    }
+
+    arrow::Status Read(int64_t nbytes, int64_t* bytes_read, void* out) override {
+        // FileReader may return less data than wanted, so read until
+        // we get 'nbytes' or reach the end of file
+        uint8_t* buf = static_cast<uint8_t*>(out);
+        int64_t total = 0;
+        while (total < nbytes) {
+            size_t len = nbytes - total;
+            bool eof = false;
+            Status st = _file_reader->read(buf + total, &len, &eof);
+            if (!st.ok()) {
+                return arrow::Status::IOError(st.get_error_msg());
+            }
+            if (eof || len == 0) {
+                break;
+            }
+            total += len;
+        }
+        *bytes_read = total;
+        _pos += total;
+        return arrow::Status::OK();
+    }
+
+    arrow::Status Read(int64_t nbytes, std::shared_ptr<arrow::Buffer>* out) override {
+        std::shared_ptr<arrow::ResizableBuffer> buffer;
+        arrow::Status st = arrow::AllocateResizableBuffer(
+            arrow::default_memory_pool(), nbytes, &buffer);
+        if (!st.ok()) {
+            return st;
+        }
+        int64_t bytes_read = 0;
+        st = Read(nbytes, &bytes_read, buffer->mutable_data());
+        if (!st.ok()) {
+            return st;
+        }
+        if (bytes_read < nbytes) {
+            st = buffer->Resize(bytes_read);
+            if (!st.ok()) {
+                return st;
+            }
+        }
+        *out = buffer;
+        return arrow::Status::OK();
+    }
+
+private:
+    FileReader* _file_reader;
+    int64_t _pos;
+    bool _closed;
+};
+
+ArrowScanner::ArrowScanner(RuntimeState* state,
+                           RuntimeProfile* profile,
+                           const TBrokerScanRangeParams& params,
+                           const std::vector<TBrokerRangeDesc>& ranges,
+                           const std::vector<TNetworkAddress>& broker_addresses,
+                           BrokerScanCounter* counter) :
+        BaseScanner(state, profile, params, counter),
+        _ranges(ranges),
+        _broker_addresses(broker_addresses),
+        _next_range(0),
+        _scanner_eof(false),
+        _batch_row(0),
+        _timezone_offset(0) {
+}
+
+// Parse offset of timezone in seconds, "UTC" and "+HH:MM"/"-HH:MM" are supported
+static bool parse_timezone_offset(const std::string& tz, int64_t* offset) {
+    if (tz == "UTC" || tz == "GMT" || tz == "Z") {
+        *offset = 0;
+        return true;
+    }
+    int hour = 0;
+    int minute = 0;
+    char sign = 0;
+    char end = 0;
+    if (sscanf(tz.c_str(), "%c%2d:%2d%c", &sign, &hour, &minute, &end) != 3
+            || (sign != '+' && sign != '-')
+            || hour < 0 || hour > 14 || minute < 0 || minute >= 60) {
+        return false;
+    }
+    *offset = (sign == '+' ? 1 : -1) * (hour * 3600 + minute * 60);
+    return true;
+}
+
+Status ArrowScanner::open() {
+    RETURN_IF_ERROR(BaseScanner::open());
+    // Timestamps with timezone are instants, they are converted to time
+    // of this timezone. Backends assume Beijing time by default.
+    std::string timezone = "+08:00";
+    auto it = _params.properties.find("timezone");
+    if (it != _params.properties.end()) {
+        timezone = it->second;
+    }
+    if (!parse_timezone_offset(timezone, &_timezone_offset)) {
+        std::stringstream ss;
+        ss << "Unknown timezone, timezone=" << timezone;
+        return Status(ss.str());
+    }
+    return Status::OK;
+}
+
+ArrowScanner::~ArrowScanner() {
+    close();
+}
+
+Status ArrowScanner::get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof) {
+    SCOPED_TIMER(_read_timer);
+    while (!_scanner_eof) {
+        if (_batch == nullptr || _batch_row >= _batch->num_rows()) {
+            bool file_eof = true;
+            if (_batch_reader != nullptr) {
+                RETURN_IF_ERROR(next_batch(&file_eof));
+            }
+            if (file_eof) {
+                RETURN_IF_ERROR(open_next_reader());
+            }
+            continue;
+        }
+
+        COUNTER_UPDATE(_rows_read_counter, 1);
+        SCOPED_TIMER(_materialize_timer);
+        std::string error_msg;
+        bool success = fill_src_tuple(&error_msg)
+            && fill_dest_tuple(tuple, tuple_pool, &error_msg);
+        if (!success) {
+            _state->append_error_msg_to_file(row_debug_string(), error_msg);
+            _counter->num_rows_filtered++;
+        }
+        _batch_row++;
+        if (success) {
+            break;
+        }
+    }
+    *eof = _scanner_eof;
+    return Status::OK;
+}
+
+Status ArrowScanner::open_next_reader() {
+    close_reader();
+    if (_next_range >= _ranges.size()) {
+        _scanner_eof = true;
+        return Status::OK;
+    }
+    const TBrokerRangeDesc& range = _ranges[_next_range++];
+    if (range.start_offset != 0) {
+        return Status("Arrow stream file can not be split");
+    }
+    RETURN_IF_ERROR(create_file_reader(range, 0, _broker_addresses, &_cur_file_reader));
+
+    _cur_stream.reset(new ArrowInputStream(_cur_file_reader.get()));
+    arrow::Status st = arrow::ipc::RecordBatchStreamReader::Open(
+        _cur_stream.get(), &_batch_reader);
+    if (!st.ok()) {
+        std::stringstream ss;
+        ss << "Open arrow stream failed, path=" << range.path << ", error=" << st.ToString();
+        return Status(ss.str());
+    }
+
+    // Map each source slot to a column of file by name, columns which
+    // are not needed are never touched.
+    const std::shared_ptr<arrow::Schema>& schema = _batch_reader->schema();
+    _column_indices.clear();
+    for (auto slot_desc : _src_slot_descs) {
+        int idx = schema->GetFieldIndex(slot_desc->col_name());
+        if (idx < 0) {
+            std::stringstream ss;
+            ss << "Column is not found in arrow file, column=" << slot_desc->col_name()
+                << ", path=" << range.path;
+            return Status(ss.str());
+        }
+        _column_indices.push_back(idx);
+    }
+    _text_values.resize(_src_slot_descs.size());
+    return Status::OK;
+}
+
+void ArrowScanner::close_reader() {
+    _batch.reset();
+    _batch_row = 0;
+    _batch_reader.reset();
+    _cur_stream.reset();
+    if (_cur_file_reader != nullptr) {
+        _cur_file_reader->close();
+        _cur_file_reader.reset();
+    }
+}
+
+Status ArrowScanner::next_batch(bool* eof) {
+    _batch_row = 0;
+    arrow::Status st = _batch_reader->ReadNext(&_batch);
+    if (!st.ok()) {
+        std::stringstream ss;
+        ss << "Read arrow record batch failed, error=" << st.ToString();
+        return Status(ss.str());
+    }
+    // null batch means the end of stream
+    *eof = (_batch == nullptr);
+    return Status::OK;
+}
+
+bool ArrowScanner::fill_src_tuple(std::string* error_msg) {
+    for (int i = 0; i < _src_slot_descs.size(); ++i) {
+        const SlotDescriptor* slot_desc = _src_slot_descs[i];
+        const arrow::Array& array = *_batch->column(_column_indices[i]);
+        if (array.IsNull(_batch_row)) {
+            if (!slot_desc->is_nullable()) {
+                std::stringstream ss;
+                ss << "column(" << slot_desc->col_name() << ") value is null";
+                *error_msg = ss.str();
+                return false;
+            }
+            _src_tuple->set_null(slot_desc->null_indicator_offset());
+            continue;
+        }
+        _src_tuple->set_not_null(slot_desc->null_indicator_offset());
+        if (!write_slot(array, _batch_row, slot_desc, i, error_msg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename ArrayType, typename T>
+static bool get_number(const arrow::Array& array, int64_t row, T* value) {
+    *value = static_cast<const ArrayType&>(array).Value(row);
+    return true;
+}
+
+// Read integer value of any integer array
+static bool get_integer(const arrow::Array& array, int64_t row, int64_t* value) {
+    switch (array.type_id()) {
+    case arrow::Type::INT8:
+        return get_number<arrow::Int8Array>(array, row, value);
+    case arrow::Type::INT16:
+        return get_number<arrow::Int16Array>(array, row, value);
+    case arrow::Type::INT32:
+        return get_number<arrow::Int32Array>(array, row, value);
+    case arrow::Type::INT64:
+        return get_number<arrow::Int64Array>(array, row, value);
+    case arrow::Type::UINT8:
+        return get_number<arrow::UInt8Array>(array, row, value);
+    case arrow::Type::UINT16:
+        return get_number<arrow::UInt16Array>(array, row, value);
+    case arrow::Type::UINT32:
+        return get_number<arrow::UInt32Array>(array, row, value);
+    case arrow::Type::BOOL:
+        *value = static_cast<const arrow::BooleanArray&>(array).Value(row);
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<typename T>
+static bool write_integer(int64_t value, void* slot) {
+    if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {
+        return false;
+    }
+    *reinterpret_cast<T*>(slot) = value;
+    return true;
+}
+
+// Set 'value' to the time of 'seconds' since 1970-01-01 00:00:00.
+// All fields are set, because slot may hold value of previous row.
+static bool set_datetime(int64_t seconds, DateTimeValue* value) {
+    int64_t days = seconds / 86400;
+    int64_t second_of_day = seconds % 86400;
+    if (second_of_day < 0) {
+        days -= 1;
+        second_of_day += 86400;
+    }
+    int64_t daynr = days + DateTimeValue::calc_daynr(1970, 1, 1);
+    DateTimeValue date;
+    if (daynr <= 0 || !date.from_date_daynr(daynr)) {
+        return false;
+    }
+    uint64_t date_val = date.year() * 10000 + date.month() * 100 + date.day();
+    uint64_t time_val = second_of_day / 3600 * 10000
+        + second_of_day % 3600 / 60 * 100 + second_of_day % 60;
+    return value->from_olap_datetime(date_val * 1000000 + time_val);
+}
+
+// Read value of date or timestamp array. Timestamp without timezone is
+// wall clock time, timestamp with timezone is shifted by 'timezone_offset'.
+static bool get_datetime(const arrow::Array& array, int64_t row,
+                         int64_t timezone_offset, DateTimeValue* value) {
+    switch (array.type_id()) {
+    case arrow::Type::DATE32: {
+        int64_t days = static_cast<const arrow::Date32Array&>(array).Value(row);
+        int64_t daynr = days + DateTimeValue::calc_daynr(1970, 1, 1);
+        return daynr > 0 && value->from_date_daynr(daynr);
+    }
+    case arrow::Type::TIMESTAMP: {
+        int64_t ts = static_cast<const arrow::TimestampArray&>(array).Value(row);
+        auto& type = static_cast<const arrow::TimestampType&>(*array.type());
+        int64_t units_per_second = 1;
+        switch (type.unit()) {
+        case arrow::TimeUnit::MILLI:
+            units_per_second = 1000;
+            break;
+        case arrow::TimeUnit::MICRO:
+            units_per_second = 1000000;
+            break;
+        case arrow::TimeUnit::NANO:
+            units_per_second = 1000000000;
+            break;
+        default:
+            break;
+        }
+        // round towards negative infinity for time before 1970
+        int64_t seconds = ts / units_per_second;
+        if (ts % units_per_second < 0) {
+            seconds -= 1;
+        }
+        if (!type.timezone().empty()) {
+            seconds += timezone_offset;
+        }
+        return set_datetime(seconds, value);
+    }
+    default:
+        return false;
+    }
+}
+
+bool ArrowScanner::write_slot(const arrow::Array& array, int64_t row,
+                              const SlotDescriptor* slot_desc, int slot_idx,
+                              std::string* error_msg) {
+    void* slot = _src_tuple->get_slot(slot_desc->tuple_offset());
+    bool success = false;
+    switch (slot_desc->type().type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT: {
+        int64_t value = 0;
+        if (!get_integer(array, row, &value)) {
+            break;
+        }
+        switch (slot_desc->type().type) {
+        case TYPE_TINYINT:
+            success = write_integer<int8_t>(value, slot);
+            break;
+        case TYPE_SMALLINT:
+            success = write_integer<int16_t>(value, slot);
+            break;
+        case TYPE_INT:
+            success = write_integer<int32_t>(value, slot);
+            break;
+        default:
+            success = write_integer<int64_t>(value, slot);
+            break;
+        }
+        break;
+    }
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE: {
+        double value = 0;
+        int64_t int_value = 0;
+        if (array.type_id() == arrow::Type::FLOAT) {
+            value = static_cast<const arrow::FloatArray&>(array).Value(row);
+        } else if (array.type_id() == arrow::Type::DOUBLE) {
+            value = static_cast<const arrow::DoubleArray&>(array).Value(row);
+        } else if (get_integer(array, row, &int_value)) {
+            value = int_value;
+        } else {
+            break;
+        }
+        if (slot_desc->type().type == TYPE_FLOAT) {
+            *reinterpret_cast<float*>(slot) = value;
+        } else {
+            *reinterpret_cast<double*>(slot) = value;
+        }
+        success = true;
+        break;
+    }
+    case TYPE_DATE:
+    case TYPE_DATETIME: {
+        DateTimeValue* value = reinterpret_cast<DateTimeValue*>(slot);
+        success = get_datetime(array, row, _timezone_offset, value);
+        if (success) {
+            if (slot_desc->type().type == TYPE_DATE) {
+                value->cast_to_date();
+            } else {
+                value->to_datetime();
+            }
+        }
+        break;
+    }
+    case TYPE_CHAR:
+    case TYPE_VARCHAR: {
+        StringValue* str_slot = reinterpret_cast<StringValue*>(slot);
+        if (array.type_id() == arrow::Type::STRING || array.type_id() == arrow::Type::BINARY) {
+            // point to data in record batch, it's alive until this row is done
+            int32_t len = 0;
+            const uint8_t* data = static_cast<const arrow::BinaryArray&>(array).GetValue(row, &len);
+            str_slot->ptr = (char*)data;
+            str_slot->len = len;
+            success = true;
+            break;
+        }
+        // typed value is converted to text, and parsed by cast expr of dest slot
+        std::string& text = _text_values[slot_idx];
+        int64_t int_value = 0;
+        DateTimeValue dt_value;
+        char buf[64];
+        if (get_integer(array, row, &int_value)) {
+            text = std::to_string(int_value);
+        } else if (array.type_id() == arrow::Type::UINT64) {
+            text = std::to_string(static_cast<const arrow::UInt64Array&>(array).Value(row));
+        } else if (array.type_id() == arrow::Type::FLOAT) {
+            // enough digits to be parsed back to the same value
+            int len = snprintf(buf, sizeof(buf), "%.9g",
+                               static_cast<const arrow::FloatArray&>(array).Value(row));
+            text.assign(buf, len);
+        } else if (array.type_id() == arrow::Type::DOUBLE) {
+            int len = snprintf(buf, sizeof(buf), "%.17g",
+                               static_cast<const arrow::DoubleArray&>(array).Value(row));
+            text.assign(buf, len);
+        } else if (array.type_id() == arrow::Type::DECIMAL) {
+            text = static_cast<const arrow::Decimal128Array&>(array).FormatValue(row);
+        } else if (get_datetime(array, row, _timezone_offset, &dt_value)) {
+            char* end = dt_value.to_string(buf);
+            text.assign(buf, end - buf - 1);
+        } else {
+            break;
+        }
+        str_slot->ptr = (char*)text.data();
+        str_slot->len = text.size();
+        success = true;
+        break;
+    }
+    default:
+        break;
+    }
+    if (!success) {
+        std::stringstream ss;
+        ss << "can not convert arrow value of type " << array.type()->ToString()
+            << " to " << slot_desc->type() << ", column=" << slot_desc->col_name();
+        *error_msg = ss.str();
+    }
+    return success;
+}
+
+std::string ArrowScanner::row_debug_string() {
+    std::stringstream ss;
+    ss << "row " << _batch_row << " of record batch";
+    if (_next_range > 0) {
+        ss << " in file " << _ranges[_next_range - 1].path;
+    }
+    return ss.str();
+}
+
+void ArrowScanner::close() {
+    close_reader();
+    BaseScanner::close();
+}
+
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "exec/base_scanner.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gen_cpp/Types_types.h"
+
+namespace arrow {
+class Array;
+class RecordBatch;
+class RecordBatchReader;
+}
+
+namespace palo {
+
+class ArrowInputStream;
+class FileReader;
+
+// ArrowScanner reads files in Apache Arrow IPC stream format.
+// Only columns needed by source slots are read, and typed values are
+// written into source slots of the same type directly, so they need not
+// to be parsed from text like BrokerScanner does.
+class ArrowScanner : public BaseScanner {
+public:
+    ArrowScanner(
+        RuntimeState* state,
+        RuntimeProfile* profile,
+        const TBrokerScanRangeParams& params,
+        const std::vector<TBrokerRangeDesc>& ranges,
+        const std::vector<TNetworkAddress>& broker_addresses,
+        BrokerScanCounter* counter);
+    virtual ~ArrowScanner();
+
+    virtual Status open() override;
+
+    virtual Status get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof) override;
+
+    virtual void close() override;
+
+private:
+    // Open next file and read its schema
+    Status open_next_reader();
+    void close_reader();
+
+    // Read next record batch of current file, 'eof' is set if
+    // there is no more batch in current file
+    Status next_batch(bool* eof);
+
+    // Fill _src_tuple with '_batch_row'th row of current batch.
+    // Return false if this row should be filtered.
+    bool fill_src_tuple(std::string* error_msg);
+
+    // Write value of 'row'th row in 'array' into slot, which is of 'slot_desc'
+    bool write_slot(const arrow::Array& array, int64_t row,
+                    const SlotDescriptor* slot_desc, int slot_idx,
+                    std::string* error_msg);
+
+    // Describe current row for error log
+    std::string row_debug_string();
+
+    const std::vector<TBrokerRangeDesc>& _ranges;
+    const std::vector<TNetworkAddress>& _broker_addresses;
+    int _next_range;
+    bool _scanner_eof;
+
+    std::shared_ptr<FileReader> _cur_file_reader;
+    std::unique_ptr<ArrowInputStream> _cur_stream;
+    std::shared_ptr<arrow::RecordBatchReader> _batch_reader;
+    std::shared_ptr<arrow::RecordBatch> _batch;
+    int64_t _batch_row;
+
+    // index of column in file of each source slot
+    std::vector<int> _column_indices;
+    // text of typed values which are written into string slots
+    std::vector<std::string> _text_values;
+    // offset in seconds of timezone which timestamps are converted to
+    int64_t _timezone_offset;
+};
+
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec/base_scanner.h"
+
+#include <map>
+#include <sstream>
+
+#include "exec/broker_reader.h"
+#include "exec/local_file_reader.h"
+#include "exprs/expr.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/raw_value.h"
+#include "runtime/runtime_state.h"
+#include "runtime/tuple.h"
+
+namespace palo {
+
+BaseScanner::BaseScanner(RuntimeState* state,
+                         RuntimeProfile* profile,
+                         const TBrokerScanRangeParams& params,
+                         BrokerScanCounter* counter) :
+        _state(state),
+        _profile(profile),
+        _params(params),
+        _src_tuple(nullptr),
+        _src_tuple_row(nullptr),
+        _mem_pool(_state->instance_mem_tracker()),
+        _dest_tuple_desc(nullptr),
+        _mem_tracker(new MemTracker(-1, "Broker Scanner", state->instance_mem_tracker())),
+        _counter(counter),
+        _rows_read_counter(nullptr),
+        _read_timer(nullptr),
+        _materialize_timer(nullptr),
+        _is_closed(false) {
+}
+
+BaseScanner::~BaseScanner() {
+}
+
+Status BaseScanner::init_expr_ctxes() {
+    // Constcut _src_slot_descs
+    const TupleDescriptor* src_tuple_desc = 
+        _state->desc_tbl().get_tuple_descriptor(_params.src_tuple_id);
+    if (src_tuple_desc == nullptr) {
+        std::stringstream ss;
+        ss << "Unknown source tuple descriptor, tuple_id=" << _params.src_tuple_id;
+        return Status(ss.str());
+    }
+
+    std::map<SlotId, SlotDescriptor*> src_slot_desc_map;
+    for (auto slot_desc : src_tuple_desc->slots()) {
+        src_slot_desc_map.emplace(slot_desc->id(), slot_desc);
+    }
+    for (auto slot_id : _params.src_slot_ids) {
+        auto it = src_slot_desc_map.find(slot_id);
+        if (it == std::end(src_slot_desc_map)) {
+            std::stringstream ss;
+            ss << "Unknown source slot descriptor, slot_id=" << slot_id;
+            return Status(ss.str());
+        }
+        _src_slot_descs.emplace_back(it->second);
+    }
+    // Construct source tuple and tuple row
+    _src_tuple = (Tuple*) _mem_pool.allocate(src_tuple_desc->byte_size());
+    _src_tuple_row = (TupleRow*) _mem_pool.allocate(sizeof(Tuple*));
+    _src_tuple_row->set_tuple(0, _src_tuple);
+    _row_desc.reset(new RowDescriptor(_state->desc_tbl(), 
+                                      std::vector<TupleId>({_params.src_tuple_id}), 
+                                      std::vector<bool>({false})));
+
+    // Construct dest slots information
+    _dest_tuple_desc = _state->desc_tbl().get_tuple_descriptor(_params.dest_tuple_id);
+    if (_dest_tuple_desc == nullptr) {
+        std::stringstream ss;
+        ss << "Unknown dest tuple descriptor, tuple_id=" << _params.dest_tuple_id;
+        return Status(ss.str());
+    }
+
+    for (auto slot_desc : _dest_tuple_desc->slots()) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        auto it = _params.expr_of_dest_slot.find(slot_desc->id());
+        if (it == std::end(_params.expr_of_dest_slot)) {
+            std::stringstream ss;
+            ss << "No expr for dest slot, id=" << slot_desc->id() 
+                << ", name=" << slot_desc->col_name();
+            return Status(ss.str());
+        }
+        ExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_state->obj_pool(), it->second, &ctx));
+        RETURN_IF_ERROR(ctx->prepare(_state, *_row_desc.get(), _mem_tracker.get()));
+        RETURN_IF_ERROR(ctx->open(_state));
+        _dest_expr_ctx.emplace_back(ctx);
+    }
+
+    return Status::OK;
+}
+
+Status BaseScanner::open() {
+    RETURN_IF_ERROR(init_expr_ctxes());
+
+    _rows_read_counter = ADD_COUNTER(_profile, "RowsRead", TUnit::UNIT);
+    _read_timer = ADD_TIMER(_profile, "TotalRawReadTime(*)");
+    _materialize_timer = ADD_TIMER(_profile, "MaterializeTupleTime(*)");
+
+    return Status::OK;
+}
+
+void BaseScanner::close() {
+    if (_is_closed) {
+        return;
+    }
+    _is_closed = true;
+    Expr::close(_dest_expr_ctx, _state);
+}
+
+Status BaseScanner::create_file_reader(
+        const TBrokerRangeDesc& range, int64_t start_offset,
+        const std::vector<TNetworkAddress>& broker_addresses,
+        std::shared_ptr<FileReader>* file_reader) {
+    switch (range.file_type) {
+    case TFileType::FILE_LOCAL: {
+        LocalFileReader* local_reader = new LocalFileReader(range.path, start_offset);
+        file_reader->reset(local_reader);
+        RETURN_IF_ERROR(local_reader->open());
+        break;
+    }
+    case TFileType::FILE_BROKER: {
+        BrokerReader* broker_reader = new BrokerReader(
+            _state, broker_addresses, _params.properties, range.path, start_offset);
+        file_reader->reset(broker_reader);
+        RETURN_IF_ERROR(broker_reader->open());
+        break;
+    }
+    default: {
+        std::stringstream ss;
+        ss << "Unknown file type, type=" << range.file_type;
+        return Status(ss.str());
+    }
+    }
+    return Status::OK;
+}
+
+bool BaseScanner::fill_dest_tuple(Tuple* dest_tuple, MemPool* mem_pool,
+                                  std::string* error_msg) {
+    int ctx_idx = 0;
+    for (auto slot_desc : _dest_tuple_desc->slots()) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        ExprContext* ctx = _dest_expr_ctx[ctx_idx++];
+        void* value = ctx->get_value(_src_tuple_row);
+        if (value == nullptr) {
+            if (slot_desc->is_nullable()) {
+                dest_tuple->set_null(slot_desc->null_indicator_offset());
+                continue;
+            } else {
+                std::stringstream ss;
+                ss << "column(" << slot_desc->col_name() << ") value is null";
+                *error_msg = ss.str();
+                return false;
+            }
+        }
+        dest_tuple->set_not_null(slot_desc->null_indicator_offset());
+        void* slot = dest_tuple->get_slot(slot_desc->tuple_offset());
+        RawValue::write(value, slot, slot_desc->type(), mem_pool);
+    }
+    return true;
+}
+
+}
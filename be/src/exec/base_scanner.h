@@ -0,0 +1,112 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "gen_cpp/Types_types.h"
+#include "runtime/mem_pool.h"
+#include "util/runtime_profile.h"
+
+namespace palo {
+
+class FileReader;
+class Tuple;
+class SlotDescriptor;
+class RuntimeState;
+class ExprContext;
+class TupleDescriptor;
+class TupleRow;
+class RowDescriptor;
+class MemTracker;
+
+struct BrokerScanCounter {
+    BrokerScanCounter() : num_rows_returned(0), num_rows_filtered(0) {
+    }
+    
+    int64_t num_rows_returned;
+    int64_t num_rows_filtered;
+};
+
+// Base of scanners used by BrokerScanNode.
+// Derived scanner fills values read from file into source tuple, and
+// then the dest tuple is computed from source tuple by exprs of dest slots.
+class BaseScanner {
+public:
+    BaseScanner(RuntimeState* state,
+                RuntimeProfile* profile,
+                const TBrokerScanRangeParams& params,
+                BrokerScanCounter* counter);
+    virtual ~BaseScanner();
+
+    // Open this scanner, will initialize information needed
+    virtual Status open();
+
+    // Get next tuple
+    virtual Status get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof) = 0;
+
+    // Close this scanner
+    virtual void close();
+
+protected:
+    Status init_expr_ctxes();
+
+    // Open reader of file described by 'range', reading from 'start_offset'
+    Status create_file_reader(const TBrokerRangeDesc& range, int64_t start_offset,
+                              const std::vector<TNetworkAddress>& broker_addresses,
+                              std::shared_ptr<FileReader>* file_reader);
+
+    // Compute dest tuple from _src_tuple. Return false if this row
+    // should be filtered, and reason is saved in 'error_msg'.
+    bool fill_dest_tuple(Tuple* dest_tuple, MemPool* mem_pool, std::string* error_msg);
+
+    RuntimeState* _state;
+    RuntimeProfile* _profile;
+    const TBrokerScanRangeParams& _params;
+
+    // Used for constructing tuple
+    // slots for value read from file
+    std::vector<SlotDescriptor*> _src_slot_descs;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    Tuple* _src_tuple;
+    TupleRow* _src_tuple_row;
+
+    // Mem pool used to allocate _src_tuple and _src_tuple_row
+    MemPool _mem_pool;
+
+    // Dest tuple descriptor and dest expr context
+    const TupleDescriptor* _dest_tuple_desc;
+    std::vector<ExprContext*> _dest_expr_ctx;
+
+    std::unique_ptr<MemTracker> _mem_tracker;
+
+    // used for process stat
+    BrokerScanCounter* _counter;
+
+    // Profile
+    RuntimeProfile::Counter* _rows_read_counter;
+    RuntimeProfile::Counter* _read_timer;
+    RuntimeProfile::Counter* _materialize_timer;
+
+private:
+    bool _is_closed;
+};
+
+}
@@ -22,6 +22,7 @@
 #include "runtime/runtime_state.h"
 #include "runtime/row_batch.h"
 #include "runtime/dpp_sink_internal.h"
+#include "exec/arrow_scanner.h"
 #include "exec/broker_scanner.h"
 #include "exprs/expr.h"
 #include "util/debug_util.h"
@@ -266,18 +267,68 @@ void BrokerScanNode::debug_string(int ident_level, std::stringstream* out) const
     (*out) << "BrokerScanNode";
 }
 
+BaseScanner* BrokerScanNode::create_scanner(
+        const TBrokerScanRange& scan_range,
+        const std::vector<TBrokerRangeDesc>& ranges,
+        BrokerScanCounter* counter) {
+    if (ranges[0].format_type == TFileFormatType::FORMAT_ARROW_STREAM) {
+        return new ArrowScanner(
+                _runtime_state,
+                runtime_profile(),
+                scan_range.params,
+                ranges,
+                scan_range.broker_addresses,
+                counter);
+    }
+    return new BrokerScanner(
+            _runtime_state,
+            runtime_profile(),
+            scan_range.params,
+            ranges,
+            scan_range.broker_addresses,
+            counter);
+}
+
 Status BrokerScanNode::scanner_scan(
         const TBrokerScanRange& scan_range, 
         const std::vector<ExprContext*>& conjunct_ctxs, 
         const std::vector<ExprContext*>& partition_expr_ctxs,
         BrokerScanCounter* counter) {
-    std::unique_ptr<BrokerScanner> scanner(new BrokerScanner(
-            _runtime_state, 
-            runtime_profile(),
-            scan_range.params, 
-            scan_range.ranges, 
-            scan_range.broker_addresses, 
-            counter));
+    // Files of one scan range may be of different formats, consecutive
+    // ranges of the same format are read by one scanner.
+    const std::vector<TBrokerRangeDesc>& all_ranges = scan_range.ranges;
+    size_t begin = 0;
+    while (begin < all_ranges.size()) {
+        size_t end = begin + 1;
+        while (end < all_ranges.size()
+                && all_ranges[end].format_type == all_ranges[begin].format_type) {
+            ++end;
+        }
+        std::vector<TBrokerRangeDesc> ranges(all_ranges.begin() + begin,
+                                             all_ranges.begin() + end);
+        std::unique_ptr<BaseScanner> scanner(create_scanner(scan_range, ranges, counter));
+        RETURN_IF_ERROR(scanner_scan(scanner.get(), scan_range, conjunct_ctxs,
+                                     partition_expr_ctxs, counter));
+        if (_scan_finished.load() || _runtime_state->is_cancelled()) {
+            break;
+        }
+        {
+            std::unique_lock<std::mutex> l(_batch_queue_lock);
+            if (!_process_status.ok()) {
+                break;
+            }
+        }
+        begin = end;
+    }
+    return Status::OK;
+}
+
+Status BrokerScanNode::scanner_scan(
+        BaseScanner* scanner,
+        const TBrokerScanRange& scan_range, 
+        const std::vector<ExprContext*>& conjunct_ctxs, 
+        const std::vector<ExprContext*>& partition_expr_ctxs,
+        BrokerScanCounter* counter) {
     RETURN_IF_ERROR(scanner->open());
     bool scanner_eof = false;
     
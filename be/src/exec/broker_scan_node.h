@@ -33,6 +33,7 @@ class RuntimeState;
 class PartRangeKey;
 class PartitionInfo;
 class BrokerScanCounter;
+class BaseScanner;
 
 class BrokerScanNode : public ScanNode {
 public:
@@ -92,6 +93,18 @@ private:
                         const std::vector<ExprContext*>& partition_expr_ctxs,
                         BrokerScanCounter* counter);
 
+    // Scan files of one range with 'scanner'
+    Status scanner_scan(BaseScanner* scanner,
+                        const TBrokerScanRange& scan_range,
+                        const std::vector<ExprContext*>& conjunct_ctxs,
+                        const std::vector<ExprContext*>& partition_expr_ctxs,
+                        BrokerScanCounter* counter);
+
+    // Create scanner for 'ranges' which are all of the same format
+    BaseScanner* create_scanner(const TBrokerScanRange& scan_range,
+                                const std::vector<TBrokerRangeDesc>& ranges,
+                                BrokerScanCounter* counter);
+
     // Find partition id with PartRangeKey
     int64_t binary_find_partition_id(const PartRangeKey& key) const;
 
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <iostream>
 
+#include "common/config.h"
 #include "runtime/descriptors.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/raw_value.h"
@@ -26,9 +27,10 @@
 #include "exec/text_converter.h"
 #include "exec/text_converter.hpp"
 #include "exec/plain_text_line_reader.h"
-#include "exec/local_file_reader.h"
-#include "exec/broker_reader.h"
 #include "exec/decompressor.h"
+#include "exec/decompress_prefetch_reader.h"
+#include "runtime/runtime_state.h"
+#include "util/debug_util.h"
 
 namespace palo {
 
@@ -70,107 +72,31 @@ BrokerScanner::BrokerScanner(RuntimeState* state,
                              const std::vector<TBrokerRangeDesc>& ranges,
                              const std::vector<TNetworkAddress>& broker_addresses,
                              BrokerScanCounter* counter) : 
-        _state(state),
-        _profile(profile),
-        _params(params),
+        BaseScanner(state, profile, params, counter),
         _ranges(ranges),
         _broker_addresses(broker_addresses),
         // _splittable(params.splittable),
         _value_separator(params.column_separator),
         _line_delimiter(params.line_delimiter),
-        _cur_file_reader(nullptr),
         _cur_line_reader(nullptr),
         _cur_decompressor(nullptr),
         _next_range(0),
         _cur_line_reader_eof(false),
         _scanner_eof(false),
-        _skip_next_line(false),
-        _src_tuple(nullptr),
-        _src_tuple_row(nullptr),
-        _mem_pool(_state->instance_mem_tracker()),
-        _dest_tuple_desc(nullptr),
-        _mem_tracker(new MemTracker(-1, "Broker Scanner", state->instance_mem_tracker())),
-        _counter(counter),
-        _rows_read_counter(nullptr),
-        _read_timer(nullptr),
-        _materialize_timer(nullptr) {
+        _skip_next_line(false) {
 }
 
 BrokerScanner::~BrokerScanner() {
     close();
 }
 
-Status BrokerScanner::init_expr_ctxes() {
-    // Constcut _src_slot_descs
-    const TupleDescriptor* src_tuple_desc = 
-        _state->desc_tbl().get_tuple_descriptor(_params.src_tuple_id);
-    if (src_tuple_desc == nullptr) {
-        std::stringstream ss;
-        ss << "Unknown source tuple descriptor, tuple_id=" << _params.src_tuple_id;
-        return Status(ss.str());
-    }
-
-    std::map<SlotId, SlotDescriptor*> src_slot_desc_map;
-    for (auto slot_desc : src_tuple_desc->slots()) {
-        src_slot_desc_map.emplace(slot_desc->id(), slot_desc);
-    }
-    for (auto slot_id : _params.src_slot_ids) {
-        auto it = src_slot_desc_map.find(slot_id);
-        if (it == std::end(src_slot_desc_map)) {
-            std::stringstream ss;
-            ss << "Unknown source slot descriptor, slot_id=" << slot_id;
-            return Status(ss.str());
-        }
-        _src_slot_descs.emplace_back(it->second);
-    }
-    // Construct source tuple and tuple row
-    _src_tuple = (Tuple*) _mem_pool.allocate(src_tuple_desc->byte_size());
-    _src_tuple_row = (TupleRow*) _mem_pool.allocate(sizeof(Tuple*));
-    _src_tuple_row->set_tuple(0, _src_tuple);
-    _row_desc.reset(new RowDescriptor(_state->desc_tbl(), 
-                                      std::vector<TupleId>({_params.src_tuple_id}), 
-                                      std::vector<bool>({false})));
-
-    // Construct dest slots information
-    _dest_tuple_desc = _state->desc_tbl().get_tuple_descriptor(_params.dest_tuple_id);
-    if (_dest_tuple_desc == nullptr) {
-        std::stringstream ss;
-        ss << "Unknown dest tuple descriptor, tuple_id=" << _params.dest_tuple_id;
-        return Status(ss.str());
-    }
-
-    for (auto slot_desc : _dest_tuple_desc->slots()) {
-        if (!slot_desc->is_materialized()) {
-            continue;
-        }
-        auto it = _params.expr_of_dest_slot.find(slot_desc->id());
-        if (it == std::end(_params.expr_of_dest_slot)) {
-            std::stringstream ss;
-            ss << "No expr for dest slot, id=" << slot_desc->id() 
-                << ", name=" << slot_desc->col_name();
-            return Status(ss.str());
-        }
-        ExprContext* ctx = nullptr;
-        RETURN_IF_ERROR(Expr::create_expr_tree(_state->obj_pool(), it->second, &ctx));
-        RETURN_IF_ERROR(ctx->prepare(_state, *_row_desc.get(), _mem_tracker.get()));
-        RETURN_IF_ERROR(ctx->open(_state));
-        _dest_expr_ctx.emplace_back(ctx);
-    }
-
-    return Status::OK;
-}
-
 Status BrokerScanner::open() {
-    RETURN_IF_ERROR(init_expr_ctxes());
+    RETURN_IF_ERROR(BaseScanner::open());
     _text_converter.reset(new(std::nothrow) TextConverter('\\'));
     if (_text_converter == nullptr) {
         return Status("No memory error.");
     }
 
-    _rows_read_counter = ADD_COUNTER(_profile, "RowsRead", TUnit::UNIT);
-    _read_timer = ADD_TIMER(_profile, "TotalRawReadTime(*)");
-    _materialize_timer = ADD_TIMER(_profile, "MaterializeTupleTime(*)");
-
     return Status::OK;
 }
 
@@ -227,9 +153,10 @@ Status BrokerScanner::open_next_reader() {
 }
 
 Status BrokerScanner::open_file_reader() {
+    _cur_prefetch_reader.reset();
     if (_cur_file_reader != nullptr) {
-        delete _cur_file_reader;
-        _cur_file_reader = nullptr;
+        _cur_file_reader->close();
+        _cur_file_reader.reset();
     }
 
     const TBrokerRangeDesc& range = _ranges[_next_range];
@@ -237,27 +164,7 @@ Status BrokerScanner::open_file_reader() {
     if (start_offset != 0) {
         start_offset -= 1;
     }
-    switch (range.file_type) {
-    case TFileType::FILE_LOCAL: {
-        LocalFileReader* file_reader = new LocalFileReader(range.path, start_offset);
-        RETURN_IF_ERROR(file_reader->open());
-        _cur_file_reader = file_reader;
-        break;
-    }
-    case TFileType::FILE_BROKER: {
-        BrokerReader* broker_reader = new BrokerReader(
-            _state, _broker_addresses, _params.properties, range.path, start_offset);
-        RETURN_IF_ERROR(broker_reader->open());
-        _cur_file_reader = broker_reader;
-        break;
-    }
-    default: {
-        std::stringstream ss;
-        ss << "Unknown file type, type=" << range.file_type;
-        return Status(ss.str());
-    }
-    }
-    return Status::OK;
+    return create_file_reader(range, start_offset, _broker_addresses, &_cur_file_reader);
 }
 
 Status BrokerScanner::create_decompressor(TFileFormatType::type type) {
@@ -324,18 +231,35 @@ Status BrokerScanner::open_line_reader() {
     // _decompressor may be NULL if this is not a compressed file
     RETURN_IF_ERROR(create_decompressor(range.format_type));
 
+    FileReader* file_reader = _cur_file_reader.get();
+    Decompressor* decompressor = _cur_decompressor;
+    if (decompressor != nullptr && config::enable_load_prefetch_decompress) {
+        // decompress in another thread, line reader reads plain text from it
+        _cur_prefetch_reader.reset(new DecompressPrefetchReader(
+                _profile, file_reader, decompressor,
+                config::load_decompress_buffer_bytes));
+        RETURN_IF_ERROR(_cur_prefetch_reader->open());
+        file_reader = _cur_prefetch_reader.get();
+        decompressor = nullptr;
+        // compressed file is never split, so read to the end of decompressed data
+        size = -1;
+    }
+
     // open line reader
     switch (range.format_type) {
     case TFileFormatType::FORMAT_CSV_PLAIN:
     case TFileFormatType::FORMAT_CSV_GZ:
     case TFileFormatType::FORMAT_CSV_BZ2:
     case TFileFormatType::FORMAT_CSV_LZ4FRAME:
-    case TFileFormatType::FORMAT_CSV_LZOP:
-        _cur_line_reader = new PlainTextLineReader(
-                _profile,
-                _cur_file_reader, _cur_decompressor,
+    case TFileFormatType::FORMAT_CSV_LZOP: {
+        PlainTextLineReader* line_reader = new PlainTextLineReader(
+                _profile, file_reader, decompressor,
                 size, _line_delimiter);
+        // find value separators while searching line delimiter
+        line_reader->set_field_separator(_value_separator);
+        _cur_line_reader = line_reader;
         break;
+    }
     default: {
         std::stringstream ss;
         ss << "Unknown format type, type=" << range.format_type;
@@ -349,6 +273,7 @@ Status BrokerScanner::open_line_reader() {
 }
 
 void BrokerScanner::close() {
+    _cur_prefetch_reader.reset();
     if (_cur_decompressor != nullptr) {
         delete _cur_decompressor;
         _cur_decompressor = nullptr;
@@ -360,14 +285,26 @@ void BrokerScanner::close() {
     }
 
     if (_cur_file_reader != nullptr) {
-        delete _cur_file_reader;
-        _cur_file_reader = nullptr;
+        _cur_file_reader->close();
+        _cur_file_reader.reset();
     }
-    Expr::close(_dest_expr_ctx, _state);
+    BaseScanner::close();
 }
 
 void BrokerScanner::split_line(
         const Slice& line, std::vector<Slice>* values) {
+    const std::vector<size_t>* field_pos = _cur_line_reader->field_separator_pos();
+    if (field_pos != nullptr) {
+        // line reader has found all separators of this line
+        size_t begin = 0;
+        for (size_t pos : *field_pos) {
+            values->emplace_back(line.data() + begin, pos - begin);
+            begin = pos + 1;
+        }
+        values->emplace_back(line.data() + begin, line.size() - begin);
+        return;
+    }
+
     // line-begin char and line-end char are considered to be 'delimeter'
     const uint8_t* value = line.data();
     const uint8_t* ptr = line.data();
@@ -538,10 +475,10 @@ bool BrokerScanner::convert_one_row(
 
 // Convert one row to this tuple
 bool BrokerScanner::line_to_src_tuple(const Slice& line) {
-    std::vector<Slice> values;
-    {
-        split_line(line, &values);
-    }
+    // reuse vector to avoid allocating for every line
+    std::vector<Slice>& values = _split_values;
+    values.clear();
+    split_line(line, &values);
 
     if (values.size() < _src_slot_descs.size()) {
         std::stringstream error_msg;
@@ -581,29 +518,12 @@ bool BrokerScanner::line_to_src_tuple(const Slice& line) {
 }
 
 bool BrokerScanner::fill_dest_tuple(const Slice& line, Tuple* dest_tuple, MemPool* mem_pool) {
-    int ctx_idx = 0;
-    for (auto slot_desc : _dest_tuple_desc->slots()) {
-        if (!slot_desc->is_materialized()) {
-            continue;
-        }
-        ExprContext* ctx = _dest_expr_ctx[ctx_idx++];
-        void* value = ctx->get_value(_src_tuple_row);
-        if (value == nullptr) {
-            if (slot_desc->is_nullable()) {
-                dest_tuple->set_null(slot_desc->null_indicator_offset());
-                continue;
-            } else {
-                std::stringstream error_msg;
-                error_msg << "column(" << slot_desc->col_name() << ") value is null";
-                _state->append_error_msg_to_file(
-                    std::string((const char*)line.data(), line.size()), error_msg.str());
-                _counter->num_rows_filtered++;
-                return false;
-            }
-        }
-        dest_tuple->set_not_null(slot_desc->null_indicator_offset());
-        void* slot = dest_tuple->get_slot(slot_desc->tuple_offset());
-        RawValue::write(value, slot, slot_desc->type(), mem_pool);
+    std::string error_msg;
+    if (!BaseScanner::fill_dest_tuple(dest_tuple, mem_pool, &error_msg)) {
+        _state->append_error_msg_to_file(
+            std::string((const char*)line.data(), line.size()), error_msg);
+        _counter->num_rows_filtered++;
+        return false;
     }
     return true;
 }
@@ -22,6 +22,7 @@
 #include <sstream>
 
 #include "common/status.h"
+#include "exec/base_scanner.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gen_cpp/Types_types.h"
 #include "runtime/mem_pool.h"
@@ -36,6 +37,7 @@ class TextConverter;
 class FileReader;
 class LineReader;
 class Decompressor;
+class DecompressPrefetchReader;
 class RuntimeState;
 class ExprContext;
 class TupleDescriptor;
@@ -44,16 +46,8 @@ class RowDescriptor;
 class MemTracker;
 class RuntimeProfile;
 
-struct BrokerScanCounter {
-    BrokerScanCounter() : num_rows_returned(0), num_rows_filtered(0) {
-    }
-    
-    int64_t num_rows_returned;
-    int64_t num_rows_filtered;
-};
-
 // Broker scanner convert the data read from broker to palo's tuple.
-class BrokerScanner {
+class BrokerScanner : public BaseScanner {
 public:
     BrokerScanner(
         RuntimeState* state,
@@ -62,16 +56,16 @@ public:
         const std::vector<TBrokerRangeDesc>& ranges,
         const std::vector<TNetworkAddress>& broker_addresses,
         BrokerScanCounter* counter);
-    ~BrokerScanner();
+    virtual ~BrokerScanner();
 
     // Open this scanner, will initialize informtion need to 
-    Status open();
+    virtual Status open() override;
 
     // Get next tuple 
-    Status get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof);
+    virtual Status get_next(Tuple* tuple, MemPool* tuple_pool, bool* eof) override;
 
     // Close this scanner
-    void close();
+    virtual void close() override;
 
 private:
     Status open_file_reader();
@@ -104,15 +98,10 @@ private:
     //  output is tuple
     bool convert_one_row(const Slice& line, Tuple* tuple, MemPool* tuple_pool);
 
-    Status init_expr_ctxes();
-
     Status line_to_src_tuple();
     bool line_to_src_tuple(const Slice& line);
     bool fill_dest_tuple(const Slice& line, Tuple* dest_tuple, MemPool* mem_pool);
 private:
-    RuntimeState* _state;
-    RuntimeProfile* _profile;
-    const TBrokerScanRangeParams& _params;
     const std::vector<TBrokerRangeDesc>& _ranges;
     const std::vector<TNetworkAddress>& _broker_addresses;
 
@@ -122,9 +111,12 @@ private:
     uint8_t _line_delimiter;
 
     // Reader
-    FileReader* _cur_file_reader;
+    std::shared_ptr<FileReader> _cur_file_reader;
     LineReader* _cur_line_reader;
     Decompressor* _cur_decompressor;
+    // decompress current file in background, it uses _cur_file_reader
+    // and _cur_decompressor, so it must be closed before them
+    std::unique_ptr<DecompressPrefetchReader> _cur_prefetch_reader;
     int _next_range;
     bool _cur_line_reader_eof;
 
@@ -134,29 +126,8 @@ private:
     // we will read to one ahead, and skip the first line
     bool _skip_next_line;
 
-    // Used for constructing tuple
-    // slots for value read from broker file
-    std::vector<SlotDescriptor*> _src_slot_descs;
-    std::unique_ptr<RowDescriptor> _row_desc;
-    Tuple* _src_tuple;
-    TupleRow* _src_tuple_row;
-
-    // Mem pool used to allocate _src_tuple and _src_tuple_row
-    MemPool _mem_pool;
-
-    // Dest tuple descriptor and dest expr context
-    const TupleDescriptor* _dest_tuple_desc;
-    std::vector<ExprContext*> _dest_expr_ctx;
-
-    std::unique_ptr<MemTracker> _mem_tracker;
-
-    // used for process stat
-    BrokerScanCounter* _counter;
-
-    // Profile
-    RuntimeProfile::Counter* _rows_read_counter;
-    RuntimeProfile::Counter* _read_timer;
-    RuntimeProfile::Counter* _materialize_timer;
+    // values of current line
+    std::vector<Slice> _split_values;
 };
 
 }
@@ -0,0 +1,193 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec/decompress_prefetch_reader.h"
+
+#include <string.h>
+
+#include <sstream>
+
+#include "common/logging.h"
+#include "exec/decompressor.h"
+
+// Same as chunks used by PlainTextLineReader
+#define INPUT_CHUNK  (2 * 1024 * 1024)
+#define OUTPUT_CHUNK (8 * 1024 * 1024)
+
+namespace palo {
+
+DecompressPrefetchReader::DecompressPrefetchReader(
+        RuntimeProfile* profile,
+        FileReader* file_reader,
+        Decompressor* decompressor,
+        size_t max_buffered_bytes) :
+            _file_reader(file_reader),
+            _decompressor(decompressor),
+            _pipe(max_buffered_bytes),
+            _input_buf(new uint8_t[INPUT_CHUNK]),
+            _input_buf_size(INPUT_CHUNK),
+            _input_buf_pos(0),
+            _input_buf_limit(0),
+            _output_buf(new uint8_t[OUTPUT_CHUNK]),
+            _output_buf_size(OUTPUT_CHUNK) {
+    // line reader counts decompressed bytes read from us as BytesRead
+    _bytes_read_counter = ADD_COUNTER(profile, "CompressedBytesRead", TUnit::BYTES);
+    _read_timer = ADD_TIMER(profile, "CompressedFileReadTime");
+    _bytes_decompress_counter = ADD_COUNTER(profile, "BytesDecompressed", TUnit::BYTES);
+    _decompress_timer = ADD_TIMER(profile, "DecompressTime");
+}
+
+DecompressPrefetchReader::~DecompressPrefetchReader() {
+    close();
+    delete[] _input_buf;
+    delete[] _output_buf;
+}
+
+Status DecompressPrefetchReader::open() {
+    _thread = std::thread(&DecompressPrefetchReader::_decompress_thread, this);
+    return Status::OK;
+}
+
+void DecompressPrefetchReader::close() {
+    // wake up background thread if it is blocked in appending
+    _pipe.cancel();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+Status DecompressPrefetchReader::read(uint8_t* buf, size_t* buf_len, bool* eof) {
+    Status st = _pipe.read(buf, buf_len, eof);
+    if (!st.ok()) {
+        std::lock_guard<std::mutex> l(_lock);
+        if (!_status.ok()) {
+            return _status;
+        }
+    }
+    return st;
+}
+
+void DecompressPrefetchReader::_decompress_thread() {
+    Status st = _decompress();
+    if (st.ok()) {
+        st = _pipe.finish();
+    }
+    if (!st.ok()) {
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            _status = st;
+        }
+        _pipe.cancel();
+    }
+}
+
+// make sure there are at least 'more_input_bytes' free space after input limit
+void DecompressPrefetchReader::_extend_input_buf(size_t more_input_bytes) {
+    if (_input_buf_size - _input_buf_limit >= more_input_bytes) {
+        return;
+    }
+    size_t remaining = _input_buf_limit - _input_buf_pos;
+    if (_input_buf_size - remaining >= more_input_bytes) {
+        memmove(_input_buf, _input_buf + _input_buf_pos, remaining);
+    } else {
+        while (_input_buf_size - remaining < more_input_bytes) {
+            _input_buf_size = _input_buf_size * 2;
+        }
+        uint8_t* new_input_buf = new uint8_t[_input_buf_size];
+        memcpy(new_input_buf, _input_buf + _input_buf_pos, remaining);
+        delete[] _input_buf;
+        _input_buf = new_input_buf;
+    }
+    _input_buf_pos = 0;
+    _input_buf_limit = remaining;
+}
+
+Status DecompressPrefetchReader::_decompress() {
+    bool stream_end = false;
+    size_t more_input_bytes = 0;
+    size_t more_output_bytes = 0;
+    while (true) {
+        if (_input_buf_pos == _input_buf_limit || more_input_bytes > 0) {
+            if (more_input_bytes > 0) {
+                _extend_input_buf(more_input_bytes);
+            } else {
+                // all data in input buf has been consumed
+                _input_buf_pos = 0;
+                _input_buf_limit = 0;
+            }
+            size_t read_len = _input_buf_size - _input_buf_limit;
+            bool file_eof = false;
+            {
+                SCOPED_TIMER(_read_timer);
+                RETURN_IF_ERROR(_file_reader->read(
+                        _input_buf + _input_buf_limit, &read_len, &file_eof));
+                COUNTER_UPDATE(_bytes_read_counter, read_len);
+            }
+            if (file_eof || read_len == 0) {
+                if (!stream_end) {
+                    return Status("Compressed file has been truncated, which is not allowed");
+                }
+                return Status::OK;
+            }
+            _input_buf_limit += read_len;
+            if (read_len < more_input_bytes) {
+                // we failed to read enough data, continue to read from file
+                more_input_bytes -= read_len;
+                continue;
+            }
+        }
+
+        size_t input_read_bytes = 0;
+        size_t decompressed_len = 0;
+        more_input_bytes = 0;
+        more_output_bytes = 0;
+        {
+            SCOPED_TIMER(_decompress_timer);
+            RETURN_IF_ERROR(_decompressor->decompress(
+                    _input_buf + _input_buf_pos, _input_buf_limit - _input_buf_pos,
+                    &input_read_bytes,
+                    _output_buf, _output_buf_size,
+                    &decompressed_len,
+                    &stream_end,
+                    &more_input_bytes,
+                    &more_output_bytes));
+        }
+        _input_buf_pos += input_read_bytes;
+        COUNTER_UPDATE(_bytes_decompress_counter, decompressed_len);
+
+        if (decompressed_len > 0) {
+            // blocked here if reader is slower than us
+            RETURN_IF_ERROR(_pipe.append(
+                    reinterpret_cast<const char*>(_output_buf), decompressed_len));
+        }
+        if (more_output_bytes > 0) {
+            // decompressed data has been consumed, so just reallocate it
+            _output_buf_size += more_output_bytes;
+            delete[] _output_buf;
+            _output_buf = new uint8_t[_output_buf_size];
+        }
+        if (input_read_bytes == 0 && decompressed_len == 0
+                && more_input_bytes == 0 && more_output_bytes == 0) {
+            std::stringstream ss;
+            ss << "decompress made no progess. decompressor: "
+               << _decompressor->debug_info();
+            LOG(WARNING) << ss.str();
+            return Status(ss.str());
+        }
+    }
+    return Status::OK;
+}
+
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <mutex>
+#include <thread>
+
+#include "common/status.h"
+#include "exec/file_reader.h"
+#include "runtime/stream_load_pipe.h"
+#include "util/runtime_profile.h"
+
+namespace palo {
+
+class Decompressor;
+
+// DecompressPrefetchReader decompresses a file in a background thread,
+// and provides decompressed content as an uncompressed file. So that
+// decompressing is pipelined with line splitting and parsing which are
+// done by the thread reading from this reader.
+// Background thread is blocked when too much decompressed data is buffered.
+class DecompressPrefetchReader : public FileReader {
+public:
+    // 'file_reader' and 'decompressor' are not owned by this reader,
+    // and must be alive until this reader is closed.
+    DecompressPrefetchReader(RuntimeProfile* profile,
+                             FileReader* file_reader,
+                             Decompressor* decompressor,
+                             size_t max_buffered_bytes);
+    virtual ~DecompressPrefetchReader();
+
+    // Start the background decompressing thread
+    Status open();
+
+    virtual Status read(uint8_t* buf, size_t* buf_len, bool* eof) override;
+
+    // Stop background thread and wait it to exit
+    virtual void close() override;
+
+private:
+    void _decompress_thread();
+    Status _decompress();
+    void _extend_input_buf(size_t more_input_bytes);
+
+    FileReader* _file_reader;
+    Decompressor* _decompressor;
+    StreamLoadPipe _pipe;
+    std::thread _thread;
+
+    std::mutex _lock;
+    // Error of background thread, returned to reader
+    Status _status;
+
+    uint8_t* _input_buf;
+    size_t _input_buf_size;
+    size_t _input_buf_pos;
+    size_t _input_buf_limit;
+
+    uint8_t* _output_buf;
+    size_t _output_buf_size;
+
+    RuntimeProfile::Counter* _bytes_read_counter;
+    RuntimeProfile::Counter* _read_timer;
+    RuntimeProfile::Counter* _bytes_decompress_counter;
+    RuntimeProfile::Counter* _decompress_timer;
+};
+
+}
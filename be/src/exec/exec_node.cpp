@@ -28,6 +28,7 @@
 #include "codegen/codegen_anyval.h"
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "exprs/expr_column.h"
 #include "exprs/expr_context.h"
 #include "exec/aggregation_node.h"
 #include "exec/partitioned_aggregation_node.h"
@@ -490,6 +491,24 @@ bool ExecNode::eval_conjuncts(ExprContext* const* ctxs, int num_ctxs, TupleRow*
     return true;
 }
 
+Status ExecNode::eval_conjuncts_batch(ExprContext* const* ctxs, int num_ctxs,
+                                      RowBatch* batch, MemPool* pool,
+                                      int* sel, int* num_rows) {
+    for (int i = 0; i < num_ctxs && *num_rows > 0; ++i) {
+        ExprColumn result;
+        RETURN_IF_ERROR(ctxs[i]->evaluate_batch(batch, sel, *num_rows, pool, &result));
+        // values of null rows are false
+        const bool* values = result.data<bool>();
+        int num_selected = 0;
+        for (int j = 0; j < *num_rows; ++j) {
+            sel[num_selected] = sel[j];
+            num_selected += values[j];
+        }
+        *num_rows = num_selected;
+    }
+    return Status::OK;
+}
+
 void ExecNode::collect_nodes(TPlanNodeType::type node_type, vector<ExecNode*>* nodes) {
     if (_type == node_type) {
         nodes->push_back(this);
@@ -160,6 +160,14 @@ public:
     // out how to deal with declaring a templated std:vector type in IR
     static bool eval_conjuncts(ExprContext* const* ctxs, int num_ctxs, TupleRow* row);
 
+    // Evaluate exprs over rows sel[0], ..., sel[*num_rows - 1] of batch a column at a
+    // time, and keep in 'sel' only the rows for which all exprs return true. Each expr
+    // is only evaluated over rows passing previous ones. Results of exprs are allocated
+    // from 'pool'.
+    static Status eval_conjuncts_batch(ExprContext* const* ctxs, int num_ctxs,
+                                       RowBatch* batch, MemPool* pool,
+                                       int* sel, int* num_rows);
+
     // Returns a string representation in DFS order of the plan rooted at this.
     std::string debug_string() const;
 
@@ -414,7 +414,7 @@ Function* HashTable::codegen_eval_tuple_row(RuntimeState* state, bool build) {
     for (int i = 0; i < ctxs.size(); ++i) {
         PrimitiveType type = ctxs[i]->root()->type().type;
         if (type == TYPE_DATE || type == TYPE_DATETIME
-                || type == TYPE_DECIMAL || type == TYPE_CHAR) {
+                || type == TYPE_DECIMAL || type == TYPE_DECIMALV2 || type == TYPE_CHAR) {
             return NULL;
         }
     }
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "common/status.h"
 
 namespace palo {
@@ -31,6 +33,13 @@ public:
     }
     virtual Status read_line(const uint8_t** ptr, size_t* size, bool* eof) = 0;
 
+    // Positions of field separators in the line returned by last read_line,
+    // they are offsets from the begin of line. Return nullptr if this reader
+    // doesn't record field separators, caller should split line by itself.
+    virtual const std::vector<size_t>* field_separator_pos() const {
+        return nullptr;
+    }
+
     virtual void close() = 0;
 };
 
@@ -24,6 +24,7 @@
 #include "runtime/raw_value.h"
 #include "runtime/tuple.h"
 #include "util/debug_util.h"
+#include "util/types.h"
 
 namespace palo {
 
@@ -57,10 +58,16 @@ Status OlapRewriteNode::prepare(RuntimeState* state) {
             new RowBatch(child(0)->row_desc(), state->batch_size(), state->fragment_mem_tracker()));
 
     _max_decimal_val.resize(_column_types.size());
+    _max_decimalv2_val.resize(_column_types.size());
     for (int i = 0; i < _column_types.size(); ++i) {
         if (_column_types[i].type == TPrimitiveType::DECIMAL) {
             _max_decimal_val[i].to_max_decimal(
                 _column_types[i].precision, _column_types[i].scale);
+        } else if (_column_types[i].type == TPrimitiveType::DECIMALV2) {
+            const TColumnType& column_type = _column_types[i];
+            std::string max_str(column_type.precision - column_type.scale, '9');
+            max_str.append(".").append(column_type.scale, '9');
+            _max_decimalv2_val[i].parse_from_str(max_str.c_str(), max_str.size());
         }
     }
     return Status::OK;
@@ -178,6 +185,25 @@ bool OlapRewriteNode::copy_one_row(TupleRow* src_row, Tuple* tuple,
             }
             break;
         }
+        case TPrimitiveType::DECIMALV2: {
+            // fraction digits beyond scale are truncated
+            __int128 value = reinterpret_cast<const PackedInt128*>(src_value)->value;
+            for (int j = column_type.scale; j < DecimalV2Value::SCALE; ++j) {
+                value /= 10;
+            }
+            for (int j = column_type.scale; j < DecimalV2Value::SCALE; ++j) {
+                value *= 10;
+            }
+            DecimalV2Value dec_val = DecimalV2Value::from_raw(value);
+            if (dec_val > _max_decimalv2_val[i]) {
+                dec_val = _max_decimalv2_val[i];
+            } else if (dec_val.value() < -_max_decimalv2_val[i].value()) {
+                dec_val = DecimalV2Value::from_raw(-_max_decimalv2_val[i].value());
+            }
+            reinterpret_cast<PackedInt128*>(tuple->get_slot(slot_desc->tuple_offset()))->value =
+                dec_val.value();
+            break;
+        }
         default: {
             void* dst_val = (void*)tuple->get_slot(slot_desc->tuple_offset());
             RawValue::write(src_value, dst_val, slot_desc->type(), pool);
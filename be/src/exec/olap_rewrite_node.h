@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "exec/exec_node.h"
+#include "runtime/decimalv2_value.h"
 #include "runtime/mem_pool.h"
 
 namespace palo {
@@ -61,6 +62,7 @@ private:
     TupleDescriptor* _output_tuple_desc;
 
     std::vector<DecimalValue> _max_decimal_val;
+    std::vector<DecimalV2Value> _max_decimalv2_val;
 };
 
 }
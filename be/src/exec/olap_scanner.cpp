@@ -30,6 +30,7 @@
 #include "util/mem_util.hpp"
 #include "util/network_util.h"
 #include "util/palo_metrics.h"
+#include "util/types.h"
 
 namespace palo {
 
@@ -195,6 +196,7 @@ Status OlapScanner::_init_params(
     for (auto cid : _return_columns) {
         _query_fields.push_back(_read_row_cursor.get_field_by_index(cid));
     }
+    _tuple_converter.init(_query_slots, _query_fields);
 
     return Status::OK;
 }
@@ -255,7 +257,7 @@ Status OlapScanner::get_batch(
 
             _num_rows_read++;
 
-            _convert_row_to_tuple(tuple);
+            _tuple_converter.convert(_read_row_cursor.get_buf(), tuple);
             if (VLOG_ROW_IS_ON) {
                 VLOG_ROW << "OlapScanner input row: " << print_tuple(tuple, *_tuple_desc);
             }
@@ -344,67 +346,135 @@ Status OlapScanner::get_batch(
     return Status::OK;
 }
 
-void OlapScanner::_convert_row_to_tuple(Tuple* tuple) {
-    char* row = _read_row_cursor.get_buf();
-    size_t slots_size = _query_slots.size();
-    for (int i = 0; i < slots_size; ++i) {
-        SlotDescriptor* slot_desc = _query_slots[i];
-        const Field* field = _query_fields[i];
-        if (field->is_null(row)) {
-            tuple->set_null(slot_desc->null_indicator_offset());
+void OlapTupleConverter::init(const std::vector<SlotDescriptor*>& slots,
+                              const std::vector<const Field*>& fields) {
+    _slot_converters.clear();
+    for (int i = 0; i < slots.size(); ++i) {
+        SlotDescriptor* slot_desc = slots[i];
+        const Field* field = fields[i];
+        SlotConvertType type = CONVERT_COPY;
+        switch (slot_desc->type().type) {
+        case TYPE_CHAR:
+            type = CONVERT_CHAR;
+            break;
+        case TYPE_VARCHAR:
+        case TYPE_HLL:
+            type = CONVERT_VARCHAR;
+            break;
+        case TYPE_DECIMAL:
+            type = CONVERT_DECIMAL;
+            break;
+        case TYPE_DECIMALV2:
+            type = CONVERT_DECIMALV2;
+            break;
+        case TYPE_DATETIME:
+            type = CONVERT_DATETIME;
+            break;
+        case TYPE_DATE:
+            type = CONVERT_DATE;
+            break;
+        default:
+            switch (field->size()) {
+            case 1:
+                type = CONVERT_COPY_1;
+                break;
+            case 2:
+                type = CONVERT_COPY_2;
+                break;
+            case 4:
+                type = CONVERT_COPY_4;
+                break;
+            case 8:
+                type = CONVERT_COPY_8;
+                break;
+            case 16:
+                type = CONVERT_COPY_16;
+                break;
+            default:
+                type = CONVERT_COPY;
+                break;
+            }
+            break;
+        }
+        _slot_converters.emplace_back(type, field->get_offset(), field->size(),
+                                      slot_desc->tuple_offset(),
+                                      slot_desc->null_indicator_offset());
+    }
+}
+
+void OlapTupleConverter::convert(char* row, Tuple* tuple) const {
+    for (const SlotConverter& converter : _slot_converters) {
+        if (*reinterpret_cast<bool*>(row + converter.field_offset)) {
+            tuple->set_null(converter.null_indicator_offset);
             continue;
         }
-        char* ptr = (char*)field->get_ptr(row);
-        size_t len = field->size();
-        switch (slot_desc->type().type) {
-        case TYPE_CHAR: {
+        char* ptr = row + converter.field_offset + 1;
+        void* slot = tuple->get_slot(converter.tuple_offset);
+        switch (converter.type) {
+        case CONVERT_COPY_1:
+            fixed_size_memory_copy<1>(slot, ptr);
+            break;
+        case CONVERT_COPY_2:
+            fixed_size_memory_copy<2>(slot, ptr);
+            break;
+        case CONVERT_COPY_4:
+            fixed_size_memory_copy<4>(slot, ptr);
+            break;
+        case CONVERT_COPY_8:
+            fixed_size_memory_copy<8>(slot, ptr);
+            break;
+        case CONVERT_COPY_16:
+            fixed_size_memory_copy<16>(slot, ptr);
+            break;
+        case CONVERT_COPY:
+            memory_copy(slot, ptr, converter.size);
+            break;
+        case CONVERT_CHAR: {
             StringSlice* slice = reinterpret_cast<StringSlice*>(ptr);
-            StringValue *slot = tuple->get_string_slot(slot_desc->tuple_offset());
-            slot->ptr = slice->data;
-            slot->len = strnlen(slot->ptr, slice->size);
+            StringValue* value = reinterpret_cast<StringValue*>(slot);
+            value->ptr = slice->data;
+            value->len = strnlen(value->ptr, slice->size);
             break;
         }
-        case TYPE_VARCHAR:
-        case TYPE_HLL: {
+        case CONVERT_VARCHAR: {
             StringSlice* slice = reinterpret_cast<StringSlice*>(ptr);
-            StringValue *slot = tuple->get_string_slot(slot_desc->tuple_offset());
-            slot->ptr = slice->data;
-            slot->len = slice->size;
+            StringValue* value = reinterpret_cast<StringValue*>(slot);
+            value->ptr = slice->data;
+            value->len = slice->size;
             break;
         }
-        case TYPE_DECIMAL: {
-            DecimalValue *slot = tuple->get_decimal_slot(slot_desc->tuple_offset());
-
+        case CONVERT_DECIMAL: {
             // TODO(lingbin): should remove this assign, use set member function
             int64_t int_value = *(int64_t*)(ptr);
             int32_t frac_value = *(int32_t*)(ptr + sizeof(int64_t));
-            *slot = DecimalValue(int_value, frac_value);
+            *reinterpret_cast<DecimalValue*>(slot) = DecimalValue(int_value, frac_value);
             break;
         }
-        case TYPE_DATETIME: {
-            DateTimeValue *slot = tuple->get_datetime_slot(slot_desc->tuple_offset());
-            uint64_t value = *reinterpret_cast<uint64_t*>(ptr);
-            if (!slot->from_olap_datetime(value)) {
-                tuple->set_null(slot_desc->null_indicator_offset());
-            }
+        case CONVERT_DECIMALV2: {
+            int64_t int_value = *(int64_t*)(ptr);
+            int32_t frac_value = *(int32_t*)(ptr + sizeof(int64_t));
+            *reinterpret_cast<PackedInt128*>(slot) =
+                DecimalV2Value::from_olap_decimal(int_value, frac_value).value();
             break;
         }
-        case TYPE_DATE: {
-            DateTimeValue *slot = tuple->get_datetime_slot(slot_desc->tuple_offset());
-            uint64_t value = 0;
-            value = *(unsigned char*)(ptr + 2);
-            value <<= 8;
-            value |= *(unsigned char*)(ptr + 1);
-            value <<= 8;
-            value |= *(unsigned char*)(ptr);
-            if (!slot->from_olap_date(value)) {
-                tuple->set_null(slot_desc->null_indicator_offset());
+        case CONVERT_DATETIME: {
+            DateTimeValue* value = reinterpret_cast<DateTimeValue*>(slot);
+            if (!value->from_olap_datetime(*reinterpret_cast<uint64_t*>(ptr))) {
+                tuple->set_null(converter.null_indicator_offset);
             }
             break;
         }
-        default: {
-            void *slot = tuple->get_slot(slot_desc->tuple_offset());
-            memory_copy(slot, ptr, len);
+        case CONVERT_DATE: {
+            DateTimeValue* value = reinterpret_cast<DateTimeValue*>(slot);
+            uint64_t date = 0;
+            date = *(unsigned char*)(ptr + 2);
+            date <<= 8;
+            date |= *(unsigned char*)(ptr + 1);
+            date <<= 8;
+            date |= *(unsigned char*)(ptr);
+            if (!value->from_olap_date(date)) {
+                tuple->set_null(converter.null_indicator_offset);
+            }
             break;
         }
         }
@@ -45,6 +45,53 @@ class OLAPReader;
 class RuntimeProfile;
 class Field;
 
+// Converts rows read from olap table into tuples. How each field is
+// converted to its slot is resolved once from slot descriptors and fields,
+// so that converting a row only walks offsets, and fixed length values are
+// copied with constant size.
+class OlapTupleConverter {
+public:
+    // 'fields' are fields of row cursor for each slot in 'slots'
+    void init(const std::vector<SlotDescriptor*>& slots,
+              const std::vector<const Field*>& fields);
+
+    // String slots of tuple point to data of row
+    void convert(char* row, Tuple* tuple) const;
+
+private:
+    enum SlotConvertType {
+        CONVERT_COPY_1,
+        CONVERT_COPY_2,
+        CONVERT_COPY_4,
+        CONVERT_COPY_8,
+        CONVERT_COPY_16,
+        CONVERT_COPY,
+        CONVERT_CHAR,
+        CONVERT_VARCHAR,
+        CONVERT_DECIMAL,
+        CONVERT_DECIMALV2,
+        CONVERT_DATETIME,
+        CONVERT_DATE,
+    };
+
+    // How a field of row is converted to a slot of tuple
+    struct SlotConverter {
+        SlotConverter(SlotConvertType type_, size_t field_offset_, size_t size_,
+                      int tuple_offset_, const NullIndicatorOffset& null_indicator_offset_) :
+                type(type_), field_offset(field_offset_), size(size_),
+                tuple_offset(tuple_offset_), null_indicator_offset(null_indicator_offset_) { }
+
+        SlotConvertType type;
+        // offset of null flag of field in row buf, value follows it
+        size_t field_offset;
+        size_t size;
+        int tuple_offset;
+        NullIndicatorOffset null_indicator_offset;
+    };
+
+    std::vector<SlotConverter> _slot_converters;
+};
+
 class OlapScanner {
 public:
     OlapScanner(
@@ -89,7 +136,6 @@ private:
         const std::vector<TCondition>& filters,
         const std::vector<TCondition>& is_nulls);
     Status _init_return_columns();
-    void _convert_row_to_tuple(Tuple* tuple);
 
     RuntimeState* _runtime_state;
     OlapScanNode* _parent;
@@ -124,6 +170,7 @@ private:
 
     std::vector<SlotDescriptor*> _query_slots;
     std::vector<const Field*> _query_fields;
+    OlapTupleConverter _tuple_converter;
 
     // time costed and row returned statistics
     ExecNode::EvalConjunctsFn _eval_conjuncts_fn = nullptr;
@@ -20,6 +20,10 @@
 
 #include "exec/plain_text_line_reader.h"
 
+#ifdef __SSE4_2__
+#include "util/sse_util.hpp"
+#endif
+
 #include "common/status.h"
 #include "exec/file_reader.h"
 #include "exec/decompressor.h"
@@ -46,6 +50,8 @@ PlainTextLineReader::PlainTextLineReader(
             _min_length(length),
             _total_read_bytes(0),
             _line_delimiter(line_delimiter),
+            _field_separator(0),
+            _save_field_pos(false),
             _input_buf(new uint8_t[INPUT_CHUNK]),
             _input_buf_size(INPUT_CHUNK),
             _input_buf_pos(0),
@@ -96,9 +102,46 @@ inline bool PlainTextLineReader::update_eof() {
 }
 
 uint8_t* PlainTextLineReader::update_field_pos_and_find_line_delimiter(
-        const uint8_t* start, size_t len) {
-    // TODO: meanwhile find and save field pos
-    return (uint8_t*) memmem(start, len, &_line_delimiter, 1);
+        const uint8_t* line, size_t offset, size_t len) {
+    const uint8_t* start = line + offset;
+    if (!_save_field_pos) {
+        return (uint8_t*) memmem(start, len, &_line_delimiter, 1);
+    }
+
+    const uint8_t* ptr = start;
+    const uint8_t* end = start + len;
+#ifdef __SSE4_2__
+    // compare 16 bytes with both line delimiter and field separator at a time,
+    // each bit in the masks stands for one byte.
+    const __m128i delimiter = _mm_set1_epi8(_line_delimiter);
+    const __m128i separator = _mm_set1_epi8(_field_separator);
+    while (ptr + sse_util::CHARS_PER_128_BIT_REGISTER <= end) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        uint32_t delimiter_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, delimiter));
+        uint32_t separator_mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chars, separator));
+        if (delimiter_mask != 0) {
+            // only keep separators before line delimiter
+            separator_mask &= (delimiter_mask & -delimiter_mask) - 1;
+        }
+        while (separator_mask != 0) {
+            _field_pos.push_back(ptr - line + __builtin_ctz(separator_mask));
+            separator_mask &= separator_mask - 1;
+        }
+        if (delimiter_mask != 0) {
+            return (uint8_t*) ptr + __builtin_ctz(delimiter_mask);
+        }
+        ptr += sse_util::CHARS_PER_128_BIT_REGISTER;
+    }
+#endif
+    for (; ptr < end; ++ptr) {
+        if (*ptr == _line_delimiter) {
+            return (uint8_t*) ptr;
+        }
+        if (*ptr == _field_separator) {
+            _field_pos.push_back(ptr - line);
+        }
+    }
+    return nullptr;
 }
 
 // extend input buf if necessary only when _more_input_bytes > 0
@@ -193,11 +236,12 @@ Status PlainTextLineReader::read_line(const uint8_t** ptr, size_t* size, bool* e
     }
     int found_line_delimiter = 0;
     size_t offset = 0;
+    _field_pos.clear();
     while (!done()) {
         // find line delimiter in current decompressed data
         uint8_t* cur_ptr = _output_buf + _output_buf_pos;
         uint8_t* pos = update_field_pos_and_find_line_delimiter(
-                cur_ptr + offset,
+                cur_ptr, offset,
                 output_buf_read_remaining() - offset);
 
         if (pos == nullptr) {
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "exec/line_reader.h"
 #include "util/runtime_profile.h"
 
@@ -39,6 +41,17 @@ public:
 
     virtual Status read_line(const uint8_t** ptr, size_t* size, bool* eof) override;
 
+    // Record positions of 'field_separator' while searching line delimiter,
+    // so that each byte is only scanned once.
+    void set_field_separator(uint8_t field_separator) {
+        _field_separator = field_separator;
+        _save_field_pos = true;
+    }
+
+    virtual const std::vector<size_t>* field_separator_pos() const override {
+        return _save_field_pos ? &_field_pos : nullptr;
+    }
+
     virtual void close() override;
 
 private:
@@ -56,11 +69,12 @@ private:
         return _file_eof && output_buf_read_remaining() == 0;
     }
 
-    // find line delimiter from 'start' to 'start' + len,
+    // find line delimiter from 'line' + 'offset' to 'line' + 'offset' + len,
     // return line delimiter pos if found, otherwise return nullptr.
-    // TODO:
-    //  save to positions of field separator
-    uint8_t* update_field_pos_and_find_line_delimiter(const uint8_t* start, size_t len);
+    // If field separator is set, positions of field separator
+    // (relative to 'line') are saved into _field_pos.
+    uint8_t* update_field_pos_and_find_line_delimiter(
+        const uint8_t* line, size_t offset, size_t len);
 
     void extend_input_buf();
     void extend_output_buf();
@@ -72,6 +86,9 @@ private:
     size_t _min_length;
     size_t _total_read_bytes;
     uint8_t _line_delimiter;
+    uint8_t _field_separator;
+    bool _save_field_pos;
+    std::vector<size_t> _field_pos;
 
     // save the data read from file reader
     uint8_t* _input_buf;
@@ -112,7 +112,8 @@ std::string SchemaColumnsScanner::type_to_string(TColumnDesc &desc) {
             return "date";
         case TPrimitiveType::DATETIME:
             return "datetime";
-        case TPrimitiveType::DECIMAL: {
+        case TPrimitiveType::DECIMAL:
+        case TPrimitiveType::DECIMALV2: {
             std::stringstream stream;
             stream << "decimal(";
             if (desc.__isset.columnPrecision) {
@@ -32,6 +32,7 @@ SelectNode::SelectNode(
     ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
     : ExecNode(pool, tnode, descs),
       _child_row_batch(NULL),
+      _num_selected(0),
       _child_row_idx(0),
       _child_eos(false) {
 }
@@ -40,6 +41,7 @@ Status SelectNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::prepare(state));
     _child_row_batch.reset(
         new RowBatch(child(0)->row_desc(), state->batch_size(), mem_tracker()));
+    _selected.resize(state->batch_size());
     return Status::OK;
 }
 
@@ -55,7 +57,7 @@ Status SelectNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos)
     RETURN_IF_CANCELLED(state);
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
-    if (reached_limit() || (_child_row_idx == _child_row_batch->num_rows() && _child_eos)) {
+    if (reached_limit() || (_child_row_idx == _num_selected && _child_eos)) {
         // we're already done or we exhausted the last child batch and there won't be any
         // new ones
         _child_row_batch->transfer_resource_ownership(row_batch);
@@ -67,20 +69,22 @@ Status SelectNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos)
     // start (or continue) consuming row batches from child
     while (true) {
         RETURN_IF_CANCELLED(state);
-        if (_child_row_idx == _child_row_batch->num_rows()) {
+        if (_child_row_idx == _num_selected) {
             // fetch next batch
             _child_row_idx = 0;
+            _num_selected = 0;
             _child_row_batch->transfer_resource_ownership(row_batch);
             _child_row_batch->reset();
             if (row_batch->at_capacity()) {
                 return Status::OK;
             }
             RETURN_IF_ERROR(child(0)->get_next(state, _child_row_batch.get(), &_child_eos));
+            RETURN_IF_ERROR(select_rows());
         }
 
         if (copy_rows(row_batch)) {
             *eos = reached_limit()
-                   || (_child_row_idx == _child_row_batch->num_rows() && _child_eos);
+                   || (_child_row_idx == _num_selected && _child_eos);
             if (*eos) {
                 _child_row_batch->transfer_resource_ownership(row_batch);
             }
@@ -98,11 +102,30 @@ Status SelectNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos)
     return Status::OK;
 }
 
-bool SelectNode::copy_rows(RowBatch* output_batch) {
-    ExprContext** ctxs = &_conjunct_ctxs[0];
-    int num_ctxs = _conjunct_ctxs.size();
+Status SelectNode::select_rows() {
+    int num_rows = _child_row_batch->num_rows();
+    if (_selected.size() < static_cast<size_t>(num_rows)) {
+        _selected.resize(num_rows);
+    }
+    for (int i = 0; i < num_rows; ++i) {
+        _selected[i] = i;
+    }
+    if (_conjunct_ctxs.empty() || num_rows == 0) {
+        _num_selected = num_rows;
+        return Status::OK;
+    }
+    Status status = ExecNode::eval_conjuncts_batch(
+        &_conjunct_ctxs[0], _conjunct_ctxs.size(), _child_row_batch.get(),
+        expr_mem_pool(), &_selected[0], &num_rows);
+    // results of exprs are not needed any more
+    expr_mem_pool()->clear();
+    RETURN_IF_ERROR(status);
+    _num_selected = num_rows;
+    return Status::OK;
+}
 
-    for (; _child_row_idx < _child_row_batch->num_rows(); ++_child_row_idx) {
+bool SelectNode::copy_rows(RowBatch* output_batch) {
+    for (; _child_row_idx < _num_selected; ++_child_row_idx) {
         // Add a new row to output_batch
         int dst_row_idx = output_batch->add_row();
 
@@ -111,17 +134,15 @@ bool SelectNode::copy_rows(RowBatch* output_batch) {
         }
 
         TupleRow* dst_row = output_batch->get_row(dst_row_idx);
-        TupleRow* src_row = _child_row_batch->get_row(_child_row_idx);
-
-        if (ExecNode::eval_conjuncts(ctxs, num_ctxs, src_row)) {
-            output_batch->copy_row(src_row, dst_row);
-            output_batch->commit_last_row();
-            ++_num_rows_returned;
-            COUNTER_SET(_rows_returned_counter, _num_rows_returned);
-
-            if (reached_limit()) {
-                return true;
-            }
+        TupleRow* src_row = _child_row_batch->get_row(_selected[_child_row_idx]);
+        output_batch->copy_row(src_row, dst_row);
+        output_batch->commit_last_row();
+        ++_num_rows_returned;
+        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+
+        if (reached_limit()) {
+            ++_child_row_idx;
+            return true;
         }
     }
 
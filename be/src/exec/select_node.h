@@ -21,6 +21,8 @@
 #ifndef BDG_PALO_BE_SRC_QUERY_EXEC_SELECT_NODE_H
 #define BDG_PALO_BE_SRC_QUERY_EXEC_SELECT_NODE_H
 
+#include <vector>
+
 #include <boost/scoped_ptr.hpp>
 
 #include "exec/exec_node.h"
@@ -46,14 +48,22 @@ private:
     // current row batch of child
     boost::scoped_ptr<RowBatch> _child_row_batch;
 
-    // index of current row in _child_row_batch
+    // indices of rows in _child_row_batch for which _conjuncts evaluate to true,
+    // the first _num_selected are valid
+    std::vector<int> _selected;
+    int _num_selected;
+
+    // index of current row in _selected
     int _child_row_idx;
 
     // true if last get_next() call on child signalled eos
     bool _child_eos;
 
-    // Copy rows from _child_row_batch for which _conjuncts evaluate to true to
-    // output_batch, up to _limit.
+    // Evaluate _conjuncts over _child_row_batch a column at a time and set
+    // _selected to rows passing them.
+    Status select_rows();
+
+    // Copy selected rows from _child_row_batch to output_batch, up to _limit.
     // Return true if limit was hit or output_batch should be returned, otherwise false.
     bool copy_rows(RowBatch* output_batch);
 };
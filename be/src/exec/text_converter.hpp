@@ -26,6 +26,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include "runtime/decimal_value.h"
+#include "runtime/decimalv2_value.h"
 #include "runtime/descriptors.h"
 #include "runtime/mem_pool.h"
 #include "runtime/runtime_state.h"
@@ -33,6 +34,7 @@
 #include "runtime/datetime_value.h"
 #include "runtime/tuple.h"
 #include "util/string_parser.hpp"
+#include "util/types.h"
 #include "olap/utils.h"
 
 namespace palo {
@@ -165,6 +167,17 @@ inline bool TextConverter::write_slot(const SlotDescriptor* slot_desc,
         break;
     }
 
+    case TYPE_DECIMALV2: {
+        DecimalV2Value decimal_value;
+        int err = decimal_value.parse_from_str(data, len);
+        if (err != E_DEC_OK && err != E_DEC_TRUNCATED) {
+            parse_result = StringParser::PARSE_FAILURE;
+            break;
+        }
+        reinterpret_cast<PackedInt128*>(slot)->value = decimal_value.value();
+        break;
+    }
+
     default:
         DCHECK(false) << "bad slot type: " << slot_desc->type();
         break;
@@ -46,6 +46,7 @@ using palo_udf::LargeIntVal;
 using palo_udf::FloatVal;
 using palo_udf::DoubleVal;
 using palo_udf::DecimalVal;
+using palo_udf::DecimalV2Val;
 using palo_udf::DateTimeVal;
 using palo_udf::StringVal;
 using palo_udf::AnyVal;
@@ -344,6 +345,10 @@ inline void AggFnEvaluator::set_any_val(
         memcpy(&reinterpret_cast<LargeIntVal*>(dst)->val, slot, sizeof(__int128));
         return;
 
+    case TYPE_DECIMALV2:
+        memcpy(&reinterpret_cast<DecimalV2Val*>(dst)->val, slot, sizeof(__int128));
+        return;
+
     default:
         DCHECK(false) << "NYI";
     }
@@ -414,6 +419,11 @@ inline void AggFnEvaluator::set_output_slot(const AnyVal* src,
         return;
     }
 
+    case TYPE_DECIMALV2: {
+        memcpy(slot, &reinterpret_cast<const DecimalV2Val*>(src)->val, sizeof(__int128));
+        return;
+    }
+
     default:
         DCHECK(false) << "NYI";
     }
@@ -555,6 +565,13 @@ bool AggFnEvaluator::count_distinct_data_filter(TupleRow* row, Tuple* dst) {
             break;
         }
 
+        case TYPE_DECIMALV2: {
+            DecimalV2Val* value = reinterpret_cast<DecimalV2Val*>(_staging_input_vals[i]);
+            memcpy(begin, &value->val, sizeof(__int128));
+            begin += sizeof(__int128);
+            break;
+        }
+
         case TYPE_FLOAT: {
             memcpy(begin, &reinterpret_cast<FloatVal*>(_staging_input_vals[i])->val, FLOAT_SIZE);
             begin += FLOAT_SIZE;
@@ -659,6 +676,13 @@ bool AggFnEvaluator::sum_distinct_data_filter(TupleRow* row, Tuple* dst) {
         return is_filter;
     }
 
+    case TYPE_DECIMALV2: {
+        const DecimalV2Val* value = reinterpret_cast<DecimalV2Val*>(_staging_input_vals[0]);
+        is_filter = is_in_hybirdmap((void*) & (value->val), dst, &is_add_buckets);
+        update_mem_trackers(is_filter, is_add_buckets, sizeof(__int128));
+        return is_filter;
+    }
+
     default: {
         DCHECK(0) << "FYI";
     }
@@ -932,6 +956,13 @@ void AggFnEvaluator::serialize_or_finalize(FunctionContext* agg_fn_ctx, Tuple* s
         break;
     }
 
+    case TYPE_DECIMALV2: {
+        typedef DecimalV2Val(*Fn)(FunctionContext*, AnyVal*);
+        DecimalV2Val v = reinterpret_cast<Fn>(fn)(agg_fn_ctx, _staging_intermediate_val);
+        set_output_slot(&v, dst_slot_desc, dst);
+        break;
+    }
+
     default:
         DCHECK(false) << "NYI";
     }
@@ -20,16 +20,26 @@
 
 #include "exprs/aggregate_functions.h"
 
+#include <limits.h>
 #include <math.h>
+#include <memory>
 #include <sstream>
-#include <unordered_set>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include "common/logging.h"
 #include "runtime/string_value.h"
 #include "runtime/datetime_value.h"
 #include "exprs/anyval_util.h"
+#include "exprs/distinct_hash_set.h"
+#include "exprs/hll_agg_state.h"
 #include "exprs/hybird_set.h"
 #include "util/debug_util.h"
+#include "util/roaring_bitmap.h"
+#include "util/tdigest.h"
+#include "util/topn_counter.h"
+#include "util/types.h"
 
 // TODO: this file should be cross compiled and then all of the builtin
 // aggregate functions will have a codegen enabled path. Then we can remove
@@ -45,6 +55,7 @@ using palo_udf::LargeIntVal;
 using palo_udf::FloatVal;
 using palo_udf::DoubleVal;
 using palo_udf::DecimalVal;
+using palo_udf::DecimalV2Val;
 using palo_udf::DateTimeVal;
 using palo_udf::StringVal;
 using palo_udf::AnyVal;
@@ -52,11 +63,6 @@ using palo_udf::AnyVal;
 // Delimiter to use if the separator is NULL.
 static const StringVal DEFAULT_STRING_CONCAT_DELIM((uint8_t*)", ", 2);
 
-// Hyperloglog precision. Default taken from paper. Doesn't seem to matter very
-// much when between [6,12]
-const int HLL_PRECISION = 14;
-const int HLL_SETS_BYTES_NUM = 16384;
-    
 void AggregateFunctions::init_null(FunctionContext*, AnyVal* dst) {
     dst->is_null = true;
 }
@@ -112,6 +118,34 @@ void AggregateFunctions::sum_remove(FunctionContext* ctx, const DecimalVal& src,
     new_dst.to_decimal_val(dst);
 }
 
+template<>
+void AggregateFunctions::sum_remove(FunctionContext* ctx, const DecimalV2Val& src,
+    DecimalV2Val* dst) {
+    // Do not count null values towards the number of removes
+    if (src.is_null) {
+        ctx->impl()->increment_num_removes(-1);
+    }
+    if (ctx->impl()->num_removes() >= ctx->impl()->num_updates()) {
+        *dst = DecimalV2Val::null();
+        return;
+    }
+    if (src.is_null) {
+        return;
+    }
+    if (dst->is_null) {
+        init_zero<DecimalV2Val>(ctx, dst);
+    }
+
+    DecimalV2Value new_dst;
+    if (DecimalV2Value::sub(DecimalV2Value::from_decimal_val(*dst),
+                            DecimalV2Value::from_decimal_val(src), &new_dst)
+            == E_DEC_OVERFLOW) {
+        ctx->set_error("decimal overflow in sum");
+        return;
+    }
+    new_dst.to_decimal_val(dst);
+}
+
 StringVal AggregateFunctions::string_val_get_value(
         FunctionContext* ctx, const StringVal& src) {
     if (src.is_null) {
@@ -166,6 +200,12 @@ struct DecimalAvgState {
     int64_t count;
 };
 
+// state is allocated by FunctionContext and may be unaligned
+struct DecimalV2AvgState {
+    PackedInt128 sum;
+    int64_t count;
+};
+
 void AggregateFunctions::avg_init(FunctionContext* ctx, StringVal* dst) {
     dst->is_null = false;
     dst->len = sizeof(AvgState);
@@ -294,6 +334,94 @@ DecimalVal AggregateFunctions::decimal_avg_get_value(FunctionContext* ctx, const
     return res;
 }
 
+void AggregateFunctions::decimalv2_avg_init(FunctionContext* ctx, StringVal* dst) {
+    dst->is_null = false;
+    dst->len = sizeof(DecimalV2AvgState);
+    dst->ptr = ctx->allocate(dst->len);
+    memset(dst->ptr, 0, sizeof(DecimalV2AvgState));
+}
+
+void AggregateFunctions::decimalv2_avg_update(FunctionContext* ctx,
+        const DecimalV2Val& src,
+        StringVal* dst) {
+    if (src.is_null) {
+        return;
+    }
+    DCHECK(dst->ptr != NULL);
+    DCHECK_EQ(sizeof(DecimalV2AvgState), dst->len);
+    DecimalV2AvgState* avg = reinterpret_cast<DecimalV2AvgState*>(dst->ptr);
+    DecimalV2Value sum = DecimalV2Value::from_raw(avg->sum.value);
+    if (DecimalV2Value::add(sum, DecimalV2Value::from_decimal_val(src), &sum)
+            == E_DEC_OVERFLOW) {
+        ctx->set_error("decimal overflow in avg");
+        return;
+    }
+    avg->sum = sum.value();
+    ++avg->count;
+}
+
+void AggregateFunctions::decimalv2_avg_merge(FunctionContext* ctx, const StringVal& src,
+        StringVal* dst) {
+    const DecimalV2AvgState* src_struct = reinterpret_cast<const DecimalV2AvgState*>(src.ptr);
+    DCHECK(dst->ptr != NULL);
+    DCHECK_EQ(sizeof(DecimalV2AvgState), dst->len);
+    DecimalV2AvgState* dst_struct = reinterpret_cast<DecimalV2AvgState*>(dst->ptr);
+    DecimalV2Value sum = DecimalV2Value::from_raw(dst_struct->sum.value);
+    if (DecimalV2Value::add(sum, DecimalV2Value::from_raw(src_struct->sum.value), &sum)
+            == E_DEC_OVERFLOW) {
+        ctx->set_error("decimal overflow in avg");
+        return;
+    }
+    dst_struct->sum = sum.value();
+    dst_struct->count += src_struct->count;
+}
+
+void AggregateFunctions::decimalv2_avg_remove(palo_udf::FunctionContext* ctx,
+        const DecimalV2Val& src,
+        StringVal* dst) {
+    // Remove doesn't need to explicitly check the number of calls to Update() or Remove()
+    // because Finalize() returns NULL if count is 0.
+    if (src.is_null) {
+        return;
+    }
+    DCHECK(dst->ptr != NULL);
+    DCHECK_EQ(sizeof(DecimalV2AvgState), dst->len);
+    DecimalV2AvgState* avg = reinterpret_cast<DecimalV2AvgState*>(dst->ptr);
+    DecimalV2Value sum = DecimalV2Value::from_raw(avg->sum.value);
+    if (DecimalV2Value::sub(sum, DecimalV2Value::from_decimal_val(src), &sum)
+            == E_DEC_OVERFLOW) {
+        ctx->set_error("decimal overflow in avg");
+        return;
+    }
+    avg->sum = sum.value();
+    --avg->count;
+    DCHECK_GE(avg->count, 0);
+}
+
+DecimalV2Val AggregateFunctions::decimalv2_avg_get_value(FunctionContext* ctx,
+        const StringVal& src) {
+    DecimalV2AvgState* val_struct = reinterpret_cast<DecimalV2AvgState*>(src.ptr);
+    if (val_struct->count == 0) {
+        return DecimalV2Val::null();
+    }
+    DecimalV2Value avg;
+    DecimalV2Value::div(DecimalV2Value::from_raw(val_struct->sum.value),
+                        DecimalV2Value(val_struct->count), &avg);
+    DecimalV2Val res;
+    avg.to_decimal_val(&res);
+    return res;
+}
+
+DecimalV2Val AggregateFunctions::decimalv2_avg_finalize(FunctionContext* ctx,
+        const StringVal& src) {
+    if (src.is_null) {
+        return DecimalV2Val::null();
+    }
+    DecimalV2Val result = decimalv2_avg_get_value(ctx, src);
+    ctx->free(src.ptr);
+    return result;
+}
+
 DoubleVal AggregateFunctions::avg_finalize(FunctionContext* ctx, const StringVal& src) {
     if (src.is_null) {
         return DoubleVal::null();
@@ -402,6 +530,27 @@ void AggregateFunctions::sum(FunctionContext* ctx, const DecimalVal& src, Decima
     new_dst.to_decimal_val(dst);
 }
 
+// Overflow fails the query instead of returning saturated or wrapped sum
+template<>
+void AggregateFunctions::sum(FunctionContext* ctx, const DecimalV2Val& src, DecimalV2Val* dst) {
+    if (src.is_null) {
+        return;
+    }
+
+    if (dst->is_null) {
+        dst->is_null = false;
+        dst->val = 0;
+    }
+
+    DecimalV2Value sum;
+    if (DecimalV2Value::add(DecimalV2Value::from_decimal_val(*dst),
+                            DecimalV2Value::from_decimal_val(src), &sum) == E_DEC_OVERFLOW) {
+        ctx->set_error("decimal overflow in sum");
+        return;
+    }
+    sum.to_decimal_val(dst);
+}
+
 template<>
 void AggregateFunctions::sum(FunctionContext* ctx, const LargeIntVal& src, LargeIntVal* dst) {
     if (src.is_null) {
@@ -893,11 +1042,7 @@ StringVal AggregateFunctions::pcsa_finalize(FunctionContext* c, const StringVal&
 }
 
 void AggregateFunctions::hll_init(FunctionContext* ctx, StringVal* dst) {
-    int str_len = std::pow(2, HLL_PRECISION);
-    dst->is_null = false;
-    dst->ptr = ctx->allocate(str_len);
-    dst->len = str_len;
-    memset(dst->ptr, 0, str_len);
+    HllAggState::init(ctx, dst);
 }
 
 template <typename T>
@@ -907,16 +1052,9 @@ void AggregateFunctions::hll_update(FunctionContext* ctx, const T& src, StringVa
     }
 
     DCHECK(!dst->is_null);
-    DCHECK_EQ(dst->len, std::pow(2, HLL_PRECISION));
     uint64_t hash_value = AnyValUtil::hash64_murmur(src, HashUtil::MURMUR_SEED);
-
     if (hash_value != 0) {
-        // Use the lower bits to index into the number of streams and then
-        // find the first 1 bit after the index bits.
-        int idx = hash_value % dst->len;
-        // uint8_t first_one_bit = __buiHLL_LENltin_ctzl(hash_value >> HLL_PRECISION) + 1;
-        uint8_t first_one_bit = __builtin_ctzl(hash_value >> HLL_PRECISION) + 1;
-        dst->ptr[idx] = std::max(dst->ptr[idx], first_one_bit);
+        HllAggState::update(ctx, hash_value, dst);
     }
 }
 
@@ -924,12 +1062,7 @@ void AggregateFunctions::hll_merge(FunctionContext* ctx, const StringVal& src,
                                    StringVal* dst) {
     DCHECK(!dst->is_null);
     DCHECK(!src.is_null);
-    DCHECK_EQ(dst->len, std::pow(2, HLL_PRECISION));
-    DCHECK_EQ(src.len, std::pow(2, HLL_PRECISION));
-
-    for (int i = 0; i < src.len; ++i) {
-        dst->ptr[i] = std::max(dst->ptr[i], src.ptr[i]);
-    }
+    HllAggState::merge(ctx, src, dst);
 }
 
 StringVal AggregateFunctions::hll_finalize(FunctionContext* ctx, const StringVal& src) {
@@ -943,42 +1076,8 @@ StringVal AggregateFunctions::hll_finalize(FunctionContext* ctx, const StringVal
     return result_str;
 }
 
-    
 void AggregateFunctions::hll_union_agg_init(FunctionContext* ctx, StringVal* dst) {
-    int str_len = std::pow(2, HLL_PRECISION);
-    dst->is_null = false;
-    dst->ptr = ctx->allocate(str_len);
-    dst->len = str_len;
-    memset(dst->ptr, 0, str_len);
-}
-
-void AggregateFunctions::hll_union_parse_and_cal(HllSetResolver& resolver, StringVal* dst) {
-    
-    if (resolver.get_hll_data_type() == HLL_DATA_EMPTY) {    
-        return;
-    }    
-    if (resolver.get_hll_data_type() == HLL_DATA_EXPLICIT) {
-        for (int i = 0; i < resolver.get_expliclit_count(); i++) {
-            uint64_t hash_value = resolver.get_expliclit_value(i);
-            int idx = hash_value % dst->len;
-            uint8_t first_one_bit = __builtin_ctzl(hash_value >> HLL_PRECISION) + 1; 
-            dst->ptr[idx] = std::max(dst->ptr[idx], first_one_bit);
-        }    
-    } else if (resolver.get_hll_data_type() == HLL_DATA_SPRASE) {
-        std::map<HllSetResolver::SparseIndexType, HllSetResolver::SparseValueType>& 
-                                            sparse_map = resolver.get_sparse_map();
-        for (std::map<HllSetResolver::SparseIndexType, 
-             HllSetResolver::SparseValueType>::iterator iter = sparse_map.begin(); 
-                                    iter != sparse_map.end(); iter++) {
-            dst->ptr[iter->first] = std::max(dst->ptr[iter->first], (uint8_t)iter->second);
-        }  
-    } else if (resolver.get_hll_data_type() == HLL_DATA_FULL) {
-        char* full_value = resolver.get_full_value();
-        for (int i = 0; i < HLL_SETS_BYTES_NUM; i++) {
-            dst->ptr[i] = std::max(dst->ptr[i], (uint8_t)full_value[i]);
-        }
-    }
-    return ;
+    HllAggState::init(ctx, dst);
 }
 
 void AggregateFunctions::hll_union_agg_update(FunctionContext* ctx, 
@@ -987,25 +1086,15 @@ void AggregateFunctions::hll_union_agg_update(FunctionContext* ctx,
         return;
     }
     DCHECK(!dst->is_null);
-    DCHECK_EQ(dst->len, std::pow(2, HLL_PRECISION));
-    
-    HllSetResolver resolver;
-    resolver.init((char*)src.ptr, src.len);
-    resolver.parse();
-    hll_union_parse_and_cal(resolver, dst); 
-    return ;
+    // hll column is stored in the same encodings as the state
+    HllAggState::merge(ctx, src, dst);
 }
 
 void AggregateFunctions::hll_union_agg_merge(FunctionContext* ctx, const StringVal& src,
                                    StringVal* dst) {
     DCHECK(!dst->is_null);
     DCHECK(!src.is_null);
-    DCHECK_EQ(dst->len, HLL_SETS_BYTES_NUM);
-    DCHECK_EQ(src.len, HLL_SETS_BYTES_NUM);
-     
-    for (int i = 0; i < src.len; ++i) {
-        dst->ptr[i] = std::max(dst->ptr[i], src.ptr[i]);
-    }
+    HllAggState::merge(ctx, src, dst);
 }
 
 palo_udf::StringVal AggregateFunctions::hll_union_agg_finalize(palo_udf::FunctionContext* ctx, 
@@ -1021,66 +1110,60 @@ palo_udf::StringVal AggregateFunctions::hll_union_agg_finalize(palo_udf::Functio
 
 int64_t AggregateFunctions::hll_algorithm(const palo_udf::StringVal& src) {
     DCHECK(!src.is_null);
-    DCHECK_EQ(src.len, HLL_SETS_BYTES_NUM);
-    
-    const int num_streams = HLL_SETS_BYTES_NUM;
-    // Empirical constants for the algorithm.
-    float alpha = 0;
-    
-    if (num_streams == 16) {
-        alpha = 0.673f;
-    } else if (num_streams == 32) {
-        alpha = 0.697f;
-    } else if (num_streams == 64) {
-        alpha = 0.709f;
-    } else {
-        alpha = 0.7213f / (1 + 1.079f / num_streams);
+    return HllAggState::estimate(src);
+}
+
+void AggregateFunctions::bitmap_init(FunctionContext* ctx, StringVal* dst) {
+    dst->is_null = false;
+    dst->len = sizeof(RoaringBitmap);
+    dst->ptr = (uint8_t*)new RoaringBitmap();
+}
+
+template <typename T>
+void AggregateFunctions::bitmap_update_int(FunctionContext* ctx, const T& src, StringVal* dst) {
+    DCHECK(!dst->is_null);
+    if (src.is_null) {
+        return;
     }
-    
-    float harmonic_mean = 0;
-    int num_zero_registers = 0;
-    
-    for (int i = 0; i < src.len; ++i) {
-        harmonic_mean += powf(2.0f, -src.ptr[i]);
-        
-        if (src.ptr[i] == 0) {
-            ++num_zero_registers;
-        }
+    // negative values are distinct after cast as well
+    reinterpret_cast<RoaringBitmap*>(dst->ptr)->add((uint64_t)src.val);
+}
+
+void AggregateFunctions::bitmap_merge(FunctionContext* ctx, const StringVal& src,
+                                      StringVal* dst) {
+    DCHECK(!dst->is_null);
+    if (src.is_null) {
+        return;
     }
-    
-    harmonic_mean = 1.0f / harmonic_mean;
-    double estimate = alpha * num_streams * num_streams * harmonic_mean;
-    double tmp = 0.f;
-    // according to HerperLogLog current correction, if E is cardinal
-    // E =< num_streams * 2.5 , LC has higher accuracy.
-    // num_streams * 2.5 < E =< 2 ^ 32 / 30 , HerperLogLog has higher accuracy.
-    // E > 2 ^ 32 / 30 ,  estimate = -tmp * log(1 - estimate / tmp);
-    // Generally , we can use HerperLogLog to produce value as E.
-    if (num_zero_registers != 0) {
-        // Estimated cardinality is too low. Hll is too inaccurate here, instead use
-        // linear counting.
-        estimate = num_streams * log(static_cast<float>(num_streams) / num_zero_registers);
-    } else if (num_streams == 16384 && estimate < 72000) {
-        // when Linear Couint change to HerperLoglog according to HerperLogLog Correction,
-        // there are relatively large fluctuations, we fixed the problem refer to redis.
-        double bias = 5.9119 * 1.0e-18 * (estimate * estimate * estimate * estimate)
-        - 1.4253 * 1.0e-12 * (estimate * estimate * estimate) +
-        1.2940 * 1.0e-7 * (estimate * estimate)
-        - 5.2921 * 1.0e-3 * estimate +
-        83.3216;
-        estimate -= estimate * (bias / 100);
-    } else if (estimate > (tmp = std::pow(2, 32) / 30)) {
-        estimate = -tmp * log(1 - estimate / tmp);
-    }
-    return (int64_t)(estimate + 0.5);
-}
-
-// TODO chenhao , reduce memory copy
+    RoaringBitmap* bitmap = reinterpret_cast<RoaringBitmap*>(dst->ptr);
+    if (!bitmap->merge(src.ptr, src.len)) {
+        ctx->set_error("invalid serialized bitmap");
+    }
+}
+
+StringVal AggregateFunctions::bitmap_serialize(FunctionContext* ctx, const StringVal& src) {
+    DCHECK(!src.is_null);
+    RoaringBitmap* bitmap = reinterpret_cast<RoaringBitmap*>(src.ptr);
+    StringVal result(ctx, bitmap->serialized_size());
+    bitmap->serialize(result.ptr);
+    delete bitmap;
+    return result;
+}
+
+BigIntVal AggregateFunctions::bitmap_finalize(FunctionContext* ctx, const StringVal& src) {
+    DCHECK(!src.is_null);
+    RoaringBitmap* bitmap = reinterpret_cast<RoaringBitmap*>(src.ptr);
+    BigIntVal result(bitmap->cardinality());
+    delete bitmap;
+    return result;
+}
+
 // multi distinct state for numertic
 // serialize order type:value:value:value ...
 template <typename T>
 class MultiDistinctNumericState {
 public:
+    typedef decltype(T::val) ValueType;
 
     static void create(StringVal* dst) {
         dst->is_null = false;
@@ -1112,48 +1195,40 @@ public:
     }
 
     void update(T& t) {
-        _set.insert(t);
+        _set.insert(t.val);
     }
 
     // type:one byte  value:sizeof(T)
     StringVal serialize(FunctionContext* ctx) {
-        size_t type_size = sizeof(((T*)0)->val);
-        const size_t serialized_set_length = sizeof(uint8_t) + type_size * _set.size();
+        const size_t serialized_set_length = sizeof(uint8_t) + sizeof(ValueType) * _set.size();
         StringVal result(ctx, serialized_set_length);
-        uint8_t* type_writer = result.ptr;
+        uint8_t* writer = result.ptr;
         // type
-        *type_writer = (uint8_t)_type;
-        type_writer++;
+        *writer = (uint8_t)_type;
+        writer++;
         // value
-        for (auto& value : _set) {
-            memcpy(type_writer, &value.val, type_size);
-            type_writer += type_size;
-        }
+        _set.for_each([&writer](const ValueType& value) {
+            memcpy(writer, &value, sizeof(ValueType));
+            writer += sizeof(ValueType);
+        });
         return result;
     }
 
-    void unserialize(StringVal& src) {
-        size_t type_size = sizeof(((T*)0)->val);
-        const uint8_t* type_reader = src.ptr;
-        const uint8_t* end = src.ptr + src.len;
-        // type
-        _type = (FunctionContext::Type)*type_reader;
-        type_reader++;
-        // value
-        while (type_reader < end) {
-            T value;
-            value.is_null = false;
-            memcpy(&value.val, type_reader, type_size);
+    // merge serialized set, values are inserted directly
+    void merge(const StringVal& src) {
+        const uint8_t* reader = src.ptr;
+        DCHECK_EQ(_type, (FunctionContext::Type)*reader);
+        reader++;
+        const size_t count = (src.len - 1) / sizeof(ValueType);
+        _set.reserve(_set.size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            ValueType value;
+            memcpy(&value, reader, sizeof(ValueType));
             _set.insert(value);
-            type_reader += type_size;
+            reader += sizeof(ValueType);
         }
     }
 
-    // merge set
-    void merge(MultiDistinctNumericState& state) {
-        _set.insert(state._set.begin(), state._set.end());
-    }
-
     // count
     BigIntVal count_finalize() {
         return BigIntVal(_set.size());
@@ -1162,54 +1237,34 @@ public:
     // sum for double, decimal
     DoubleVal sum_finalize_double() {
         double sum = 0;
-        for (auto& value : _set) {
-            sum += value.val;
-        }
+        _set.for_each([&sum](const ValueType& value) { sum += value; });
         return DoubleVal(sum);
     }
 
     // sum for largeint 
     LargeIntVal sum_finalize_largeint() {
         __int128 sum = 0;
-        for (auto& value : _set) {
-            sum += value.val;
-        }
+        _set.for_each([&sum](const ValueType& value) { sum += value; });
         return LargeIntVal(sum);
     }
 
     // sum for tinyint, smallint, int, bigint
     BigIntVal sum_finalize_bigint() {
         int64_t sum = 0;
-        for (auto& value : _set) {
-            sum += value.val;
-        }
+        _set.for_each([&sum](const ValueType& value) { sum += value; });
         return BigIntVal(sum);
     }
 
-    FunctionContext::Type set_type() {
-        return _type;
-    }
-
 private:
-
-    class NumericHashHelper {   
-    public:
-        size_t operator()(const T& obj) const {
-            size_t result = AnyValUtil::hash64_murmur(obj, HashUtil::MURMUR_SEED);   
-            return result;
-        }
-    };
-
-    std::unordered_set<T, NumericHashHelper> _set;
-    // Because Anyval does not provide the hash function, in order 
-    // to adopt the type different from the template, the pointer is used
-    // HybirdSetBase* _set;
+    DistinctHashSet<ValueType, DistinctBytesHash<ValueType>,
+                    DistinctBytesEqual<ValueType> > _set;
     // _type is serialized into buffer by one byte
     FunctionContext::Type _type;
 };
 
 // multi distinct state for string
-// // serialize order type:len:value:len:value ...
+// // serialize order SERIALIZED_WITH_COUNT:count:len:value:len:value ...
+// // states serialized by old versions are type:len:value:len:value ...
 class MultiDistinctStringCountState {
 public:
 
@@ -1227,75 +1282,128 @@ public:
         delete (MultiDistinctStringCountState*)dst.ptr;
     }
 
-    inline void update(StringValue* sv) {
-        _set.insert(sv);
+    MultiDistinctStringCountState() :
+            _chunk_pos(NULL),
+            _chunk_remain(0),
+            _next_chunk_size(MIN_CHUNK_SIZE) {
+    }
+
+    inline void update(const StringValue& sv) {
+        _insert(sv);
     }
 
     StringVal serialize(FunctionContext* ctx) {
         // calculate total serialize buffer length
-        int total_serialized_set_length = 1;
-        HybirdSetBase::IteratorBase* iterator = _set.begin();
-        while (iterator->has_next()) {
-            const StringValue* value = 
-                        reinterpret_cast<const StringValue*>(iterator->get_value());
-            total_serialized_set_length += STRING_LENGTH_RECORD_LENGTH + value->len;
-            iterator->next();
-        }
+        int total_serialized_set_length = 1 + STRING_COUNT_RECORD_LENGTH;
+        _set.for_each([&total_serialized_set_length](const StringValue& value) {
+            total_serialized_set_length += STRING_LENGTH_RECORD_LENGTH + value.len;
+        });
         StringVal result(ctx, total_serialized_set_length);
         uint8_t* writer = result.ptr;
-        // type
-        *writer = _type;
+        // format instead of type, so that merge can tell it from old format
+        *writer = SERIALIZED_WITH_COUNT;
         writer ++;
-        iterator = _set.begin();
-        while (iterator->has_next()) {
-            const StringValue* value = reinterpret_cast<const StringValue*>
-            (iterator->get_value());
+        // count, so that merge can reserve the set
+        *(int*)writer = _set.size();
+        writer += STRING_COUNT_RECORD_LENGTH;
+        _set.for_each([&writer](const StringValue& value) {
             // length, it is unnecessary to consider little or big endian for
             // all running in little-endian.
-            *(int*)writer = value->len;
+            *(int*)writer = value.len;
             writer += STRING_LENGTH_RECORD_LENGTH;
             // value
-            memcpy(writer, value->ptr, value->len);
-            writer += value->len;
-            iterator->next();
-        }
+            memcpy(writer, value.ptr, value.len);
+            writer += value.len;
+        });
         return result;
     }
-    
-    void unserialize(StringVal& src) {
-        uint8_t* reader = src.ptr;
-        // skip type ,no used now
-        _type = (FunctionContext::Type)*reader;
-        DCHECK(_type == FunctionContext::TYPE_STRING);
+
+    // merge serialized set, strings are copied only if they are new
+    void merge(const StringVal& src) {
+        const uint8_t* reader = src.ptr;
+        if (*reader != SERIALIZED_WITH_COUNT) {
+            _merge_without_count(src);
+            return;
+        }
         reader ++;
-        const uint8_t* end = src.ptr + src.len;
-        while (reader < end) {
+        const int count = *(int*)reader;
+        reader += STRING_COUNT_RECORD_LENGTH;
+        _set.reserve(_set.size() + count);
+        for (int i = 0; i < count; ++i) {
             const int length = *(int*)reader;
             reader += STRING_LENGTH_RECORD_LENGTH;
-            StringValue value((char*)reader, length);
-            _set.insert(&value);
+            _insert(StringValue((char*)reader, length));
             reader += length;
         }
-        DCHECK(reader == end);
-    }
-   
-    // merge set 
-    void merge(MultiDistinctStringCountState& state) {
-        _set.insert(&(state._set));
+        DCHECK(reader == src.ptr + src.len);
     }
     
     BigIntVal finalize() {
         return BigIntVal(_set.size());
     }
 
-    FunctionContext::Type set_type() {
-        return _type;
-    }
-  
     static const int STRING_LENGTH_RECORD_LENGTH = 4; 
+    static const int STRING_COUNT_RECORD_LENGTH = 4;
+    // first byte of serialized set with count, which is not a type
+    static const uint8_t SERIALIZED_WITH_COUNT = 0xff;
 private:
+    // merge set serialized by old versions, which has no count
+    void _merge_without_count(const StringVal& src) {
+        const uint8_t* reader = src.ptr;
+        DCHECK_EQ(_type, (FunctionContext::Type)*reader);
+        reader ++;
+        const uint8_t* end = src.ptr + src.len;
+        while (reader < end) {
+            const int length = *(int*)reader;
+            reader += STRING_LENGTH_RECORD_LENGTH;
+            _insert(StringValue((char*)reader, length));
+            reader += length;
+        }
+        DCHECK(reader == end);
+    }
+
+    struct StringValueHash {
+        size_t operator()(const StringValue& value) const {
+            return hash_value(value);
+        }
+    };
+
+    // chunks of copied strings grow from MIN_CHUNK_SIZE to MAX_CHUNK_SIZE, so
+    // that states of small groups stay small
+    static const int MIN_CHUNK_SIZE = 256;
+    static const int MAX_CHUNK_SIZE = 64 * 1024;
+
+    void _insert(const StringValue& value) {
+        bool inserted = false;
+        StringValue* element = _set.find_or_insert(value, hash_value(value), &inserted);
+        if (inserted && value.len > 0) {
+            element->ptr = _copy_string(value.ptr, value.len);
+        }
+    }
+
+    char* _copy_string(const char* data, int len) {
+        if (len > _chunk_remain) {
+            int chunk_size = std::max(len, _next_chunk_size);
+            if (_next_chunk_size < MAX_CHUNK_SIZE) {
+                _next_chunk_size *= 2;
+            }
+            _chunks.emplace_back(new char[chunk_size]);
+            _chunk_pos = _chunks.back().get();
+            _chunk_remain = chunk_size;
+        }
+        char* ptr = _chunk_pos;
+        memcpy(ptr, data, len);
+        _chunk_pos += len;
+        _chunk_remain -= len;
+        return ptr;
+    }
  
-    StringValueSet _set;
+    // strings in the set point to _chunks
+    DistinctHashSet<StringValue, StringValueHash> _set;
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    char* _chunk_pos;
+    int _chunk_remain;
+    int _next_chunk_size;
     // _type is serialized into buffer by one byte
     FunctionContext::Type _type;
 };
@@ -1324,17 +1432,13 @@ public:
 
     // type:one byte  value:sizeof(T)
     StringVal serialize(FunctionContext* ctx) {
-        const int serialized_set_length = sizeof(uint8_t) 
-                   + (DECIMAL_INT_LEN_BYTE_SIZE 
-                     + DECIMAL_FRAC_BYTE_SIZE
-                     + DECIMAL_SIGN_BYTE_SIZE
-                     + DECIMAL_BUFFER_BYTE_SIZE) * _set.size();
+        const int serialized_set_length = sizeof(uint8_t) + DECIMAL_BYTE_SIZE * _set.size();
         StringVal result(ctx, serialized_set_length);
         uint8_t* writer = result.ptr;
         *writer = (uint8_t)_type;
         writer++;
         // for int_length and frac_length, uint8_t will not overflow.
-        for (auto& value : _set) {
+        _set.for_each([&writer](const DecimalValue& value) {
             *writer = value._int_length;
             writer += DECIMAL_INT_LEN_BYTE_SIZE;
             *writer = value._frac_length;
@@ -1343,16 +1447,17 @@ public:
             writer += DECIMAL_SIGN_BYTE_SIZE;
             memcpy(writer, value._buffer, DECIMAL_BUFFER_BYTE_SIZE);
             writer += DECIMAL_BUFFER_BYTE_SIZE;
-        }    
+        });
         return result;
     }    
 
-    void unserialize(StringVal& src) {
+    // merge serialized set, values are inserted directly
+    void merge(const StringVal& src) {
         const uint8_t* reader = src.ptr;
-        // type
-        _type = (FunctionContext::Type)*reader;
+        DCHECK_EQ(_type, (FunctionContext::Type)*reader);
         reader++;
         const uint8_t* end = src.ptr + src.len;
+        _set.reserve(_set.size() + (src.len - 1) / DECIMAL_BYTE_SIZE);
         // value
         while (reader < end) {
             DecimalValue value;
@@ -1368,15 +1473,6 @@ public:
             _set.insert(value);
         }    
     }    
- 
-    FunctionContext::Type set_type() {
-        return _type;
-    }
-
-    // merge set
-    void merge(MultiDistinctDecimalState& state) {
-        _set.insert(state._set.begin(), state._set.end());
-    }    
 
     // count
     BigIntVal count_finalize() {
@@ -1385,9 +1481,7 @@ public:
 
     DecimalVal sum_finalize() {
         DecimalValue sum;
-        for (auto& value : _set) {
-             sum += value;
-        }
+        _set.for_each([&sum](const DecimalValue& value) { sum += value; });
         DecimalVal result;
         sum.to_decimal_val(&result); 
         return result;
@@ -1395,12 +1489,14 @@ public:
 
 private:
 
-    const int DECIMAL_INT_LEN_BYTE_SIZE = 1; 
-    const int DECIMAL_FRAC_BYTE_SIZE = 1; 
-    const int DECIMAL_SIGN_BYTE_SIZE = 1; 
-    const int DECIMAL_BUFFER_BYTE_SIZE = 36;
+    static const int DECIMAL_INT_LEN_BYTE_SIZE = 1; 
+    static const int DECIMAL_FRAC_BYTE_SIZE = 1; 
+    static const int DECIMAL_SIGN_BYTE_SIZE = 1; 
+    static const int DECIMAL_BUFFER_BYTE_SIZE = 36;
+    static const int DECIMAL_BYTE_SIZE = DECIMAL_INT_LEN_BYTE_SIZE + DECIMAL_FRAC_BYTE_SIZE
+        + DECIMAL_SIGN_BYTE_SIZE + DECIMAL_BUFFER_BYTE_SIZE;
 
-    std::unordered_set<DecimalValue> _set;
+    DistinctHashSet<DecimalValue, std::hash<DecimalValue> > _set;
     FunctionContext::Type _type;
 };
 
@@ -1436,23 +1532,25 @@ public:
         *writer = (uint8_t)_type;
         writer++;
         // value
-        for (auto& value : _set) {
+        _set.for_each([&writer](const DateTimeVal& value) {
             int64_t* packed_time_writer = (int64_t*)writer;
             *packed_time_writer = value.packed_time;
             writer += DATETIME_PACKED_TIME_BYTE_SIZE;
             int* type_writer = (int*)writer;
             *type_writer = value.type;
             writer += DATETIME_TYPE_BYTE_SIZE;
-        }
+        });
         return result;
     }
     
-    void unserialize(StringVal& src) {
+    // merge serialized set, values are inserted directly
+    void merge(const StringVal& src) {
         const uint8_t* reader = src.ptr;
-        // type
-        _type = (FunctionContext::Type)*reader;
+        DCHECK_EQ(_type, (FunctionContext::Type)*reader);
         reader++;
         const uint8_t* end = src.ptr + src.len;
+        _set.reserve(_set.size() + (src.len - 1)
+                     / (DATETIME_PACKED_TIME_BYTE_SIZE + DATETIME_TYPE_BYTE_SIZE));
         // value
         while (reader < end) {
             DateTimeVal value;
@@ -1467,34 +1565,25 @@ public:
         }
     }
     
-    // merge set
-    void merge(MultiDistinctCountDateState& state) {
-        _set.insert(state._set.begin(), state._set.end());
-    }
-    
     // count
     BigIntVal count_finalize() {
         return BigIntVal(_set.size());
     }
    
-    FunctionContext::Type set_type() {
-        return _type;
-    }
- 
 private:
    
     class DateTimeHashHelper {    
     public:
         size_t operator()(const DateTimeVal& obj) const {
-            size_t result = AnyValUtil::hash64_murmur(obj, HashUtil::MURMUR_SEED);   
-            return result;
+            return HashUtil::hash(&obj.packed_time, sizeof(obj.packed_time),
+                                  HashUtil::FNV_SEED);
         }
     }; 
  
-    const int DATETIME_PACKED_TIME_BYTE_SIZE = 8;
-    const int DATETIME_TYPE_BYTE_SIZE = 4;
+    static const int DATETIME_PACKED_TIME_BYTE_SIZE = 8;
+    static const int DATETIME_TYPE_BYTE_SIZE = 4;
 
-    std::unordered_set<DateTimeVal, DateTimeHashHelper> _set;
+    DistinctHashSet<DateTimeVal, DateTimeHashHelper> _set;
     FunctionContext::Type _type;
 };
     
@@ -1529,8 +1618,7 @@ void AggregateFunctions::count_distinct_string_update(FunctionContext* ctx, Stri
     DCHECK(!dst->is_null);
     if (src.is_null) return;
     MultiDistinctStringCountState* state = reinterpret_cast<MultiDistinctStringCountState*>(dst->ptr);
-    StringValue sv = StringValue::from_string_val(src);
-    state->update(&sv);
+    state->update(StringValue::from_string_val(src));
 }
     
 void AggregateFunctions::count_or_sum_distinct_decimal_update(FunctionContext* ctx, DecimalVal& src,
@@ -1552,17 +1640,10 @@ void AggregateFunctions::count_distinct_date_update(FunctionContext* ctx, DateTi
 template <typename T>
 void AggregateFunctions::count_or_sum_distinct_numeric_merge(FunctionContext* ctx, StringVal& src,
                          StringVal* dst) {
-   DCHECK(!dst->is_null);
-   DCHECK(!src.is_null);
-   MultiDistinctNumericState<T>* dst_state = reinterpret_cast<MultiDistinctNumericState<T>*>(dst->ptr);
-   // unserialize src
-   StringVal src_state_val;
-   MultiDistinctNumericState<T>::create(&src_state_val); 
-   MultiDistinctNumericState<T>* src_state = reinterpret_cast<MultiDistinctNumericState<T>*>(src_state_val.ptr);
-   src_state->unserialize(src);
-   DCHECK(dst_state->set_type() == src_state->set_type());
-   dst_state->merge(*src_state);
-   MultiDistinctNumericState<T>::destory(src_state_val);
+    DCHECK(!dst->is_null);
+    DCHECK(!src.is_null);
+    MultiDistinctNumericState<T>* dst_state = reinterpret_cast<MultiDistinctNumericState<T>*>(dst->ptr);
+    dst_state->merge(src);
 }
     
 void AggregateFunctions::count_distinct_string_merge(FunctionContext* ctx, StringVal& src,
@@ -1570,30 +1651,15 @@ void AggregateFunctions::count_distinct_string_merge(FunctionContext* ctx, Strin
     DCHECK(!dst->is_null);
     DCHECK(!src.is_null);
     MultiDistinctStringCountState* dst_state = reinterpret_cast<MultiDistinctStringCountState*>(dst->ptr);
-    // unserialize src
-    StringVal src_state_val;
-    MultiDistinctStringCountState::create(&src_state_val);
-    MultiDistinctStringCountState* src_state = reinterpret_cast<MultiDistinctStringCountState*>(src_state_val.ptr);
-    src_state->unserialize(src);
-    DCHECK(dst_state->set_type() == src_state->set_type());
-    dst_state->merge(*src_state);
-    MultiDistinctStringCountState::destory(src_state_val); 
+    dst_state->merge(src);
 }
 
-
 void AggregateFunctions::count_or_sum_distinct_decimal_merge(FunctionContext* ctx, StringVal& src,
                                                              StringVal* dst) {
     DCHECK(!dst->is_null);
     DCHECK(!src.is_null);
     MultiDistinctDecimalState* dst_state = reinterpret_cast<MultiDistinctDecimalState*>(dst->ptr);
-    // unserialize src
-    StringVal src_state_val;
-    MultiDistinctDecimalState::create(&src_state_val);
-    MultiDistinctDecimalState* src_state = reinterpret_cast<MultiDistinctDecimalState*>(src_state_val.ptr);
-    src_state->unserialize(src);
-    DCHECK(dst_state->set_type() == src_state->set_type());
-    dst_state->merge(*src_state);
-    MultiDistinctDecimalState::destory(src_state_val);
+    dst_state->merge(src);
 }
     
 void AggregateFunctions::count_distinct_date_merge(FunctionContext* ctx, StringVal& src,
@@ -1601,14 +1667,7 @@ void AggregateFunctions::count_distinct_date_merge(FunctionContext* ctx, StringV
     DCHECK(!dst->is_null);
     DCHECK(!src.is_null);
     MultiDistinctCountDateState* dst_state = reinterpret_cast<MultiDistinctCountDateState*>(dst->ptr);
-    // unserialize src
-    StringVal src_state_val;
-    MultiDistinctCountDateState::create(&src_state_val);
-    MultiDistinctCountDateState* src_state = reinterpret_cast<MultiDistinctCountDateState*>(src_state_val.ptr);
-    src_state->unserialize(src);
-    DCHECK(dst_state->set_type() == src_state->set_type());
-    dst_state->merge(*src_state);
-    MultiDistinctCountDateState::destory(src_state_val);
+    dst_state->merge(src);
 }
     
 template <typename T>
@@ -1819,6 +1878,188 @@ DoubleVal AggregateFunctions::knuth_stddev_pop_finalize(FunctionContext* ctx,
     return DoubleVal(variance);
 }
 
+// state of percentile_approx
+// serialize order quantile:digest
+struct PercentileApproxState {
+    PercentileApproxState() : quantile(-1) { }
+
+    TDigest digest;
+    // quantile is constant argument, set by the first update
+    double quantile;
+};
+
+void AggregateFunctions::percentile_approx_init(FunctionContext* ctx, StringVal* dst) {
+    dst->is_null = false;
+    dst->len = sizeof(PercentileApproxState);
+    dst->ptr = (uint8_t*)new PercentileApproxState();
+}
+
+void AggregateFunctions::percentile_approx_update(FunctionContext* ctx, const DoubleVal& src,
+                                                  const DoubleVal& quantile, StringVal* dst) {
+    DCHECK(!dst->is_null);
+    if (src.is_null) {
+        return;
+    }
+    if (quantile.is_null || quantile.val < 0 || quantile.val > 1) {
+        ctx->set_error("quantile of percentile_approx must be between 0 and 1");
+        return;
+    }
+    PercentileApproxState* state = reinterpret_cast<PercentileApproxState*>(dst->ptr);
+    state->quantile = quantile.val;
+    state->digest.add(src.val);
+}
+
+void AggregateFunctions::percentile_approx_merge(FunctionContext* ctx, const StringVal& src,
+                                                 StringVal* dst) {
+    DCHECK(!dst->is_null);
+    DCHECK(!src.is_null);
+    PercentileApproxState* dst_state = reinterpret_cast<PercentileApproxState*>(dst->ptr);
+    double quantile = 0;
+    memcpy(&quantile, src.ptr, sizeof(double));
+    TDigest digest;
+    if (!digest.unserialize(src.ptr + sizeof(double), src.len - sizeof(double))) {
+        ctx->set_error("invalid state of percentile_approx");
+        return;
+    }
+    if (quantile >= 0) {
+        dst_state->quantile = quantile;
+    }
+    dst_state->digest.merge(digest);
+}
+
+StringVal AggregateFunctions::percentile_approx_serialize(FunctionContext* ctx,
+                                                          const StringVal& state_sv) {
+    DCHECK(!state_sv.is_null);
+    PercentileApproxState* state = reinterpret_cast<PercentileApproxState*>(state_sv.ptr);
+    StringVal result(ctx, sizeof(double) + state->digest.serialized_size());
+    memcpy(result.ptr, &state->quantile, sizeof(double));
+    state->digest.serialize(result.ptr + sizeof(double));
+    delete state;
+    return result;
+}
+
+DoubleVal AggregateFunctions::percentile_approx_finalize(FunctionContext* ctx,
+                                                         const StringVal& state_sv) {
+    DCHECK(!state_sv.is_null);
+    PercentileApproxState* state = reinterpret_cast<PercentileApproxState*>(state_sv.ptr);
+    DoubleVal result = DoubleVal::null();
+    if (state->quantile >= 0 && state->digest.total_weight() > 0) {
+        result = DoubleVal(state->digest.quantile(state->quantile));
+    }
+    delete state;
+    return result;
+}
+
+// state of topn
+// serialize order topn:counter
+struct TopNState {
+    TopNState() : topn(0), counter(NULL) { }
+    ~TopNState() {
+        delete counter;
+    }
+
+    // topn and capacity of counter are constant arguments, set by the first update
+    int32_t topn;
+    TopNCounter* counter;
+};
+
+// capacity of counter is topn * space_expand_rate
+static const int32_t TOPN_DEFAULT_SPACE_EXPAND_RATE = 50;
+
+void AggregateFunctions::topn_init(FunctionContext* ctx, StringVal* dst) {
+    dst->is_null = false;
+    dst->len = sizeof(TopNState);
+    dst->ptr = (uint8_t*)new TopNState();
+}
+
+void AggregateFunctions::topn_update(FunctionContext* ctx, const StringVal& src,
+                                     const IntVal& topn, StringVal* dst) {
+    topn_update(ctx, src, topn, IntVal(TOPN_DEFAULT_SPACE_EXPAND_RATE), dst);
+}
+
+void AggregateFunctions::topn_update(FunctionContext* ctx, const StringVal& src,
+                                     const IntVal& topn, const IntVal& space_expand_rate,
+                                     StringVal* dst) {
+    DCHECK(!dst->is_null);
+    if (src.is_null) {
+        return;
+    }
+    TopNState* state = reinterpret_cast<TopNState*>(dst->ptr);
+    if (state->counter == NULL) {
+        if (topn.is_null || topn.val <= 0 || space_expand_rate.is_null
+                || space_expand_rate.val <= 0) {
+            ctx->set_error("topn and space_expand_rate of topn must be positive");
+            return;
+        }
+        state->topn = topn.val;
+        state->counter = new TopNCounter(
+            std::min<int64_t>((int64_t)topn.val * space_expand_rate.val, INT_MAX));
+    }
+    state->counter->add(std::string((char*)src.ptr, src.len));
+}
+
+void AggregateFunctions::topn_merge(FunctionContext* ctx, const StringVal& src,
+                                    StringVal* dst) {
+    DCHECK(!dst->is_null);
+    DCHECK(!src.is_null);
+    TopNState* dst_state = reinterpret_cast<TopNState*>(dst->ptr);
+    int32_t topn = 0;
+    memcpy(&topn, src.ptr, sizeof(int32_t));
+    if (topn == 0) {
+        // no value is updated
+        return;
+    }
+    TopNCounter counter(1);
+    if (!counter.unserialize(src.ptr + sizeof(int32_t), src.len - sizeof(int32_t))) {
+        ctx->set_error("invalid state of topn");
+        return;
+    }
+    if (dst_state->counter == NULL) {
+        dst_state->topn = topn;
+        dst_state->counter = new TopNCounter(counter.capacity());
+    }
+    dst_state->counter->merge(counter);
+}
+
+StringVal AggregateFunctions::topn_serialize(FunctionContext* ctx, const StringVal& state_sv) {
+    DCHECK(!state_sv.is_null);
+    TopNState* state = reinterpret_cast<TopNState*>(state_sv.ptr);
+    size_t counter_size = state->counter == NULL ? 0 : state->counter->serialized_size();
+    StringVal result(ctx, sizeof(int32_t) + counter_size);
+    memcpy(result.ptr, &state->topn, sizeof(int32_t));
+    if (state->counter != NULL) {
+        state->counter->serialize(result.ptr + sizeof(int32_t));
+    }
+    delete state;
+    return result;
+}
+
+// output is json object of values to their counts, ordered by count, e.g.
+// {"a":10,"b":5}
+StringVal AggregateFunctions::topn_finalize(FunctionContext* ctx, const StringVal& state_sv) {
+    DCHECK(!state_sv.is_null);
+    TopNState* state = reinterpret_cast<TopNState*>(state_sv.ptr);
+    if (state->counter == NULL) {
+        delete state;
+        return StringVal::null();
+    }
+    std::vector<std::pair<std::string, uint64_t> > top;
+    state->counter->top(state->topn, &top);
+    delete state;
+
+    rapidjson::StringBuffer buf;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
+    writer.StartObject();
+    for (auto& value_count : top) {
+        writer.String(value_count.first.data(), value_count.first.size());
+        writer.Uint64(value_count.second);
+    }
+    writer.EndObject();
+    StringVal result(ctx, buf.GetSize());
+    memcpy(result.ptr, buf.GetString(), buf.GetSize());
+    return result;
+}
+
 struct RankState {
     int64_t rank;
     int64_t count;
@@ -2025,6 +2266,8 @@ template void AggregateFunctions::sum_remove<DecimalVal, DecimalVal>(
     FunctionContext*, const DecimalVal& src, DecimalVal* dst);
 template void AggregateFunctions::sum_remove<LargeIntVal, LargeIntVal>(
     FunctionContext*, const LargeIntVal& src, LargeIntVal* dst);
+template void AggregateFunctions::sum_remove<DecimalV2Val, DecimalV2Val>(
+    FunctionContext*, const DecimalV2Val& src, DecimalV2Val* dst);
 
 template void AggregateFunctions::avg_update<palo_udf::BooleanVal>(
     palo_udf::FunctionContext*, palo_udf::BooleanVal const&, palo_udf::StringVal*);
@@ -2080,6 +2323,8 @@ template void AggregateFunctions::min<DoubleVal>(
     FunctionContext*, const DoubleVal& src, DoubleVal* dst);
 template void AggregateFunctions::min<StringVal>(
     FunctionContext*, const StringVal& src, StringVal* dst);
+template void AggregateFunctions::min<DecimalV2Val>(
+    FunctionContext*, const DecimalV2Val& src, DecimalV2Val* dst);
 
 template void AggregateFunctions::avg_remove<palo_udf::BooleanVal>(
     palo_udf::FunctionContext*, palo_udf::BooleanVal const&, palo_udf::StringVal*);
@@ -2108,6 +2353,8 @@ template void AggregateFunctions::max<DoubleVal>(
     FunctionContext*, const DoubleVal& src, DoubleVal* dst);
 template void AggregateFunctions::max<StringVal>(
     FunctionContext*, const StringVal& src, StringVal* dst);
+template void AggregateFunctions::max<DecimalV2Val>(
+    FunctionContext*, const DecimalV2Val& src, DecimalV2Val* dst);
 
 template void AggregateFunctions::pc_update(
     FunctionContext*, const BooleanVal&, StringVal*);
@@ -2167,9 +2414,20 @@ template void AggregateFunctions::hll_update(
     FunctionContext*, const DateTimeVal&, StringVal*);
 template void AggregateFunctions::hll_update(
     FunctionContext*, const LargeIntVal&, StringVal*);
+template void AggregateFunctions::hll_update(
+    FunctionContext*, const DecimalV2Val&, StringVal*);
 template void AggregateFunctions::hll_update(
     FunctionContext*, const DecimalVal&, StringVal*);
 
+template void AggregateFunctions::bitmap_update_int(
+    FunctionContext*, const TinyIntVal&, StringVal*);
+template void AggregateFunctions::bitmap_update_int(
+    FunctionContext*, const SmallIntVal&, StringVal*);
+template void AggregateFunctions::bitmap_update_int(
+    FunctionContext*, const IntVal&, StringVal*);
+template void AggregateFunctions::bitmap_update_int(
+    FunctionContext*, const BigIntVal&, StringVal*);
+
 template void AggregateFunctions::count_or_sum_distinct_numeric_init<TinyIntVal>(
     FunctionContext* ctx, StringVal* dst);
 template void AggregateFunctions::count_or_sum_distinct_numeric_init<SmallIntVal>(
@@ -2313,12 +2571,16 @@ template void AggregateFunctions::first_val_rewrite_update<DateTimeVal>(
     FunctionContext*, const DateTimeVal& src, const BigIntVal&, DateTimeVal* dst);
 template void AggregateFunctions::first_val_rewrite_update<DecimalVal>(
     FunctionContext*, const DecimalVal& src, const BigIntVal&, DecimalVal* dst);
+template void AggregateFunctions::first_val_rewrite_update<DecimalV2Val>(
+    FunctionContext*, const DecimalV2Val& src, const BigIntVal&, DecimalV2Val* dst);
 
 
 //template void AggregateFunctions::FirstValUpdate<impala::StringValue>(
 //    palo_udf::FunctionContext*, impala::StringValue const&, impala::StringValue*);
 template void AggregateFunctions::first_val_update<palo_udf::DecimalVal>(
     palo_udf::FunctionContext*, palo_udf::DecimalVal const&, palo_udf::DecimalVal*);
+template void AggregateFunctions::first_val_update<palo_udf::DecimalV2Val>(
+    palo_udf::FunctionContext*, palo_udf::DecimalV2Val const&, palo_udf::DecimalV2Val*);
 
 template void AggregateFunctions::last_val_update<BooleanVal>(
     FunctionContext*, const BooleanVal& src, BooleanVal* dst);
@@ -2340,6 +2602,8 @@ template void AggregateFunctions::last_val_update<DateTimeVal>(
     FunctionContext*, const DateTimeVal& src, DateTimeVal* dst);
 template void AggregateFunctions::last_val_update<DecimalVal>(
     FunctionContext*, const DecimalVal& src, DecimalVal* dst);
+template void AggregateFunctions::last_val_update<DecimalV2Val>(
+    FunctionContext*, const DecimalV2Val& src, DecimalV2Val* dst);
 
 template void AggregateFunctions::last_val_remove<BooleanVal>(
     FunctionContext*, const BooleanVal& src, BooleanVal* dst);
@@ -2361,6 +2625,8 @@ template void AggregateFunctions::last_val_remove<DateTimeVal>(
     FunctionContext*, const DateTimeVal& src, DateTimeVal* dst);
 template void AggregateFunctions::last_val_remove<DecimalVal>(
     FunctionContext*, const DecimalVal& src, DecimalVal* dst);
+template void AggregateFunctions::last_val_remove<DecimalV2Val>(
+    FunctionContext*, const DecimalV2Val& src, DecimalV2Val* dst);
 
 template void AggregateFunctions::offset_fn_init<BooleanVal>(
     FunctionContext*, BooleanVal*);
@@ -2382,6 +2648,8 @@ template void AggregateFunctions::offset_fn_init<DateTimeVal>(
     FunctionContext*, DateTimeVal*);
 template void AggregateFunctions::offset_fn_init<DecimalVal>(
     FunctionContext*, DecimalVal*);
+template void AggregateFunctions::offset_fn_init<DecimalV2Val>(
+    FunctionContext*, DecimalV2Val*);
 
 template void AggregateFunctions::offset_fn_update<BooleanVal>(
     FunctionContext*, const BooleanVal& src, const BigIntVal&, const BooleanVal&,
@@ -2412,5 +2680,8 @@ template void AggregateFunctions::offset_fn_update<DateTimeVal>(
 template void AggregateFunctions::offset_fn_update<DecimalVal>(
     FunctionContext*, const DecimalVal& src, const BigIntVal&, const DecimalVal&,
     DecimalVal* dst);
+template void AggregateFunctions::offset_fn_update<DecimalV2Val>(
+    FunctionContext*, const DecimalV2Val& src, const BigIntVal&, const DecimalV2Val&,
+    DecimalV2Val* dst);
 
 }
@@ -119,6 +119,21 @@ dst);
     static palo_udf::DecimalVal decimal_avg_finalize(palo_udf::FunctionContext* ctx,
          const palo_udf::StringVal& val);
 
+    // Avg for decimalv2, sum is kept as scaled int128
+    static void decimalv2_avg_init(palo_udf::FunctionContext* ctx, palo_udf::StringVal* dst);
+    static void decimalv2_avg_update(palo_udf::FunctionContext* ctx,
+            const palo_udf::DecimalV2Val& src,
+            palo_udf::StringVal* dst);
+    static void decimalv2_avg_merge(FunctionContext* ctx, const palo_udf::StringVal& src,
+            palo_udf::StringVal* dst);
+    static void decimalv2_avg_remove(palo_udf::FunctionContext* ctx,
+            const palo_udf::DecimalV2Val& src,
+            palo_udf::StringVal* dst);
+    static palo_udf::DecimalV2Val decimalv2_avg_get_value(palo_udf::FunctionContext* ctx,
+         const palo_udf::StringVal& val);
+    static palo_udf::DecimalV2Val decimalv2_avg_finalize(palo_udf::FunctionContext* ctx,
+         const palo_udf::StringVal& val);
+
     // SumUpdate, SumMerge
     template <typename SRC_VAL, typename DST_VAL>
     static void sum(palo_udf::FunctionContext*, const SRC_VAL& src, DST_VAL* dst);
@@ -248,6 +263,28 @@ dst);
     /// Calculates the biased STDDEV, uses KnuthVar Init-Update-Merge functions
     static DoubleVal knuth_stddev_pop_finalize(FunctionContext* context, const StringVal& val);
 
+    // PERCENTILE_APPROX, estimates quantile of values with TDigest.
+    // The state is serialized as quantile:digest
+    static void percentile_approx_init(FunctionContext* ctx, StringVal* dst);
+    static void percentile_approx_update(FunctionContext* ctx, const DoubleVal& src,
+                                         const DoubleVal& quantile, StringVal* dst);
+    static void percentile_approx_merge(FunctionContext* ctx, const StringVal& src,
+                                        StringVal* dst);
+    static StringVal percentile_approx_serialize(FunctionContext* ctx, const StringVal& state_sv);
+    static DoubleVal percentile_approx_finalize(FunctionContext* ctx, const StringVal& state_sv);
+
+    // TOPN(value, topn[, space_expand_rate]), finds most frequent values with
+    // TopNCounter of capacity topn * space_expand_rate, returns json string of
+    // values to their counts. The state is serialized as topn:counter
+    static void topn_init(FunctionContext* ctx, StringVal* dst);
+    static void topn_update(FunctionContext* ctx, const StringVal& src, const IntVal& topn,
+                            StringVal* dst);
+    static void topn_update(FunctionContext* ctx, const StringVal& src, const IntVal& topn,
+                            const IntVal& space_expand_rate, StringVal* dst);
+    static void topn_merge(FunctionContext* ctx, const StringVal& src, StringVal* dst);
+    static StringVal topn_serialize(FunctionContext* ctx, const StringVal& state_sv);
+    static StringVal topn_finalize(FunctionContext* ctx, const StringVal& state_sv);
+
     /// ----------------------------- Analytic Functions ---------------------------------
     /// Analytic functions implement the UDA interface (except Merge(), Serialize()) and are
     /// used internally by the AnalyticEvalNode. Some analytic functions store intermediate
@@ -310,7 +347,7 @@ dst);
     //  HLL value type calculate
     //  init sets buffer
     static void hll_union_agg_init(palo_udf::FunctionContext*, palo_udf::StringVal* slot);
-    // fill all register accroading to hll set type
+    // merge hll value of any set type
     static void hll_union_agg_update(palo_udf::FunctionContext*, const palo_udf::StringVal& src, 
                                      palo_udf::StringVal* dst);
     // merge the register value
@@ -324,7 +361,21 @@ dst);
                                             const palo_udf::StringVal& src);
     // calculate result
     static int64_t hll_algorithm(const palo_udf::StringVal& src);
-    static void hll_union_parse_and_cal(HllSetResolver& resolver, StringVal* dst);
+
+    // BITMAP_UNION_INT counts distinct integers exactly with RoaringBitmap,
+    // BITMAP_UNION_AGG counts distinct values of serialized bitmaps, e.g.
+    // columns of BITMAP_UNION. The state is serialized bitmap.
+    static void bitmap_init(palo_udf::FunctionContext*, palo_udf::StringVal* dst);
+    template <typename T>
+    static void bitmap_update_int(palo_udf::FunctionContext*, const T& src,
+                                  palo_udf::StringVal* dst);
+    // merge serialized bitmap
+    static void bitmap_merge(palo_udf::FunctionContext*, const palo_udf::StringVal& src,
+                             palo_udf::StringVal* dst);
+    static palo_udf::StringVal bitmap_serialize(palo_udf::FunctionContext*,
+                                                const palo_udf::StringVal& src);
+    static palo_udf::BigIntVal bitmap_finalize(palo_udf::FunctionContext*,
+                                               const palo_udf::StringVal& src);
 };
 
 }
@@ -34,6 +34,7 @@ using palo_udf::LargeIntVal;
 using palo_udf::FloatVal;
 using palo_udf::DoubleVal;
 using palo_udf::DecimalVal;
+using palo_udf::DecimalV2Val;
 using palo_udf::DateTimeVal;
 using palo_udf::StringVal;
 using palo_udf::AnyVal;
@@ -88,6 +89,9 @@ AnyVal* create_any_val(ObjectPool* pool, const TypeDescriptor& type) {
     case TYPE_DECIMAL:
         return pool->add(new DecimalVal);
 
+    case TYPE_DECIMALV2:
+        return pool->add(new DecimalV2Val);
+
     case TYPE_DATE:
         return pool->add(new DateTimeVal);
 
@@ -149,6 +153,11 @@ FunctionContext::TypeDesc AnyValUtil::column_type_to_type_desc(const TypeDescrip
         // out.precision = type.precision;
         // out.scale = type.scale;
         break;
+    case TYPE_DECIMALV2:
+        out.type = FunctionContext::TYPE_DECIMALV2;
+        out.precision = type.precision;
+        out.scale = type.scale;
+        break;
     case TYPE_NULL:
         out.type = FunctionContext::TYPE_NULL;
         break;
@@ -80,6 +80,10 @@ public:
         return HashUtil::hash(&v.val, 8, seed);
     }
 
+    static uint32_t hash(const palo_udf::DecimalV2Val& v, int seed) {
+        return HashUtil::hash(&v.val, 16, seed);
+    }
+
     static uint64_t hash64(const palo_udf::BooleanVal& v, int64_t seed) {
         return HashUtil::fnv_hash64(&v.val, 1, seed);
     }
@@ -128,6 +132,10 @@ public:
         return HashUtil::fnv_hash64(&v.val, 8, seed);
     }
 
+    static uint64_t hash64(const palo_udf::DecimalV2Val& v, int64_t seed) {
+        return HashUtil::fnv_hash64(&v.val, 16, seed);
+    }
+
     static uint64_t hash64_murmur(const palo_udf::BooleanVal& v, int64_t seed) {
         return HashUtil::murmur_hash64A(&v.val, 1, seed);
     }
@@ -174,6 +182,10 @@ public:
         return HashUtil::murmur_hash64A(&v.val, 8, seed);
     }
 
+    static uint64_t hash64_murmur(const palo_udf::DecimalV2Val& v, int64_t seed) {
+        return HashUtil::murmur_hash64A(&v.val, 16, seed);
+    }
+
     static palo_udf::FunctionContext::Type primitive_type_to_type(const PrimitiveType& type) {
     switch (type) {
     case TYPE_NULL:
@@ -204,6 +216,8 @@ public:
         return palo_udf::FunctionContext::TYPE_STRING;
     case TYPE_DECIMAL:
         return palo_udf::FunctionContext::TYPE_DECIMAL;
+    case TYPE_DECIMALV2:
+        return palo_udf::FunctionContext::TYPE_DECIMALV2;
     break;
     default:
     DCHECK(false) << "Unknown type: " << type;
@@ -249,6 +263,9 @@ public:
         case TYPE_DECIMAL:
             return sizeof(palo_udf::DecimalVal);
 
+        case TYPE_DECIMALV2:
+            return sizeof(palo_udf::DecimalV2Val);
+
         default:
             DCHECK(false) << t;
             return 0;
@@ -274,6 +291,7 @@ public:
         case TYPE_DATE:
           return alignof(DateTimeVal);
         case TYPE_DECIMAL: return alignof(DecimalVal);
+        case TYPE_DECIMALV2: return alignof(DecimalV2Val);
         default:
             DCHECK(false) << t;
             return 0;
@@ -366,6 +384,9 @@ public:
             reinterpret_cast<const DecimalValue*>(slot)->to_decimal_val(
             reinterpret_cast<palo_udf::DecimalVal*>(dst));
             return; 
+        case TYPE_DECIMALV2:
+            memcpy(&reinterpret_cast<palo_udf::DecimalV2Val*>(dst)->val, slot, sizeof(__int128));
+            return;
         case TYPE_DATE:
             reinterpret_cast<const DateTimeValue*>(slot)->to_datetime_val(
             reinterpret_cast<palo_udf::DateTimeVal*>(dst));
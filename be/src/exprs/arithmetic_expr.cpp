@@ -22,6 +22,7 @@
 
 #include "codegen/llvm_codegen.h"
 #include "codegen/codegen_anyval.h"
+#include "exprs/expr_column.h"
 #include "runtime/runtime_state.h"
 
 using llvm::BasicBlock;
@@ -174,6 +175,211 @@ BINARY_BIT_FNS(BitXorExpr, ^)
 
 BITNOT_FNS()
 
+// Operators of batch evaluation. is_null() returns true if result is null
+// for the right value.
+struct AddOp {
+    template <typename T>
+    static T apply(T a, T b) { return a + b; }
+    template <typename T>
+    static bool is_null(T b) { return false; }
+};
+
+struct SubOp {
+    template <typename T>
+    static T apply(T a, T b) { return a - b; }
+    template <typename T>
+    static bool is_null(T b) { return false; }
+};
+
+struct MulOp {
+    template <typename T>
+    static T apply(T a, T b) { return a * b; }
+    template <typename T>
+    static bool is_null(T b) { return false; }
+};
+
+struct DivOp {
+    template <typename T>
+    static T apply(T a, T b) { return a / b; }
+    template <typename T>
+    static bool is_null(T b) { return b == 0; }
+};
+
+struct ModOp {
+    template <typename T>
+    static T apply(T a, T b) { return a % b; }
+    static float apply(float a, float b) { return fmod(a, b); }
+    static double apply(double a, double b) { return fmod(a, b); }
+    template <typename T>
+    static bool is_null(T b) { return b == 0; }
+    static bool is_null(float b) { return false; }
+    static bool is_null(double b) { return false; }
+};
+
+struct BitAndOp {
+    template <typename T>
+    static T apply(T a, T b) { return a & b; }
+    template <typename T>
+    static bool is_null(T b) { return false; }
+};
+
+struct BitOrOp {
+    template <typename T>
+    static T apply(T a, T b) { return a | b; }
+    template <typename T>
+    static bool is_null(T b) { return false; }
+};
+
+struct BitXorOp {
+    template <typename T>
+    static T apply(T a, T b) { return a ^ b; }
+    template <typename T>
+    static bool is_null(T b) { return false; }
+};
+
+template <typename T, typename OP>
+Status ArithmeticExpr::evaluate_binary_batch(
+        ExprContext* context, RowBatch* batch, const int* sel,
+        int num_rows, MemPool* pool, ExprColumn* result) {
+    ExprColumn lhs;
+    RETURN_IF_ERROR(_children[0]->evaluate_batch(context, batch, sel, num_rows, pool, &lhs));
+    ExprColumn rhs;
+    RETURN_IF_ERROR(_children[1]->evaluate_batch(context, batch, sel, num_rows, pool, &rhs));
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+
+    const T* a = lhs.data<T>();
+    const T* b = rhs.data<T>();
+    T* c = result->data<T>();
+    uint8_t* nulls = result->nulls();
+    bool has_nulls = lhs.has_nulls() || rhs.has_nulls();
+    if (has_nulls) {
+        const uint8_t* lhs_nulls = lhs.nulls();
+        const uint8_t* rhs_nulls = rhs.nulls();
+        for (int i = 0; i < num_rows; ++i) {
+            nulls[i] = lhs_nulls[i] | rhs_nulls[i];
+        }
+    }
+    for (int i = 0; i < num_rows; ++i) {
+        if (OP::is_null(b[i])) {
+            nulls[i] = 1;
+            has_nulls = true;
+        }
+    }
+
+    if (!has_nulls) {
+        // no branch, so that it can be vectorized
+        for (int i = 0; i < num_rows; ++i) {
+            c[i] = OP::apply(a[i], b[i]);
+        }
+    } else {
+        // values of null rows are left zero
+        for (int i = 0; i < num_rows; ++i) {
+            if (!nulls[i]) {
+                c[i] = OP::apply(a[i], b[i]);
+            }
+        }
+    }
+    result->set_has_nulls(has_nulls);
+    return Status::OK;
+}
+
+template <typename OP>
+Status ArithmeticExpr::evaluate_numeric_batch(
+        ExprContext* context, RowBatch* batch, const int* sel,
+        int num_rows, MemPool* pool, bool allow_float, ExprColumn* result) {
+    // children are casted to result type by FE, fall back to row by row
+    // evaluation in case they are not
+    if (_children[0]->type().type != _type.type || _children[1]->type().type != _type.type) {
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    switch (_type.type) {
+    case TYPE_TINYINT:
+        return evaluate_binary_batch<int8_t, OP>(context, batch, sel, num_rows, pool, result);
+    case TYPE_SMALLINT:
+        return evaluate_binary_batch<int16_t, OP>(context, batch, sel, num_rows, pool, result);
+    case TYPE_INT:
+        return evaluate_binary_batch<int32_t, OP>(context, batch, sel, num_rows, pool, result);
+    case TYPE_BIGINT:
+        return evaluate_binary_batch<int64_t, OP>(context, batch, sel, num_rows, pool, result);
+    case TYPE_LARGEINT:
+        return evaluate_binary_batch<__int128, OP>(context, batch, sel, num_rows, pool, result);
+    case TYPE_FLOAT:
+        if (allow_float) {
+            return evaluate_binary_batch<float, OP>(
+                context, batch, sel, num_rows, pool, result);
+        }
+        break;
+    case TYPE_DOUBLE:
+        if (allow_float) {
+            return evaluate_binary_batch<double, OP>(
+                context, batch, sel, num_rows, pool, result);
+        }
+        break;
+    default:
+        break;
+    }
+    return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+}
+
+#define BINARY_BATCH_FN(CLASS, OP, ALLOW_FLOAT) \
+    Status CLASS::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel, \
+                                 int num_rows, MemPool* pool, ExprColumn* result) { \
+        return evaluate_numeric_batch<OP>( \
+            context, batch, sel, num_rows, pool, ALLOW_FLOAT, result); \
+    }
+
+BINARY_BATCH_FN(AddExpr, AddOp, true)
+BINARY_BATCH_FN(SubExpr, SubOp, true)
+BINARY_BATCH_FN(MulExpr, MulOp, true)
+BINARY_BATCH_FN(DivExpr, DivOp, true)
+BINARY_BATCH_FN(ModExpr, ModOp, true)
+BINARY_BATCH_FN(BitAndExpr, BitAndOp, false)
+BINARY_BATCH_FN(BitOrExpr, BitOrOp, false)
+BINARY_BATCH_FN(BitXorExpr, BitXorOp, false)
+
+template <typename T>
+static void bit_not_batch(const ExprColumn& child, ExprColumn* result) {
+    const T* a = child.data<T>();
+    T* c = result->data<T>();
+    const uint8_t* nulls = child.nulls();
+    for (int i = 0; i < child.num_rows(); ++i) {
+        // keep values of null rows zero
+        c[i] = nulls[i] ? 0 : ~a[i];
+    }
+    memcpy(result->nulls(), nulls, child.num_rows());
+    result->set_has_nulls(child.has_nulls());
+}
+
+Status BitNotExpr::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result) {
+    if (_children[0]->type().type != _type.type) {
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    ExprColumn child;
+    RETURN_IF_ERROR(_children[0]->evaluate_batch(context, batch, sel, num_rows, pool, &child));
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+    switch (_type.type) {
+    case TYPE_TINYINT:
+        bit_not_batch<int8_t>(child, result);
+        break;
+    case TYPE_SMALLINT:
+        bit_not_batch<int16_t>(child, result);
+        break;
+    case TYPE_INT:
+        bit_not_batch<int32_t>(child, result);
+        break;
+    case TYPE_BIGINT:
+        bit_not_batch<int64_t>(child, result);
+        break;
+    case TYPE_LARGEINT:
+        bit_not_batch<__int128>(child, result);
+        break;
+    default:
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    return Status::OK;
+}
+
 // IR codegen for compound add predicates.  Compound predicate has non trivial 
 // null handling as well as many branches so this is pretty complicated.  The IR 
 // for x && y is:
@@ -46,6 +46,20 @@ protected:
 
     Status codegen_binary_op(
         RuntimeState* state, llvm::Function** fn, BinaryOpType op_type);
+
+    // Evaluate both children into columns and compute OP::apply() of all rows,
+    // T is the type of children and result. Rows are null if any child is null,
+    // or OP::is_null() of right value is true, e.g. divided by zero.
+    template <typename T, typename OP>
+    Status evaluate_binary_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                 int num_rows, MemPool* pool, ExprColumn* result);
+
+    // Call evaluate_binary_batch() of result type, which should be integer,
+    // or float if 'allow_float' is true
+    template <typename OP>
+    Status evaluate_numeric_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                 int num_rows, MemPool* pool, bool allow_float,
+                                 ExprColumn* result);
 };
 
 class AddExpr : public ArithmeticExpr {
@@ -63,6 +77,8 @@ public:
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
     virtual FloatVal get_float_val(ExprContext* context, TupleRow*);
     virtual DoubleVal get_double_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class SubExpr : public ArithmeticExpr {
@@ -80,6 +96,8 @@ public:
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
     virtual FloatVal get_float_val(ExprContext* context, TupleRow*);
     virtual DoubleVal get_double_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class MulExpr : public ArithmeticExpr {
@@ -97,6 +115,8 @@ public:
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
     virtual FloatVal get_float_val(ExprContext* context, TupleRow*);
     virtual DoubleVal get_double_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class DivExpr : public ArithmeticExpr {
@@ -114,6 +134,8 @@ public:
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
     virtual FloatVal get_float_val(ExprContext* context, TupleRow*);
     virtual DoubleVal get_double_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class ModExpr : public ArithmeticExpr {
@@ -131,6 +153,8 @@ public:
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
     virtual FloatVal get_float_val(ExprContext* context, TupleRow*);
     virtual DoubleVal get_double_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class BitAndExpr : public ArithmeticExpr {
@@ -146,6 +170,8 @@ public:
     virtual IntVal get_int_val(ExprContext* context, TupleRow*);
     virtual BigIntVal get_big_int_val(ExprContext* context, TupleRow*);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class BitOrExpr : public ArithmeticExpr {
@@ -161,6 +187,8 @@ public:
     virtual IntVal get_int_val(ExprContext* context, TupleRow*);
     virtual BigIntVal get_big_int_val(ExprContext* context, TupleRow*);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class BitXorExpr : public ArithmeticExpr {
@@ -176,6 +204,8 @@ public:
     virtual IntVal get_int_val(ExprContext* context, TupleRow*);
     virtual BigIntVal get_big_int_val(ExprContext* context, TupleRow*);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 class BitNotExpr : public ArithmeticExpr {
@@ -191,6 +221,8 @@ public:
     virtual IntVal get_int_val(ExprContext* context, TupleRow*);
     virtual BigIntVal get_big_int_val(ExprContext* context, TupleRow*);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 }
@@ -20,16 +20,19 @@
 
 #include "exprs/binary_predicate.h"
 
+#include <functional>
 #include <sstream>
 
 #include "codegen/llvm_codegen.h"
 #include "codegen/codegen_anyval.h"
+#include "exprs/expr_column.h"
 #include "util/debug_util.h"
 #include "gen_cpp/Exprs_types.h"
 #include "runtime/runtime_state.h"
 #include "runtime/string_value.h"
 #include "runtime/datetime_value.h"
 #include "runtime/decimal_value.h"
+#include "runtime/row_batch.h"
 
 using llvm::BasicBlock;
 using llvm::CmpInst;
@@ -70,6 +73,8 @@ Expr* BinaryPredicate::from_thrift(const TExprNode& node) {
             return new EqDateTimeValPred(node);
         case TPrimitiveType::DECIMAL:
             return new EqDecimalValPred(node);
+        case TPrimitiveType::DECIMALV2:
+            return new EqDecimalV2ValPred(node);
         default:
             return NULL;
         }
@@ -100,6 +105,8 @@ Expr* BinaryPredicate::from_thrift(const TExprNode& node) {
             return new NeDateTimeValPred(node);
         case TPrimitiveType::DECIMAL:
             return new NeDecimalValPred(node);
+        case TPrimitiveType::DECIMALV2:
+            return new NeDecimalV2ValPred(node);
         default:
             return NULL;
         }
@@ -130,6 +137,8 @@ Expr* BinaryPredicate::from_thrift(const TExprNode& node) {
             return new LtDateTimeValPred(node);
         case TPrimitiveType::DECIMAL:
             return new LtDecimalValPred(node);
+        case TPrimitiveType::DECIMALV2:
+            return new LtDecimalV2ValPred(node);
         default:
             return NULL;
         }
@@ -160,6 +169,8 @@ Expr* BinaryPredicate::from_thrift(const TExprNode& node) {
             return new LeDateTimeValPred(node);
         case TPrimitiveType::DECIMAL:
             return new LeDecimalValPred(node);
+        case TPrimitiveType::DECIMALV2:
+            return new LeDecimalV2ValPred(node);
         default:
             return NULL;
         }
@@ -190,6 +201,8 @@ Expr* BinaryPredicate::from_thrift(const TExprNode& node) {
             return new GtDateTimeValPred(node);
         case TPrimitiveType::DECIMAL:
             return new GtDecimalValPred(node);
+        case TPrimitiveType::DECIMALV2:
+            return new GtDecimalV2ValPred(node);
         default:
             return NULL;
         }
@@ -220,6 +233,8 @@ Expr* BinaryPredicate::from_thrift(const TExprNode& node) {
             return new GeDateTimeValPred(node);
         case TPrimitiveType::DECIMAL:
             return new GeDecimalValPred(node);
+        case TPrimitiveType::DECIMALV2:
+            return new GeDecimalV2ValPred(node);
         default:
             return NULL;
         }
@@ -421,6 +436,7 @@ BINARY_PRED_FLOAT_FNS(DoubleVal, get_double_val);
     COMPLICATE_BINARY_PRED_FN(Ge##TYPE##Pred, TYPE, FN, PALO_TYPE, FROM_FUNC, >=)
 
 COMPLICATE_BINARY_PRED_FNS(DecimalVal, get_decimal_val, DecimalValue, from_decimal_val)
+COMPLICATE_BINARY_PRED_FNS(DecimalV2Val, get_decimalv2_val, DecimalV2Value, from_decimal_val)
 
 #define DATETIME_BINARY_PRED_FN(CLASS, OP, LLVM_PRED) \
     BooleanVal CLASS::get_boolean_val(ExprContext* ctx, TupleRow* row) { \
@@ -500,6 +516,70 @@ Status EqStringValPred::get_codegend_compute_fn(RuntimeState* state, llvm::Funct
     return get_codegend_compute_fn_wrapper(state, fn);
 }
 
+template <typename T, typename CMP>
+Status BinaryPredicate::compare_batch(ExprContext* ctx, RowBatch* batch, const int* sel,
+                                      int num_rows, MemPool* pool, ExprColumn* result) {
+    // e.g. NULL literal which is not casted
+    const int slot_size = sizeof(T);
+    if (get_slot_size(_children[0]->type().type) != slot_size
+            || get_slot_size(_children[1]->type().type) != slot_size) {
+        return Expr::evaluate_batch(ctx, batch, sel, num_rows, pool, result);
+    }
+    ExprColumn lhs;
+    RETURN_IF_ERROR(_children[0]->evaluate_batch(ctx, batch, sel, num_rows, pool, &lhs));
+    ExprColumn rhs;
+    RETURN_IF_ERROR(_children[1]->evaluate_batch(ctx, batch, sel, num_rows, pool, &rhs));
+    RETURN_IF_ERROR(result->init(TYPE_BOOLEAN, num_rows, pool));
+
+    // values of null rows are zero, comparing them is safe
+    const T* a = lhs.data<T>();
+    const T* b = rhs.data<T>();
+    bool* c = result->data<bool>();
+    CMP cmp;
+    if (!lhs.has_nulls() && !rhs.has_nulls()) {
+        for (int i = 0; i < num_rows; ++i) {
+            c[i] = cmp(a[i], b[i]);
+        }
+        return Status::OK;
+    }
+    const uint8_t* lhs_nulls = lhs.nulls();
+    const uint8_t* rhs_nulls = rhs.nulls();
+    uint8_t* nulls = result->nulls();
+    for (int i = 0; i < num_rows; ++i) {
+        nulls[i] = lhs_nulls[i] | rhs_nulls[i];
+        c[i] = !nulls[i] && cmp(a[i], b[i]);
+    }
+    result->set_has_nulls(true);
+    return Status::OK;
+}
+
+#define BINARY_PRED_BATCH_FN(CLASS, T, CMP) \
+    Status CLASS::evaluate_batch(ExprContext* ctx, RowBatch* batch, const int* sel, \
+                                 int num_rows, MemPool* pool, ExprColumn* result) { \
+        return compare_batch<T, CMP<T> >(ctx, batch, sel, num_rows, pool, result); \
+    }
+
+#define BINARY_PRED_BATCH_FNS(TYPE, T) \
+    BINARY_PRED_BATCH_FN(Eq##TYPE##Pred, T, std::equal_to) \
+    BINARY_PRED_BATCH_FN(Ne##TYPE##Pred, T, std::not_equal_to) \
+    BINARY_PRED_BATCH_FN(Lt##TYPE##Pred, T, std::less) \
+    BINARY_PRED_BATCH_FN(Le##TYPE##Pred, T, std::less_equal) \
+    BINARY_PRED_BATCH_FN(Gt##TYPE##Pred, T, std::greater) \
+    BINARY_PRED_BATCH_FN(Ge##TYPE##Pred, T, std::greater_equal)
+
+BINARY_PRED_BATCH_FNS(BooleanVal, bool)
+BINARY_PRED_BATCH_FNS(TinyIntVal, int8_t)
+BINARY_PRED_BATCH_FNS(SmallIntVal, int16_t)
+BINARY_PRED_BATCH_FNS(IntVal, int32_t)
+BINARY_PRED_BATCH_FNS(BigIntVal, int64_t)
+BINARY_PRED_BATCH_FNS(LargeIntVal, __int128)
+BINARY_PRED_BATCH_FNS(FloatVal, float)
+BINARY_PRED_BATCH_FNS(DoubleVal, double)
+BINARY_PRED_BATCH_FNS(StringVal, StringValue)
+BINARY_PRED_BATCH_FNS(DateTimeVal, DateTimeValue)
+BINARY_PRED_BATCH_FNS(DecimalVal, DecimalValue)
+BINARY_PRED_BATCH_FNS(DecimalV2Val, __int128)
+
 #if 0
 Status EqStringValPred::get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn) {
     LlvmCodeGen* codegen = NULL;
@@ -43,6 +43,12 @@ protected:
 
     Status codegen_compare_fn(
         RuntimeState* state, llvm::Function** fn, llvm::CmpInst::Predicate pred);
+
+    // Evaluate both children into columns and compare values of each row by CMP,
+    // T is the slot type of children
+    template <typename T, typename CMP>
+    Status compare_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                         int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 #define BIN_PRED_CLASS_DEFINE(CLASS) \
@@ -55,6 +61,8 @@ protected:
         \
         virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn); \
         virtual BooleanVal get_boolean_val(ExprContext* context, TupleRow*); \
+        virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel, \
+                                      int num_rows, MemPool* pool, ExprColumn* result); \
     };
 
 #define BIN_PRED_CLASSES_DEFINE(TYPE) \
@@ -76,5 +84,6 @@ BIN_PRED_CLASSES_DEFINE(DoubleVal)
 BIN_PRED_CLASSES_DEFINE(StringVal)
 BIN_PRED_CLASSES_DEFINE(DateTimeVal)
 BIN_PRED_CLASSES_DEFINE(DecimalVal)
+BIN_PRED_CLASSES_DEFINE(DecimalV2Val)
 }
 #endif
@@ -0,0 +1,51 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/bitmap_function.h"
+
+#include "util/roaring_bitmap.h"
+
+namespace palo {
+
+using palo_udf::BigIntVal;
+using palo_udf::FunctionContext;
+using palo_udf::StringVal;
+
+void BitmapFunctions::init() {
+}
+
+StringVal BitmapFunctions::to_bitmap(FunctionContext* ctx, const BigIntVal& src) {
+    RoaringBitmap bitmap;
+    if (!src.is_null) {
+        bitmap.add((uint64_t)src.val);
+    }
+    StringVal result(ctx, bitmap.serialized_size());
+    bitmap.serialize(result.ptr);
+    return result;
+}
+
+BigIntVal BitmapFunctions::bitmap_count(FunctionContext* ctx, const StringVal& src) {
+    if (src.is_null) {
+        return BigIntVal::null();
+    }
+    RoaringBitmap bitmap;
+    if (!bitmap.unserialize(src.ptr, src.len)) {
+        ctx->set_error("invalid serialized bitmap");
+        return BigIntVal::null();
+    }
+    return BigIntVal(bitmap.cardinality());
+}
+
+}
@@ -0,0 +1,37 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include "udf/udf.h"
+
+namespace palo {
+
+// Functions of serialized RoaringBitmap, which is stored in VARCHAR columns
+// of BITMAP_UNION aggregation
+class BitmapFunctions {
+public:
+    static void init();
+
+    // Return bitmap of one value, to load values into BITMAP_UNION columns.
+    // Return empty bitmap if value is null.
+    static palo_udf::StringVal to_bitmap(palo_udf::FunctionContext* ctx,
+                                         const palo_udf::BigIntVal& src);
+    // Return number of values in bitmap
+    static palo_udf::BigIntVal bitmap_count(palo_udf::FunctionContext* ctx,
+                                            const palo_udf::StringVal& src);
+};
+
+}
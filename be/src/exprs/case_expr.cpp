@@ -23,6 +23,8 @@
 #include "codegen/llvm_codegen.h"
 #include "codegen/codegen_anyval.h"
 #include "exprs/anyval_util.h"
+#include "exprs/expr_column.h"
+#include "runtime/raw_value.h"
 #include "runtime/runtime_state.h"
 #include "gen_cpp/Exprs_types.h"
 
@@ -335,6 +337,9 @@ void CaseExpr::get_child_val(int child_idx, ExprContext* ctx, TupleRow* row, Any
     case TYPE_DECIMAL:
         *reinterpret_cast<DecimalVal*>(dst) = _children[child_idx]->get_decimal_val(ctx, row);
         break;
+    case TYPE_DECIMALV2:
+        *reinterpret_cast<DecimalV2Val*>(dst) = _children[child_idx]->get_decimalv2_val(ctx, row);
+        break;
     case TYPE_LARGEINT:
         *reinterpret_cast<LargeIntVal*>(dst) = _children[child_idx]->get_large_int_val(ctx, row);
         break;
@@ -378,6 +383,9 @@ bool CaseExpr::any_val_eq(const TypeDescriptor& type, const AnyVal* v1, const An
     case TYPE_DECIMAL:
         return AnyValUtil::equals(type, *reinterpret_cast<const DecimalVal*>(v1),
                                   *reinterpret_cast<const DecimalVal*>(v2));
+    case TYPE_DECIMALV2:
+        return AnyValUtil::equals(type, *reinterpret_cast<const DecimalV2Val*>(v1),
+                                  *reinterpret_cast<const DecimalV2Val*>(v2));
     case TYPE_LARGEINT:
         return AnyValUtil::equals(type, *reinterpret_cast<const LargeIntVal*>(v1),
                                   *reinterpret_cast<const LargeIntVal*>(v2));
@@ -387,6 +395,110 @@ bool CaseExpr::any_val_eq(const TypeDescriptor& type, const AnyVal* v1, const An
     }
 }
 
+Status CaseExpr::evaluate_child_batch(
+        int child_idx, ExprContext* ctx, RowBatch* batch, const int* sel,
+        const std::vector<int>& positions, MemPool* pool, ExprColumn* result) {
+    std::vector<int> rows(positions.size());
+    for (int j = 0; j < positions.size(); ++j) {
+        rows[j] = sel[positions[j]];
+    }
+    ExprColumn child;
+    RETURN_IF_ERROR(_children[child_idx]->evaluate_batch(
+            ctx, batch, &rows[0], rows.size(), pool, &child));
+    result->scatter(child, &positions[0]);
+    return Status::OK;
+}
+
+Status CaseExpr::evaluate_batch(ExprContext* ctx, RowBatch* batch, const int* sel,
+                                int num_rows, MemPool* pool, ExprColumn* result) {
+    int num_children = _children.size();
+    int loop_start = has_case_expr() ? 1 : 0;
+    int loop_end = has_else_expr() ? num_children - 1 : num_children;
+    // results of children are copied into result, and compared with case
+    // value, so their slot types must match. It may be not true for NULL literal.
+    const int slot_size = get_slot_size(_type.type);
+    const TypeDescriptor& when_type = _children[0]->type();
+    for (int i = loop_start; i < loop_end; i += 2) {
+        if (get_slot_size(_children[i]->type().type) != get_slot_size(when_type.type)
+                || get_slot_size(_children[i + 1]->type().type) != slot_size) {
+            return Expr::evaluate_batch(ctx, batch, sel, num_rows, pool, result);
+        }
+    }
+    if (has_else_expr() && get_slot_size(_children[num_children - 1]->type().type) != slot_size) {
+        return Expr::evaluate_batch(ctx, batch, sel, num_rows, pool, result);
+    }
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+
+    // positions of rows which are not matched yet
+    std::vector<int> remaining;
+    std::vector<int> else_positions;
+    remaining.reserve(num_rows);
+    ExprColumn case_col;
+    if (has_case_expr()) {
+        RETURN_IF_ERROR(_children[0]->evaluate_batch(ctx, batch, sel, num_rows, pool, &case_col));
+        for (int i = 0; i < num_rows; ++i) {
+            if (case_col.is_null(i)) {
+                else_positions.push_back(i);
+            } else {
+                remaining.push_back(i);
+            }
+        }
+    } else {
+        for (int i = 0; i < num_rows; ++i) {
+            remaining.push_back(i);
+        }
+    }
+
+    std::vector<int> rows;
+    std::vector<int> matched;
+    std::vector<int> unmatched;
+    for (int w = loop_start; w < loop_end && !remaining.empty(); w += 2) {
+        rows.resize(remaining.size());
+        for (int j = 0; j < remaining.size(); ++j) {
+            rows[j] = sel[remaining[j]];
+        }
+        ExprColumn when_col;
+        RETURN_IF_ERROR(_children[w]->evaluate_batch(
+                ctx, batch, &rows[0], rows.size(), pool, &when_col));
+        matched.clear();
+        unmatched.clear();
+        for (int j = 0; j < remaining.size(); ++j) {
+            int i = remaining[j];
+            bool is_match = false;
+            if (!when_col.is_null(j)) {
+                if (has_case_expr()) {
+                    is_match = RawValue::eq(
+                        case_col.get_value(i), when_col.get_value(j), when_type);
+                } else {
+                    is_match = when_col.data<bool>()[j];
+                }
+            }
+            if (is_match) {
+                matched.push_back(i);
+            } else {
+                unmatched.push_back(i);
+            }
+        }
+        if (!matched.empty()) {
+            RETURN_IF_ERROR(evaluate_child_batch(w + 1, ctx, batch, sel, matched, pool, result));
+        }
+        remaining.swap(unmatched);
+    }
+
+    else_positions.insert(else_positions.end(), remaining.begin(), remaining.end());
+    if (else_positions.empty()) {
+        return Status::OK;
+    }
+    if (has_else_expr()) {
+        return evaluate_child_batch(
+            num_children - 1, ctx, batch, sel, else_positions, pool, result);
+    }
+    for (int i : else_positions) {
+        result->set_null(i);
+    }
+    return Status::OK;
+}
+
 #define CASE_COMPUTE_FN(THEN_TYPE, TYPE_NAME) \
     THEN_TYPE CaseExpr::get_##TYPE_NAME(ExprContext* ctx, TupleRow* row) { \
         FunctionContext* fn_ctx = ctx->fn_context(_fn_context_index); \
@@ -441,6 +553,7 @@ CASE_COMPUTE_FN_WAPPER(DoubleVal, double_val)
 CASE_COMPUTE_FN_WAPPER(StringVal, string_val)
 CASE_COMPUTE_FN_WAPPER(DateTimeVal, datetime_val)
 CASE_COMPUTE_FN_WAPPER(DecimalVal, decimal_val)
+CASE_COMPUTE_FN_WAPPER(DecimalV2Val, decimalv2_val)
 
 
 }
@@ -49,6 +49,12 @@ public:
     virtual StringVal get_string_val(ExprContext* ctx, TupleRow* row);
     virtual DateTimeVal get_datetime_val(ExprContext* ctx, TupleRow* row);
     virtual DecimalVal get_decimal_val(ExprContext* ctx, TupleRow* row);
+    virtual DecimalV2Val get_decimalv2_val(ExprContext* ctx, TupleRow* row);
+
+    // Children are only evaluated for rows which reach them, as row by row
+    // evaluation does
+    virtual Status evaluate_batch(ExprContext* ctx, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 
 protected:
     friend class Expr;
@@ -82,6 +88,12 @@ private:
     /// specified child expr.
     void get_child_val(int child_idx, ExprContext* ctx, TupleRow* row, AnyVal* dst);
 
+    /// Evaluates child expr over rows sel[positions[j]] and copies the results to
+    /// positions[j] of 'result'.
+    Status evaluate_child_batch(int child_idx, ExprContext* ctx, RowBatch* batch,
+                                const int* sel, const std::vector<int>& positions,
+                                MemPool* pool, ExprColumn* result);
+
     /// Return true iff *v1 == *v2. v1 and v2 should both be of the specified type.
     bool any_val_eq(const TypeDescriptor& type, const AnyVal* v1, const AnyVal* v2);
 };
@@ -22,6 +22,7 @@
 
 #include "codegen/llvm_codegen.h"
 #include "codegen/codegen_anyval.h"
+#include "exprs/expr_column.h"
 #include "runtime/runtime_state.h"
 
 using llvm::BasicBlock;
@@ -169,6 +170,74 @@ CAST_FROM_DOUBLE(BigIntVal, get_big_int_val)
 CAST_FROM_DOUBLE(LargeIntVal, get_large_int_val)
 CAST_FROM_DOUBLE(FloatVal, get_float_val)
 
+template <typename FROM, typename TO>
+static void convert_column(const ExprColumn& child, ExprColumn* result) {
+    const FROM* from = child.data<FROM>();
+    TO* to = result->data<TO>();
+    // values of null rows are zero, so are the converted ones
+    for (int i = 0; i < child.num_rows(); ++i) {
+        to[i] = static_cast<TO>(from[i]);
+    }
+    memcpy(result->nulls(), child.nulls(), child.num_rows());
+    result->set_has_nulls(child.has_nulls());
+}
+
+template <typename FROM>
+Status CastExpr::cast_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                            int num_rows, MemPool* pool, ExprColumn* result) {
+    const int slot_size = sizeof(FROM);
+    if (get_slot_size(_children[0]->type().type) != slot_size) {
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    ExprColumn child;
+    RETURN_IF_ERROR(_children[0]->evaluate_batch(context, batch, sel, num_rows, pool, &child));
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+    switch (_type.type) {
+    case TYPE_BOOLEAN:
+        convert_column<FROM, bool>(child, result);
+        break;
+    case TYPE_TINYINT:
+        convert_column<FROM, int8_t>(child, result);
+        break;
+    case TYPE_SMALLINT:
+        convert_column<FROM, int16_t>(child, result);
+        break;
+    case TYPE_INT:
+        convert_column<FROM, int32_t>(child, result);
+        break;
+    case TYPE_BIGINT:
+        convert_column<FROM, int64_t>(child, result);
+        break;
+    case TYPE_LARGEINT:
+        convert_column<FROM, __int128>(child, result);
+        break;
+    case TYPE_FLOAT:
+        convert_column<FROM, float>(child, result);
+        break;
+    case TYPE_DOUBLE:
+        convert_column<FROM, double>(child, result);
+        break;
+    default:
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    return Status::OK;
+}
+
+#define CAST_BATCH_DEFINE(CLASS, FROM) \
+    Status CLASS::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel, \
+                                 int num_rows, MemPool* pool, ExprColumn* result) { \
+        return cast_batch<FROM>(context, batch, sel, num_rows, pool, result); \
+    }
+
+CAST_BATCH_DEFINE(CastBooleanExpr, bool);
+CAST_BATCH_DEFINE(CastTinyIntExpr, int8_t);
+CAST_BATCH_DEFINE(CastSmallIntExpr, int16_t);
+CAST_BATCH_DEFINE(CastIntExpr, int32_t);
+CAST_BATCH_DEFINE(CastBigIntExpr, int64_t);
+CAST_BATCH_DEFINE(CastLargeIntExpr, __int128);
+CAST_BATCH_DEFINE(CastFloatExpr, float);
+CAST_BATCH_DEFINE(CastDoubleExpr, double);
+
 // IR codegen for cast expression
 //
 // define i16 @cast(%"class.palo::ExprContext"* %context,
@@ -32,6 +32,12 @@ public:
     static Expr* from_thrift(const TExprNode& node);
 protected:
     Status codegen_cast_fn(RuntimeState* state, llvm::Function** fn);
+
+    // Evaluate child into a column and convert values to result type,
+    // FROM is the slot type of child
+    template <typename FROM>
+    Status cast_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                      int num_rows, MemPool* pool, ExprColumn* result);
 };
 
 #define CAST_EXPR_DEFINE(CLASS) \
@@ -51,6 +57,8 @@ protected:
         virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow*); \
         virtual FloatVal get_float_val(ExprContext* context, TupleRow*); \
         virtual DoubleVal get_double_val(ExprContext* context, TupleRow*); \
+        virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel, \
+                                      int num_rows, MemPool* pool, ExprColumn* result); \
     };
 
 CAST_EXPR_DEFINE(CastBooleanExpr);
@@ -20,10 +20,14 @@
 
 #include "exprs/compound_predicate.h"
 
+#include <string.h>
+
 #include <sstream>
+#include <vector>
 
 #include "codegen/llvm_codegen.h"
 #include "codegen/codegen_anyval.h"
+#include "exprs/expr_column.h"
 #include "util/debug_util.h"
 #include "runtime/runtime_state.h"
 
@@ -95,6 +99,80 @@ BooleanVal NotPredicate::get_boolean_val(ExprContext* context, TupleRow* row) {
     return BooleanVal(!val.val);
 }
 
+Status CompoundPredicate::evaluate_batch_and_or(
+        bool is_and, ExprContext* context, RowBatch* batch, const int* sel, int num_rows,
+        MemPool* pool, ExprColumn* result) {
+    DCHECK_EQ(_children.size(), 2);
+    ExprColumn lhs;
+    RETURN_IF_ERROR(_children[0]->evaluate_batch(context, batch, sel, num_rows, pool, &lhs));
+
+    // rows whose result is not decided by left value, i.e. left value is
+    // not false for AND, or not true for OR
+    const bool* lhs_values = lhs.data<bool>();
+    const uint8_t* lhs_nulls = lhs.nulls();
+    std::vector<int> positions;
+    std::vector<int> rows;
+    positions.reserve(num_rows);
+    for (int i = 0; i < num_rows; ++i) {
+        if (lhs_nulls[i] || lhs_values[i] == is_and) {
+            positions.push_back(i);
+        }
+    }
+    int num_undecided = positions.size();
+    if (num_undecided == 0) {
+        *result = lhs;
+        return Status::OK;
+    }
+    const int* rhs_sel = sel;
+    if (num_undecided < num_rows) {
+        rows.resize(num_undecided);
+        for (int j = 0; j < num_undecided; ++j) {
+            rows[j] = sel[positions[j]];
+        }
+        rhs_sel = &rows[0];
+    }
+    ExprColumn rhs;
+    RETURN_IF_ERROR(_children[1]->evaluate_batch(
+            context, batch, rhs_sel, num_undecided, pool, &rhs));
+
+    // rows decided by left value are copied as is
+    RETURN_IF_ERROR(result->init(TYPE_BOOLEAN, num_rows, pool));
+    bool* values = result->data<bool>();
+    memcpy(values, lhs_values, num_rows);
+    const bool* rhs_values = rhs.data<bool>();
+    const uint8_t* rhs_nulls = rhs.nulls();
+    for (int j = 0; j < num_undecided; ++j) {
+        int i = positions[j];
+        if (!rhs_nulls[j] && rhs_values[j] != is_and) {
+            // decided by right value
+            values[i] = !is_and;
+        } else if (lhs_nulls[i] || rhs_nulls[j]) {
+            values[i] = false;
+            result->set_null(i);
+        } else {
+            values[i] = is_and;
+        }
+    }
+    return Status::OK;
+}
+
+Status NotPredicate::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                    int num_rows, MemPool* pool, ExprColumn* result) {
+    ExprColumn child;
+    RETURN_IF_ERROR(_children[0]->evaluate_batch(context, batch, sel, num_rows, pool, &child));
+    RETURN_IF_ERROR(result->init(TYPE_BOOLEAN, num_rows, pool));
+    const bool* child_values = child.data<bool>();
+    const uint8_t* child_nulls = child.nulls();
+    bool* values = result->data<bool>();
+    for (int i = 0; i < num_rows; ++i) {
+        // keep values of null rows false
+        values[i] = !child_values[i] && !child_nulls[i];
+    }
+    memcpy(result->nulls(), child_nulls, num_rows);
+    result->set_has_nulls(child.has_nulls());
+    return Status::OK;
+}
+
 std::string CompoundPredicate::debug_string() const {
     std::stringstream out;
     out << "CompoundPredicate(" << Expr::debug_string() << ")";
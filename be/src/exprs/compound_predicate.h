@@ -42,6 +42,12 @@ protected:
     CompoundPredicate(const TExprNode& node);
 
     Status codegen_compute_fn(bool and_fn, RuntimeState* state, llvm::Function** fn);
+
+    // Batch evaluation of AND and OR. Right child is only evaluated for rows
+    // whose result is not decided by left child, as row by row evaluation does.
+    Status evaluate_batch_and_or(bool is_and, ExprContext* context, RowBatch* batch,
+                                 const int* sel, int num_rows, MemPool* pool,
+                                 ExprColumn* result);
     // virtual Status prepare(RuntimeState* state, const RowDescriptor& desc);
     virtual std::string debug_string() const;
 
@@ -60,6 +66,10 @@ public:
         return pool->add(new AndPredicate(*this));
     }
     virtual palo_udf::BooleanVal get_boolean_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result) {
+        return evaluate_batch_and_or(true, context, batch, sel, num_rows, pool, result);
+    }
 
     virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn) {
         return CompoundPredicate::codegen_compute_fn(true, state, fn);
@@ -86,6 +96,10 @@ public:
         return pool->add(new OrPredicate(*this));
     }
     virtual palo_udf::BooleanVal get_boolean_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result) {
+        return evaluate_batch_and_or(false, context, batch, sel, num_rows, pool, result);
+    }
 
     virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn) {
         return CompoundPredicate::codegen_compute_fn(false, state, fn);
@@ -112,6 +126,8 @@ public:
         return pool->add(new NotPredicate(*this));
     }
     virtual palo_udf::BooleanVal get_boolean_val(ExprContext* context, TupleRow*);
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 
     virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn) {
         return get_codegend_compute_fn_wrapper(state, fn);
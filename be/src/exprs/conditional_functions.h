@@ -56,6 +56,7 @@ public:
     virtual StringVal get_string_val(ExprContext* context, TupleRow* row);
     virtual DateTimeVal get_datetime_val(ExprContext* context, TupleRow* row);
     virtual DecimalVal get_decimal_val(ExprContext* context, TupleRow* row);
+    virtual DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow* row);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow* row);
 
     virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn);
@@ -85,6 +86,7 @@ public:
     virtual StringVal get_string_val(ExprContext* context, TupleRow* row);
     virtual DateTimeVal get_datetime_val(ExprContext* context, TupleRow* row);
     // virtual DecimalVal get_decimal_val(ExprContext* context, TupleRow* row);
+    virtual DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow* row);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow* row);
 
     virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn);
@@ -113,6 +115,7 @@ public:
     virtual StringVal get_string_val(ExprContext* context, TupleRow* row);
     virtual DateTimeVal get_datetime_val(ExprContext* context, TupleRow* row);
     virtual DecimalVal get_decimal_val(ExprContext* context, TupleRow* row);
+    virtual DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow* row);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow* row);
 
     virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn);
@@ -142,6 +145,7 @@ public:
     virtual StringVal get_string_val(ExprContext* context, TupleRow* row);
     virtual DateTimeVal get_datetime_val(ExprContext* context, TupleRow* row);
     virtual DecimalVal get_decimal_val(ExprContext* context, TupleRow* row);
+    virtual DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow* row);
     virtual LargeIntVal get_large_int_val(ExprContext* context, TupleRow* row);
 
     virtual Status get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn);
@@ -42,6 +42,7 @@ IF_NULL_COMPUTE_FUNCTION(DoubleVal, double_val);
 IF_NULL_COMPUTE_FUNCTION(StringVal, string_val);
 IF_NULL_COMPUTE_FUNCTION(DateTimeVal, datetime_val);
 IF_NULL_COMPUTE_FUNCTION(DecimalVal, decimal_val);
+IF_NULL_COMPUTE_FUNCTION(DecimalV2Val, decimalv2_val);
 IF_NULL_COMPUTE_FUNCTION(LargeIntVal, large_int_val);
 
 #define NULL_IF_COMPUTE_FUNCTION(TYPE, type_name) \
@@ -72,6 +73,7 @@ NULL_IF_COMPUTE_FUNCTION_WRAPPER(DoubleVal, double_val);
 NULL_IF_COMPUTE_FUNCTION_WRAPPER(StringVal, string_val);
 NULL_IF_COMPUTE_FUNCTION_WRAPPER(DateTimeVal, datetime_val);
 // NULL_IF_COMPUTE_FUNCTION(DecimalVal, decimal_val);
+NULL_IF_COMPUTE_FUNCTION_WRAPPER(DecimalV2Val, decimalv2_val);
 NULL_IF_COMPUTE_FUNCTION_WRAPPER(LargeIntVal, large_int_val);
 
 #define IF_COMPUTE_FUNCTION(type, type_name) \
@@ -94,6 +96,7 @@ IF_COMPUTE_FUNCTION(DoubleVal, double_val);
 IF_COMPUTE_FUNCTION(StringVal, string_val);
 IF_COMPUTE_FUNCTION(DateTimeVal, datetime_val);
 IF_COMPUTE_FUNCTION(DecimalVal, decimal_val);
+IF_COMPUTE_FUNCTION(DecimalV2Val, decimalv2_val);
 IF_COMPUTE_FUNCTION(LargeIntVal, large_int_val);
 
 #define COALESCE_COMPUTE_FUNCTION(type, type_name) \
@@ -116,6 +119,7 @@ COALESCE_COMPUTE_FUNCTION(DoubleVal, double_val);
 COALESCE_COMPUTE_FUNCTION(StringVal, string_val);
 COALESCE_COMPUTE_FUNCTION(DateTimeVal, datetime_val);
 COALESCE_COMPUTE_FUNCTION(DecimalVal, decimal_val);
+COALESCE_COMPUTE_FUNCTION(DecimalV2Val, decimalv2_val);
 COALESCE_COMPUTE_FUNCTION(LargeIntVal, large_int_val);
 
 }
@@ -0,0 +1,196 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/decimalv2_operators.h"
+
+#include "exprs/anyval_util.h"
+#include "runtime/datetime_value.h"
+
+namespace palo {
+
+void DecimalV2Operators::init() {
+}
+
+#define CAST_INT_TO_DECIMALV2(from_type) \
+    DecimalV2Val DecimalV2Operators::cast_to_decimalv2_val( \
+            FunctionContext* context, const from_type& val) { \
+        if (val.is_null) return DecimalV2Val::null(); \
+        DecimalV2Val result; \
+        DecimalV2Value(static_cast<int64_t>(val.val)).to_decimal_val(&result); \
+        return result; \
+    }
+
+CAST_INT_TO_DECIMALV2(TinyIntVal);
+CAST_INT_TO_DECIMALV2(SmallIntVal);
+CAST_INT_TO_DECIMALV2(IntVal);
+CAST_INT_TO_DECIMALV2(BigIntVal);
+
+DecimalV2Val DecimalV2Operators::cast_to_decimalv2_val(
+        FunctionContext* context, const LargeIntVal& val) {
+    if (val.is_null) {
+        return DecimalV2Val::null();
+    }
+    // out of range values are set to max or min value, the same as DecimalV2Value
+    const __int128 max_int_value = DecimalV2Value::MAX_VALUE / DecimalV2Value::ONE_BILLION;
+    DecimalV2Value dv;
+    if (val.val > max_int_value) {
+        dv = DecimalV2Value::get_max_decimal();
+    } else if (val.val < -max_int_value) {
+        dv = DecimalV2Value::get_min_decimal();
+    } else {
+        dv = DecimalV2Value::from_raw(val.val * DecimalV2Value::ONE_BILLION);
+    }
+    DecimalV2Val result;
+    dv.to_decimal_val(&result);
+    return result;
+}
+
+DecimalV2Val DecimalV2Operators::cast_to_decimalv2_val(
+        FunctionContext* context, const FloatVal& val) {
+    if (val.is_null) {
+        return DecimalV2Val::null();
+    }
+    DecimalV2Value dv;
+    dv.assign_from_float(val.val);
+    DecimalV2Val result;
+    dv.to_decimal_val(&result);
+    return result;
+}
+
+DecimalV2Val DecimalV2Operators::cast_to_decimalv2_val(
+        FunctionContext* context, const DoubleVal& val) {
+    if (val.is_null) {
+        return DecimalV2Val::null();
+    }
+    DecimalV2Value dv;
+    dv.assign_from_double(val.val);
+    DecimalV2Val result;
+    dv.to_decimal_val(&result);
+    return result;
+}
+
+DecimalV2Val DecimalV2Operators::cast_to_decimalv2_val(
+        FunctionContext* context, const StringVal& val) {
+    if (val.is_null) {
+        return DecimalV2Val::null();
+    }
+    DecimalV2Value dv;
+    int err = dv.parse_from_str((const char*)val.ptr, val.len);
+    if (err != E_DEC_OK && err != E_DEC_TRUNCATED) {
+        return DecimalV2Val::null();
+    }
+    DecimalV2Val result;
+    dv.to_decimal_val(&result);
+    return result;
+}
+
+DecimalV2Val DecimalV2Operators::cast_to_decimalv2_val(
+        FunctionContext* context, const DecimalVal& val) {
+    if (val.is_null) {
+        return DecimalV2Val::null();
+    }
+    DecimalV2Value dv = DecimalV2Value::from_decimal_value(DecimalValue::from_decimal_val(val));
+    DecimalV2Val result;
+    dv.to_decimal_val(&result);
+    return result;
+}
+
+#define CAST_DECIMALV2_TO(to_type, type_name, native_type) \
+    to_type DecimalV2Operators::cast_to_##type_name( \
+            FunctionContext* context, const DecimalV2Val& val) { \
+        if (val.is_null) return to_type::null(); \
+        DecimalV2Value dv = DecimalV2Value::from_decimal_val(val); \
+        return to_type(static_cast<native_type>(dv)); \
+    }
+
+CAST_DECIMALV2_TO(BooleanVal, boolean_val, bool);
+CAST_DECIMALV2_TO(TinyIntVal, tiny_int_val, int64_t);
+CAST_DECIMALV2_TO(SmallIntVal, small_int_val, int64_t);
+CAST_DECIMALV2_TO(IntVal, int_val, int64_t);
+CAST_DECIMALV2_TO(BigIntVal, big_int_val, int64_t);
+CAST_DECIMALV2_TO(LargeIntVal, large_int_val, __int128);
+CAST_DECIMALV2_TO(FloatVal, float_val, double);
+CAST_DECIMALV2_TO(DoubleVal, double_val, double);
+
+StringVal DecimalV2Operators::cast_to_string_val(
+        FunctionContext* ctx, const DecimalV2Val& val) {
+    if (val.is_null) {
+        return StringVal::null();
+    }
+    const DecimalV2Value& dv = DecimalV2Value::from_decimal_val(val);
+    return AnyValUtil::from_string_temp(ctx, dv.to_string());
+}
+
+DateTimeVal DecimalV2Operators::cast_to_datetime_val(
+        FunctionContext* context, const DecimalV2Val& val) {
+    if (val.is_null) {
+        return DateTimeVal::null();
+    }
+    const DecimalV2Value& dv = DecimalV2Value::from_decimal_val(val);
+    DateTimeValue dt;
+    if (!dt.from_date_int64(static_cast<int64_t>(dv))) {
+        return DateTimeVal::null();
+    }
+    DateTimeVal result;
+    dt.to_datetime_val(&result);
+    return result;
+}
+
+DecimalVal DecimalV2Operators::cast_to_decimal_val(
+        FunctionContext* context, const DecimalV2Val& val) {
+    if (val.is_null) {
+        return DecimalVal::null();
+    }
+    DecimalVal result;
+    DecimalV2Value::from_decimal_val(val).to_decimal_value().to_decimal_val(&result);
+    return result;
+}
+
+// Overflow sets result to max or min value like DecimalValue, division by
+// zero returns NULL
+#define DECIMALV2_ARITHMETIC_OP(FN_NAME, FN) \
+    DecimalV2Val DecimalV2Operators::FN_NAME##_decimalv2_val_decimalv2_val( \
+            FunctionContext* context, const DecimalV2Val& v1, const DecimalV2Val& v2) { \
+        if (v1.is_null || v2.is_null) return DecimalV2Val::null(); \
+        DecimalV2Value ir; \
+        int err = DecimalV2Value::FN(DecimalV2Value::from_decimal_val(v1), \
+                                     DecimalV2Value::from_decimal_val(v2), &ir); \
+        if (err == E_DEC_DIV_ZERO) return DecimalV2Val::null(); \
+        DecimalV2Val result; \
+        ir.to_decimal_val(&result); \
+        return result; \
+    }
+
+DECIMALV2_ARITHMETIC_OP(add, add);
+DECIMALV2_ARITHMETIC_OP(subtract, sub);
+DECIMALV2_ARITHMETIC_OP(multiply, mul);
+DECIMALV2_ARITHMETIC_OP(divide, div);
+DECIMALV2_ARITHMETIC_OP(mod, mod);
+
+#define DECIMALV2_BINARY_PREDICATE_FN(NAME, OP) \
+    BooleanVal DecimalV2Operators::NAME##_decimalv2_val_decimalv2_val( \
+            FunctionContext* c, const DecimalV2Val& v1, const DecimalV2Val& v2) { \
+        if (v1.is_null || v2.is_null) return BooleanVal::null(); \
+        return BooleanVal(v1.val OP v2.val); \
+    }
+
+DECIMALV2_BINARY_PREDICATE_FN(eq, ==);
+DECIMALV2_BINARY_PREDICATE_FN(ne, !=);
+DECIMALV2_BINARY_PREDICATE_FN(gt, >);
+DECIMALV2_BINARY_PREDICATE_FN(lt, <);
+DECIMALV2_BINARY_PREDICATE_FN(ge, >=);
+DECIMALV2_BINARY_PREDICATE_FN(le, <=);
+
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "runtime/decimalv2_value.h"
+#include "udf/udf.h"
+
+namespace palo {
+
+// Implementation of the DECIMALV2 operators, including the casts, the
+// arithmetic and binary operators. Division and modulo by zero return NULL.
+class DecimalV2Operators {
+public:
+    static void init();
+
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const TinyIntVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const SmallIntVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const IntVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const BigIntVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const LargeIntVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const FloatVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const DoubleVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const StringVal&);
+    static DecimalV2Val cast_to_decimalv2_val(FunctionContext*, const DecimalVal&);
+
+    static BooleanVal cast_to_boolean_val(FunctionContext*, const DecimalV2Val&);
+    static TinyIntVal cast_to_tiny_int_val(FunctionContext*, const DecimalV2Val&);
+    static SmallIntVal cast_to_small_int_val(FunctionContext*, const DecimalV2Val&);
+    static IntVal cast_to_int_val(FunctionContext*, const DecimalV2Val&);
+    static BigIntVal cast_to_big_int_val(FunctionContext*, const DecimalV2Val&);
+    static LargeIntVal cast_to_large_int_val(FunctionContext*, const DecimalV2Val&);
+    static FloatVal cast_to_float_val(FunctionContext*, const DecimalV2Val&);
+    static DoubleVal cast_to_double_val(FunctionContext*, const DecimalV2Val&);
+    static StringVal cast_to_string_val(FunctionContext*, const DecimalV2Val&);
+    static DateTimeVal cast_to_datetime_val(FunctionContext*, const DecimalV2Val&);
+    static DecimalVal cast_to_decimal_val(FunctionContext*, const DecimalV2Val&);
+
+    static DecimalV2Val add_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static DecimalV2Val subtract_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static DecimalV2Val multiply_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static DecimalV2Val divide_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static DecimalV2Val mod_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+
+    static BooleanVal eq_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static BooleanVal ne_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static BooleanVal gt_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static BooleanVal lt_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static BooleanVal ge_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+    static BooleanVal le_decimalv2_val_decimalv2_val(
+        FunctionContext*, const DecimalV2Val&, const DecimalV2Val&);
+};
+
+}
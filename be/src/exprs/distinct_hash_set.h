@@ -0,0 +1,142 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string.h>
+
+#include <functional>
+#include <vector>
+
+#include "common/logging.h"
+#include "util/hash_util.hpp"
+
+namespace palo {
+
+// Hash of fixed width values by their bytes
+template <typename T>
+struct DistinctBytesHash {
+    size_t operator()(const T& value) const {
+        return HashUtil::hash(&value, sizeof(T), HashUtil::FNV_SEED);
+    }
+};
+
+// Equal of fixed width values by their bytes, so that it is consistent with
+// DistinctBytesHash, e.g. NaN of double is equal to itself.
+template <typename T>
+struct DistinctBytesEqual {
+    bool operator()(const T& a, const T& b) const {
+        return memcmp(&a, &b, sizeof(T)) == 0;
+    }
+};
+
+// Hash set used by distinct aggregate states.
+// Elements are kept in one flat array with open addressing and linear
+// probing, so inserting doesn't allocate a node for each element and merging
+// a set of known size can be pre-sized by reserve().
+// Elements can't be removed.
+template <typename T, typename Hash, typename Equal = std::equal_to<T> >
+class DistinctHashSet {
+public:
+    DistinctHashSet() : _size(0), _mask(0) { }
+
+    size_t size() const { return _size; }
+
+    // Make room for 'num' elements, so that inserting them doesn't rehash
+    void reserve(size_t num) {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity * MAX_LOAD_FACTOR_PERCENT < num * 100) {
+            capacity *= 2;
+        }
+        if (capacity > _slots.size()) {
+            _rehash(capacity);
+        }
+    }
+
+    // Return true if 'value' is inserted, false if it's already in the set
+    bool insert(const T& value) {
+        bool inserted = false;
+        find_or_insert(value, _hash(value), &inserted);
+        return inserted;
+    }
+
+    // Return the element equal to 'value', 'value' is inserted if there is
+    // none. 'hash_value' must be the hash of 'value'. Caller may replace
+    // returned element by an equal one, e.g. to copy data it points to.
+    T* find_or_insert(const T& value, size_t hash_value, bool* inserted) {
+        if ((_size + 1) * 100 > _slots.size() * MAX_LOAD_FACTOR_PERCENT) {
+            reserve(_size + 1);
+        }
+        size_t idx = hash_value & _mask;
+        while (_used[idx]) {
+            if (_equal(_slots[idx], value)) {
+                *inserted = false;
+                return &_slots[idx];
+            }
+            idx = (idx + 1) & _mask;
+        }
+        _used[idx] = 1;
+        _slots[idx] = value;
+        ++_size;
+        *inserted = true;
+        return &_slots[idx];
+    }
+
+    // Call 'fn' on every element
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        for (size_t i = 0; i < _slots.size(); ++i) {
+            if (_used[i]) {
+                fn(_slots[i]);
+            }
+        }
+    }
+
+    const Hash& hash_function() const { return _hash; }
+
+private:
+    static const size_t MIN_CAPACITY = 16;
+    static const size_t MAX_LOAD_FACTOR_PERCENT = 70;
+
+    void _rehash(size_t capacity) {
+        DCHECK_EQ(0, capacity & (capacity - 1));
+        std::vector<T> slots(capacity);
+        std::vector<uint8_t> used(capacity, 0);
+        size_t mask = capacity - 1;
+        for (size_t i = 0; i < _slots.size(); ++i) {
+            if (!_used[i]) {
+                continue;
+            }
+            size_t idx = _hash(_slots[i]) & mask;
+            while (used[idx]) {
+                idx = (idx + 1) & mask;
+            }
+            used[idx] = 1;
+            slots[idx] = _slots[i];
+        }
+        _slots.swap(slots);
+        _used.swap(used);
+        _mask = mask;
+    }
+
+    Hash _hash;
+    Equal _equal;
+    std::vector<T> _slots;
+    std::vector<uint8_t> _used;
+    size_t _size;
+    size_t _mask;
+};
+
+}
@@ -30,6 +30,7 @@
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "exprs/anyval_util.h"
+#include "exprs/expr_column.h"
 #include "exprs/literal.h"
 #include "exprs/binary_predicate.h"
 #include "exprs/case_expr.h"
@@ -51,6 +52,7 @@
 #include "gen_cpp/Data_types.h"
 #include "runtime/runtime_state.h"
 #include "runtime/raw_value.h"
+#include "runtime/row_batch.h"
 #include "util/debug_util.h"
 
 #include "gen_cpp/Exprs_types.h"
@@ -143,6 +145,7 @@ Expr::Expr(const TypeDescriptor& type) :
         break;
 
     case TYPE_DECIMAL:
+    case TYPE_DECIMALV2:
         _node_type = (TExprNodeType::DECIMAL_LITERAL);
         break;
 
@@ -200,6 +203,7 @@ Expr::Expr(const TypeDescriptor& type, bool is_slotref) :
             break;
 
         case TYPE_DECIMAL:
+        case TYPE_DECIMALV2:
             _node_type = (TExprNodeType::DECIMAL_LITERAL);
             break;
 
@@ -750,6 +754,10 @@ palo_udf::AnyVal* Expr::get_const_val(ExprContext* context) {
         _constant_val.reset(new DecimalVal(get_decimal_val(context, NULL)));
         break;
     }
+    case TYPE_DECIMALV2: {
+        _constant_val.reset(new DecimalV2Val(get_decimalv2_val(context, NULL)));
+        break;
+    }
     case TYPE_NULL: {
         _constant_val.reset(new AnyVal(true));
         break;
@@ -833,6 +841,65 @@ DecimalVal Expr::get_decimal_val(ExprContext* context, TupleRow* row) {
     return val;
 }
 
+DecimalV2Val Expr::get_decimalv2_val(ExprContext* context, TupleRow* row) {
+    return DecimalV2Val::null();
+}
+
+Status Expr::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                            int num_rows, MemPool* pool, ExprColumn* result) {
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+    for (int i = 0; i < num_rows; ++i) {
+        TupleRow* row = batch->get_row(sel[i]);
+        switch (_type.type) {
+        case TYPE_NULL:
+            result->set_null(i);
+            break;
+        case TYPE_BOOLEAN:
+            result->set(i, get_boolean_val(context, row));
+            break;
+        case TYPE_TINYINT:
+            result->set(i, get_tiny_int_val(context, row));
+            break;
+        case TYPE_SMALLINT:
+            result->set(i, get_small_int_val(context, row));
+            break;
+        case TYPE_INT:
+            result->set(i, get_int_val(context, row));
+            break;
+        case TYPE_BIGINT:
+            result->set(i, get_big_int_val(context, row));
+            break;
+        case TYPE_LARGEINT:
+            result->set(i, get_large_int_val(context, row));
+            break;
+        case TYPE_FLOAT:
+            result->set(i, get_float_val(context, row));
+            break;
+        case TYPE_DOUBLE:
+            result->set(i, get_double_val(context, row));
+            break;
+        case TYPE_CHAR:
+        case TYPE_VARCHAR:
+        case TYPE_HLL:
+            result->set(i, get_string_val(context, row));
+            break;
+        case TYPE_DATE:
+        case TYPE_DATETIME:
+            result->set(i, get_datetime_val(context, row));
+            break;
+        case TYPE_DECIMAL:
+            result->set(i, get_decimal_val(context, row));
+            break;
+        case TYPE_DECIMALV2:
+            result->set(i, get_decimalv2_val(context, row));
+            break;
+        default:
+            return Status("Unsupported type of batch evaluation: " + type_to_string(_type.type));
+        }
+    }
+    return Status::OK;
+}
+
 Status Expr::get_fn_context_error(ExprContext* ctx) {
     if (_fn_context_index != -1) {
         FunctionContext* fn_ctx = ctx->fn_context(_fn_context_index);
@@ -947,6 +1014,9 @@ Status Expr::get_codegend_compute_fn_wrapper(RuntimeState* state, llvm::Function
         *fn = _ir_compute_fn;
         return Status::OK;
     }
+    if (_type.type == TYPE_DECIMALV2) {
+        return Status("Codegen not supported for DECIMALV2");
+    }
     LlvmCodeGen* codegen = NULL;
     RETURN_IF_ERROR(state->get_codegen(&codegen));
     llvm::Function* static_getval_fn = get_static_get_val_wrapper(type(), codegen);
@@ -36,6 +36,7 @@
 #include "runtime/string_value.hpp"
 #include "runtime/datetime_value.h"
 #include "runtime/decimal_value.h"
+#include "runtime/decimalv2_value.h"
 #include "udf/udf.h"
 #include "runtime/lib_cache.h"
 #include "runtime/types.h"
@@ -56,8 +57,11 @@ class Value;
 namespace palo {
 
 class Expr;
+class ExprColumn;
 class LlvmCodeGen;
+class MemPool;
 class ObjectPool;
+class RowBatch;
 class RowDescriptor;
 class RuntimeState;
 class TColumnValue;
@@ -125,6 +129,16 @@ public:
     // virtual ArrayVal GetArrayVal(ExprContext* context, TupleRow*);
     virtual DateTimeVal get_datetime_val(ExprContext* context, TupleRow*);
     virtual DecimalVal get_decimal_val(ExprContext* context, TupleRow*);
+    virtual DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow*);
+
+    /// Evaluates this expr over rows sel[0], ..., sel[num_rows - 1] of 'batch' and stores
+    /// the results in 'result', whose i-th value is for row sel[i]. Memory of 'result'
+    /// is allocated from 'pool' and is valid until the pool is cleared.
+    /// The default implementation calls Get*Val() row by row. Exprs override it to
+    /// evaluate children into columns first and compute the result a column at a time,
+    /// which saves the virtual calls for each row.
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
 
     // Get the number of digits after the decimal that should be displayed for this
     // value. Returns -1 if no scale has been specified (currently the scale is only set for
@@ -0,0 +1,65 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/expr_column.h"
+
+#include <string.h>
+
+#include "common/logging.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+namespace palo {
+
+Status ExprColumn::init(PrimitiveType type, int num_rows, MemPool* pool) {
+    _type = type;
+    _num_rows = num_rows;
+    _slot_size = get_slot_size(type);
+    _has_nulls = false;
+    // LARGEINT needs alignment of 16
+    int64_t data_size = static_cast<int64_t>(_slot_size) * num_rows;
+    _data = pool->try_allocate_aligned(data_size, 16);
+    _nulls = pool->try_allocate(num_rows);
+    if (_data == NULL || _nulls == NULL) {
+        return pool->mem_tracker()->MemLimitExceeded(
+            NULL, "Failed to allocate memory for expr column", data_size + num_rows);
+    }
+    memset(_data, 0, data_size);
+    memset(_nulls, 0, num_rows);
+    return Status::OK;
+}
+
+void ExprColumn::fill(const void* value) {
+    if (value == NULL) {
+        memset(_nulls, 1, _num_rows);
+        _has_nulls = _num_rows > 0;
+        return;
+    }
+    for (int i = 0; i < _num_rows; ++i) {
+        memcpy(_data + i * _slot_size, value, _slot_size);
+    }
+}
+
+void ExprColumn::scatter(const ExprColumn& src, const int* positions) {
+    DCHECK_EQ(_slot_size, src._slot_size);
+    for (int j = 0; j < src._num_rows; ++j) {
+        int i = positions[j];
+        memcpy(_data + i * _slot_size, src._data + j * src._slot_size, _slot_size);
+        _nulls[i] = src._nulls[j];
+    }
+    _has_nulls = _has_nulls || src._has_nulls;
+}
+
+}
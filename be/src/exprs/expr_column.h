@@ -0,0 +1,167 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/status.h"
+#include "runtime/datetime_value.h"
+#include "runtime/decimal_value.h"
+#include "runtime/primitive_type.h"
+#include "runtime/string_value.h"
+#include "udf/udf.h"
+
+namespace palo {
+
+class MemPool;
+
+// Result of evaluating an expr over a batch of rows, see Expr::evaluate_batch().
+//
+// Values are stored in an array in the same format as tuple slots, e.g. int32_t
+// for INT, StringValue for CHAR/VARCHAR and DateTimeValue for DATE/DATETIME, so
+// they can be read as typed arrays. There is a null map of one byte per value,
+// and values of null rows are always zero, so that operators can compute all
+// rows without checking null map and merge null maps after.
+class ExprColumn {
+public:
+    ExprColumn() :
+            _type(INVALID_TYPE),
+            _num_rows(0),
+            _slot_size(0),
+            _data(NULL),
+            _nulls(NULL),
+            _has_nulls(false) {
+    }
+
+    // Allocate zeroed values and null map of 'num_rows' rows from 'pool'
+    Status init(PrimitiveType type, int num_rows, MemPool* pool);
+
+    PrimitiveType type() const {
+        return _type;
+    }
+
+    int num_rows() const {
+        return _num_rows;
+    }
+
+    template <typename T>
+    T* data() {
+        return reinterpret_cast<T*>(_data);
+    }
+
+    template <typename T>
+    const T* data() const {
+        return reinterpret_cast<const T*>(_data);
+    }
+
+    // One byte for each row, 1 means null
+    uint8_t* nulls() {
+        return _nulls;
+    }
+
+    const uint8_t* nulls() const {
+        return _nulls;
+    }
+
+    // False if no row is null, then null map can be skipped
+    bool has_nulls() const {
+        return _has_nulls;
+    }
+
+    void set_has_nulls(bool has_nulls) {
+        _has_nulls = has_nulls;
+    }
+
+    bool is_null(int i) const {
+        return _nulls[i] != 0;
+    }
+
+    // Value should be zero before, which is true for newly allocated columns
+    void set_null(int i) {
+        _nulls[i] = 1;
+        _has_nulls = true;
+    }
+
+    // Pointer to value of row i, NULL if it's null
+    void* get_value(int i) {
+        return is_null(i) ? NULL : _data + i * _slot_size;
+    }
+
+    const void* get_value(int i) const {
+        return is_null(i) ? NULL : _data + i * _slot_size;
+    }
+
+    // Set value of row i from result of Get*Val()
+    void set(int i, const palo_udf::BooleanVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::TinyIntVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::SmallIntVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::IntVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::BigIntVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::LargeIntVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::FloatVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::DoubleVal& v) { set_native(i, v, v.val); }
+    void set(int i, const palo_udf::DecimalV2Val& v) { set_native(i, v, v.val); }
+
+    void set(int i, const palo_udf::StringVal& v) {
+        if (v.is_null) {
+            set_null(i);
+            return;
+        }
+        data<StringValue>()[i] = StringValue::from_string_val(v);
+    }
+
+    void set(int i, const palo_udf::DateTimeVal& v) {
+        if (v.is_null) {
+            set_null(i);
+            return;
+        }
+        data<DateTimeValue>()[i] = DateTimeValue::from_datetime_val(v);
+    }
+
+    void set(int i, const palo_udf::DecimalVal& v) {
+        if (v.is_null) {
+            set_null(i);
+            return;
+        }
+        data<DecimalValue>()[i] = DecimalValue::from_decimal_val(v);
+    }
+
+    // Set all rows to 'value' in slot format, or null if it's NULL
+    void fill(const void* value);
+
+    // Copy row j of 'src' to row positions[j] of this column, for j in
+    // [0, src.num_rows()). Both columns must be of the same type.
+    void scatter(const ExprColumn& src, const int* positions);
+
+private:
+    template <typename VAL, typename T>
+    void set_native(int i, const VAL& v, const T& native) {
+        if (v.is_null) {
+            set_null(i);
+            return;
+        }
+        data<T>()[i] = native;
+    }
+
+    PrimitiveType _type;
+    int _num_rows;
+    int _slot_size;
+    uint8_t* _data;
+    uint8_t* _nulls;
+    bool _has_nulls;
+};
+
+}
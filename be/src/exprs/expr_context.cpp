@@ -153,6 +153,11 @@ Status ExprContext::clone(RuntimeState* state, ExprContext** new_ctx, Expr* root
     return root->open(state, *new_ctx, FunctionContext::THREAD_LOCAL);
 }
 
+Status ExprContext::evaluate_batch(RowBatch* batch, const int* sel, int num_rows,
+                                   MemPool* pool, ExprColumn* result) {
+    return _root->evaluate_batch(this, batch, sel, num_rows, pool, result);
+}
+
 void ExprContext::free_local_allocations() {
     free_local_allocations(_fn_contexts);
 }
@@ -377,6 +382,14 @@ void* ExprContext::get_value(Expr* e, TupleRow* row) {
         _result.decimal_val = DecimalValue::from_decimal_val(v);
         return &_result.decimal_val;
     }
+    case TYPE_DECIMALV2: {
+        DecimalV2Val v = e->get_decimalv2_val(this, row);
+        if (v.is_null) {
+            return NULL;
+        }
+        _result.decimalv2_val = DecimalV2Value::from_decimal_val(v);
+        return &_result.decimalv2_val;
+    }
 #if 0
     case TYPE_ARRAY:
     case TYPE_MAP: {
@@ -454,6 +467,10 @@ DecimalVal ExprContext::get_decimal_val(TupleRow* row) {
     return _root->get_decimal_val(this, row);
 }
 
+DecimalV2Val ExprContext::get_decimalv2_val(TupleRow* row) {
+    return _root->get_decimalv2_val(this, row);
+}
+
 Status ExprContext::get_const_value(RuntimeState* state, Expr& expr,
     AnyVal** const_val) {
   DCHECK(_opened);
@@ -36,9 +36,11 @@ USING_PALO_UDF;
 namespace palo {
 
 class Expr;
+class ExprColumn;
 class MemPool;
 class MemTracker;
 class RuntimeState;
+class RowBatch;
 class RowDescriptor;
 class TColumnValue;
 class TupleRow;
@@ -145,6 +147,11 @@ public:
     // ArrayVal GetArrayVal(TupleRow* row);
     DateTimeVal get_datetime_val(TupleRow* row);
     DecimalVal get_decimal_val(TupleRow* row);
+    DecimalV2Val get_decimalv2_val(TupleRow* row);
+
+    /// Calls evaluate_batch() on _root, see Expr::evaluate_batch()
+    Status evaluate_batch(RowBatch* batch, const int* sel, int num_rows, MemPool* pool,
+                          ExprColumn* result);
 
     /// Frees all local allocations made by fn_contexts_. This can be called when result
     /// data from this context is no longer needed.
@@ -25,6 +25,7 @@
 #include "runtime/string_value.hpp"
 #include "runtime/datetime_value.h"
 #include "runtime/decimal_value.h"
+#include "runtime/decimalv2_value.h"
 #include "runtime/types.h"
 
 namespace palo {
@@ -47,6 +48,7 @@ struct ExprValue {
     StringValue string_val;
     DateTimeValue datetime_val;
     DecimalValue decimal_val;
+    DecimalV2Value decimalv2_val;
 
     ExprValue() : 
             bool_val(false),
@@ -60,7 +62,8 @@ struct ExprValue {
             string_data(),
             string_val(NULL, 0),
             datetime_val(),
-            decimal_val() {
+            decimal_val(),
+            decimalv2_val() {
     }
 
     ExprValue(bool v): bool_val(v) {}
@@ -140,6 +143,10 @@ struct ExprValue {
             decimal_val.set_to_zero();
             return &decimal_val;
 
+        case TYPE_DECIMALV2:
+            decimalv2_val = DecimalV2Value();
+            return &decimalv2_val;
+
         default:
             DCHECK(false);
             return NULL;
@@ -188,6 +195,10 @@ struct ExprValue {
             decimal_val = DecimalValue::get_min_decimal();
             return &decimal_val;
 
+        case TYPE_DECIMALV2:
+            decimalv2_val = DecimalV2Value::get_min_decimal();
+            return &decimalv2_val;
+
         default:
             DCHECK(false);
             return NULL;
@@ -236,6 +247,10 @@ struct ExprValue {
             decimal_val = DecimalValue::get_max_decimal();
             return &decimal_val;
 
+        case TYPE_DECIMALV2:
+            decimalv2_val = DecimalV2Value::get_max_decimal();
+            return &decimalv2_val;
+
         default:
             DCHECK(false);
             return NULL;
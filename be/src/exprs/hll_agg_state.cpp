@@ -0,0 +1,395 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/hll_agg_state.h"
+
+#include <math.h>
+#include <string.h>
+#include <x86intrin.h>
+
+#include <algorithm>
+
+#include "common/logging.h"
+
+namespace palo {
+
+using palo_udf::FunctionContext;
+using palo_udf::StringVal;
+
+static const int TYPE_SIZE = sizeof(HllSetResolver::SetTypeValueType);
+static const int EXPLICIT_HEADER_SIZE =
+    TYPE_SIZE + sizeof(HllSetResolver::ExpliclitLengthValueType);
+static const int SPARSE_HEADER_SIZE = TYPE_SIZE + sizeof(HllSetResolver::SparseLengthValueType);
+static const int SPARSE_ENTRY_SIZE =
+    sizeof(HllSetResolver::SparseIndexType) + sizeof(HllSetResolver::SparseValueType);
+static const int FULL_SIZE = TYPE_SIZE + HLL_REGISTERS_COUNT;
+// count of explicit hashes is uint8_t
+static const int MAX_EXPLICIT_COUNT = 256;
+
+static inline int register_index(uint64_t hash_value) {
+    return hash_value % HLL_REGISTERS_COUNT;
+}
+
+// Position of the first 1 bit after index bits
+static inline uint8_t register_value(uint64_t hash_value) {
+    uint64_t bits = hash_value >> HLL_COLUMN_PRECISION;
+    if (bits == 0) {
+        return 64 - HLL_COLUMN_PRECISION + 1;
+    }
+    return __builtin_ctzl(bits) + 1;
+}
+
+static inline int sparse_count(const uint8_t* state) {
+    return *reinterpret_cast<const HllSetResolver::SparseLengthValueType*>(state + TYPE_SIZE);
+}
+
+static inline void set_sparse_count(uint8_t* state, int count) {
+    *reinterpret_cast<HllSetResolver::SparseLengthValueType*>(state + TYPE_SIZE) = count;
+}
+
+static inline int sparse_index(const uint8_t* entry) {
+    return entry[0] | (entry[1] << 8);
+}
+
+static inline void set_sparse_entry(uint8_t* entry, int index, uint8_t value) {
+    entry[0] = index & 0xff;
+    entry[1] = index >> 8 & 0xff;
+    entry[2] = value;
+}
+
+// Registers of explicit hashes as (index << 8 | value), sorted by index
+// and only the max value of each index is kept. Return number of registers.
+static int explicit_registers(const uint8_t* state, uint32_t* registers) {
+    int count = state[1];
+    const uint64_t* hashes = reinterpret_cast<const uint64_t*>(state + EXPLICIT_HEADER_SIZE);
+    for (int i = 0; i < count; ++i) {
+        registers[i] = register_index(hashes[i]) << 8 | register_value(hashes[i]);
+    }
+    std::sort(registers, registers + count);
+    int num_registers = 0;
+    for (int i = 0; i < count; ++i) {
+        if (num_registers > 0 && (registers[num_registers - 1] >> 8) == (registers[i] >> 8)) {
+            registers[num_registers - 1] = registers[i];
+        } else {
+            registers[num_registers++] = registers[i];
+        }
+    }
+    return num_registers;
+}
+
+// Apply state of explicit or sparse type to registers
+static void fill_registers(const uint8_t* state, uint8_t* registers) {
+    if (state[0] == HLL_DATA_EXPLICIT) {
+        int count = state[1];
+        const uint64_t* hashes = reinterpret_cast<const uint64_t*>(state + EXPLICIT_HEADER_SIZE);
+        for (int i = 0; i < count; ++i) {
+            uint8_t* reg = registers + register_index(hashes[i]);
+            *reg = std::max(*reg, register_value(hashes[i]));
+        }
+    } else if (state[0] == HLL_DATA_SPRASE) {
+        int count = sparse_count(state);
+        const uint8_t* entry = state + SPARSE_HEADER_SIZE;
+        for (int i = 0; i < count; ++i, entry += SPARSE_ENTRY_SIZE) {
+            uint8_t* reg = registers + sparse_index(entry);
+            *reg = std::max(*reg, entry[2]);
+        }
+    }
+}
+
+// 'harmonic_sum' is sum of 2^-register of all registers
+static int64_t estimate_cardinality(float harmonic_sum, int num_zero_registers) {
+    const int num_streams = HLL_REGISTERS_COUNT;
+    // Empirical constants for the algorithm.
+    float alpha = 0.7213f / (1 + 1.079f / num_streams);
+    float harmonic_mean = 1.0f / harmonic_sum;
+    double estimate = alpha * num_streams * num_streams * harmonic_mean;
+    double tmp = 0.f;
+    // according to HerperLogLog current correction, if E is cardinal
+    // E =< num_streams * 2.5 , LC has higher accuracy.
+    // num_streams * 2.5 < E =< 2 ^ 32 / 30 , HerperLogLog has higher accuracy.
+    // E > 2 ^ 32 / 30 ,  estimate = -tmp * log(1 - estimate / tmp);
+    // Generally , we can use HerperLogLog to produce value as E.
+    if (num_zero_registers != 0) {
+        // Estimated cardinality is too low. Hll is too inaccurate here, instead use
+        // linear counting.
+        estimate = num_streams * log(static_cast<float>(num_streams) / num_zero_registers);
+    } else if (num_streams == 16384 && estimate < 72000) {
+        // when Linear Couint change to HerperLoglog according to HerperLogLog Correction,
+        // there are relatively large fluctuations, we fixed the problem refer to redis.
+        double bias = 5.9119 * 1.0e-18 * (estimate * estimate * estimate * estimate)
+        - 1.4253 * 1.0e-12 * (estimate * estimate * estimate) +
+        1.2940 * 1.0e-7 * (estimate * estimate)
+        - 5.2921 * 1.0e-3 * estimate +
+        83.3216;
+        estimate -= estimate * (bias / 100);
+    } else if (estimate > (tmp = std::pow(2, 32) / 30)) {
+        estimate = -tmp * log(1 - estimate / tmp);
+    }
+    return (int64_t)(estimate + 0.5);
+}
+
+void HllAggState::init(FunctionContext* ctx, StringVal* dst) {
+    dst->is_null = false;
+    dst->ptr = ctx->allocate(TYPE_SIZE);
+    dst->ptr[0] = HLL_DATA_EMPTY;
+    dst->len = TYPE_SIZE;
+}
+
+void HllAggState::update(FunctionContext* ctx, uint64_t hash_value, StringVal* dst) {
+    DCHECK(!dst->is_null);
+    switch (dst->ptr[0]) {
+    case HLL_DATA_EMPTY: {
+        dst->len = EXPLICIT_HEADER_SIZE + sizeof(uint64_t);
+        dst->ptr = ctx->reallocate(dst->ptr, dst->len);
+        dst->ptr[0] = HLL_DATA_EXPLICIT;
+        dst->ptr[1] = 1;
+        *reinterpret_cast<uint64_t*>(dst->ptr + EXPLICIT_HEADER_SIZE) = hash_value;
+        return;
+    }
+    case HLL_DATA_EXPLICIT: {
+        int count = dst->ptr[1];
+        uint64_t* hashes = reinterpret_cast<uint64_t*>(dst->ptr + EXPLICIT_HEADER_SIZE);
+        uint64_t* pos = std::lower_bound(hashes, hashes + count, hash_value);
+        if (pos != hashes + count && *pos == hash_value) {
+            return;
+        }
+        if (count < HLL_EXPLICLIT_INT64_NUM) {
+            int offset = pos - hashes;
+            dst->ptr = ctx->reallocate(dst->ptr, dst->len + sizeof(uint64_t));
+            hashes = reinterpret_cast<uint64_t*>(dst->ptr + EXPLICIT_HEADER_SIZE);
+            memmove(hashes + offset + 1, hashes + offset, (count - offset) * sizeof(uint64_t));
+            hashes[offset] = hash_value;
+            dst->ptr[1] = count + 1;
+            dst->len += sizeof(uint64_t);
+            return;
+        }
+        _to_sparse(ctx, dst);
+        break;
+    }
+    default:
+        break;
+    }
+    _update_register(ctx, register_index(hash_value), register_value(hash_value), dst);
+}
+
+void HllAggState::_update_register(FunctionContext* ctx, int index, uint8_t value,
+                                   StringVal* dst) {
+    if (dst->ptr[0] == HLL_DATA_FULL) {
+        uint8_t* reg = dst->ptr + TYPE_SIZE + index;
+        *reg = std::max(*reg, value);
+        return;
+    }
+    DCHECK_EQ(HLL_DATA_SPRASE, dst->ptr[0]);
+
+    // binary search in registers sorted by index
+    int count = sparse_count(dst->ptr);
+    uint8_t* entries = dst->ptr + SPARSE_HEADER_SIZE;
+    int low = 0;
+    int high = count;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (sparse_index(entries + mid * SPARSE_ENTRY_SIZE) < index) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    uint8_t* entry = entries + low * SPARSE_ENTRY_SIZE;
+    if (low < count && sparse_index(entry) == index) {
+        entry[2] = std::max(entry[2], value);
+        return;
+    }
+
+    if (count >= SPARSE_MAX_REGISTERS) {
+        _to_full(ctx, dst);
+        dst->ptr[TYPE_SIZE + index] = value;
+        return;
+    }
+    dst->ptr = ctx->reallocate(dst->ptr, dst->len + SPARSE_ENTRY_SIZE);
+    entry = dst->ptr + SPARSE_HEADER_SIZE + low * SPARSE_ENTRY_SIZE;
+    memmove(entry + SPARSE_ENTRY_SIZE, entry, (count - low) * SPARSE_ENTRY_SIZE);
+    set_sparse_entry(entry, index, value);
+    set_sparse_count(dst->ptr, count + 1);
+    dst->len += SPARSE_ENTRY_SIZE;
+}
+
+void HllAggState::merge(FunctionContext* ctx, const StringVal& src, StringVal* dst) {
+    DCHECK(!dst->is_null);
+    if (src.is_null || src.len == 0) {
+        return;
+    }
+    if (src.len == HLL_REGISTERS_COUNT) {
+        // registers of older versions
+        _to_full(ctx, dst);
+        merge_registers(src.ptr, HLL_REGISTERS_COUNT, dst->ptr + TYPE_SIZE);
+        return;
+    }
+
+    switch (src.ptr[0]) {
+    case HLL_DATA_EXPLICIT: {
+        int count = src.ptr[1];
+        const uint64_t* hashes = reinterpret_cast<const uint64_t*>(src.ptr + EXPLICIT_HEADER_SIZE);
+        for (int i = 0; i < count; ++i) {
+            update(ctx, hashes[i], dst);
+        }
+        break;
+    }
+    case HLL_DATA_SPRASE:
+        if (dst->ptr[0] == HLL_DATA_FULL) {
+            fill_registers(src.ptr, dst->ptr + TYPE_SIZE);
+            break;
+        }
+        if (dst->ptr[0] != HLL_DATA_SPRASE) {
+            _to_sparse(ctx, dst);
+        }
+        _merge_sparse(ctx, src, dst);
+        break;
+    case HLL_DATA_FULL:
+        _to_full(ctx, dst);
+        merge_registers(src.ptr + TYPE_SIZE, HLL_REGISTERS_COUNT, dst->ptr + TYPE_SIZE);
+        break;
+    default:
+        // HLL_DATA_EMPTY
+        break;
+    }
+}
+
+void HllAggState::_merge_sparse(FunctionContext* ctx, const StringVal& src, StringVal* dst) {
+    int dst_count = sparse_count(dst->ptr);
+    int src_count = sparse_count(src.ptr);
+    const uint8_t* dst_entry = dst->ptr + SPARSE_HEADER_SIZE;
+    const uint8_t* dst_end = dst_entry + dst_count * SPARSE_ENTRY_SIZE;
+    const uint8_t* src_entry = src.ptr + SPARSE_HEADER_SIZE;
+    const uint8_t* src_end = src_entry + src_count * SPARSE_ENTRY_SIZE;
+
+    uint8_t* merged = ctx->allocate(
+        SPARSE_HEADER_SIZE + (dst_count + src_count) * SPARSE_ENTRY_SIZE);
+    uint8_t* out = merged + SPARSE_HEADER_SIZE;
+    while (dst_entry != dst_end && src_entry != src_end) {
+        int dst_index = sparse_index(dst_entry);
+        int src_index = sparse_index(src_entry);
+        if (dst_index < src_index) {
+            memcpy(out, dst_entry, SPARSE_ENTRY_SIZE);
+            dst_entry += SPARSE_ENTRY_SIZE;
+        } else if (src_index < dst_index) {
+            memcpy(out, src_entry, SPARSE_ENTRY_SIZE);
+            src_entry += SPARSE_ENTRY_SIZE;
+        } else {
+            set_sparse_entry(out, dst_index, std::max(dst_entry[2], src_entry[2]));
+            dst_entry += SPARSE_ENTRY_SIZE;
+            src_entry += SPARSE_ENTRY_SIZE;
+        }
+        out += SPARSE_ENTRY_SIZE;
+    }
+    memcpy(out, dst_entry, dst_end - dst_entry);
+    out += dst_end - dst_entry;
+    memcpy(out, src_entry, src_end - src_entry);
+    out += src_end - src_entry;
+
+    merged[0] = HLL_DATA_SPRASE;
+    int count = (out - merged - SPARSE_HEADER_SIZE) / SPARSE_ENTRY_SIZE;
+    set_sparse_count(merged, count);
+    ctx->free(dst->ptr);
+    dst->ptr = merged;
+    dst->len = out - merged;
+    if (count > SPARSE_MAX_REGISTERS) {
+        _to_full(ctx, dst);
+    }
+}
+
+void HllAggState::_to_sparse(FunctionContext* ctx, StringVal* dst) {
+    DCHECK(dst->ptr[0] == HLL_DATA_EMPTY || dst->ptr[0] == HLL_DATA_EXPLICIT);
+    uint32_t registers[MAX_EXPLICIT_COUNT];
+    int count = 0;
+    if (dst->ptr[0] == HLL_DATA_EXPLICIT) {
+        count = explicit_registers(dst->ptr, registers);
+    }
+    int len = SPARSE_HEADER_SIZE + count * SPARSE_ENTRY_SIZE;
+    uint8_t* sparse = ctx->allocate(len);
+    sparse[0] = HLL_DATA_SPRASE;
+    set_sparse_count(sparse, count);
+    uint8_t* entry = sparse + SPARSE_HEADER_SIZE;
+    for (int i = 0; i < count; ++i, entry += SPARSE_ENTRY_SIZE) {
+        set_sparse_entry(entry, registers[i] >> 8, registers[i] & 0xff);
+    }
+    ctx->free(dst->ptr);
+    dst->ptr = sparse;
+    dst->len = len;
+}
+
+void HllAggState::_to_full(FunctionContext* ctx, StringVal* dst) {
+    if (dst->ptr[0] == HLL_DATA_FULL) {
+        return;
+    }
+    uint8_t* full = ctx->allocate(FULL_SIZE);
+    full[0] = HLL_DATA_FULL;
+    memset(full + TYPE_SIZE, 0, HLL_REGISTERS_COUNT);
+    fill_registers(dst->ptr, full + TYPE_SIZE);
+    ctx->free(dst->ptr);
+    dst->ptr = full;
+    dst->len = FULL_SIZE;
+}
+
+void HllAggState::merge_registers(const uint8_t* src, int len, uint8_t* dst) {
+    int i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i src_registers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i dst_registers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_max_epu8(src_registers, dst_registers));
+    }
+    for (; i < len; ++i) {
+        dst[i] = std::max(dst[i], src[i]);
+    }
+}
+
+int64_t HllAggState::estimate(const StringVal& src) {
+    if (src.is_null || src.len == 0) {
+        return 0;
+    }
+    float harmonic_sum = 0;
+    int num_zero_registers = 0;
+    if (src.len == HLL_REGISTERS_COUNT || src.ptr[0] == HLL_DATA_FULL) {
+        const uint8_t* registers = src.len == HLL_REGISTERS_COUNT ? src.ptr : src.ptr + TYPE_SIZE;
+        for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
+            harmonic_sum += powf(2.0f, -registers[i]);
+            if (registers[i] == 0) {
+                ++num_zero_registers;
+            }
+        }
+    } else if (src.ptr[0] == HLL_DATA_EXPLICIT) {
+        uint32_t registers[MAX_EXPLICIT_COUNT];
+        int count = explicit_registers(src.ptr, registers);
+        for (int i = 0; i < count; ++i) {
+            harmonic_sum += powf(2.0f, -static_cast<int>(registers[i] & 0xff));
+        }
+        num_zero_registers = HLL_REGISTERS_COUNT - count;
+        harmonic_sum += num_zero_registers;
+    } else if (src.ptr[0] == HLL_DATA_SPRASE) {
+        int count = sparse_count(src.ptr);
+        const uint8_t* entry = src.ptr + SPARSE_HEADER_SIZE;
+        for (int i = 0; i < count; ++i, entry += SPARSE_ENTRY_SIZE) {
+            harmonic_sum += powf(2.0f, -entry[2]);
+        }
+        num_zero_registers = HLL_REGISTERS_COUNT - count;
+        harmonic_sum += num_zero_registers;
+    } else {
+        // HLL_DATA_EMPTY
+        return 0;
+    }
+    return estimate_cardinality(harmonic_sum, num_zero_registers);
+}
+
+}
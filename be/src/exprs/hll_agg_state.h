@@ -0,0 +1,70 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#include "olap/hll.h"
+#include "udf/udf.h"
+
+namespace palo {
+
+// Intermediate state of HLL aggregate functions, ndv() and hll_union_agg().
+//
+// State is kept in the same encodings as HLL columns in storage (see
+// HllSetHelper), so it's sent through exchange as it is:
+//   empty:    [0]
+//   explicit: [1][uint8 count][uint64 hash] * count, sorted by hash
+//   sparse:   [2][int32 count][uint16 index, uint8 register] * count, sorted by index
+//   full:     [3][uint8 register] * HLL_REGISTERS_COUNT
+// It starts empty and is promoted to explicit, sparse and full as values are
+// added, so a group of few distinct values takes tens of bytes instead of
+// all registers.
+class HllAggState {
+public:
+    // Sparse state is promoted to full when it has more registers than this,
+    // which bounds the cost of inserting into sorted registers
+    static const int SPARSE_MAX_REGISTERS = HLL_REGISTERS_COUNT / 16;
+
+    static void init(palo_udf::FunctionContext* ctx, palo_udf::StringVal* dst);
+
+    // Add 64 bit hash of a value
+    static void update(palo_udf::FunctionContext* ctx, uint64_t hash_value,
+                       palo_udf::StringVal* dst);
+
+    // Merge 'src' of any encoding into 'dst'. Registers without type byte,
+    // which is the state of older versions, are accepted too.
+    static void merge(palo_udf::FunctionContext* ctx, const palo_udf::StringVal& src,
+                      palo_udf::StringVal* dst);
+
+    // Estimated number of distinct values
+    static int64_t estimate(const palo_udf::StringVal& src);
+
+    // dst[i] = max(dst[i], src[i]) for 'len' registers
+    static void merge_registers(const uint8_t* src, int len, uint8_t* dst);
+
+private:
+    static void _update_register(palo_udf::FunctionContext* ctx, int index, uint8_t value,
+                                 palo_udf::StringVal* dst);
+    static void _merge_sparse(palo_udf::FunctionContext* ctx, const palo_udf::StringVal& src,
+                              palo_udf::StringVal* dst);
+    // Convert empty or explicit state to sparse
+    static void _to_sparse(palo_udf::FunctionContext* ctx, palo_udf::StringVal* dst);
+    // Convert state of any type to full
+    static void _to_full(palo_udf::FunctionContext* ctx, palo_udf::StringVal* dst);
+};
+
+}
@@ -53,6 +53,7 @@ HybirdSetBase* HybirdSetBase::create_set(PrimitiveType type) {
         return new(std::nothrow) HybirdSet<DecimalValue>();
 
     case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
         return new(std::nothrow) HybirdSet<__int128>();
 
     case TYPE_CHAR:
@@ -91,13 +91,7 @@ void LikePredicate::like_prepare(
                 context,
                 *reinterpret_cast<StringVal*>(context->get_constant_arg(1)), 
                 &re_pattern);
-            RE2::Options opts;
-            opts.set_never_nl(false);
-            opts.set_dot_nl(true);
-            state->regex.reset(new RE2(re_pattern, opts));
-            if (!state->regex->ok()) {
-                context->set_error("Invalid regex: $0");
-            }
+            state->regex = get_regex(context, re_pattern, RE2::Options());
         }
     }
 }
@@ -156,15 +150,7 @@ void LikePredicate::regex_prepare(
             state->set_search_string(search_string);
             state->function = constant_substring_fn;
         } else {
-            RE2::Options opts;
-            opts.set_never_nl(false);
-            opts.set_dot_nl(true);
-            state->regex.reset(new RE2(pattern_str, opts));
-            if (!state->regex->ok()) {
-                std::stringstream error;
-                error << "Invalid regex expression" << pattern->ptr;
-                context->set_error(error.str().c_str());
-            }
+            state->regex = get_regex(context, pattern_str, RE2::Options());
             state->function = constant_regex_fn_partial;
         }
     }
@@ -210,11 +196,7 @@ void LikePredicate::regexp_like_prepare(
             return;
         }
         std::string pattern_str(reinterpret_cast<const char*>(pattern->ptr), pattern->len);
-        state->regex.reset(new RE2(pattern_str, opts));
-        if (!state->regex->ok()) {
-            error << "Invalid regex expression" << pattern->ptr;
-            context->set_error(error.str().c_str());
-        }
+        state->regex = get_regex(context, pattern_str, opts);
     }
 }
 
@@ -229,7 +211,7 @@ BooleanVal LikePredicate::regexp_like(
         return BooleanVal::null();
     }
     // If either the pattern or the third optional match parameter are not constant, we
-    // have to recompile the RE for every row.
+    // have to get the RE for every row, it's compiled only if it's not in cache.
     if (!context->is_arg_constant(2) || !context->is_arg_constant(1)) {
         if (match_parameter.is_null) {
             return BooleanVal::null();
@@ -241,14 +223,11 @@ BooleanVal LikePredicate::regexp_like(
             return BooleanVal(false);
         }
         std::string re_pattern(reinterpret_cast<const char*>(pattern.ptr), pattern.len);
-        re2::RE2 re(re_pattern, opts);
-        if (re.ok()) {
-            return RE2::PartialMatch(re2::StringPiece(
-                    reinterpret_cast<const char*>(val.ptr), val.len), re);
-        } else {
-            context->set_error("Invalid regex: $0");
+        CachedRegexPtr re = get_regex(context, re_pattern, opts);
+        if (re == NULL) {
             return BooleanVal(false);
         }
+        return re->partial_match(reinterpret_cast<const char*>(val.ptr), val.len);
     }
     return constant_regex_fn_partial(context, val, pattern);
 }
@@ -337,8 +316,10 @@ BooleanVal LikePredicate::constant_regex_fn_partial(
     }
     LikePredicateState* state = reinterpret_cast<LikePredicateState*>(
         context->get_function_state(FunctionContext::THREAD_LOCAL));
-    re2::StringPiece operand_sp(reinterpret_cast<const char*>(val.ptr), val.len);
-    return RE2::PartialMatch(operand_sp, *state->regex);
+    if (state->regex == NULL) {
+        return BooleanVal(false);
+    }
+    return state->regex->partial_match(reinterpret_cast<const char*>(val.ptr), val.len);
 }
 
 BooleanVal LikePredicate::constant_regex_fn(
@@ -348,8 +329,10 @@ BooleanVal LikePredicate::constant_regex_fn(
     }
     LikePredicateState* state = reinterpret_cast<LikePredicateState*>(
         context->get_function_state(FunctionContext::THREAD_LOCAL));
-    re2::StringPiece operand_sp(reinterpret_cast<const char*>(val.ptr), val.len);
-    return RE2::FullMatch(operand_sp, *state->regex);
+    if (state->regex == NULL) {
+        return BooleanVal(false);
+    }
+    return state->regex->full_match(reinterpret_cast<const char*>(val.ptr), val.len);
 }
 
 BooleanVal LikePredicate::regex_match(
@@ -360,41 +343,54 @@ BooleanVal LikePredicate::regex_match(
     if (operand_value.is_null || pattern_value.is_null) {
         return BooleanVal::null();
     }
+    const char* operand = reinterpret_cast<const char*>(operand_value.ptr);
     if (context->is_arg_constant(1)) {
         LikePredicateState* state = reinterpret_cast<LikePredicateState*>(
             context->get_function_state(FunctionContext::THREAD_LOCAL));
+        if (state->regex == NULL) {
+            return BooleanVal(false);
+        }
         if (is_like_pattern) {
-            return RE2::FullMatch(re2::StringPiece(reinterpret_cast<const char*>(
-                        operand_value.ptr), operand_value.len), *state->regex.get());
+            return state->regex->full_match(operand, operand_value.len);
         } else {
-            return RE2::PartialMatch(re2::StringPiece(reinterpret_cast<const char*>(
-                        operand_value.ptr), operand_value.len), *state->regex.get());
+            return state->regex->partial_match(operand, operand_value.len);
         }
     } else {
+        // pattern is compiled only if it's not in cache
         std::string re_pattern;
-        RE2::Options opts;
-        opts.set_never_nl(false);
-        opts.set_dot_nl(true);
         if (is_like_pattern) {
             convert_like_pattern(context, pattern_value, &re_pattern);
         } else {
             re_pattern =
                 std::string(reinterpret_cast<const char*>(pattern_value.ptr), pattern_value.len);
         }
-        re2::RE2 re(re_pattern, opts);
-        if (re.ok()) {
-            if (is_like_pattern) {
-                return RE2::FullMatch(re2::StringPiece(
-                        reinterpret_cast<const char*>(operand_value.ptr), operand_value.len), re);
-            } else {
-                return RE2::PartialMatch(re2::StringPiece(
-                        reinterpret_cast<const char*>(operand_value.ptr), operand_value.len), re);
-            }
-        } else {
-            context->set_error("Invalid regex: $0");
+        CachedRegexPtr re = get_regex(context, re_pattern, RE2::Options());
+        if (re == NULL) {
             return BooleanVal(false);
         }
+        if (is_like_pattern) {
+            return re->full_match(operand, operand_value.len);
+        } else {
+            return re->partial_match(operand, operand_value.len);
+        }
+    }
+}
+
+CachedRegexPtr LikePredicate::get_regex(
+        FunctionContext* context,
+        const std::string& pattern,
+        const RE2::Options& opts) {
+    RE2::Options options(opts);
+    options.set_never_nl(false);
+    options.set_dot_nl(true);
+    std::string error_str;
+    CachedRegexPtr re = RegexCache::instance()->get(pattern, options, &error_str);
+    if (re == NULL) {
+        std::stringstream error;
+        error << "Invalid regex expression: " << pattern << ", error: " << error_str;
+        context->set_error(error.str().c_str());
     }
+    return re;
 }
 
 void LikePredicate::convert_like_pattern(
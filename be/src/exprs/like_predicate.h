@@ -26,6 +26,7 @@
 #include <re2/re2.h>
 
 #include "exprs/predicate.h"
+#include "exprs/regex_cache.h"
 #include "gen_cpp/Exprs_types.h"
 #include "runtime/string_search.hpp"
 
@@ -67,7 +68,9 @@ private:
         StringSearch substring_pattern;
 
         /// Used for RLIKE and REGEXP predicates if the pattern is a constant argument.
-        std::unique_ptr<re2::RE2> regex;
+        /// It's shared with other predicates of the same pattern through RegexCache.
+        /// NULL if the pattern is invalid.
+        CachedRegexPtr regex;
 
         LikePredicateState() : escape_char('\\') {
         }
@@ -166,6 +169,13 @@ private:
         palo_udf::FunctionContext* context, const palo_udf::StringVal& val,
         const palo_udf::StringVal& pattern, bool is_like_pattern);
 
+    /// Return compiled regex of pattern from RegexCache, dot matches new line.
+    /// Return NULL and set error of context if it's invalid.
+    static CachedRegexPtr get_regex(
+        palo_udf::FunctionContext* context,
+        const std::string& pattern,
+        const re2::RE2::Options& opts);
+
     /// Convert a LIKE pattern (with embedded % and _) into the corresponding
     /// regular expression pattern. Escaped chars are copied verbatim.
     static void convert_like_pattern(
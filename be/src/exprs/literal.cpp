@@ -24,6 +24,7 @@
 
 #include "codegen/llvm_codegen.h"
 #include "codegen/codegen_anyval.h"
+#include "exprs/expr_column.h"
 #include "gen_cpp/Exprs_types.h"
 #include "util/string_parser.hpp"
 #include "runtime/runtime_state.h"
@@ -102,6 +103,12 @@ Literal::Literal(const TExprNode& node) :
         _value.decimal_val = DecimalValue(node.decimal_literal.value);
         break;
     }
+    case TYPE_DECIMALV2: {
+        DCHECK_EQ(node.node_type, TExprNodeType::DECIMAL_LITERAL);
+        DCHECK(node.__isset.decimal_literal);
+        _value.decimalv2_val = DecimalV2Value(node.decimal_literal.value);
+        break;
+    }
     default: 
         break;
         // DCHECK(false) << "Invalid type: " << TypeToString(_type.type);
@@ -158,6 +165,13 @@ DecimalVal Literal::get_decimal_val(ExprContext* context, TupleRow* row) {
     return dec_val;
 }
 
+DecimalV2Val Literal::get_decimalv2_val(ExprContext* context, TupleRow* row) {
+    DCHECK_EQ(_type.type, TYPE_DECIMALV2) << _type;
+    DecimalV2Val dec_val;
+    _value.decimalv2_val.to_decimal_val(&dec_val);
+    return dec_val;
+}
+
 DateTimeVal Literal::get_datetime_val(ExprContext* context, TupleRow* row) {
     DateTimeVal dt_val;
     _value.datetime_val.to_datetime_val(&dt_val);
@@ -171,6 +185,50 @@ StringVal Literal::get_string_val(ExprContext* context, TupleRow* row) {
     return str_val;
 }
 
+const void* Literal::value_ptr() const {
+    switch (_type.type) {
+    case TYPE_BOOLEAN:
+        return &_value.bool_val;
+    case TYPE_TINYINT:
+        return &_value.tinyint_val;
+    case TYPE_SMALLINT:
+        return &_value.smallint_val;
+    case TYPE_INT:
+        return &_value.int_val;
+    case TYPE_BIGINT:
+        return &_value.bigint_val;
+    case TYPE_LARGEINT:
+        return &_value.large_int_val;
+    case TYPE_FLOAT:
+        return &_value.float_val;
+    case TYPE_DOUBLE:
+        return &_value.double_val;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return &_value.string_val;
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        return &_value.datetime_val;
+    case TYPE_DECIMAL:
+        return &_value.decimal_val;
+    case TYPE_DECIMALV2:
+        return &_value.decimalv2_val;
+    default:
+        return NULL;
+    }
+}
+
+Status Literal::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                               int num_rows, MemPool* pool, ExprColumn* result) {
+    const void* value = value_ptr();
+    if (value == NULL) {
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+    result->fill(value);
+    return Status::OK;
+}
+
 // IR produced for bigint literal 10:
 //
 // define { i8, i64 } @Literal(i8* %context, %"class.palo::TupleRow"* %row) {
@@ -182,6 +240,9 @@ Status Literal::get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn
         *fn = _ir_compute_fn;
         return Status::OK;
     }
+    if (_type.type == TYPE_DECIMALV2) {
+        return Status("Literal Codegen not supported for DECIMALV2");
+    }
 
     DCHECK_EQ(get_num_children(), 0);
     LlvmCodeGen* codegen = NULL;
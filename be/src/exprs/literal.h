@@ -46,14 +46,21 @@ public:
     virtual FloatVal get_float_val(ExprContext* context, TupleRow*);
     virtual DoubleVal get_double_val(ExprContext* context, TupleRow*);
     virtual DecimalVal get_decimal_val(ExprContext* context, TupleRow*);
+    virtual DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow*);
     virtual DateTimeVal get_datetime_val(ExprContext* context, TupleRow*);
     virtual StringVal get_string_val(ExprContext* context, TupleRow* row);
 
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
+
 protected:
     friend class Expr;
     Literal(const TExprNode& node);
 
 private:
+    // Pointer to _value in slot format, NULL if type is not supported
+    const void* value_ptr() const;
+
     ExprValue _value;
 };
 
@@ -49,6 +49,7 @@ public:
     virtual palo_udf::StringVal get_string_val(ExprContext*, TupleRow*);
     virtual palo_udf::DateTimeVal get_datetime_val(ExprContext*, TupleRow*);
     virtual palo_udf::DecimalVal get_decimal_val(ExprContext*, TupleRow*);
+    virtual palo_udf::DecimalV2Val get_decimalv2_val(ExprContext*, TupleRow*);
 
 protected:
     friend class Expr;
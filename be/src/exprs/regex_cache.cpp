@@ -0,0 +1,211 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/regex_cache.h"
+
+#include <ctype.h>
+
+#include "common/config.h"
+
+namespace palo {
+
+CachedRegex::CachedRegex(re2::RE2* re, const std::string& literal) :
+        _re(re),
+        _literal(literal),
+        _literal_sv(_literal),
+        _literal_search(&_literal_sv) {
+}
+
+RegexCache* RegexCache::instance() {
+    static RegexCache s_instance(config::regex_cache_capacity);
+    return &s_instance;
+}
+
+// Options which change how a pattern is compiled, they are part of cache key
+static void append_options(const re2::RE2::Options& options, std::string* key) {
+    uint32_t flags = options.encoding();
+    flags = (flags << 1) | options.posix_syntax();
+    flags = (flags << 1) | options.longest_match();
+    flags = (flags << 1) | options.log_errors();
+    flags = (flags << 1) | options.literal();
+    flags = (flags << 1) | options.never_nl();
+    flags = (flags << 1) | options.dot_nl();
+    flags = (flags << 1) | options.never_capture();
+    flags = (flags << 1) | options.case_sensitive();
+    flags = (flags << 1) | options.perl_classes();
+    flags = (flags << 1) | options.word_boundary();
+    flags = (flags << 1) | options.one_line();
+    int64_t max_mem = options.max_mem();
+    key->append(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    key->append(reinterpret_cast<const char*>(&max_mem), sizeof(max_mem));
+}
+
+CachedRegexPtr RegexCache::get(const re2::StringPiece& pattern,
+                               const re2::RE2::Options& options,
+                               std::string* error) {
+    std::string key;
+    append_options(options, &key);
+    key.append(pattern.data(), pattern.size());
+
+    CachedRegexPtr regex;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_cache.get(key, &regex)) {
+            return regex;
+        }
+    }
+
+    // compile without lock, the same pattern may be compiled by several
+    // threads at the same time, which is rare and harmless
+    re2::RE2* re = new re2::RE2(pattern, options);
+    if (!re->ok()) {
+        *error = re->error();
+        delete re;
+        return CachedRegexPtr();
+    }
+    // literal is searched case sensitively
+    std::string literal;
+    if (options.case_sensitive() && !options.literal()) {
+        literal = required_literal(pattern);
+    } else if (options.case_sensitive()) {
+        literal = pattern.as_string();
+    }
+    regex.reset(new CachedRegex(re, literal));
+
+    std::lock_guard<std::mutex> l(_lock);
+    _cache.put(key, regex);
+    return regex;
+}
+
+size_t RegexCache::size() {
+    std::lock_guard<std::mutex> l(_lock);
+    return _cache.size();
+}
+
+// Remove the last character of 'str', which may be an UTF-8 sequence
+static void remove_last_char(std::string* str) {
+    while (!str->empty() && (static_cast<uint8_t>(str->back()) & 0xC0) == 0x80) {
+        str->pop_back();
+    }
+    if (!str->empty()) {
+        str->pop_back();
+    }
+}
+
+std::string RegexCache::required_literal(const re2::StringPiece& pattern) {
+    std::string longest;
+    std::string current;
+    auto end_current = [&longest, &current]() {
+        if (current.size() > longest.size()) {
+            longest.swap(current);
+        }
+        current.clear();
+    };
+
+    const char* p = pattern.data();
+    int len = pattern.size();
+    // depth of parentheses, only literals out of groups are taken
+    int depth = 0;
+    for (int i = 0; i < len; ++i) {
+        char c = p[i];
+        if (c == '\\') {
+            if (i + 1 >= len) {
+                return "";
+            }
+            char next = p[++i];
+            if (depth > 0) {
+                continue;
+            }
+            if (!isalnum(static_cast<uint8_t>(next))) {
+                current.append(1, next);
+                continue;
+            }
+            switch (next) {
+            case 'd': case 'D': case 'w': case 'W': case 's': case 'S':
+            case 'b': case 'B': case 'A': case 'z':
+                end_current();
+                continue;
+            default:
+                // \x, \p, \Q, octal and so on are not parsed
+                return "";
+            }
+        }
+        if (c == '[') {
+            // skip character class, ']' right after '[' or '[^' is literal
+            end_current();
+            ++i;
+            if (i < len && p[i] == '^') {
+                ++i;
+            }
+            if (i < len && p[i] == ']') {
+                ++i;
+            }
+            while (i < len && p[i] != ']') {
+                if (p[i] == '\\') {
+                    ++i;
+                }
+                ++i;
+            }
+            continue;
+        }
+        if (depth > 0) {
+            if (c == '(') {
+                ++depth;
+            } else if (c == ')') {
+                --depth;
+            }
+            continue;
+        }
+        switch (c) {
+        case '|':
+            return "";
+        case '(':
+            // flags such as (?i) change the rest of pattern
+            if (i + 1 < len && p[i + 1] == '?' && (i + 2 >= len || p[i + 2] != ':')) {
+                return "";
+            }
+            end_current();
+            ++depth;
+            break;
+        case '*':
+        case '?':
+        case '{':
+            // previous character is optional
+            remove_last_char(&current);
+            end_current();
+            if (c == '{') {
+                while (i < len && p[i] != '}') {
+                    ++i;
+                }
+            }
+            break;
+        case '+':
+            end_current();
+            break;
+        case '.':
+        case '^':
+        case '$':
+            end_current();
+            break;
+        default:
+            current.append(1, c);
+            break;
+        }
+    }
+    end_current();
+    return longest;
+}
+
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <re2/re2.h>
+
+#include "gutil/macros.h"
+#include "runtime/string_search.hpp"
+#include "runtime/string_value.h"
+#include "util/lru_cache.hpp"
+
+namespace palo {
+
+// A compiled regex shared by all queries. It's immutable after it's created,
+// so it can be used by multiple threads without lock.
+class CachedRegex {
+public:
+    // 'literal' must be in every string matched by 're', may be empty
+    CachedRegex(re2::RE2* re, const std::string& literal);
+
+    const re2::RE2& re() const { return *_re; }
+    const std::string& literal() const { return _literal; }
+
+    // Return false if 'str' can't be matched because it doesn't contain the
+    // literal, which is much cheaper than running the regex.
+    bool may_match(const char* str, int len) const {
+        if (_literal_sv.len == 0) {
+            return true;
+        }
+        StringValue value(const_cast<char*>(str), len);
+        return _literal_search.search(&value) != -1;
+    }
+
+    bool full_match(const char* str, int len) const {
+        return may_match(str, len) && re2::RE2::FullMatch(re2::StringPiece(str, len), *_re);
+    }
+
+    bool partial_match(const char* str, int len) const {
+        return may_match(str, len) && re2::RE2::PartialMatch(re2::StringPiece(str, len), *_re);
+    }
+
+private:
+    std::unique_ptr<re2::RE2> _re;
+    std::string _literal;
+    StringValue _literal_sv;
+    StringSearch _literal_search;
+
+    DISALLOW_COPY_AND_ASSIGN(CachedRegex);
+};
+
+typedef std::shared_ptr<const CachedRegex> CachedRegexPtr;
+
+// Process wide LRU cache of compiled regexes keyed by pattern and options,
+// so that LIKE and REGEXP with the same pattern in different fragments, or
+// with a pattern from a column, don't compile it again and again.
+class RegexCache {
+public:
+    explicit RegexCache(size_t capacity) : _cache(capacity) { }
+
+    // Cache of size config::regex_cache_capacity
+    static RegexCache* instance();
+
+    // Return compiled regex of 'pattern' with 'options', it's compiled and
+    // put into cache if it's not there. Return NULL and set 'error' if the
+    // pattern can't be compiled, such patterns are not cached.
+    CachedRegexPtr get(const re2::StringPiece& pattern,
+                       const re2::RE2::Options& options,
+                       std::string* error);
+
+    size_t size();
+
+    // Return the longest literal which is in every string matched by regex
+    // 'pattern', or empty string if it's not sure. Only simple patterns are
+    // handled, e.g. alternation at top level gives nothing.
+    static std::string required_literal(const re2::StringPiece& pattern);
+
+private:
+    std::mutex _lock;
+    LruCache<std::string, CachedRegexPtr> _cache;
+
+    DISALLOW_COPY_AND_ASSIGN(RegexCache);
+};
+
+}
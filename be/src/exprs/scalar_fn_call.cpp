@@ -27,6 +27,7 @@
 #include "codegen/codegen_anyval.h"
 #include "codegen/llvm_codegen.h"
 #include "exprs/anyval_util.h"
+#include "exprs/expr_column.h"
 #include "exprs/expr_context.h"
 #include "runtime/lib_cache.h"
 #include "runtime/runtime_state.h"
@@ -284,6 +285,14 @@ Status ScalarFnCall::get_codegend_compute_fn(RuntimeState* state, Function** fn)
             *fn = NULL;
             return Status("ScalarFnCall Codegen not supported for CHAR");
         }
+        if (_children[i]->type().type == TYPE_DECIMALV2) {
+            *fn = NULL;
+            return Status("ScalarFnCall Codegen not supported for DECIMALV2");
+        }
+    }
+    if (_type.type == TYPE_DECIMALV2) {
+        *fn = NULL;
+        return Status("ScalarFnCall Codegen not supported for DECIMALV2");
     }
 
     LlvmCodeGen* codegen = NULL;
@@ -583,6 +592,25 @@ void ScalarFnCall::evaluate_children(
     }
 }
 
+void ScalarFnCall::set_input_vals(
+        ExprContext* context, const std::vector<ExprColumn>& columns, int row_idx,
+        std::vector<AnyVal*>* input_vals) {
+    DCHECK_EQ(input_vals->size(), num_fixed_args());
+    FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
+    uint8_t* varargs_buffer = fn_ctx->impl()->varargs_buffer();
+    for (int i = 0; i < _children.size(); ++i) {
+        const void* src_slot = columns[i].get_value(row_idx);
+        AnyVal* dst_val = NULL;
+        if (_vararg_start_idx == -1 || i < _vararg_start_idx) {
+            dst_val = (*input_vals)[i];
+        } else {
+            dst_val = reinterpret_cast<AnyVal*>(varargs_buffer);
+            varargs_buffer += AnyValUtil::any_val_size(_children[i]->type());
+        }
+        AnyValUtil::set_any_val(src_slot, _children[i]->type(), dst_val);
+    }
+}
+
 template<typename RETURN_TYPE>
 RETURN_TYPE ScalarFnCall::interpret_eval(ExprContext* context, TupleRow* row) {
     DCHECK(_scalar_fn != NULL);
@@ -590,7 +618,72 @@ RETURN_TYPE ScalarFnCall::interpret_eval(ExprContext* context, TupleRow* row) {
     std::vector<AnyVal*>* input_vals = fn_ctx->impl()->staging_input_vals();
     
     evaluate_children(context, row, input_vals);
+    return call_scalar_fn<RETURN_TYPE>(fn_ctx, input_vals);
+}
 
+template<typename RETURN_TYPE>
+Status ScalarFnCall::interpret_eval_batch(ExprContext* context, RowBatch* batch,
+                                          const int* sel, int num_rows, MemPool* pool,
+                                          ExprColumn* result) {
+    DCHECK(_scalar_fn != NULL);
+    std::vector<ExprColumn> columns(_children.size());
+    for (int i = 0; i < _children.size(); ++i) {
+        RETURN_IF_ERROR(_children[i]->evaluate_batch(
+                context, batch, sel, num_rows, pool, &columns[i]));
+    }
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+
+    FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
+    std::vector<AnyVal*>* input_vals = fn_ctx->impl()->staging_input_vals();
+    for (int i = 0; i < num_rows; ++i) {
+        set_input_vals(context, columns, i, input_vals);
+        result->set(i, call_scalar_fn<RETURN_TYPE>(fn_ctx, input_vals));
+    }
+    return Status::OK;
+}
+
+Status ScalarFnCall::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                    int num_rows, MemPool* pool, ExprColumn* result) {
+    // codegen'd wrapper evaluates children itself, so it's called row by row
+    if (_scalar_fn_wrapper != NULL || _scalar_fn == NULL) {
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    switch (_type.type) {
+    case TYPE_BOOLEAN:
+        return interpret_eval_batch<BooleanVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_TINYINT:
+        return interpret_eval_batch<TinyIntVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_SMALLINT:
+        return interpret_eval_batch<SmallIntVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_INT:
+        return interpret_eval_batch<IntVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_BIGINT:
+        return interpret_eval_batch<BigIntVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_LARGEINT:
+        return interpret_eval_batch<LargeIntVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_FLOAT:
+        return interpret_eval_batch<FloatVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_DOUBLE:
+        return interpret_eval_batch<DoubleVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+    case TYPE_HLL:
+        return interpret_eval_batch<StringVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        return interpret_eval_batch<DateTimeVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_DECIMAL:
+        return interpret_eval_batch<DecimalVal>(context, batch, sel, num_rows, pool, result);
+    case TYPE_DECIMALV2:
+        return interpret_eval_batch<DecimalV2Val>(context, batch, sel, num_rows, pool, result);
+    default:
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+}
+
+template<typename RETURN_TYPE>
+RETURN_TYPE ScalarFnCall::call_scalar_fn(
+        FunctionContext* fn_ctx, std::vector<AnyVal*>* input_vals) {
     if (_vararg_start_idx == -1) {
         switch (_children.size()) {
         case 0:
@@ -863,6 +956,14 @@ DecimalVal ScalarFnCall::get_decimal_val(ExprContext* context, TupleRow* row) {
     return fn(context, row);
 }
 
+DecimalV2Val ScalarFnCall::get_decimalv2_val(ExprContext* context, TupleRow* row) {
+    DCHECK_EQ(_type.type, TYPE_DECIMALV2);
+    DCHECK(context != NULL);
+    // never codegen'd, see get_codegend_compute_fn()
+    DCHECK(_scalar_fn_wrapper == NULL);
+    return interpret_eval<DecimalV2Val>(context, row);
+}
+
 std::string ScalarFnCall::debug_string() const {
     std::stringstream out;
     out << "ScalarFnCall(udf_type=" << _fn.binary_type
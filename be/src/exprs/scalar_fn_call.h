@@ -81,8 +81,12 @@ protected:
     virtual palo_udf::StringVal get_string_val(ExprContext* context, TupleRow*);
     virtual palo_udf::DateTimeVal get_datetime_val(ExprContext* context, TupleRow*);
     virtual palo_udf::DecimalVal get_decimal_val(ExprContext* context, TupleRow*);
+    virtual palo_udf::DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow*);
     // virtual palo_udf::ArrayVal GetArrayVal(ExprContext* context, TupleRow*);
 
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
+
 private:
     /// If this function has var args, children()[_vararg_start_idx] is the first vararg
     /// argument.
@@ -125,9 +129,25 @@ private:
     void evaluate_children(ExprContext* context, TupleRow* row,
                           std::vector<palo_udf::AnyVal*>* input_vals);
 
+    /// Sets input_vals and varargs from values of row 'row_idx' of 'columns', which are
+    /// results of children. Used in the batch path.
+    void set_input_vals(ExprContext* context, const std::vector<ExprColumn>& columns,
+                        int row_idx, std::vector<palo_udf::AnyVal*>* input_vals);
+
     /// Function to call _scalar_fn. Used in the interpreted path.
     template<typename RETURN_TYPE>
     RETURN_TYPE interpret_eval(ExprContext* context, TupleRow* row);
+
+    /// Evaluates children a column at a time, and calls _scalar_fn for each row.
+    /// Used in the batch path when the function is not codegen'd.
+    template<typename RETURN_TYPE>
+    Status interpret_eval_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                int num_rows, MemPool* pool, ExprColumn* result);
+
+    /// Calls _scalar_fn with input_vals and varargs which are already set.
+    template<typename RETURN_TYPE>
+    RETURN_TYPE call_scalar_fn(palo_udf::FunctionContext* fn_ctx,
+                               std::vector<palo_udf::AnyVal*>* input_vals);
 };
 
 }
@@ -24,7 +24,9 @@
 
 #include "codegen/codegen_anyval.h"
 #include "codegen/llvm_codegen.h"
+#include "exprs/expr_column.h"
 #include "gen_cpp/Exprs_types.h"
+#include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "util/types.h"
 
@@ -176,6 +178,9 @@ Status SlotRef::get_codegend_compute_fn(RuntimeState* state, llvm::Function** fn
         *fn = _ir_compute_fn;
         return Status::OK;
     }
+    if (_type.type == TYPE_DECIMALV2) {
+        return Status("SlotRef Codegen not supported for DECIMALV2");
+    }
 
     DCHECK_EQ(get_num_children(), 0);
     LlvmCodeGen* codegen = NULL;
@@ -524,4 +529,78 @@ DecimalVal SlotRef::get_decimal_val(ExprContext* context, TupleRow* row) {
     return dec_val;
 }
 
+DecimalV2Val SlotRef::get_decimalv2_val(ExprContext* context, TupleRow* row) {
+    DCHECK_EQ(_type.type, TYPE_DECIMALV2);
+    Tuple* t = row->get_tuple(_tuple_idx);
+    if (t == NULL || t->is_null(_null_indicator_offset)) {
+        return DecimalV2Val::null();
+    }
+    return DecimalV2Val(reinterpret_cast<PackedInt128*>(t->get_slot(_slot_offset))->value);
+}
+
+Status SlotRef::evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                               int num_rows, MemPool* pool, ExprColumn* result) {
+    RETURN_IF_ERROR(result->init(_type.type, num_rows, pool));
+    switch (_type.type) {
+    case TYPE_BOOLEAN:
+        gather_slots<bool>(batch, sel, num_rows, result);
+        break;
+    case TYPE_TINYINT:
+        gather_slots<int8_t>(batch, sel, num_rows, result);
+        break;
+    case TYPE_SMALLINT:
+        gather_slots<int16_t>(batch, sel, num_rows, result);
+        break;
+    case TYPE_INT:
+        gather_slots<int32_t>(batch, sel, num_rows, result);
+        break;
+    case TYPE_BIGINT:
+        gather_slots<int64_t>(batch, sel, num_rows, result);
+        break;
+    case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
+        gather_slots<__int128>(batch, sel, num_rows, result);
+        break;
+    case TYPE_FLOAT:
+        gather_slots<float>(batch, sel, num_rows, result);
+        break;
+    case TYPE_DOUBLE:
+        gather_slots<double>(batch, sel, num_rows, result);
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+    case TYPE_HLL:
+        gather_slots<StringValue>(batch, sel, num_rows, result);
+        break;
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        gather_slots<DateTimeValue>(batch, sel, num_rows, result);
+        break;
+    case TYPE_DECIMAL:
+        gather_slots<DecimalValue>(batch, sel, num_rows, result);
+        break;
+    default:
+        return Expr::evaluate_batch(context, batch, sel, num_rows, pool, result);
+    }
+    return Status::OK;
+}
+
+template <typename T>
+void SlotRef::gather_slots(RowBatch* batch, const int* sel, int num_rows, ExprColumn* result) {
+    T* values = result->data<T>();
+    uint8_t* nulls = result->nulls();
+    bool has_nulls = false;
+    for (int i = 0; i < num_rows; ++i) {
+        Tuple* t = batch->get_row(sel[i])->get_tuple(_tuple_idx);
+        if (t == NULL || t->is_null(_null_indicator_offset)) {
+            nulls[i] = 1;
+            has_nulls = true;
+            continue;
+        }
+        // slots of LARGEINT are not aligned
+        memcpy(&values[i], t->get_slot(_slot_offset), sizeof(T));
+    }
+    result->set_has_nulls(has_nulls);
+}
+
 }
@@ -80,9 +80,17 @@ public:
     virtual palo_udf::StringVal get_string_val(ExprContext* context, TupleRow*);
     virtual palo_udf::DateTimeVal get_datetime_val(ExprContext* context, TupleRow*);
     virtual palo_udf::DecimalVal get_decimal_val(ExprContext* context, TupleRow*);
+    virtual palo_udf::DecimalV2Val get_decimalv2_val(ExprContext* context, TupleRow*);
     // virtual palo_udf::ArrayVal GetArrayVal(ExprContext* context, TupleRow*);
 
+    virtual Status evaluate_batch(ExprContext* context, RowBatch* batch, const int* sel,
+                                  int num_rows, MemPool* pool, ExprColumn* result);
+
 private:
+    // Copy slots of selected rows into result, T is the slot type
+    template <typename T>
+    void gather_slots(RowBatch* batch, const int* sel, int num_rows, ExprColumn* result);
+
     int _tuple_idx;  // within row
     int _slot_offset;  // within tuple
     NullIndicatorOffset _null_indicator_offset;  // within tuple
@@ -24,8 +24,11 @@
 
 #include "exprs/expr.h"
 #include "exprs/anyval_util.h"
+#include "exprs/regex_cache.h"
 #include "runtime/string_value.hpp"
 #include "runtime/tuple_row.h"
+#include "udf/udf_internal.h"
+#include "util/simd_string_util.h"
 #include "util/url_parser.h"
 
 // NOTE: be careful not to use string::append.  It is not performant.
@@ -34,6 +37,12 @@ namespace palo {
 void StringFunctions::init() {
 }
 
+// Result of string functions, which is carved from result blocks of context
+// instead of being allocated for every row
+static inline StringVal allocate_result(FunctionContext* context, int len) {
+    return StringVal(context->impl()->allocate_result(len), len);
+}
+
 // This behaves identically to the mysql implementation, namely:
 //  - 1-indexed positions
 //  - supported negative positions (count from the end of the string)
@@ -196,19 +205,25 @@ IntVal StringFunctions::length(FunctionContext* context, const StringVal& str) {
     return IntVal(str.len);
 }
 
+// Implementation of CHAR_LENGTH
+//   int char_length(string input)
+// Returns the number of UTF-8 characters of input.
+IntVal StringFunctions::char_length(FunctionContext* context, const StringVal& str) {
+    if (str.is_null) {
+        return IntVal::null();
+    }
+    return IntVal(SimdStringUtil::utf8_length(str.ptr, str.len));
+}
+
 StringVal StringFunctions::lower(FunctionContext* context, const StringVal& str) {
     if (str.is_null) {
         return StringVal::null();
     }
-    // TODO pengyubing
-    // StringVal result = StringVal::create_temp_string_val(context, str.len);
-    StringVal result(context, str.len);
+    StringVal result = allocate_result(context, str.len);
     if (UNLIKELY(result.is_null)) {
         return result;
     }
-    for (int i = 0; i < str.len; ++i) {
-        result.ptr[i] = ::tolower(str.ptr[i]);
-    }
+    SimdStringUtil::to_lower(str.ptr, str.len, result.ptr);
     return result;
 }
 
@@ -216,15 +231,11 @@ StringVal StringFunctions::upper(FunctionContext* context, const StringVal& str)
     if (str.is_null) {
         return StringVal::null();
     }
-    // TODO pengyubing
-    // StringVal result = StringVal::create_temp_string_val(context, str.len);
-    StringVal result(context, str.len);
+    StringVal result = allocate_result(context, str.len);
     if (UNLIKELY(result.is_null)) {
         return result;
     }
-    for (int i = 0; i < str.len; ++i) {
-        result.ptr[i] = ::toupper(str.ptr[i]);
-    }
+    SimdStringUtil::to_upper(str.ptr, str.len, result.ptr);
     return result;
 }
 
@@ -233,13 +244,11 @@ StringVal StringFunctions::reverse(FunctionContext* context, const StringVal& st
         return StringVal::null();
     }
 
-    // TODO pengyubing
-    // StringVal result = StringVal::create_temp_string_val(context, str.len);
-    StringVal result(context, str.len);
+    StringVal result = allocate_result(context, str.len);
     if (UNLIKELY(result.is_null)) {
         return result;
     }
-    std::reverse_copy(str.ptr, str.ptr + str.len, result.ptr);
+    SimdStringUtil::reverse(str.ptr, str.len, result.ptr);
     return result;
 }
 
@@ -248,15 +257,13 @@ StringVal StringFunctions::trim(FunctionContext* context, const StringVal& str)
         return StringVal::null();
     }
     // Find new starting position.
-    int32_t begin = 0;
-    while (begin < str.len && str.ptr[begin] == ' ') {
-        ++begin;
+    int32_t begin = SimdStringUtil::find_first_not_space(str.ptr, str.len);
+    if (begin == str.len) {
+        return StringVal(str.ptr + begin, 0);
     }
     // Find new ending position.
-    int32_t end = str.len - 1;
-    while (end > begin && str.ptr[end] == ' ') {
-        --end;
-    }
+    int32_t end = begin + SimdStringUtil::find_last_not_space(
+        str.ptr + begin, str.len - begin);
     return StringVal(str.ptr + begin, end - begin + 1);
 }
 
@@ -265,10 +272,7 @@ StringVal StringFunctions::ltrim(FunctionContext* context, const StringVal& str)
         return StringVal::null();
     }
     // Find new starting position.
-    int32_t begin = 0;
-    while (begin < str.len && str.ptr[begin] == ' ') {
-        ++begin;
-    }
+    int32_t begin = SimdStringUtil::find_first_not_space(str.ptr, str.len);
     return StringVal(str.ptr + begin, str.len - begin);
 }
 
@@ -276,16 +280,9 @@ StringVal StringFunctions::rtrim(FunctionContext* context, const StringVal& str)
     if (str.is_null) {
         return StringVal::null();
     }
-    if (str.len == 0) {
-        return str;
-    }
     // Find new ending position.
-    int32_t end = str.len - 1;
-    while (end > 0 && str.ptr[end] == ' ') {
-        --end;
-    }
-    DCHECK_GE(end, 0);
-    return StringVal(str.ptr, (str.ptr[end] == ' ') ? end : end + 1);
+    int32_t end = SimdStringUtil::find_last_not_space(str.ptr, str.len);
+    return StringVal(str.ptr, end + 1);
 }
 
 IntVal StringFunctions::ascii(FunctionContext* context, const StringVal& str) {
@@ -372,8 +369,8 @@ bool StringFunctions::set_re2_options(
     return true;
 }
 
-// The caller owns the returned regex. Returns NULL if the pattern could not be compiled.
-static re2::RE2* compile_regex(
+// The regex is shared through RegexCache. Returns NULL if the pattern could not be compiled.
+static CachedRegexPtr compile_regex(
         const StringVal& pattern, 
         std::string* error_str,
         const StringVal& match_parameter) {
@@ -386,16 +383,15 @@ static re2::RE2* compile_regex(
     options.set_dot_nl(true);
     if (!match_parameter.is_null
             && !StringFunctions::set_re2_options(match_parameter, error_str, &options)) {
-        return NULL;
+        return CachedRegexPtr();
     }
-    re2::RE2* re = new re2::RE2(pattern_sp, options);
-    if (!re->ok()) {
+    std::string re_error;
+    CachedRegexPtr re = RegexCache::instance()->get(pattern_sp, options, &re_error);
+    if (re == NULL) {
         std::stringstream ss;
         ss << "Could not compile regexp pattern: " << AnyValUtil::to_string(pattern) 
-            << std::endl << "Error: " << re->error();
+            << std::endl << "Error: " << re_error;
         *error_str = ss.str();
-        delete re;
-        return NULL;
     }
     return re;
 }
@@ -414,12 +410,12 @@ void StringFunctions::regexp_prepare(
         return;
     }
     std::string error_str;
-    re2::RE2* re = compile_regex(*pattern, &error_str, StringVal::null());
+    CachedRegexPtr re = compile_regex(*pattern, &error_str, StringVal::null());
     if (re == NULL) {
         context->set_error(error_str.c_str());
         return;
     }
-    context->set_function_state(scope, re);
+    context->set_function_state(scope, new CachedRegexPtr(re));
 }
 
 void StringFunctions::regexp_close(
@@ -427,7 +423,7 @@ void StringFunctions::regexp_close(
     if (scope != FunctionContext::FRAGMENT_LOCAL) {
         return;
     }
-    re2::RE2* re = reinterpret_cast<re2::RE2*>(context->get_function_state(scope));
+    CachedRegexPtr* re = reinterpret_cast<CachedRegexPtr*>(context->get_function_state(scope));
     delete re;
 }
 
@@ -441,19 +437,24 @@ StringVal StringFunctions::regexp_extract(
         return StringVal();
     }
 
-    re2::RE2* re = reinterpret_cast<re2::RE2*>(
+    CachedRegexPtr* state = reinterpret_cast<CachedRegexPtr*>(
         context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-    std::unique_ptr<re2::RE2> scoped_re; // destroys re if we have to locally compile it
-    if (re == NULL) {
+    CachedRegexPtr cached_re;
+    if (state == NULL) {
         DCHECK(!context->is_arg_constant(1));
         std::string error_str;
-        re = compile_regex(pattern, &error_str, StringVal::null());
-        if (re == NULL) {
+        cached_re = compile_regex(pattern, &error_str, StringVal::null());
+        if (cached_re == NULL) {
             context->add_warning(error_str.c_str());
             return StringVal::null();
         }
-        scoped_re.reset(re);
+    } else {
+        cached_re = *state;
     }
+    if (!cached_re->may_match(reinterpret_cast<const char*>(str.ptr), str.len)) {
+        return StringVal();
+    }
+    const re2::RE2* re = &cached_re->re();
 
     re2::StringPiece str_sp(reinterpret_cast<char*>(str.ptr), str.len);
     int max_matches = 1 + re->NumberOfCapturingGroups();
@@ -480,10 +481,10 @@ StringVal StringFunctions::regexp_replace(
         return StringVal::null();
     }
 
-    re2::RE2* re = reinterpret_cast<re2::RE2*>(
+    CachedRegexPtr* state = reinterpret_cast<CachedRegexPtr*>(
         context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-    std::unique_ptr<re2::RE2> scoped_re; // destroys re if state->re is NULL
-    if (re == NULL) {
+    CachedRegexPtr re;
+    if (state == NULL) {
         DCHECK(!context->is_arg_constant(1));
         std::string error_str;
         re = compile_regex(pattern, &error_str, StringVal::null());
@@ -491,13 +492,18 @@ StringVal StringFunctions::regexp_replace(
             context->add_warning(error_str.c_str());
             return StringVal::null();
         }
-        scoped_re.reset(re);
+    } else {
+        re = *state;
+    }
+    // nothing to replace
+    if (!re->may_match(reinterpret_cast<const char*>(str.ptr), str.len)) {
+        return str;
     }
 
     re2::StringPiece replace_str =
         re2::StringPiece(reinterpret_cast<char*>(replace.ptr), replace.len);
     std::string result_str = AnyValUtil::to_string(str);
-    re2::RE2::GlobalReplace(&result_str, *re, replace_str);
+    re2::RE2::GlobalReplace(&result_str, re->re(), replace_str);
     return AnyValUtil::from_string_temp(context, result_str);
 }
 
@@ -532,9 +538,7 @@ StringVal StringFunctions::concat_ws(
         total_size += sep.len + strs[i].len;
     }
 
-    // TODO pengyubing
-    // StringVal result = StringVal::create_temp_string_val(context, total_size);
-    StringVal result(context, total_size);
+    StringVal result = allocate_result(context, total_size);
     uint8_t* ptr = result.ptr;
 
     // Loop again to append the data.
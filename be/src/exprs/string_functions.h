@@ -61,6 +61,8 @@ public:
         const palo_udf::IntVal& len, const palo_udf::StringVal& pad); 
     static palo_udf::IntVal length(
         palo_udf::FunctionContext* context, const palo_udf::StringVal& str);
+    static palo_udf::IntVal char_length(
+        palo_udf::FunctionContext* context, const palo_udf::StringVal& str);
     static palo_udf::StringVal lower(
         palo_udf::FunctionContext* context, const palo_udf::StringVal& str);
     static palo_udf::StringVal upper(
@@ -147,8 +147,7 @@ IntVal TimestampFunctions::year(
     if (ts_val.is_null) {
         return IntVal::null();
     }
-    const DateTimeValue& ts_value = DateTimeValue::from_datetime_val(ts_val);
-    return IntVal(ts_value.year());
+    return IntVal(DateTimeValue::year_of_packed(ts_val.packed_time));
 }
 
 IntVal TimestampFunctions::quarter(
@@ -156,8 +155,7 @@ IntVal TimestampFunctions::quarter(
     if (ts_val.is_null) {
         return IntVal::null();
     }
-    const DateTimeValue& ts_value = DateTimeValue::from_datetime_val(ts_val);
-    return IntVal((ts_value.month() - 1) / 3 + 1);
+    return IntVal((DateTimeValue::month_of_packed(ts_val.packed_time) - 1) / 3 + 1);
 }
 
 IntVal TimestampFunctions::month(
@@ -165,8 +163,7 @@ IntVal TimestampFunctions::month(
     if (ts_val.is_null) {
         return IntVal::null();
     }
-    const DateTimeValue& ts_value = DateTimeValue::from_datetime_val(ts_val);
-    return IntVal(ts_value.month());
+    return IntVal(DateTimeValue::month_of_packed(ts_val.packed_time));
 }
 
 IntVal TimestampFunctions::day_of_month(
@@ -174,8 +171,7 @@ IntVal TimestampFunctions::day_of_month(
     if (ts_val.is_null) {
         return IntVal::null();
     }
-    const DateTimeValue& ts_value = DateTimeValue::from_datetime_val(ts_val);
-    return IntVal(ts_value.day());
+    return IntVal(DateTimeValue::day_of_packed(ts_val.packed_time));
 }
 
 IntVal TimestampFunctions::day_of_year(
@@ -406,12 +402,55 @@ DateTimeVal TimestampFunctions::timestamp_time_op(
     return new_ts_val;
 }
 
+void TimestampFunctions::date_format_prepare(
+        FunctionContext* context, FunctionContext::FunctionStateScope scope) {
+    if (scope != FunctionContext::FRAGMENT_LOCAL) {
+        return;
+    }
+
+    if (!context->is_arg_constant(1)) {
+        return;
+    }
+    StringVal* format = reinterpret_cast<StringVal*>(context->get_constant_arg(1));
+    if (format->is_null) {
+        return;
+    }
+    CompiledDateFormat* compiled = new CompiledDateFormat();
+    if (!compiled->compile((const char*)format->ptr, format->len)) {
+        delete compiled;
+        return;
+    }
+    context->set_function_state(scope, compiled);
+}
+
+void TimestampFunctions::date_format_close(
+        FunctionContext* context, FunctionContext::FunctionStateScope scope) {
+    if (scope != FunctionContext::FRAGMENT_LOCAL) {
+        return;
+    }
+    CompiledDateFormat* compiled = reinterpret_cast<CompiledDateFormat*>(
+        context->get_function_state(scope));
+    delete compiled;
+}
+
 StringVal TimestampFunctions::date_format(
         FunctionContext* ctx, const DateTimeVal& ts_val, const StringVal& format) {
     if (ts_val.is_null || format.is_null) {
         return StringVal::null();
     }
     DateTimeValue ts_value = DateTimeValue::from_datetime_val(ts_val);
+    CompiledDateFormat* compiled = reinterpret_cast<CompiledDateFormat*>(
+        ctx->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+    if (compiled != NULL) {
+        // Format into result directly
+        StringVal result = StringVal::create_temp_string_val(ctx, compiled->max_length());
+        char* end = compiled->format(ts_value, (char*)result.ptr);
+        if (end == NULL) {
+            return StringVal::null();
+        }
+        result.len = end - (char*)result.ptr;
+        return result;
+    }
     if (ts_value.compute_format_len((const char*)format.ptr, format.len) >= 128) {
         return StringVal::null();
     }
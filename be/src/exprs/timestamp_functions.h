@@ -140,6 +140,13 @@ public:
     static palo_udf::StringVal date_format(
         palo_udf::FunctionContext* ctx, const palo_udf::DateTimeVal& ts_val,
         const palo_udf::StringVal& format);
+    // Compile constant format string of date_format()
+    static void date_format_prepare(
+        palo_udf::FunctionContext* context,
+        palo_udf::FunctionContext::FunctionStateScope scope);
+    static void date_format_close(
+        palo_udf::FunctionContext* context,
+        palo_udf::FunctionContext::FunctionStateScope scope);
     static palo_udf::DateTimeVal from_days(
         palo_udf::FunctionContext* ctx, const palo_udf::IntVal& days);
     static palo_udf::IntVal to_days(
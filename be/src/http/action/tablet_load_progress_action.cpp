@@ -0,0 +1,85 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/tablet_load_progress_action.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "http/http_channel.h"
+#include "http/http_request.h"
+#include "http/http_response.h"
+#include "http/http_status.h"
+#include "olap/olap_engine.h"
+
+namespace palo {
+
+const static std::string HEADER_JSON = "application/json";
+
+TabletLoadProgressAction::TabletLoadProgressAction(ExecEnv* exec_env) :
+        _exec_env(exec_env) {
+}
+
+void TabletLoadProgressAction::handle(HttpRequest *req, HttpChannel *channel) {
+    std::vector<TabletLoadProgress> progress;
+    OLAPEngine::get_instance()->get_tablet_load_progress(&progress);
+    int64_t num_tables = 0;
+    int64_t num_loaded_tables = 0;
+    OLAPEngine::get_instance()->count_loaded_tables(&num_tables, &num_loaded_tables);
+
+    std::string result = to_json(progress, num_tables, num_loaded_tables, time(NULL));
+    HttpResponse response(HttpStatus::OK, HEADER_JSON, &result);
+    channel->send_response(response);
+}
+
+std::string TabletLoadProgressAction::to_json(
+        const std::vector<TabletLoadProgress>& progress,
+        int64_t num_tables, int64_t num_loaded_tables, time_t now) {
+    rapidjson::Document root(rapidjson::kObjectType);
+    rapidjson::Document::AllocatorType& allocator = root.GetAllocator();
+
+    bool finished = true;
+    rapidjson::Value root_paths(rapidjson::kArrayType);
+    for (const TabletLoadProgress& p : progress) {
+        bool path_finished = p.finish_time != 0;
+        finished = finished && path_finished;
+        rapidjson::Value path_info(rapidjson::kObjectType);
+        path_info.AddMember("path",
+                            rapidjson::Value(p.root_path.c_str(), allocator).Move(),
+                            allocator);
+        path_info.AddMember("tablets", p.num_tablets, allocator);
+        path_info.AddMember("loaded", p.num_loaded, allocator);
+        path_info.AddMember("failed", p.num_failed, allocator);
+        path_info.AddMember("finished", path_finished, allocator);
+        path_info.AddMember("cost_seconds",
+                            static_cast<int64_t>((path_finished ? p.finish_time : now)
+                                                 - p.start_time),
+                            allocator);
+        root_paths.PushBack(path_info, allocator);
+    }
+    root.AddMember("root_paths", root_paths, allocator);
+    root.AddMember("status", rapidjson::StringRef(finished ? "FINISHED" : "LOADING"), allocator);
+    // tables whose data and index are loaded
+    root.AddMember("tables", num_tables, allocator);
+    root.AddMember("data_loaded_tables", num_loaded_tables, allocator);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    root.Accept(writer);
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+}
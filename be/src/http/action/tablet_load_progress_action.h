@@ -0,0 +1,48 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "http/http_handler.h"
+
+namespace palo {
+
+class ExecEnv;
+struct TabletLoadProgress;
+
+// Get progress of loading tablets on start. Headers of all tablets are
+// loaded on start, and data and index of a tablet are loaded when it's
+// accessed first time.
+class TabletLoadProgressAction : public HttpHandler {
+public:
+    TabletLoadProgressAction(ExecEnv* exec_env);
+
+    virtual ~TabletLoadProgressAction() {};
+
+    virtual void handle(HttpRequest *req, HttpChannel *channel);
+
+    // Format progress of all root paths into json
+    static std::string to_json(const std::vector<TabletLoadProgress>& progress,
+                               int64_t num_tables, int64_t num_loaded_tables, time_t now);
+
+private:
+    ExecEnv* _exec_env;
+};
+
+}
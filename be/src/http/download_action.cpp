@@ -169,19 +169,35 @@ void DownloadAction::do_file_response(
     int64_t file_size = get_file_size(fp);
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
+    // Only single range is supported, clone downloads large files with
+    // several range requests in parallel.
+    int64_t offset = 0;
+    int64_t length = file_size;
+    HttpStatus status_code = HttpStatus::OK;
     const std::string& range_header = req->header(HttpHeaders::RANGE);
     if (!range_header.empty()) {
-        // analyse range header
+        if (!parse_range(range_header, file_size, &offset, &length)) {
+            LOG(WARNING) << "invalid range: " << range_header << ", file: " << file_path;
+            HttpResponse response(HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+            channel->send_response(response);
+            return;
+        }
+        status_code = HttpStatus::PARTIAL_CONTENT;
     }
 
-    HttpResponse response(HttpStatus::OK);
+    HttpResponse response(status_code);
     response.add_header(
             std::string(HttpHeaders::CONTENT_LENGTH),
-            boost::lexical_cast<std::string>(file_size));
+            boost::lexical_cast<std::string>(length));
     response.add_header(
             std::string(HttpHeaders::CONTENT_TYPE),
             get_content_type(file_path));
+    response.add_header(std::string(HttpHeaders::ACCEPT_RANGES), "bytes");
+    if (status_code == HttpStatus::PARTIAL_CONTENT) {
+        std::stringstream content_range;
+        content_range << "bytes " << offset << "-" << offset + length - 1 << "/" << file_size;
+        response.add_header(std::string(HttpHeaders::CONTENT_RANGE), content_range.str());
+    }
 
     if (req->method() == HttpMethod::HEAD) {
         channel->send_response_header(response);
@@ -189,22 +205,75 @@ void DownloadAction::do_file_response(
     }
 
     channel->send_response_header(response);
+    if (::fseek(fp, offset, SEEK_SET) != 0) {
+        LOG(ERROR) << "Something is wrong when seek file: " << file_path;
+        return;
+    }
     const int BUFFER_SIZE = 4096;
     char *buffer = new char[BUFFER_SIZE];
     int32_t readed_size = 0;
     bool eos = false;
-    do {
-        Status status = get_file_content(fp, buffer, BUFFER_SIZE, &readed_size, &eos);
+    int64_t remaining = length;
+    while (remaining > 0 && !eos) {
+        int32_t buffer_size = remaining < BUFFER_SIZE ? remaining : BUFFER_SIZE;
+        Status status = get_file_content(fp, buffer, buffer_size, &readed_size, &eos);
         if (!status.ok()) {
             LOG(ERROR) << "Something is wrong when read file: " << file_path;
             break;
         }
         channel->append_response_content(response, buffer, readed_size);
-    } while (!eos);
+        remaining -= readed_size;
+    }
 
     delete[] buffer;
 }
 
+bool DownloadAction::parse_range(
+        const std::string& range_header, int64_t file_size,
+        int64_t* offset, int64_t* length) {
+    const std::string BYTES_UNIT = "bytes=";
+    if (range_header.compare(0, BYTES_UNIT.size(), BYTES_UNIT) != 0) {
+        return false;
+    }
+    std::string range = range_header.substr(BYTES_UNIT.size());
+    size_t pos = range.find('-');
+    if (pos == std::string::npos || range.find(',') != std::string::npos) {
+        return false;
+    }
+
+    std::string first = range.substr(0, pos);
+    std::string last = range.substr(pos + 1);
+    int64_t start = 0;
+    int64_t end = file_size - 1;
+    try {
+        if (first.empty()) {
+            // suffix range, last N bytes
+            if (last.empty()) {
+                return false;
+            }
+            int64_t suffix = boost::lexical_cast<int64_t>(last);
+            start = suffix < file_size ? file_size - suffix : 0;
+        } else {
+            start = boost::lexical_cast<int64_t>(first);
+            if (!last.empty()) {
+                end = boost::lexical_cast<int64_t>(last);
+            }
+        }
+    } catch (boost::bad_lexical_cast& e) {
+        return false;
+    }
+
+    if (start < 0 || start >= file_size || end < start) {
+        return false;
+    }
+    if (end >= file_size) {
+        end = file_size - 1;
+    }
+    *offset = start;
+    *length = end - start + 1;
+    return true;
+}
+
 Status DownloadAction::get_file_content(
         FILE* fp, char* buffer, int32_t buffer_size,
         int32_t* readed_size, bool* eos) {
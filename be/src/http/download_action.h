@@ -26,9 +26,9 @@ namespace palo {
 class ExecEnv;
 
 // A simple handler that serves incoming HTTP requests of file-download to send their respective HTTP responses.
+// A single byte range in 'Range' header is supported.
 //
-// TODO(lingbin): implements two useful header ('If-Modified-Since' and 'RANGE') to reduce
-// transmission consumption.
+// TODO(lingbin): implements useful header 'If-Modified-Since' to reduce transmission consumption.
 // We use parameter named 'file' to specify the static resource path, it is an absolute path.
 class DownloadAction : public HttpHandler {
 public:
@@ -41,6 +41,11 @@ public:
 
     virtual void handle(HttpRequest *req, HttpChannel *channel);
 
+    // Parse 'Range' header like "bytes=0-99", "bytes=100-" or "bytes=-100".
+    // Return false if it's not a single range satisfiable in file.
+    static bool parse_range(const std::string& range_header, int64_t file_size,
+                            int64_t* offset, int64_t* length);
+
 private:
     enum DOWNLOAD_TYPE {
         NORMAL = 1,
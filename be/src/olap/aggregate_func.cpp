@@ -131,9 +131,15 @@ AggregateFuncResolver::AggregateFuncResolver() {
     // Hyperloglog Aggregate Function
     add_aggregate_mapping<OLAP_FIELD_AGGREGATION_HLL_UNION, OLAP_FIELD_TYPE_HLL>();
 
+    // Bitmap Aggregate Function
+    add_aggregate_mapping<OLAP_FIELD_AGGREGATION_BITMAP_UNION, OLAP_FIELD_TYPE_VARCHAR>();
+
 
     // Finalize Function for hyperloglog Function
     add_finalize_mapping<OLAP_FIELD_AGGREGATION_HLL_UNION, OLAP_FIELD_TYPE_HLL>();
+
+    // Finalize Function for bitmap Function
+    add_finalize_mapping<OLAP_FIELD_AGGREGATION_BITMAP_UNION, OLAP_FIELD_TYPE_VARCHAR>();
 }
 
 AggregateFuncResolver::~AggregateFuncResolver() {}
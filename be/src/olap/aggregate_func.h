@@ -19,11 +19,12 @@
 #include "olap/field_info.h"
 #include "olap/hll.h"
 #include "olap/types.h"
+#include "util/roaring_bitmap.h"
 
 namespace palo {
 
 using AggregateFunc = void (*)(char* left, char* right);
-using FinalizeFunc = void (*)(char* data);
+using FinalizeFunc = OLAPStatus (*)(char* data);
 
 template<FieldAggregationMethod agg_method,
         FieldType field_type> struct AggregateFuncTraits {};
@@ -220,7 +221,7 @@ struct AggregateFuncTraits<OLAP_FIELD_AGGREGATION_HLL_UNION, OLAP_FIELD_TYPE_HLL
         HllContext* context = (reinterpret_cast<HllContext*>(hll_ptr));
         HllSetHelper::fill_set(right + 1, context);
     }
-    static void finalize(char* data) {
+    static OLAPStatus finalize(char* data) {
         StringSlice* slice = reinterpret_cast<StringSlice*>(data);
         size_t hll_ptr = *(size_t*)(slice->data - sizeof(HllContext*));
         HllContext* context = (reinterpret_cast<HllContext*>(hll_ptr));
@@ -256,6 +257,68 @@ struct AggregateFuncTraits<OLAP_FIELD_AGGREGATION_HLL_UNION, OLAP_FIELD_TYPE_HLL
         slice->size = result_len & 0xffff;
 
         HllSetHelper::init_context(context);
+        return OLAP_SUCCESS;
+    }
+};
+
+// BITMAP_UNION列在RowCursor中的聚合上下文，与HllContext一样，地址保存在列数据之前。
+// 聚合时合并到bitmap中，finalize时再序列化到列数据中。
+struct BitmapContext {
+    BitmapContext(size_t capacity_) : capacity(capacity_) { }
+
+    RoaringBitmap bitmap;
+    // 列数据的buffer大小
+    size_t capacity;
+};
+
+template <>
+struct AggregateFuncTraits<OLAP_FIELD_AGGREGATION_BITMAP_UNION, OLAP_FIELD_TYPE_VARCHAR> {
+    static BitmapContext* context(const StringSlice* slice) {
+        return *reinterpret_cast<BitmapContext**>(slice->data - sizeof(BitmapContext*));
+    }
+
+    static void init(char* left, const char* right) {
+        bool r_null = *reinterpret_cast<const bool*>(right);
+        *reinterpret_cast<bool*>(left) = r_null;
+        BitmapContext* ctx = context(reinterpret_cast<StringSlice*>(left + 1));
+        ctx->bitmap.clear();
+        if (!r_null) {
+            _merge(ctx, reinterpret_cast<const StringSlice*>(right + 1));
+        }
+    }
+
+    static void aggregate(char* left, char* right) {
+        bool r_null = *reinterpret_cast<bool*>(right);
+        if (r_null) {
+            return;
+        }
+        *reinterpret_cast<bool*>(left) = false;
+        BitmapContext* ctx = context(reinterpret_cast<StringSlice*>(left + 1));
+        _merge(ctx, reinterpret_cast<const StringSlice*>(right + 1));
+    }
+
+    static OLAPStatus finalize(char* data) {
+        StringSlice* slice = reinterpret_cast<StringSlice*>(data);
+        BitmapContext* ctx = context(slice);
+        size_t size = ctx->bitmap.serialized_size();
+        if (size > ctx->capacity) {
+            // 超过列长度的bitmap无法保存，置NULL会丢失数据，直接让导入或合并失败
+            OLAP_LOG_WARNING("bitmap is too large for column. [size=%lu capacity=%lu]",
+                             size, ctx->capacity);
+            ctx->bitmap.clear();
+            return OLAP_ERR_BUFFER_OVERFLOW;
+        }
+        ctx->bitmap.serialize(reinterpret_cast<uint8_t*>(slice->data));
+        slice->size = size;
+        ctx->bitmap.clear();
+        return OLAP_SUCCESS;
+    }
+
+private:
+    static void _merge(BitmapContext* ctx, const StringSlice* slice) {
+        if (!ctx->bitmap.merge(reinterpret_cast<const uint8_t*>(slice->data), slice->size)) {
+            OLAP_LOG_WARNING("invalid bitmap is ignored. [size=%lu]", slice->size);
+        }
     }
 };
 
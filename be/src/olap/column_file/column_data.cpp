@@ -81,7 +81,9 @@ OLAPStatus ColumnData::_next_row(const RowCursor** row, bool without_filter) {
                 return OLAP_SUCCESS;
             } else {
                 DCHECK(_read_block->block_status() == DEL_PARTIAL_SATISFIED);
-                bool row_del_filter = _delete_handler.is_filter_data(
+                // _read_block is always read from current segment, whose delete
+                // handler has no condition resolved by delete bitmap
+                bool row_del_filter = _segment_reader->delete_handler().is_filter_data(
                     _olap_index->version().second, _cursor);
                 if (!row_del_filter) {
                     *row = &_cursor;
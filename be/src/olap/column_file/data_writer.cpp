@@ -148,15 +148,7 @@ OLAPStatus ColumnDataWriter::_add_segment() {
         return OLAP_ERR_MALLOC_ERROR;
     }
 
-    OLAPStatus res = OLAP_SUCCESS;
-    if (_is_push_write) {
-        res = _segment_writer->init(
-                config::push_write_mbytes_per_sec);
-    } else {
-        res = _segment_writer->init(
-                config::base_compaction_write_mbytes_per_sec);
-    }
-
+    OLAPStatus res = _segment_writer->init();
     if (OLAP_SUCCESS != res) {
         OLAP_LOG_WARNING("fail to init segment writer");
         return res;
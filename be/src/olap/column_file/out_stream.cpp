@@ -373,15 +373,9 @@ uint64_t OutStream::get_total_buffer_size() const {
     return result;
 }
 
-OLAPStatus OutStream::write_to_file(FileHandler* file_handle,
-                                uint32_t write_mbytes_per_sec) const {
+OLAPStatus OutStream::write_to_file(FileHandler* file_handle) const {
     OLAPStatus res = OLAP_SUCCESS;
 
-    uint64_t total_stream_len = 0;
-    OlapStopWatch speed_limit_watch;
-
-    speed_limit_watch.reset();
-
     for (std::vector<ByteBuffer*>::const_iterator it = _output_buffers.begin();
             it != _output_buffers.end(); ++it) {
         OLAP_LOG_DEBUG("write stream begin: %lu", file_handle->tell());
@@ -393,18 +387,6 @@ OLAPStatus OutStream::write_to_file(FileHandler* file_handle,
         }
 
         OLAP_LOG_DEBUG("write stream end: %lu", file_handle->tell());
-
-        total_stream_len += (*it)->limit();
-        if (write_mbytes_per_sec > 0) {
-            uint64_t delta_time_us = speed_limit_watch.get_elapse_time_us();
-            int64_t sleep_time =
-                    total_stream_len / write_mbytes_per_sec - delta_time_us;
-            if (sleep_time > 0) {
-                OLAP_LOG_DEBUG("sleep to limit merge speed. [time=%lu bytes=%lu]",
-                        sleep_time, total_stream_len);
-                usleep(sleep_time);
-            }
-        }
     }
 
     return res;
@@ -64,9 +64,7 @@ public:
     uint64_t get_total_buffer_size() const;
 
     // 将缓存的数据流输出到文件
-    OLAPStatus write_to_file(
-        FileHandler* file_handle,
-        uint32_t write_mbytes_per_sec) const;
+    OLAPStatus write_to_file(FileHandler* file_handle) const;
 
     bool is_suppressed() const {
         return _is_suppressed;
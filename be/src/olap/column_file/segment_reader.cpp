@@ -212,6 +212,7 @@ OLAPStatus SegmentReader::init(bool is_using_cache) {
         OLAP_LOG_WARNING("fail to set sgment info. ");
         return res;
     }
+    _load_delete_bitmaps();
 
     _shared_buffer = ByteBuffer::create(
         _header_message().stream_buffer_size() + sizeof(StreamHead));
@@ -377,7 +378,7 @@ OLAPStatus SegmentReader::_pick_columns() {
 OLAPStatus SegmentReader::_pick_delete_row_groups(uint32_t first_block, uint32_t last_block) {
     OLAP_LOG_DEBUG("pick for %u to %u for delete_condition", first_block, last_block);
 
-    if (_delete_handler.empty()) {
+    if (_delete_handler.empty() && _delete_bitmaps.empty()) {
         return OLAP_SUCCESS;
     }
 
@@ -444,6 +445,24 @@ OLAPStatus SegmentReader::_pick_delete_row_groups(uint32_t first_block, uint32_t
         }
     }
 
+    // 已经由delete bitmap解决的删除条件不再计算统计信息，整个block都被删除时直接跳过
+    for (int64_t j = first_block; !_delete_bitmaps.empty() && j <= last_block; ++j) {
+        if (DEL_SATISFIED == _include_blocks[j]) {
+            continue;
+        }
+
+        uint64_t block_begin = j * _num_rows_in_block;
+        uint64_t block_end = std::min<uint64_t>(block_begin + _num_rows_in_block, num_rows());
+        if (!_is_rows_deleted(block_begin, block_end)) {
+            continue;
+        }
+
+        _include_blocks[j] = DEL_SATISFIED;
+        --_remain_block;
+        OLAP_LOG_DEBUG("filter block by delete bitmap: %d", j);
+        _stats->rows_del_filtered += block_end - block_begin;
+    }
+
     return OLAP_SUCCESS;
 
 }
@@ -918,6 +937,9 @@ OLAPStatus SegmentReader::_load_to_vectorized_row_batch(
         }
     }
     batch->set_size(size);
+    if (!_delete_bitmaps.empty() && !_without_filter) {
+        _filter_deleted_rows(batch, _current_block_id * _num_rows_in_block);
+    }
     if (_include_blocks != nullptr) {
         batch->set_block_status(_include_blocks[_current_block_id]);
     } else {
@@ -937,5 +959,72 @@ OLAPStatus SegmentReader::_load_to_vectorized_row_batch(
     return OLAP_SUCCESS;
 }
 
+void SegmentReader::_load_delete_bitmaps() {
+    std::shared_ptr<const OLAPIndex::DeleteBitmaps> bitmaps;
+    if (_olap_index->get_delete_bitmaps(_segment_id, &bitmaps) != OLAP_SUCCESS
+            || bitmaps->empty()) {
+        return;
+    }
+
+    std::vector<int32_t> resolved_versions;
+    for (auto& delete_condition : _delete_handler.get_delete_conditions()) {
+        if (!delete_condition.use_delete_bitmap
+                || delete_condition.filter_version <= _olap_index->version().first) {
+            continue;
+        }
+
+        // 没有bitmap的segment(例如合并或者clone生成的数据)仍然按删除条件过滤
+        auto it = bitmaps->find(delete_condition.filter_version);
+        if (it == bitmaps->end()
+                || static_cast<uint64_t>(it->second->num_bits()) != num_rows()) {
+            continue;
+        }
+        _delete_bitmaps.push_back(it->second);
+        resolved_versions.push_back(delete_condition.filter_version);
+    }
+
+    if (!resolved_versions.empty()) {
+        _delete_handler.remove_conditions(resolved_versions);
+    }
+}
+
+bool SegmentReader::_is_rows_deleted(uint64_t begin, uint64_t end) const {
+    for (uint64_t row = begin; row < end; ++row) {
+        bool deleted = false;
+        for (auto& bitmap : _delete_bitmaps) {
+            if (bitmap->Get(row)) {
+                deleted = true;
+                break;
+            }
+        }
+        if (!deleted) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SegmentReader::_filter_deleted_rows(VectorizedRowBatch* batch, uint64_t first_row) {
+    uint16_t* sel = batch->selected();
+    uint16_t n = batch->size();
+    uint16_t new_size = 0;
+    for (uint16_t i = 0; i != n; ++i) {
+        bool deleted = false;
+        for (auto& bitmap : _delete_bitmaps) {
+            if (bitmap->Get(first_row + i)) {
+                deleted = true;
+                break;
+            }
+        }
+        sel[new_size] = i;
+        new_size += !deleted;
+    }
+    if (new_size < n) {
+        batch->set_size(new_size);
+        batch->set_selected_in_use(true);
+        _stats->rows_del_filtered += n - new_size;
+    }
+}
+
 }  // namespace column_file
 }  //unamespace palo
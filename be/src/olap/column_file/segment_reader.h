@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "olap/column_file/bloom_filter_reader.h"
@@ -114,6 +115,16 @@ public:
         return _num_rows_in_block;
     }
 
+    // 返回当前segment的总行数，在init之后调用
+    uint64_t num_rows() {
+        return _header_message().number_of_rows();
+    }
+
+    // 返回去掉了由delete bitmap解决的删除条件之后的delete handler，在init之后调用
+    const DeleteHandler& delete_handler() const {
+        return _delete_handler;
+    }
+
     bool is_using_mmap() {
         return _is_using_mmap;
     }
@@ -260,6 +271,16 @@ private:
     OLAPStatus _load_to_vectorized_row_batch(
         VectorizedRowBatch* batch, size_t size);
 
+    // 加载已经生成了delete bitmap的删除条件对应的bitmap，并从_delete_handler中移除这些
+    // 删除条件，读取时不再对这些删除条件做block和行的过滤
+    void _load_delete_bitmaps();
+
+    // 根据delete bitmap过滤batch中被删除的行，first_row是batch第一行在segment中的行号
+    void _filter_deleted_rows(VectorizedRowBatch* batch, uint64_t first_row);
+
+    // [begin, end)之间的行是否都已经被delete bitmap标记为删除
+    bool _is_rows_deleted(uint64_t begin, uint64_t end) const;
+
 private:
     static const int32_t BYTE_STREAM_POSITIONS = 1;
     static const int32_t RUN_LENGTH_BYTE_POSITIONS = BYTE_STREAM_POSITIONS + 1;
@@ -281,6 +302,8 @@ private:
     const Conditions* _conditions;         // 列过滤条件
     DeleteHandler _delete_handler;
     DelCondSatisfied _delete_status;
+    // 已经标记了被删除行的delete bitmap
+    std::vector<std::shared_ptr<Bitmap>> _delete_bitmaps;
 
     bool _eof;                             // eof标志
 
@@ -45,7 +45,7 @@ SegmentWriter::~SegmentWriter() {
     }
 }
 
-OLAPStatus SegmentWriter::init(uint32_t write_mbytes_per_sec) {
+OLAPStatus SegmentWriter::init() {
     OLAPStatus res = OLAP_SUCCESS;
     // 创建factory
     _stream_factory = 
@@ -79,8 +79,6 @@ OLAPStatus SegmentWriter::init(uint32_t write_mbytes_per_sec) {
         }
     }
 
-    _write_mbytes_per_sec = write_mbytes_per_sec;
-
     return OLAP_SUCCESS;
 }
 
@@ -258,8 +256,7 @@ OLAPStatus SegmentWriter::finalize(uint32_t* segment_file_size) {
                     it->first.unique_column_id(),
                     it->first.kind());
 
-            res = stream->write_to_file(
-                    &file_handle, _write_mbytes_per_sec);
+            res = stream->write_to_file(&file_handle);
             if (OLAP_SUCCESS != res) {
                 OLAP_LOG_WARNING("fail to write stream to file. [res=%d]", res);
                 return res;
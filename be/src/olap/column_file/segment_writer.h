@@ -33,7 +33,7 @@ public:
             SmartOLAPTable table,
             uint32_t stream_buffer_size);
     ~SegmentWriter();
-    OLAPStatus init(uint32_t write_mbytes_per_sec);
+    OLAPStatus init();
     // 写入一行数据, 使用row_cursor读取每个列
     OLAPStatus write(RowCursor* row_cursor);
     // 记录index信息
@@ -59,9 +59,6 @@ private:
     uint64_t _row_in_block; // 当前block中的数据
     uint64_t _block_count;  // 已经写入的block个数
 
-    // write limit
-    uint32_t _write_mbytes_per_sec;
-
     DISALLOW_COPY_AND_ASSIGN(SegmentWriter);
 };
 
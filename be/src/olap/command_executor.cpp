@@ -26,6 +26,7 @@
 #include <sstream>
 #include <vector>
 
+#include <boost/filesystem.hpp>
 #include <boost/regex.hpp>
 #include <boost/scoped_array.hpp>
 #include <thrift/protocol/TDebugProtocol.h>
@@ -33,6 +34,7 @@
 #include "olap/base_compaction.h"
 #include "olap/delete_handler.h"
 #include "olap/field.h"
+#include "olap/io_governor.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/olap_engine.h"
@@ -214,6 +216,7 @@ OLAPStatus CommandExecutor::base_compaction(
         return OLAP_ERR_TABLE_NOT_FOUND;
     }
 
+    IOPriorityScope io_priority(IO_PRIORITY_BASE_COMPACTION);
     BaseCompaction base_compaction;
     res = base_compaction.init(table, true);
     if (res != OLAP_SUCCESS) {
@@ -530,6 +533,49 @@ OLAPStatus CommandExecutor::obtain_shard_path(
     return res;
 }
 
+OLAPStatus CommandExecutor::obtain_shard_path_for_clone(
+        SmartOLAPTable table, string* shard_path) {
+    OLAP_LOG_INFO("begin to process obtain shard path for clone. [table=%s]",
+                  table->full_name().c_str());
+    OLAPStatus res = OLAP_SUCCESS;
+
+    if (shard_path == NULL) {
+        OLAP_LOG_WARNING("invalid output parameter which is null pointer.");
+        return OLAP_ERR_CE_CMD_PARAMS_ERROR;
+    }
+
+    const string root_path = table->storage_root_path_name();
+    uint64_t shard = 0;
+    res = OLAPRootPath::get_instance()->get_root_path_shard(root_path, &shard);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to get root path shard. [res=%d]", res);
+        return res;
+    }
+
+    // header file is in shard/tablet_id/schema_hash/
+    boost::filesystem::path table_shard_path = boost::filesystem::path(
+            table->header_file_name()).parent_path().parent_path().parent_path();
+    stringstream root_path_stream;
+    root_path_stream << root_path << DATA_PREFIX << "/" << shard;
+    if (root_path_stream.str() == table_shard_path.string()) {
+        root_path_stream.str("");
+        root_path_stream << root_path << DATA_PREFIX << "/" << shard + 1;
+    }
+    *shard_path = root_path_stream.str();
+
+    if (!check_dir_existed(*shard_path)) {
+        res = create_dir(*shard_path);
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to create path. [path='%s']", shard_path->c_str());
+            return res;
+        }
+    }
+
+    OLAP_LOG_INFO("success to process obtain shard path for clone. [path='%s']",
+                  shard_path->c_str());
+    return res;
+}
+
 OLAPStatus CommandExecutor::load_header(
         const string& shard_path,
         const TCloneReq& request) {
@@ -135,6 +135,17 @@ public:
             TStorageMedium::type storage_medium,
             std::string* shared_path);
 
+    // Obtain shard path for cloning data of an existing tablet. It's on the
+    // same root path as the tablet so that its files can be hard linked,
+    // but not in the same shard.
+    //
+    // @param [in] table existing tablet
+    // @param [out] shard_path
+    // @return error code
+    virtual OLAPStatus obtain_shard_path_for_clone(
+            SmartOLAPTable table,
+            std::string* shard_path);
+
     // Load new tablet to make it effective.
     //
     // @param [in] root_path specify root path of new tablet
@@ -0,0 +1,419 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_merger.h"
+
+#include <set>
+
+#include "olap/field.h"
+#include "olap/i_data.h"
+#include "olap/row_block.h"
+#include "olap/writer.h"
+
+namespace palo {
+
+// Current row of one input data
+class CompactionMerger::ChildCtx {
+public:
+    ChildCtx(IData* data, RowBlock* block, const DeleteHandler* delete_handler)
+            : _data(data),
+            _version(data->version().second),
+            _delete_handler(delete_handler),
+            _row_block(block) {
+    }
+
+    OLAPStatus init(const std::vector<FieldInfo>& tablet_schema) {
+        OLAPStatus res = _row_cursor.init(tablet_schema);
+        if (res != OLAP_SUCCESS) {
+            LOG(WARNING) << "failed to init row cursor, res=" << res;
+            return res;
+        }
+        if (_row_block != nullptr && _seek_valid_row()) {
+            return OLAP_SUCCESS;
+        }
+        return next_block();
+    }
+
+    const RowCursor& current_row() const { return _row_cursor; }
+
+    int32_t version() const { return _version; }
+
+    bool eof() const { return _eof; }
+
+    int64_t num_filtered_rows() const { return _num_filtered_rows; }
+
+    // Move to next row in current row block, return false if there is
+    // no more row in it, then next_block() should be called.
+    bool next_in_block() {
+        _row_block->pos_inc();
+        return _seek_valid_row();
+    }
+
+    // Read next row block and move to its first row, eof() is true if
+    // there is no more row.
+    OLAPStatus next_block() {
+        while (true) {
+            OLAPStatus res = _data->get_next_block(&_row_block);
+            if (res == OLAP_ERR_DATA_EOF || (res == OLAP_SUCCESS && _row_block == nullptr)) {
+                _eof = true;
+                return OLAP_SUCCESS;
+            } else if (res != OLAP_SUCCESS) {
+                LOG(WARNING) << "failed to read next block, res=" << res;
+                return res;
+            }
+            if (_seek_valid_row()) {
+                return OLAP_SUCCESS;
+            }
+        }
+    }
+
+private:
+    // Skip rows deleted by delete conditions in current row block,
+    // return true if a valid row is found.
+    bool _seek_valid_row() {
+        while (_row_block->has_remaining()) {
+            _row_block->get_row(_row_block->pos(), &_row_cursor);
+            if (_row_block->block_status() == DEL_PARTIAL_SATISFIED
+                    && _delete_handler->is_filter_data(_version, _row_cursor)) {
+                _num_filtered_rows++;
+                _row_block->pos_inc();
+                continue;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    IData* _data;
+    int32_t _version;
+    const DeleteHandler* _delete_handler;
+    RowBlock* _row_block;
+    RowCursor _row_cursor;
+    bool _eof = false;
+    int64_t _num_filtered_rows = 0;
+};
+
+bool CompactionMerger::ChildLess::operator()(int a, int b) const {
+    const ChildCtx* first = (*_children)[a];
+    const ChildCtx* second = (*_children)[b];
+    int cmp_res = first->current_row().full_key_cmp(second->current_row());
+    if (cmp_res != 0) {
+        return cmp_res < 0;
+    }
+    // rows of lower version go first, so that newer value is aggregated later
+    return first->version() < second->version();
+}
+
+CompactionMerger::CompactionMerger(SmartOLAPTable table,
+                                   ReaderType type,
+                                   const Version& version)
+        : _table(table),
+        _reader_type(type),
+        _version(version),
+        _keys_type(table->keys_type()),
+        _tree(ChildLess(&_children)),
+        _writer(nullptr),
+        _uniq_keys(nullptr),
+        _group_key(nullptr),
+        _first_group_continued(false),
+        _open_row(nullptr),
+        _last_out_row(nullptr),
+        _row_count(0),
+        _merged_rows(0),
+        _filted_rows(0) {
+}
+
+CompactionMerger::~CompactionMerger() {
+    for (auto child : _children) {
+        delete child;
+    }
+    for (auto field : _fields) {
+        delete field;
+    }
+    _conditions.finalize();
+    _delete_handler.finalize();
+}
+
+bool CompactionMerger::is_supported(SmartOLAPTable table,
+                                    const std::vector<IData*>& olap_data_arr) {
+    // Rows of data with delete flag remove rows of the same key, which is
+    // only handled by Reader.
+    if (table->keys_type() == KeysType::UNIQUE_KEYS) {
+        for (auto data : olap_data_arr) {
+            if (!data->empty() && data->delete_flag()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+OLAPStatus CompactionMerger::init(const std::vector<IData*>& olap_data_arr) {
+    OLAPStatus res = OLAP_SUCCESS;
+    _conditions.set_table(_table);
+    if (_reader_type != READER_CUMULATIVE_COMPACTION) {
+        _table->obtain_header_rdlock();
+        res = _delete_handler.init(_table, _version.second);
+        _table->release_header_lock();
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to init delete handler. [res=%d]", res);
+            return res;
+        }
+    }
+
+    const std::vector<FieldInfo>& tablet_schema = _table->tablet_schema();
+    res = _out_row.init(tablet_schema);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init row cursor. [res=%d]", res);
+        return res;
+    }
+    std::vector<uint32_t> return_columns;
+    _fields.resize(tablet_schema.size(), nullptr);
+    for (uint32_t cid = 0; cid < tablet_schema.size(); ++cid) {
+        return_columns.push_back(cid);
+        if (tablet_schema[cid].is_key) {
+            _key_cids.push_back(cid);
+        } else {
+            _value_cids.push_back(cid);
+        }
+        _fields[cid] = Field::create(tablet_schema[cid]);
+        if (_fields[cid] == nullptr) {
+            OLAP_LOG_WARNING("fail to create field. [cid=%u]", cid);
+            return OLAP_ERR_INIT_FAILED;
+        }
+        _fields[cid]->set_offset(_out_row.get_field_by_index(cid)->get_offset());
+    }
+
+    std::set<uint32_t> load_bf_columns;
+    std::vector<RowCursor*> empty_keys;
+    for (auto data : olap_data_arr) {
+        if (data->empty()) {
+            continue;
+        }
+        data->set_delete_handler(_delete_handler);
+        data->set_read_params(return_columns, load_bf_columns, _conditions, _col_predicates,
+                              empty_keys, empty_keys, false, nullptr);
+        int ret = data->delete_pruning_filter();
+        if (ret == DEL_SATISFIED) {
+            _filted_rows += data->num_rows();
+            continue;
+        }
+        data->set_delete_status(ret == DEL_PARTIAL_SATISFIED
+                                ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
+
+        RowBlock* block = nullptr;
+        res = data->prepare_block_read(nullptr, false, nullptr, false, &block);
+        if (res == OLAP_ERR_DATA_EOF) {
+            continue;
+        } else if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to prepare block read. [version=%d-%d res=%d]",
+                             data->version().first, data->version().second, res);
+            return res;
+        }
+
+        std::unique_ptr<ChildCtx> child(new ChildCtx(data, block, &_delete_handler));
+        res = child->init(tablet_schema);
+        if (res != OLAP_SUCCESS) {
+            return res;
+        }
+        if (child->eof()) {
+            _filted_rows += child->num_filtered_rows();
+            continue;
+        }
+        _children.push_back(child.release());
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus CompactionMerger::merge(IWriter* writer, std::vector<uint64_t>* uniq_keys) {
+    _writer = writer;
+    _uniq_keys = uniq_keys;
+    _tree.init(_children.size());
+
+    OLAPStatus res = OLAP_SUCCESS;
+    while (!_tree.empty()) {
+        ChildCtx* child = _children[_tree.top()];
+        _add_row(child->current_row());
+        if (child->next_in_block()) {
+            _tree.update_top();
+            continue;
+        }
+
+        // Row block of child is reused when reading next block, so rows of
+        // current batch must be written before that.
+        res = _flush_batch(true);
+        if (res != OLAP_SUCCESS) {
+            return res;
+        }
+        res = child->next_block();
+        if (res != OLAP_SUCCESS) {
+            return res;
+        }
+        if (child->eof()) {
+            _tree.pop_top();
+        } else {
+            _tree.update_top();
+        }
+    }
+
+    res = _flush_batch(false);
+    if (res != OLAP_SUCCESS) {
+        return res;
+    }
+    for (auto child : _children) {
+        _filted_rows += child->num_filtered_rows();
+    }
+    return OLAP_SUCCESS;
+}
+
+void CompactionMerger::_add_row(const RowCursor& row) {
+    char* buf = row.get_buf();
+    if (_group_key != nullptr) {
+        if (_keys_type != KeysType::DUP_KEYS) {
+            bool equal = true;
+            for (auto cid : _key_cids) {
+                Field* field = _fields[cid];
+                if (!field->equal(field->get_field_ptr(_group_key), field->get_field_ptr(buf))) {
+                    equal = false;
+                    break;
+                }
+            }
+            if (equal) {
+                _rows.push_back(buf);
+                return;
+            }
+        }
+        // close last group
+        _group_ends.push_back(_rows.size());
+    }
+    _rows.push_back(buf);
+    _group_key = buf;
+}
+
+OLAPStatus CompactionMerger::_flush_batch(bool keep_last_open) {
+    if (_group_key == nullptr) {
+        return OLAP_SUCCESS;
+    }
+    // rows of DUP_KEYS table are never aggregated
+    keep_last_open = keep_last_open && _keys_type != KeysType::DUP_KEYS;
+    _group_ends.push_back(_rows.size());
+
+    size_t num_groups = _group_ends.size();
+    size_t num_new_groups = num_groups - (_first_group_continued ? 1 : 0);
+    _out_rows.clear();
+    size_t fill_begin = 0;
+    for (size_t i = 0; i < num_groups; ++i) {
+        if (i == 0 && _first_group_continued) {
+            _out_rows.push_back(_open_row);
+            continue;
+        }
+        char* first_row = _rows[i == 0 ? 0 : _group_ends[i - 1]];
+        if (_uniq_keys != nullptr) {
+            _update_uniq_keys(first_row);
+        }
+        // values of attached rows must be filled before they are flushed
+        if (_writer->is_block_full()) {
+            OLAPStatus res = _fill_values(fill_begin, i, false);
+            if (res != OLAP_SUCCESS) {
+                OLAP_LOG_WARNING("fail to finalize merged values. [table='%s' res=%d]",
+                                 _table->full_name().c_str(), res);
+                return res;
+            }
+            fill_begin = i;
+        }
+
+        OLAPStatus res = _writer->attached_by(&_out_row);
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("attach row failed. [table='%s' res=%d]",
+                             _table->full_name().c_str(), res);
+            return res;
+        }
+        _out_row.allocate_memory_for_string_type(_table->tablet_schema(), _writer->mem_pool());
+        char* out_row = _out_row.get_buf();
+        for (auto cid : _key_cids) {
+            Field* field = _fields[cid];
+            field->copy_without_pool(field->get_field_ptr(out_row), field->get_field_ptr(first_row));
+        }
+        _writer->next(_out_row);
+        _out_rows.push_back(out_row);
+        _last_out_row = out_row;
+        ++_row_count;
+    }
+    OLAPStatus res = _fill_values(fill_begin, num_groups, keep_last_open);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to finalize merged values. [table='%s' res=%d]",
+                         _table->full_name().c_str(), res);
+        return res;
+    }
+    _merged_rows += _rows.size() - num_new_groups;
+
+    _rows.clear();
+    _group_ends.clear();
+    if (keep_last_open) {
+        _open_row = _out_rows.back();
+        _group_key = _open_row;
+        _first_group_continued = true;
+    } else {
+        _open_row = nullptr;
+        _group_key = nullptr;
+        _first_group_continued = false;
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus CompactionMerger::_fill_values(size_t begin, size_t end, bool keep_last_open) {
+    bool need_finalize = _keys_type != KeysType::DUP_KEYS;
+    for (auto cid : _value_cids) {
+        Field* field = _fields[cid];
+        for (size_t i = begin; i < end; ++i) {
+            char* dest = field->get_field_ptr(_out_rows[i]);
+            size_t pos = (i == 0 ? 0 : _group_ends[i - 1]);
+            size_t group_end = _group_ends[i];
+            if (i != 0 || !_first_group_continued) {
+                field->agg_init(dest, field->get_field_ptr(_rows[pos]));
+                ++pos;
+            }
+            for (; pos < group_end; ++pos) {
+                field->aggregate(dest, field->get_field_ptr(_rows[pos]));
+            }
+            if (need_finalize && !(keep_last_open && i + 1 == end)) {
+                OLAPStatus res = field->finalize(field->get_ptr(_out_rows[i]));
+                if (res != OLAP_SUCCESS) {
+                    return res;
+                }
+            }
+        }
+    }
+    return OLAP_SUCCESS;
+}
+
+void CompactionMerger::_update_uniq_keys(char* row) {
+    if (_last_out_row == nullptr) {
+        return;
+    }
+    size_t first_diff_id = _key_cids.size();
+    for (size_t i = 0; i < _key_cids.size(); ++i) {
+        Field* field = _fields[_key_cids[i]];
+        if (0 != field->cmp(field->get_field_ptr(_last_out_row), field->get_field_ptr(row))) {
+            first_diff_id = i;
+            break;
+        }
+    }
+    for (size_t i = first_diff_id; i < _uniq_keys->size(); ++i) {
+        ++(*_uniq_keys)[i];
+    }
+}
+
+}
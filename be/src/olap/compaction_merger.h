@@ -0,0 +1,137 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "olap/delete_handler.h"
+#include "olap/loser_tree.h"
+#include "olap/olap_cond.h"
+#include "olap/olap_define.h"
+#include "olap/olap_table.h"
+#include "olap/row_cursor.h"
+
+namespace palo {
+
+class Field;
+class IData;
+class IWriter;
+class RowBlock;
+
+// CompactionMerger merges rows of multiple data into a writer for base and
+// cumulative compaction, without going through the query path of Reader.
+//
+// Rows are merged in batches. Keys of input row blocks are merged with a
+// loser tree, which gives the output order of input rows and groups of
+// rows with the same key. Then each output row is attached in writer and
+// its key columns are copied, after that value columns are aggregated one
+// column at a time for all groups of the batch.
+//
+// A batch ends when some input needs to read its next row block, because
+// the row block is reused. The last group of the batch may continue in the
+// next batch, so it is kept open in writer until a different key comes.
+class CompactionMerger {
+public:
+    CompactionMerger(SmartOLAPTable table, ReaderType type, const Version& version);
+    ~CompactionMerger();
+
+    // Return false if data can not be merged by this merger, caller should
+    // use Reader instead.
+    static bool is_supported(SmartOLAPTable table, const std::vector<IData*>& olap_data_arr);
+
+    OLAPStatus init(const std::vector<IData*>& olap_data_arr);
+
+    // Write all merged rows into writer, writer is not finalized.
+    // If 'uniq_keys' is not null, number of unique values of each key prefix
+    // is accumulated into it.
+    OLAPStatus merge(IWriter* writer, std::vector<uint64_t>* uniq_keys);
+
+    uint64_t row_count() const { return _row_count; }
+    uint64_t merged_rows() const { return _merged_rows; }
+    uint64_t filted_rows() const { return _filted_rows; }
+
+private:
+    class ChildCtx;
+
+    // Compare current rows of two children
+    class ChildLess {
+    public:
+        ChildLess(std::vector<ChildCtx*>* children) : _children(children) { }
+        bool operator()(int a, int b) const;
+    private:
+        std::vector<ChildCtx*>* _children;
+    };
+
+    // Add current row of child into current batch
+    void _add_row(const RowCursor& row);
+
+    // Write all groups of current batch into writer. If 'keep_last_open' is
+    // true, the last group is not finalized, more rows can be added into it.
+    OLAPStatus _flush_batch(bool keep_last_open);
+
+    // Aggregate value columns of groups in [begin, end) of current batch
+    OLAPStatus _fill_values(size_t begin, size_t end, bool keep_last_open);
+
+    // Count unique key prefixes between 'row' and last output row
+    void _update_uniq_keys(char* row);
+
+    SmartOLAPTable _table;
+    ReaderType _reader_type;
+    Version _version;
+    KeysType _keys_type;
+
+    DeleteHandler _delete_handler;
+    Conditions _conditions;
+    std::vector<ColumnPredicate*> _col_predicates;
+
+    std::vector<uint32_t> _key_cids;
+    std::vector<uint32_t> _value_cids;
+    // fields used to access columns of rows in input and output blocks,
+    // indexed by column id
+    std::vector<Field*> _fields;
+
+    std::vector<ChildCtx*> _children;
+    LoserTree<ChildLess> _tree;
+
+    IWriter* _writer;
+    std::vector<uint64_t>* _uniq_keys;
+    // cursor to attach rows in writer
+    RowCursor _out_row;
+
+    // Rows of current batch in output order
+    std::vector<char*> _rows;
+    // End position in _rows of each closed group
+    std::vector<size_t> _group_ends;
+    // Output row of each group
+    std::vector<char*> _out_rows;
+    // Key of the last group, nullptr if there is no group
+    char* _group_key;
+    // The first group continues the last group of previous batch,
+    // whose output row is _open_row
+    bool _first_group_continued;
+    char* _open_row;
+    // Output row written before current row, nullptr if there is no one
+    char* _last_out_row;
+
+    uint64_t _row_count;
+    uint64_t _merged_rows;
+    uint64_t _filted_rows;
+
+    DISALLOW_COPY_AND_ASSIGN(CompactionMerger);
+};
+
+}
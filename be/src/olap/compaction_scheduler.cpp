@@ -0,0 +1,276 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_scheduler.h"
+
+#include <unistd.h>
+
+#include <ctime>
+
+#include <gperftools/profiler.h>
+
+#include "agent/cgroups_mgr.h"
+#include "common/config.h"
+#include "olap/base_compaction.h"
+#include "olap/cumulative_compaction.h"
+#include "olap/io_governor.h"
+#include "olap/olap_engine.h"
+
+namespace palo {
+
+// Base compaction time window and failed tasks cleared by rescan thread
+// change without notify, so waiting workers check the queue periodically.
+static const uint32_t TAKE_TASK_WAIT_SECONDS = 5;
+
+CompactionScheduler::CompactionScheduler() :
+        _cond(_mutex),
+        _rescan_cond(_mutex),
+        _stopped(false),
+        _queue(config::compaction_task_num_per_disk, config::compaction_running_bytes_budget) {
+}
+
+CompactionScheduler::~CompactionScheduler() {
+}
+
+OLAPStatus CompactionScheduler::start() {
+    int32_t num_threads = config::compaction_num_threads;
+    if (num_threads <= 0) {
+        OLAP_LOG_WARNING("compaction thread number config is illegal: [%d], "
+                         "force set to 1", num_threads);
+        num_threads = 1;
+    }
+    _worker_threads.resize(num_threads);
+    for (uint32_t i = 0; i < num_threads; ++i) {
+        if (0 != pthread_create(&_worker_threads[i], NULL, _worker_thread_callback, this)) {
+            OLAP_LOG_FATAL("failed to start compaction thread. [id=%u]", i);
+            return OLAP_ERR_INIT_FAILED;
+        }
+    }
+
+    if (0 != pthread_create(&_rescan_thread, NULL, _rescan_thread_callback, this)) {
+        OLAP_LOG_FATAL("failed to start compaction rescan thread.");
+        return OLAP_ERR_INIT_FAILED;
+    }
+    return OLAP_SUCCESS;
+}
+
+void CompactionScheduler::stop() {
+    {
+        AutoMutexLock l(&_mutex);
+        if (_stopped) {
+            return;
+        }
+        _stopped = true;
+        _cond.notify_all();
+        _rescan_cond.notify_all();
+    }
+
+    for (pthread_t thread : _worker_threads) {
+        pthread_join(thread, NULL);
+    }
+    _worker_threads.clear();
+    pthread_join(_rescan_thread, NULL);
+}
+
+void CompactionScheduler::update_score(SmartOLAPTable table) {
+    if (!table->is_loaded()) {
+        return;
+    }
+
+    CompactionTask cumulative_task;
+    cumulative_task.type = CUMULATIVE_COMPACTION;
+    cumulative_task.tablet_id = table->tablet_id();
+    cumulative_task.schema_hash = table->schema_hash();
+    cumulative_task.data_size = 0;
+    CompactionTask base_task = cumulative_task;
+    base_task.type = BASE_COMPACTION;
+    base_task.score = 0;
+
+    table->obtain_header_rdlock();
+    // number of deltas after cumulative layer point, 0 if it's less than
+    // cumulative_compaction_num_singleton_deltas
+    cumulative_task.score = table->get_compaction_nice_estimate();
+    // number of cumulative deltas before cumulative layer point
+    const int32_t point = table->cumulative_layer_point();
+    for (int i = 0; i < table->file_version_size(); ++i) {
+        const FileVersionMessage& version = table->file_version(i);
+        if (version.start_version() >= point) {
+            cumulative_task.data_size += version.data_size();
+        } else {
+            if (version.start_version() != 0) {
+                ++base_task.score;
+            }
+            base_task.data_size += version.data_size();
+        }
+    }
+    table->release_header_lock();
+
+    std::string root_path = table->storage_root_path_name();
+    if (cumulative_task.score > 0) {
+        _add_task(root_path, cumulative_task);
+    }
+    // base compaction needs at least two cumulative deltas, other policies
+    // are checked when it runs. Time window is checked again when it's picked.
+    if (base_task.score >= 2 && _is_base_compaction_allowed()) {
+        _add_task(root_path, base_task);
+    }
+}
+
+bool CompactionScheduler::_is_base_compaction_allowed() {
+    uint64_t base_compaction_start_hour = config::base_compaction_start_hour;
+    uint64_t base_compaction_end_hour = config::base_compaction_end_hour;
+    time_t current_time = time(NULL);
+    uint64_t current_hour = localtime(&current_time)->tm_hour;
+    // 如果执行BE的时间区间设置为类似以下的形式：[1:00, 8:00)
+    if (base_compaction_start_hour <= base_compaction_end_hour) {
+        return current_hour >= base_compaction_start_hour
+            && current_hour < base_compaction_end_hour;
+    }
+    // 如果执行BE的时间区间设置为类似以下的形式：[22:00, 8:00)
+    return current_hour >= base_compaction_start_hour
+        || current_hour < base_compaction_end_hour;
+}
+
+void CompactionScheduler::_add_task(const std::string& root_path, const CompactionTask& task) {
+    AutoMutexLock l(&_mutex);
+    if (_queue.add(root_path, task)) {
+        _cond.notify();
+    }
+}
+
+bool CompactionScheduler::_take_task(CompactionTask* task, std::string* root_path) {
+    AutoMutexLock l(&_mutex);
+    while (!_stopped) {
+        if (_queue.pick(_is_base_compaction_allowed(), task, root_path)) {
+            return true;
+        }
+        _cond.wait_for_seconds(TAKE_TASK_WAIT_SECONDS);
+    }
+    return false;
+}
+
+void CompactionScheduler::_finish_task(const CompactionTask& task,
+                                       const std::string& root_path,
+                                       bool success) {
+    AutoMutexLock l(&_mutex);
+    _queue.finish(task, root_path, success);
+    _cond.notify_all();
+}
+
+bool CompactionScheduler::_run_task(const CompactionTask& task) {
+    SmartOLAPTable table = OLAPEngine::get_instance()->get_table(
+        task.tablet_id, task.schema_hash);
+    if (table.get() == NULL) {
+        return false;
+    }
+
+    // 跳过正在做schema change的tablet
+    if (!OLAPEngine::get_instance()->can_do_compaction(table)) {
+        OLAP_LOG_DEBUG("skip tablet, it is schema changing. [tablet=%s]",
+                       table->full_name().c_str());
+        return false;
+    }
+
+    if (task.type == CUMULATIVE_COMPACTION) {
+        IOPriorityScope io_priority(IO_PRIORITY_CUMULATIVE_COMPACTION);
+        CumulativeCompaction cumulative_compaction;
+        if (cumulative_compaction.init(table) != OLAP_SUCCESS) {
+            return false;
+        }
+        if (cumulative_compaction.run() != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("failed to do cumulative. [tablet='%s']",
+                             table->full_name().c_str());
+            return false;
+        }
+    } else {
+        IOPriorityScope io_priority(IO_PRIORITY_BASE_COMPACTION);
+        BaseCompaction base_compaction;
+        if (base_compaction.init(table, false) != OLAP_SUCCESS) {
+            return false;
+        }
+        OLAP_LOG_NOTICE_PUSH("request", "START_BASE_COMPACTION");
+        if (base_compaction.run() != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("failed to do base compaction. [tablet='%s']",
+                             table->full_name().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void* CompactionScheduler::_worker_thread_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    CompactionScheduler* scheduler = static_cast<CompactionScheduler*>(arg);
+    while (true) {
+        CompactionTask task;
+        std::string root_path;
+        if (!scheduler->_take_task(&task, &root_path)) {
+            break;
+        }
+
+        // must be here, because this thread is start on start and
+        // cgroup is not initialized at this time
+        // add tid to cgroup
+        CgroupsMgr::apply_system_cgroup();
+        bool success = scheduler->_run_task(task);
+        scheduler->_finish_task(task, root_path, success);
+
+        // versions are changed by compaction, other compaction may be needed
+        SmartOLAPTable table = OLAPEngine::get_instance()->get_table(
+            task.tablet_id, task.schema_hash);
+        if (table.get() != NULL) {
+            scheduler->update_score(table);
+        }
+    }
+
+    return NULL;
+}
+
+void* CompactionScheduler::_rescan_thread_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    uint32_t interval = config::base_compaction_check_interval_seconds;
+    if (interval <= 0) {
+        OLAP_LOG_WARNING("base compaction check interval config is illegal: [%d], "
+                         "force set to 1", interval);
+        interval = 1;
+    }
+
+    CompactionScheduler* scheduler = static_cast<CompactionScheduler*>(arg);
+    while (true) {
+        {
+            // give tasks not done last time another chance
+            AutoMutexLock l(&scheduler->_mutex);
+            if (scheduler->_stopped) {
+                break;
+            }
+            scheduler->_queue.clear_failed();
+        }
+        OLAPEngine::get_instance()->update_compaction_scores();
+
+        AutoMutexLock l(&scheduler->_mutex);
+        if (scheduler->_stopped) {
+            break;
+        }
+        scheduler->_rescan_cond.wait_for_seconds(interval);
+    }
+
+    return NULL;
+}
+
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+
+#include "olap/compaction_task_queue.h"
+#include "olap/olap_define.h"
+#include "olap/olap_table.h"
+#include "olap/utils.h"
+
+namespace palo {
+
+// CompactionScheduler schedules base and cumulative compactions of all tablets.
+//
+// Each tablet gets compaction scores when its versions change, which are
+// number of deltas to merge. Tablets whose score reaches the threshold are
+// put into the priority queue of their data directory immediately, and
+// a shared pool of workers runs tasks of the highest score, limited by
+// number of running tasks of each data directory and total size of data
+// being merged.
+// All tablets are also rescanned periodically, in case some are missed.
+class CompactionScheduler {
+    DECLARE_SINGLETON(CompactionScheduler);
+public:
+    // Start worker threads and rescan thread
+    OLAPStatus start();
+
+    // Stop taking new tasks and wait for worker threads and rescan thread
+    // to exit. Running tasks are not interrupted.
+    void stop();
+
+    // Compute compaction scores of table and schedule compactions if needed.
+    // Called whenever versions of table are changed.
+    void update_score(SmartOLAPTable table);
+
+private:
+    static void* _worker_thread_callback(void* arg);
+    static void* _rescan_thread_callback(void* arg);
+
+    static bool _is_base_compaction_allowed();
+
+    void _add_task(const std::string& root_path, const CompactionTask& task);
+
+    // Wait until a task can be run, return false if scheduler is stopped
+    bool _take_task(CompactionTask* task, std::string* root_path);
+    void _finish_task(const CompactionTask& task, const std::string& root_path, bool success);
+
+    // Return false if compaction is not done
+    bool _run_task(const CompactionTask& task);
+
+    MutexLock _mutex;
+    Condition _cond;
+    // Wakes up rescan thread before interval expires when stopped
+    Condition _rescan_cond;
+    bool _stopped;
+
+    CompactionTaskQueue _queue;
+
+    std::vector<pthread_t> _worker_threads;
+    pthread_t _rescan_thread;
+
+    DISALLOW_COPY_AND_ASSIGN(CompactionScheduler);
+};
+
+}
@@ -0,0 +1,145 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_task_queue.h"
+
+namespace palo {
+
+CompactionTaskQueue::CompactionTaskQueue(int32_t task_num_per_disk,
+                                         int64_t running_bytes_budget) :
+        _task_num_per_disk(task_num_per_disk),
+        _running_bytes_budget(running_bytes_budget),
+        _running_data_size(0) {
+}
+
+bool CompactionTaskQueue::add(const std::string& root_path, const CompactionTask& task) {
+    TaskKey key = _key(task);
+    // it will be scored again when it's finished
+    if (_running_tasks.find(key) != _running_tasks.end()) {
+        return false;
+    }
+    auto it = _queued_tasks.find(key);
+    if (it != _queued_tasks.end() && it->second == task.score) {
+        return false;
+    }
+    auto failed = _failed_tasks.find(key);
+    if (failed != _failed_tasks.end()) {
+        if (failed->second == task.score) {
+            return false;
+        }
+        _failed_tasks.erase(failed);
+    }
+    _queued_tasks[key] = task.score;
+    DiskQueue& queue = _disk_queues[root_path];
+    queue.tasks.push(task);
+    // Stale tasks are skipped when they reach the top, remove them when
+    // they are more than half of the queue, so that it doesn't grow when
+    // scores keep changing.
+    if (queue.tasks.size() > 2 * _queued_tasks.size()) {
+        _remove_stale_tasks(&queue);
+    }
+    return true;
+}
+
+bool CompactionTaskQueue::pick(bool base_compaction_allowed,
+                               CompactionTask* task, std::string* root_path) {
+    CompactionTaskLess task_less;
+    std::map<std::string, DiskQueue>::iterator best = _disk_queues.end();
+    for (auto it = _disk_queues.begin(); it != _disk_queues.end(); ++it) {
+        DiskQueue& queue = it->second;
+        while (!queue.tasks.empty()) {
+            const CompactionTask& top = queue.tasks.top();
+            if (_is_stale(top)) {
+                queue.tasks.pop();
+                continue;
+            }
+            // the time window may have passed since it's queued
+            if (top.type == BASE_COMPACTION && !base_compaction_allowed) {
+                _queued_tasks.erase(_key(top));
+                queue.tasks.pop();
+                continue;
+            }
+            break;
+        }
+        if (queue.tasks.empty() || queue.running >= _task_num_per_disk) {
+            continue;
+        }
+        if (best == _disk_queues.end() || task_less(best->second.tasks.top(), queue.tasks.top())) {
+            best = it;
+        }
+    }
+    if (best == _disk_queues.end()) {
+        return false;
+    }
+
+    // A task is always allowed if nothing is running, so that large
+    // tablets can still be compacted.
+    const CompactionTask& top = best->second.tasks.top();
+    if (!_running_tasks.empty()
+            && _running_data_size + top.data_size > _running_bytes_budget) {
+        return false;
+    }
+
+    *task = top;
+    *root_path = best->first;
+    best->second.tasks.pop();
+    best->second.running++;
+    TaskKey key = _key(*task);
+    _queued_tasks.erase(key);
+    _running_tasks.insert(key);
+    _running_data_size += task->data_size;
+    return true;
+}
+
+void CompactionTaskQueue::finish(const CompactionTask& task,
+                                 const std::string& root_path,
+                                 bool success) {
+    TaskKey key = _key(task);
+    _disk_queues[root_path].running--;
+    _running_tasks.erase(key);
+    _running_data_size -= task.data_size;
+    if (!success) {
+        _failed_tasks[key] = task.score;
+    }
+}
+
+size_t CompactionTaskQueue::queue_size(const std::string& root_path) const {
+    auto it = _disk_queues.find(root_path);
+    if (it == _disk_queues.end()) {
+        return 0;
+    }
+    return it->second.tasks.size();
+}
+
+bool CompactionTaskQueue::_is_stale(const CompactionTask& task) const {
+    auto queued = _queued_tasks.find(_key(task));
+    return queued == _queued_tasks.end() || queued->second != task.score;
+}
+
+void CompactionTaskQueue::_remove_stale_tasks(DiskQueue* queue) {
+    std::vector<CompactionTask> tasks;
+    std::set<TaskKey> keys;
+    while (!queue->tasks.empty()) {
+        const CompactionTask& task = queue->tasks.top();
+        // task may be added again after its score changed back
+        if (!_is_stale(task) && keys.insert(_key(task)).second) {
+            tasks.push_back(task);
+        }
+        queue->tasks.pop();
+    }
+    queue->tasks = TaskHeap(CompactionTaskLess(), std::move(tasks));
+}
+
+}
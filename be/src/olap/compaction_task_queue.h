@@ -0,0 +1,121 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <map>
+#include <queue>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "olap/olap_common.h"
+
+namespace palo {
+
+enum CompactionType {
+    CUMULATIVE_COMPACTION = 0,
+    BASE_COMPACTION = 1,
+};
+
+struct CompactionTask {
+    CompactionType type;
+    TTabletId tablet_id;
+    SchemaHash schema_hash;
+    uint32_t score;
+    // size of data to merge
+    int64_t data_size;
+};
+
+// Queues of compaction tasks of all data directories, and tasks which are
+// running. It's not thread safe, CompactionScheduler locks it.
+class CompactionTaskQueue {
+public:
+    CompactionTaskQueue(int32_t task_num_per_disk, int64_t running_bytes_budget);
+
+    // Return false if task is running, or it's queued or failed with the
+    // same score.
+    bool add(const std::string& root_path, const CompactionTask& task);
+
+    // Pick task of the highest score which is allowed to run. Base
+    // compactions which are not allowed are dropped from queues, they are
+    // added again by next rescan.
+    // Return false if no task can be run now.
+    bool pick(bool base_compaction_allowed, CompactionTask* task, std::string* root_path);
+
+    void finish(const CompactionTask& task, const std::string& root_path, bool success);
+
+    // Give failed tasks another chance
+    void clear_failed() {
+        _failed_tasks.clear();
+    }
+
+    size_t num_queued() const {
+        return _queued_tasks.size();
+    }
+    size_t num_running() const {
+        return _running_tasks.size();
+    }
+    // Number of tasks in queue of data directory, including stale ones
+    size_t queue_size(const std::string& root_path) const;
+
+private:
+    // Task of higher score is run first, cumulative compaction goes before
+    // base compaction of the same score.
+    struct CompactionTaskLess {
+        bool operator()(const CompactionTask& a, const CompactionTask& b) const {
+            if (a.score != b.score) {
+                return a.score < b.score;
+            }
+            return a.type > b.type;
+        }
+    };
+
+    typedef std::priority_queue<CompactionTask, std::vector<CompactionTask>,
+                                CompactionTaskLess> TaskHeap;
+
+    struct DiskQueue {
+        DiskQueue() : running(0) { }
+        TaskHeap tasks;
+        uint32_t running;
+    };
+
+    typedef std::tuple<CompactionType, TTabletId, SchemaHash> TaskKey;
+
+    static TaskKey _key(const CompactionTask& task) {
+        return TaskKey(task.type, task.tablet_id, task.schema_hash);
+    }
+
+    // Task is stale if its score has been changed or it has been picked
+    bool _is_stale(const CompactionTask& task) const;
+    void _remove_stale_tasks(DiskQueue* queue);
+
+    int32_t _task_num_per_disk;
+    int64_t _running_bytes_budget;
+
+    // queue of each data directory, key is root path
+    std::map<std::string, DiskQueue> _disk_queues;
+    // score of tasks in queues. Queues are not updated when score changes,
+    // so tasks whose score is different from here are stale.
+    std::map<TaskKey, uint32_t> _queued_tasks;
+    std::set<TaskKey> _running_tasks;
+    // score of tasks which are not done last time, they are not scheduled
+    // again until score changes or next rescan
+    std::map<TaskKey, uint32_t> _failed_tasks;
+    int64_t _running_data_size;
+};
+
+}
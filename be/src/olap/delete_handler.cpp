@@ -15,7 +15,9 @@
 
 #include "olap/delete_handler.h"
 
+#include <algorithm>
 #include <limits>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -25,8 +27,13 @@
 #include <thrift/protocol/TDebugProtocol.h>
 
 #include "gen_cpp/olap_file.pb.h"
+#include "olap/column_file/segment_reader.h"
+#include "olap/i_data.h"
 #include "olap/olap_common.h"
+#include "olap/olap_index.h"
+#include "olap/row_block.h"
 #include "olap/utils.h"
+#include "runtime/vectorized_row_batch.h"
 
 using apache::thrift::ThriftDebugString;
 using std::numeric_limits;
@@ -77,6 +84,8 @@ OLAPStatus DeleteConditionHandler::store_cond(
         del_cond = table->mutable_delete_data_conditions(cond_index);
         del_cond->clear_sub_conditions();
     }
+    // 之前生成的delete bitmap可能属于被覆盖的删除条件，需要重新生成
+    del_cond->set_use_delete_bitmap(false);
 
     // 存储删除条件
     for (const TCondition& condition : conditions) {
@@ -151,6 +160,162 @@ OLAPStatus DeleteConditionHandler::delete_cond(SmartOLAPTable table,
     return OLAP_SUCCESS;
 }
 
+OLAPStatus DeleteConditionHandler::build_delete_bitmaps(SmartOLAPTable table,
+                                                        const int32_t version) {
+    if (table->data_file_type() != COLUMN_ORIENTED_FILE) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    // 获取删除条件和在它之前的所有版本，之后的读取不需要持有Header锁
+    DeleteHandler delete_handler;
+    vector<Version> versions;
+    vector<IData*> data_sources;
+    table->obtain_header_rdlock();
+    OLAPStatus res = delete_handler.init(table, version);
+    if (res == OLAP_SUCCESS) {
+        vector<Version> all_versions;
+        table->list_versions(&all_versions);
+        for (const Version& data_version : all_versions) {
+            if (data_version.second < version) {
+                versions.push_back(data_version);
+            }
+        }
+        table->acquire_data_sources_by_versions(versions, &data_sources);
+    }
+    table->release_header_lock();
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init delete handler. [res=%d table='%s' version=%d]",
+                         res, table->full_name().c_str(), version);
+        return res;
+    }
+
+    const Conditions* del_cond = NULL;
+    for (const DeleteConditions& cond : delete_handler.get_delete_conditions()) {
+        if (cond.filter_version == version) {
+            del_cond = cond.del_cond;
+        }
+    }
+    if (del_cond == NULL) {
+        OLAP_LOG_WARNING("delete condition is not found. [table='%s' version=%d]",
+                         table->full_name().c_str(), version);
+        res = OLAP_ERR_DELETE_INVALID_VERSION;
+    } else if (data_sources.size() != versions.size()) {
+        OLAP_LOG_WARNING("fail to acquire data sources. [table='%s' version=%d]",
+                         table->full_name().c_str(), version);
+        res = OLAP_ERR_BE_ACQUIRE_DATA_SOURCES_ERROR;
+    }
+
+    for (size_t i = 0; res == OLAP_SUCCESS && i < data_sources.size(); ++i) {
+        OLAPIndex* olap_index = data_sources[i]->olap_index();
+        for (uint32_t seg = 0; seg < olap_index->num_segments(); ++seg) {
+            std::shared_ptr<Bitmap> bitmap;
+            res = _build_segment_delete_bitmap(table, olap_index, seg, *del_cond, &bitmap);
+            if (res != OLAP_SUCCESS) {
+                break;
+            }
+            res = olap_index->add_delete_bitmap(seg, version, bitmap);
+            if (res != OLAP_SUCCESS) {
+                OLAP_LOG_WARNING("fail to save delete bitmap. [res=%d table='%s' segment=%u]",
+                                 res, table->full_name().c_str(), seg);
+                break;
+            }
+        }
+    }
+
+    table->release_data_sources(&data_sources);
+    delete_handler.finalize();
+    return res;
+}
+
+OLAPStatus DeleteConditionHandler::_build_segment_delete_bitmap(SmartOLAPTable table,
+                                                                OLAPIndex* olap_index,
+                                                                uint32_t segment,
+                                                                const Conditions& del_cond,
+                                                                std::shared_ptr<Bitmap>* bitmap) {
+    vector<uint32_t> columns;
+    for (const auto& it : del_cond.columns()) {
+        columns.push_back(it.first);
+    }
+    std::set<uint32_t> load_bf_columns;
+    OlapReaderStatistics stats;
+    string file_name = table->construct_data_file_path(
+            olap_index->version(), olap_index->version_hash(), segment);
+    column_file::SegmentReader reader(file_name, table.get(), olap_index, segment,
+                                      columns, load_bf_columns, NULL, NULL,
+                                      DeleteHandler(), DEL_NOT_SATISFIED, NULL, &stats);
+    OLAPStatus res = reader.init(false);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init segment reader. [res=%d file='%s']",
+                         res, file_name.c_str());
+        return res;
+    }
+
+    bitmap->reset(new Bitmap(reader.num_rows()));
+    if (reader.block_count() == 0) {
+        return OLAP_SUCCESS;
+    }
+
+    uint32_t next_block_id = 0;
+    bool eof = false;
+    res = reader.seek_to_block(0, reader.block_count() - 1, true, &next_block_id, &eof);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to seek to block. [res=%d file='%s']", res, file_name.c_str());
+        return res;
+    }
+
+    VectorizedRowBatch batch(table->tablet_schema(), columns, reader.num_rows_in_block());
+    RowBlock row_block(table->tablet_schema());
+    RowBlockInfo block_info;
+    block_info.row_num = reader.num_rows_in_block();
+    block_info.null_supported = true;
+    row_block.init(block_info);
+    RowCursor cursor;
+    res = cursor.init(table->tablet_schema());
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init row cursor. [res=%d]", res);
+        return res;
+    }
+
+    // 读取时不过滤任何block，行号就是在segment中的位置
+    uint64_t row_id = 0;
+    while (!eof) {
+        batch.clear();
+        res = reader.get_block(&batch, &next_block_id, &eof);
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to read block. [res=%d file='%s']", res, file_name.c_str());
+            return res;
+        }
+        row_block.clear();
+        batch.dump_to_row_block(&row_block);
+        for (uint32_t i = 0; i < row_block.row_block_info().row_num; ++i, ++row_id) {
+            row_block.get_row(i, &cursor);
+            if (del_cond.delete_conditions_eval(cursor)) {
+                (*bitmap)->Set(row_id, true);
+            }
+        }
+    }
+
+    if (row_id != reader.num_rows()) {
+        OLAP_LOG_WARNING("number of rows read is wrong. [file='%s' read=%lu expected=%lu]",
+                         file_name.c_str(), row_id, reader.num_rows());
+        return OLAP_ERR_CHECK_LINES_ERROR;
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus DeleteConditionHandler::mark_delete_bitmap(SmartOLAPTable table,
+                                                      const int32_t version) {
+    int cond_index = _check_whether_condition_exist(table, version);
+    if (cond_index == -1) {
+        OLAP_LOG_WARNING("delete condition is not found. [table='%s' version=%d]",
+                         table->full_name().c_str(), version);
+        return OLAP_ERR_DELETE_INVALID_VERSION;
+    }
+
+    table->mutable_delete_data_conditions(cond_index)->set_use_delete_bitmap(true);
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus DeleteConditionHandler::log_conds(SmartOLAPTable table) {
     OLAP_LOG_INFO("display all delete condition. [full_name=%s]",
                   table->full_name().c_str());
@@ -297,7 +462,7 @@ int DeleteConditionHandler::_check_whether_condition_exist(SmartOLAPTable table,
     return -1;
 }
 
-bool DeleteHandler::_parse_condition(const std::string& condition_str, TCondition* condition) {
+bool DeleteHandler::parse_condition(const std::string& condition_str, TCondition* condition) {
     bool matched = true;
     smatch what;
 
@@ -357,6 +522,7 @@ OLAPStatus DeleteHandler::init(SmartOLAPTable olap_table, int32_t version) {
 
         DeleteConditions temp;
         temp.filter_version = it->version();
+        temp.use_delete_bitmap = it->use_delete_bitmap();
 
         temp.del_cond = new(std::nothrow) Conditions();
 
@@ -369,7 +535,7 @@ OLAPStatus DeleteHandler::init(SmartOLAPTable olap_table, int32_t version) {
 
         for (int i = 0; i != it->sub_conditions_size(); ++i) {
             TCondition condition;
-            if (!_parse_condition(it->sub_conditions(i), &condition)) {
+            if (!parse_condition(it->sub_conditions(i), &condition)) {
                 OLAP_LOG_WARNING("fail to parse condition. [condition=%s]",
                                  it->sub_conditions(i).c_str());
                 return OLAP_ERR_DELETE_INVALID_PARAMETERS;
@@ -409,6 +575,19 @@ bool DeleteHandler::is_filter_data(const int32_t data_version,
     return false;
 }
 
+void DeleteHandler::remove_conditions(const vector<int32_t>& filter_versions) {
+    vector<DeleteConditions>::iterator it = _del_conds.begin();
+
+    while (it != _del_conds.end()) {
+        if (std::find(filter_versions.begin(), filter_versions.end(), it->filter_version)
+                != filter_versions.end()) {
+            it = _del_conds.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 vector<int32_t> DeleteHandler::get_conds_version() {
     vector<int32_t> conds_version;
     vector<DeleteConditions>::const_iterator cond_iter = _del_conds.begin();
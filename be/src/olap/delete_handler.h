@@ -16,6 +16,7 @@
 #ifndef BDG_PALO_BE_SRC_OLAP_DELETE_HANDLER_H
 #define BDG_PALO_BE_SRC_OLAP_DELETE_HANDLER_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,9 +27,12 @@
 #include "olap/olap_define.h"
 #include "olap/olap_table.h"
 #include "olap/row_cursor.h"
+#include "util/bitmap.h"
 
 namespace palo {
 
+class OLAPIndex;
+
 // 实现了删除条件的存储，移除和显示功能
 // *  存储删除条件：
 //    OLAPStatus res;
@@ -83,6 +87,22 @@ public:
     OLAPStatus delete_cond(
             SmartOLAPTable table, const int32_t version, bool delete_smaller_version_conditions);
 
+    // 将指定版本号的删除条件应用到之前的所有版本上，在每个segment的delete bitmap中标记被删除
+    // 的行。读取数据时，使用delete bitmap过滤这些行，不再对每一行计算这个删除条件。
+    // 调用之前不能对Header文件加锁，因为需要读取之前版本的所有数据，这可能需要很长时间
+    //
+    // 输入参数：
+    //     * table：删除条件所在的olap engine表
+    //     * version：删除条件的版本
+    // 返回值：
+    //     * OLAP_SUCCESS：调用成功，需要调用mark_delete_bitmap()标记这个删除条件
+    //     * OLAP_ERR_FUNC_NOT_IMPLEMENTED：表不是列存表
+    //     * 其他：读取数据或者保存delete bitmap失败
+    OLAPStatus build_delete_bitmaps(SmartOLAPTable table, const int32_t version);
+
+    // 标记指定版本号的删除条件已经生成了delete bitmap。在调用之前需要对Header文件加写锁
+    OLAPStatus mark_delete_bitmap(SmartOLAPTable table, const int32_t version);
+
     // 将一个olap engine的表上存有的所有删除条件打印到log中。调用前只需要给Header文件加读锁
     //
     // 输入参数：
@@ -101,15 +121,23 @@ private:
 
     // 检查指定版本的删除条件是否已经存在。如果存在，返回指定版本删除条件的数组下标；不存在返回-1
     int _check_whether_condition_exist(SmartOLAPTable, int cond_version);
+
+    // 生成一个segment中被删除条件del_cond删除的行的bitmap
+    OLAPStatus _build_segment_delete_bitmap(SmartOLAPTable table,
+                                            OLAPIndex* olap_index,
+                                            uint32_t segment,
+                                            const Conditions& del_cond,
+                                            std::shared_ptr<Bitmap>* bitmap);
 };
 
 // 表示一个删除条件
 struct DeleteConditions {
-    DeleteConditions() : filter_version(0), del_cond(NULL) {}
+    DeleteConditions() : filter_version(0), del_cond(NULL), use_delete_bitmap(false) {}
     ~DeleteConditions() {}
 
     int32_t filter_version; // 删除条件版本号
     Conditions* del_cond;   // 删除条件
+    bool use_delete_bitmap; // 之前版本中被删除的行已经标记在delete bitmap中
 };
 
 // 这个类主要用于判定一条数据(RowCursor)是否符合删除条件。这个类的使用流程如下：
@@ -180,10 +208,14 @@ public:
         return _del_conds;
     }
 
-private:
+    // 移除指定版本号的删除条件，但不销毁删除条件。用于handler的拷贝，例如segment中的行已经
+    // 通过delete bitmap过滤时，SegmentReader移除对应的删除条件
+    void remove_conditions(const std::vector<int32_t>& filter_versions);
+
     // Use regular expression to extract 'column_name', 'op' and 'operands'
-    bool _parse_condition(const std::string& condition_str, TCondition* condition);
+    static bool parse_condition(const std::string& condition_str, TCondition* condition);
 
+private:
     bool _is_inited;
     std::vector<DeleteConditions> _del_conds;
 };
@@ -0,0 +1,234 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/delta_writer.h"
+
+#include <atomic>
+
+#include "common/config.h"
+#include "olap/i_data.h"
+#include "olap/olap_index.h"
+#include "olap/reader.h"
+#include "olap/writer.h"
+
+namespace palo {
+
+// temporary runs use versions which can never be used by tablet, each run
+// of the process gets a new one, so concurrent writers of a tablet don't
+// share file names
+static const int32_t kRunVersionBase = (1 << 28);
+static std::atomic<int32_t> s_next_run_version(kRunVersionBase);
+
+DeltaWriter::DeltaWriter(SmartOLAPTable table, int64_t version_hash,
+                         MemTracker* parent_mem_tracker) :
+        _table(table),
+        _version_hash(version_hash),
+        _parent_mem_tracker(parent_mem_tracker),
+        _num_rows(0) {
+}
+
+DeltaWriter::~DeltaWriter() {
+    _mem_table.reset();
+    _delete_runs();
+}
+
+OLAPStatus DeltaWriter::init() {
+    return _init_mem_table();
+}
+
+OLAPStatus DeltaWriter::_init_mem_table() {
+    _mem_table.reset(new MemTable(_table->tablet_schema(), _table->keys_type(),
+                                  _parent_mem_tracker));
+    OLAPStatus res = _mem_table->init();
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init mem table. [res=%d table='%s']",
+                         res, _table->full_name().c_str());
+        return res;
+    }
+    return OLAP_SUCCESS;
+}
+
+int64_t DeltaWriter::mem_consumption() const {
+    if (_mem_table == nullptr) {
+        return 0;
+    }
+    return _mem_table->memory_usage();
+}
+
+OLAPStatus DeltaWriter::write(const RowCursor& row) {
+    OLAPStatus res = _mem_table->insert(row);
+    if (res != OLAP_SUCCESS) {
+        return res;
+    }
+    ++_num_rows;
+
+    if (_mem_table->memory_usage() >= config::write_buffer_size) {
+        return flush();
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus DeltaWriter::flush() {
+    if (_mem_table->size() == 0) {
+        return OLAP_SUCCESS;
+    }
+    OLAPStatus res = _flush_mem_table();
+    if (res != OLAP_SUCCESS) {
+        return res;
+    }
+    return _init_mem_table();
+}
+
+OLAPStatus DeltaWriter::_flush_mem_table() {
+    int32_t run_version = s_next_run_version.fetch_add(1);
+    Version version(run_version, run_version);
+    OLAPIndex* index = new(std::nothrow) OLAPIndex(
+            _table.get(), version, _version_hash, false, 0, 0);
+    if (index == nullptr) {
+        OLAP_LOG_WARNING("fail to malloc OLAPIndex. [size=%ld]", sizeof(OLAPIndex));
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+    _runs.push_back(index);
+
+    std::unique_ptr<IWriter> writer(IWriter::create(_table, index, false));
+    if (writer == nullptr) {
+        OLAP_LOG_WARNING("fail to create writer. [table='%s']", _table->full_name().c_str());
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+    OLAPStatus res = writer->init();
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init writer. [res=%d table='%s']",
+                         res, _table->full_name().c_str());
+        return res;
+    }
+
+    RowCursor row;
+    res = row.init(_table->tablet_schema());
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init row cursor. [res=%d]", res);
+        return res;
+    }
+    uint32_t num_rows = 0;
+    res = _mem_table->flush(&row, writer.get(), &num_rows);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to flush mem table. [res=%d table='%s']",
+                         res, _table->full_name().c_str());
+        return res;
+    }
+    res = writer->finalize();
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to finalize writer. [res=%d table='%s']",
+                         res, _table->full_name().c_str());
+        return res;
+    }
+    res = index->load();
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to load index. [res=%d table='%s']",
+                         res, _table->full_name().c_str());
+        return res;
+    }
+
+    VLOG(3) << "flush mem table to run. table=" << _table->full_name()
+            << ", version=" << version.first << ", rows=" << num_rows;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus DeltaWriter::write_to(RowCursor* row, IWriter* writer, uint32_t* num_rows) {
+    if (_runs.empty()) {
+        // all rows fit in memory, write them without any temporary file
+        return _mem_table->flush(row, writer, num_rows);
+    }
+
+    if (_mem_table->size() > 0) {
+        OLAPStatus res = _flush_mem_table();
+        if (res != OLAP_SUCCESS) {
+            return res;
+        }
+    }
+    _mem_table.reset();
+    return _merge_runs(row, writer, num_rows);
+}
+
+OLAPStatus DeltaWriter::_merge_runs(RowCursor* row, IWriter* writer, uint32_t* num_rows) {
+    std::vector<IData*> olap_data_arr;
+    OLAPStatus res = OLAP_SUCCESS;
+    for (auto index : _runs) {
+        IData* olap_data = IData::create(index);
+        if (olap_data == nullptr) {
+            OLAP_LOG_WARNING("fail to create IData. [table='%s']", _table->full_name().c_str());
+            res = OLAP_ERR_MALLOC_ERROR;
+            break;
+        }
+        olap_data_arr.push_back(olap_data);
+        res = olap_data->init();
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to init olap data. [res=%d table='%s']",
+                             res, _table->full_name().c_str());
+            break;
+        }
+    }
+
+    if (res == OLAP_SUCCESS) {
+        // runs are merged (and aggregated) in the same way as sorting schema change
+        Reader reader;
+        ReaderParams reader_params;
+        reader_params.olap_table = _table;
+        reader_params.reader_type = READER_ALTER_TABLE;
+        reader_params.olap_data_arr = olap_data_arr;
+        res = reader.init(reader_params);
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to init reader. [res=%d table='%s']",
+                             res, _table->full_name().c_str());
+        }
+
+        const std::vector<FieldInfo>& tablet_schema = _table->tablet_schema();
+        bool eof = false;
+        while (res == OLAP_SUCCESS) {
+            res = writer->attached_by(row);
+            if (res != OLAP_SUCCESS) {
+                OLAP_LOG_WARNING("fail to attach row to writer. [res=%d table='%s']",
+                                 res, _table->full_name().c_str());
+                break;
+            }
+            row->allocate_memory_for_string_type(tablet_schema, writer->mem_pool());
+            res = reader.next_row_with_aggregation(row, &eof);
+            if (res != OLAP_SUCCESS) {
+                OLAP_LOG_WARNING("fail to read merged row. [res=%d table='%s']",
+                                 res, _table->full_name().c_str());
+                break;
+            }
+            if (eof) {
+                break;
+            }
+            writer->next(*row);
+            ++(*num_rows);
+        }
+    }
+
+    for (auto olap_data : olap_data_arr) {
+        SAFE_DELETE(olap_data);
+    }
+    return res;
+}
+
+void DeltaWriter::_delete_runs() {
+    for (auto index : _runs) {
+        index->delete_all_files();
+        SAFE_DELETE(index);
+    }
+    _runs.clear();
+}
+
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "olap/memtable.h"
+#include "olap/olap_table.h"
+#include "olap/row_cursor.h"
+
+namespace palo {
+
+class IWriter;
+class MemTracker;
+class OLAPIndex;
+
+// DeltaWriter sorts rows of one delta of a tablet, so that rows pushed
+// into the tablet need not be sorted or aggregated in advance.
+// Rows are kept sorted (and aggregated) in a MemTable. When the MemTable
+// reaches config::write_buffer_size it is flushed into a temporary sorted
+// run, and all runs are merged when rows are written into the delta.
+class DeltaWriter {
+public:
+    // 'version_hash' is the version hash of delta being written, it is
+    // used to name temporary runs.
+    DeltaWriter(SmartOLAPTable table, int64_t version_hash,
+                MemTracker* parent_mem_tracker = nullptr);
+    ~DeltaWriter();
+
+    OLAPStatus init();
+
+    OLAPStatus write(const RowCursor& row);
+
+    // Flush rows in mem table into a sorted run to release memory.
+    OLAPStatus flush();
+
+    // Write all rows into writer in key order, 'row' is inited with
+    // tablet schema and can be attached to writer. Writer is not finalized.
+    OLAPStatus write_to(RowCursor* row, IWriter* writer, uint32_t* num_rows);
+
+    int64_t num_rows() const { return _num_rows; }
+    int64_t mem_consumption() const;
+
+private:
+    OLAPStatus _init_mem_table();
+    OLAPStatus _flush_mem_table();
+    OLAPStatus _merge_runs(RowCursor* row, IWriter* writer, uint32_t* num_rows);
+    void _delete_runs();
+
+    SmartOLAPTable _table;
+    int64_t _version_hash;
+    MemTracker* _parent_mem_tracker;
+
+    std::unique_ptr<MemTable> _mem_table;
+    // sorted runs flushed from full mem tables, they are
+    // temporary indices which are not registered in tablet
+    std::vector<OLAPIndex*> _runs;
+    int64_t _num_rows;
+
+    DISALLOW_COPY_AND_ASSIGN(DeltaWriter);
+};
+
+}
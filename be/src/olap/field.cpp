@@ -50,6 +50,7 @@ Field* Field::create_by_type(const FieldType& type) {
 
 Field::Field(const FieldInfo& field_info)
         : _type(field_info.type),
+          _aggregation(field_info.aggregation),
           _index_size(field_info.index_length),
           _offset(0) {
 
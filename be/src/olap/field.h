@@ -78,7 +78,7 @@ public:
     inline bool equal(char* left, char* right);
 
     inline void aggregate(char* dest, char* src);
-    inline void finalize(char* data);
+    inline OLAPStatus finalize(char* data);
 
     inline void copy_with_pool(char* dest, const char* src, MemPool* mem_pool);
     inline void copy_without_pool(char* dest, const char* src);
@@ -105,6 +105,7 @@ public:
     inline uint32_t hash_code(char* data, uint32_t seed) const;
 private:
     FieldType _type;
+    FieldAggregationMethod _aggregation;
     // Field的长度，单位为字节
     uint16_t _size;
     // Field的最大长度，单位为字节，通常等于length， 变长字符串不同
@@ -173,11 +174,12 @@ inline void Field::aggregate(char* dest, char* src) {
     _aggregate_func(dest, src);
 }
 
-inline void Field::finalize(char* data) {
-    if (OLAP_UNLIKELY(_type == OLAP_FIELD_TYPE_HLL)) {
-        // hyperloglog type use this function
-        _finalize_func(data);
+inline OLAPStatus Field::finalize(char* data) {
+    if (OLAP_UNLIKELY(_finalize_func != nullptr)) {
+        // hyperloglog and bitmap use this function
+        return _finalize_func(data);
     }
+    return OLAP_SUCCESS;
 }
 
 inline void Field::copy_with_pool(char* dest, const char* src, MemPool* mem_pool) {
@@ -199,8 +201,12 @@ inline void Field::copy_without_pool(char* dest, const char* src) {
 }
 
 inline void Field::agg_init(char* dest, const char* src) {
-    if (OLAP_LIKELY(_type != OLAP_FIELD_TYPE_HLL)) {
+    if (OLAP_LIKELY(_type != OLAP_FIELD_TYPE_HLL
+            && _aggregation != OLAP_FIELD_AGGREGATION_BITMAP_UNION)) {
         copy_without_pool(dest, src);
+    } else if (_aggregation == OLAP_FIELD_AGGREGATION_BITMAP_UNION) {
+        AggregateFuncTraits<OLAP_FIELD_AGGREGATION_BITMAP_UNION,
+                OLAP_FIELD_TYPE_VARCHAR>::init(dest, src);
     } else {
         StringSlice* slice = reinterpret_cast<StringSlice*>(dest + 1);
         size_t hll_ptr = *(size_t*)(slice->data - sizeof(HllContext*));
@@ -93,6 +93,8 @@ FieldAggregationMethod FieldInfo::get_aggregation_type_by_string(const string& s
         aggregation_type = OLAP_FIELD_AGGREGATION_REPLACE;
     } else if (0 == upper_str.compare("HLL_UNION")) {
         aggregation_type = OLAP_FIELD_AGGREGATION_HLL_UNION;
+    } else if (0 == upper_str.compare("BITMAP_UNION")) {
+        aggregation_type = OLAP_FIELD_AGGREGATION_BITMAP_UNION;
     } else {
         OLAP_LOG_WARNING("invalid aggregation type string. [aggregation='%s']", str.c_str());
         aggregation_type = OLAP_FIELD_AGGREGATION_UNKNOWN;
@@ -191,6 +193,9 @@ string FieldInfo::get_string_by_aggregation_type(FieldAggregationMethod type) {
         case OLAP_FIELD_AGGREGATION_HLL_UNION:
             return "HLL_UNION";
 
+        case OLAP_FIELD_AGGREGATION_BITMAP_UNION:
+            return "BITMAP_UNION";
+
         default:
             return "UNKNOWN";
     }
@@ -222,6 +227,7 @@ uint32_t FieldInfo::get_field_length_by_type(TPrimitiveType::type type, uint32_t
         case TPrimitiveType::HLL:
             return string_length + sizeof(OLAP_STRING_MAX_LENGTH);
         case TPrimitiveType::DECIMAL:    
+        case TPrimitiveType::DECIMALV2:
             return 12; // use 12 bytes in olap engine.
         default:
             OLAP_LOG_WARNING("unknown field type. [type=%d]", type);
@@ -38,7 +38,8 @@ FileHandler::FileHandler() :
         _wr_length(0),
         _file_name(""),
         _is_using_cache(false),
-        _cache_handle(NULL) {
+        _cache_handle(NULL),
+        _io_governor(NULL) {
     _fd_cache = OLAPEngine::get_instance()->file_descriptor_lru_cache();
 }
 
@@ -67,6 +68,7 @@ OLAPStatus FileHandler::open(const string& file_name, int flag) {
                    file_name.c_str(), flag, _fd);
     _is_using_cache = false;
     _file_name = file_name;
+    _io_governor = IOGovernor::get_instance()->get_disk(file_name);
     return OLAP_SUCCESS;
 }
 
@@ -103,6 +105,7 @@ OLAPStatus FileHandler::open_with_cache(const string& file_name, int flag) {
     }
     _is_using_cache = true;
     _file_name = file_name;
+    _io_governor = IOGovernor::get_instance()->get_disk(file_name);
     return OLAP_SUCCESS;
 }
 
@@ -126,6 +129,7 @@ OLAPStatus FileHandler::open_with_mode(const string& file_name, int flag, int mo
     OLAP_LOG_DEBUG("success to open file. [file_name='%s' flag=%d mode=%d fd=%d]",
                    file_name.c_str(), flag, mode, _fd);
     _file_name = file_name;
+    _io_governor = IOGovernor::get_instance()->get_disk(file_name);
     return OLAP_SUCCESS;
 }
 
@@ -163,10 +167,15 @@ OLAPStatus FileHandler::close() {
     _fd = -1;
     _file_name = "";
     _wr_length = 0;
+    _io_governor = NULL;
     return OLAP_SUCCESS;
 }
 
 OLAPStatus FileHandler::pread(void* buf, size_t size, size_t offset) {
+    if (_io_governor != NULL) {
+        _io_governor->acquire(IO_READ, size);
+    }
+
     char* ptr = reinterpret_cast<char*>(buf);
 
     while (size > 0) {
@@ -193,6 +202,9 @@ OLAPStatus FileHandler::pread(void* buf, size_t size, size_t offset) {
 }
 
 OLAPStatus FileHandler::write(const void* buf, size_t buf_size) {
+    if (_io_governor != NULL) {
+        _io_governor->acquire(IO_WRITE, buf_size);
+    }
 
     size_t org_buf_size = buf_size;
     const char* ptr = reinterpret_cast<const char*>(buf);
@@ -225,6 +237,10 @@ OLAPStatus FileHandler::write(const void* buf, size_t buf_size) {
 }
 
 OLAPStatus FileHandler::pwrite(const void* buf, size_t buf_size, size_t offset) {
+    if (_io_governor != NULL) {
+        _io_governor->acquire(IO_WRITE, buf_size);
+    }
+
     const char* ptr = reinterpret_cast<const char*>(buf);
 
     while (buf_size > 0) {
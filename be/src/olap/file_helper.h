@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 
+#include "olap/io_governor.h"
 #include "olap/lru_cache.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
@@ -104,6 +105,8 @@ private:
     bool _is_using_cache;
     Cache::Handle* _cache_handle;
     Cache* _fd_cache;
+    // governor of data directory where file is, NULL if not in any
+    DiskIOGovernor* _io_governor;
 };
 
 class FileHandlerWithBuf {
@@ -0,0 +1,529 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/header_store.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "common/config.h"
+
+namespace palo {
+
+static const std::string CHECKPOINT_FILE = "checkpoint";
+static const std::string LOG_FILE_PREFIX = "log_";
+// length and checksum
+static const size_t RECORD_HEADER_SIZE = sizeof(uint32_t) * 2;
+// size of records encoded at a time by checkpoint
+static const size_t CHECKPOINT_CHUNK_SIZE = 1024 * 1024;
+
+DiskHeaderStore::DiskHeaderStore(const std::string& root_path) :
+        _root_path(root_path),
+        _store_path(root_path + HEADER_STORE_PREFIX),
+        _io_governor(NULL),
+        _cond(_mutex),
+        _log_fd(-1),
+        _log_seq(0),
+        _log_bytes(0),
+        _num_appended(0),
+        _num_synced(0),
+        _syncing(false),
+        _checkpointing(false),
+        _failed(false) {
+}
+
+DiskHeaderStore::~DiskHeaderStore() {
+    if (_log_fd >= 0) {
+        ::close(_log_fd);
+    }
+}
+
+std::string DiskHeaderStore::_log_path(uint64_t seq) const {
+    return _store_path + "/" + LOG_FILE_PREFIX + std::to_string(seq);
+}
+
+OLAPStatus DiskHeaderStore::open() {
+    OLAPStatus res = OLAP_SUCCESS;
+    if (!check_dir_existed(_store_path) && create_dirs(_store_path) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to create header store dir. [path=%s]", _store_path.c_str());
+        return OLAP_ERR_CANNOT_CREATE_DIR;
+    }
+
+    std::set<std::string> files;
+    if ((res = dir_walk(_store_path, NULL, &files)) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to walk header store dir. [path=%s]", _store_path.c_str());
+        return res;
+    }
+
+    _io_governor = IOGovernor::get_instance()->get_disk(_store_path);
+
+    std::vector<uint64_t> log_seqs;
+    for (const std::string& file : files) {
+        if (file.compare(0, LOG_FILE_PREFIX.size(), LOG_FILE_PREFIX) == 0) {
+            log_seqs.push_back(strtoull(file.c_str() + LOG_FILE_PREFIX.size(), NULL, 10));
+        }
+    }
+    std::sort(log_seqs.begin(), log_seqs.end());
+
+    if (files.find(CHECKPOINT_FILE) != files.end()) {
+        if ((res = _replay(_store_path + "/" + CHECKPOINT_FILE, false)) != OLAP_SUCCESS) {
+            return res;
+        }
+    }
+    for (uint64_t seq : log_seqs) {
+        if ((res = _replay(_log_path(seq), seq == log_seqs.back())) != OLAP_SUCCESS) {
+            return res;
+        }
+    }
+
+    uint64_t seq = log_seqs.empty() ? 1 : log_seqs.back() + 1;
+    if ((res = _open_log(seq)) != OLAP_SUCCESS) {
+        return res;
+    }
+    OLAP_LOG_INFO("succeed to open header store. [path=%s headers=%lu logs=%lu]",
+                  _store_path.c_str(), _headers.size(), log_seqs.size());
+
+    // merge logs left by last run, so that they're not replayed again
+    if (!log_seqs.empty()) {
+        _checkpointing = true;
+        return _checkpoint();
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus DiskHeaderStore::get(const std::string& header_file, std::string* value) {
+    AutoMutexLock l(&_mutex);
+    auto it = _headers.find(_key(header_file));
+    if (it == _headers.end()) {
+        return OLAP_ERR_HEADER_NOT_FOUND;
+    }
+    *value = it->second;
+    return OLAP_SUCCESS;
+}
+
+bool DiskHeaderStore::contains(const std::string& header_file) {
+    AutoMutexLock l(&_mutex);
+    return _headers.find(_key(header_file)) != _headers.end();
+}
+
+OLAPStatus DiskHeaderStore::put(const std::string& header_file, const std::string& value) {
+    return _append(RECORD_PUT, _key(header_file), value);
+}
+
+OLAPStatus DiskHeaderStore::remove(const std::string& header_file) {
+    return _append(RECORD_REMOVE, _key(header_file), "");
+}
+
+OLAPStatus DiskHeaderStore::retain(const std::set<std::string>& header_files) {
+    std::set<std::string> keys;
+    for (const std::string& header_file : header_files) {
+        keys.insert(_key(header_file));
+    }
+
+    std::vector<std::string> unused_keys;
+    {
+        AutoMutexLock l(&_mutex);
+        for (const auto& it : _headers) {
+            if (keys.find(it.first) == keys.end()) {
+                unused_keys.push_back(it.first);
+            }
+        }
+    }
+
+    for (const std::string& key : unused_keys) {
+        OLAP_LOG_INFO("remove unused header from header store. [root=%s header=%s]",
+                      _root_path.c_str(), key.c_str());
+        OLAPStatus res = _append(RECORD_REMOVE, key, "");
+        if (res != OLAP_SUCCESS) {
+            return res;
+        }
+    }
+    return OLAP_SUCCESS;
+}
+
+void DiskHeaderStore::_encode_record(RecordType type,
+                                     const std::string& key,
+                                     const std::string& value,
+                                     std::string* record) {
+    uint32_t key_length = key.size();
+    uint32_t body_length = sizeof(uint8_t) + sizeof(key_length) + key.size() + value.size();
+    record->reserve(RECORD_HEADER_SIZE + body_length);
+    record->assign(RECORD_HEADER_SIZE, '\0');
+    record->push_back(static_cast<char>(type));
+    record->append(reinterpret_cast<const char*>(&key_length), sizeof(key_length));
+    record->append(key);
+    record->append(value);
+
+    uint32_t checksum = olap_adler32(
+            ADLER32_INIT, record->data() + RECORD_HEADER_SIZE, body_length);
+    memcpy(&(*record)[0], &body_length, sizeof(body_length));
+    memcpy(&(*record)[sizeof(body_length)], &checksum, sizeof(checksum));
+}
+
+OLAPStatus DiskHeaderStore::_replay(const std::string& file_name, bool is_newest_log) {
+    int fd = ::open(file_name.c_str(), O_RDWR);
+    if (fd < 0) {
+        OLAP_LOG_WARNING("fail to open header store file. [file=%s err=%m]", file_name.c_str());
+        return OLAP_ERR_IO_ERROR;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        OLAP_LOG_WARNING("fail to stat header store file. [file=%s err=%m]", file_name.c_str());
+        ::close(fd);
+        return OLAP_ERR_IO_ERROR;
+    }
+    std::string data(st.st_size, '\0');
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t rd_size = ::pread(fd, &data[offset], data.size() - offset, offset);
+        if (rd_size <= 0) {
+            OLAP_LOG_WARNING("fail to read header store file. [file=%s err=%m]",
+                             file_name.c_str());
+            ::close(fd);
+            return OLAP_ERR_IO_ERROR;
+        }
+        offset += rd_size;
+    }
+
+    offset = 0;
+    // end of the broken record, or end of file if its length is broken
+    size_t broken_end = 0;
+    while (offset < data.size()) {
+        uint32_t body_length = 0;
+        uint32_t checksum = 0;
+        if (data.size() - offset < RECORD_HEADER_SIZE) {
+            broken_end = data.size();
+            break;
+        }
+        memcpy(&body_length, &data[offset], sizeof(body_length));
+        memcpy(&checksum, &data[offset + sizeof(body_length)], sizeof(checksum));
+        size_t body_offset = offset + RECORD_HEADER_SIZE;
+        if (data.size() - body_offset < body_length
+                || body_length < sizeof(uint8_t) + sizeof(uint32_t)) {
+            broken_end = data.size();
+            break;
+        }
+        if (checksum != olap_adler32(ADLER32_INIT, &data[body_offset], body_length)) {
+            broken_end = body_offset + body_length;
+            break;
+        }
+
+        // checksum is right, so it's not left by crash if it can't be parsed
+        const char* body = &data[body_offset];
+        RecordType type = static_cast<RecordType>(body[0]);
+        uint32_t key_length = 0;
+        memcpy(&key_length, body + sizeof(uint8_t), sizeof(key_length));
+        size_t key_offset = sizeof(uint8_t) + sizeof(key_length);
+        if (key_offset + key_length > body_length
+                || (type != RECORD_PUT && type != RECORD_REMOVE)) {
+            OLAP_LOG_WARNING("invalid record in header store. [file=%s offset=%lu]",
+                             file_name.c_str(), offset);
+            ::close(fd);
+            return OLAP_ERR_CHECKSUM_ERROR;
+        }
+        std::string key(body + key_offset, key_length);
+        if (type == RECORD_PUT) {
+            _headers[key].assign(body + key_offset + key_length,
+                                 body_length - key_offset - key_length);
+        } else {
+            _headers.erase(key);
+        }
+        offset = body_offset + body_length;
+    }
+
+    if (offset == data.size()) {
+        ::close(fd);
+        return OLAP_SUCCESS;
+    }
+    // Bytes after a record broken by crash may be zeros, if size of file
+    // is persisted but data is not.
+    bool zero_tail = data.find_first_not_of('\0', broken_end) == std::string::npos;
+    if (!is_newest_log || !zero_tail) {
+        OLAP_LOG_WARNING("header store is corrupted. [file=%s offset=%lu size=%lu]",
+                         file_name.c_str(), offset, data.size());
+        ::close(fd);
+        return OLAP_ERR_CHECKSUM_ERROR;
+    }
+    // Truncate it, so that it's not in the middle of logs after new
+    // log is created.
+    OLAP_LOG_WARNING("truncate incomplete record at the end of header store log. "
+                     "[file=%s offset=%lu size=%lu]",
+                     file_name.c_str(), offset, data.size());
+    if (ftruncate(fd, offset) != 0 || fdatasync(fd) != 0) {
+        OLAP_LOG_WARNING("fail to truncate header store log. [file=%s err=%m]",
+                         file_name.c_str());
+        ::close(fd);
+        return OLAP_ERR_IO_ERROR;
+    }
+    ::close(fd);
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus DiskHeaderStore::_write_fully(int fd, const std::string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t wr_size = ::write(fd, data.data() + offset, data.size() - offset);
+        if (wr_size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            OLAP_LOG_WARNING("fail to write header store file. [err=%m]");
+            return OLAP_ERR_IO_ERROR;
+        }
+        offset += wr_size;
+    }
+    return OLAP_SUCCESS;
+}
+
+// _mutex must be held, or it's called in open()
+OLAPStatus DiskHeaderStore::_open_log(uint64_t seq) {
+    std::string log_path = _log_path(seq);
+    int fd = ::open(log_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        OLAP_LOG_WARNING("fail to create header store log. [file=%s err=%m]", log_path.c_str());
+        return OLAP_ERR_IO_ERROR;
+    }
+
+    if (_log_fd >= 0) {
+        ::close(_log_fd);
+    }
+    _log_fd = fd;
+    _log_seq = seq;
+    _log_bytes = 0;
+    _num_appended = 0;
+    _num_synced = 0;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus DiskHeaderStore::_append(RecordType type,
+                                    const std::string& key,
+                                    const std::string& value) {
+    std::string record;
+    _encode_record(type, key, value, &record);
+    if (_io_governor != NULL) {
+        _io_governor->acquire(IO_WRITE, record.size());
+    }
+
+    bool need_checkpoint = false;
+    {
+        AutoMutexLock l(&_mutex);
+        if (_failed) {
+            OLAP_LOG_WARNING("header store is failed. [root=%s]", _root_path.c_str());
+            return OLAP_ERR_IO_ERROR;
+        }
+        if (_write_fully(_log_fd, record) != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to append header store log. [root=%s]", _root_path.c_str());
+            // remove partial record, otherwise records after it can't be read
+            if (ftruncate(_log_fd, _log_bytes) != 0
+                    || lseek(_log_fd, _log_bytes, SEEK_SET) != _log_bytes) {
+                OLAP_LOG_WARNING("fail to truncate header store log. [root=%s err=%m]",
+                                 _root_path.c_str());
+                _failed = true;
+            }
+            return OLAP_ERR_IO_ERROR;
+        }
+        _log_bytes += record.size();
+        uint64_t num_appended = ++_num_appended;
+        uint64_t log_seq = _log_seq;
+        if (type == RECORD_PUT) {
+            _headers[key] = value;
+        } else {
+            _headers.erase(key);
+        }
+
+        // One of waiting savers syncs the log for all records appended
+        // before it. Log is synced before it's replaced by checkpoint.
+        while (_num_synced < num_appended && log_seq == _log_seq) {
+            if (_syncing) {
+                _cond.wait();
+                continue;
+            }
+            _syncing = true;
+            uint64_t target = _num_appended;
+            int fd = _log_fd;
+            _mutex.unlock();
+            int ret = fdatasync(fd);
+            _mutex.lock();
+            _syncing = false;
+            _cond.notify_all();
+            if (ret != 0) {
+                // it's unknown which records are on disk
+                OLAP_LOG_WARNING("fail to sync header store log. [root=%s err=%m]",
+                                 _root_path.c_str());
+                _failed = true;
+                return OLAP_ERR_IO_ERROR;
+            }
+            _num_synced = target;
+        }
+
+        if (_log_bytes >= config::header_store_checkpoint_log_mbytes * 1024L * 1024L
+                && !_checkpointing) {
+            _checkpointing = true;
+            need_checkpoint = true;
+        }
+    }
+
+    if (need_checkpoint) {
+        // saving won't fail if checkpoint fails, since record is synced
+        _checkpoint();
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus DiskHeaderStore::_checkpoint() {
+    OLAPStatus res = OLAP_SUCCESS;
+    uint64_t last_log_seq = 0;
+    {
+        AutoMutexLock l(&_mutex);
+        while (_syncing) {
+            _cond.wait();
+        }
+        if (_failed) {
+            _checkpointing = false;
+            return OLAP_ERR_IO_ERROR;
+        }
+        if (_num_synced < _num_appended && fdatasync(_log_fd) != 0) {
+            OLAP_LOG_WARNING("fail to sync header store log. [root=%s err=%m]",
+                             _root_path.c_str());
+            _failed = true;
+            _checkpointing = false;
+            return OLAP_ERR_IO_ERROR;
+        }
+        _num_synced = _num_appended;
+        last_log_seq = _log_seq;
+        // records after checkpoint go to new log
+        if ((res = _open_log(last_log_seq + 1)) != OLAP_SUCCESS) {
+            _checkpointing = false;
+            return res;
+        }
+        _cond.notify_all();
+    }
+
+    std::string checkpoint_path = _store_path + "/" + CHECKPOINT_FILE;
+    std::string tmp_path = checkpoint_path + ".tmp";
+    size_t num_headers = 0;
+    int fd = ::open(tmp_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        OLAP_LOG_WARNING("fail to create header store checkpoint. [file=%s err=%m]",
+                         tmp_path.c_str());
+        res = OLAP_ERR_IO_ERROR;
+    } else {
+        std::string chunk;
+        std::string record;
+        std::string last_key;
+        bool finished = false;
+        while (!finished && res == OLAP_SUCCESS) {
+            chunk.clear();
+            {
+                // encode headers after last key, without holding all of them
+                AutoMutexLock l(&_mutex);
+                auto it = num_headers == 0 ? _headers.begin() : _headers.upper_bound(last_key);
+                for (; it != _headers.end() && chunk.size() < CHECKPOINT_CHUNK_SIZE; ++it) {
+                    _encode_record(RECORD_PUT, it->first, it->second, &record);
+                    chunk.append(record);
+                    last_key = it->first;
+                    ++num_headers;
+                }
+                finished = it == _headers.end();
+            }
+            if (_io_governor != NULL) {
+                _io_governor->acquire(IO_WRITE, chunk.size());
+            }
+            res = _write_fully(fd, chunk);
+        }
+        if (res == OLAP_SUCCESS && fdatasync(fd) != 0) {
+            OLAP_LOG_WARNING("fail to sync header store checkpoint. [err=%m]");
+            res = OLAP_ERR_IO_ERROR;
+        }
+        ::close(fd);
+    }
+
+    // Logs are removed only after checkpoint is renamed. Replaying logs
+    // already in checkpoint again gets the same headers.
+    if (res == OLAP_SUCCESS && rename(tmp_path.c_str(), checkpoint_path.c_str()) != 0) {
+        OLAP_LOG_WARNING("fail to rename header store checkpoint. [file=%s err=%m]",
+                         checkpoint_path.c_str());
+        res = OLAP_ERR_IO_ERROR;
+    }
+    if (res == OLAP_SUCCESS) {
+        int dir_fd = ::open(_store_path.c_str(), O_RDONLY);
+        if (dir_fd >= 0) {
+            fsync(dir_fd);
+            ::close(dir_fd);
+        }
+        std::set<std::string> files;
+        dir_walk(_store_path, NULL, &files);
+        for (const std::string& file : files) {
+            if (file.compare(0, LOG_FILE_PREFIX.size(), LOG_FILE_PREFIX) == 0
+                    && strtoull(file.c_str() + LOG_FILE_PREFIX.size(), NULL, 10) <= last_log_seq) {
+                ::remove((_store_path + "/" + file).c_str());
+            }
+        }
+        OLAP_LOG_INFO("succeed to do header store checkpoint. [root=%s headers=%lu]",
+                      _root_path.c_str(), num_headers);
+    }
+
+    AutoMutexLock l(&_mutex);
+    _checkpointing = false;
+    return res;
+}
+
+HeaderStore::HeaderStore() {
+}
+
+HeaderStore::~HeaderStore() {
+    for (DiskHeaderStore* disk : _disks) {
+        delete disk;
+    }
+}
+
+OLAPStatus HeaderStore::init(const std::vector<std::string>& root_paths) {
+    for (const std::string& root_path : root_paths) {
+        if (get_disk(root_path + DATA_PREFIX + "/") != NULL) {
+            continue;
+        }
+        DiskHeaderStore* disk = new DiskHeaderStore(root_path);
+        OLAPStatus res = disk->open();
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to open header store. [root=%s res=%d]",
+                             root_path.c_str(), res);
+            delete disk;
+            return res;
+        }
+        _disks.push_back(disk);
+    }
+    return OLAP_SUCCESS;
+}
+
+DiskHeaderStore* HeaderStore::get_disk(const std::string& header_file) {
+    for (DiskHeaderStore* disk : _disks) {
+        const std::string& root_path = disk->root_path();
+        if (header_file.size() >= root_path.size() + DATA_PREFIX.size() + 1
+                && header_file.compare(0, root_path.size(), root_path) == 0
+                && header_file.compare(root_path.size(), DATA_PREFIX.size(), DATA_PREFIX) == 0
+                && header_file[root_path.size() + DATA_PREFIX.size()] == '/') {
+            return disk;
+        }
+    }
+    return NULL;
+}
+
+}
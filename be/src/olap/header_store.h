@@ -0,0 +1,147 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "olap/io_governor.h"
+#include "olap/olap_define.h"
+#include "olap/utils.h"
+
+namespace palo {
+
+// Headers of all tablets in a data directory. Headers are kept in memory
+// and persisted as records in a log, so saving a header appends a small
+// record instead of rewriting the header file, and records appended by
+// concurrent savers are synced to disk together. When the log gets large,
+// all headers are written into a checkpoint and older logs are removed.
+//
+// Files are in root_path/header_store:
+//   checkpoint    headers when the last checkpoint was done
+//   log_<seq>     records after the checkpoint, replayed in order of seq
+//
+// Each record is: length(4) | adler32 of body(4) | body, and body is
+// type(1) | key length(4) | key | serialized OLAPHeaderMessage.
+class DiskHeaderStore {
+public:
+    explicit DiskHeaderStore(const std::string& root_path);
+    ~DiskHeaderStore();
+
+    // Read checkpoint and logs, then start a new log
+    OLAPStatus open();
+
+    // header_file is full path of header file of tablet, and value is
+    // serialized OLAPHeaderMessage.
+    // Return OLAP_ERR_HEADER_NOT_FOUND if header is not in store.
+    OLAPStatus get(const std::string& header_file, std::string* value);
+    bool contains(const std::string& header_file);
+    // Return after the record is synced to disk
+    OLAPStatus put(const std::string& header_file, const std::string& value);
+    OLAPStatus remove(const std::string& header_file);
+
+    // Remove headers whose file is not in header_files
+    OLAPStatus retain(const std::set<std::string>& header_files);
+
+    const std::string& root_path() const {
+        return _root_path;
+    }
+
+private:
+    enum RecordType {
+        RECORD_PUT = 1,
+        RECORD_REMOVE = 2,
+    };
+
+    // key is path of header file relative to root path
+    std::string _key(const std::string& header_file) const {
+        return header_file.substr(_root_path.size());
+    }
+    std::string _log_path(uint64_t seq) const;
+
+    static void _encode_record(RecordType type,
+                               const std::string& key,
+                               const std::string& value,
+                               std::string* record);
+    // Apply records in file to _headers. If it's the newest log, a broken
+    // record which reaches the end of file is left by crash when it's being
+    // written, it's ignored and truncated. Any other broken record is
+    // corruption, and OLAP_ERR_CHECKSUM_ERROR is returned.
+    OLAPStatus _replay(const std::string& file_name, bool is_newest_log);
+    static OLAPStatus _write_fully(int fd, const std::string& data);
+
+    // Create log of seq, and replace current log with it
+    OLAPStatus _open_log(uint64_t seq);
+    // Append record to current log and wait until it's synced
+    OLAPStatus _append(RecordType type, const std::string& key, const std::string& value);
+    // Write all headers into checkpoint, and remove logs before it.
+    // Headers are encoded and written by chunks, changes during checkpoint
+    // are in the new log and replayed after checkpoint.
+    OLAPStatus _checkpoint();
+
+    std::string _root_path;
+    std::string _store_path;
+    // writes are counted and throttled with priority of saver, NULL if IO
+    // of data directory is not governed
+    DiskIOGovernor* _io_governor;
+
+    MutexLock _mutex;
+    Condition _cond;
+    // serialized header of each key
+    std::map<std::string, std::string> _headers;
+
+    int _log_fd;
+    uint64_t _log_seq;
+    int64_t _log_bytes;
+    // number of records appended to and synced in current log
+    uint64_t _num_appended;
+    uint64_t _num_synced;
+    bool _syncing;
+    bool _checkpointing;
+    // set when log can't be restored after a failed write or sync, then
+    // nothing is appended, so that broken record stays at the end of log
+    bool _failed;
+
+    DISALLOW_COPY_AND_ASSIGN(DiskHeaderStore);
+};
+
+// HeaderStore holds header stores of all data directories. Headers of
+// tablets in data directories are saved into and loaded from the store by
+// OLAPHeader. It's only used if enable_header_store is set, and header
+// files are written along with it until header_store_migration_finalized
+// is set. Header files are still written for snapshots, and header files
+// put into tablet directories by clone or migration are loaded by
+// OLAPEngine::load_one_tablet().
+class HeaderStore {
+    DECLARE_SINGLETON(HeaderStore);
+public:
+    // Open stores of root paths. Must be called once on start, before any
+    // tablet is loaded.
+    OLAPStatus init(const std::vector<std::string>& root_paths);
+
+    // Return store of data directory where header file is, NULL if header
+    // file is not under data path of any data directory
+    DiskHeaderStore* get_disk(const std::string& header_file);
+
+private:
+    std::vector<DiskHeaderStore*> _disks;
+
+    DISALLOW_COPY_AND_ASSIGN(HeaderStore);
+};
+
+}
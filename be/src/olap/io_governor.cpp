@@ -0,0 +1,167 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/io_governor.h"
+
+#include <sys/time.h>
+
+#include "common/config.h"
+#include "util/palo_metrics.h"
+
+namespace palo {
+
+static const char* const s_io_type_names[IO_TYPE_NUM] = {"read", "write"};
+static const char* const s_io_priority_names[IO_PRIORITY_NUM] = {
+    "query", "push", "cumulative_compaction", "base_compaction", "schema_change", "clone"
+};
+
+static int64_t now_us() {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec * 1000000L + now.tv_usec;
+}
+
+DiskIOGovernor::DiskIOGovernor(const std::string& root_path,
+                               int64_t read_bytes_per_sec,
+                               int64_t write_bytes_per_sec,
+                               int64_t iops) :
+        _root_path(root_path),
+        _cond(_mutex) {
+    // allow burst of one second
+    int64_t now = now_us();
+    _bytes_buckets[IO_READ].init(read_bytes_per_sec, read_bytes_per_sec, now);
+    _bytes_buckets[IO_WRITE].init(write_bytes_per_sec, write_bytes_per_sec, now);
+    _iops_bucket.init(iops, iops, now);
+    for (int type = 0; type < IO_TYPE_NUM; ++type) {
+        _unlimited[type] = _bytes_buckets[type].unlimited() && _iops_bucket.unlimited();
+    }
+    for (int i = 0; i < IO_PRIORITY_NUM; ++i) {
+        _num_waiting[i] = 0;
+    }
+
+    MetricRegistry* metrics = PaloMetrics::metrics();
+    if (metrics == NULL) {
+        return;
+    }
+    for (int i = 0; i < IO_PRIORITY_NUM; ++i) {
+        for (int type = 0; type < IO_TYPE_NUM; ++type) {
+            metrics->register_metric(
+                "disk_io_bytes_total",
+                MetricLabels().add("path", root_path)
+                    .add("type", s_io_type_names[type])
+                    .add("priority", s_io_priority_names[i]),
+                &_io_bytes[type][i]);
+        }
+        metrics->register_metric(
+            "disk_io_throttled_us_total",
+            MetricLabels().add("path", root_path).add("priority", s_io_priority_names[i]),
+            &_wait_us[i]);
+    }
+}
+
+DiskIOGovernor::~DiskIOGovernor() {
+}
+
+void DiskIOGovernor::acquire(IOType type, int64_t bytes) {
+    IOPriority priority = IOGovernor::thread_priority();
+    _io_bytes[type][priority].increment(bytes);
+    if (_unlimited[type]) {
+        return;
+    }
+
+    AutoMutexLock l(&_mutex);
+    int64_t start_us = now_us();
+    int64_t current_us = start_us;
+    if (priority != IO_PRIORITY_QUERY) {
+        ++_num_waiting[priority];
+        while (true) {
+            _bytes_buckets[type].refill(current_us);
+            _iops_bucket.refill(current_us);
+            if (!_has_higher_waiting(priority)) {
+                int64_t wait_us = _wait_time_us(type);
+                if (wait_us == 0) {
+                    break;
+                }
+                _cond.wait_for_microseconds(wait_us);
+            } else {
+                // notified when IO of higher priority is done
+                _cond.wait();
+            }
+            current_us = now_us();
+        }
+        --_num_waiting[priority];
+        _wait_us[priority].increment(current_us - start_us);
+    } else {
+        _bytes_buckets[type].refill(current_us);
+        _iops_bucket.refill(current_us);
+    }
+
+    _bytes_buckets[type].consume(bytes);
+    _iops_bucket.consume(1);
+    if (priority != IO_PRIORITY_QUERY) {
+        _cond.notify_all();
+    }
+}
+
+bool DiskIOGovernor::_has_higher_waiting(IOPriority priority) const {
+    for (int i = IO_PRIORITY_PUSH; i < priority; ++i) {
+        if (_num_waiting[i] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int64_t DiskIOGovernor::_wait_time_us(IOType type) const {
+    int64_t bytes_wait_us = _bytes_buckets[type].wait_time_us();
+    int64_t iops_wait_us = _iops_bucket.wait_time_us();
+    return bytes_wait_us > iops_wait_us ? bytes_wait_us : iops_wait_us;
+}
+
+__thread IOPriority IOGovernor::_s_thread_priority = IO_PRIORITY_QUERY;
+
+IOGovernor::IOGovernor() {
+}
+
+IOGovernor::~IOGovernor() {
+    for (DiskIOGovernor* disk : _disks) {
+        delete disk;
+    }
+}
+
+void IOGovernor::init(const std::vector<std::string>& root_paths) {
+    int64_t read_bytes_per_sec = config::disk_read_mbytes_per_sec * 1024L * 1024L;
+    int64_t write_bytes_per_sec = config::disk_write_mbytes_per_sec * 1024L * 1024L;
+    for (const std::string& root_path : root_paths) {
+        _disks.push_back(new DiskIOGovernor(root_path,
+                                            read_bytes_per_sec,
+                                            write_bytes_per_sec,
+                                            config::disk_iops));
+    }
+}
+
+DiskIOGovernor* IOGovernor::get_disk(const std::string& file_name) {
+    for (DiskIOGovernor* disk : _disks) {
+        const std::string& root_path = disk->root_path();
+        if (file_name.size() > root_path.size()
+                && file_name[root_path.size()] == '/'
+                && file_name.compare(0, root_path.size(), root_path) == 0) {
+            return disk;
+        }
+    }
+    return NULL;
+}
+
+}
@@ -0,0 +1,184 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "olap/olap_define.h"
+#include "olap/utils.h"
+#include "util/metrics.h"
+
+namespace palo {
+
+// Priority of IO, smaller is higher. IO of query is never throttled, but
+// it takes tokens so that other IO is throttled more.
+enum IOPriority {
+    IO_PRIORITY_QUERY = 0,
+    IO_PRIORITY_PUSH = 1,
+    IO_PRIORITY_CUMULATIVE_COMPACTION = 2,
+    IO_PRIORITY_BASE_COMPACTION = 3,
+    IO_PRIORITY_SCHEMA_CHANGE = 4,
+    IO_PRIORITY_CLONE = 5,
+    IO_PRIORITY_NUM = 6,
+};
+
+enum IOType {
+    IO_READ = 0,
+    IO_WRITE = 1,
+    IO_TYPE_NUM = 2,
+};
+
+// Token bucket refilled at 'rate' tokens per second, holding at most
+// 'burst' tokens. Tokens may be negative after a large request, and
+// requests should wait until it's not negative. Debt is at most 'burst',
+// so that IO which is never throttled doesn't starve others forever.
+class TokenBucket {
+public:
+    TokenBucket() : _rate(0), _burst(0), _tokens(0), _last_refill_us(0) { }
+
+    // rate 0 means no limit
+    void init(int64_t rate, int64_t burst, int64_t now_us) {
+        _rate = rate;
+        _burst = burst;
+        _tokens = burst;
+        _last_refill_us = now_us;
+    }
+
+    bool unlimited() const { return _rate <= 0; }
+
+    void refill(int64_t now_us) {
+        if (unlimited() || now_us <= _last_refill_us) {
+            return;
+        }
+        _tokens += (now_us - _last_refill_us) * _rate / 1000000;
+        if (_tokens > _burst) {
+            _tokens = _burst;
+        }
+        _last_refill_us = now_us;
+    }
+
+    // Time in microseconds until tokens are not negative
+    int64_t wait_time_us() const {
+        if (unlimited() || _tokens >= 0) {
+            return 0;
+        }
+        return (-_tokens * 1000000 + _rate - 1) / _rate;
+    }
+
+    void consume(int64_t tokens) {
+        if (unlimited()) {
+            return;
+        }
+        _tokens -= tokens;
+        if (_tokens < -_burst) {
+            _tokens = -_burst;
+        }
+    }
+
+    int64_t tokens() const { return _tokens; }
+
+private:
+    int64_t _rate;
+    int64_t _burst;
+    int64_t _tokens;
+    int64_t _last_refill_us;
+};
+
+// IO governor of one data directory. Read bytes, write bytes and number
+// of IO are limited by token buckets shared by all threads. When tokens
+// are used up, waiting IO of higher priority goes first.
+class DiskIOGovernor {
+public:
+    // Limits of 0 means no limit
+    DiskIOGovernor(const std::string& root_path,
+                   int64_t read_bytes_per_sec,
+                   int64_t write_bytes_per_sec,
+                   int64_t iops);
+    ~DiskIOGovernor();
+
+    // Wait until IO of 'bytes' is allowed for priority of current thread
+    void acquire(IOType type, int64_t bytes);
+
+    const std::string& root_path() const { return _root_path; }
+
+private:
+    // Return true if IO of higher priority than 'priority' is waiting
+    bool _has_higher_waiting(IOPriority priority) const;
+    int64_t _wait_time_us(IOType type) const;
+
+    std::string _root_path;
+    // IO of a type is not throttled if neither its bytes nor iops is
+    // limited, and it doesn't take the mutex at all
+    bool _unlimited[IO_TYPE_NUM];
+
+    MutexLock _mutex;
+    Condition _cond;
+    TokenBucket _bytes_buckets[IO_TYPE_NUM];
+    TokenBucket _iops_bucket;
+    uint32_t _num_waiting[IO_PRIORITY_NUM];
+
+    IntCounter _io_bytes[IO_TYPE_NUM][IO_PRIORITY_NUM];
+    IntCounter _wait_us[IO_PRIORITY_NUM];
+
+    DISALLOW_COPY_AND_ASSIGN(DiskIOGovernor);
+};
+
+// IOGovernor holds governors of all data directories. FileHandler finds
+// governor of its file when it's opened, and every read and write goes
+// through it with IO priority of current thread, which is set by
+// IOPriorityScope in background tasks and loads.
+class IOGovernor {
+    DECLARE_SINGLETON(IOGovernor);
+public:
+    // Create governors of root paths, limits are from config.
+    // Must be called once on start, before any file is opened.
+    void init(const std::vector<std::string>& root_paths);
+
+    // Return governor of data directory where file is, NULL if it's not in
+    // any data directory
+    DiskIOGovernor* get_disk(const std::string& file_name);
+
+    static IOPriority thread_priority() { return _s_thread_priority; }
+    static void set_thread_priority(IOPriority priority) { _s_thread_priority = priority; }
+
+private:
+    static __thread IOPriority _s_thread_priority;
+
+    std::vector<DiskIOGovernor*> _disks;
+
+    DISALLOW_COPY_AND_ASSIGN(IOGovernor);
+};
+
+// Set IO priority of current thread in the scope
+class IOPriorityScope {
+public:
+    explicit IOPriorityScope(IOPriority priority) :
+            _old_priority(IOGovernor::thread_priority()) {
+        IOGovernor::set_thread_priority(priority);
+    }
+
+    ~IOPriorityScope() {
+        IOGovernor::set_thread_priority(_old_priority);
+    }
+
+private:
+    IOPriority _old_priority;
+
+    DISALLOW_COPY_AND_ASSIGN(IOPriorityScope);
+};
+
+}
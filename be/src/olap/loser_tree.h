@@ -0,0 +1,123 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+namespace palo {
+
+// Tournament tree of losers used to merge multiple sorted inputs.
+// Each leaf is identified by its index in [0, num_leaves), and the tree
+// only keeps leaf indexes, values are compared through 'Less'.
+// Compared to a binary heap, replacing the winner costs only one
+// comparison per level, instead of two.
+//
+// Less should provide 'bool operator()(int a, int b) const' which returns
+// true if current value of leaf 'a' should be output before leaf 'b'.
+// Leaves which are equal are output in order of their indexes.
+//
+// Usage:
+//   LoserTree<Less> tree(less);
+//   tree.init(num_leaves);
+//   while (!tree.empty()) {
+//       int leaf = tree.top();
+//       ... consume value of leaf, and move leaf to its next value
+//       if (leaf has value) tree.update_top(); else tree.pop_top();
+//   }
+template<class Less>
+class LoserTree {
+public:
+    LoserTree(const Less& less) : _less(less), _num_leaves(0), _num_alive(0) { }
+
+    // Build tree with all leaves alive, each leaf must have value
+    void init(int num_leaves) {
+        _num_leaves = num_leaves;
+        _num_alive = num_leaves;
+        _exhausted.assign(num_leaves, false);
+        _nodes.assign(num_leaves > 0 ? num_leaves : 1, -1);
+        if (num_leaves > 0) {
+            _nodes[0] = _build(1);
+        }
+    }
+
+    bool empty() const { return _num_alive == 0; }
+
+    // Leaf whose value is the smallest, only valid when not empty
+    int top() const { return _nodes[0]; }
+
+    // Value of top leaf has been changed, find the new winner
+    void update_top() {
+        _replay(_nodes[0]);
+    }
+
+    // Top leaf has no more value
+    void pop_top() {
+        _exhausted[_nodes[0]] = true;
+        _num_alive--;
+        _replay(_nodes[0]);
+    }
+
+private:
+    // Return true if leaf 'a' wins leaf 'b'
+    bool _beats(int a, int b) const {
+        if (_exhausted[b]) {
+            return !_exhausted[a] || a < b;
+        }
+        if (_exhausted[a]) {
+            return false;
+        }
+        if (_less(a, b)) {
+            return true;
+        }
+        return !_less(b, a) && a < b;
+    }
+
+    // Internal nodes are numbered from 1 to _num_leaves - 1, node i has
+    // children 2i and 2i + 1, and node (_num_leaves + i) is leaf i.
+    int _build(int node) {
+        if (node >= _num_leaves) {
+            return node - _num_leaves;
+        }
+        int left = _build(node * 2);
+        int right = _build(node * 2 + 1);
+        if (_beats(left, right)) {
+            _nodes[node] = right;
+            return left;
+        }
+        _nodes[node] = left;
+        return right;
+    }
+
+    void _replay(int leaf) {
+        int winner = leaf;
+        for (int node = (leaf + _num_leaves) / 2; node > 0; node /= 2) {
+            if (_beats(_nodes[node], winner)) {
+                std::swap(_nodes[node], winner);
+            }
+        }
+        _nodes[0] = winner;
+    }
+
+    Less _less;
+    int _num_leaves;
+    int _num_alive;
+    // _nodes[0] is the winner, others are losers of internal nodes
+    std::vector<int> _nodes;
+    std::vector<bool> _exhausted;
+};
+
+}
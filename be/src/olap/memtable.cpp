@@ -0,0 +1,258 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/memtable.h"
+
+#include "olap/writer.h"
+#include "runtime/datetime_value.h"
+#include "runtime/decimal_value.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/string_value.h"
+#include "runtime/tuple.h"
+#include "util/types.h"
+
+namespace palo {
+
+int MemTable::RowCursorComparator::operator()(char* const& l, char* const& r) const {
+    left->attach(l);
+    right->attach(r);
+    return left->full_key_cmp(*right);
+}
+
+MemTable::MemTable(const std::vector<FieldInfo>& tablet_schema,
+                   KeysType keys_type,
+                   const std::vector<const SlotDescriptor*>& col_slots,
+                   MemTracker* parent_mem_tracker) :
+        _tablet_schema(tablet_schema),
+        _keys_type(keys_type),
+        _col_slots(col_slots),
+        _parent_mem_tracker(parent_mem_tracker),
+        _scratch_buf(nullptr),
+        _num_filtered_rows(0) {
+}
+
+MemTable::MemTable(const std::vector<FieldInfo>& tablet_schema,
+                   KeysType keys_type,
+                   MemTracker* parent_mem_tracker) :
+        MemTable(tablet_schema, keys_type, std::vector<const SlotDescriptor*>(),
+                 parent_mem_tracker) {
+}
+
+MemTable::~MemTable() {
+    // skiplist nodes are allocated from arena, release list before arena
+    _skip_list.reset();
+    _scratch_pool.reset();
+    _arena.reset();
+    if (_mem_tracker != nullptr && _parent_mem_tracker != nullptr) {
+        _mem_tracker->unregister_from_parent();
+    }
+    delete[] _scratch_buf;
+}
+
+OLAPStatus MemTable::init() {
+    OLAPStatus res = _row_cursor.init(_tablet_schema);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init row cursor. [res=%d]", res);
+        return res;
+    }
+    res = _cmp_cursor.init(_tablet_schema);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init row cursor. [res=%d]", res);
+        return res;
+    }
+    res = _scratch_cursor.init(_tablet_schema);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to init row cursor. [res=%d]", res);
+        return res;
+    }
+
+    _scratch_buf = new(std::nothrow) char[_scratch_cursor.get_fixed_len()];
+    if (_scratch_buf == nullptr) {
+        OLAP_LOG_WARNING("fail to malloc scratch row. [size=%lu]",
+                         _scratch_cursor.get_fixed_len());
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+
+    _mem_tracker.reset(new MemTracker(-1, "MemTable", _parent_mem_tracker));
+    _arena.reset(new MemPool(_mem_tracker.get()));
+    _scratch_pool.reset(new MemPool(_mem_tracker.get()));
+    _skip_list.reset(new Table(RowCursorComparator(&_row_cursor, &_cmp_cursor), _arena.get()));
+    return OLAP_SUCCESS;
+}
+
+int64_t MemTable::memory_usage() const {
+    return _mem_tracker->consumption();
+}
+
+OLAPStatus MemTable::insert(Tuple* tuple) {
+    // row is converted into scratch buffer first, so that nothing is left
+    // in _arena if the conversion fails
+    _scratch_cursor.attach(_scratch_buf);
+    OLAPStatus res = _convert_tuple(tuple, &_scratch_cursor, _scratch_pool.get());
+    if (res != OLAP_SUCCESS) {
+        _scratch_pool->clear();
+        ++_num_filtered_rows;
+        return res;
+    }
+    _insert_row(_scratch_cursor);
+    _scratch_pool->clear();
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus MemTable::insert(const RowCursor& row) {
+    _insert_row(row);
+    return OLAP_SUCCESS;
+}
+
+void MemTable::_insert_row(const RowCursor& row) {
+    if (_keys_type == KeysType::DUP_KEYS) {
+        // every row is kept
+        char* row_buf = reinterpret_cast<char*>(_arena->allocate(_row_cursor.get_fixed_len()));
+        _row_cursor.attach(row_buf);
+        _row_cursor.copy(row, _arena.get());
+        _skip_list->insert(row_buf);
+        return;
+    }
+
+    char** found = _skip_list->find(row.get_buf());
+    if (found != nullptr) {
+        // comparator has attached _row_cursor to other rows, reattach here
+        _row_cursor.attach(*found);
+        _row_cursor.aggregate(row);
+    } else {
+        char* row_buf = reinterpret_cast<char*>(_arena->allocate(_row_cursor.get_fixed_len()));
+        _row_cursor.attach(row_buf);
+        _row_cursor.allocate_memory_for_string_type(_tablet_schema, _arena.get());
+        _row_cursor.agg_init(row);
+        _skip_list->insert(row_buf);
+    }
+}
+
+OLAPStatus MemTable::flush(RowCursor* row, IWriter* writer, uint32_t* num_rows) {
+    bool need_finalize = (_keys_type != KeysType::DUP_KEYS);
+    Table::Iterator it(_skip_list.get());
+    for (it.seek_to_first(); it.valid(); it.next()) {
+        OLAPStatus res = writer->attached_by(row);
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to attach row to writer. [res=%d]", res);
+            return res;
+        }
+        _row_cursor.attach(it.key());
+        if (need_finalize) {
+            res = _row_cursor.finalize_one_merge();
+            if (res != OLAP_SUCCESS) {
+                OLAP_LOG_WARNING("fail to finalize row. [res=%d]", res);
+                return res;
+            }
+        }
+        row->copy(_row_cursor, writer->mem_pool());
+        writer->next(*row);
+        ++(*num_rows);
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus MemTable::_convert_tuple(Tuple* tuple, RowCursor* row, MemPool* pool) {
+    for (size_t i = 0; i < _col_slots.size(); ++i) {
+        const SlotDescriptor* slot = _col_slots[i];
+        if (tuple->is_null(slot->null_indicator_offset())) {
+            if (!_tablet_schema[i].is_allow_null) {
+                OLAP_LOG_WARNING("null value for not null column. [column='%s']",
+                                 _tablet_schema[i].name.c_str());
+                return OLAP_ERR_INPUT_PARAMETER_ERROR;
+            }
+            row->set_null(i);
+            continue;
+        }
+        row->set_not_null(i);
+        const void* value = tuple->get_slot(slot->tuple_offset());
+        switch (_tablet_schema[i].type) {
+        case OLAP_FIELD_TYPE_CHAR: {
+            // char is stored with fixed length and padded with '\0'
+            const StringValue* str = reinterpret_cast<const StringValue*>(value);
+            size_t len = _tablet_schema[i].length;
+            if (str->len > len) {
+                OLAP_LOG_WARNING("char value is too long. [column='%s' len=%d]",
+                                 _tablet_schema[i].name.c_str(), str->len);
+                return OLAP_ERR_INPUT_PARAMETER_ERROR;
+            }
+            char* buf = reinterpret_cast<char*>(pool->allocate(len));
+            memset(buf + str->len, 0, len - str->len);
+            memcpy(buf, str->ptr, str->len);
+            StringSlice slice(buf, len);
+            memcpy(row->get_field_content_ptr(i), &slice, sizeof(slice));
+            break;
+        }
+        case OLAP_FIELD_TYPE_VARCHAR:
+        case OLAP_FIELD_TYPE_HLL: {
+            // string memory of aggregated rows is allocated by column length
+            const StringValue* str = reinterpret_cast<const StringValue*>(value);
+            size_t max_len = _tablet_schema[i].length - OLAP_STRING_MAX_BYTES;
+            if (str->len > max_len) {
+                OLAP_LOG_WARNING("varchar value is too long. [column='%s' len=%d max_len=%lu]",
+                                 _tablet_schema[i].name.c_str(), str->len, max_len);
+                return OLAP_ERR_INPUT_PARAMETER_ERROR;
+            }
+            StringSlice slice(str->ptr, str->len);
+            row->set_field_content(i, reinterpret_cast<const char*>(&slice), pool);
+            break;
+        }
+        case OLAP_FIELD_TYPE_DECIMAL: {
+            decimal12_t storage;
+            if (slot->type().type == TYPE_DECIMALV2) {
+                // int128 scaled by 10^9, whose integer part may not fit int64
+                DecimalV2Value dec = DecimalV2Value::from_raw(
+                    reinterpret_cast<const PackedInt128*>(value)->value);
+                __int128 int_value = dec.int_value();
+                if (int_value > INT64_MAX || int_value < INT64_MIN) {
+                    OLAP_LOG_WARNING("decimal value is out of range. [column='%s']",
+                                     _tablet_schema[i].name.c_str());
+                    return OLAP_ERR_INPUT_PARAMETER_ERROR;
+                }
+                storage.integer = static_cast<int64_t>(int_value);
+                storage.fraction = dec.frac_value();
+            } else {
+                const DecimalValue* dec = reinterpret_cast<const DecimalValue*>(value);
+                storage.integer = dec->int_value();
+                storage.fraction = dec->frac_value();
+            }
+            row->set_field_content(i, reinterpret_cast<const char*>(&storage), pool);
+            break;
+        }
+        case OLAP_FIELD_TYPE_DATE: {
+            const DateTimeValue* date = reinterpret_cast<const DateTimeValue*>(value);
+            uint64_t olap_date = date->to_olap_date();
+            // date is stored in 3 bytes, little endian
+            memcpy(row->get_field_content_ptr(i), &olap_date, sizeof(uint24_t));
+            break;
+        }
+        case OLAP_FIELD_TYPE_DATETIME: {
+            const DateTimeValue* datetime = reinterpret_cast<const DateTimeValue*>(value);
+            uint64_t olap_datetime = datetime->to_olap_datetime();
+            row->set_field_content(i, reinterpret_cast<const char*>(&olap_datetime), pool);
+            break;
+        }
+        default:
+            row->set_field_content(i, reinterpret_cast<const char*>(value), pool);
+            break;
+        }
+    }
+    return OLAP_SUCCESS;
+}
+
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "gen_cpp/olap_file.pb.h"
+#include "olap/field_info.h"
+#include "olap/olap_define.h"
+#include "olap/row_cursor.h"
+#include "olap/skiplist.h"
+
+namespace palo {
+
+class IWriter;
+class MemPool;
+class MemTracker;
+class SlotDescriptor;
+class Tuple;
+
+// MemTable keeps rows written into one tablet in memory, ordered by key.
+// For AGG_KEYS and UNIQUE_KEYS tables rows with same key are aggregated
+// when inserted, so only one row of each key is kept. For DUP_KEYS tables
+// all rows are kept in insertion order among equal keys.
+// It is NOT thread-safe.
+class MemTable {
+public:
+    MemTable(const std::vector<FieldInfo>& tablet_schema,
+             KeysType keys_type,
+             const std::vector<const SlotDescriptor*>& col_slots,
+             MemTracker* parent_mem_tracker = nullptr);
+    // Rows are only inserted in row format of tablet
+    MemTable(const std::vector<FieldInfo>& tablet_schema,
+             KeysType keys_type,
+             MemTracker* parent_mem_tracker = nullptr);
+    ~MemTable();
+
+    OLAPStatus init();
+
+    // Convert tuple into row format of tablet and insert it. Tuple which
+    // can't be converted, e.g. a string longer than its column, is counted
+    // as filtered and OLAP_ERR_INPUT_PARAMETER_ERROR is returned.
+    OLAPStatus insert(Tuple* tuple);
+
+    // Insert a row which is already in row format of tablet,
+    // its string values are copied.
+    OLAPStatus insert(const RowCursor& row);
+
+    // Write all rows into writer in key order. Writer is not finalized.
+    OLAPStatus flush(RowCursor* row, IWriter* writer, uint32_t* num_rows);
+
+    // Number of distinct rows kept in memory.
+    size_t size() const { return _skip_list->size(); }
+    int64_t memory_usage() const;
+    // Number of tuples which are not inserted because they can't be converted.
+    int64_t num_filtered_rows() const { return _num_filtered_rows; }
+
+private:
+    friend class MemTableTest;
+
+    struct RowCursorComparator {
+        RowCursorComparator(RowCursor* left, RowCursor* right) :
+            left(left), right(right) { }
+        int operator()(char* const& l, char* const& r) const;
+
+        RowCursor* left;
+        RowCursor* right;
+    };
+    typedef SkipList<char*, RowCursorComparator> Table;
+
+    OLAPStatus _convert_tuple(Tuple* tuple, RowCursor* row, MemPool* pool);
+    void _insert_row(const RowCursor& row);
+
+    const std::vector<FieldInfo>& _tablet_schema;
+    KeysType _keys_type;
+    // slot of each tablet column in input tuple
+    std::vector<const SlotDescriptor*> _col_slots;
+
+    MemTracker* _parent_mem_tracker;
+    std::unique_ptr<MemTracker> _mem_tracker;
+    // rows and their string values are allocated from _arena
+    std::unique_ptr<MemPool> _arena;
+    // strings of row being inserted into aggregate table, it is cleared
+    // after each insert because the row is copied into _arena
+    std::unique_ptr<MemPool> _scratch_pool;
+    char* _scratch_buf;
+
+    RowCursor _row_cursor;
+    RowCursor _cmp_cursor;
+    RowCursor _scratch_cursor;
+    std::unique_ptr<Table> _skip_list;
+    int64_t _num_filtered_rows;
+};
+
+}
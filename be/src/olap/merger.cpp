@@ -18,6 +18,8 @@
 #include <memory>
 #include <vector>
 
+#include "common/config.h"
+#include "olap/compaction_merger.h"
 #include "olap/i_data.h"
 #include "olap/olap_define.h"
 #include "olap/olap_index.h"
@@ -154,6 +156,13 @@ OLAPStatus Merger::_merge(
         const vector<IData*>& olap_data_arr,
         uint64_t* merged_rows,
         uint64_t* filted_rows) {
+    if (config::enable_compaction_merger
+            && (_reader_type == READER_BASE_COMPACTION
+                || _reader_type == READER_CUMULATIVE_COMPACTION)
+            && CompactionMerger::is_supported(_table, olap_data_arr)) {
+        return _compaction_merge(olap_data_arr, merged_rows, filted_rows);
+    }
+
     // Create and initiate reader for scanning and multi-merging specified
     // OLAPDatas.
     Reader reader;
@@ -281,5 +290,60 @@ OLAPStatus Merger::_merge(
     return has_error ? OLAP_ERR_OTHER_ERROR : OLAP_SUCCESS;
 }
 
+OLAPStatus Merger::_compaction_merge(
+        const vector<IData*>& olap_data_arr,
+        uint64_t* merged_rows,
+        uint64_t* filted_rows) {
+    CompactionMerger merger(_table, _reader_type, _index->version());
+    OLAPStatus res = merger.init(olap_data_arr);
+    if (OLAP_SUCCESS != res) {
+        OLAP_LOG_WARNING("fail to init compaction merger. [table='%s' res=%d]",
+                _table->full_name().c_str(), res);
+        return OLAP_ERR_INIT_FAILED;
+    }
+
+    unique_ptr<IWriter> writer(IWriter::create(_table, _index, false));
+    if (NULL == writer) {
+        OLAP_LOG_WARNING("fail to allocate writer.");
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+
+    if (OLAP_SUCCESS != writer->init()) {
+        OLAP_LOG_WARNING("fail to initiate writer. [table='%s']",
+                _table->full_name().c_str());
+        return OLAP_ERR_INIT_FAILED;
+    }
+
+    // We calculate selectivities only when base compactioning.
+    bool need_calculate_selectivities = (_index->version().first == 0);
+    bool has_error = false;
+    res = merger.merge(writer.get(), need_calculate_selectivities ? &_uniq_keys : NULL);
+    if (OLAP_SUCCESS != res) {
+        OLAP_LOG_WARNING("fail to merge. [table='%s' res=%d]",
+                _table->full_name().c_str(), res);
+        has_error = true;
+    }
+
+    if (OLAP_SUCCESS != writer->finalize()) {
+        OLAP_LOG_WARNING("fail to finalize writer. [table='%s']",
+                _table->full_name().c_str());
+        has_error = true;
+    }
+
+    _row_count = merger.row_count();
+    if (need_calculate_selectivities) {
+        for (size_t i = 0; i < _uniq_keys.size(); ++i) {
+            _selectivities[i]
+                = static_cast<uint32_t>(_row_count / _uniq_keys[i]);
+        }
+    }
+
+    if (!has_error) {
+        *merged_rows = merger.merged_rows();
+        *filted_rows = merger.filted_rows();
+    }
+
+    return has_error ? OLAP_ERR_OTHER_ERROR : OLAP_SUCCESS;
+}
 
 }  // namespace palo
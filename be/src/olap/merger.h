@@ -56,6 +56,12 @@ private:
             uint64_t* merged_rows,
             uint64_t* filted_rows);
 
+    // Merge with CompactionMerger instead of Reader
+    OLAPStatus _compaction_merge(
+            const std::vector<IData*>& olap_data_arr,
+            uint64_t* merged_rows,
+            uint64_t* filted_rows);
+
     bool _check_simple_merge(const std::vector<IData*>& olap_data_arr);
 
     OLAPStatus _create_hard_link();
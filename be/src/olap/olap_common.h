@@ -115,7 +115,8 @@ enum FieldAggregationMethod {
     OLAP_FIELD_AGGREGATION_MAX = 3,
     OLAP_FIELD_AGGREGATION_REPLACE = 4,
     OLAP_FIELD_AGGREGATION_HLL_UNION = 5,
-    OLAP_FIELD_AGGREGATION_UNKNOWN = 6
+    OLAP_FIELD_AGGREGATION_BITMAP_UNION = 6,
+    OLAP_FIELD_AGGREGATION_UNKNOWN = 7
 };
 
 // 压缩算法类型
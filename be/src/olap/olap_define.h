@@ -45,8 +45,6 @@ static const uint32_t OLAP_DEFAULT_COLUMN_DICT_KEY_SIZE_THRESHOLD = 80; // 30%
 static const size_t OLAP_LRU_CACHE_MAX_KEY_LENTH = OLAP_MAX_PATH_LEN * 2;
 
 static const uint64_t OLAP_FIX_HEADER_MAGIC_NUMBER = 0;
-// 执行be/ce时默认的候选集大小
-static constexpr uint32_t OLAP_COMPACTION_DEFAULT_CANDIDATE_SIZE = 10;
 
 // the max length supported for string type
 static const uint16_t OLAP_STRING_MAX_LENGTH = 65535;
@@ -71,6 +69,7 @@ static const std::string SNAPSHOT_PREFIX = "/snapshot";
 static const std::string TRASH_PREFIX = "/trash";
 static const std::string UNUSED_PREFIX = "/unused";
 static const std::string ERROR_LOG_PREFIX = "/error_log";
+static const std::string HEADER_STORE_PREFIX = "/header_store";
 
 static const int32_t OLAP_DATA_VERSION_APPLIED = PALO_V1;
 
@@ -257,6 +256,7 @@ enum OLAPStatus {
     // [-1400, -1500)
     OLAP_ERR_HEADER_ADD_VERSION = -1400,
     OLAP_ERR_HEADER_DELETE_VERSION = -1401,
+    OLAP_ERR_HEADER_NOT_FOUND = -1402,
 
     // OLAPTableSchema
     // [-1500, -1600)
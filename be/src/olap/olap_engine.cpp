@@ -20,7 +20,6 @@
 #include <algorithm>
 #include <cstdio>
 #include <new>
-#include <queue>
 #include <set>
 
 #include <boost/algorithm/string/classification.hpp>
@@ -28,8 +27,10 @@
 #include <boost/filesystem.hpp>
 #include <rapidjson/document.h>
 
-#include "olap/base_compaction.h"
-#include "olap/cumulative_compaction.h"
+#include "olap/compaction_scheduler.h"
+#include "olap/delete_handler.h"
+#include "olap/header_store.h"
+#include "olap/io_governor.h"
 #include "olap/lru_cache.h"
 #include "olap/olap_header.h"
 #include "olap/olap_rootpath.h"
@@ -49,7 +50,6 @@ using std::list;
 using std::map;
 using std::nothrow;
 using std::pair;
-using std::priority_queue;
 using std::set;
 using std::set_difference;
 using std::string;
@@ -70,17 +70,32 @@ bool _sort_table_by_create_time(const SmartOLAPTable& a, const SmartOLAPTable& b
 OLAPEngine::OLAPEngine() :
         _global_table_id(0),
         _file_descriptor_lru_cache(NULL),
-        _index_stream_lru_cache(NULL) {}
+        _index_stream_lru_cache(NULL),
+        _mem_index_lru_cache(NULL),
+        _delete_bitmap_task_cond(_delete_bitmap_task_lock) {}
 
 OLAPEngine::~OLAPEngine() {
     clear();
 }
 
 OLAPStatus OLAPEngine::_load_tables(const string& tablet_root_path) {
+    TabletLoadContext context;
+    context.root_path = tablet_root_path;
+    context.next_task = 0;
+    {
+        AutoMutexLock l(&_tablet_load_progress_lock);
+        TabletLoadProgress& progress = _tablet_load_progress[tablet_root_path];
+        progress = TabletLoadProgress();
+        progress.root_path = tablet_root_path;
+        progress.start_time = time(NULL);
+    }
+
     // 遍历跟目录寻找所有的shard
     set<string> shards;
     if (dir_walk(tablet_root_path + DATA_PREFIX, &shards, NULL) != OLAP_SUCCESS) {
         OLAP_LOG_WARNING("fail to walk dir. [root=%s]", tablet_root_path.c_str());
+        AutoMutexLock l(&_tablet_load_progress_lock);
+        _tablet_load_progress[tablet_root_path].finish_time = time(NULL);
         return OLAP_ERR_INIT_FAILED;
     }
 
@@ -103,25 +118,168 @@ OLAPStatus OLAPEngine::_load_tables(const string& tablet_root_path) {
             }
 
             for (const auto& schema_hash : schema_hashes) {
-                TTabletId tablet_id = strtoul(tablet.c_str(), NULL, 10);
-                TSchemaHash tablet_schema_hash = strtoul(schema_hash.c_str(), NULL, 10);
-
-                // 遍历schema_hash目录寻找此index的所有schema
-                // 加载失败依然加载下一个Table
-                if (load_one_tablet(
-                        tablet_id,
-                        tablet_schema_hash,
-                        one_tablet_path + '/' + schema_hash) != OLAP_SUCCESS) {
-                    OLAP_LOG_WARNING("fail to load one table, but continue. [path='%s']",
-                                     (one_tablet_path + '/' + schema_hash).c_str());
-                }
+                TabletLoadTask task;
+                task.tablet_id = strtoul(tablet.c_str(), NULL, 10);
+                task.schema_hash = strtoul(schema_hash.c_str(), NULL, 10);
+                task.schema_hash_path = one_tablet_path + '/' + schema_hash;
+                context.tasks.push_back(task);
             }
         }
     }
 
+    {
+        AutoMutexLock l(&_tablet_load_progress_lock);
+        _tablet_load_progress[tablet_root_path].num_tablets = context.tasks.size();
+    }
+
+    // 只加载header, 数据和索引在第一次访问时加载
+    int32_t num_threads = config::load_tablet_num_threads_per_disk;
+    if (num_threads <= 0) {
+        OLAP_LOG_WARNING("load tablet thread number config is illegal: [%d], "
+                         "force set to 1", num_threads);
+        num_threads = 1;
+    }
+    if (static_cast<size_t>(num_threads) > context.tasks.size()) {
+        num_threads = context.tasks.size();
+    }
+    vector<pthread_t> threads;
+    for (int32_t i = 0; i < num_threads; ++i) {
+        pthread_t thread;
+        if (0 != pthread_create(&thread, NULL, _load_tablet_thread_callback, &context)) {
+            OLAP_LOG_WARNING("failed to start load tablet thread. [root=%s]",
+                             tablet_root_path.c_str());
+            break;
+        }
+        threads.push_back(thread);
+    }
+    if (threads.empty()) {
+        // 线程创建失败时在当前线程加载
+        _load_tablet_thread_callback(&context);
+    }
+    for (pthread_t thread : threads) {
+        pthread_join(thread, NULL);
+    }
+
+    // 删除header store中目录已经不存在的table, 加载失败的table目录已被移到trash
+    DiskHeaderStore* header_store = HeaderStore::get_instance()->get_disk(
+            tablet_root_path + DATA_PREFIX + '/');
+    if (header_store != NULL) {
+        set<string> header_files;
+        for (const TabletLoadTask& task : context.tasks) {
+            if (check_dir_existed(task.schema_hash_path)) {
+                stringstream header_name_stream;
+                header_name_stream << task.schema_hash_path << "/" << task.tablet_id << ".hdr";
+                header_files.insert(header_name_stream.str());
+            }
+        }
+        if (header_store->retain(header_files) != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to remove unused headers. [root=%s]",
+                             tablet_root_path.c_str());
+        }
+    }
+
+    AutoMutexLock l(&_tablet_load_progress_lock);
+    TabletLoadProgress& progress = _tablet_load_progress[tablet_root_path];
+    progress.finish_time = time(NULL);
+    OLAP_LOG_INFO("finish to load tablets. [root=%s tablets=%ld failed=%ld cost=%lds]",
+                  tablet_root_path.c_str(), progress.num_tablets, progress.num_failed,
+                  progress.finish_time - progress.start_time);
     return OLAP_SUCCESS;
 }
 
+void* OLAPEngine::_load_tablet_thread_callback(void* arg) {
+    TabletLoadContext* context = static_cast<TabletLoadContext*>(arg);
+    OLAPEngine* engine = OLAPEngine::get_instance();
+    while (true) {
+        size_t i = atomic_inc_return(&context->next_task) - 1;
+        if (i >= context->tasks.size()) {
+            break;
+        }
+
+        // 加载失败依然加载下一个Table
+        const TabletLoadTask& task = context->tasks[i];
+        bool success = engine->load_one_tablet(
+                task.tablet_id, task.schema_hash, task.schema_hash_path) == OLAP_SUCCESS;
+        if (!success) {
+            OLAP_LOG_WARNING("fail to load one table, but continue. [path='%s']",
+                             task.schema_hash_path.c_str());
+        }
+
+        AutoMutexLock l(&engine->_tablet_load_progress_lock);
+        TabletLoadProgress& progress = engine->_tablet_load_progress[context->root_path];
+        ++progress.num_loaded;
+        if (!success) {
+            ++progress.num_failed;
+        }
+    }
+
+    return NULL;
+}
+
+void OLAPEngine::get_tablet_load_progress(vector<TabletLoadProgress>* progress) {
+    AutoMutexLock l(&_tablet_load_progress_lock);
+    for (const auto& it : _tablet_load_progress) {
+        progress->push_back(it.second);
+    }
+}
+
+void OLAPEngine::count_loaded_tables(int64_t* num_tables, int64_t* num_loaded) {
+    *num_tables = 0;
+    *num_loaded = 0;
+    AutoRWLock auto_lock(&_tablet_map_lock, true);
+    for (const auto& it : _tablet_map) {
+        for (const SmartOLAPTable& table : it.second.table_arr) {
+            ++*num_tables;
+            if (table->is_loaded()) {
+                ++*num_loaded;
+            }
+        }
+    }
+}
+
+void OLAPEngine::add_delete_bitmap_task(
+        TTabletId tablet_id, SchemaHash schema_hash, int32_t version) {
+    AutoMutexLock l(&_delete_bitmap_task_lock);
+    _delete_bitmap_tasks.push_back({tablet_id, schema_hash, version});
+    _delete_bitmap_task_cond.notify();
+}
+
+void OLAPEngine::run_delete_bitmap_task() {
+    DeleteBitmapTask task;
+    {
+        AutoMutexLock l(&_delete_bitmap_task_lock);
+        while (_delete_bitmap_tasks.empty()) {
+            _delete_bitmap_task_cond.wait();
+        }
+        task = _delete_bitmap_tasks.front();
+        _delete_bitmap_tasks.pop_front();
+    }
+
+    // table may be dropped or replaced by clone after the task is added
+    SmartOLAPTable table = get_table(task.tablet_id, task.schema_hash);
+    if (table.get() == NULL) {
+        OLAP_LOG_INFO("table is not found, skip building delete bitmaps. "
+                      "[tablet_id=%ld schema_hash=%d version=%d]",
+                      task.tablet_id, task.schema_hash, task.version);
+        return;
+    }
+
+    DeleteConditionHandler del_cond_handler;
+    OLAPStatus res = del_cond_handler.build_delete_bitmaps(table, task.version);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to build delete bitmaps. [res=%d table='%s' version=%d]",
+                         res, table->full_name().c_str(), task.version);
+        return;
+    }
+
+    table->obtain_header_wrlock();
+    if (del_cond_handler.mark_delete_bitmap(table, task.version) == OLAP_SUCCESS
+            && table->save_header() != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to save header. [table='%s']", table->full_name().c_str());
+    }
+    table->release_header_lock();
+}
+
 OLAPStatus OLAPEngine::load_one_tablet(
         TTabletId tablet_id, SchemaHash schema_hash, const string& schema_hash_path) {
     stringstream header_name_stream;
@@ -129,7 +287,10 @@ OLAPStatus OLAPEngine::load_one_tablet(
     string header_path = header_name_stream.str();
     path boost_schema_hash_path(schema_hash_path);
 
-    if (access(header_path.c_str(), F_OK) != 0) {
+    // header file put by clone or migration overrides header in store
+    DiskHeaderStore* header_store = HeaderStore::get_instance()->get_disk(header_path);
+    bool has_header_file = access(header_path.c_str(), F_OK) == 0;
+    if (!has_header_file && (header_store == NULL || !header_store->contains(header_path))) {
         OLAP_LOG_WARNING("fail to find header file. [header_path=%s]", header_path.c_str());
         move_to_trash(boost_schema_hash_path, boost_schema_hash_path);
         return OLAP_ERR_FILE_NOT_EXIST;
@@ -179,6 +340,16 @@ OLAPStatus OLAPEngine::load_one_tablet(
         return OLAP_ERR_ENGINE_LOAD_INDEX_TABLE_ERROR;
     }
 
+    // 将header文件转存到header store中, 失败时header文件仍然有效
+    if (has_header_file && header_store != NULL) {
+        olap_table->obtain_header_wrlock();
+        if (olap_table->save_header() != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to save header into header store. [header_path=%s]",
+                             header_path.c_str());
+        }
+        olap_table->release_header_lock();
+    }
+
     OLAP_LOG_DEBUG("succeed to add table. [table=%s, path=%s]",
                    olap_table->full_name().c_str(),
                    schema_hash_path.c_str());
@@ -259,23 +430,34 @@ OLAPStatus OLAPEngine::init() {
         return OLAP_ERR_INIT_FAILED;
     }
 
-    // 初始化CE调度器
+    // 短key索引按需加载, 内存使用超过上限时淘汰最近最少使用的索引
+    // 索引可能在engine清理后才析构, 因此该cache不释放
+    if (_mem_index_lru_cache == NULL) {
+        _mem_index_lru_cache = new_lru_cache(config::mem_index_cache_capacity);
+    }
+    if (_mem_index_lru_cache == NULL) {
+        OLAP_LOG_WARNING("failed to init mem index LRUCache");
+        _tablet_map.clear();
+        return OLAP_ERR_INIT_FAILED;
+    }
+
+    // 初始化各个root path的IO限速
     vector<RootPathInfo> all_root_paths_info;
     OLAPRootPath::get_instance()->get_all_root_path_info(&all_root_paths_info);
-    _cumulative_compaction_disk_stat.reserve(all_root_paths_info.size());
-    for (uint32_t i = 0; i < all_root_paths_info.size(); i++) {
-        const RootPathInfo& info = all_root_paths_info[i];
-        _cumulative_compaction_disk_stat.emplace_back(info.path, i, info.is_used);
-        _disk_id_map[info.path] = i;
-    }
-    int32_t cumulative_compaction_num_threads = config::cumulative_compaction_num_threads;
-    int32_t base_compaction_num_threads = config::base_compaction_num_threads;
-    uint32_t file_system_num = OLAPRootPath::get_instance()->get_file_system_count();
-    _max_cumulative_compaction_task_per_disk = (cumulative_compaction_num_threads + file_system_num - 1) / file_system_num;
-    _max_base_compaction_task_per_disk = (base_compaction_num_threads + file_system_num - 1) / file_system_num;
+    vector<string> all_root_paths;
+    for (const RootPathInfo& info : all_root_paths_info) {
+        all_root_paths.push_back(info.path);
+    }
+    IOGovernor::get_instance()->init(all_root_paths);
 
     // 加载所有table
     OLAPRootPath::get_instance()->get_all_available_root_path(&all_available_root_path);
+    if (config::enable_header_store
+            && HeaderStore::get_instance()->init(all_available_root_path) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("failed to init header store");
+        _tablet_map.clear();
+        return OLAP_ERR_INIT_FAILED;
+    }
     load_root_paths(all_available_root_path);
 
     // 取消未完成的SchemaChange任务
@@ -426,11 +608,12 @@ OLAPStatus OLAPEngine::add_table(TTabletId tablet_id, SchemaHash schema_hash, OL
 
     if (new_version > old_version
             || (new_version == old_version && new_time > old_time)) {
-        drop_table(tablet_id, schema_hash);
-        _tablet_map_lock.wrlock();
-        _tablet_map[tablet_id].table_arr.push_back(smart_table);
-        _tablet_map[tablet_id].table_arr.sort(_sort_table_by_create_time);
-        _tablet_map_lock.unlock();
+        // the new table is deleted with its files if it can't replace the old
+        // one, so that clone fails rather than keeps the old table silently
+        res = _replace_table(table_item, smart_table);
+        if (res != OLAP_SUCCESS) {
+            smart_table->mark_dropped();
+        }
     } else {
         smart_table->mark_dropped();
         res = OLAP_ERR_ENGINE_INSERT_EXISTS_TABLE;
@@ -443,6 +626,74 @@ OLAPStatus OLAPEngine::add_table(TTabletId tablet_id, SchemaHash schema_hash, OL
     return res;
 }
 
+OLAPStatus OLAPEngine::_replace_table(SmartOLAPTable old_table, SmartOLAPTable new_table) {
+    TTabletId tablet_id = old_table->tablet_id();
+    SchemaHash schema_hash = old_table->schema_hash();
+
+    // same as drop_table, base table in schema change cannot be dropped
+    AlterTabletType type;
+    TTabletId related_tablet_id;
+    TSchemaHash related_schema_hash;
+    vector<Version> schema_change_versions;
+    old_table->obtain_header_rdlock();
+    bool is_schema_changing = old_table->get_schema_change_request(
+            &related_tablet_id, &related_schema_hash, &schema_change_versions, &type);
+    old_table->release_header_lock();
+
+    SmartOLAPTable related_table;
+    if (is_schema_changing) {
+        related_table = get_table(related_tablet_id, related_schema_hash);
+        if (related_table.get() != NULL && !schema_change_versions.empty()
+                && old_table->creation_time() < related_table->creation_time()) {
+            OLAP_LOG_WARNING("base table in schema change cannot be replaced. [table=%s]",
+                             old_table->full_name().c_str());
+            return OLAP_ERR_PREVIOUS_SCHEMA_CHANGE_NOT_FINISHED;
+        }
+    }
+
+    // readers get either the old table or the new one, never neither
+    _tablet_map_lock.wrlock();
+    bool replaced = false;
+    for (SmartOLAPTable& item : _tablet_map[tablet_id].table_arr) {
+        if (item == old_table) {
+            item = new_table;
+            replaced = true;
+            break;
+        }
+    }
+    if (!replaced) {
+        if (_tablet_map[tablet_id].table_arr.empty()) {
+            _tablet_map.erase(tablet_id);
+        }
+        _tablet_map_lock.unlock();
+        OLAP_LOG_WARNING("table is dropped or replaced when replacing it. "
+                         "[tablet_id=%ld schema_hash=%d]", tablet_id, schema_hash);
+        return OLAP_ERR_TABLE_NOT_FOUND;
+    }
+    old_table->mark_dropped();
+    _tablet_map[tablet_id].table_arr.sort(_sort_table_by_create_time);
+    _tablet_map_lock.unlock();
+
+    if (related_table.get() != NULL) {
+        related_table->obtain_header_wrlock();
+        related_table->clear_schema_change_request();
+        OLAPStatus res = related_table->save_header();
+        related_table->release_header_lock();
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_FATAL("fail to save table header. [res=%d table=%s]",
+                           res, related_table->full_name().c_str());
+        }
+    }
+
+    OLAPStatus res = OLAPRootPath::get_instance()->unregister_table_from_root_path(
+            old_table.get());
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to unregister from root path. [res=%d table=%ld]",
+                         res, tablet_id);
+    }
+    return OLAP_SUCCESS;
+}
+
 // Drop table specified, the main logical is as follows:
 // 1. table not in schema change:
 //      drop specified table directly;
@@ -808,6 +1059,10 @@ OLAPStatus OLAPEngine::report_tablet_info(TTabletInfo* tablet_info) {
     }
     olap_table->release_header_lock();
 
+    if (olap_table->schema_change_status().status == ALTER_TABLE_RUNNING) {
+        tablet_info->__set_alter_progress(olap_table->alter_progress());
+    }
+
     return res;
 }
 
@@ -851,6 +1106,10 @@ OLAPStatus OLAPEngine::report_all_tablets_info(
             }
             olap_table->release_header_lock();
 
+            if (olap_table->schema_change_status().status == ALTER_TABLE_RUNNING) {
+                tablet_info.__set_alter_progress(olap_table->alter_progress());
+            }
+
             if (available_storage_medium_type_count > 1) {
                 tablet_info.__set_storage_medium(TStorageMedium::HDD);
                 if (OLAPRootPath::is_ssd_disk(olap_table->storage_root_path_name())) {
@@ -872,7 +1131,7 @@ OLAPStatus OLAPEngine::report_all_tablets_info(
     return OLAP_SUCCESS;
 }
 
-bool OLAPEngine::_can_do_compaction(SmartOLAPTable table) {
+bool OLAPEngine::can_do_compaction(SmartOLAPTable table) {
     // 如果table正在做schema change，则通过选路判断数据是否转换完成
     // 如果选路成功，则转换完成，可以进行BE
     // 如果选路失败，则转换未完成，不能进行BE
@@ -902,217 +1161,14 @@ void OLAPEngine::start_clean_fd_cache() {
     OLAP_LOG_TRACE("end clean file descritpor cache");
 }
 
-void OLAPEngine::start_base_compaction(string* last_base_compaction_fs, TTabletId* last_base_compaction_tablet_id) {
-    uint64_t base_compaction_start_hour = config::base_compaction_start_hour;
-    uint64_t base_compaction_end_hour = config::base_compaction_end_hour;
-    time_t current_time = time(NULL);
-    uint64_t current_hour = localtime(&current_time)->tm_hour;
-    // 如果执行BE的时间区间设置为类似以下的形式：[1:00, 8:00)
-    if (base_compaction_start_hour <= base_compaction_end_hour) {
-        if (current_hour < base_compaction_start_hour
-                || current_hour >= base_compaction_end_hour) {
-            OLAP_LOG_TRACE("don't allow to excute base compaction in this time interval. "
-                           "[now_hour=%d; allow_start_time=%d; allow_end_time=%d]",
-                           current_hour,
-                           base_compaction_start_hour,
-                           base_compaction_end_hour);
-            return;
-        }
-    } else { // 如果执行BE的时间区间设置为类似以下的形式：[22:00, 8:00)
-        if (current_hour < base_compaction_start_hour
-                && current_hour >= base_compaction_end_hour) {
-            OLAP_LOG_TRACE("don't allow to excute base compaction in this time interval. "
-                           "[now_hour=%d; allow_start_time=%d; allow_end_time=%d]",
-                           current_hour,
-                           base_compaction_start_hour,
-                           base_compaction_end_hour);
-            return;
-        }
-    }
-
-    SmartOLAPTable tablet;
-    BaseCompaction base_compaction;
-
-    bool do_base_compaction = false;
-    OLAP_LOG_TRACE("start_base_compaction begin.");
+void OLAPEngine::update_compaction_scores() {
     _tablet_map_lock.rdlock();
-    _fs_task_mutex.lock();
-
-    if (*last_base_compaction_fs != "") {
-        _fs_base_compaction_task_num_map[*last_base_compaction_fs] -= 1;
-        last_base_compaction_fs->clear();
-    }
-
     for (const auto& i : _tablet_map) {
-        for (SmartOLAPTable j : i.second.table_arr) {
-            // 保证从上一次被选中进行BE的表开始轮询
-            if (i.first <= *last_base_compaction_tablet_id) {
-                continue;
-            }
-
-            if (_fs_base_compaction_task_num_map[j->storage_root_path_name()] >= _max_base_compaction_task_per_disk) {
-                continue;
-            }
-
-            // 跳过正在做schema change的tablet
-            if (!_can_do_compaction(j)) {
-                OLAP_LOG_DEBUG("skip tablet, it is schema changing. [tablet=%s]",
-                               j->full_name().c_str());
-                continue;
-            }
-
-            if (base_compaction.init(j, false) == OLAP_SUCCESS) {
-                tablet = j;
-                do_base_compaction = true;
-                _fs_base_compaction_task_num_map[tablet->storage_root_path_name()] += 1;
-                *last_base_compaction_fs = tablet->storage_root_path_name();
-                *last_base_compaction_tablet_id = i.first;
-                goto TRY_START_BE_OK;
-            }
-        }
-    }
-
-    // when the loop comes the end, restart from begin
-    *last_base_compaction_tablet_id = -1;
-
-TRY_START_BE_OK:
-    _fs_task_mutex.unlock();
-    _tablet_map_lock.unlock();
-    OLAP_LOG_TRACE("start_base_compaction end.");
-
-    if (do_base_compaction) {
-        OLAP_LOG_NOTICE_PUSH("request", "START_BASE_COMPACTION");
-        OLAPStatus cmd_res = base_compaction.run();
-        if (cmd_res != OLAP_SUCCESS) {
-            OLAP_LOG_WARNING("failed to do base compaction. [tablet='%s']",
-                             tablet->full_name().c_str());
-        }
-    }
-}
-
-void OLAPEngine::_select_candidate() {
-    // 这是一个小根堆，用于记录nice最大的top k个candidate tablet
-    SmartOLAPTable tablet;
-    typedef priority_queue<CompactionCandidate, vector<CompactionCandidate>,
-            CompactionCandidateComparator> candidate_heap_t;
-    vector<candidate_heap_t> candidate_heap_vec(_cumulative_compaction_disk_stat.size());
-    for (const auto& i : _tablet_map) {
-        uint32_t nice = 0;
-        // calc nice
-        for (SmartOLAPTable j : i.second.table_arr) {
-            if (!j->is_loaded()) {
-                continue;
-            }
-
-            j->obtain_header_rdlock();
-            const uint32_t curr_nice = j->get_compaction_nice_estimate();
-            j->release_header_lock();
-            nice = curr_nice > nice ? curr_nice : nice;
-            tablet = j;
-        }
-
-        // save
-        if (nice > 0) {
-            uint32_t disk_id = _disk_id_map[tablet->storage_root_path_name()];
-            candidate_heap_vec[disk_id].emplace(nice, i.first, disk_id);
-            if (candidate_heap_vec[disk_id].size() > OLAP_COMPACTION_DEFAULT_CANDIDATE_SIZE) {
-                candidate_heap_vec[disk_id].pop();
-            }
-        }
-    }
-
-    _cumulative_compaction_candidate.clear();
-    for (auto& stat : _cumulative_compaction_disk_stat) {
-        stat.task_remaining = 0;
-    }
-
-    for (auto& candidate_heap : candidate_heap_vec) {
-        while (!candidate_heap.empty()) {
-            _cumulative_compaction_candidate.push_back(candidate_heap.top());
-            ++_cumulative_compaction_disk_stat[candidate_heap.top().disk_index].task_remaining;
-            candidate_heap.pop();
-        }
-    }
-
-    // sort small to big
-    sort(_cumulative_compaction_candidate.rbegin(), _cumulative_compaction_candidate.rend(), CompactionCandidateComparator());
-}
-
-void OLAPEngine::start_cumulative_priority() {
-    _tablet_map_lock.rdlock();
-    _fs_task_mutex.lock();
-
-    // determine whether to select candidate or not 
-    bool is_select = false;
-    vector<RootPathInfo> all_root_paths_info;
-    OLAPRootPath::get_instance()->get_all_root_path_info(&all_root_paths_info);
-    for (uint32_t i = 0; i < all_root_paths_info.size(); i++) {
-        uint32_t disk_id = _disk_id_map[all_root_paths_info[i].path];
-        _cumulative_compaction_disk_stat[disk_id].is_used = all_root_paths_info[i].is_used;
-    }
-
-    for (auto& disk : _cumulative_compaction_disk_stat) {
-        if (!disk.task_remaining && disk.is_used) {
-            is_select = true;
-        }
-    }
-
-    if (is_select) {
-        _select_candidate();
-    }
-
-    // traverse _cumulative_compaction_candidate to start cumulative compaction
-    CumulativeCompaction cumulative_compaction;
-    for (auto it_cand = _cumulative_compaction_candidate.rbegin(); it_cand != _cumulative_compaction_candidate.rend(); ++it_cand) {
-        CompactionCandidate candidate = *it_cand;
-        const auto i = _tablet_map.find(candidate.tablet_id);
-        if (i == _tablet_map.end()) {
-            // tablet已经不存在
-            _cumulative_compaction_candidate.erase(it_cand.base() - 1);
-            --_cumulative_compaction_disk_stat[candidate.disk_index].task_remaining;
-            continue;
-        }
-
-        if (_cumulative_compaction_disk_stat[candidate.disk_index].task_running >= _max_cumulative_compaction_task_per_disk) {
-            OLAP_LOG_DEBUG("skip tablet, too much ce task on disk %s",
-                    _cumulative_compaction_disk_stat[candidate.disk_index].storage_path.c_str());
-            // 某个disk上任务数太多，跳过，candidate中保留这个任务
-            continue;
-        }
-
-        for (SmartOLAPTable j : i->second.table_arr) {
-            if (!_can_do_compaction(j)) {
-                OLAP_LOG_DEBUG("skip tablet, it is schema changing. [tablet=%s]",
-                               j->full_name().c_str());
-                continue;
-            }
-
-            if (cumulative_compaction.init(j) == OLAP_SUCCESS) {
-                _cumulative_compaction_candidate.erase(it_cand.base() - 1);
-                --_cumulative_compaction_disk_stat[candidate.disk_index].task_remaining;
-                ++_cumulative_compaction_disk_stat[candidate.disk_index].task_running;
-                _fs_task_mutex.unlock();
-                _tablet_map_lock.unlock();
-
-                // start cumulative
-                if (cumulative_compaction.run() != OLAP_SUCCESS) {
-                    OLAP_LOG_WARNING("failed to do cumulative. [tablet='%s']",
-                                     j->full_name().c_str());
-                }
-
-                _fs_task_mutex.lock();
-                --_cumulative_compaction_disk_stat[candidate.disk_index].task_running;
-                _fs_task_mutex.unlock();
-                return;
-            }
+        for (SmartOLAPTable table : i.second.table_arr) {
+            CompactionScheduler::get_instance()->update_score(table);
         }
-        // 这个tablet不适合做ce
-        _cumulative_compaction_candidate.erase(it_cand.base() - 1);
-        --_cumulative_compaction_disk_stat[candidate.disk_index].task_remaining;
     }
-    _fs_task_mutex.unlock();
     _tablet_map_lock.unlock();
-    OLAP_LOG_TRACE("no tablet selected to do cumulative compaction this loop.");
 }
 
 void OLAPEngine::get_cache_status(rapidjson::Document* document) const {
@@ -1314,7 +1370,9 @@ OLAPStatus OLAPEngine::_create_new_table_header_file(
         EnumToString(TPrimitiveType, column.column_type.type, data_type);
         header.mutable_column(i)->set_type(data_type);
 
-        if (column.column_type.type == TPrimitiveType::DECIMAL) {
+        // DECIMALV2 is stored as decimal12_t like DECIMAL
+        if (column.column_type.type == TPrimitiveType::DECIMAL
+                || column.column_type.type == TPrimitiveType::DECIMALV2) {
             if (column.column_type.__isset.precision && column.column_type.__isset.scale) {
                 header.mutable_column(i)->set_precision(column.column_type.precision);
                 header.mutable_column(i)->set_frac(column.column_type.scale);
@@ -17,6 +17,7 @@
 #define BDG_PALO_BE_SRC_OLAP_OLAP_ENGINE_H
 
 #include <ctime>
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
@@ -28,6 +29,7 @@
 
 #include "gen_cpp/AgentService_types.h"
 #include "gen_cpp/MasterService_types.h"
+#include "olap/atomic.h"
 #include "olap/lru_cache.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
@@ -41,6 +43,21 @@ void* load_root_path_thread_callback(void* arg);
 
 class OLAPTable;
 
+// Progress of loading tablet headers of a root path on start
+struct TabletLoadProgress {
+    TabletLoadProgress() :
+            num_tablets(0), num_loaded(0), num_failed(0), start_time(0), finish_time(0) {}
+
+    std::string root_path;
+    // number of tablets found in root path
+    int64_t num_tablets;
+    int64_t num_loaded;
+    int64_t num_failed;
+    time_t start_time;
+    // 0 if it's still loading
+    time_t finish_time;
+};
+
 // OLAPEngine singleton to manage all Table pointers.
 // Providing add/drop/get operations.
 // OLAPEngine instance doesn't own the Table resources, just hold the pointer,
@@ -110,10 +127,12 @@ public:
     OLAPStatus clear();
 
     void start_clean_fd_cache();
-    void start_base_compaction(std::string* last_base_compaction_fs, TTabletId* last_base_compaction_tablet_id);
 
-    // 调度ce，优先级调度
-    void start_cumulative_priority();
+    // Compute compaction scores of all tablets, see CompactionScheduler
+    void update_compaction_scores();
+
+    // 正在做schema change且数据还未转换完成的table不能做compaction
+    bool can_do_compaction(SmartOLAPTable table);
 
     // 获取cache的使用情况信息
     void get_cache_status(rapidjson::Document* document) const;
@@ -134,55 +153,67 @@ public:
         return _file_descriptor_lru_cache;
     }
 
+    Cache* mem_index_lru_cache() {
+        return _mem_index_lru_cache;
+    }
+
     // 清理trash和snapshot文件，返回清理后的磁盘使用量
     OLAPStatus start_trash_sweep(double *usage);
 
+    // 启动时各root path加载tablet header的进度
+    void get_tablet_load_progress(std::vector<TabletLoadProgress>* progress);
+
+    // 统计所有table以及已经加载数据和索引的table的个数
+    void count_loaded_tables(int64_t* num_tables, int64_t* num_loaded);
+
+    // 在后台为version对应的删除条件生成delete bitmap，生成失败时读取仍然使用删除条件过滤
+    void add_delete_bitmap_task(TTabletId tablet_id, SchemaHash schema_hash, int32_t version);
+
+    // 等待并执行一个生成delete bitmap的任务，由OLAPServer的后台线程循环调用
+    void run_delete_bitmap_task();
+
 private:
     struct TableInstances {
         MutexLock schema_change_lock;
         std::list<SmartOLAPTable> table_arr;
     };
 
-    struct CompactionCandidate {
-        CompactionCandidate(uint32_t nicumulative_compaction_, int64_t tablet_id_, uint32_t index_) :
-                nice(nicumulative_compaction_), tablet_id(tablet_id_), disk_index(index_) {}
-        uint32_t nice; // 优先度
-        int64_t tablet_id;
-        uint32_t disk_index = -1;
-    };
+    typedef std::map<int64_t, TableInstances> tablet_map_t;
 
-    struct CompactionCandidateComparator {
-        bool operator()(const CompactionCandidate& a, const CompactionCandidate& b) {
-            return a.nice > b.nice;
-        }
+    struct DeleteBitmapTask {
+        TTabletId tablet_id;
+        SchemaHash schema_hash;
+        int32_t version;
     };
 
-    struct CompactionDiskStat {
-        CompactionDiskStat(std::string path, uint32_t index, bool used) :
-                storage_path(path),
-                disk_index(index),
-                task_running(0),
-                task_remaining(0),
-                is_used(used){}
-        const std::string storage_path;
-        const uint32_t disk_index;
-        uint32_t task_running;
-        uint32_t task_remaining;
-        bool is_used;
+    struct TabletLoadTask {
+        TTabletId tablet_id;
+        SchemaHash schema_hash;
+        std::string schema_hash_path;
     };
 
-    typedef std::map<int64_t, TableInstances> tablet_map_t;
-    typedef std::map<std::string, uint32_t> file_system_task_count_t;
+    // tablets of one root path, shared by load threads of the root path
+    struct TabletLoadContext {
+        std::string root_path;
+        std::vector<TabletLoadTask> tasks;
+        atomic_t next_task;
+    };
 
     SmartOLAPTable _get_table_with_no_lock(TTabletId tablet_id, SchemaHash schema_hash);
 
+    // Replace old_table by new_table which is newer, e.g. a lagging tablet
+    // cloned again. Fail without changing anything if old_table is base of an
+    // unfinished schema change or it's dropped or replaced by others.
+    OLAPStatus _replace_table(SmartOLAPTable old_table, SmartOLAPTable new_table);
+
     // 遍历root所指定目录, 通过dirs返回此目录下所有有文件夹的名字, files返回所有文件的名字
     OLAPStatus _dir_walk(const std::string& root,
                      std::set<std::string>* dirs,
                      std::set<std::string>* files);
 
-    // 扫描目录, 加载表
+    // 扫描目录, 由多个线程并发加载表的header
     OLAPStatus _load_tables(const std::string& tables_root_path);
+    static void* _load_tablet_thread_callback(void* arg);
 
     OLAPStatus _create_new_table_header_file(const TCreateTabletReq& request,
                                              const std::string& root_path,
@@ -192,10 +223,6 @@ private:
 
     OLAPStatus _check_existed_or_else_create_dir(const std::string& path);
 
-    bool _can_do_compaction(SmartOLAPTable table);
-
-    void _select_candidate();
-
     void _cancel_unfinished_schema_change();
 
     static OLAPStatus _spawn_load_root_path_thread(pthread_t* thread, const std::string& root_path);
@@ -208,14 +235,15 @@ private:
     size_t _global_table_id;
     Cache* _file_descriptor_lru_cache;
     Cache* _index_stream_lru_cache;
-    uint32_t _max_base_compaction_task_per_disk;
-    uint32_t _max_cumulative_compaction_task_per_disk;
-
-    MutexLock _fs_task_mutex;
-    file_system_task_count_t _fs_base_compaction_task_num_map;
-    std::vector<CompactionCandidate> _cumulative_compaction_candidate;
-    std::vector<CompactionDiskStat> _cumulative_compaction_disk_stat;
-    std::map<std::string, uint32_t> _disk_id_map;
+    Cache* _mem_index_lru_cache;
+
+    MutexLock _tablet_load_progress_lock;
+    // key is root path
+    std::map<std::string, TabletLoadProgress> _tablet_load_progress;
+
+    MutexLock _delete_bitmap_task_lock;
+    Condition _delete_bitmap_task_cond;
+    std::deque<DeleteBitmapTask> _delete_bitmap_tasks;
 
     DISALLOW_COPY_AND_ASSIGN(OLAPEngine);
 };
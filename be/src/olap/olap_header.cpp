@@ -15,6 +15,9 @@
 
 #include "olap/olap_header.h"
 
+#include <errno.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <fstream>
 #include <queue>
@@ -23,9 +26,11 @@
 #include <utility>
 #include <vector>
 
+#include "common/config.h"
 #include "olap/field.h"
 #include "olap/wrapper_field.h"
 #include "olap/file_helper.h"
+#include "olap/header_store.h"
 #include "olap/utils.h"
 
 using google::protobuf::RepeatedPtrField;
@@ -78,6 +83,14 @@ OLAPHeader::~OLAPHeader() {
 }
 
 OLAPStatus OLAPHeader::load() {
+    // header file is newer than header store if it exists, because it's
+    // written before store, or removed after store once migration is
+    // finalized, whenever header is saved.
+    DiskHeaderStore* store = HeaderStore::get_instance()->get_disk(_file_name);
+    if (store != NULL && access(_file_name.c_str(), F_OK) != 0) {
+        return _load_from_store(store);
+    }
+
     FileHeader<OLAPHeaderMessage> file_header;
     FileHandler file_handler;
 
@@ -111,8 +124,68 @@ OLAPStatus OLAPHeader::load() {
     return OLAP_SUCCESS;
 }
 
+OLAPStatus OLAPHeader::_load_from_store(DiskHeaderStore* store) {
+    string value;
+    OLAPStatus res = store->get(_file_name, &value);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to get header from header store. [path='%s' res=%d]",
+                         _file_name.c_str(), res);
+        return res;
+    }
+
+    if (!ParseFromString(value)) {
+        OLAP_LOG_WARNING("fail to parse header from header store. [path='%s']",
+                         _file_name.c_str());
+        return OLAP_ERR_PARSE_PROTOBUF_ERROR;
+    }
+
+    clear_version_graph(&_version_graph, &_vertex_helper_map);
+
+    if (construct_version_graph(file_version(),
+                                &_version_graph,
+                                &_vertex_helper_map) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to construct version graph.");
+        return OLAP_ERR_OTHER_ERROR;
+    }
+
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus OLAPHeader::save() {
-    return save(_file_name);
+    // header file is kept until migration to header store is finalized, so
+    // that tablets can still be loaded by versions without header store
+    DiskHeaderStore* store = HeaderStore::get_instance()->get_disk(_file_name);
+    if (store == NULL || !config::header_store_migration_finalized) {
+        OLAPStatus res = save(_file_name);
+        if (res != OLAP_SUCCESS || store == NULL) {
+            return res;
+        }
+    }
+
+    string value;
+    if (!SerializeToString(&value)) {
+        OLAP_LOG_WARNING("fail to serialize header. [path='%s']", _file_name.c_str());
+        return OLAP_ERR_SERIALIZE_PROTOBUF_ERROR;
+    }
+
+    OLAPStatus res = store->put(_file_name, value);
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to put header into header store. [path='%s' res=%d]",
+                         _file_name.c_str(), res);
+        return res;
+    }
+
+    if (!config::header_store_migration_finalized) {
+        return OLAP_SUCCESS;
+    }
+
+    // header file left by clone or earlier version is replaced by store
+    if (unlink(_file_name.c_str()) != 0 && errno != ENOENT) {
+        OLAP_LOG_WARNING("fail to remove header file. [path='%s' err=%m]", _file_name.c_str());
+        return OLAP_ERR_IO_ERROR;
+    }
+
+    return OLAP_SUCCESS;
 }
 
 OLAPStatus OLAPHeader::save(const string& file_path) {
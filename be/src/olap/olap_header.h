@@ -26,6 +26,9 @@
 #include "olap/olap_define.h"
 
 namespace palo {
+
+class DiskHeaderStore;
+
 // Class for managing olap table header.
 class OLAPHeader : public OLAPHeaderMessage {
 public:
@@ -41,6 +44,8 @@ public:
     OLAPStatus load();
 
     // Saves the header to disk, returning true on success.
+    // save() puts header into header store if the header file is in a data
+    // directory, and save(file_path) always writes header file.
     OLAPStatus save();
     OLAPStatus save(const std::string& file_path);
 
@@ -94,6 +99,8 @@ private:
     // names) using lzo_adler32 function.
     OLAPStatus _compute_schema_hash(SchemaHash* schema_hash);
 
+    OLAPStatus _load_from_store(DiskHeaderStore* store);
+
     // full path of olap header file
     std::string _file_name;
 
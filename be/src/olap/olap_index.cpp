@@ -15,17 +15,22 @@
 
 #include "olap/olap_index.h"
 
+#include <errno.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <fstream>
 
 #include "olap/olap_data.h"
+#include "olap/olap_engine.h"
 #include "olap/olap_table.h"
 #include "olap/row_block.h"
 #include "olap/row_cursor.h"
 #include "olap/utils.h"
 #include "olap/wrapper_field.h"
+#include "util/palo_metrics.h"
 
 using std::ifstream;
 using std::string;
@@ -42,6 +47,14 @@ namespace palo {
         } \
     } while (0);
 
+#define MEM_INDEX_PIN(pin) \
+    MemIndexPin pin(this); \
+    do { \
+        if (pin.status() != OLAP_SUCCESS) { \
+            return pin.status(); \
+        } \
+    } while (0);
+
 #define POS_PARAM_VALIDATE(pos) \
     do { \
         if (NULL == pos) { \
@@ -70,6 +83,8 @@ OLAPIndex::OLAPIndex(OLAPTable* table,
         _max_timestamp(max_timestamp),
         _num_segments(num_segments),
         _version_hash(version_hash),
+        _mem_index_cache(NULL),
+        _cache_id(0),
         _current_num_rows_per_row_block(0),
         _inited_column_statistics(false),
         _column_statistics(
@@ -99,6 +114,11 @@ OLAPIndex::~OLAPIndex() {
     delete [] _short_key_buf;
     _current_file_handler.close();
 
+    // entries still pinned are deleted when they're released
+    if (_mem_index_cache != NULL) {
+        _mem_index_cache->erase(_cache_key());
+    }
+
     if (_inited_column_statistics) {
             for (size_t i = 0; i < _column_statistics.size(); ++i) {
             SAFE_DELETE(_column_statistics[i].first);
@@ -139,7 +159,158 @@ void OLAPIndex::delete_all_files() {
         if (remove(data_path.c_str()) != 0) {
             OLAP_LOG_WARNING("fail to delete data file. [err='%m' path='%s']", data_path.c_str());
         }
+
+        // most segments have no delete bitmap
+        string delete_bitmap_path = _construct_delete_bitmap_file_path(seg_id);
+        if (remove(delete_bitmap_path.c_str()) != 0 && errno != ENOENT) {
+            OLAP_LOG_WARNING("fail to delete delete bitmap file. [err='%m' path='%s']",
+                             delete_bitmap_path.c_str());
+        }
+        OLAPEngine::get_instance()->index_stream_lru_cache()->erase(
+                CacheKey(delete_bitmap_path));
+    }
+}
+
+OLAPStatus OLAPIndex::get_delete_bitmaps(uint32_t segment,
+                                         std::shared_ptr<const DeleteBitmaps>* bitmaps) {
+    Cache* cache = OLAPEngine::get_instance()->index_stream_lru_cache();
+    string file_name = _construct_delete_bitmap_file_path(segment);
+    CacheKey key(file_name);
+
+    Cache::Handle* handle = cache->lookup(key);
+    if (handle == NULL) {
+        AutoMutexLock l(&_delete_bitmap_lock);
+        // bitmaps may be loaded by others when waiting for the lock
+        handle = cache->lookup(key);
+        if (handle == NULL) {
+            std::shared_ptr<DeleteBitmaps> loaded_bitmaps(new DeleteBitmaps());
+            OLAPStatus res = _load_delete_bitmaps(segment, loaded_bitmaps.get());
+            if (res != OLAP_SUCCESS) {
+                return res;
+            }
+
+            size_t charge = sizeof(DeleteBitmaps);
+            for (const auto& it : *loaded_bitmaps) {
+                charge += (it.second->num_bits() + 7) / 8;
+            }
+            handle = cache->insert(key,
+                                   new std::shared_ptr<const DeleteBitmaps>(loaded_bitmaps),
+                                   charge,
+                                   &_delete_cached_delete_bitmaps);
+        }
+    }
+
+    *bitmaps = *reinterpret_cast<std::shared_ptr<const DeleteBitmaps>*>(cache->value(handle));
+    cache->release(handle);
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus OLAPIndex::add_delete_bitmap(uint32_t segment,
+                                        int32_t delete_version,
+                                        std::shared_ptr<Bitmap> bitmap) {
+    AutoMutexLock l(&_delete_bitmap_lock);
+    DeleteBitmaps bitmaps;
+    OLAPStatus res = _load_delete_bitmaps(segment, &bitmaps);
+    if (res != OLAP_SUCCESS) {
+        return res;
+    }
+
+    bitmaps[delete_version] = bitmap;
+    res = _save_delete_bitmaps(segment, bitmaps);
+    if (res != OLAP_SUCCESS) {
+        return res;
+    }
+
+    // readers holding old bitmaps still evaluate the new condition on rows
+    string file_name = _construct_delete_bitmap_file_path(segment);
+    OLAPEngine::get_instance()->index_stream_lru_cache()->erase(CacheKey(file_name));
+    return OLAP_SUCCESS;
+}
+
+void OLAPIndex::_delete_cached_delete_bitmaps(const CacheKey& key, void* value) {
+    delete reinterpret_cast<std::shared_ptr<const DeleteBitmaps>*>(value);
+}
+
+OLAPStatus OLAPIndex::_load_delete_bitmaps(uint32_t segment, DeleteBitmaps* bitmaps) {
+    string file_name = _construct_delete_bitmap_file_path(segment);
+    if (access(file_name.c_str(), F_OK) != 0) {
+        return OLAP_SUCCESS;
+    }
+
+    // Bitmaps are only used to skip evaluating delete conditions, so a
+    // broken file is ignored and the conditions are evaluated on rows.
+    FileHandler file_handler;
+    FileHeader<DeleteBitmapFileMessage> file_header;
+    if (file_handler.open(file_name, O_RDONLY) != OLAP_SUCCESS
+            || file_header.unserialize(&file_handler) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to load delete bitmap file, ignore it. [file='%s']",
+                         file_name.c_str());
+        return OLAP_SUCCESS;
+    }
+
+    const DeleteBitmapFileMessage& message = file_header.message();
+    for (int i = 0; i < message.bitmaps_size(); ++i) {
+        const string& data = message.bitmaps(i).bitmap();
+        if (data.size() * 8 < message.num_rows()) {
+            OLAP_LOG_WARNING("invalid delete bitmap, ignore it. [file='%s' version=%d]",
+                             file_name.c_str(), message.bitmaps(i).delete_version());
+            continue;
+        }
+
+        std::shared_ptr<Bitmap> bitmap(new Bitmap(message.num_rows()));
+        for (uint64_t row = 0; row < message.num_rows(); ++row) {
+            if (data[row >> 3] & (1 << (row & 7))) {
+                bitmap->Set(row, true);
+            }
+        }
+        (*bitmaps)[message.bitmaps(i).delete_version()] = bitmap;
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus OLAPIndex::_save_delete_bitmaps(uint32_t segment, const DeleteBitmaps& bitmaps) {
+    string file_name = _construct_delete_bitmap_file_path(segment);
+    string tmp_file_name = file_name + ".tmp";
+
+    FileHeader<DeleteBitmapFileMessage> file_header;
+    DeleteBitmapFileMessage* message = file_header.mutable_message();
+    for (const auto& it : bitmaps) {
+        const Bitmap& bitmap = *it.second;
+        message->set_num_rows(bitmap.num_bits());
+        DeleteBitmapMessage* bitmap_message = message->add_bitmaps();
+        bitmap_message->set_delete_version(it.first);
+        string* data = bitmap_message->mutable_bitmap();
+        data->assign((bitmap.num_bits() + 7) / 8, '\0');
+        for (int64_t row = 0; row < bitmap.num_bits(); ++row) {
+            if (bitmap.Get(row)) {
+                (*data)[row >> 3] |= 1 << (row & 7);
+            }
+        }
+    }
+
+    // write into temporary file, so that a broken file is never loaded
+    FileHandler file_handler;
+    if (file_handler.open_with_mode(tmp_file_name,
+            O_CREAT | O_WRONLY | O_TRUNC, S_IRUSR | S_IWUSR) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to open delete bitmap file. [file='%s']", tmp_file_name.c_str());
+        return OLAP_ERR_IO_ERROR;
+    }
+    if (file_header.prepare(&file_handler) != OLAP_SUCCESS
+            || file_header.serialize(&file_handler) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to write delete bitmap file. [file='%s']", tmp_file_name.c_str());
+        file_handler.close();
+        remove(tmp_file_name.c_str());
+        return OLAP_ERR_IO_ERROR;
+    }
+    file_handler.close();
+
+    if (rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+        OLAP_LOG_WARNING("fail to rename delete bitmap file. [err='%m' file='%s']",
+                         file_name.c_str());
+        remove(tmp_file_name.c_str());
+        return OLAP_ERR_IO_ERROR;
     }
+    return OLAP_SUCCESS;
 }
 
 OLAPStatus OLAPIndex::set_column_statistics(
@@ -264,7 +435,7 @@ OLAPStatus OLAPIndex::load() {
 
         // get full path for one segment
         string path = _table->construct_index_file_path(_version, _version_hash, seg_id);
-        if ((res = _index.load_segment(path.c_str(), &_current_num_rows_per_row_block))
+        if ((res = _index.load_segment(path.c_str(), &_current_num_rows_per_row_block, false))
                 != OLAP_SUCCESS) {
             OLAP_LOG_WARNING("fail to load segment. [path='%s']", path.c_str());
             _check_io_error(res);
@@ -272,11 +443,57 @@ OLAPStatus OLAPIndex::load() {
         }
     }
 
+    _mem_index_cache = OLAPEngine::get_instance()->mem_index_lru_cache();
+    _cache_id = _mem_index_cache->new_id();
     _index_loaded = true;
 
     return OLAP_SUCCESS;
 }
 
+OLAPStatus OLAPIndex::_load_mem_index(MemIndex** mem_index) const {
+    OLAPStatus res = OLAP_SUCCESS;
+    OlapStopWatch watch;
+
+    MemIndex* index = new(std::nothrow) MemIndex();
+    if (index == NULL) {
+        OLAP_LOG_WARNING("fail to malloc MemIndex.");
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+
+    // _short_key_info_list is not changed after construction
+    RowFields* fields = const_cast<RowFields*>(&_short_key_info_list);
+    if (index->init(_short_key_length, _new_short_key_length,
+                    _table->num_short_key_fields(), fields) != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to create MemIndex. [num_segment=%d]", _num_segments);
+        delete index;
+        return OLAP_ERR_INDEX_LOAD_ERROR;
+    }
+
+    for (uint32_t seg_id = 0; seg_id < _num_segments; ++seg_id) {
+        string path = _table->construct_index_file_path(_version, _version_hash, seg_id);
+        if ((res = index->load_segment(path.c_str(), NULL)) != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to load segment. [path='%s']", path.c_str());
+            if (is_io_error(res)) {
+                _table->set_io_error();
+            }
+            delete index;
+            return res;
+        }
+    }
+
+    PaloMetrics::mem_index_load_total.increment(1);
+    PaloMetrics::mem_index_load_duration_us.increment(watch.get_elapse_time_us());
+    *mem_index = index;
+    return OLAP_SUCCESS;
+}
+
+void OLAPIndex::_delete_cached_mem_index(const CacheKey& key, void* value) {
+    MemIndex* mem_index = reinterpret_cast<MemIndex*>(value);
+    PaloMetrics::mem_index_cache_bytes.increment(
+            -static_cast<int64_t>(mem_index->memory_usage()));
+    delete mem_index;
+}
+
 OLAPStatus OLAPIndex::load_pb(const char* file, uint32_t seg_id) {
     OLAPStatus res = OLAP_SUCCESS;
 
@@ -339,9 +556,10 @@ OLAPStatus OLAPIndex::find_row_block(const RowCursor& key,
                                  RowBlockPosition* pos) const {
     TABLE_PARAM_VALIDATE();
     POS_PARAM_VALIDATE(pos);
+    MEM_INDEX_PIN(pin);
 
     // 将这部分逻辑从memindex移出来，这样可以复用find。
-    OLAPIndexOffset offset = _index.find(key, helper_cursor, find_last);
+    OLAPIndexOffset offset = pin.mem_index()->find(key, helper_cursor, find_last);
     if (offset.offset > 0) {
         offset.offset = offset.offset - 1;
     } else {
@@ -355,7 +573,7 @@ OLAPStatus OLAPIndex::find_row_block(const RowCursor& key,
         }
     }
 
-    return _index.get_row_block_position(offset, pos);
+    return pin.mem_index()->get_row_block_position(offset, pos);
 }
 
 OLAPStatus OLAPIndex::find_short_key(const RowCursor& key,
@@ -364,10 +582,11 @@ OLAPStatus OLAPIndex::find_short_key(const RowCursor& key,
                                  RowBlockPosition* pos) const {
     TABLE_PARAM_VALIDATE();
     POS_PARAM_VALIDATE(pos);
+    MEM_INDEX_PIN(pin);
 
     // 由于find会从前一个segment找起，如果前一个segment中恰好没有该key，
     // 就用前移后移来移动segment的位置.
-    OLAPIndexOffset offset = _index.find(key, helper_cursor, find_last);
+    OLAPIndexOffset offset = pin.mem_index()->find(key, helper_cursor, find_last);
     if (offset.offset > 0) {
         offset.offset = offset.offset - 1;
 
@@ -378,34 +597,40 @@ OLAPStatus OLAPIndex::find_short_key(const RowCursor& key,
     }
 
     OLAP_LOG_DEBUG("[seg='%d', offset='%d']", offset.segment, offset.offset);
-    return _index.get_row_block_position(offset, pos);
+    return pin.mem_index()->get_row_block_position(offset, pos);
 }
 
+// entry is valid only while entries are pinned, so caller should hold a
+// MemIndexPin if entry is used after return
 OLAPStatus OLAPIndex::get_row_block_entry(const RowBlockPosition& pos, EntrySlice* entry) const {
     TABLE_PARAM_VALIDATE();
     SLICE_PARAM_VALIDATE(entry);
+    MEM_INDEX_PIN(pin);
     
-    return _index.get_entry(_index.get_offset(pos), entry);
+    return pin.mem_index()->get_entry(_index.get_offset(pos), entry);
 }
 
 OLAPStatus OLAPIndex::find_first_row_block(RowBlockPosition* position) const {
     TABLE_PARAM_VALIDATE();
     POS_PARAM_VALIDATE(position);
+    MEM_INDEX_PIN(pin);
     
-    return _index.get_row_block_position(_index.find_first(), position);
+    return pin.mem_index()->get_row_block_position(_index.find_first(), position);
 }
 
 OLAPStatus OLAPIndex::find_last_row_block(RowBlockPosition* position) const {
     TABLE_PARAM_VALIDATE();
     POS_PARAM_VALIDATE(position);
+    MEM_INDEX_PIN(pin);
     
-    return _index.get_row_block_position(_index.find_last(), position);
+    return pin.mem_index()->get_row_block_position(_index.find_last(), position);
 }
 
 OLAPStatus OLAPIndex::find_next_row_block(RowBlockPosition* pos, bool* eof) const {
     TABLE_PARAM_VALIDATE();
     POS_PARAM_VALIDATE(pos);
     POS_PARAM_VALIDATE(eof);
+    MEM_INDEX_PIN(pin);
 
     OLAPIndexOffset current = _index.get_offset(*pos);
     *eof = false;
@@ -416,7 +641,7 @@ OLAPStatus OLAPIndex::find_next_row_block(RowBlockPosition* pos, bool* eof) cons
         return OLAP_ERR_INDEX_EOF;
     }
 
-    return _index.get_row_block_position(next, pos);
+    return pin.mem_index()->get_row_block_position(next, pos);
 }
 
 OLAPStatus OLAPIndex::find_mid_point(const RowBlockPosition& low,
@@ -438,15 +663,17 @@ OLAPStatus OLAPIndex::find_mid_point(const RowBlockPosition& low,
 
 OLAPStatus OLAPIndex::find_prev_point(
         const RowBlockPosition& current, RowBlockPosition* prev) const {
+    MEM_INDEX_PIN(pin);
     OLAPIndexOffset current_offset = _index.get_offset(current);
     OLAPIndexOffset prev_offset = _index.prev(current_offset);
 
-    return _index.get_row_block_position(prev_offset, prev);
+    return pin.mem_index()->get_row_block_position(prev_offset, prev);
 }
 
 OLAPStatus OLAPIndex::advance_row_block(int64_t num_row_blocks, RowBlockPosition* position) const {
     TABLE_PARAM_VALIDATE();
     POS_PARAM_VALIDATE(position);
+    MEM_INDEX_PIN(pin);
 
     OLAPIndexOffset off = _index.get_offset(*position);
     iterator_offset_t absolute_offset = _index.get_absolute_offset(off) + num_row_blocks;
@@ -454,7 +681,14 @@ OLAPStatus OLAPIndex::advance_row_block(int64_t num_row_blocks, RowBlockPosition
         return OLAP_ERR_INDEX_EOF;
     }
 
-    return _index.get_row_block_position(_index.get_relative_offset(absolute_offset), position);
+    return pin.mem_index()->get_row_block_position(
+            _index.get_relative_offset(absolute_offset), position);
+}
+
+OLAPStatus OLAPIndex::get_row_block_position(
+        const OLAPIndexOffset& pos, RowBlockPosition* rbp) const {
+    MEM_INDEX_PIN(pin);
+    return pin.mem_index()->get_row_block_position(pos, rbp);
 }
 
 // PRECONDITION position1 < position2
@@ -622,6 +856,43 @@ uint64_t OLAPIndex::num_index_entries() const {
     return _index.count();
 }
 
+MemIndexPin::MemIndexPin(const OLAPIndex* index) :
+        _cache(index->_mem_index_cache),
+        _handle(NULL),
+        _mem_index(NULL),
+        _status(OLAP_SUCCESS) {
+    if (_cache == NULL) {
+        OLAP_LOG_WARNING("fail to pin MemIndex, index is not loaded.");
+        _status = OLAP_ERR_NOT_INITED;
+        return;
+    }
+
+    CacheKey key = index->_cache_key();
+    _handle = _cache->lookup(key);
+    if (_handle == NULL) {
+        // only one thread loads entries of the same index
+        boost::lock_guard<boost::mutex> guard(index->_index_load_lock);
+        _handle = _cache->lookup(key);
+        if (_handle == NULL) {
+            MemIndex* mem_index = NULL;
+            if ((_status = index->_load_mem_index(&mem_index)) != OLAP_SUCCESS) {
+                return;
+            }
+            size_t charge = mem_index->memory_usage();
+            PaloMetrics::mem_index_cache_bytes.increment(charge);
+            _handle = _cache->insert(key, mem_index, charge,
+                                     &OLAPIndex::_delete_cached_mem_index);
+        }
+    }
+    _mem_index = reinterpret_cast<const MemIndex*>(_cache->value(_handle));
+}
+
+MemIndexPin::~MemIndexPin() {
+    if (_handle != NULL) {
+        _cache->release(_handle);
+    }
+}
+
 MemIndex::MemIndex()
     : _key_length(0),
       _num_entries(0),
@@ -632,6 +903,14 @@ MemIndex::MemIndex()
     _mem_pool.reset(new MemPool(_tracker.get()));
 }
 
+size_t MemIndex::memory_usage() const {
+    size_t usage = _mem_pool->total_reserved_bytes();
+    for (const SegmentMetaInfo& meta : _meta) {
+        usage += meta.buffer.length;
+    }
+    return usage;
+}
+
 MemIndex::~MemIndex() {
     _num_entries = 0;
     for (vector<SegmentMetaInfo>::iterator it = _meta.begin(); it != _meta.end(); ++it) {
@@ -641,7 +920,9 @@ MemIndex::~MemIndex() {
     }
 }
 
-OLAPStatus MemIndex::load_segment(const char* file, size_t *current_num_rows_per_row_block) {
+OLAPStatus MemIndex::load_segment(const char* file,
+                                  size_t *current_num_rows_per_row_block,
+                                  bool load_entries) {
     OLAPStatus res = OLAP_SUCCESS;
 
     SegmentMetaInfo meta;
@@ -754,6 +1035,13 @@ OLAPStatus MemIndex::load_segment(const char* file, size_t *current_num_rows_per
         return res;
     }
 
+    // 只加载文件头时也校验索引内容, 使损坏的索引在加载table时即可发现
+    if (!load_entries) {
+        file_handler.close();
+        free(storage_data);
+        return OLAP_SUCCESS;
+    }
+
     /*
      * convert storage layout to memory layout for olapindex
      * In this procedure, string type(Varchar/Char) should be
@@ -990,7 +1278,8 @@ const OLAPIndexOffset MemIndex::prev(const OLAPIndexOffset& pos) const {
 const OLAPIndexOffset MemIndex::get_offset(const RowBlockPosition& pos) const {
     uint32_t file_header_size = _meta[pos.segment].file_header.size();
     if (pos.segment >= segment_count()
-            || pos.index_offset > file_header_size + _meta[pos.segment].buffer.length
+            || pos.index_offset > file_header_size
+                                  + _meta[pos.segment].count() * new_entry_length()
             || (pos.index_offset - file_header_size) % new_entry_length() != 0) {
         return end();
     }
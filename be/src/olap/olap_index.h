@@ -19,6 +19,8 @@
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
 #include <iterator>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -29,11 +31,13 @@
 #include "olap/atomic.h"
 #include "olap/field.h"
 #include "olap/file_helper.h"
+#include "olap/lru_cache.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/olap_table.h"
 #include "olap/row_cursor.h"
 #include "olap/utils.h"
+#include "util/bitmap.h"
 
 namespace palo {
 class IndexComparator;
@@ -176,8 +180,10 @@ public:
     OLAPStatus init(size_t short_key_len, size_t new_short_key_len,
                     size_t short_key_num, RowFields* fields);
 
-    // 加载一个segment到内存
-    OLAPStatus load_segment(const char* file, size_t *current_num_rows_per_row_block);
+    // 加载一个segment到内存, 如果load_entries为false则只加载文件头并校验索引内容
+    OLAPStatus load_segment(const char* file,
+                            size_t *current_num_rows_per_row_block,
+                            bool load_entries = true);
 
     // Return the IndexOffset of the first element, physically, it's (0, 0)
     const OLAPIndexOffset begin() const {
@@ -322,6 +328,9 @@ public:
         }
     }
 
+    // Return bytes of memory used by index entries
+    size_t memory_usage() const;
+
 private:
     std::vector<SegmentMetaInfo> _meta;
     size_t _key_length;
@@ -428,6 +437,31 @@ private:
     RowCursor* _helper_cursor;
 };
 
+// Keep index entries of OLAPIndex in memory during the lifetime of pin.
+// Entries are loaded into the MemIndex cache on demand, and they may be
+// evicted when no pin holds them.
+class MemIndexPin {
+public:
+    explicit MemIndexPin(const OLAPIndex* index);
+    ~MemIndexPin();
+
+    OLAPStatus status() const {
+        return _status;
+    }
+
+    const MemIndex* mem_index() const {
+        return _mem_index;
+    }
+
+private:
+    Cache* _cache;
+    Cache::Handle* _handle;
+    const MemIndex* _mem_index;
+    OLAPStatus _status;
+
+    DISALLOW_COPY_AND_ASSIGN(MemIndexPin);
+};
+
 // Class for managing OLAP table indices
 // For fast key lookup, we maintain a sparse index for every data file. The
 // index is sparse because we only have one pointer per row block. Each
@@ -435,6 +469,7 @@ private:
 // corresponding row block
 class OLAPIndex {
     friend class MemIndex;
+    friend class MemIndexPin;
 public:
     OLAPIndex(OLAPTable* table,
               Version version,
@@ -445,7 +480,8 @@ public:
 
     virtual ~OLAPIndex();
 
-    // Load the index into memory.
+    // Load headers of index files. Index entries are loaded into the
+    // MemIndex cache when they're used.
     OLAPStatus load();
     bool index_loaded();
     OLAPStatus load_pb(const char* file, uint32_t seg_id);
@@ -534,9 +570,25 @@ public:
     bool is_in_use();
     int64_t ref_count();
 
-    // delete all files (*.idx; *.dat)
+    // delete all files (*.idx; *.dat; *.del)
     void delete_all_files();
 
+    // bitmaps of one segment, key is version of delete condition
+    typedef std::map<int32_t, std::shared_ptr<Bitmap>> DeleteBitmaps;
+
+    // Get bitmaps of rows of segment deleted by delete conditions, bitmaps
+    // is empty if segment has no .del file. Bitmaps are loaded from .del
+    // file and kept in index stream lru cache, so they may be evicted and
+    // loaded again; caller keeps them alive by holding the shared_ptr.
+    OLAPStatus get_delete_bitmaps(uint32_t segment,
+                                  std::shared_ptr<const DeleteBitmaps>* bitmaps);
+
+    // Add bitmap of rows of segment deleted by delete condition of
+    // delete_version, and save all bitmaps of the segment into .del file.
+    OLAPStatus add_delete_bitmap(uint32_t segment,
+                                 int32_t delete_version,
+                                 std::shared_ptr<Bitmap> bitmap);
+
     // getters and setters.
     // get associated OLAPTable pointer
     OLAPTable* table() const {
@@ -604,9 +656,7 @@ public:
         return _current_num_rows_per_row_block;
     }
 
-    OLAPStatus get_row_block_position(const OLAPIndexOffset& pos, RowBlockPosition* rbp) const {
-        return _index.get_row_block_position(pos, rbp);
-    }
+    OLAPStatus get_row_block_position(const OLAPIndexOffset& pos, RowBlockPosition* rbp) const;
     
     inline const FileHeader<column_file::ColumnDataHeaderMessage>* get_seg_pb(uint32_t seg_id) const {
         return &(_seg_pb_map.at(seg_id));
@@ -619,6 +669,13 @@ public:
 private:
     void _check_io_error(OLAPStatus res);
 
+    // Load index entries of all segments into a new MemIndex
+    OLAPStatus _load_mem_index(MemIndex** mem_index) const;
+    CacheKey _cache_key() const {
+        return CacheKey(reinterpret_cast<const char*>(&_cache_id), sizeof(_cache_id));
+    }
+    static void _delete_cached_mem_index(const CacheKey& key, void* value);
+
     std::string _construct_index_file_path(const Version& version,
                                            VersionHash version_hash,
                                            uint32_t segment) const {
@@ -639,6 +696,20 @@ private:
                                               "dat");
     }
 
+    std::string _construct_delete_bitmap_file_path(uint32_t segment) const {
+        return OLAPTable::construct_file_path(_header_file_name,
+                                              _version,
+                                              _version_hash,
+                                              segment,
+                                              "del");
+    }
+
+    // Read bitmaps of segment from .del file, without cache. Entries of
+    // index stream lru cache are keyed by path of .del file.
+    OLAPStatus _load_delete_bitmaps(uint32_t segment, DeleteBitmaps* bitmaps);
+    static void _delete_cached_delete_bitmaps(const CacheKey& key, void* value);
+    OLAPStatus _save_delete_bitmaps(uint32_t segment, const DeleteBitmaps& bitmaps);
+
     OLAPTable* _table;                 // table definition for this index
     Version _version;                  // version of associated data file
     bool _delete_flag;
@@ -647,7 +718,10 @@ private:
     VersionHash _version_hash;      // version hash for this index
     bool _index_loaded;                // whether the index has been read
     atomic_t _ref_count;               // reference count
+    // headers of index files, entries are in _mem_index_cache
     MemIndex _index;
+    Cache* _mem_index_cache;
+    uint64_t _cache_id;
 
     std::string _header_file_name;     // the name of the related header file
     // short key对应的field_info数组
@@ -679,6 +753,10 @@ private:
     std::vector<bool> _has_null_flags;
     std::unordered_map<uint32_t, FileHeader<column_file::ColumnDataHeaderMessage> > _seg_pb_map;
 
+    // serializes loading and saving .del files, so that a reader never
+    // caches bitmaps older than the file
+    MutexLock _delete_bitmap_lock;
+
     DISALLOW_COPY_AND_ASSIGN(OLAPIndex);
 };
 
@@ -25,12 +25,11 @@
 #include <gperftools/profiler.h>
 
 #include "olap/command_executor.h"
-#include "olap/cumulative_compaction.h"
+#include "olap/compaction_scheduler.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
 #include "olap/olap_engine.h"
 #include "olap/olap_snapshot.h"
-#include "agent/cgroups_mgr.h"
 
 
 using std::string;
@@ -85,29 +84,10 @@ OLAPStatus OLAPServer::init(const char* config_path, const char* config_file) {
         return OLAP_ERR_INIT_FAILED;
     }
 
-    // start be and ce threads for merge data
-    int32_t base_compaction_num_threads = config::base_compaction_num_threads;
-    _base_compaction_threads.resize(base_compaction_num_threads, -1);
-    for (uint32_t i = 0; i < base_compaction_num_threads; ++i) {
-        if (0 != pthread_create(&_base_compaction_threads[i],
-                                NULL,
-                                _base_compaction_thread_callback,
-                                NULL)) {
-            OLAP_LOG_FATAL("failed to start base compaction thread. [id=%u]", i); 
-            return OLAP_ERR_INIT_FAILED;
-        }
-    }
-
-    int32_t cumulative_compaction_num_threads = config::cumulative_compaction_num_threads;
-    _cumulative_compaction_threads.resize(cumulative_compaction_num_threads, -1);
-    for (uint32_t i = 0; i < cumulative_compaction_num_threads; ++i) {
-        if (0 != pthread_create(&(_cumulative_compaction_threads[i]), 
-                                NULL, 
-                                _cumulative_compaction_thread_callback, 
-                                NULL)) {
-            OLAP_LOG_FATAL("failed to start cumulative thread. [id=%u]", i); 
-            return OLAP_ERR_INIT_FAILED;
-        }
+    // start threads to run base and cumulative compactions
+    if (CompactionScheduler::get_instance()->start() != OLAP_SUCCESS) {
+        OLAP_LOG_FATAL("failed to start compaction scheduler.");
+        return OLAP_ERR_INIT_FAILED;
     }
 
     if (0 != pthread_create(&_fd_cache_clean_thread, NULL, _fd_cache_clean_callback, NULL)) {
@@ -115,6 +95,12 @@ OLAPStatus OLAPServer::init(const char* config_path, const char* config_file) {
         return OLAP_ERR_INIT_FAILED;
     }
 
+    // start thread for building delete bitmaps after delete conditions are pushed
+    if (0 != pthread_create(&_delete_bitmap_thread, NULL, _delete_bitmap_thread_callback, NULL)) {
+        OLAP_LOG_FATAL("failed to start delete bitmap thread");
+        return OLAP_ERR_INIT_FAILED;
+    }
+
     OLAP_LOG_TRACE("init finished.");
     return OLAP_SUCCESS;
 }
@@ -137,27 +123,12 @@ void* OLAPServer::_fd_cache_clean_callback(void* arg) {
     return NULL;
 }
 
-void* OLAPServer::_base_compaction_thread_callback(void* arg) {
+void* OLAPServer::_delete_bitmap_thread_callback(void* arg) {
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
 #endif
-    uint32_t interval = config::base_compaction_check_interval_seconds;
-    if (interval <= 0) {
-        OLAP_LOG_WARNING("base compaction check interval config is illegal: [%d], "
-                         "force set to 1", interval);
-        interval = 1;
-    }
-
-    string last_base_compaction_fs;
-    TTabletId last_base_compaction_tablet_id = -1;
     while (true) {
-        // must be here, because this thread is start on start and
-        // cgroup is not initialized at this time
-        // add tid to cgroup
-        CgroupsMgr::apply_system_cgroup();
-        OLAPEngine::get_instance()->start_base_compaction(&last_base_compaction_fs, &last_base_compaction_tablet_id);
-
-        usleep(interval * 1000000);
+        OLAPEngine::get_instance()->run_delete_bitmap_task();
     }
 
     return NULL;
@@ -253,28 +224,4 @@ void* OLAPServer::_unused_index_thread_callback(void* arg) {
     return NULL;
 }
 
-void* OLAPServer::_cumulative_compaction_thread_callback(void* arg) {
-#ifdef GOOGLE_PROFILER
-    ProfilerRegisterThread();
-#endif
-    OLAP_LOG_INFO("try to start cumulative compaction process!");
-    uint32_t interval = config::cumulative_compaction_check_interval_seconds;
-    if (interval <= 0) {
-        OLAP_LOG_WARNING("cumulative compaction check interval config is illegal: [%d], "
-                         "force set to 1", interval);
-        interval = 1;
-    }
-
-    while (true) {
-        // must be here, because this thread is start on start and
-        // cgroup is not initialized at this time
-        // add tid to cgroup
-        CgroupsMgr::apply_system_cgroup();
-        OLAPEngine::get_instance()->start_cumulative_priority();
-        usleep(interval * 1000000);
-    }
-
-    return NULL;
-}
-
 }  // namespace palo
@@ -35,9 +35,6 @@ public:
 private:
     // Thread functions
 
-    // base compaction thread process function
-    static void* _base_compaction_thread_callback(void* arg);
-
     // garbage sweep thread process function. clear snapshot and trash folder
     static void* _garbage_sweeper_thread_callback(void* arg);
 
@@ -47,12 +44,12 @@ private:
     // unused index process function
     static void* _unused_index_thread_callback(void* arg);
 
-    // cumulative process function
-    static void* _cumulative_compaction_thread_callback(void* arg);
-
     // clean file descriptors cache
     static void* _fd_cache_clean_callback(void* arg);
 
+    // build delete bitmaps of delete conditions
+    static void* _delete_bitmap_thread_callback(void* arg);
+
     // thread to monitor snapshot expiry
     pthread_t _garbage_sweeper_thread;
     static MutexLock _s_garbage_sweeper_mutex;
@@ -78,14 +75,10 @@ private:
     static MutexLock _s_session_timeout_mutex;
     static Condition _s_session_timeout_cond;
 
-    // thread to run base compaction
-    std::vector<pthread_t> _base_compaction_threads;
-
-    // thread to check cumulative
-    std::vector<pthread_t> _cumulative_compaction_threads;
-
     pthread_t _fd_cache_clean_thread;
 
+    pthread_t _delete_bitmap_thread;
+
     static atomic_t _s_request_number;
 };
 
@@ -26,6 +26,7 @@
 #include <boost/filesystem.hpp>
 
 #include "olap/field.h"
+#include "olap/header_store.h"
 #include "olap/i_data.h"
 #include "olap/olap_common.h"
 #include "olap/olap_define.h"
@@ -93,6 +94,8 @@ OLAPTable::OLAPTable(OLAPHeader* header) :
         _num_fields(0),
         _num_null_fields(0),
         _num_key_fields(0),
+        _alter_total_rows(0),
+        _alter_processed_rows(0),
         _id(0),
         _is_loaded(false) {
     if (header == NULL) {
@@ -210,6 +213,14 @@ OLAPTable::~OLAPTable() {
     release_header_lock();
 
     path path_name(_header->file_name());
+    // 删除的table在trash中保留header文件
+    if (_is_dropped) {
+        DiskHeaderStore* header_store = HeaderStore::get_instance()->get_disk(
+                _header->file_name());
+        if (header_store != NULL && _header->save(_header->file_name()) == OLAP_SUCCESS) {
+            header_store->remove(_header->file_name());
+        }
+    }
     SAFE_DELETE(_header);
 
     // 移动数据目录
@@ -230,6 +241,7 @@ OLAPStatus OLAPTable::load() {
     set<string> files;
     set<string> index_files;
     set<string> data_files;
+    set<string> delete_bitmap_files;
 
     if (_is_loaded) {
         goto EXIT;
@@ -252,6 +264,8 @@ OLAPStatus OLAPTable::load() {
     obtain_header_rdlock();
     list_index_files(&index_files);
     list_data_files(&data_files);
+    list_delete_bitmap_files(&delete_bitmap_files);
+    data_files.insert(delete_bitmap_files.begin(), delete_bitmap_files.end());
     if (remove_unused_files(one_schema_root,
                             files,
                             header_file_path.filename().string(),
@@ -808,6 +822,13 @@ OLAPStatus OLAPTable::split_range(
         return OLAP_ERR_TABLE_NOT_FOUND;
     }
 
+    // entries got from index are used after the call, keep them in memory
+    MemIndexPin index_pin(base_index);
+    if (index_pin.status() != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to load index entries. [table=%s]", full_name().c_str());
+        return index_pin.status();
+    }
+
     // 找到startkey对应的起始位置
     if (base_index->find_short_key(start_key, &helper_cursor, false, &start_pos) != OLAP_SUCCESS) {
         if (base_index->find_first_row_block(&start_pos) != OLAP_SUCCESS) {
@@ -938,6 +959,10 @@ void OLAPTable::list_index_files(set<string>* file_names) const {
     _list_files_with_suffix("idx", file_names);
 }
 
+void OLAPTable::list_delete_bitmap_files(set<string>* file_names) const {
+    _list_files_with_suffix("del", file_names);
+}
+
 void OLAPTable::_list_files_with_suffix(const string& file_suffix, set<string>* file_names) const {
     if (file_names == NULL) {
         OLAP_LOG_WARNING("parameter filenames is null. [table='%s']", full_name().c_str());
@@ -25,6 +25,7 @@
 
 #include "gen_cpp/AgentService_types.h"
 #include "gen_cpp/olap_file.pb.h"
+#include "olap/atomic.h"
 #include "olap/field.h"
 #include "olap/olap_define.h"
 #include "olap/olap_header.h"
@@ -182,6 +183,8 @@ public:
 
     void list_index_files(std::set<std::string>* filenames) const;
 
+    void list_delete_bitmap_files(std::set<std::string>* filenames) const;
+
     bool has_version(const Version& version) const;
 
     void list_versions(std::vector<Version>* versions) const;
@@ -547,6 +550,25 @@ public:
         set_schema_change_status(ALTER_TABLE_WAITING, 0, -1);
     }
 
+    // 历史数据转换的进度，汇报给FE
+    void set_alter_total_rows(int64_t total_rows) {
+        _alter_total_rows = total_rows;
+        _alter_processed_rows = 0;
+    }
+
+    void add_alter_processed_rows(int64_t rows) {
+        atomic64_add(rows, &_alter_processed_rows);
+    }
+
+    // 转换完成前最多为99
+    int32_t alter_progress() const {
+        if (_alter_total_rows <= 0) {
+            return 0;
+        }
+        int64_t progress = _alter_processed_rows * 100 / _alter_total_rows;
+        return progress < 99 ? progress : 99;
+    }
+
     bool equal(TTabletId tablet_id, TSchemaHash schema_hash) {
         if (this->tablet_id() != tablet_id || this->schema_hash() != schema_hash) {
             return false;
@@ -666,6 +688,8 @@ private:
     PushStatus _push_status;
     SyncStatus _sync_status;
     SchemaChangeStatus _schema_change_status;
+    int64_t _alter_total_rows;
+    atomic64 _alter_processed_rows;
     // related locks to ensure that commands are executed correctly.
     RWLock _header_lock;
     MutexLock _push_lock;
@@ -21,9 +21,15 @@
 
 #include <boost/filesystem.hpp>
 
+#include "common/config.h"
+#include "olap/compaction_scheduler.h"
+#include "olap/delta_writer.h"
+#include "olap/io_governor.h"
 #include "olap/olap_engine.h"
 #include "olap/olap_table.h"
 #include "olap/schema_change.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
 
 using std::list;
 using std::map;
@@ -49,6 +55,7 @@ OLAPStatus PushHandler::process(
         vector<TTabletInfo>* tablet_info_vec) {
     OLAP_LOG_INFO("begin to push data. [table='%s' version=%ld]",
                    olap_table->full_name().c_str(), request.version);
+    IOPriorityScope io_priority(IO_PRIORITY_PUSH);
 
     OLAPStatus res = OLAP_SUCCESS;
     _request = request;
@@ -218,6 +225,22 @@ OLAPStatus PushHandler::process(
         }
 
         _release_header_lock();
+
+        // Mark deleted rows of existing data in delete bitmaps, so that
+        // the condition is not evaluated on every read. It's only an
+        // optimization and scans all existing data, so it's done by a
+        // background thread rather than delaying the push.
+        if (config::enable_delete_bitmap) {
+            for (TableVars& table_var : table_infoes) {
+                if (table_var.olap_table.get() == NULL) {
+                    continue;
+                }
+                OLAPEngine::get_instance()->add_delete_bitmap_task(
+                        table_var.olap_table->tablet_id(),
+                        table_var.olap_table->schema_hash(),
+                        request.version);
+            }
+        }
     }
 
     // 5. Convert local data file into delta_file and build index,
@@ -294,6 +317,15 @@ EXIT:
     }
     _olap_table_arr.clear();
 
+    // New versions are added, compaction may be needed
+    if (res == OLAP_SUCCESS) {
+        for (TableVars& table_var : table_infoes) {
+            if (table_var.olap_table.get() != NULL) {
+                CompactionScheduler::get_instance()->update_score(table_var.olap_table);
+            }
+        }
+    }
+
     OLAP_LOG_INFO("finish to process push. [res=%d]", res);
 
     return res;
@@ -418,22 +450,31 @@ OLAPStatus PushHandler::_convert(
             // Convert from raw to delta
             OLAP_LOG_DEBUG("start to convert row file to delta.");
 
-            while (!reader->eof()) {
-                if (OLAP_SUCCESS != (res = writer->attached_by(&row))) {
-                    OLAP_LOG_WARNING(
-                            "fail to attach row to writer. [res=%d table='%s' read_rows=%u]",
-                            res, curr_olap_table->full_name().c_str(), num_rows);
-                    break;
-                }
-
-                res = reader->next(&row, mem_pool);
+            if (config::enable_push_memtable) {
+                // rows of file are sorted and aggregated in memory, so
+                // they need not be sorted by etl
+                res = _convert_by_memtable(curr_olap_table, reader, &row, writer, &num_rows);
                 if (OLAP_SUCCESS != res) {
-                    OLAP_LOG_WARNING("read next row failed. [res=%d read_rows=%u]",
-                                     res, num_rows);
                     break;
-                } else {
-                    writer->next(row);
-                    num_rows++;
+                }
+            } else {
+                while (!reader->eof()) {
+                    if (OLAP_SUCCESS != (res = writer->attached_by(&row))) {
+                        OLAP_LOG_WARNING(
+                                "fail to attach row to writer. [res=%d table='%s' read_rows=%u]",
+                                res, curr_olap_table->full_name().c_str(), num_rows);
+                        break;
+                    }
+
+                    res = reader->next(&row, mem_pool);
+                    if (OLAP_SUCCESS != res) {
+                        OLAP_LOG_WARNING("read next row failed. [res=%d read_rows=%u]",
+                                         res, num_rows);
+                        break;
+                    } else {
+                        writer->next(row);
+                        num_rows++;
+                    }
                 }
             }
 
@@ -488,6 +529,54 @@ OLAPStatus PushHandler::_convert(
     return res;
 }
 
+OLAPStatus PushHandler::_convert_by_memtable(
+        SmartOLAPTable olap_table,
+        IBinaryReader* reader,
+        RowCursor* row,
+        IWriter* writer,
+        uint32_t* num_rows) {
+    DeltaWriter delta_writer(olap_table, _request.version_hash);
+    OLAPStatus res = delta_writer.init();
+    if (OLAP_SUCCESS != res) {
+        OLAP_LOG_WARNING("fail to init delta writer. [res=%d table='%s']",
+                         res, olap_table->full_name().c_str());
+        return res;
+    }
+
+    RowCursor read_row;
+    if (OLAP_SUCCESS != (res = read_row.init(olap_table->tablet_schema()))) {
+        OLAP_LOG_WARNING("fail to init rowcursor. [res=%d]", res);
+        return res;
+    }
+
+    // string values of read row are copied into mem table
+    MemTracker tracker(-1);
+    MemPool mem_pool(&tracker);
+    while (!reader->eof()) {
+        res = reader->next(&read_row, &mem_pool);
+        if (OLAP_SUCCESS != res) {
+            OLAP_LOG_WARNING("read next row failed. [res=%d read_rows=%ld]",
+                             res, delta_writer.num_rows());
+            return res;
+        }
+        res = delta_writer.write(read_row);
+        if (OLAP_SUCCESS != res) {
+            OLAP_LOG_WARNING("fail to write row to delta writer. [res=%d table='%s']",
+                             res, olap_table->full_name().c_str());
+            return res;
+        }
+        mem_pool.clear();
+    }
+
+    res = delta_writer.write_to(row, writer, num_rows);
+    if (OLAP_SUCCESS != res) {
+        OLAP_LOG_WARNING("fail to write sorted rows. [res=%d table='%s']",
+                         res, olap_table->full_name().c_str());
+        return res;
+    }
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus PushHandler::_validate_request(
         SmartOLAPTable olap_table_for_raw,
         SmartOLAPTable olap_table_for_schema_change,
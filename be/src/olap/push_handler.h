@@ -36,6 +36,7 @@ typedef std::vector<OLAPIndex*> Indices;
 
 class BinaryFile;
 class BinaryReader;
+class IBinaryReader;
 class ColumnMapping;
 class RowCursor;
 
@@ -59,6 +60,7 @@ public:
             const TPushReq& request,
             PushType push_type,
             std::vector<TTabletInfo>* tablet_info_vec);
+
     int64_t write_bytes() const { return _write_bytes; }
     int64_t write_rows() const { return _write_rows; }
 private:
@@ -87,6 +89,15 @@ private:
             Indices* new_olap_indices,
             AlterTabletType alter_table_type);
 
+    // Read all rows of raw file into a DeltaWriter, which sorts and
+    // aggregates them, then write them into writer in key order.
+    OLAPStatus _convert_by_memtable(
+            SmartOLAPTable olap_table,
+            IBinaryReader* reader,
+            RowCursor* row,
+            IWriter* writer,
+            uint32_t* num_rows);
+
     // Update header info when new version add or dirty version removed.
     OLAPStatus _update_header(
             SmartOLAPTable olap_table,
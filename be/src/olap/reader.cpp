@@ -410,8 +410,7 @@ OLAPStatus Reader::_agg_key_next_row(RowCursor* row_cursor, bool* eof) {
         ++merged_count;
     } while (true);
     _merged_rows += merged_count;
-    row_cursor->finalize_one_merge(_value_cids);
-    return OLAP_SUCCESS;
+    return row_cursor->finalize_one_merge(_value_cids);
 }
 
 OLAPStatus Reader::_unique_key_next_row(RowCursor* row_cursor, bool* eof) {
@@ -447,12 +446,18 @@ OLAPStatus Reader::_unique_key_next_row(RowCursor* row_cursor, bool* eof) {
             //   2. to make cost of  each scan round reasonable, we will control merged_count.
             if (_olap_table->keys_type() == KeysType::DUP_KEYS
                 || (_aggregation && merged_count > config::palo_scanner_row_num)) {
-                row_cursor->finalize_one_merge(_value_cids);
+                res = row_cursor->finalize_one_merge(_value_cids);
+                if (res != OLAP_SUCCESS) {
+                    return res;
+                }
                 break;
             }
             // break while can NOT doing aggregation
             if (!RowCursor::equal(_key_cids, row_cursor, _next_key)) {
-                row_cursor->finalize_one_merge(_value_cids);
+                res = row_cursor->finalize_one_merge(_value_cids);
+                if (res != OLAP_SUCCESS) {
+                    return res;
+                }
                 break;
             }
 
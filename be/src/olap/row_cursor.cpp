@@ -42,6 +42,9 @@ RowCursor::~RowCursor() {
         for (HllContext* context : hll_contexts) {
             delete context;
         }
+        for (BitmapContext* context : bitmap_contexts) {
+            delete context;
+        }
 
         delete [] _variable_buf;
     }
@@ -84,6 +87,9 @@ OLAPStatus RowCursor::_init(const std::vector<FieldInfo>& tablet_schema,
         FieldType type = tablet_schema[cid].type;
         if (type == OLAP_FIELD_TYPE_VARCHAR) {
             _variable_len += tablet_schema[cid].length - OLAP_STRING_MAX_BYTES;
+            if (tablet_schema[cid].aggregation == OLAP_FIELD_AGGREGATION_BITMAP_UNION) {
+                _variable_len += sizeof(BitmapContext*);
+            }
         } else if (type == OLAP_FIELD_TYPE_CHAR) {
             _variable_len += tablet_schema[cid].length;
         } else if (type == OLAP_FIELD_TYPE_HLL) {
@@ -226,6 +232,20 @@ OLAPStatus RowCursor::allocate_memory_for_string_type(
         FieldType type = tablet_schema[cid].type;
         if (type == OLAP_FIELD_TYPE_VARCHAR) {
             StringSlice* slice = reinterpret_cast<StringSlice*>(fixed_ptr + 1);
+            if (tablet_schema[cid].aggregation == OLAP_FIELD_AGGREGATION_BITMAP_UNION) {
+                size_t capacity = tablet_schema[cid].length - OLAP_STRING_MAX_BYTES;
+                BitmapContext* context = nullptr;
+                if (mem_pool != nullptr) {
+                    // memory of bitmap is released in finalize
+                    context = new (mem_pool->allocate(sizeof(BitmapContext)))
+                        BitmapContext(capacity);
+                } else {
+                    context = new BitmapContext(capacity);
+                    bitmap_contexts.push_back(context);
+                }
+                *(size_t*)(variable_ptr) = (size_t)(context);
+                variable_ptr += sizeof(BitmapContext*);
+            }
             slice->data = variable_ptr;
             slice->size = tablet_schema[cid].length - OLAP_STRING_MAX_BYTES;
             variable_ptr += slice->size;
@@ -328,14 +348,18 @@ bool RowCursor::equal(const RowCursor& other) const {
     return true;
 }
 
-void RowCursor::finalize_one_merge() {
+OLAPStatus RowCursor::finalize_one_merge() {
     for (size_t i = _key_column_num; i < _field_array.size(); ++i) {
         if (_field_array[i] == NULL) {
             continue;
         }
         char* dest = _field_array[i]->get_ptr(_fixed_buf);
-        _field_array[i]->finalize(dest);
+        OLAPStatus res = _field_array[i]->finalize(dest);
+        if (res != OLAP_SUCCESS) {
+            return res;
+        }
     }
+    return OLAP_SUCCESS;
 }
 
 void RowCursor::aggregate(const RowCursor& other) {
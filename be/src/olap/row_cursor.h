@@ -96,8 +96,8 @@ public:
     void aggregate(const RowCursor& other);
 
     // now only used by hll column, do aggregating
-    void finalize_one_merge();
-    inline void finalize_one_merge(const std::vector<uint32_t>& ids);
+    OLAPStatus finalize_one_merge();
+    inline OLAPStatus finalize_one_merge(const std::vector<uint32_t>& ids);
 
     // RowCursor attach到一段连续的buf
     inline void attach(char* buf) { _fixed_buf = buf; }
@@ -191,6 +191,7 @@ private:
     size_t _variable_len;
     bool _variable_buf_allocated_by_pool;
     std::vector<HllContext*> hll_contexts;
+    std::vector<BitmapContext*> bitmap_contexts;
 
     DISALLOW_COPY_AND_ASSIGN(RowCursor);
 };
@@ -229,11 +230,15 @@ inline OLAPStatus RowCursor::agg_init(const RowCursor& other) {
     return OLAP_SUCCESS;
 }
 
-inline void RowCursor::finalize_one_merge(const std::vector<uint32_t>& ids) {
+inline OLAPStatus RowCursor::finalize_one_merge(const std::vector<uint32_t>& ids) {
     for (uint32_t id : ids) {
         char* dest = _field_array[id]->get_ptr(_fixed_buf);
-        _field_array[id]->finalize(dest);
+        OLAPStatus res = _field_array[id]->finalize(dest);
+        if (OLAP_UNLIKELY(res != OLAP_SUCCESS)) {
+            return res;
+        }
     }
+    return OLAP_SUCCESS;
 }
 
 inline uint32_t RowCursor::hash_code(uint32_t seed) const {
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "olap/i_data.h"
+#include "olap/io_governor.h"
 #include "olap/merger.h"
 #include "olap/olap_data.h"
 #include "olap/olap_engine.h"
@@ -483,12 +484,18 @@ OLAPStatus RowBlockAllocator::allocate(RowBlock** row_block,
                                        bool null_supported) {
     size_t row_block_size = _row_len * num_rows;
 
-    if (_memory_limitation > 0
-            && _memory_allocated + row_block_size > _memory_limitation) {
-        OLAP_LOG_DEBUG("RowBlockAllocator::alocate() memory exceeded. [m_memory_allocated=%ld]",
-                       _memory_allocated);
-        *row_block = NULL;
-        return OLAP_SUCCESS;
+    {
+        AutoMutexLock l(&_lock);
+        if (_memory_limitation > 0
+                && _memory_allocated + row_block_size > _memory_limitation) {
+            OLAP_LOG_DEBUG("RowBlockAllocator::alocate() memory exceeded. "
+                           "[m_memory_allocated=%ld]",
+                           _memory_allocated);
+            *row_block = NULL;
+            return OLAP_SUCCESS;
+        }
+        // 先占用内存，避免其他线程同时分配超出限制
+        _memory_allocated += row_block_size;
     }
 
     // TODO(lijiao) : 为什么舍弃原有的m_row_block_buffer
@@ -496,6 +503,8 @@ OLAPStatus RowBlockAllocator::allocate(RowBlock** row_block,
 
     if (*row_block == NULL) {
         OLAP_LOG_WARNING("failed to malloc RowBlock. [size=%ld]", sizeof(RowBlock));
+        AutoMutexLock l(&_lock);
+        _memory_allocated -= row_block_size;
         return OLAP_ERR_MALLOC_ERROR;
     }
 
@@ -507,15 +516,15 @@ OLAPStatus RowBlockAllocator::allocate(RowBlock** row_block,
     if ((res = (*row_block)->init(row_block_info)) != OLAP_SUCCESS) {
         OLAP_LOG_WARNING("failed to init row block.");
         SAFE_DELETE(*row_block);
+        AutoMutexLock l(&_lock);
+        _memory_allocated -= row_block_size;
         return res;
     }
 
-    _memory_allocated += row_block_size;
     OLAP_LOG_DEBUG("RowBlockAllocator::allocate() "
-                   "[this=%p num_rows=%ld m_memory_allocated=%ld p=%p]",
+                   "[this=%p num_rows=%ld p=%p]",
                    this,
                    num_rows,
-                   _memory_allocated,
                    *row_block);
     return res;
 }
@@ -526,15 +535,16 @@ void RowBlockAllocator::release(RowBlock* row_block) {
         return;
     }
 
-    _memory_allocated -= row_block->capacity() * _row_len;
-
     OLAP_LOG_DEBUG("RowBlockAllocator::release() "
-                   "[this=%p num_rows=%ld m_memory_allocated=%ld p=%p]",
+                   "[this=%p num_rows=%ld p=%p]",
                    this,
                    row_block->capacity(),
-                   _memory_allocated,
                    row_block);
+    size_t row_block_size = row_block->capacity() * _row_len;
     delete row_block;
+
+    AutoMutexLock l(&_lock);
+    _memory_allocated -= row_block_size;
 }
 
 RowBlockMerger::RowBlockMerger(SmartOLAPTable olap_table) : _olap_table(olap_table) {}
@@ -586,7 +596,10 @@ bool RowBlockMerger::merge(
                 goto MERGE_ERR;
             }
         }
-        row_cursor.finalize_one_merge();
+        if (row_cursor.finalize_one_merge() != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to finalize row.");
+            goto MERGE_ERR;
+        }
         writer->next(row_cursor);
     }
     if (writer->finalize() != OLAP_SUCCESS) {
@@ -848,6 +861,9 @@ bool SchemaChangeDirectly::process(IData* olap_data, OLAPIndex* new_olap_index)
             goto DIRECTLY_PROCESS_ERR;
         }
         add_filted_rows(filted_rows);
+        if (report_alter_progress()) {
+            _olap_table->add_alter_processed_rows(ref_row_block->row_block_info().row_num);
+        }
 
         if (!_write_row_block(writer, new_row_block)) {
             OLAP_LOG_WARNING("failed to write row block.");
@@ -898,21 +914,33 @@ DIRECTLY_PROCESS_ERR:
     return result;
 }
 
+// 每次SchemaChange做外排的时候，会写一些临时版本，为避免Cache冲突，临时版本进行2个处理：
+// 1. 随机值作为VersionHash
+// 2. 版本号取一个BIG NUMBER加上递增的序号，并行的SchemaChange共用这个序号
+static const int32_t TEMP_DELTA_VERSION_BASE = (1 << 28);
+static atomic_t s_temp_delta_version_seq = 0;
+
+static Version next_temp_delta_version() {
+    int32_t version = TEMP_DELTA_VERSION_BASE
+            + atomic_inc_return(&s_temp_delta_version_seq) % TEMP_DELTA_VERSION_BASE;
+    return Version(version, version);
+}
+
+static bool temp_olap_index_less(const OLAPIndex* a, const OLAPIndex* b) {
+    return a->version().first < b->version().first;
+}
+
 SchemaChangeWithSorting::SchemaChangeWithSorting(SmartOLAPTable olap_table,
                                                  const RowBlockChanger& row_block_changer,
                                                  size_t memory_limitation) :
         _olap_table(olap_table),
         _row_block_changer(row_block_changer),
         _memory_limitation(memory_limitation),
-        _row_block_allocator(NULL) {
-    // 每次SchemaChange做外排的时候，会写一些临时版本（比如999,1000,1001），为避免Cache冲突，临时
-    // 版本进行2个处理：
-    // 1. 随机值作为VersionHash
-    // 2. 版本号取一个BIG NUMBER加上当前正在进行SchemaChange的版本号
-    _temp_delta_versions.first = (1 << 28);
-    _temp_delta_versions.second = (1 << 28);
-    // TODO(zyh): remove the magic number
-}
+        _row_block_allocator(NULL),
+        _cond(_lock),
+        _running_runs(0),
+        _finished(false),
+        _failed(false) {}
 
 SchemaChangeWithSorting::~SchemaChangeWithSorting() {
     OLAP_LOG_DEBUG("~SchemaChangeWithSorting()");
@@ -930,9 +958,6 @@ bool SchemaChangeWithSorting::process(IData* olap_data, OLAPIndex* new_olap_inde
     }
 
     bool result = true;
-    DataFileType data_file_type = new_olap_index->table()->data_file_type();
-    bool null_supported = true;
-
     RowBlock* ref_row_block = NULL;
     OLAPStatus res = olap_data->get_first_row_block(&ref_row_block);
 
@@ -957,28 +982,75 @@ bool SchemaChangeWithSorting::process(IData* olap_data, OLAPIndex* new_olap_inde
         return result;
     }
 
-    RowBlockSorter row_block_sorter(_row_block_allocator);
+    // Reset filted_rows and merged_rows statistic
+    reset_merged_rows();
+    reset_filted_rows();
 
-    // for internal sorting
-    RowBlock* new_row_block = NULL;
-    vector<RowBlock*> row_block_arr;
+    _start_sorting_threads();
+    result = _sort_and_merge(olap_data, ref_row_block, new_olap_index);
+    _join_sorting_threads(!result);
+
+    for (vector<OLAPIndex*>::iterator it = _temp_olap_indices.begin();
+            it != _temp_olap_indices.end(); ++it) {
+        (*it)->delete_all_files();
+        SAFE_DELETE(*it);
+    }
+    _temp_olap_indices.clear();
 
-    // for external sorting
-    vector<OLAPIndex*> olap_index_arr;
+    if (!result) {
+        return false;
+    }
 
-    _temp_delta_versions.first = _temp_delta_versions.second;
+    add_filted_rows(olap_data->get_filted_rows());
 
-    // Reset filted_rows and merged_rows statistic
-    reset_merged_rows();
-    reset_filted_rows();
+    // Check row num changes
+    if (config::row_nums_check) {
+        if (olap_data->olap_index()->num_rows()
+            != new_olap_index->num_rows() + merged_rows() + filted_rows()) {
+            OLAP_LOG_WARNING("fail to check row num! "
+                             "[source_rows=%lu merged_rows=%lu filted_rows=%lu new_index_rows=%lu]",
+                             olap_data->olap_index()->num_rows(),
+                             merged_rows(), filted_rows(), new_olap_index->num_rows());
+            result = false;
+        }
+    } else {
+        OLAP_LOG_INFO("all row nums. "
+                      "[source_rows=%lu merged_rows=%lu filted_rows=%lu new_index_rows=%lu]",
+                      olap_data->olap_index()->num_rows(),
+                      merged_rows(), filted_rows(), new_olap_index->num_rows());
+    }
+
+    return result;
+}
+
+bool SchemaChangeWithSorting::_sort_and_merge(IData* olap_data,
+                                              RowBlock* ref_row_block,
+                                              OLAPIndex* new_olap_index) {
+    DataFileType data_file_type = new_olap_index->table()->data_file_type();
+    bool null_supported = true;
+    RowBlockSorter row_block_sorter(_row_block_allocator);
+
+    // 当前线程和每个写出线程各持有一个数据段，读取排序和写出可以同时进行
+    size_t run_memory_limitation = _memory_limitation / (_sorting_threads.size() + 1);
+    size_t run_memory = 0;
+    vector<RowBlock*> row_block_arr;
+    RowBlock* new_row_block = NULL;
 
     while (NULL != ref_row_block) {
-        if (OLAP_SUCCESS != _row_block_allocator->allocate(
-                    &new_row_block, ref_row_block->row_block_info().row_num, 
-                    data_file_type, null_supported)) {
+        size_t num_rows = ref_row_block->row_block_info().row_num;
+        size_t row_block_memory = _row_block_allocator->memory_size(num_rows);
+        if (!row_block_arr.empty() && run_memory + row_block_memory > run_memory_limitation) {
+            if (!_submit_sorted_run(&row_block_arr)) {
+                OLAP_LOG_WARNING("failed to sorting internally.");
+                return false;
+            }
+            run_memory = 0;
+        }
+
+        if (!_allocate_row_block(&new_row_block, num_rows, data_file_type, null_supported)) {
             OLAP_LOG_WARNING("failed to allocate RowBlock.");
-            result = false;
-            goto SORTING_PROCESS_ERR;
+            _release_row_blocks(&row_block_arr);
+            return false;
         }
 
         if (NULL == new_row_block) {
@@ -990,28 +1062,11 @@ bool SchemaChangeWithSorting::process(IData* olap_data, OLAPIndex* new_olap_inde
             }
 
             // enter here while memory limitation is reached.
-            OLAPIndex* olap_index = NULL;
-
-            if (!_internal_sorting(row_block_arr,
-                                   Version(_temp_delta_versions.second,
-                                           _temp_delta_versions.second),
-                                   &olap_index)) {
+            if (!_submit_sorted_run(&row_block_arr)) {
                 OLAP_LOG_WARNING("failed to sorting internally.");
-                result = false;
-                goto SORTING_PROCESS_ERR;
-            }
-
-            olap_index_arr.push_back(olap_index);
-
-            for (vector<RowBlock*>::iterator it = row_block_arr.begin();
-                    it != row_block_arr.end(); ++it) {
-                _row_block_allocator->release(*it);
+                return false;
             }
-
-            row_block_arr.clear();
-
-            // increase temp version
-            ++_temp_delta_versions.second;
+            run_memory = 0;
             continue;
         }
 
@@ -1023,117 +1078,255 @@ bool SchemaChangeWithSorting::process(IData* olap_data, OLAPIndex* new_olap_inde
                 new_row_block,
                 &filted_rows)) {
             OLAP_LOG_WARNING("failed to change data in row block.");
-            result = false;
-            goto SORTING_PROCESS_ERR;
+            _row_block_allocator->release(new_row_block);
+            _release_row_blocks(&row_block_arr);
+            return false;
         }
         add_filted_rows(filted_rows);
+        if (report_alter_progress()) {
+            _olap_table->add_alter_processed_rows(num_rows);
+        }
 
         if (new_row_block->row_block_info().row_num > 0) {
             if (!row_block_sorter.sort(&new_row_block)) {
                 OLAP_LOG_WARNING("failed to sort row block.");
-                result = false;
-                OLAP_GOTO(SORTING_PROCESS_ERR);
+                _row_block_allocator->release(new_row_block);
+                _release_row_blocks(&row_block_arr);
+                return false;
             }
 
             row_block_arr.push_back(new_row_block);
+            run_memory += row_block_memory;
         } else {
             _row_block_allocator->release(new_row_block);
-            new_row_block = NULL;
         }
+        new_row_block = NULL;
 
         olap_data->get_next_row_block(&ref_row_block);
     }
 
-    if (!row_block_arr.empty()) {
-        // enter here while memory limitation is reached.
-        OLAPIndex* olap_index = NULL;
+    bool single_run = false;
+    {
+        AutoMutexLock l(&_lock);
+        if (_failed) {
+            OLAP_LOG_WARNING("failed to sorting internally.");
+            _release_row_blocks(&row_block_arr);
+            return false;
+        }
+        single_run = _temp_olap_indices.empty()
+                && _pending_runs.empty()
+                && _running_runs == 0;
+    }
 
-        if (!_internal_sorting(row_block_arr,
-                               Version(_temp_delta_versions.second, _temp_delta_versions.second),
-                               &olap_index)) {
+    // 只有一个数据段时直接写成新版本，不需要再外排
+    if (single_run && !row_block_arr.empty()) {
+        uint64_t merged_rows = 0;
+        bool result = _internal_sorting(row_block_arr, new_olap_index, &merged_rows);
+        _release_row_blocks(&row_block_arr);
+        if (!result) {
             OLAP_LOG_WARNING("failed to sorting internally.");
-            result = false;
-            goto SORTING_PROCESS_ERR;
+            return false;
         }
+        add_merged_rows(merged_rows);
+        return true;
+    }
+
+    if (!row_block_arr.empty() && !_submit_sorted_run(&row_block_arr)) {
+        OLAP_LOG_WARNING("failed to sorting internally.");
+        return false;
+    }
+
+    if (!_join_sorting_threads(false)) {
+        OLAP_LOG_WARNING("failed to sorting internally.");
+        return false;
+    }
 
-        olap_index_arr.push_back(olap_index);
+    // 写出线程完成的顺序不确定，按临时版本排序，保持和数据读取的顺序一致
+    std::sort(_temp_olap_indices.begin(), _temp_olap_indices.end(), temp_olap_index_less);
+    if (!_external_sorting(_temp_olap_indices, new_olap_index)) {
+        OLAP_LOG_WARNING("failed to sorting externally.");
+        return false;
+    }
 
-        for (vector<RowBlock*>::iterator it = row_block_arr.begin();
-                it != row_block_arr.end(); ++it) {
-            _row_block_allocator->release(*it);
+    return true;
+}
+
+void SchemaChangeWithSorting::_start_sorting_threads() {
+    _finished = false;
+    _failed = false;
+    _running_runs = 0;
+
+    int32_t num_threads = config::schema_change_sorting_num_threads;
+    if (num_threads < 0) {
+        OLAP_LOG_WARNING("schema change sorting thread number config is illegal: [%d], "
+                         "force set to 0", num_threads);
+        num_threads = 0;
+    }
+    for (int32_t i = 0; i < num_threads; ++i) {
+        pthread_t thread;
+        if (0 != pthread_create(&thread, NULL, _sorting_thread_callback, this)) {
+            OLAP_LOG_WARNING("failed to start schema change sorting thread. [table='%s']",
+                             _olap_table->full_name().c_str());
+            break;
         }
+        _sorting_threads.push_back(thread);
+    }
+}
 
-        row_block_arr.clear();
+bool SchemaChangeWithSorting::_join_sorting_threads(bool abort) {
+    {
+        AutoMutexLock l(&_lock);
+        _finished = true;
+        if (abort) {
+            _failed = true;
+        }
+        _cond.notify_all();
+    }
 
-        // increase temp version
-        ++_temp_delta_versions.second;
+    for (pthread_t thread : _sorting_threads) {
+        pthread_join(thread, NULL);
     }
+    _sorting_threads.clear();
 
-    // TODO(zyh): 如果_temp_delta_versions只有一个，不需要再外排
-    if (!_external_sorting(olap_index_arr, new_olap_index)) {
-        OLAP_LOG_WARNING("failed to sorting externally.");
-        result = false;
-        goto SORTING_PROCESS_ERR;
+    // 失败时丢弃没有写出的数据段和临时版本
+    for (SortedRun* run : _pending_runs) {
+        _release_row_blocks(&run->row_block_arr);
+        delete run;
     }
+    _pending_runs.clear();
 
-    add_filted_rows(olap_data->get_filted_rows());
+    return !_failed;
+}
 
-    // Check row num changes
-    if (config::row_nums_check) {
-        if (olap_data->olap_index()->num_rows()
-            != new_olap_index->num_rows() + merged_rows() + filted_rows()) {
-            OLAP_LOG_WARNING("fail to check row num! "
-                             "[source_rows=%lu merged_rows=%lu filted_rows=%lu new_index_rows=%lu]",
-                             olap_data->olap_index()->num_rows(),
-                             merged_rows(), filted_rows(), new_olap_index->num_rows());
-            result = false;
+void* SchemaChangeWithSorting::_sorting_thread_callback(void* arg) {
+    SchemaChangeWithSorting* sc_procedure = static_cast<SchemaChangeWithSorting*>(arg);
+    // add tid to cgroup
+    CgroupsMgr::apply_system_cgroup();
+    IOPriorityScope io_priority(IO_PRIORITY_SCHEMA_CHANGE);
+
+    while (true) {
+        SortedRun* run = NULL;
+        {
+            AutoMutexLock l(&sc_procedure->_lock);
+            while (!sc_procedure->_failed
+                    && !sc_procedure->_finished
+                    && sc_procedure->_pending_runs.empty()) {
+                sc_procedure->_cond.wait();
+            }
+            if (sc_procedure->_failed || sc_procedure->_pending_runs.empty()) {
+                break;
+            }
+            run = sc_procedure->_pending_runs.front();
+            sc_procedure->_pending_runs.pop_front();
+            ++sc_procedure->_running_runs;
+        }
+
+        bool result = sc_procedure->_write_sorted_run(run);
+
+        AutoMutexLock l(&sc_procedure->_lock);
+        --sc_procedure->_running_runs;
+        // 唤醒等待内存的转换线程
+        sc_procedure->_cond.notify_all();
+        if (!result) {
+            break;
         }
-    } else {
-        OLAP_LOG_INFO("all row nums. "
-                      "[source_rows=%lu merged_rows=%lu filted_rows=%lu new_index_rows=%lu]",
-                      olap_data->olap_index()->num_rows(),
-                      merged_rows(), filted_rows(), new_olap_index->num_rows());
     }
 
-SORTING_PROCESS_ERR:
-    for (vector<OLAPIndex*>::iterator it = olap_index_arr.begin();
-            it != olap_index_arr.end(); ++it) {
-        (*it)->delete_all_files();
-        SAFE_DELETE(*it);
+    return NULL;
+}
+
+bool SchemaChangeWithSorting::_allocate_row_block(RowBlock** row_block,
+                                                  size_t num_rows,
+                                                  DataFileType data_file_type,
+                                                  bool null_supported) {
+    AutoMutexLock l(&_lock);
+    while (true) {
+        if (_failed) {
+            return false;
+        }
+
+        if (OLAP_SUCCESS != _row_block_allocator->allocate(
+                    row_block, num_rows, data_file_type, null_supported)) {
+            return false;
+        }
+
+        if (NULL != *row_block || (_pending_runs.empty() && _running_runs == 0)) {
+            return true;
+        }
+
+        _cond.wait();
     }
+}
 
-    for (vector<RowBlock*>::iterator it = row_block_arr.begin();
-            it != row_block_arr.end(); ++it) {
-        _row_block_allocator->release(*it);
+bool SchemaChangeWithSorting::_submit_sorted_run(vector<RowBlock*>* row_block_arr) {
+    SortedRun* run = new(nothrow) SortedRun();
+    if (NULL == run) {
+        OLAP_LOG_WARNING("failed to malloc SortedRun. [size=%ld]", sizeof(SortedRun));
+        _release_row_blocks(row_block_arr);
+        return false;
+    }
+    run->row_block_arr.swap(*row_block_arr);
+    // 临时版本按数据读取的顺序递增
+    run->version = next_temp_delta_version();
+
+    if (_sorting_threads.empty()) {
+        return _write_sorted_run(run);
     }
 
-    row_block_arr.clear();
+    AutoMutexLock l(&_lock);
+    _pending_runs.push_back(run);
+    _cond.notify_all();
+    return !_failed;
+}
+
+bool SchemaChangeWithSorting::_write_sorted_run(SortedRun* run) {
+    uint64_t merged_rows = 0;
+    bool result = false;
+    OLAPIndex* olap_index = new(nothrow) OLAPIndex(_olap_table.get(),
+                                                   run->version,
+                                                   rand(),
+                                                   false,
+                                                   0,
+                                                   0);
+    if (NULL == olap_index) {
+        OLAP_LOG_WARNING("failed to malloc OLAPIndex. [size=%ld]", sizeof(OLAPIndex));
+    } else {
+        result = _internal_sorting(run->row_block_arr, olap_index, &merged_rows);
+    }
+    _release_row_blocks(&run->row_block_arr);
+    delete run;
+
+    AutoMutexLock l(&_lock);
+    if (result) {
+        _temp_olap_indices.push_back(olap_index);
+        add_merged_rows(merged_rows);
+    } else {
+        OLAP_LOG_WARNING("failed to sorting internally.");
+        SAFE_DELETE(olap_index);
+        _failed = true;
+    }
     return result;
 }
 
+void SchemaChangeWithSorting::_release_row_blocks(vector<RowBlock*>* row_block_arr) {
+    for (vector<RowBlock*>::iterator it = row_block_arr->begin();
+            it != row_block_arr->end(); ++it) {
+        _row_block_allocator->release(*it);
+    }
+    row_block_arr->clear();
+}
+
 bool SchemaChangeWithSorting::_internal_sorting(const vector<RowBlock*>& row_block_arr,
-                                                const Version& temp_delta_versions,
-                                                OLAPIndex** temp_olap_index) {
+                                                OLAPIndex* olap_index,
+                                                uint64_t* merged_rows) {
     IWriter* writer = NULL;
-    uint64_t merged_rows = 0;
     RowBlockMerger merger(_olap_table);
 
-    (*temp_olap_index) = new(nothrow) OLAPIndex(_olap_table.get(),
-                                                temp_delta_versions,
-                                                rand(),
-                                                false,
-                                                0,
-                                                0);
-    if (NULL == (*temp_olap_index)) {
-        OLAP_LOG_WARNING("failed to malloc OLAPIndex. [size=%ld]", sizeof(OLAPIndex));
-        goto INTERNAL_SORTING_ERR;
-    }
-
     OLAP_LOG_DEBUG("init writer. [table='%s' block_row_size=%lu]",
                    _olap_table->full_name().c_str(),
                    _olap_table->num_rows_per_row_block());
 
-    writer = IWriter::create(_olap_table, *temp_olap_index, false);
+    writer = IWriter::create(_olap_table, olap_index, false);
     if (NULL == writer) {
         OLAP_LOG_WARNING("failed to create writer.");
         goto INTERNAL_SORTING_ERR;
@@ -1144,13 +1337,12 @@ bool SchemaChangeWithSorting::_internal_sorting(const vector<RowBlock*>& row_blo
         goto INTERNAL_SORTING_ERR;
     }
 
-    if (!merger.merge(row_block_arr, writer, &merged_rows)) {
+    if (!merger.merge(row_block_arr, writer, merged_rows)) {
         OLAP_LOG_WARNING("failed to merge row blocks.");
         goto INTERNAL_SORTING_ERR;
     }
-    add_merged_rows(merged_rows);
 
-    if (OLAP_SUCCESS != (*temp_olap_index)->load()) {
+    if (OLAP_SUCCESS != olap_index->load()) {
         OLAP_LOG_WARNING("failed to reload olap index.");
         goto INTERNAL_SORTING_ERR;
     }
@@ -1161,8 +1353,7 @@ bool SchemaChangeWithSorting::_internal_sorting(const vector<RowBlock*>& row_blo
 INTERNAL_SORTING_ERR:
     SAFE_DELETE(writer);
 
-    (*temp_olap_index)->delete_all_files();
-    SAFE_DELETE(*temp_olap_index);
+    olap_index->delete_all_files();
     return false;
 }
 
@@ -1361,6 +1552,7 @@ OLAPStatus SchemaChangeHandler::process_alter_table(
         const TAlterTabletReq& request) {
     OLAPStatus res = OLAP_SUCCESS;
     OLAP_LOG_INFO("begin to validate alter tablet request.");
+    IOPriorityScope io_priority(IO_PRIORITY_SCHEMA_CHANGE);
 
     // 1. Lock schema_change_lock util schema change info is stored in table header
     if (!OLAPEngine::get_instance()->try_schema_change_lock(request.base_tablet_id)) {
@@ -1674,24 +1866,12 @@ OLAPStatus SchemaChangeHandler::schema_version_convert(
     // NOTE split_table如果使用row_block，会导致原block变小
     // 但由于历史数据在后续base/cumulative后还是会变成正常，故用directly也可以
     // b. 生成历史数据转换器
-    SchemaChange* sc_procedure = NULL;
-    if (true == sc_sorting) {
-        size_t memory_limitation = config::memory_limiation_per_thread_for_schema_change;
-        OLAP_LOG_INFO("doing schema change with sorting.");
-        sc_procedure = new(nothrow) SchemaChangeWithSorting(
-                                dest_olap_table,
-                                rb_changer,
-                                memory_limitation * 1024 * 1024 * 1024);
-    } else if (true == sc_directly || src_olap_table->data_file_type() == OLAP_DATA_FILE) {
-        OLAP_LOG_INFO("doing schema change directly.");
-        sc_procedure = new(nothrow) SchemaChangeDirectly(
-                                dest_olap_table, rb_changer);
-    } else {
-        OLAP_LOG_INFO("doing linked schema change.");
-        sc_procedure = new(nothrow) LinkedSchemaChange(
-                                src_olap_table,
-                                dest_olap_table);
-    }
+    SchemaChange* sc_procedure = _create_sc_procedure(src_olap_table,
+                                                      dest_olap_table,
+                                                      rb_changer,
+                                                      sc_sorting,
+                                                      sc_directly,
+                                                      1);
 
     if (NULL == sc_procedure) {
         OLAP_LOG_FATAL("failed to malloc SchemaChange. [size=%ld]",
@@ -1884,7 +2064,6 @@ OLAPStatus SchemaChangeHandler::_alter_table(SchemaChangeParams* sc_params) {
 
     bool sc_sorting = false;
     bool sc_directly = false;
-    SchemaChange* sc_procedure = NULL;
 
     // a. 解析Alter请求，转换成内部的表示形式
     res = _parse_request(sc_params->ref_olap_table,
@@ -1897,178 +2076,72 @@ OLAPStatus SchemaChangeHandler::_alter_table(SchemaChangeParams* sc_params) {
         goto PROCESS_ALTER_EXIT;
     }
 
-    // b. 生成历史数据转换器
-    if (true == sc_sorting) {
-        size_t memory_limitation = config::memory_limiation_per_thread_for_schema_change;
-        OLAP_LOG_INFO("doing schema change with sorting.");
-        sc_procedure = new(nothrow) SchemaChangeWithSorting(
-                               sc_params->new_olap_table,
-                               rb_changer,
-                               memory_limitation * 1024 * 1024 * 1024);
-    } else if (true == sc_directly
-               || sc_params->ref_olap_table->data_file_type() == OLAP_DATA_FILE) {
-        OLAP_LOG_INFO("doing schema change directly.");
-        sc_procedure = new(nothrow) SchemaChangeDirectly(
-                sc_params->new_olap_table, rb_changer);
-    } else {
-        OLAP_LOG_INFO("doing linked schema change.");
-        sc_procedure = new(nothrow) LinkedSchemaChange(
-                                sc_params->ref_olap_table,
-                                sc_params->new_olap_table);
-    }
-
-    if (NULL == sc_procedure) {
-        OLAP_LOG_WARNING("failed to malloc SchemaChange. [size=%ld]",
-                         sizeof(SchemaChangeWithSorting));
-        res = OLAP_ERR_MALLOC_ERROR;
-        goto PROCESS_ALTER_EXIT;
-    }
-
-    // c. 转换历史数据
-    for (vector<IData*>::iterator it = sc_params->ref_olap_data_arr.end() - 1;
-            it >= sc_params->ref_olap_data_arr.begin(); --it) {
-        OLAP_LOG_TRACE("begin to convert a history delta. [version='%d-%d']",
-                       (*it)->version().first, (*it)->version().second);
-
-        // set status for monitor
-        // 只要有一个new_table为running，ref table就设置为running
-        // NOTE 如果第一个sub_table先fail，这里会继续按正常走
-        sc_params->ref_olap_table->set_schema_change_status(
-                ALTER_TABLE_RUNNING,
-                sc_params->new_olap_table->schema_hash(),
-                -1);
-        sc_params->new_olap_table->set_schema_change_status(
-                ALTER_TABLE_RUNNING,
-                sc_params->ref_olap_table->schema_hash(),
-                (*it)->version().second);
-
-        // we create a new delta with the same version as the IData processing currently.
-        OLAPIndex* new_olap_index = new(nothrow) OLAPIndex(
-                                            sc_params->new_olap_table.get(),
-                                            (*it)->version(),
-                                            (*it)->version_hash(),
-                                            (*it)->delete_flag(),
-                                            0,
-                                            (*it)->max_timestamp());
-
-        if (new_olap_index == NULL) {
-            OLAP_LOG_WARNING("failed to malloc OLAPIndex. [size=%ld]", sizeof(OLAPIndex));
-            res = OLAP_ERR_MALLOC_ERROR;
+    // b. linked schema change不会过滤被删除的数据，把删除条件复制到新表
+    if (!sc_sorting && !sc_directly
+            && sc_params->ref_olap_table->data_file_type() != OLAP_DATA_FILE) {
+        res = _copy_delete_conditions(sc_params->ref_olap_table,
+                                      sc_params->new_olap_table,
+                                      end_version);
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("failed to copy delete conditions. [res=%d]", res);
             goto PROCESS_ALTER_EXIT;
         }
+    }
 
-        (*it)->set_delete_handler(sc_params->delete_handler);
-        int del_ret = (*it)->delete_pruning_filter();
-        if (DEL_SATISFIED == del_ret) {
-            OLAP_LOG_DEBUG("filter delta in schema change: %d, %d",
-                           (*it)->version().first, (*it)->version().second);
-            res = sc_procedure->create_init_version(
-                                                    new_olap_index->table()->tablet_id(),
-                                                    new_olap_index->table()->schema_hash(),
-                                                    new_olap_index->version(),
-                                                    new_olap_index->version_hash(),
-                                                    new_olap_index);
-            sc_procedure->add_filted_rows((*it)->num_rows());
-            if (res != OLAP_SUCCESS) {
-                OLAP_LOG_WARNING("fail to create init version. [res=%d]", res);
-                res = OLAP_ERR_INPUT_PARAMETER_ERROR;
-                OLAP_GOTO(PROCESS_ALTER_EXIT);
+    // c. 多个线程并行转换历史数据，每个线程使用自己的历史数据转换器
+    {
+        AlterTableContext context;
+        context.sc_params = sc_params;
+        context.rb_changer = &rb_changer;
+        context.sc_sorting = sc_sorting;
+        context.sc_directly = sc_directly;
+        context.olap_data_arr.assign(sc_params->ref_olap_data_arr.rbegin(),
+                                     sc_params->ref_olap_data_arr.rend());
+        context.converted.resize(context.olap_data_arr.size(), false);
+        context.next_data = 0;
+        context.res = OLAP_SUCCESS;
+
+        int64_t total_rows = 0;
+        for (IData* olap_data : context.olap_data_arr) {
+            total_rows += olap_data->olap_index()->num_rows();
+        }
+        sc_params->new_olap_table->set_alter_total_rows(total_rows);
+
+        // 排序需要的内存由转换线程平分
+        int32_t num_threads = config::schema_change_num_threads;
+        if (num_threads <= 0) {
+            OLAP_LOG_WARNING("schema change thread number config is illegal: [%d], "
+                             "force set to 1", num_threads);
+            num_threads = 1;
+        }
+        if (static_cast<size_t>(num_threads) > context.olap_data_arr.size()) {
+            num_threads = context.olap_data_arr.size();
+        }
+        context.num_threads = num_threads;
+        vector<pthread_t> threads;
+        for (int32_t i = 1; i < num_threads; ++i) {
+            pthread_t thread;
+            if (0 != pthread_create(&thread, NULL, _alter_table_thread_callback, &context)) {
+                OLAP_LOG_WARNING("failed to start schema change thread. [table='%s']",
+                                 sc_params->new_olap_table->full_name().c_str());
+                break;
             }
-        } else if (DEL_PARTIAL_SATISFIED == del_ret) {
-            OLAP_LOG_DEBUG("filter delta partially in schema change: %d, %d",
-                           (*it)->version().first, (*it)->version().second);
-            (*it)->set_delete_status(DEL_PARTIAL_SATISFIED);
-        } else {
-            OLAP_LOG_DEBUG("not filter delta in schema change: %d, %d",
-                           (*it)->version().first, (*it)->version().second);
-            (*it)->set_delete_status(DEL_NOT_SATISFIED);
+            threads.push_back(thread);
         }
-
-        if (DEL_SATISFIED != del_ret && !sc_procedure->process(*it, new_olap_index)) {
-            //if del_ret is DEL_SATISFIED, the new delta version has already been created in new_olap_table
-            OLAP_LOG_WARNING("failed to process the version. [version='%d-%d']",
-                             (*it)->version().first, (*it)->version().second);
-            new_olap_index->delete_all_files();
-            SAFE_DELETE(new_olap_index);
-
-            res = OLAP_ERR_INPUT_PARAMETER_ERROR;
-            goto PROCESS_ALTER_EXIT;
+        // 当前线程也参与转换
+        _alter_table_thread_callback(&context);
+        for (pthread_t thread : threads) {
+            pthread_join(thread, NULL);
         }
 
-        // 将新版本的数据加入header
-        // 为了防止死锁的出现，一定要先锁住旧表，再锁住新表
-        sc_params->new_olap_table->obtain_push_lock();
-        sc_params->ref_olap_table->obtain_header_wrlock();
-        sc_params->new_olap_table->obtain_header_wrlock();
-
-        if (!sc_params->new_olap_table->has_version((*it)->version())) {
-            // register version
-            res = sc_params->new_olap_table->register_data_source(new_olap_index);
-            if (OLAP_SUCCESS != res) {
-                OLAP_LOG_WARNING("failed to register new version. [table='%s' version='%d-%d']",
-                                 sc_params->new_olap_table->full_name().c_str(),
-                                 (*it)->version().first,
-                                 (*it)->version().second);
-                new_olap_index->delete_all_files();
-                SAFE_DELETE(new_olap_index);
-
-                sc_params->new_olap_table->release_header_lock();
-                sc_params->ref_olap_table->release_header_lock();
-
-                goto PROCESS_ALTER_EXIT;
+        // 没有转换的历史版本在最后释放
+        sc_params->ref_olap_data_arr.clear();
+        for (size_t i = 0; i < context.olap_data_arr.size(); ++i) {
+            if (!context.converted[i]) {
+                sc_params->ref_olap_data_arr.push_back(context.olap_data_arr[i]);
             }
-
-            OLAP_LOG_DEBUG("register new version. [table='%s' version='%d-%d']",
-                           sc_params->new_olap_table->full_name().c_str(),
-                           (*it)->version().first,
-                           (*it)->version().second);
-        } else {
-            OLAP_LOG_WARNING("version already exist, version revert occured. "
-                             "[table='%s' version='%d-%d']",
-                             sc_params->new_olap_table->full_name().c_str(),
-                             (*it)->version().first, (*it)->version().second);
-            new_olap_index->delete_all_files();
-            SAFE_DELETE(new_olap_index);
         }
-
-        // 保存header
-        if (OLAP_SUCCESS != sc_params->new_olap_table->save_header()) {
-            OLAP_LOG_FATAL("fail to save header. [res=%d table='%s']",
-                           res, sc_params->new_olap_table->full_name().c_str());
-        }
-
-        // XXX: 此处需要验证ref_olap_data_arr中最后一个版本是否与new_olap_table的header中记录的最
-        //      后一个版本相同。然后还要注意一致性问题。
-        if (!sc_params->ref_olap_table->remove_last_schema_change_version(
-                    sc_params->new_olap_table)) {
-            OLAP_LOG_WARNING("failed to remove the last version did schema change.");
-
-            sc_params->new_olap_table->release_header_lock();
-            sc_params->ref_olap_table->release_header_lock();
-
-            res = OLAP_ERR_INPUT_PARAMETER_ERROR;
-            goto PROCESS_ALTER_EXIT;
-        }
-
-        // 保存header
-        if (OLAP_SUCCESS != sc_params->ref_olap_table->save_header()) {
-            OLAP_LOG_FATAL("failed to save header. [table='%s']",
-                           sc_params->new_olap_table->full_name().c_str());
-        }
-
-        sc_params->new_olap_table->release_header_lock();
-        sc_params->ref_olap_table->release_header_lock();
-        sc_params->new_olap_table->release_push_lock();
-
-        OLAP_LOG_TRACE("succeed to convert a history version. [version='%d-%d']",
-                       (*it)->version().first,
-                       (*it)->version().second);
-
-        // 释放IData
-        vector<IData*> olap_data_to_be_released(it, it + 1);
-        sc_params->ref_olap_table->release_data_sources(&olap_data_to_be_released);
-
-        it = sc_params->ref_olap_data_arr.erase(it); // after erasing, it will point to end()
+        res = context.res;
     }
 
     // XXX: 此时应该不取消SchemaChange状态，因为新Delta还要转换成新旧Schema的版本
@@ -2115,12 +2188,238 @@ PROCESS_ALTER_EXIT:
     }
 
     sc_params->ref_olap_table->release_data_sources(&(sc_params->ref_olap_data_arr));
-    SAFE_DELETE(sc_procedure);
 
     OLAP_LOG_INFO("finish to process alter table job. [res=%d]", res);
     return res;
 }
 
+void* SchemaChangeHandler::_alter_table_thread_callback(void* arg) {
+    AlterTableContext* context = static_cast<AlterTableContext*>(arg);
+    SchemaChangeParams* sc_params = context->sc_params;
+    // add tid to cgroup
+    CgroupsMgr::apply_system_cgroup();
+    IOPriorityScope io_priority(IO_PRIORITY_SCHEMA_CHANGE);
+
+    SchemaChange* sc_procedure = _create_sc_procedure(sc_params->ref_olap_table,
+                                                      sc_params->new_olap_table,
+                                                      *context->rb_changer,
+                                                      context->sc_sorting,
+                                                      context->sc_directly,
+                                                      context->num_threads);
+    if (NULL == sc_procedure) {
+        OLAP_LOG_WARNING("failed to malloc SchemaChange. [size=%ld]",
+                         sizeof(SchemaChangeWithSorting));
+        AutoMutexLock l(&context->lock);
+        context->res = OLAP_ERR_MALLOC_ERROR;
+        return NULL;
+    }
+    sc_procedure->enable_alter_progress();
+
+    while (true) {
+        size_t i = atomic_inc_return(&context->next_data) - 1;
+        if (i >= context->olap_data_arr.size()) {
+            break;
+        }
+
+        IData* olap_data = context->olap_data_arr[i];
+        {
+            AutoMutexLock l(&context->lock);
+            // 一个版本转换失败后，其他线程也停止转换
+            if (context->res != OLAP_SUCCESS) {
+                break;
+            }
+
+            // set status for monitor
+            // 只要有一个new_table为running，ref table就设置为running
+            // NOTE 如果第一个sub_table先fail，这里会继续按正常走
+            sc_params->ref_olap_table->set_schema_change_status(
+                    ALTER_TABLE_RUNNING,
+                    sc_params->new_olap_table->schema_hash(),
+                    -1);
+            sc_params->new_olap_table->set_schema_change_status(
+                    ALTER_TABLE_RUNNING,
+                    sc_params->ref_olap_table->schema_hash(),
+                    olap_data->version().second);
+        }
+
+        int64_t num_rows = olap_data->olap_index()->num_rows();
+        OLAPStatus res = _convert_history_version(sc_params, sc_procedure, olap_data);
+        // 需要重写数据时在转换过程中更新进度，链接文件时在转换后更新
+        if (res == OLAP_SUCCESS && !context->sc_sorting && !context->sc_directly
+                && sc_params->ref_olap_table->data_file_type() != OLAP_DATA_FILE) {
+            sc_params->new_olap_table->add_alter_processed_rows(num_rows);
+        }
+
+        AutoMutexLock l(&context->lock);
+        if (res != OLAP_SUCCESS) {
+            if (context->res == OLAP_SUCCESS) {
+                context->res = res;
+            }
+            break;
+        }
+        context->converted[i] = true;
+    }
+
+    SAFE_DELETE(sc_procedure);
+    return NULL;
+}
+
+SchemaChange* SchemaChangeHandler::_create_sc_procedure(SmartOLAPTable ref_olap_table,
+                                                        SmartOLAPTable new_olap_table,
+                                                        const RowBlockChanger& rb_changer,
+                                                        bool sc_sorting,
+                                                        bool sc_directly,
+                                                        int32_t num_threads) {
+    if (true == sc_sorting) {
+        size_t memory_limitation = config::memory_limiation_per_thread_for_schema_change;
+        memory_limitation = memory_limitation * 1024 * 1024 * 1024 / std::max(num_threads, 1);
+        OLAP_LOG_INFO("doing schema change with sorting. [memory_limitation=%lu]",
+                      memory_limitation);
+        return new(nothrow) SchemaChangeWithSorting(
+                                new_olap_table,
+                                rb_changer,
+                                memory_limitation);
+    } else if (true == sc_directly || ref_olap_table->data_file_type() == OLAP_DATA_FILE) {
+        OLAP_LOG_INFO("doing schema change directly.");
+        return new(nothrow) SchemaChangeDirectly(new_olap_table, rb_changer);
+    } else {
+        OLAP_LOG_INFO("doing linked schema change.");
+        return new(nothrow) LinkedSchemaChange(ref_olap_table, new_olap_table);
+    }
+}
+
+OLAPStatus SchemaChangeHandler::_convert_history_version(SchemaChangeParams* sc_params,
+                                                         SchemaChange* sc_procedure,
+                                                         IData* olap_data) {
+    OLAPStatus res = OLAP_SUCCESS;
+    OLAP_LOG_TRACE("begin to convert a history delta. [version='%d-%d']",
+                   olap_data->version().first, olap_data->version().second);
+
+    // we create a new delta with the same version as the IData processing currently.
+    OLAPIndex* new_olap_index = new(nothrow) OLAPIndex(
+                                        sc_params->new_olap_table.get(),
+                                        olap_data->version(),
+                                        olap_data->version_hash(),
+                                        olap_data->delete_flag(),
+                                        0,
+                                        olap_data->max_timestamp());
+
+    if (new_olap_index == NULL) {
+        OLAP_LOG_WARNING("failed to malloc OLAPIndex. [size=%ld]", sizeof(OLAPIndex));
+        return OLAP_ERR_MALLOC_ERROR;
+    }
+
+    olap_data->set_delete_handler(sc_params->delete_handler);
+    int del_ret = olap_data->delete_pruning_filter();
+    if (DEL_SATISFIED == del_ret) {
+        OLAP_LOG_DEBUG("filter delta in schema change: %d, %d",
+                       olap_data->version().first, olap_data->version().second);
+        res = sc_procedure->create_init_version(
+                                                new_olap_index->table()->tablet_id(),
+                                                new_olap_index->table()->schema_hash(),
+                                                new_olap_index->version(),
+                                                new_olap_index->version_hash(),
+                                                new_olap_index);
+        sc_procedure->add_filted_rows(olap_data->num_rows());
+        if (res != OLAP_SUCCESS) {
+            OLAP_LOG_WARNING("fail to create init version. [res=%d]", res);
+            new_olap_index->delete_all_files();
+            SAFE_DELETE(new_olap_index);
+            return OLAP_ERR_INPUT_PARAMETER_ERROR;
+        }
+    } else if (DEL_PARTIAL_SATISFIED == del_ret) {
+        OLAP_LOG_DEBUG("filter delta partially in schema change: %d, %d",
+                       olap_data->version().first, olap_data->version().second);
+        olap_data->set_delete_status(DEL_PARTIAL_SATISFIED);
+    } else {
+        OLAP_LOG_DEBUG("not filter delta in schema change: %d, %d",
+                       olap_data->version().first, olap_data->version().second);
+        olap_data->set_delete_status(DEL_NOT_SATISFIED);
+    }
+
+    if (DEL_SATISFIED != del_ret && !sc_procedure->process(olap_data, new_olap_index)) {
+        //if del_ret is DEL_SATISFIED, the new delta version has already been created in new_olap_table
+        OLAP_LOG_WARNING("failed to process the version. [version='%d-%d']",
+                         olap_data->version().first, olap_data->version().second);
+        new_olap_index->delete_all_files();
+        SAFE_DELETE(new_olap_index);
+        return OLAP_ERR_INPUT_PARAMETER_ERROR;
+    }
+
+    // 将新版本的数据加入header
+    // 为了防止死锁的出现，一定要先锁住旧表，再锁住新表
+    sc_params->new_olap_table->obtain_push_lock();
+    sc_params->ref_olap_table->obtain_header_wrlock();
+    sc_params->new_olap_table->obtain_header_wrlock();
+
+    if (!sc_params->new_olap_table->has_version(olap_data->version())) {
+        // register version
+        res = sc_params->new_olap_table->register_data_source(new_olap_index);
+        if (OLAP_SUCCESS != res) {
+            OLAP_LOG_WARNING("failed to register new version. [table='%s' version='%d-%d']",
+                             sc_params->new_olap_table->full_name().c_str(),
+                             olap_data->version().first,
+                             olap_data->version().second);
+            new_olap_index->delete_all_files();
+            SAFE_DELETE(new_olap_index);
+
+            sc_params->new_olap_table->release_header_lock();
+            sc_params->ref_olap_table->release_header_lock();
+            sc_params->new_olap_table->release_push_lock();
+            return res;
+        }
+
+        OLAP_LOG_DEBUG("register new version. [table='%s' version='%d-%d']",
+                       sc_params->new_olap_table->full_name().c_str(),
+                       olap_data->version().first,
+                       olap_data->version().second);
+    } else {
+        OLAP_LOG_WARNING("version already exist, version revert occured. "
+                         "[table='%s' version='%d-%d']",
+                         sc_params->new_olap_table->full_name().c_str(),
+                         olap_data->version().first, olap_data->version().second);
+        new_olap_index->delete_all_files();
+        SAFE_DELETE(new_olap_index);
+    }
+
+    // 保存header
+    if (OLAP_SUCCESS != sc_params->new_olap_table->save_header()) {
+        OLAP_LOG_FATAL("fail to save header. [res=%d table='%s']",
+                       res, sc_params->new_olap_table->full_name().c_str());
+    }
+
+    // XXX: 此处需要验证ref_olap_data_arr中最后一个版本是否与new_olap_table的header中记录的最
+    //      后一个版本相同。然后还要注意一致性问题。
+    if (!sc_params->ref_olap_table->remove_last_schema_change_version(
+                sc_params->new_olap_table)) {
+        OLAP_LOG_WARNING("failed to remove the last version did schema change.");
+
+        sc_params->new_olap_table->release_header_lock();
+        sc_params->ref_olap_table->release_header_lock();
+        sc_params->new_olap_table->release_push_lock();
+        return OLAP_ERR_INPUT_PARAMETER_ERROR;
+    }
+
+    // 保存header
+    if (OLAP_SUCCESS != sc_params->ref_olap_table->save_header()) {
+        OLAP_LOG_FATAL("failed to save header. [table='%s']",
+                       sc_params->new_olap_table->full_name().c_str());
+    }
+
+    sc_params->new_olap_table->release_header_lock();
+    sc_params->ref_olap_table->release_header_lock();
+    sc_params->new_olap_table->release_push_lock();
+
+    OLAP_LOG_TRACE("succeed to convert a history version. [version='%d-%d']",
+                   olap_data->version().first,
+                   olap_data->version().second);
+
+    // 释放IData
+    vector<IData*> olap_data_to_be_released(1, olap_data);
+    sc_params->ref_olap_table->release_data_sources(&olap_data_to_be_released);
+    return OLAP_SUCCESS;
+}
+
 // @static
 // 分析column的mapping以及filter key的mapping
 OLAPStatus SchemaChangeHandler::_parse_request(SmartOLAPTable ref_olap_table,
@@ -2236,25 +2535,28 @@ OLAPStatus SchemaChangeHandler::_parse_request(SmartOLAPTable ref_olap_table,
         if (column_mapping->ref_column < 0) {
             continue;
         } else {
-            if (new_table_schema[i].type != ref_table_schema[column_mapping->ref_column].type) {
-                *sc_directly = true;
-                return OLAP_SUCCESS;
-            } else if (
-                (new_table_schema[i].type == ref_table_schema[column_mapping->ref_column].type)
-                    && (new_table_schema[i].length 
-                        != ref_table_schema[column_mapping->ref_column].length)) {
+            const FieldInfo& new_column = new_table_schema[i];
+            const FieldInfo& ref_column = ref_table_schema[column_mapping->ref_column];
+            if (new_column.type != ref_column.type) {
                 *sc_directly = true;
                 return OLAP_SUCCESS;
-
-            } else if (new_table_schema[i].is_bf_column != ref_table_schema[i].is_bf_column) {
+            } else if (new_column.length != ref_column.length) {
+                // varchar按实际长度存储，加长不在short key中的varchar列不需要重写数据
+                if (new_column.type != OLAP_FIELD_TYPE_VARCHAR
+                        || new_column.length < ref_column.length
+                        || i < new_olap_table->num_short_key_fields()) {
+                    *sc_directly = true;
+                    return OLAP_SUCCESS;
+                }
+            } else if (new_column.is_bf_column != ref_column.is_bf_column) {
                 *sc_directly = true;
                 return OLAP_SUCCESS;
             }
         }
     }
 
-    if (ref_olap_table->delete_data_conditions_size() != 0){
-        //there exists delete condtion in header, can't do linked schema change
+    if (!_can_link_delete_conditions(ref_olap_table, new_olap_table)) {
+        //delete condition can't be applied to new table, can't do linked schema change
         *sc_directly = true;
     }
 
@@ -2266,6 +2568,80 @@ OLAPStatus SchemaChangeHandler::_parse_request(SmartOLAPTable ref_olap_table,
     return OLAP_SUCCESS;
 }
 
+bool SchemaChangeHandler::_can_link_delete_conditions(SmartOLAPTable ref_olap_table,
+                                                      SmartOLAPTable new_olap_table) {
+    const DeleteConditionHandler::del_cond_array& delete_conditions =
+            ref_olap_table->delete_data_conditions();
+    for (int i = 0; i < delete_conditions.size(); ++i) {
+        const DeleteDataConditionMessage& delete_condition = delete_conditions.Get(i);
+        for (int j = 0; j < delete_condition.sub_conditions_size(); ++j) {
+            TCondition condition;
+            if (!DeleteHandler::parse_condition(delete_condition.sub_conditions(j), &condition)) {
+                return false;
+            }
+
+            int32_t ref_index = ref_olap_table->get_field_index(condition.column_name);
+            int32_t new_index = new_olap_table->get_field_index(condition.column_name);
+            if (ref_index < 0 || new_index < 0) {
+                return false;
+            }
+            const FieldInfo& ref_column = ref_olap_table->tablet_schema()[ref_index];
+            const FieldInfo& new_column = new_olap_table->tablet_schema()[new_index];
+            if (!new_column.is_key
+                    || new_column.type != ref_column.type
+                    || new_column.length != ref_column.length) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+OLAPStatus SchemaChangeHandler::_copy_delete_conditions(SmartOLAPTable ref_olap_table,
+                                                        SmartOLAPTable new_olap_table,
+                                                        int32_t end_version) {
+    // 为了防止死锁的出现，一定要先锁住旧表，再锁住新表
+    ref_olap_table->obtain_header_rdlock();
+    new_olap_table->obtain_header_wrlock();
+
+    const DeleteConditionHandler::del_cond_array& delete_conditions =
+            ref_olap_table->delete_data_conditions();
+    for (int i = 0; i < delete_conditions.size(); ++i) {
+        const DeleteDataConditionMessage& delete_condition = delete_conditions.Get(i);
+        if (delete_condition.version() > end_version) {
+            // 转换期间导入的删除条件已经同时保存在新表中
+            continue;
+        }
+
+        bool existed = false;
+        for (int j = 0; j < new_olap_table->delete_data_conditions_size(); ++j) {
+            if (new_olap_table->delete_data_conditions().Get(j).version()
+                    == delete_condition.version()) {
+                existed = true;
+                break;
+            }
+        }
+        if (!existed) {
+            DeleteDataConditionMessage* new_condition =
+                    new_olap_table->add_delete_data_conditions();
+            new_condition->CopyFrom(delete_condition);
+            // 新表中的segment没有delete bitmap
+            new_condition->set_use_delete_bitmap(false);
+        }
+    }
+
+    OLAPStatus res = new_olap_table->save_header();
+    if (res != OLAP_SUCCESS) {
+        OLAP_LOG_WARNING("fail to save header. [res=%d table='%s']",
+                         res, new_olap_table->full_name().c_str());
+    }
+
+    new_olap_table->release_header_lock();
+    ref_olap_table->release_header_lock();
+    return res;
+}
+
 OLAPStatus SchemaChangeHandler::_init_column_mapping(ColumnMapping* column_mapping,
                                                      const FieldInfo& column_schema,
                                                      const std::string& value) {
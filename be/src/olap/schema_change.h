@@ -21,8 +21,10 @@
 #include <vector>
 
 #include "gen_cpp/AgentService_types.h"
+#include "olap/atomic.h"
 #include "olap/delete_handler.h"
 #include "olap/i_data.h"
+#include "olap/utils.h"
 
 namespace palo {
 // defined in 'field.h'
@@ -108,8 +110,14 @@ public:
                         DataFileType data_file_type, bool null_supported);
     void release(RowBlock* row_block);
 
+    size_t memory_size(size_t num_rows) const {
+        return _row_len * num_rows;
+    }
+
 private:
     const std::vector<FieldInfo>& _tablet_schema;
+    // 排序线程和写出线程共用一个allocator
+    MutexLock _lock;
     size_t _memory_allocated;
     size_t _row_len;
     size_t _memory_limitation;
@@ -145,7 +153,7 @@ private:
 
 class SchemaChange {
 public:
-    SchemaChange() : _filted_rows(0), _merged_rows(0) {}
+    SchemaChange() : _filted_rows(0), _merged_rows(0), _report_alter_progress(false) {}
     virtual ~SchemaChange() {}
 
     virtual bool process(IData* olap_data, OLAPIndex* new_olap_index) = 0;
@@ -174,6 +182,11 @@ public:
         _merged_rows = 0;
     }
 
+    // 转换历史版本时汇报进度，schema_version_convert转换的导入数据不计入进度
+    void enable_alter_progress() {
+        _report_alter_progress = true;
+    }
+
     OLAPStatus create_init_version(
             TTabletId tablet_id,
             TSchemaHash schema_hash,
@@ -181,9 +194,15 @@ public:
             VersionHash version_hash,
             OLAPIndex* olap_index);
 
+protected:
+    bool report_alter_progress() const {
+        return _report_alter_progress;
+    }
+
 private:
     uint64_t _filted_rows;
     uint64_t _merged_rows;
+    bool _report_alter_progress;
 };
 
 class LinkedSchemaChange : public SchemaChange {
@@ -236,10 +255,37 @@ public:
     virtual bool process(IData* olap_data, OLAPIndex* new_olap_index);
 
 private:
+    // 内存中排好序的一段数据，由后台线程归并后写成一个临时版本
+    struct SortedRun {
+        std::vector<RowBlock*> row_block_arr;
+        Version version;
+    };
+
+    static void* _sorting_thread_callback(void* arg);
+
+    void _start_sorting_threads();
+    // 等待后台线程写完所有数据段，abort为true时后台线程不再写出新的数据段
+    bool _join_sorting_threads(bool abort);
+
+    // 读取、转换并排序olap_data的数据，排好序的数据段交给后台线程写出
+    bool _sort_and_merge(IData* olap_data,
+                         RowBlock* ref_row_block,
+                         OLAPIndex* new_olap_index);
+
+    // 内存不足时等待后台线程写出数据段，没有正在写出的数据段时
+    // row_block返回NULL
+    bool _allocate_row_block(RowBlock** row_block,
+                             size_t num_rows,
+                             DataFileType data_file_type,
+                             bool null_supported);
+    bool _submit_sorted_run(std::vector<RowBlock*>* row_block_arr);
+    bool _write_sorted_run(SortedRun* run);
+    void _release_row_blocks(std::vector<RowBlock*>* row_block_arr);
+
     bool _internal_sorting(
             const std::vector<RowBlock*>& row_block_arr,
-            const Version& temp_delta_versions,
-            OLAPIndex** temp_olap_index);
+            OLAPIndex* olap_index,
+            uint64_t* merged_rows);
 
     bool _external_sorting(
             std::vector<OLAPIndex*>& src_olap_index_arr,
@@ -248,13 +294,25 @@ private:
     SmartOLAPTable _olap_table;
     const RowBlockChanger& _row_block_changer;
     size_t _memory_limitation;
-    Version _temp_delta_versions;
     RowBlockAllocator* _row_block_allocator;
 
+    MutexLock _lock;
+    Condition _cond;
+    std::vector<pthread_t> _sorting_threads;
+    std::deque<SortedRun*> _pending_runs;
+    // 后台线程正在写出的数据段个数
+    uint32_t _running_runs;
+    // 已经写出的临时版本
+    std::vector<OLAPIndex*> _temp_olap_indices;
+    bool _finished;
+    bool _failed;
+
     DISALLOW_COPY_AND_ASSIGN(SchemaChangeWithSorting);
 };
 
 class SchemaChangeHandler {
+    friend class TestSchemaChange_linked_schema_change_with_delete_conditions_Test;
+    friend class TestSchemaChange_parse_request_widen_varchar_Test;
 public:
     SchemaChangeHandler() {}
     virtual ~SchemaChangeHandler() {}
@@ -339,8 +397,48 @@ private:
                                         SmartOLAPTable new_olap_table,
                                         const std::vector<Version>& versions_to_be_changed);
 
+    // 多个线程并行转换历史版本时共享的状态
+    struct AlterTableContext {
+        SchemaChangeParams* sc_params;
+        const RowBlockChanger* rb_changer;
+        bool sc_sorting;
+        bool sc_directly;
+        // 转换线程数，排序使用的内存由这些线程平分
+        int32_t num_threads;
+        // 需要转换的历史版本，按版本从新到旧排列
+        std::vector<IData*> olap_data_arr;
+        // 已经转换并释放的历史版本
+        std::vector<bool> converted;
+        atomic_t next_data;
+        MutexLock lock;
+        OLAPStatus res;
+    };
+
     static OLAPStatus _alter_table(SchemaChangeParams* sc_params);
 
+    static void* _alter_table_thread_callback(void* arg);
+
+    static SchemaChange* _create_sc_procedure(SmartOLAPTable ref_olap_table,
+                                              SmartOLAPTable new_olap_table,
+                                              const RowBlockChanger& rb_changer,
+                                              bool sc_sorting,
+                                              bool sc_directly,
+                                              int32_t num_threads);
+
+    // 转换一个历史版本并注册到新表中，成功后释放olap_data
+    static OLAPStatus _convert_history_version(SchemaChangeParams* sc_params,
+                                               SchemaChange* sc_procedure,
+                                               IData* olap_data);
+
+    // linked schema change不会过滤被删除的数据，需要把删除条件复制到新表中
+    static OLAPStatus _copy_delete_conditions(SmartOLAPTable ref_olap_table,
+                                              SmartOLAPTable new_olap_table,
+                                              int32_t end_version);
+
+    // 删除条件中的列在新表中都是类型不变的key列时，才能使用linked schema change
+    static bool _can_link_delete_conditions(SmartOLAPTable ref_olap_table,
+                                            SmartOLAPTable new_olap_table);
+
     static OLAPStatus _parse_request(SmartOLAPTable ref_olap_table,
                                      SmartOLAPTable new_olap_table,
                                      RowBlockChanger* rb_changer,
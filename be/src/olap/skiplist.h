@@ -0,0 +1,167 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "runtime/mem_pool.h"
+
+namespace palo {
+
+// A simple skiplist whose nodes are allocated from a MemPool, nodes are
+// never deleted until the MemPool is freed.
+// It is NOT thread-safe, caller should synchronize accesses.
+//
+// Comparator should provide 'int operator()(const Key& a, const Key& b) const'
+// which returns negative, zero or positive value like memcmp.
+// Keys which are equal to each other are kept in insertion order.
+template<typename Key, class Comparator>
+class SkipList {
+private:
+    struct Node;
+
+public:
+    SkipList(Comparator cmp, MemPool* mem_pool);
+
+    // Insert key after all keys which are equal to it.
+    void insert(const Key& key);
+
+    // Return the first node whose key is equal to 'key', nullptr if not found.
+    // The returned key is mutable so that caller can update its content in
+    // place, but the compare result must not be changed.
+    Key* find(const Key& key);
+
+    size_t size() const { return _size; }
+
+    // Iteration over the contents of a skip list
+    class Iterator {
+    public:
+        explicit Iterator(const SkipList* list) : _list(list), _node(nullptr) { }
+
+        bool valid() const { return _node != nullptr; }
+        const Key& key() const { return _node->key; }
+        void next() { _node = _node->next[0]; }
+        void seek_to_first() { _node = _list->_head->next[0]; }
+
+    private:
+        const SkipList* _list;
+        Node* _node;
+    };
+
+private:
+    static const int MAX_HEIGHT = 12;
+
+    struct Node {
+        Key key;
+        // array of length equal to the node height, next[0] is the lowest level link
+        Node* next[1];
+    };
+
+    Node* _new_node(const Key& key, int height);
+    int _random_height();
+
+    Comparator _compare;
+    MemPool* _pool;
+    Node* _head;
+    int _max_height;
+    size_t _size;
+    uint32_t _rnd;
+};
+
+template<typename Key, class Comparator>
+SkipList<Key, Comparator>::SkipList(Comparator cmp, MemPool* mem_pool)
+        : _compare(cmp), _pool(mem_pool), _head(nullptr),
+        _max_height(1), _size(0), _rnd(0xdeadbeef) {
+    _head = _new_node(Key(), MAX_HEIGHT);
+    for (int i = 0; i < MAX_HEIGHT; ++i) {
+        _head->next[i] = nullptr;
+    }
+}
+
+template<typename Key, class Comparator>
+typename SkipList<Key, Comparator>::Node*
+SkipList<Key, Comparator>::_new_node(const Key& key, int height) {
+    uint8_t* mem = _pool->allocate(sizeof(Node) + sizeof(Node*) * (height - 1));
+    Node* node = reinterpret_cast<Node*>(mem);
+    node->key = key;
+    return node;
+}
+
+template<typename Key, class Comparator>
+int SkipList<Key, Comparator>::_random_height() {
+    // Increase height with probability 1 in 4
+    int height = 1;
+    while (height < MAX_HEIGHT) {
+        // simple linear congruential generator
+        _rnd = _rnd * 1103515245 + 12345;
+        if (((_rnd >> 16) & 3) != 0) {
+            break;
+        }
+        height++;
+    }
+    return height;
+}
+
+template<typename Key, class Comparator>
+void SkipList<Key, Comparator>::insert(const Key& key) {
+    // find the last node at each level whose key is not greater than 'key'
+    Node* prev[MAX_HEIGHT];
+    Node* x = _head;
+    for (int level = _max_height - 1; level >= 0; --level) {
+        Node* next = x->next[level];
+        while (next != nullptr && _compare(next->key, key) <= 0) {
+            x = next;
+            next = x->next[level];
+        }
+        prev[level] = x;
+    }
+
+    int height = _random_height();
+    if (height > _max_height) {
+        for (int i = _max_height; i < height; ++i) {
+            prev[i] = _head;
+        }
+        _max_height = height;
+    }
+
+    Node* node = _new_node(key, height);
+    for (int i = 0; i < height; ++i) {
+        node->next[i] = prev[i]->next[i];
+        prev[i]->next[i] = node;
+    }
+    _size++;
+}
+
+template<typename Key, class Comparator>
+Key* SkipList<Key, Comparator>::find(const Key& key) {
+    // find the first node whose key is not less than 'key'
+    Node* x = _head;
+    Node* next = nullptr;
+    for (int level = _max_height - 1; level >= 0; --level) {
+        next = x->next[level];
+        while (next != nullptr && _compare(next->key, key) < 0) {
+            x = next;
+            next = x->next[level];
+        }
+    }
+    if (next != nullptr && _compare(next->key, key) == 0) {
+        return &next->key;
+    }
+    return nullptr;
+}
+
+}
@@ -1184,6 +1184,22 @@ void Condition::wait_for_seconds(uint32_t seconds) {
     }
 }
 
+void Condition::wait_for_microseconds(uint64_t microseconds) {
+    struct timeval now;
+    struct timespec outtime = {0, 0};
+    gettimeofday(&now, NULL);
+    uint64_t usec = now.tv_usec + microseconds;
+    outtime.tv_sec = now.tv_sec + usec / 1000000;
+    outtime.tv_nsec = (usec % 1000000) * 1000;
+    int cond_ret = 0;
+    cond_ret = pthread_cond_timedwait(&_cond, _mutex.getlock(), &outtime);
+    if (0 != cond_ret && ETIMEDOUT != cond_ret) {
+        OLAP_LOG_FATAL("fail to timewait cond. "
+                       "[cond_ret=%d err='%m' outtime.tv_sec=%d outtime.tv_nsec=%ld]",
+                       cond_ret, outtime.tv_sec, outtime.tv_nsec); 
+    }
+}
+
 void Condition::notify() {
     PTHREAD_COND_SIGNAL_WITH_LOG(&_cond);
 }
@@ -1512,12 +1528,13 @@ OLAPStatus remove_unused_files(const string& schema_hash_root,
     different_set.erase(header);
     // 遍历所有没有使用的文件
     for (set<string>::const_iterator it = different_set.begin(); it != different_set.end(); ++it) {
-        if (ENDSWITH(*it, ".hdr") || ENDSWITH(*it, ".idx") || ENDSWITH(*it, ".dat")) {
+        if (ENDSWITH(*it, ".hdr") || ENDSWITH(*it, ".idx") || ENDSWITH(*it, ".dat")
+                || ENDSWITH(*it, ".del")) {
             OLAP_LOG_INFO("delete unused file. [file='%s']", it->c_str());
             move_to_trash(boost::filesystem::path(schema_hash_root),
                           boost::filesystem::path(schema_hash_root + "/" + *it));
         } else {
-            // 除了.hdr, .idx, .dat其他文件均忽略
+            // 除了.hdr, .idx, .dat, .del其他文件均忽略
             continue;
         }
     }
@@ -246,6 +246,8 @@ public:
 
     void wait_for_seconds(uint32_t seconds);
 
+    void wait_for_microseconds(uint64_t microseconds);
+
     void notify();
 
     void notify_all();
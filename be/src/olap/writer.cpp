@@ -116,14 +116,6 @@ OLAPStatus OLAPDataWriter::init(uint32_t num_rows_per_row_block) {
         return res;
     }
 
-    if (_is_push_write) {
-        _write_mbytes_per_sec = config::push_write_mbytes_per_sec;
-    } else {
-        _write_mbytes_per_sec = config::base_compaction_write_mbytes_per_sec;
-    }
-    
-    _speed_limit_watch.reset();
-
     return OLAP_SUCCESS;
 }
 
@@ -216,17 +208,6 @@ OLAPStatus OLAPDataWriter::write_row_block(RowBlock* row_block) {
     _current_segment_size = end_offset;
     _num_rows += row_block->row_block_info().row_num;
 
-    if (_write_mbytes_per_sec > 0) {
-        uint64_t delta_time_us = _speed_limit_watch.get_elapse_time_us();
-        int64_t sleep_time =
-                _current_segment_size / _write_mbytes_per_sec - delta_time_us;
-        if (sleep_time > 0) {
-            OLAP_LOG_DEBUG("sleep to limit merge speed. [time=%lu bytes=%lu]",
-                    sleep_time, _current_segment_size);
-            usleep(sleep_time);
-        }
-    }
-    
     // In order to reuse row_block, clear the row_block after finalize
     row_block->clear();
 
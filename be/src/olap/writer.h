@@ -78,6 +78,11 @@ public:
 
         ++_row_index;
     }
+    // Whether row block being written is full. If it is, the block will be
+    // flushed when attaching next row, and rows attached before are invalid.
+    bool is_block_full() const {
+        return _row_index >= _table->num_rows_per_row_block();
+    }
     virtual OLAPStatus finalize() = 0;
     virtual OLAPStatus write_row_block(RowBlock* row_block) = 0;
     virtual uint64_t written_bytes() = 0;
@@ -161,10 +166,7 @@ private:
     RowBlock* _row_block;
     int64_t _num_rows;
 
-    // write limit
     bool _is_push_write;
-    uint32_t _write_mbytes_per_sec;
-    OlapStopWatch _speed_limit_watch;
 
     DISALLOW_COPY_AND_ASSIGN(OLAPDataWriter);
 };
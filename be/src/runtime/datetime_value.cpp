@@ -61,6 +61,40 @@ static uint32_t calc_days_in_year(uint32_t year) {
     return is_leap(year) ? 366 : 365;
 }
 
+// Calendar of year 0 to 9999, so that conversions between day number and date
+// are table lookups instead of loops.
+static const uint32_t CALENDAR_MAX_YEAR = 9999;
+// day number of January 1st of each year, one more year for the end of last year
+static uint32_t s_year_first_daynr[CALENDAR_MAX_YEAR + 2];
+// days before each month in normal and leap year, indexed by [leap][month]
+static uint32_t s_days_before_month[2][13];
+// month of each day in normal and leap year, indexed by [leap][day of year - 1]
+static uint8_t s_month_of_day[2][366];
+
+static bool init_calendar() {
+    for (int leap = 0; leap < 2; ++leap) {
+        uint32_t days = 0;
+        for (int month = 1; month <= 12; ++month) {
+            s_days_before_month[leap][month] = days;
+            uint32_t days_in_month = s_days_in_month[month] + (leap && month == 2);
+            for (uint32_t i = 0; i < days_in_month; ++i) {
+                s_month_of_day[leap][days + i] = month;
+            }
+            days += days_in_month;
+        }
+    }
+    // same as calc_daynr(year, 1, 1), year 0 is not leap
+    s_year_first_daynr[0] = 1;
+    for (uint32_t year = 0; year <= CALENDAR_MAX_YEAR; ++year) {
+        s_year_first_daynr[year + 1] = s_year_first_daynr[year] + calc_days_in_year(year);
+    }
+    return true;
+}
+
+// tables are not used before they are initialized, in case of static initialization
+// of other files
+static bool s_calendar_inited = init_calendar();
+
 DateTimeValue DateTimeValue::_s_min_datetime_value(0, TIME_DATETIME, 0, 0, 0, 0, 0, 1, 1);
 DateTimeValue DateTimeValue::_s_max_datetime_value(0, TIME_DATETIME, 23, 59, 59, 0, 
                                                    9999, 12, 31);
@@ -500,6 +534,22 @@ bool DateTimeValue::get_date_from_daynr(uint64_t daynr) {
     if (daynr <= 0 || daynr > DATE_MAX_DAYNR) {
         return false;
     }
+    if (s_calendar_inited) {
+        // 146097 days every 400 years, so estimated year is at most one year off
+        uint32_t year = daynr * 400 / 146097;
+        while (year > 0 && daynr < s_year_first_daynr[year]) {
+            year--;
+        }
+        while (year < CALENDAR_MAX_YEAR && daynr >= s_year_first_daynr[year + 1]) {
+            year++;
+        }
+        uint32_t day_of_year = daynr - s_year_first_daynr[year];
+        int leap = is_leap(year);
+        _year = year;
+        _month = s_month_of_day[leap][day_of_year];
+        _day = day_of_year - s_days_before_month[leap][_month] + 1;
+        return true;
+    }
     _year = daynr / 365;
     uint32_t days_befor_year = 0;
     while (daynr < (days_befor_year = calc_daynr(_year, 1, 1))) {
@@ -545,6 +595,9 @@ uint64_t DateTimeValue::calc_daynr(uint32_t year, uint32_t month, uint32_t day)
     if (year == 0 && month == 0) {
         return 0;
     }
+    if (s_calendar_inited && year <= CALENDAR_MAX_YEAR && month >= 1 && month <= 12) {
+        return s_year_first_daynr[year] + s_days_before_month[is_leap(year)][month] + day - 1;
+    }
 
     /* Cast to int to be able to handle month == 0 */
     delsum = 365 * y + 31 * (month - 1) + day;
@@ -670,11 +723,8 @@ int DateTimeValue::compute_format_len(const char* format, int len) const {
 }
 
 bool DateTimeValue::to_format_string(const char* format, int len, char* to) const {
-    char buf[64];
-    char* pos = NULL;
     const char* ptr = format;
     const char* end = format + len;
-    char ch = '\0';
 
     while (ptr < end) {
         if (*ptr != '%' || (ptr + 1) == end) {
@@ -683,241 +733,251 @@ bool DateTimeValue::to_format_string(const char* format, int len, char* to) cons
         }
         // Skip '%'
         ptr++;
-        switch (ch = *ptr++) {
-        case 'a':
-            // Abbreviated weekday name
-            if (_type == TIME_TIME || (_year == 0 && _month == 0)) {
-                return false;
-            }
-            to = append_string(s_ab_day_name[weekday()], to);
-            break;
-        case 'b':
-            // Abbreviated month name
-            if (_month == 0) {
-                return false;
-            }
-            to = append_string(s_ab_month_name[_month], to);
-            break;
-        case 'c':
-            // Month, numeric (0...12)
-            pos = int_to_str(_month, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 1, to);
-            break;
-        case 'd':
-            // Day of month (00...31)
-            pos = int_to_str(_day, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'D':
-            // Day of the month with English suffix (0th, 1st, ...)
-            pos = int_to_str(_day, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 1, to);
-            if (_day >= 10 && _day <= 19) {
+        to = append_format_spec(*ptr++, to);
+        if (to == NULL) {
+            return false;
+        }
+    }
+    *to++ = '\0';
+    return true;
+}
+
+char* DateTimeValue::append_format_spec(char spec, char* to) const {
+    char buf[64];
+    char* pos = NULL;
+    switch (spec) {
+    case 'a':
+        // Abbreviated weekday name
+        if (_type == TIME_TIME || (_year == 0 && _month == 0)) {
+            return NULL;
+        }
+        to = append_string(s_ab_day_name[weekday()], to);
+        break;
+    case 'b':
+        // Abbreviated month name
+        if (_month == 0) {
+            return NULL;
+        }
+        to = append_string(s_ab_month_name[_month], to);
+        break;
+    case 'c':
+        // Month, numeric (0...12)
+        pos = int_to_str(_month, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 1, to);
+        break;
+    case 'd':
+        // Day of month (00...31)
+        pos = int_to_str(_day, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'D':
+        // Day of the month with English suffix (0th, 1st, ...)
+        pos = int_to_str(_day, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 1, to);
+        if (_day >= 10 && _day <= 19) {
+            to = append_string("th", to);
+        } else {
+            switch (_day % 10) {
+            case 1:
+                to = append_string("st", to);
+                break;
+            case 2:
+                to = append_string("nd", to);
+                break;
+            case 3:
+                to = append_string("rd", to);
+                break;
+            default:
                 to = append_string("th", to);
-            } else {
-                switch (_day % 10) {
-                case 1:
-                    to = append_string("st", to);
-                    break;
-                case 2:
-                    to = append_string("nd", to);
-                    break;
-                case 3:
-                    to = append_string("rd", to);
-                    break;
-                default:
-                    to = append_string("th", to);
-                    break;
-                }
-            }
-            break;
-        case 'e':
-            // Day of the month, numeric (0..31)
-            pos = int_to_str(_day, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 1, to);
-            break;
-        case 'f':
-            // Microseconds (000000..999999)
-            pos = int_to_str(_microsecond, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 6, to);
-            break;
-        case 'h':
-        case 'I':
-            // Hour (01..12)
-            pos = int_to_str((_hour % 24 + 11) % 12 + 1, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'H':
-            // Hour (00..23)
-            pos = int_to_str(_hour, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'i':
-            // Minutes, numeric (00..59)
-            pos = int_to_str(_minute, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'j':
-            // Day of year (001..366)
-            pos = int_to_str(daynr() - calc_daynr(_year, 1, 1) + 1, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 3, to);
-            break;
-        case 'k':
-            // Hour (0..23)
-            pos = int_to_str(_hour, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 1, to);
-            break;
-        case 'l':
-            // Hour (1..12)
-            pos = int_to_str((_hour % 24 + 11) % 12 + 1, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 1, to);
-            break;
-        case 'm':
-            // Month, numeric (00..12)
-            pos = int_to_str(_month, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'M':
-            // Month name (January..December)
-            if (_month == 0) {
-                return false;
-            }
-            to = append_string(s_month_name[_month], to);
-            break;
-        case 'p':
-            // AM or PM
-            if ((_hour % 24) >= 12) {
-                to = append_string("PM", to);
-            } else {
-                to = append_string("AM", to);
-            }
-            break;
-        case 'r':
-            // Time, 12-hour (hh:mm:ss followed by AM or PM)
-            *to++ = (char) ('0' + (((_hour + 11) % 12 + 1) / 10));
-            *to++ = (char) ('0' + (((_hour + 11) % 12 + 1) % 10));
-            *to++ = ':';
-            // Minute
-            *to++ = (char) ('0' + (_minute / 10));
-            *to++ = (char) ('0' + (_minute % 10));
-            *to++ = ':';
-            /* Second */
-            *to++ = (char) ('0' + (_second / 10));
-            *to++ = (char) ('0' + (_second % 10));
-            if ((_hour % 24) >= 12) {
-                to = append_string(" PM", to);
-            } else {
-                to = append_string(" AM", to);
-            }
-            break;
-        case 's':
-        case 'S':
-            // Seconds (00..59)
-            pos = int_to_str(_second, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'T':
-            // Time, 24-hour (hh:mm:ss)
-            *to++ = (char) ('0' + ((_hour % 24) / 10));
-            *to++ = (char) ('0' + ((_hour % 24) % 10));
-            *to++ = ':';
-            // Minute
-            *to++ = (char) ('0' + (_minute / 10));
-            *to++ = (char) ('0' + (_minute % 10));
-            *to++ = ':';
-            /* Second */
-            *to++ = (char) ('0' + (_second / 10));
-            *to++ = (char) ('0' + (_second % 10));
-            break;
-        case 'u':
-            // Week (00..53), where Monday is the first day of the week;
-            // WEEK() mode 1
-            if (_type == TIME_TIME) {
-                return false;
-            }
-            pos = int_to_str(week(mysql_week_mode(1)), buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'U':
-            // Week (00..53), where Sunday is the first day of the week;
-            // WEEK() mode 0
-            if (_type == TIME_TIME) {
-                return false;
-            }
-            pos = int_to_str(week(mysql_week_mode(0)), buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'v':
-            // Week (01..53), where Monday is the first day of the week;
-            // WEEK() mode 3; used with %x
-            if (_type == TIME_TIME) {
-                return false;
-            }
-            pos = int_to_str(week(mysql_week_mode(3)), buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'V':
-            // Week (01..53), where Sunday is the first day of the week;
-            // WEEK() mode 2; used with %X
-            if (_type == TIME_TIME) {
-                return false;
-            }
-            pos = int_to_str(week(mysql_week_mode(2)), buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'w':
-            // Day of the week (0=Sunday..6=Saturday)
-            if (_type == TIME_TIME || (_month == 0 && _year == 0)) {
-                return false;
-            }
-            pos = int_to_str(calc_weekday(daynr(), true), buf);
-            to = append_with_prefix(buf, pos - buf, '0', 1, to);
-            break;
-        case 'W':
-            // Weekday name (Sunday..Saturday)
-            to = append_string(s_day_name[weekday()], to);
-            break;
-        case 'x': {
-            // Year for the week, where Monday is the first day of the week,
-            // numeric, four digits; used with %v
-            if (_type == TIME_TIME) {
-                return false;
+                break;
             }
-            uint32_t year = 0;
-            calc_week(*this, mysql_week_mode(3), &year);
-            pos = int_to_str(year, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 4, to);
-            break;
         }
-        case 'X': {
-            // Year for the week where Sunday is the first day of the week,
-            // numeric, four digits; used with %V
-            if (_type == TIME_TIME) {
-                return false;
-            }
-            uint32_t year = 0;
-            calc_week(*this, mysql_week_mode(2), &year);
-            pos = int_to_str(year, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 4, to);
-            break;
+        break;
+    case 'e':
+        // Day of the month, numeric (0..31)
+        pos = int_to_str(_day, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 1, to);
+        break;
+    case 'f':
+        // Microseconds (000000..999999)
+        pos = int_to_str(_microsecond, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 6, to);
+        break;
+    case 'h':
+    case 'I':
+        // Hour (01..12)
+        pos = int_to_str((_hour % 24 + 11) % 12 + 1, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'H':
+        // Hour (00..23)
+        pos = int_to_str(_hour, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'i':
+        // Minutes, numeric (00..59)
+        pos = int_to_str(_minute, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'j':
+        // Day of year (001..366)
+        pos = int_to_str(daynr() - calc_daynr(_year, 1, 1) + 1, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 3, to);
+        break;
+    case 'k':
+        // Hour (0..23)
+        pos = int_to_str(_hour, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 1, to);
+        break;
+    case 'l':
+        // Hour (1..12)
+        pos = int_to_str((_hour % 24 + 11) % 12 + 1, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 1, to);
+        break;
+    case 'm':
+        // Month, numeric (00..12)
+        pos = int_to_str(_month, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'M':
+        // Month name (January..December)
+        if (_month == 0) {
+            return NULL;
         }
-        case 'y':
-            // Year, numeric (two digits)
-            pos = int_to_str(_year % 100, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 2, to);
-            break;
-        case 'Y':
-            // Year, numeric, four digits
-            pos = int_to_str(_year, buf);
-            to = append_with_prefix(buf, pos - buf, '0', 4, to);
-            break;
-        default:
-            *to++ = ch;
-            break;
+        to = append_string(s_month_name[_month], to);
+        break;
+    case 'p':
+        // AM or PM
+        if ((_hour % 24) >= 12) {
+            to = append_string("PM", to);
+        } else {
+            to = append_string("AM", to);
+        }
+        break;
+    case 'r':
+        // Time, 12-hour (hh:mm:ss followed by AM or PM)
+        *to++ = (char) ('0' + (((_hour + 11) % 12 + 1) / 10));
+        *to++ = (char) ('0' + (((_hour + 11) % 12 + 1) % 10));
+        *to++ = ':';
+        // Minute
+        *to++ = (char) ('0' + (_minute / 10));
+        *to++ = (char) ('0' + (_minute % 10));
+        *to++ = ':';
+        /* Second */
+        *to++ = (char) ('0' + (_second / 10));
+        *to++ = (char) ('0' + (_second % 10));
+        if ((_hour % 24) >= 12) {
+            to = append_string(" PM", to);
+        } else {
+            to = append_string(" AM", to);
+        }
+        break;
+    case 's':
+    case 'S':
+        // Seconds (00..59)
+        pos = int_to_str(_second, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'T':
+        // Time, 24-hour (hh:mm:ss)
+        *to++ = (char) ('0' + ((_hour % 24) / 10));
+        *to++ = (char) ('0' + ((_hour % 24) % 10));
+        *to++ = ':';
+        // Minute
+        *to++ = (char) ('0' + (_minute / 10));
+        *to++ = (char) ('0' + (_minute % 10));
+        *to++ = ':';
+        /* Second */
+        *to++ = (char) ('0' + (_second / 10));
+        *to++ = (char) ('0' + (_second % 10));
+        break;
+    case 'u':
+        // Week (00..53), where Monday is the first day of the week;
+        // WEEK() mode 1
+        if (_type == TIME_TIME) {
+            return NULL;
         }
+        pos = int_to_str(week(mysql_week_mode(1)), buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'U':
+        // Week (00..53), where Sunday is the first day of the week;
+        // WEEK() mode 0
+        if (_type == TIME_TIME) {
+            return NULL;
+        }
+        pos = int_to_str(week(mysql_week_mode(0)), buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'v':
+        // Week (01..53), where Monday is the first day of the week;
+        // WEEK() mode 3; used with %x
+        if (_type == TIME_TIME) {
+            return NULL;
+        }
+        pos = int_to_str(week(mysql_week_mode(3)), buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'V':
+        // Week (01..53), where Sunday is the first day of the week;
+        // WEEK() mode 2; used with %X
+        if (_type == TIME_TIME) {
+            return NULL;
+        }
+        pos = int_to_str(week(mysql_week_mode(2)), buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'w':
+        // Day of the week (0=Sunday..6=Saturday)
+        if (_type == TIME_TIME || (_month == 0 && _year == 0)) {
+            return NULL;
+        }
+        pos = int_to_str(calc_weekday(daynr(), true), buf);
+        to = append_with_prefix(buf, pos - buf, '0', 1, to);
+        break;
+    case 'W':
+        // Weekday name (Sunday..Saturday)
+        to = append_string(s_day_name[weekday()], to);
+        break;
+    case 'x': {
+        // Year for the week, where Monday is the first day of the week,
+        // numeric, four digits; used with %v
+        if (_type == TIME_TIME) {
+            return NULL;
+        }
+        uint32_t year = 0;
+        calc_week(*this, mysql_week_mode(3), &year);
+        pos = int_to_str(year, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 4, to);
+        break;
     }
-    *to++ = '\0';
-    return true;
+    case 'X': {
+        // Year for the week where Sunday is the first day of the week,
+        // numeric, four digits; used with %V
+        if (_type == TIME_TIME) {
+            return NULL;
+        }
+        uint32_t year = 0;
+        calc_week(*this, mysql_week_mode(2), &year);
+        pos = int_to_str(year, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 4, to);
+        break;
+    }
+    case 'y':
+        // Year, numeric (two digits)
+        pos = int_to_str(_year % 100, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 2, to);
+        break;
+    case 'Y':
+        // Year, numeric, four digits
+        pos = int_to_str(_year, buf);
+        to = append_with_prefix(buf, pos - buf, '0', 4, to);
+        break;
+    default:
+        *to++ = spec;
+        break;
+    }
+    return to;
 }
 
 uint8_t DateTimeValue::calc_week(const DateTimeValue& value, uint8_t mode, uint32_t *year) {
@@ -1591,6 +1651,79 @@ std::ostream& operator<<(std::ostream& os, const DateTimeValue& value) {
 
 // NOTE: 
 //  only support DATE - DATE (no support DATETIME - DATETIME)
+// Max length of value of format specifier
+static int max_format_spec_length(char spec) {
+    switch (spec) {
+    case 'a':
+    case 'b':
+        return 3;
+    case 'M':
+    case 'W':
+        // September, Wednesday
+        return 9;
+    case 'p':
+        return 2;
+    case 'r':
+        return 11;
+    case 'T':
+        return 8;
+    case 'D':
+        return 20 + 2;
+    default:
+        // All numbers are less than 20 digits
+        return 20;
+    }
+}
+
+bool CompiledDateFormat::compile(const char* format, int len) {
+    // date_format() returns NULL for format string of this length
+    if (DateTimeValue().compute_format_len(format, len) >= 128) {
+        return false;
+    }
+    static const char* s_format_specs = "abcdDefhHiIjklmMprsSTuUvVwWxXyY";
+
+    _items.clear();
+    _literals.clear();
+    _max_length = 0;
+    const char* ptr = format;
+    const char* end = format + len;
+    while (ptr < end) {
+        char literal = *ptr++;
+        if (literal == '%' && ptr < end) {
+            char spec = *ptr++;
+            if (strchr(s_format_specs, spec) != NULL) {
+                _items.push_back({spec, 0, 0});
+                _max_length += max_format_spec_length(spec);
+                continue;
+            }
+            // Unknown specifier is the character itself, such as "%%"
+            literal = spec;
+        }
+        if (_items.empty() || _items.back().spec != 0) {
+            _items.push_back({0, (int)_literals.size(), 0});
+        }
+        _literals.push_back(literal);
+        _items.back().len++;
+        _max_length++;
+    }
+    return true;
+}
+
+char* CompiledDateFormat::format(const DateTimeValue& value, char* to) const {
+    for (const Item& item : _items) {
+        if (item.spec == 0) {
+            memcpy(to, _literals.data() + item.offset, item.len);
+            to += item.len;
+            continue;
+        }
+        to = value.append_format_spec(item.spec, to);
+        if (to == NULL) {
+            return NULL;
+        }
+    }
+    return to;
+}
+
 std::size_t operator-(const DateTimeValue& v1, const DateTimeValue& v2) {
     return v1.daynr() - v2.daynr();
 }
@@ -20,6 +20,8 @@
 
 #include <iostream>
 #include <cstddef>
+#include <string>
+#include <vector>
 
 #include "udf/udf.h"
 #include "util/hash_util.hpp"
@@ -236,6 +238,11 @@ public:
     bool to_format_string(const char* format, int len, char* to) const;
     int compute_format_len(const char* format, int len) const;
 
+    // Append value of one format specifier (the character after '%') to 'to'.
+    // Return end of appended string, NULL if this value can't be formatted
+    // by the specifier.
+    char* append_format_spec(char spec, char* to) const;
+
     // Convert this value to uint64_t
     // Will check its type
     int64_t to_int64() const;
@@ -398,6 +405,21 @@ public:
         tv->type = _type;
     }
 
+    // Get fields from packed time of DateTimeVal directly, which is the same
+    // as from_datetime_val(tv).year() etc. but doesn't decode other fields.
+    static int year_of_packed(int64_t packed_time) {
+        uint16_t year = (packed_time >> 46) / 13;
+        return year % 10000;
+    }
+    static int month_of_packed(int64_t packed_time) {
+        uint8_t month = (packed_time >> 46) % 13;
+        return month;
+    }
+    static int day_of_packed(int64_t packed_time) {
+        uint8_t day = (packed_time >> 41) % (1 << 5);
+        return day;
+    }
+
     static DateTimeValue from_datetime_val(const palo_udf::DateTimeVal& tv) {
         DateTimeValue value;
         value.from_packed_time(tv.packed_time);
@@ -536,6 +558,39 @@ private:
     static DateTimeValue _s_max_datetime_value;
 };
 
+// Format string of date_format() which is parsed once, so that values are
+// formatted without parsing format string and computing length of result
+// again, used when format string is constant.
+class CompiledDateFormat {
+public:
+    CompiledDateFormat() : _max_length(0) { }
+
+    // Return false if format string is too long for date_format()
+    bool compile(const char* format, int len);
+
+    // Max length of formatted string
+    int max_length() const {
+        return _max_length;
+    }
+
+    // Write formatted value to 'to', which has at least max_length() bytes.
+    // Return end of formatted string, NULL if value can't be formatted,
+    // the same as to_format_string().
+    char* format(const DateTimeValue& value, char* to) const;
+
+private:
+    // Literal string in _literals if spec is 0
+    struct Item {
+        char spec;
+        int offset;
+        int len;
+    };
+
+    std::vector<Item> _items;
+    std::string _literals;
+    int _max_length;
+};
+
 // only support DATE - DATE (no support DATETIME - DATETIME)
 std::size_t operator-(const DateTimeValue& v1, const DateTimeValue& v2);
 
@@ -0,0 +1,279 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/decimalv2_value.h"
+
+#include <cctype>
+#include <cmath>
+
+#include <limits>
+
+namespace palo {
+
+const char* DecimalV2Value::_s_llvm_class_name = "class.palo::DecimalV2Value";
+
+const __int128 DecimalV2Value::MAX_VALUE =
+    static_cast<__int128>(999999999999999999LL) * 1000000000000000000LL + 999999999999999999LL;
+
+static const __int128 MAX_INT_VALUE = DecimalV2Value::MAX_VALUE / DecimalV2Value::ONE_BILLION;
+
+static inline __int128 abs_value(__int128 x) {
+    return x < 0 ? -x : x;
+}
+
+int DecimalV2Value::mul(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                        DecimalV2Value* result) {
+    __int128 x = v1._value;
+    __int128 y = v2._value;
+    if (x == 0 || y == 0) {
+        result->_value = 0;
+        return E_DEC_OK;
+    }
+    bool negative = (x < 0) != (y < 0);
+    x = abs_value(x);
+    y = abs_value(y);
+    // x * y / 10^9 = (x / 10^9) * y + (x % 10^9) * y / 10^9, the second
+    // term doesn't overflow since y is at most 10^36
+    __int128 x_int = x / ONE_BILLION;
+    __int128 x_frac = x % ONE_BILLION;
+    __int128 product = 0;
+    if (x_int != 0 && (y > MAX_VALUE / x_int)) {
+        result->_value = negative ? -MAX_VALUE : MAX_VALUE;
+        return E_DEC_OVERFLOW;
+    }
+    product = x_int * y;
+    __int128 frac_product = 0;
+    if (y < MAX_VALUE / ONE_BILLION) {
+        frac_product = x_frac * y / ONE_BILLION;
+    } else {
+        frac_product = x_frac * (y / ONE_BILLION) + x_frac * (y % ONE_BILLION) / ONE_BILLION;
+    }
+    product += frac_product;
+    return result->set_checked(negative ? -product : product);
+}
+
+int DecimalV2Value::div(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                        DecimalV2Value* result) {
+    if (v2._value == 0) {
+        result->_value = 0;
+        return E_DEC_DIV_ZERO;
+    }
+    bool negative = (v1._value < 0) != (v2._value < 0);
+    __int128 x = abs_value(v1._value);
+    __int128 y = abs_value(v2._value);
+    // x * 10^9 / y, integer part first so that nothing overflows
+    __int128 quotient = x / y;
+    __int128 remainder = x % y;
+    if (quotient > MAX_INT_VALUE) {
+        result->_value = negative ? -MAX_VALUE : MAX_VALUE;
+        return E_DEC_OVERFLOW;
+    }
+    quotient *= ONE_BILLION;
+    if (remainder <= MAX_VALUE / ONE_BILLION) {
+        quotient += remainder * ONE_BILLION / y;
+    } else {
+        // one digit each time, remainder * 10 is less than 10^37
+        __int128 frac = 0;
+        for (int i = 0; i < SCALE; ++i) {
+            remainder *= 10;
+            frac = frac * 10 + remainder / y;
+            remainder %= y;
+        }
+        quotient += frac;
+    }
+    return result->set_checked(negative ? -quotient : quotient);
+}
+
+int DecimalV2Value::mod(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                        DecimalV2Value* result) {
+    if (v2._value == 0) {
+        result->_value = 0;
+        return E_DEC_DIV_ZERO;
+    }
+    // both are scaled by 10^9, so is the remainder
+    result->_value = v1._value % v2._value;
+    return E_DEC_OK;
+}
+
+DecimalV2Value DecimalV2Value::from_decimal_value(const DecimalValue& value) {
+    __int128 int_part = value;
+    DecimalV2Value result;
+    if (abs_value(int_part) > MAX_INT_VALUE) {
+        result._value = int_part < 0 ? -MAX_VALUE : MAX_VALUE;
+        return result;
+    }
+    result._value = int_part * ONE_BILLION + value.frac_value();
+    return result;
+}
+
+DecimalValue DecimalV2Value::to_decimal_value() const {
+    __int128 int_part = int_value();
+    if (int_part >= std::numeric_limits<int64_t>::min()
+            && int_part <= std::numeric_limits<int64_t>::max()) {
+        return DecimalValue(static_cast<int64_t>(int_part), frac_value());
+    }
+    return DecimalValue(to_string());
+}
+
+DecimalV2Value& DecimalV2Value::assign_from_double(double double_value) {
+    if (std::isnan(double_value)) {
+        _value = 0;
+        return *this;
+    }
+    double max_value = static_cast<double>(MAX_VALUE);
+    double scaled = double_value * ONE_BILLION;
+    if (scaled >= max_value) {
+        _value = MAX_VALUE;
+    } else if (scaled <= -max_value) {
+        _value = -MAX_VALUE;
+    } else {
+        // round half away from zero, e.g. 0.3 is 0.29999999999999998
+        _value = static_cast<__int128>(scaled + (scaled < 0 ? -0.5 : 0.5));
+    }
+    return *this;
+}
+
+int DecimalV2Value::to_buffer(char* buffer, int scale) const {
+    if (scale > SCALE) {
+        scale = SCALE;
+    }
+    __int128 int_part = abs_value(int_value());
+    int32_t frac_part = std::abs(frac_value());
+
+    char* pos = buffer;
+    // no sign if printed digits are all zero, e.g. -0.05 with scale 1
+    int32_t printed_frac = frac_part;
+    for (int i = scale; i < SCALE; ++i) {
+        printed_frac /= 10;
+    }
+    if (_value < 0 && (int_part != 0 || printed_frac != 0)) {
+        *pos++ = '-';
+    }
+
+    // integer digits in reverse order
+    char digits[MAX_INT_DIGITS + 1];
+    int num_digits = 0;
+    do {
+        digits[num_digits++] = '0' + static_cast<int>(int_part % 10);
+        int_part /= 10;
+    } while (int_part != 0);
+    while (num_digits > 0) {
+        *pos++ = digits[--num_digits];
+    }
+
+    if (scale > 0) {
+        *pos++ = '.';
+        int32_t divisor = ONE_BILLION / 10;
+        for (int i = 0; i < scale; ++i) {
+            *pos++ = '0' + frac_part / divisor;
+            frac_part %= divisor;
+            divisor /= 10;
+        }
+    }
+    return pos - buffer;
+}
+
+std::string DecimalV2Value::to_string(int scale) const {
+    char buffer[MAX_STR_LENGTH];
+    int length = to_buffer(buffer, scale);
+    std::string result(buffer, length);
+    // DECIMAL(p, s) with s more than 9 is printed with zeros
+    if (scale > SCALE) {
+        result.append(scale - SCALE, '0');
+    }
+    return result;
+}
+
+std::string DecimalV2Value::to_string() const {
+    int32_t frac_part = std::abs(frac_value());
+    int scale = SCALE;
+    while (scale > 0 && frac_part % 10 == 0) {
+        frac_part /= 10;
+        --scale;
+    }
+    return to_string(scale);
+}
+
+int DecimalV2Value::parse_from_str(const char* decimal_str, int32_t length) {
+    _value = 0;
+    const char* begin = decimal_str;
+    const char* end = decimal_str + length;
+
+    // ignore leading spaces
+    while (begin < end && std::isspace(*begin)) {
+        ++begin;
+    }
+
+    bool negative = false;
+    if (begin < end && (*begin == '-' || *begin == '+')) {
+        negative = (*begin == '-');
+        ++begin;
+    }
+
+    int error = E_DEC_OK;
+    int num_digits = 0;
+    __int128 int_part = 0;
+    for (; begin < end && std::isdigit(*begin); ++begin) {
+        ++num_digits;
+        if (int_part > MAX_INT_VALUE) {
+            continue;
+        }
+        int_part = int_part * 10 + (*begin - '0');
+    }
+    if (int_part > MAX_INT_VALUE) {
+        _value = negative ? -MAX_VALUE : MAX_VALUE;
+        return E_DEC_OVERFLOW;
+    }
+
+    int64_t frac_part = 0;
+    int frac_digits = 0;
+    if (begin < end && *begin == '.') {
+        for (++begin; begin < end && std::isdigit(*begin); ++begin) {
+            ++num_digits;
+            if (frac_digits == SCALE) {
+                if (*begin != '0') {
+                    error = E_DEC_TRUNCATED;
+                }
+                continue;
+            }
+            frac_part = frac_part * 10 + (*begin - '0');
+            ++frac_digits;
+        }
+    }
+
+    // bad num like "  a"
+    if (num_digits == 0) {
+        return E_DEC_BAD_NUM;
+    }
+    for (; frac_digits < SCALE; ++frac_digits) {
+        frac_part *= 10;
+    }
+
+    _value = int_part * ONE_BILLION + frac_part;
+    if (negative) {
+        _value = -_value;
+    }
+    return error;
+}
+
+std::ostream& operator<<(std::ostream& os, const DecimalV2Value& value) {
+    return os << value.to_string();
+}
+
+std::size_t hash_value(const DecimalV2Value& value) {
+    return value.hash(0);
+}
+
+}
@@ -0,0 +1,271 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <string>
+
+#include "runtime/decimal_value.h"
+#include "udf/udf.h"
+#include "util/hash_util.hpp"
+
+namespace palo {
+
+// DecimalV2Value is a fixed-point decimal of at most 27 integer digits and
+// 9 fraction digits, stored as an __int128 scaled by 10^9. It's the same
+// format as DECIMAL columns in storage (decimal12_t), and arithmetic is done
+// on the integer directly instead of arrays of digits like DecimalValue.
+//
+// Fraction digits beyond 9 are truncated. Results out of range are set to
+// the max or min value, and the checked functions return E_DEC_OVERFLOW.
+class DecimalV2Value {
+public:
+    static const int32_t PRECISION = 36;
+    static const int32_t SCALE = 9;
+    static const int32_t MAX_INT_DIGITS = PRECISION - SCALE;
+    static const int64_t ONE_BILLION = 1000000000;
+    // 10^36 - 1
+    static const __int128 MAX_VALUE;
+
+    DecimalV2Value() : _value(0) { }
+
+    DecimalV2Value(int64_t int_value, int64_t frac_value) {
+        _value = static_cast<__int128>(int_value) * ONE_BILLION + frac_value;
+    }
+
+    explicit DecimalV2Value(int64_t int_value) {
+        _value = static_cast<__int128>(int_value) * ONE_BILLION;
+    }
+
+    explicit DecimalV2Value(const std::string& decimal_str) : _value(0) {
+        parse_from_str(decimal_str.c_str(), decimal_str.size());
+    }
+
+    // Value is 'value' / 10^9
+    static DecimalV2Value from_raw(__int128 value) {
+        DecimalV2Value result;
+        result._value = value;
+        return result;
+    }
+
+    // From decimal12_t of storage, whose parts have the same sign
+    static DecimalV2Value from_olap_decimal(int64_t integer, int32_t fraction) {
+        return DecimalV2Value(integer, fraction);
+    }
+
+    static DecimalV2Value from_decimal_val(const palo_udf::DecimalV2Val& val) {
+        return from_raw(val.val);
+    }
+
+    void to_decimal_val(palo_udf::DecimalV2Val* value) const {
+        value->val = _value;
+    }
+
+    // Fraction digits of 'value' beyond 9 are truncated
+    static DecimalV2Value from_decimal_value(const DecimalValue& value);
+    DecimalValue to_decimal_value() const;
+
+    static DecimalV2Value get_max_decimal() {
+        return from_raw(MAX_VALUE);
+    }
+
+    static DecimalV2Value get_min_decimal() {
+        return from_raw(-MAX_VALUE);
+    }
+
+    __int128 value() const {
+        return _value;
+    }
+
+    // Integer part, which may not fit int64_t if it's more than 18 digits
+    __int128 int_value() const {
+        return _value / ONE_BILLION;
+    }
+
+    // Fraction part in 10^-9, with the same sign as value
+    int32_t frac_value() const {
+        return static_cast<int32_t>(_value % ONE_BILLION);
+    }
+
+    bool is_zero() const {
+        return _value == 0;
+    }
+
+    operator int64_t() const {
+        return static_cast<int64_t>(int_value());
+    }
+
+    operator __int128() const {
+        return int_value();
+    }
+
+    operator bool() const {
+        return _value != 0;
+    }
+
+    operator double() const {
+        return static_cast<double>(_value) / ONE_BILLION;
+    }
+
+    DecimalV2Value& assign_from_float(float float_value) {
+        return assign_from_double(float_value);
+    }
+
+    DecimalV2Value& assign_from_double(double double_value);
+
+    // Checked arithmetic, return E_DEC_OK, E_DEC_OVERFLOW or E_DEC_DIV_ZERO.
+    // On overflow 'result' is set to the max or min value, on division by
+    // zero it's set to zero.
+    static int add(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                   DecimalV2Value* result) {
+        // no overflow of __int128, both are at most 10^36
+        return result->set_checked(v1._value + v2._value);
+    }
+
+    static int sub(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                   DecimalV2Value* result) {
+        return result->set_checked(v1._value - v2._value);
+    }
+
+    static int mul(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                   DecimalV2Value* result);
+    static int div(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                   DecimalV2Value* result);
+    static int mod(const DecimalV2Value& v1, const DecimalV2Value& v2,
+                   DecimalV2Value* result);
+
+    DecimalV2Value& operator+=(const DecimalV2Value& other) {
+        add(*this, other, this);
+        return *this;
+    }
+
+    bool operator==(const DecimalV2Value& other) const {
+        return _value == other._value;
+    }
+
+    bool operator!=(const DecimalV2Value& other) const {
+        return _value != other._value;
+    }
+
+    bool operator<(const DecimalV2Value& other) const {
+        return _value < other._value;
+    }
+
+    bool operator<=(const DecimalV2Value& other) const {
+        return _value <= other._value;
+    }
+
+    bool operator>(const DecimalV2Value& other) const {
+        return _value > other._value;
+    }
+
+    bool operator>=(const DecimalV2Value& other) const {
+        return _value >= other._value;
+    }
+
+    // Print with 'scale' fraction digits, which are truncated if it's less
+    // than 9.
+    std::string to_string(int scale) const;
+
+    // Print without trailing zeros of fraction
+    std::string to_string() const;
+
+    // Write string to 'buffer' of at least MAX_STR_LENGTH bytes, without
+    // terminating '\0', return length of string
+    int to_buffer(char* buffer, int scale) const;
+
+    // Return E_DEC_OK, E_DEC_TRUNCATED if fraction digits beyond 9 are
+    // dropped, E_DEC_OVERFLOW if integer part is too long, or E_DEC_BAD_NUM
+    int parse_from_str(const char* decimal_str, int32_t length);
+
+    uint32_t hash(uint32_t seed) const {
+        return HashUtil::hash(&_value, sizeof(_value), seed);
+    }
+
+    // sign, digits and point
+    static const int32_t MAX_STR_LENGTH = PRECISION + 2;
+
+    // For C++/IR interop, we need to be able to look up types by name.
+    static const char* _s_llvm_class_name;
+
+private:
+    int set_checked(__int128 value) {
+        if (value > MAX_VALUE) {
+            _value = MAX_VALUE;
+            return E_DEC_OVERFLOW;
+        }
+        if (value < -MAX_VALUE) {
+            _value = -MAX_VALUE;
+            return E_DEC_OVERFLOW;
+        }
+        _value = value;
+        return E_DEC_OK;
+    }
+
+    __int128 _value;
+};
+
+inline DecimalV2Value operator+(const DecimalV2Value& v1, const DecimalV2Value& v2) {
+    DecimalV2Value result;
+    DecimalV2Value::add(v1, v2, &result);
+    return result;
+}
+
+inline DecimalV2Value operator-(const DecimalV2Value& v1, const DecimalV2Value& v2) {
+    DecimalV2Value result;
+    DecimalV2Value::sub(v1, v2, &result);
+    return result;
+}
+
+inline DecimalV2Value operator*(const DecimalV2Value& v1, const DecimalV2Value& v2) {
+    DecimalV2Value result;
+    DecimalV2Value::mul(v1, v2, &result);
+    return result;
+}
+
+inline DecimalV2Value operator/(const DecimalV2Value& v1, const DecimalV2Value& v2) {
+    DecimalV2Value result;
+    DecimalV2Value::div(v1, v2, &result);
+    return result;
+}
+
+inline DecimalV2Value operator%(const DecimalV2Value& v1, const DecimalV2Value& v2) {
+    DecimalV2Value result;
+    DecimalV2Value::mod(v1, v2, &result);
+    return result;
+}
+
+inline DecimalV2Value operator-(const DecimalV2Value& v) {
+    return DecimalV2Value::from_raw(-v.value());
+}
+
+std::ostream& operator<<(std::ostream& os, const DecimalV2Value& value);
+
+std::size_t hash_value(const DecimalV2Value& value);
+
+}
+
+namespace std {
+template<>
+struct hash<palo::DecimalV2Value> {
+    size_t operator()(const palo::DecimalV2Value& v) const {
+        return palo::hash_value(v);
+    }
+};
+}
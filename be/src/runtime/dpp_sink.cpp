@@ -465,6 +465,22 @@ Status Translator::create_value_updaters() {
             }
             break;
         }
+        case TYPE_DECIMALV2: {
+            switch (_rollup_schema.value_ops()[i]) {
+            case TAggregationType::MAX:
+                _value_updaters.push_back(update_max<DecimalV2Value>);
+                break;
+            case TAggregationType::MIN:
+                _value_updaters.push_back(update_min<DecimalV2Value>);
+                break;
+            case TAggregationType::SUM:
+                _value_updaters.push_back(update_sum<DecimalV2Value>);
+                break;
+            default:
+                _value_updaters.push_back(fake_update);
+            }
+            break;
+        }
         case TYPE_DATE:
         case TYPE_DATETIME: {
             switch (_rollup_schema.value_ops()[i]) {
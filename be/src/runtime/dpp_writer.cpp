@@ -25,6 +25,7 @@
 #include "runtime/primitive_type.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "util/types.h"
 
 namespace palo {
 
@@ -213,6 +214,16 @@ Status DppWriter::append_one_row(TupleRow* row) {
             append_to_buf(&frac_val, sizeof(frac_val));
             break;
         }
+        case TYPE_DECIMALV2: {
+            // the same format as DECIMAL in storage
+            DecimalV2Value decimal_val = DecimalV2Value::from_raw(
+                reinterpret_cast<const PackedInt128*>(item)->value);
+            int64_t int_val = static_cast<int64_t>(decimal_val.int_value());
+            int32_t frac_val = decimal_val.frac_value();
+            append_to_buf(&int_val, sizeof(int_val));
+            append_to_buf(&frac_val, sizeof(frac_val));
+            break;
+        }
         default: {
             std::stringstream ss;
             ss << "Unknown column type " << _output_expr_ctxs[i]->root()->type();
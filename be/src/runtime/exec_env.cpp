@@ -52,6 +52,7 @@
 #include "http/action/snapshot_action.h"
 #include "http/action/pprof_actions.h"
 #include "http/action/metrics_action.h"
+#include "http/action/tablet_load_progress_action.h"
 #include "http/download_action.h"
 #include "http/monitor_action.h"
 #include "http/http_method.h"
@@ -258,6 +259,11 @@ Status ExecEnv::start_webserver() {
     // Register BE snapshot action
     SnapshotAction* snapshot_action = new SnapshotAction(this);
     _webserver->register_handler(HttpMethod::GET, "/api/snapshot", snapshot_action);
+
+    // Register BE tablet load progress action
+    TabletLoadProgressAction* tablet_load_progress_action = new TabletLoadProgressAction(this);
+    _webserver->register_handler(
+            HttpMethod::GET, "/api/tablet_load_progress", tablet_load_progress_action);
 #endif
 
     RETURN_IF_ERROR(_webserver->start());
@@ -181,6 +181,20 @@ Status ExportSink::gen_row_buffer(TupleRow* row, std::stringstream* ss) {
             (*ss) << decimal_str;
             break;
         }
+        case TYPE_DECIMALV2: {
+            DecimalV2Value decimal_val = DecimalV2Value::from_raw(
+                reinterpret_cast<const PackedInt128*>(item)->value);
+            std::string decimal_str;
+            int output_scale = _output_expr_ctxs[i]->root()->output_scale();
+
+            if (output_scale > 0 && output_scale <= 30) {
+                decimal_str = decimal_val.to_string(output_scale);
+            } else {
+                decimal_str = decimal_val.to_string();
+            }
+            (*ss) << decimal_str;
+            break;
+        }
         default: {
             std::stringstream err_ss;
             err_ss << "can't export this type. type = " << _output_expr_ctxs[i]->root()->type();
@@ -19,6 +19,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
 #include "exprs/expr.h"
+#include "util/types.h"
 
 namespace palo {
 
@@ -147,6 +148,20 @@ Status MysqlTableWriter::insert_row(TupleRow* row) {
             ss << decimal_str;
             break;
         }
+        case TYPE_DECIMALV2: {
+            DecimalV2Value decimal_val = DecimalV2Value::from_raw(
+                reinterpret_cast<const PackedInt128*>(item)->value);
+            std::string decimal_str;
+            int output_scale = _output_expr_ctxs[i]->root()->output_scale();
+
+            if (output_scale > 0 && output_scale <= 30) {
+                decimal_str = decimal_val.to_string(output_scale);
+            } else {
+                decimal_str = decimal_val.to_string();
+            }
+            ss << decimal_str;
+            break;
+        }
         default: {
             std::stringstream err_ss;
             err_ss << "can't convert this type to mysql type. type = " <<
@@ -80,6 +80,9 @@ PrimitiveType thrift_to_type(TPrimitiveType::type ttype) {
     case TPrimitiveType::DECIMAL:
         return TYPE_DECIMAL;
 
+    case TPrimitiveType::DECIMALV2:
+        return TYPE_DECIMALV2;
+
     case TPrimitiveType::CHAR:
         return TYPE_CHAR;
             
@@ -138,6 +141,9 @@ TPrimitiveType::type to_thrift(PrimitiveType ptype) {
     case TYPE_DECIMAL:
         return TPrimitiveType::DECIMAL;
 
+    case TYPE_DECIMALV2:
+        return TPrimitiveType::DECIMALV2;
+
     case TYPE_CHAR:
         return TPrimitiveType::CHAR;
 
@@ -196,6 +202,9 @@ std::string type_to_string(PrimitiveType t) {
     case TYPE_DECIMAL:
         return "DECIMAL";
 
+    case TYPE_DECIMALV2:
+        return "DECIMALV2";
+
     case TYPE_CHAR:
         return "CHAR";
     case TYPE_HLL:
@@ -254,6 +263,7 @@ std::string type_to_odbc_string(PrimitiveType t) {
         return "binary";
 
     case TYPE_DECIMAL:
+    case TYPE_DECIMALV2:
         return "decimal";
 
     case TYPE_CHAR:
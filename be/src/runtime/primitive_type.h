@@ -27,6 +27,7 @@
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/Opcodes_types.h"
 #include "runtime/decimal_value.h"
+#include "runtime/decimalv2_value.h"
 #include "runtime/datetime_value.h"
 #include "runtime/large_int_value.h"
 #include "runtime/string_value.h"
@@ -54,7 +55,8 @@ enum PrimitiveType {
     TYPE_STRUCT, /* 16 */
     TYPE_ARRAY, /* 17 */
     TYPE_MAP, /* 18 */
-    TYPE_HLL /* 19 */
+    TYPE_HLL, /* 19 */
+    TYPE_DECIMALV2 /* 20 */
 };
 
 inline bool is_enumeration_type(PrimitiveType type) {
@@ -66,6 +68,7 @@ inline bool is_enumeration_type(PrimitiveType type) {
     case TYPE_VARCHAR:
     case TYPE_DATETIME:
     case TYPE_DECIMAL:
+    case TYPE_DECIMALV2:
     case TYPE_BOOLEAN:
     case TYPE_HLL:
         return false;
@@ -120,6 +123,7 @@ inline int get_byte_size(PrimitiveType type) {
     case TYPE_LARGEINT:
     case TYPE_DATETIME:
     case TYPE_DATE:
+    case TYPE_DECIMALV2:
         return 16;
 
     case TYPE_DECIMAL:
@@ -163,6 +167,7 @@ inline int get_real_byte_size(PrimitiveType type) {
         return 40;
 
     case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
         return 16;
 
     case INVALID_TYPE:
@@ -207,6 +212,9 @@ inline int get_slot_size(PrimitiveType type) {
     case TYPE_DECIMAL:
         return sizeof(DecimalValue);
 
+    case TYPE_DECIMALV2:
+        return sizeof(DecimalV2Value);
+
     case INVALID_TYPE:
     default:
         DCHECK(false);
@@ -88,6 +88,7 @@ void RawValue::print_value_as_bytes(const void* value, const TypeDescriptor& typ
         break;
 
     case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
         stream->write(chars, sizeof(__int128));
         break;
 
@@ -168,6 +169,11 @@ void RawValue::print_value(const void* value, const TypeDescriptor& type, int sc
         *stream << reinterpret_cast<const PackedInt128*>(value)->value;
         break;
 
+    case TYPE_DECIMALV2:
+        *stream << DecimalV2Value::from_raw(
+            reinterpret_cast<const PackedInt128*>(value)->value);
+        break;
+
     default:
         DCHECK(false) << "bad RawValue::print_value() type: " << type;
     }
@@ -247,7 +253,8 @@ void RawValue::write(const void* value, void* dst, const TypeDescriptor& type, M
         break;
     }
 
-    case TYPE_LARGEINT: {
+    case TYPE_LARGEINT:
+    case TYPE_DECIMALV2: {
         *reinterpret_cast<PackedInt128*>(dst) = *reinterpret_cast<const PackedInt128*>(value);
         break;
     }
@@ -315,6 +322,7 @@ void RawValue::write(const void* value, const TypeDescriptor& type, void* dst, u
             *reinterpret_cast<int64_t*>(dst) = *reinterpret_cast<const int64_t*>(value);
             break;
         case TYPE_LARGEINT:
+        case TYPE_DECIMALV2:
             *reinterpret_cast<PackedInt128*>(dst) = *reinterpret_cast<const PackedInt128*>(value);
             break;
         case TYPE_FLOAT:
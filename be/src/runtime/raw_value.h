@@ -171,6 +171,7 @@ inline bool RawValue::lt(const void* v1, const void* v2, const TypeDescriptor& t
                *reinterpret_cast<const DecimalValue*>(v2);
 
     case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
         return reinterpret_cast<const PackedInt128*>(v1)->value <
                reinterpret_cast<const PackedInt128*>(v2)->value;
 
@@ -229,6 +230,7 @@ inline bool RawValue::eq(const void* v1, const void* v2, const TypeDescriptor& t
                *reinterpret_cast<const DecimalValue*>(v2);
 
     case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
         return reinterpret_cast<const PackedInt128*>(v1)->value ==
                reinterpret_cast<const PackedInt128*>(v2)->value;
 
@@ -289,6 +291,7 @@ inline uint32_t RawValue::get_hash_value(
         return HashUtil::hash(v, 40, seed);
 
     case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
         return HashUtil::hash(v, 16, seed);
 
     default:
@@ -344,6 +347,7 @@ inline uint32_t RawValue::get_hash_value_fvn(
         return ((DecimalValue *) v)->hash(seed);
 
     case TYPE_LARGEINT:
+    case TYPE_DECIMALV2:
         return HashUtil::fnv_hash(v, 16, seed);
 
     default:
@@ -409,6 +413,15 @@ inline uint32_t RawValue::zlib_crc32(const void* v, const TypeDescriptor& type,
         seed = HashUtil::zlib_crc_hash(&int_val, sizeof(int_val), seed);
         return HashUtil::zlib_crc_hash(&frac_val, sizeof(frac_val), seed);
     }
+    case TYPE_DECIMALV2: {
+        // the same as DECIMAL, so that rows are distributed as in storage
+        DecimalV2Value dec_val = DecimalV2Value::from_raw(
+            reinterpret_cast<const PackedInt128*>(v)->value);
+        int64_t int_val = dec_val.int_value();
+        int32_t frac_val = dec_val.frac_value();
+        seed = HashUtil::zlib_crc_hash(&int_val, sizeof(int_val), seed);
+        return HashUtil::zlib_crc_hash(&frac_val, sizeof(frac_val), seed);
+    }
     default:
         DCHECK(false) << "invalid type: " << type;
         return 0;
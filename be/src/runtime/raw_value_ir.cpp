@@ -102,7 +102,8 @@ int RawValue::compare(const void* v1, const void* v2, const TypeDescriptor& type
         return (*decimal_value1 > *decimal_value2)
                 ? 1 : (*decimal_value1 < *decimal_value2 ? -1 : 0);
 
-    case TYPE_LARGEINT: {
+    case TYPE_LARGEINT:
+    case TYPE_DECIMALV2: {
         __int128 large_int_value1 = reinterpret_cast<const PackedInt128*>(v1)->value;
         __int128 large_int_value2 = reinterpret_cast<const PackedInt128*>(v2)->value;
         return large_int_value1 > large_int_value2 ? 1 : 
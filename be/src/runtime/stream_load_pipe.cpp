@@ -0,0 +1,110 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load_pipe.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+namespace palo {
+
+StreamLoadPipe::StreamLoadPipe(size_t max_buffered_bytes, size_t min_chunk_size) :
+        _read_offset(0),
+        _buffered_bytes(0),
+        _max_buffered_bytes(max_buffered_bytes),
+        _min_chunk_size(min_chunk_size),
+        _finished(false),
+        _cancelled(false) {
+}
+
+StreamLoadPipe::~StreamLoadPipe() {
+}
+
+Status StreamLoadPipe::append(const char* data, size_t size) {
+    std::unique_lock<std::mutex> l(_lock);
+    while (!_cancelled && _buffered_bytes + size > _max_buffered_bytes
+           && _buffered_bytes > 0) {
+        _put_cond.wait(l);
+    }
+    if (_cancelled) {
+        return Status::CANCELLED;
+    }
+    if (_finished) {
+        return Status("Append data to a finished stream load pipe.");
+    }
+    if (size == 0) {
+        return Status::OK;
+    }
+    // Merge small appends to avoid too many chunks, the first chunk may be
+    // reading by reader, so only merge into a chunk which is not the first.
+    if (_chunks.size() > 1 && _chunks.back().size() < _min_chunk_size) {
+        _chunks.back().append(data, size);
+    } else {
+        _chunks.emplace_back(data, size);
+    }
+    _buffered_bytes += size;
+    _get_cond.notify_one();
+    return Status::OK;
+}
+
+Status StreamLoadPipe::finish() {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _finished = true;
+    }
+    _get_cond.notify_all();
+    return Status::OK;
+}
+
+void StreamLoadPipe::cancel() {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _cancelled = true;
+    }
+    _get_cond.notify_all();
+    _put_cond.notify_all();
+}
+
+Status StreamLoadPipe::read(uint8_t* data, size_t* data_size, bool* eof) {
+    size_t bytes_read = 0;
+    std::unique_lock<std::mutex> l(_lock);
+    while (!_cancelled && !_finished && _chunks.empty()) {
+        _get_cond.wait(l);
+    }
+    if (_cancelled) {
+        return Status::CANCELLED;
+    }
+    // Read as much as possible, data is only waited for once so that
+    // reader can process what it has got.
+    while (bytes_read < *data_size && !_chunks.empty()) {
+        const std::string& chunk = _chunks.front();
+        size_t copy_size = std::min(*data_size - bytes_read, chunk.size() - _read_offset);
+        memcpy(data + bytes_read, chunk.data() + _read_offset, copy_size);
+        bytes_read += copy_size;
+        _read_offset += copy_size;
+        if (_read_offset == chunk.size()) {
+            _chunks.pop_front();
+            _read_offset = 0;
+        }
+    }
+    _buffered_bytes -= bytes_read;
+    *data_size = bytes_read;
+    *eof = (bytes_read == 0 && _finished);
+    _put_cond.notify_one();
+    return Status::OK;
+}
+
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "exec/file_reader.h"
+
+namespace palo {
+
+// StreamLoadPipe is used to pass the body of a stream load http request
+// to the scanner which is executing the load plan.
+// http thread appends data into this pipe, and scanner read data from
+// it as a file. Writer will be blocked when there are too much data
+// buffered, and reader will be blocked when there is no data buffered.
+class StreamLoadPipe : public FileReader {
+public:
+    StreamLoadPipe(size_t max_buffered_bytes = 1024 * 1024,
+                   size_t min_chunk_size = 64 * 1024);
+    virtual ~StreamLoadPipe();
+
+    // Append 'size' bytes to this pipe, this will block until there is
+    // enough room for this data or this pipe is cancelled.
+    Status append(const char* data, size_t size);
+
+    // Called by writer when all data has been appended.
+    Status finish();
+
+    // Cancel this pipe, both writer and reader will get an error.
+    void cancel();
+
+    virtual Status read(uint8_t* data, size_t* data_size, bool* eof) override;
+
+    // Reader is gone, writer should not append data anymore.
+    virtual void close() override {
+        cancel();
+    }
+
+private:
+    std::mutex _lock;
+    // Signalled when some data is appended or pipe is finished
+    std::condition_variable _get_cond;
+    // Signalled when some data is consumed
+    std::condition_variable _put_cond;
+
+    std::deque<std::string> _chunks;
+    // read offset in the first chunk
+    size_t _read_offset;
+    size_t _buffered_bytes;
+
+    size_t _max_buffered_bytes;
+    // small appends are merged until chunk reach this size
+    size_t _min_chunk_size;
+
+    bool _finished;
+    bool _cancelled;
+};
+
+}
@@ -27,13 +27,17 @@
 
 #include "common/logging.h"
 #include "runtime/string_value.h"
+#include "util/cpu_info.h"
+#ifdef __SSE4_2__
+#include "util/sse_util.hpp"
+#endif
 
 namespace palo {
 
-// TODO: This can be sped up with SIDD_CMP_EQUAL_ORDERED or at the very least rewritten
-// from published algorithms.
+// Patterns up to 16 bytes are searched with SSE4.2 SIDD_CMP_EQUAL_ORDERED if it's
+// supported, 16 bytes at a time.
 //
-// This is taken from the python search string function doing string search (substring)
+// Otherwise this is taken from the python search string function doing string search (substring)
 // using an optimized boyer-moore-horspool algorithm.
 // http://hg.python.org/cpython/file/6b6c79eba944/Objects/stringlib/fastsearch.h
 //
@@ -98,6 +102,12 @@ public:
             return;
         }
 
+        // copy to a full register, so that loading it doesn't read out of pattern
+        if (_pattern->len <= SSE_PATTERN_BYTES) {
+            memset(_sse_pattern, 0, sizeof(_sse_pattern));
+            memcpy(_sse_pattern, _pattern->ptr, _pattern->len);
+        }
+
         // Build compressed lookup table
         int mlast = _pattern->len - 1;
         _skip = mlast - 1;
@@ -140,6 +150,14 @@ public:
             return -1;
         }
 
+#ifdef __SSE4_2__
+        if (m <= sse_util::CHARS_PER_128_BIT_REGISTER
+                && n >= sse_util::CHARS_PER_128_BIT_REGISTER
+                && CpuInfo::is_supported(CpuInfo::SSE4_2)) {
+            return sse_search(s, n);
+        }
+#endif
+
         // General case.
         int j;
         // TODO: the original code seems to have an off by one error. It is possible
@@ -177,6 +195,41 @@ public:
 
 private:
     static const int BLOOM_WIDTH = 64;
+    static const int SSE_PATTERN_BYTES = 16;
+
+#ifdef __SSE4_2__
+    static const int SEARCH_MODE = _SIDD_CMP_EQUAL_ORDERED | _SIDD_UBYTE_OPS;
+
+    // Search pattern of at most 16 bytes in s of at least 16 bytes. Only bytes
+    // in s are loaded, the last 16 bytes are searched at last if there is less
+    // than 16 bytes left.
+    int sse_search(const char* s, int n) const {
+        const int width = sse_util::CHARS_PER_128_BIT_REGISTER;
+        int m = _pattern->len;
+        __m128i pattern = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_sse_pattern));
+        int i = 0;
+        while (i + width <= n) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            int index = _mm_cmpestri(pattern, m, chunk, width, SEARCH_MODE);
+            if (index == width) {
+                i += width;
+            } else if (index + m <= width) {
+                return i + index;
+            } else {
+                // prefix of pattern at the end of chunk, search from there
+                i += index;
+            }
+        }
+        if (i < n) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + n - width));
+            int index = _mm_cmpestri(pattern, m, chunk, width, SEARCH_MODE);
+            if (index + m <= width) {
+                return n - width + index;
+            }
+        }
+        return -1;
+    }
+#endif
 
     void bloom_add(char c) {
         _mask |= (1UL << (c & (BLOOM_WIDTH - 1)));
@@ -189,6 +242,7 @@ private:
     const StringValue* _pattern;
     int64_t _mask;
     int64_t _skip;
+    char _sse_pattern[SSE_PATTERN_BYTES];
 };
 
 }
@@ -43,7 +43,7 @@ TypeDescriptor::TypeDescriptor(const std::vector<TTypeNode>& types, int* idx) :
         if (type == TYPE_CHAR || type == TYPE_VARCHAR || type == TYPE_HLL) {
             DCHECK(scalar_type.__isset.len);
             len = scalar_type.len;
-        } else if (type == TYPE_DECIMAL) {
+        } else if (type == TYPE_DECIMAL || type == TYPE_DECIMALV2) {
             DCHECK(scalar_type.__isset.precision);
             DCHECK(scalar_type.__isset.scale);
             precision = scalar_type.precision;
@@ -110,7 +110,7 @@ void TypeDescriptor::to_thrift(TTypeDesc* thrift_type) const {
         if (type == TYPE_CHAR || type == TYPE_VARCHAR || type == TYPE_HLL) {
             // DCHECK_NE(len, -1);
             scalar_type.__set_len(len);
-        } else if (type == TYPE_DECIMAL) {
+        } else if (type == TYPE_DECIMAL || type == TYPE_DECIMALV2) {
             DCHECK_NE(precision, -1);
             DCHECK_NE(scale, -1);
             scalar_type.__set_precision(precision);
@@ -128,6 +128,9 @@ std::string TypeDescriptor::debug_string() const {
     case TYPE_DECIMAL:
         ss << "DECIMAL(" << precision << ", " << scale << ")";
         return ss.str();
+    case TYPE_DECIMALV2:
+        ss << "DECIMALV2(" << precision << ", " << scale << ")";
+        return ss.str();
     default:
         return type_to_string(type);
     }
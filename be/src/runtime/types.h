@@ -49,7 +49,7 @@ struct TypeDescriptor {
     static const int MAX_CHAR_LENGTH = 255;
     static const int MAX_CHAR_INLINE_LENGTH = 128;
 
-    /// Only set if type == TYPE_DECIMAL
+    /// Only set if type == TYPE_DECIMAL or TYPE_DECIMALV2
     int precision;
     int scale;
 
@@ -139,7 +139,7 @@ struct TypeDescriptor {
         if (type == TYPE_CHAR) {
             return len == o.len;
         }
-        if (type == TYPE_DECIMAL) {
+        if (type == TYPE_DECIMAL || type == TYPE_DECIMALV2) {
             return precision == o.precision && scale == o.scale;
         }
         return true;
@@ -208,6 +208,7 @@ struct TypeDescriptor {
         case TYPE_LARGEINT:
         case TYPE_DATETIME:
         case TYPE_DATE:
+        case TYPE_DECIMALV2:
             return 16;
 
         case TYPE_DECIMAL:
@@ -255,6 +256,9 @@ struct TypeDescriptor {
         case TYPE_DECIMAL:
             return sizeof(DecimalValue);
 
+        case TYPE_DECIMALV2:
+            return sizeof(DecimalV2Value);
+
         case INVALID_TYPE:
         default:
             DCHECK(false);
@@ -94,6 +94,8 @@ FunctionContextImpl::FunctionContextImpl(palo_udf::FunctionContext* parent) :
         _debug(false),
         _version(palo_udf::FunctionContext::V2_0),
         _num_warnings(0),
+        _result_block(nullptr),
+        _result_block_remaining(0),
         _thread_local_fn_state(nullptr),
         _fragment_local_fn_state(nullptr),
         _external_bytes_tracked(0),
@@ -128,12 +130,28 @@ uint8_t* FunctionContextImpl::allocate_local(int byte_size) {
     return buffer;
 }
 
+uint8_t* FunctionContextImpl::allocate_result(int byte_size) {
+    if (byte_size > RESULT_BLOCK_SIZE / 4) {
+        return allocate_local(byte_size);
+    }
+    if (_result_block == nullptr || byte_size > _result_block_remaining) {
+        _result_block = allocate_local(RESULT_BLOCK_SIZE);
+        _result_block_remaining = RESULT_BLOCK_SIZE;
+    }
+    uint8_t* buffer = _result_block;
+    _result_block += byte_size;
+    _result_block_remaining -= byte_size;
+    return buffer;
+}
+
 void FunctionContextImpl::free_local_allocations() {
     for (int i = 0; i < _local_allocations.size(); ++i) {
         _pool->free(_local_allocations[i]);
     }
 
     _local_allocations.clear();
+    _result_block = nullptr;
+    _result_block_remaining = 0;
 }
 
 void FunctionContextImpl::set_constant_args(const std::vector<palo_udf::AnyVal*>& constant_args) {
@@ -45,6 +45,7 @@ struct BigIntVal;
 struct StringVal;
 struct DateTimeVal;
 struct DecimalVal;
+struct DecimalV2Val;
 
 // The FunctionContext is passed to every UDF/UDA and is the interface for the UDF to the
 // rest of the system. It contains APIs to examine the system state, report errors
@@ -74,6 +75,7 @@ public:
         TYPE_HLL,
         TYPE_STRING,
         TYPE_FIXED_BUFFER,
+        TYPE_DECIMALV2,
     };
 
     struct TypeDesc {
@@ -719,6 +721,37 @@ struct LargeIntVal : public AnyVal {
     }
 };
 
+// Decimal of at most 27 integer digits and 9 fraction digits, 'val' is the
+// value scaled by 10^9
+struct DecimalV2Val : public AnyVal {
+    __int128 val;
+
+    DecimalV2Val() : val(0) { }
+
+    DecimalV2Val(__int128 value) : val(value) { }
+
+    static DecimalV2Val null() {
+        DecimalV2Val result;
+        result.is_null = true;
+        return result;
+    }
+
+    bool operator==(const DecimalV2Val& other) const {
+        if (is_null && other.is_null) {
+            return true;
+        }
+
+        if (is_null || other.is_null) {
+            return false;
+        }
+
+        return val == other.val;
+    }
+    bool operator!=(const DecimalV2Val& other) const {
+        return !(*this == other);
+    }
+};
+
 typedef uint8_t* BufferVal;
 }
 
@@ -732,6 +765,7 @@ using palo_udf::FloatVal;
 using palo_udf::DoubleVal;
 using palo_udf::StringVal;
 using palo_udf::DecimalVal;
+using palo_udf::DecimalV2Val;
 using palo_udf::DateTimeVal;
 using palo_udf::FunctionContext;
 
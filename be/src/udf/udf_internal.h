@@ -113,6 +113,12 @@ public:
     // TODO: free them at the batch level and save some copies?
     uint8_t* allocate_local(int byte_size);
 
+    // Allocates a buffer of 'byte_size' for result of a builtin function, which is
+    // freed with local allocations. Small buffers are carved out of larger local
+    // allocations, so that functions returning new strings don't allocate for every
+    // row. Buffers can't be freed one by one.
+    uint8_t* allocate_result(int byte_size);
+
     // Frees all allocations returned by AllocateLocal().
     void free_local_allocations();
 
@@ -173,6 +179,10 @@ private:
     std::map<uint8_t*, int> _allocations;
     std::vector<uint8_t*> _local_allocations;
 
+    // Block which allocate_result() carves buffers from, it's one of local allocations
+    uint8_t* _result_block;
+    int _result_block_remaining;
+
     /// The function state accessed via FunctionContext::Get/SetFunctionState()
     void* _thread_local_fn_state;
     void* _fragment_local_fn_state;
@@ -206,6 +216,9 @@ private:
     bool _closed;
 
     std::string _string_result;
+
+    // Size of blocks of allocate_result(), larger buffers are allocated directly
+    static const int RESULT_BLOCK_SIZE = 8192;
 };
 
 }
@@ -49,9 +49,12 @@ IntCounter PaloMetrics::base_compaction_deltas_total;
 IntCounter PaloMetrics::base_compaction_bytes_total;
 IntCounter PaloMetrics::cumulative_compaction_deltas_total;
 IntCounter PaloMetrics::cumulative_compaction_bytes_total;
+IntCounter PaloMetrics::mem_index_load_total;
+IntCounter PaloMetrics::mem_index_load_duration_us;
 
 // gauges
 IntGauge PaloMetrics::memory_pool_bytes_total;
+IntGauge PaloMetrics::mem_index_cache_bytes;
 
 PaloMetrics::PaloMetrics() : _metrics(nullptr), _system_metrics(nullptr) {
 }
@@ -116,8 +119,12 @@ void PaloMetrics::initialize(const std::string& name,
         "compaction_bytes_total", MetricLabels().add("type", "cumulative"),
         &cumulative_compaction_bytes_total);
 
+    REGISTER_PALO_METRIC(mem_index_load_total);
+    REGISTER_PALO_METRIC(mem_index_load_duration_us);
+
     // Gauge
     REGISTER_PALO_METRIC(memory_pool_bytes_total);
+    REGISTER_PALO_METRIC(mem_index_cache_bytes);
 
     if (init_system_metrics) {
         _system_metrics = new SystemMetrics();
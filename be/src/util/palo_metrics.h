@@ -57,8 +57,12 @@ public:
     static IntCounter cumulative_compaction_deltas_total;
     static IntCounter cumulative_compaction_bytes_total;
 
+    static IntCounter mem_index_load_total;
+    static IntCounter mem_index_load_duration_us;
+
     // Gauges
     static IntGauge memory_pool_bytes_total;
+    static IntGauge mem_index_cache_bytes;
 
     ~PaloMetrics();
     // call before calling metrics
@@ -0,0 +1,228 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/roaring_bitmap.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace palo {
+
+static const size_t CONTAINER_HEADER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+void RoaringBitmap::add(uint64_t value) {
+    uint16_t low = value & 0xFFFF;
+    _add_array(_get_container(value >> 16), &low, 1);
+}
+
+bool RoaringBitmap::contains(uint64_t value) const {
+    const Container* container = _find_container(value >> 16);
+    if (container == NULL) {
+        return false;
+    }
+    uint16_t low = value & 0xFFFF;
+    if (!container->bitset.empty()) {
+        return (container->bitset[low >> 6] >> (low & 63)) & 1;
+    }
+    return std::binary_search(container->array.begin(), container->array.end(), low);
+}
+
+void RoaringBitmap::merge(const RoaringBitmap& other) {
+    for (const Container& src : other._containers) {
+        Container* dst = _get_container(src.key);
+        if (!src.bitset.empty()) {
+            _add_bitset(dst, src.bitset.data());
+        } else {
+            _add_array(dst, src.array.data(), src.array.size());
+        }
+    }
+}
+
+bool RoaringBitmap::merge(const uint8_t* buf, size_t len) {
+    if (len == 0) {
+        return true;
+    }
+    if (len < sizeof(uint32_t)) {
+        return false;
+    }
+    uint32_t num_containers = 0;
+    memcpy(&num_containers, buf, sizeof(uint32_t));
+    const uint8_t* ptr = buf + sizeof(uint32_t);
+    const uint8_t* end = buf + len;
+    // values of containers are not aligned, copy them out before adding
+    std::vector<uint16_t> array;
+    std::vector<uint64_t> bitset;
+    for (uint32_t i = 0; i < num_containers; ++i) {
+        if ((size_t)(end - ptr) < CONTAINER_HEADER_SIZE) {
+            return false;
+        }
+        uint64_t key = 0;
+        uint32_t cardinality = 0;
+        memcpy(&key, ptr, sizeof(uint64_t));
+        memcpy(&cardinality, ptr + sizeof(uint64_t), sizeof(uint32_t));
+        ptr += CONTAINER_HEADER_SIZE;
+        if (cardinality == 0 || cardinality > 65536) {
+            return false;
+        }
+        if (cardinality <= ARRAY_MAX_CARDINALITY) {
+            size_t size = cardinality * sizeof(uint16_t);
+            if ((size_t)(end - ptr) < size) {
+                return false;
+            }
+            array.resize(cardinality);
+            memcpy(array.data(), ptr, size);
+            ptr += size;
+            _add_array(_get_container(key), array.data(), cardinality);
+        } else {
+            size_t size = BITSET_WORDS * sizeof(uint64_t);
+            if ((size_t)(end - ptr) < size) {
+                return false;
+            }
+            bitset.resize(BITSET_WORDS);
+            memcpy(bitset.data(), ptr, size);
+            ptr += size;
+            _add_bitset(_get_container(key), bitset.data());
+        }
+    }
+    return ptr == end;
+}
+
+uint64_t RoaringBitmap::cardinality() const {
+    uint64_t cardinality = 0;
+    for (const Container& container : _containers) {
+        cardinality += container.cardinality;
+    }
+    return cardinality;
+}
+
+void RoaringBitmap::clear() {
+    std::vector<Container>().swap(_containers);
+}
+
+size_t RoaringBitmap::serialized_size() const {
+    size_t size = sizeof(uint32_t);
+    for (const Container& container : _containers) {
+        size += CONTAINER_HEADER_SIZE;
+        if (container.cardinality <= ARRAY_MAX_CARDINALITY) {
+            size += container.cardinality * sizeof(uint16_t);
+        } else {
+            size += BITSET_WORDS * sizeof(uint64_t);
+        }
+    }
+    return size;
+}
+
+void RoaringBitmap::serialize(uint8_t* buf) const {
+    uint32_t num_containers = _containers.size();
+    memcpy(buf, &num_containers, sizeof(uint32_t));
+    buf += sizeof(uint32_t);
+    for (const Container& container : _containers) {
+        memcpy(buf, &container.key, sizeof(uint64_t));
+        memcpy(buf + sizeof(uint64_t), &container.cardinality, sizeof(uint32_t));
+        buf += CONTAINER_HEADER_SIZE;
+        if (container.cardinality <= ARRAY_MAX_CARDINALITY) {
+            size_t size = container.cardinality * sizeof(uint16_t);
+            memcpy(buf, container.array.data(), size);
+            buf += size;
+        } else {
+            size_t size = BITSET_WORDS * sizeof(uint64_t);
+            memcpy(buf, container.bitset.data(), size);
+            buf += size;
+        }
+    }
+}
+
+bool RoaringBitmap::unserialize(const uint8_t* buf, size_t len) {
+    clear();
+    return merge(buf, len);
+}
+
+RoaringBitmap::Container* RoaringBitmap::_get_container(uint64_t key) {
+    auto it = std::lower_bound(
+        _containers.begin(), _containers.end(), key,
+        [](const Container& container, uint64_t key) { return container.key < key; });
+    if (it == _containers.end() || it->key != key) {
+        it = _containers.insert(it, Container());
+        it->key = key;
+        it->cardinality = 0;
+    }
+    return &*it;
+}
+
+const RoaringBitmap::Container* RoaringBitmap::_find_container(uint64_t key) const {
+    auto it = std::lower_bound(
+        _containers.begin(), _containers.end(), key,
+        [](const Container& container, uint64_t key) { return container.key < key; });
+    if (it == _containers.end() || it->key != key) {
+        return NULL;
+    }
+    return &*it;
+}
+
+void RoaringBitmap::_add_array(Container* container, const uint16_t* values, uint32_t num) {
+    if (container->bitset.empty()) {
+        std::vector<uint16_t>& array = container->array;
+        if (num == 1) {
+            auto it = std::lower_bound(array.begin(), array.end(), values[0]);
+            if (it != array.end() && *it == values[0]) {
+                return;
+            }
+            array.insert(it, values[0]);
+        } else {
+            std::vector<uint16_t> merged;
+            merged.reserve(array.size() + num);
+            std::set_union(array.begin(), array.end(), values, values + num,
+                           std::back_inserter(merged));
+            array.swap(merged);
+        }
+        container->cardinality = array.size();
+        if (container->cardinality > ARRAY_MAX_CARDINALITY) {
+            _to_bitset(container);
+        }
+        return;
+    }
+    uint64_t* words = container->bitset.data();
+    for (uint32_t i = 0; i < num; ++i) {
+        uint64_t& word = words[values[i] >> 6];
+        uint64_t bit = 1ULL << (values[i] & 63);
+        container->cardinality += (word & bit) == 0;
+        word |= bit;
+    }
+}
+
+void RoaringBitmap::_add_bitset(Container* container, const uint64_t* words) {
+    if (container->bitset.empty()) {
+        _to_bitset(container);
+    }
+    uint64_t* dst = container->bitset.data();
+    uint32_t cardinality = 0;
+    for (uint32_t i = 0; i < BITSET_WORDS; ++i) {
+        dst[i] |= words[i];
+        cardinality += __builtin_popcountll(dst[i]);
+    }
+    container->cardinality = cardinality;
+}
+
+void RoaringBitmap::_to_bitset(Container* container) {
+    container->bitset.assign(BITSET_WORDS, 0);
+    for (uint16_t value : container->array) {
+        container->bitset[value >> 6] |= 1ULL << (value & 63);
+    }
+    std::vector<uint16_t>().swap(container->array);
+}
+
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace palo {
+
+// RoaringBitmap is a compressed bitmap of 64-bit integers, see "Better bitmap
+// performance with Roaring bitmaps" by Chambi et al.
+//
+// Values are partitioned by their high 48 bits into containers, each holding
+// the low 16 bits of its values either as a sorted array, if it has at most
+// ARRAY_MAX_CARDINALITY values, or as a bitset of 65536 bits. Sparse ids cost
+// about 2 bytes each and dense ids about 1 bit each, and union is a merge of
+// sorted containers.
+class RoaringBitmap {
+public:
+    RoaringBitmap() { }
+
+    void add(uint64_t value);
+    bool contains(uint64_t value) const;
+
+    // Add values of 'other'
+    void merge(const RoaringBitmap& other);
+    // Add values of serialized bitmap in 'buf' without building it.
+    // Return false if 'buf' is not a valid serialized bitmap.
+    bool merge(const uint8_t* buf, size_t len);
+
+    uint64_t cardinality() const;
+    bool empty() const { return _containers.empty(); }
+    // Remove all values and release memory
+    void clear();
+
+    // Serialized format:
+    // num_containers:uint32 (key:uint64 cardinality:uint32 values)*
+    // values are cardinality uint16 if cardinality <= ARRAY_MAX_CARDINALITY,
+    // otherwise BITSET_WORDS uint64. Empty buffer is also an empty bitmap.
+    size_t serialized_size() const;
+    // 'buf' must have serialized_size() bytes
+    void serialize(uint8_t* buf) const;
+    // Return false if 'buf' is not a valid serialized bitmap
+    bool unserialize(const uint8_t* buf, size_t len);
+
+    static const uint32_t ARRAY_MAX_CARDINALITY = 4096;
+    static const uint32_t BITSET_WORDS = 65536 / 64;
+
+private:
+    struct Container {
+        // high 48 bits of values
+        uint64_t key;
+        uint32_t cardinality;
+        // sorted low 16 bits, used if cardinality <= ARRAY_MAX_CARDINALITY
+        std::vector<uint16_t> array;
+        // used otherwise
+        std::vector<uint64_t> bitset;
+    };
+
+    // Return container of 'key', create it if not exists
+    Container* _get_container(uint64_t key);
+    const Container* _find_container(uint64_t key) const;
+
+    static void _add_array(Container* container, const uint16_t* values, uint32_t num);
+    static void _add_bitset(Container* container, const uint64_t* words);
+    static void _to_bitset(Container* container);
+
+    // sorted by key
+    std::vector<Container> _containers;
+};
+
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#include "util/cpu_info.h"
+
+namespace palo {
+
+// String kernels used by string builtins. 16 bytes are processed at a time
+// with SSE, and the rest byte by byte. Results are the same as scalar loops.
+class SimdStringUtil {
+public:
+    // Same as ::tolower() of every byte in C locale, only ASCII is changed
+    static void to_lower(const uint8_t* src, int len, uint8_t* dst) {
+        convert_case(src, len, dst, 'A', 'Z');
+    }
+
+    // Same as ::toupper() of every byte in C locale, only ASCII is changed
+    static void to_upper(const uint8_t* src, int len, uint8_t* dst) {
+        convert_case(src, len, dst, 'a', 'z');
+    }
+
+    // Return index of the first byte which is not ' ', 'len' if there is none
+    static int find_first_not_space(const uint8_t* str, int len) {
+        int i = 0;
+#ifdef __SSE2__
+        const __m128i spaces = _mm_set1_epi8(' ');
+        for (; i + 16 <= len; i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, spaces));
+            if (mask != 0xFFFF) {
+                return i + __builtin_ctz(~mask & 0xFFFF);
+            }
+        }
+#endif
+        while (i < len && str[i] == ' ') {
+            ++i;
+        }
+        return i;
+    }
+
+    // Return index of the last byte which is not ' ', -1 if there is none
+    static int find_last_not_space(const uint8_t* str, int len) {
+        int end = len;
+#ifdef __SSE2__
+        const __m128i spaces = _mm_set1_epi8(' ');
+        for (; end >= 16; end -= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + end - 16));
+            int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, spaces));
+            if (mask != 0xFFFF) {
+                return end - 16 + 31 - __builtin_clz(~mask & 0xFFFF);
+            }
+        }
+#endif
+        int i = end - 1;
+        while (i >= 0 && str[i] == ' ') {
+            --i;
+        }
+        return i;
+    }
+
+    // Number of UTF-8 characters, which is the number of bytes that are not
+    // continuation bytes (10xxxxxx). Invalid sequences are not checked.
+    static int utf8_length(const uint8_t* str, int len) {
+        int count = 0;
+        int i = 0;
+#ifdef __SSE2__
+        // continuation bytes are [-128, -65] as signed char
+        const __m128i threshold = _mm_set1_epi8(-65);
+        for (; i + 16 <= len; i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+            int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(chunk, threshold));
+            count += __builtin_popcount(mask);
+        }
+#endif
+        for (; i < len; ++i) {
+            count += (str[i] & 0xC0) != 0x80;
+        }
+        return count;
+    }
+
+    // Write bytes of 'src' into 'dst' in reverse order, they must not overlap
+    static void reverse(const uint8_t* src, int len, uint8_t* dst) {
+        int i = 0;
+#ifdef __SSSE3__
+        if (CpuInfo::is_supported(CpuInfo::SSSE3)) {
+            const __m128i shuffle = _mm_setr_epi8(
+                15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+            for (; i + 16 <= len; i += 16) {
+                __m128i chunk = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + len - i - 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                                 _mm_shuffle_epi8(chunk, shuffle));
+            }
+        }
+#endif
+        for (; i < len; ++i) {
+            dst[i] = src[len - 1 - i];
+        }
+    }
+
+private:
+    // Flip case of bytes in ['first', 'last'], which must be ASCII letters
+    static void convert_case(const uint8_t* src, int len, uint8_t* dst,
+                             char first, char last) {
+        int i = 0;
+#ifdef __SSE2__
+        // bytes not less than 0x80 are negative, so they are never in range
+        const __m128i lower_bound = _mm_set1_epi8(first - 1);
+        const __m128i upper_bound = _mm_set1_epi8(last + 1);
+        const __m128i case_bit = _mm_set1_epi8(0x20);
+        for (; i + 16 <= len; i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(chunk, lower_bound),
+                                             _mm_cmplt_epi8(chunk, upper_bound));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                             _mm_xor_si128(chunk, _mm_and_si128(in_range, case_bit)));
+        }
+#endif
+        for (; i < len; ++i) {
+            uint8_t c = src[i];
+            dst[i] = (c >= first && c <= last) ? (c ^ 0x20) : c;
+        }
+    }
+};
+
+}
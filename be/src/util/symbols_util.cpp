@@ -163,6 +163,9 @@ static void append_any_val_type(
     case TYPE_DECIMAL:
         append_mangled_token("DecimalVal", s);
         break;
+    case TYPE_DECIMALV2:
+        append_mangled_token("DecimalV2Val", s);
+        break;
     default:
         DCHECK(false) << "NYI: " << type.debug_string();
     }
@@ -0,0 +1,193 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/tdigest.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace palo {
+
+TDigest::TDigest(double compression) :
+        _compression(compression),
+        _max_unprocessed(static_cast<size_t>(compression) * 8),
+        _processed_weight(0),
+        _unprocessed_weight(0),
+        _min(std::numeric_limits<double>::max()),
+        _max(std::numeric_limits<double>::lowest()) {
+}
+
+void TDigest::add(double value, double weight) {
+    if (isnan(value) || weight <= 0) {
+        return;
+    }
+    _add_centroid(Centroid(value, weight));
+}
+
+void TDigest::_add_centroid(const Centroid& centroid) {
+    _unprocessed.push_back(centroid);
+    _unprocessed_weight += centroid.weight;
+    _min = std::min(_min, centroid.mean);
+    _max = std::max(_max, centroid.mean);
+    if (_unprocessed.size() >= _max_unprocessed) {
+        _process();
+    }
+}
+
+void TDigest::merge(const TDigest& other) {
+    for (const Centroid& centroid : other._processed) {
+        _add_centroid(centroid);
+    }
+    for (const Centroid& centroid : other._unprocessed) {
+        _add_centroid(centroid);
+    }
+    // centroids of 'other' may be inside its [min, max]
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+}
+
+void TDigest::_process() {
+    if (_unprocessed.empty()) {
+        return;
+    }
+    _unprocessed.insert(_unprocessed.end(), _processed.begin(), _processed.end());
+    std::sort(_unprocessed.begin(), _unprocessed.end());
+    _processed.clear();
+
+    double total_weight = _processed_weight + _unprocessed_weight;
+    double weight_so_far = 0;
+    Centroid current = _unprocessed[0];
+    for (size_t i = 1; i < _unprocessed.size(); ++i) {
+        const Centroid& next = _unprocessed[i];
+        double proposed_weight = current.weight + next.weight;
+        // size of a centroid is bounded by 4 * total * q * (1 - q) / compression,
+        // q of both ends are checked so that centroids at tails are small
+        double q0 = weight_so_far / total_weight;
+        double q2 = (weight_so_far + proposed_weight) / total_weight;
+        double limit = 4 * total_weight * std::min(q0 * (1 - q0), q2 * (1 - q2)) / _compression;
+        if (proposed_weight <= limit) {
+            current.mean += (next.mean - current.mean) * next.weight / proposed_weight;
+            current.weight = proposed_weight;
+        } else {
+            weight_so_far += current.weight;
+            _processed.push_back(current);
+            current = next;
+        }
+    }
+    _processed.push_back(current);
+
+    _unprocessed.clear();
+    _processed_weight = total_weight;
+    _unprocessed_weight = 0;
+}
+
+double TDigest::quantile(double q) {
+    _process();
+    if (_processed.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (q <= 0) {
+        return _min;
+    }
+    if (q >= 1) {
+        return _max;
+    }
+    if (_processed.size() == 1) {
+        return _processed[0].mean;
+    }
+
+    // Each centroid is assumed to be centered at its mean, values between
+    // centers of adjacent centroids are interpolated linearly. Min and max
+    // are the ends.
+    double index = q * _processed_weight;
+    const Centroid& first = _processed.front();
+    if (index < first.weight / 2) {
+        return _min + (first.mean - _min) * index / (first.weight / 2);
+    }
+    double weight_so_far = first.weight / 2;
+    for (size_t i = 0; i + 1 < _processed.size(); ++i) {
+        const Centroid& left = _processed[i];
+        const Centroid& right = _processed[i + 1];
+        double delta = (left.weight + right.weight) / 2;
+        if (index < weight_so_far + delta) {
+            return left.mean + (right.mean - left.mean) * (index - weight_so_far) / delta;
+        }
+        weight_so_far += delta;
+    }
+    const Centroid& last = _processed.back();
+    double rest = last.weight / 2;
+    return last.mean + (_max - last.mean) * std::min(1.0, (index - weight_so_far) / rest);
+}
+
+size_t TDigest::serialized_size() {
+    _process();
+    return sizeof(double) * 3 + sizeof(int32_t) + _processed.size() * sizeof(double) * 2;
+}
+
+void TDigest::serialize(uint8_t* buf) {
+    _process();
+    memcpy(buf, &_compression, sizeof(double));
+    buf += sizeof(double);
+    memcpy(buf, &_min, sizeof(double));
+    buf += sizeof(double);
+    memcpy(buf, &_max, sizeof(double));
+    buf += sizeof(double);
+    int32_t count = _processed.size();
+    memcpy(buf, &count, sizeof(int32_t));
+    buf += sizeof(int32_t);
+    for (const Centroid& centroid : _processed) {
+        memcpy(buf, &centroid.mean, sizeof(double));
+        buf += sizeof(double);
+        memcpy(buf, &centroid.weight, sizeof(double));
+        buf += sizeof(double);
+    }
+}
+
+bool TDigest::unserialize(const uint8_t* buf, size_t len) {
+    const size_t header_size = sizeof(double) * 3 + sizeof(int32_t);
+    if (len < header_size) {
+        return false;
+    }
+    int32_t count = 0;
+    memcpy(&count, buf + sizeof(double) * 3, sizeof(int32_t));
+    if (count < 0 || len != header_size + count * sizeof(double) * 2) {
+        return false;
+    }
+
+    memcpy(&_compression, buf, sizeof(double));
+    buf += sizeof(double);
+    memcpy(&_min, buf, sizeof(double));
+    buf += sizeof(double);
+    memcpy(&_max, buf, sizeof(double));
+    buf += sizeof(double) + sizeof(int32_t);
+    _max_unprocessed = static_cast<size_t>(_compression) * 8;
+    _processed.resize(count);
+    _unprocessed.clear();
+    _processed_weight = 0;
+    _unprocessed_weight = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        memcpy(&_processed[i].mean, buf, sizeof(double));
+        buf += sizeof(double);
+        memcpy(&_processed[i].weight, buf, sizeof(double));
+        buf += sizeof(double);
+        _processed_weight += _processed[i].weight;
+    }
+    return true;
+}
+
+}
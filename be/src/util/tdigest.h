@@ -0,0 +1,89 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace palo {
+
+// TDigest is a sketch of a distribution for estimating quantiles, see
+// "Computing Extremely Accurate Quantiles Using t-Digests" by Ted Dunning.
+//
+// Values are clustered into centroids of (mean, weight). Centroids near the
+// tails hold less weight than those in the middle, so extreme quantiles like
+// P99 are accurate. Number of centroids is bounded by about 'compression',
+// independent of number of values, and digests can be merged, so it can be
+// used as state of distributed aggregation.
+//
+// Added values are buffered and merged into centroids in batches.
+class TDigest {
+public:
+    static const int DEFAULT_COMPRESSION = 100;
+
+    explicit TDigest(double compression = DEFAULT_COMPRESSION);
+
+    void add(double value, double weight = 1);
+
+    // Add all centroids of 'other'
+    void merge(const TDigest& other);
+
+    // Return estimated value at quantile 'q' in [0, 1], NaN if it's empty
+    double quantile(double q);
+
+    double total_weight() const { return _processed_weight + _unprocessed_weight; }
+
+    // Serialized format:
+    // compression:double min:double max:double count:int32 (mean:double weight:double)*
+    size_t serialized_size();
+    // 'buf' must have serialized_size() bytes
+    void serialize(uint8_t* buf);
+    // Return false if 'buf' is not a valid serialized digest
+    bool unserialize(const uint8_t* buf, size_t len);
+
+private:
+    struct Centroid {
+        Centroid() : mean(0), weight(0) { }
+        Centroid(double mean_, double weight_) : mean(mean_), weight(weight_) { }
+
+        bool operator<(const Centroid& other) const {
+            return mean < other.mean;
+        }
+
+        double mean;
+        double weight;
+    };
+
+    // Merge buffered centroids into processed ones
+    void _process();
+    void _add_centroid(const Centroid& centroid);
+
+    double _compression;
+    // bound of buffered centroids before they are processed
+    size_t _max_unprocessed;
+
+    // sorted by mean
+    std::vector<Centroid> _processed;
+    std::vector<Centroid> _unprocessed;
+    double _processed_weight;
+    double _unprocessed_weight;
+    double _min;
+    double _max;
+};
+
+}
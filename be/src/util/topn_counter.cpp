@@ -0,0 +1,189 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/topn_counter.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+namespace palo {
+
+TopNCounter::TopNCounter(uint32_t capacity) : _capacity(std::max(capacity, 1U)) {
+}
+
+void TopNCounter::add(const std::string& value, uint64_t count) {
+    auto it = _index.find(value);
+    if (it != _index.end()) {
+        _counters[it->second].count += count;
+        _sift_down(it->second);
+        return;
+    }
+    if (_counters.size() < _capacity) {
+        _counters.push_back(Counter{value, count});
+        size_t pos = _counters.size() - 1;
+        _index[value] = pos;
+        // sift up, new counter may be smaller than its parents
+        while (pos > 0) {
+            size_t parent = (pos - 1) / 2;
+            if (_counters[parent].count <= _counters[pos].count) {
+                break;
+            }
+            _swap(parent, pos);
+            pos = parent;
+        }
+        return;
+    }
+    // replace the smallest counter
+    Counter& min_counter = _counters[0];
+    _index.erase(min_counter.value);
+    min_counter.value = value;
+    min_counter.count += count;
+    _index[value] = 0;
+    _sift_down(0);
+}
+
+void TopNCounter::_swap(size_t a, size_t b) {
+    std::swap(_counters[a], _counters[b]);
+    _index[_counters[a].value] = a;
+    _index[_counters[b].value] = b;
+}
+
+void TopNCounter::_sift_down(size_t pos) {
+    size_t size = _counters.size();
+    while (true) {
+        size_t smallest = pos;
+        size_t left = pos * 2 + 1;
+        size_t right = left + 1;
+        if (left < size && _counters[left].count < _counters[smallest].count) {
+            smallest = left;
+        }
+        if (right < size && _counters[right].count < _counters[smallest].count) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            return;
+        }
+        _swap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void TopNCounter::_rebuild() {
+    std::make_heap(_counters.begin(), _counters.end(),
+                   [](const Counter& a, const Counter& b) { return a.count > b.count; });
+    _index.clear();
+    for (size_t i = 0; i < _counters.size(); ++i) {
+        _index[_counters[i].value] = i;
+    }
+}
+
+void TopNCounter::merge(const TopNCounter& other) {
+    for (const Counter& counter : other._counters) {
+        auto it = _index.find(counter.value);
+        if (it != _index.end()) {
+            _counters[it->second].count += counter.count;
+        } else {
+            _counters.push_back(counter);
+        }
+    }
+    _capacity = std::max(_capacity, other._capacity);
+    if (_counters.size() > _capacity) {
+        std::nth_element(_counters.begin(), _counters.begin() + _capacity, _counters.end(),
+                         [](const Counter& a, const Counter& b) { return a.count > b.count; });
+        _counters.resize(_capacity);
+    }
+    _rebuild();
+}
+
+void TopNCounter::top(int n, std::vector<std::pair<std::string, uint64_t> >* result) const {
+    result->clear();
+    for (const Counter& counter : _counters) {
+        result->emplace_back(counter.value, counter.count);
+    }
+    // ties are ordered by value, so that result is stable
+    std::sort(result->begin(), result->end(),
+              [](const std::pair<std::string, uint64_t>& a,
+                 const std::pair<std::string, uint64_t>& b) {
+                  return a.second > b.second || (a.second == b.second && a.first < b.first);
+              });
+    if (result->size() > static_cast<size_t>(n)) {
+        result->resize(n);
+    }
+}
+
+size_t TopNCounter::serialized_size() const {
+    size_t size = sizeof(uint32_t) * 2;
+    for (const Counter& counter : _counters) {
+        size += sizeof(uint64_t) + sizeof(uint32_t) + counter.value.size();
+    }
+    return size;
+}
+
+void TopNCounter::serialize(uint8_t* buf) const {
+    uint32_t num_counters = _counters.size();
+    memcpy(buf, &_capacity, sizeof(uint32_t));
+    buf += sizeof(uint32_t);
+    memcpy(buf, &num_counters, sizeof(uint32_t));
+    buf += sizeof(uint32_t);
+    for (const Counter& counter : _counters) {
+        uint32_t len = counter.value.size();
+        memcpy(buf, &counter.count, sizeof(uint64_t));
+        buf += sizeof(uint64_t);
+        memcpy(buf, &len, sizeof(uint32_t));
+        buf += sizeof(uint32_t);
+        memcpy(buf, counter.value.data(), len);
+        buf += len;
+    }
+}
+
+bool TopNCounter::unserialize(const uint8_t* buf, size_t len) {
+    const uint8_t* end = buf + len;
+    uint32_t capacity = 0;
+    uint32_t num_counters = 0;
+    if (len < sizeof(uint32_t) * 2) {
+        return false;
+    }
+    memcpy(&capacity, buf, sizeof(uint32_t));
+    buf += sizeof(uint32_t);
+    memcpy(&num_counters, buf, sizeof(uint32_t));
+    buf += sizeof(uint32_t);
+
+    std::vector<Counter> counters(num_counters);
+    for (uint32_t i = 0; i < num_counters; ++i) {
+        uint32_t value_len = 0;
+        if (static_cast<size_t>(end - buf) < sizeof(uint64_t) + sizeof(uint32_t)) {
+            return false;
+        }
+        memcpy(&counters[i].count, buf, sizeof(uint64_t));
+        buf += sizeof(uint64_t);
+        memcpy(&value_len, buf, sizeof(uint32_t));
+        buf += sizeof(uint32_t);
+        if (static_cast<size_t>(end - buf) < value_len) {
+            return false;
+        }
+        counters[i].value.assign(reinterpret_cast<const char*>(buf), value_len);
+        buf += value_len;
+    }
+    if (buf != end) {
+        return false;
+    }
+    _capacity = std::max(capacity, 1U);
+    _counters.swap(counters);
+    _rebuild();
+    return true;
+}
+
+}
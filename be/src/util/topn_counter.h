@@ -0,0 +1,81 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace palo {
+
+// TopNCounter finds the most frequent values of a stream in bounded memory
+// with the Space-Saving algorithm, see "Efficient Computation of Frequent
+// and Top-k Elements in Data Streams" by Metwally et al.
+//
+// At most 'capacity' values are counted. When a new value comes and all
+// counters are used, the value of the smallest counter is replaced, and its
+// count is inherited, so counts are overestimated by at most the smallest
+// count. Capacity is usually several times of N for accurate top N.
+//
+// Counters are kept in a min heap on count, so updating is O(log capacity).
+class TopNCounter {
+public:
+    explicit TopNCounter(uint32_t capacity);
+
+    void add(const std::string& value, uint64_t count = 1);
+
+    // Add counts of 'other', only the largest 'capacity' counts are kept
+    void merge(const TopNCounter& other);
+
+    // Return the 'n' most frequent values with their counts, ordered by
+    // count descending
+    void top(int n, std::vector<std::pair<std::string, uint64_t> >* result) const;
+
+    uint32_t capacity() const { return _capacity; }
+    size_t size() const { return _counters.size(); }
+
+    // Serialized format:
+    // capacity:uint32 num_counters:uint32 (count:uint64 len:uint32 value)*
+    size_t serialized_size() const;
+    // 'buf' must have serialized_size() bytes
+    void serialize(uint8_t* buf) const;
+    // Return false if 'buf' is not a valid serialized counter
+    bool unserialize(const uint8_t* buf, size_t len);
+
+private:
+    struct Counter {
+        std::string value;
+        uint64_t count;
+    };
+
+    // Move counter at heap position 'pos' down after its count is increased
+    void _sift_down(size_t pos);
+    void _swap(size_t a, size_t b);
+    // Build heap and index from _counters
+    void _rebuild();
+
+    uint32_t _capacity;
+    // min heap on count
+    std::vector<Counter> _counters;
+    // value to position in _counters
+    std::unordered_map<std::string, size_t> _index;
+};
+
+}
@@ -0,0 +1,263 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exec/arrow_scanner.h"
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/datetime_value.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_pool.h"
+#include "runtime/runtime_state.h"
+#include "runtime/string_value.h"
+#include "runtime/tuple.h"
+
+namespace palo {
+
+static const char* s_file_path = "/tmp/arrow_scanner_test.arrow";
+
+class ArrowScannerTest : public testing::Test {
+public:
+    ArrowScannerTest() : _runtime_state("ArrowScannerTest") {
+        init_desc_table();
+        init_params();
+        _profile = _runtime_state.runtime_profile();
+    }
+
+protected:
+    virtual void SetUp() {
+        write_file();
+    }
+    virtual void TearDown() {
+        unlink(s_file_path);
+    }
+
+    void init_desc_table();
+    void init_params();
+    void write_file();
+    std::vector<TBrokerRangeDesc> create_ranges();
+
+    RuntimeState _runtime_state;
+    RuntimeProfile* _profile;
+    ObjectPool _obj_pool;
+    TBrokerScanRangeParams _params;
+    DescriptorTbl* _desc_tbl;
+    std::vector<TNetworkAddress> _addresses;
+    BrokerScanCounter _counter;
+};
+
+static TTypeDesc create_type_desc(TPrimitiveType::type type) {
+    TTypeDesc type_desc;
+    TTypeNode node;
+    node.__set_type(TTypeNodeType::SCALAR);
+    TScalarType scalar_type;
+    scalar_type.__set_type(type);
+    if (type == TPrimitiveType::VARCHAR) {
+        scalar_type.__set_len(5000);
+    }
+    node.__set_scalar_type(scalar_type);
+    type_desc.types.push_back(node);
+    return type_desc;
+}
+
+static const std::vector<std::string> s_col_names = {"ts", "ts_naive", "d"};
+static const std::vector<TPrimitiveType::type> s_col_types = {
+    TPrimitiveType::DATETIME, TPrimitiveType::DATETIME, TPrimitiveType::VARCHAR};
+
+// dest tuple is 0 with slots 1, 2, 3, source tuple is 1 with slots 4, 5, 6
+void ArrowScannerTest::init_desc_table() {
+    TDescriptorTable t_desc_table;
+    for (int tuple_id = 0; tuple_id < 2; ++tuple_id) {
+        for (int i = 0; i < s_col_names.size(); ++i) {
+            TSlotDescriptor slot_desc;
+            slot_desc.id = tuple_id * 3 + i + 1;
+            slot_desc.parent = tuple_id;
+            slot_desc.slotType = create_type_desc(s_col_types[i]);
+            slot_desc.columnPos = i;
+            slot_desc.byteOffset = i * 16;
+            slot_desc.nullIndicatorByte = 0;
+            slot_desc.nullIndicatorBit = -1;
+            slot_desc.colName = s_col_names[i];
+            slot_desc.slotIdx = i;
+            slot_desc.isMaterialized = true;
+            t_desc_table.slotDescriptors.push_back(slot_desc);
+        }
+        TTupleDescriptor t_tuple_desc;
+        t_tuple_desc.id = tuple_id;
+        t_tuple_desc.byteSize = 48;
+        t_tuple_desc.numNullBytes = 0;
+        t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+    }
+    t_desc_table.__isset.slotDescriptors = true;
+
+    DescriptorTbl::create(&_obj_pool, t_desc_table, &_desc_tbl);
+    _runtime_state.set_desc_tbl(_desc_tbl);
+}
+
+void ArrowScannerTest::init_params() {
+    _params.column_separator = ',';
+    _params.line_delimiter = '\n';
+    for (int i = 0; i < s_col_names.size(); ++i) {
+        TExprNode slot_ref;
+        slot_ref.node_type = TExprNodeType::SLOT_REF;
+        slot_ref.type = create_type_desc(s_col_types[i]);
+        slot_ref.num_children = 0;
+        slot_ref.__isset.slot_ref = true;
+        slot_ref.slot_ref.slot_id = 4 + i;
+        slot_ref.slot_ref.tuple_id = 1;
+
+        TExpr expr;
+        expr.nodes.push_back(slot_ref);
+        _params.expr_of_dest_slot.emplace(1 + i, expr);
+        _params.src_slot_ids.push_back(4 + i);
+    }
+    _params.__set_dest_tuple_id(0);
+    _params.__set_src_tuple_id(1);
+}
+
+// ts: timestamp(s, UTC), ts_naive: timestamp(ms), d: double
+void ArrowScannerTest::write_file() {
+    arrow::TimestampBuilder ts_builder(
+        arrow::timestamp(arrow::TimeUnit::SECOND, "UTC"), arrow::default_memory_pool());
+    arrow::TimestampBuilder naive_builder(
+        arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    arrow::DoubleBuilder double_builder;
+    // 2017-07-14 02:40:00 UTC, 1971-01-01 00:00:00 UTC, 1970-01-01 00:00:00 UTC
+    for (int64_t ts : {1500000000L, 86400L * 365, 0L}) {
+        ASSERT_TRUE(ts_builder.Append(ts).ok());
+    }
+    // 2017-07-14 02:40:00.123, 1969-12-31 23:59:59, 1970-01-02 00:00:00
+    for (int64_t ts : {1500000000123L, -1000L, 86400000L}) {
+        ASSERT_TRUE(naive_builder.Append(ts).ok());
+    }
+    for (double d : {0.1, 1234567.891, -2.5}) {
+        ASSERT_TRUE(double_builder.Append(d).ok());
+    }
+    std::vector<std::shared_ptr<arrow::Array>> columns(3);
+    ASSERT_TRUE(ts_builder.Finish(&columns[0]).ok());
+    ASSERT_TRUE(naive_builder.Finish(&columns[1]).ok());
+    ASSERT_TRUE(double_builder.Finish(&columns[2]).ok());
+    auto schema = arrow::schema({
+        arrow::field("ts", columns[0]->type()),
+        arrow::field("ts_naive", columns[1]->type()),
+        arrow::field("d", columns[2]->type())});
+    auto batch = arrow::RecordBatch::Make(schema, 3, columns);
+
+    std::shared_ptr<arrow::io::FileOutputStream> file;
+    ASSERT_TRUE(arrow::io::FileOutputStream::Open(s_file_path, &file).ok());
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+    ASSERT_TRUE(arrow::ipc::RecordBatchStreamWriter::Open(file.get(), schema, &writer).ok());
+    ASSERT_TRUE(writer->WriteRecordBatch(*batch).ok());
+    ASSERT_TRUE(writer->Close().ok());
+    ASSERT_TRUE(file->Close().ok());
+}
+
+std::vector<TBrokerRangeDesc> ArrowScannerTest::create_ranges() {
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.path = s_file_path;
+    range.start_offset = 0;
+    range.size = -1;
+    range.splittable = false;
+    range.file_type = TFileType::FILE_LOCAL;
+    range.format_type = TFileFormatType::FORMAT_ARROW_STREAM;
+    ranges.push_back(range);
+    return ranges;
+}
+
+static std::string datetime_string(Tuple* tuple, int offset) {
+    char buf[64];
+    reinterpret_cast<DateTimeValue*>(tuple->get_slot(offset))->to_string(buf);
+    return buf;
+}
+
+static std::string string_value(Tuple* tuple, int offset) {
+    StringValue* value = reinterpret_cast<StringValue*>(tuple->get_slot(offset));
+    return std::string(value->ptr, value->len);
+}
+
+TEST_F(ArrowScannerTest, normal) {
+    auto ranges = create_ranges();
+    ArrowScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, &_counter);
+    ASSERT_TRUE(scanner.open().ok());
+
+    MemPool tuple_pool(_runtime_state.instance_mem_tracker());
+    Tuple* tuple = (Tuple*)tuple_pool.allocate(48);
+    bool eof = false;
+    ASSERT_TRUE(scanner.get_next(tuple, &tuple_pool, &eof).ok());
+    ASSERT_FALSE(eof);
+    // timestamp with timezone is converted to +08:00 by default
+    ASSERT_EQ("2017-07-14 10:40:00", datetime_string(tuple, 0));
+    ASSERT_EQ("2017-07-14 02:40:00", datetime_string(tuple, 16));
+    // double keeps all digits
+    ASSERT_EQ("0.10000000000000001", string_value(tuple, 32));
+
+    // time of source slot in previous row is not kept
+    ASSERT_TRUE(scanner.get_next(tuple, &tuple_pool, &eof).ok());
+    ASSERT_FALSE(eof);
+    ASSERT_EQ("1971-01-01 08:00:00", datetime_string(tuple, 0));
+    ASSERT_EQ("1969-12-31 23:59:59", datetime_string(tuple, 16));
+    ASSERT_EQ("1234567.8910000001", string_value(tuple, 32));
+
+    ASSERT_TRUE(scanner.get_next(tuple, &tuple_pool, &eof).ok());
+    ASSERT_FALSE(eof);
+    ASSERT_EQ("1970-01-01 08:00:00", datetime_string(tuple, 0));
+    ASSERT_EQ("1970-01-02 00:00:00", datetime_string(tuple, 16));
+    ASSERT_EQ("-2.5", string_value(tuple, 32));
+
+    ASSERT_TRUE(scanner.get_next(tuple, &tuple_pool, &eof).ok());
+    ASSERT_TRUE(eof);
+}
+
+TEST_F(ArrowScannerTest, timezone) {
+    _params.properties["timezone"] = "UTC";
+    auto ranges = create_ranges();
+    ArrowScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, &_counter);
+    ASSERT_TRUE(scanner.open().ok());
+
+    MemPool tuple_pool(_runtime_state.instance_mem_tracker());
+    Tuple* tuple = (Tuple*)tuple_pool.allocate(48);
+    bool eof = false;
+    ASSERT_TRUE(scanner.get_next(tuple, &tuple_pool, &eof).ok());
+    ASSERT_FALSE(eof);
+    ASSERT_EQ("2017-07-14 02:40:00", datetime_string(tuple, 0));
+    // timestamp without timezone is not changed
+    ASSERT_EQ("2017-07-14 02:40:00", datetime_string(tuple, 16));
+}
+
+TEST_F(ArrowScannerTest, unknown_timezone) {
+    _params.properties["timezone"] = "Mars/Olympus";
+    auto ranges = create_ranges();
+    ArrowScanner scanner(&_runtime_state, _profile, _params, ranges, _addresses, &_counter);
+    ASSERT_FALSE(scanner.open().ok());
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,359 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "common/object_pool.h"
+#include "exec/olap_scanner.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "olap/field.h"
+#include "olap/row_cursor.h"
+#include "olap/string_slice.h"
+#include "runtime/datetime_value.h"
+#include "runtime/decimal_value.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/descriptors.h"
+#include "runtime/string_value.h"
+#include "runtime/tuple.h"
+#include "util/mem_util.hpp"
+#include "util/types.h"
+
+namespace palo {
+
+// Conversion done by OlapScanner before slot converters, every slot is
+// converted by its type for every row
+static void convert_by_slot_type(char* row,
+                                 const std::vector<SlotDescriptor*>& slots,
+                                 const std::vector<const Field*>& fields,
+                                 Tuple* tuple) {
+    for (int i = 0; i < slots.size(); ++i) {
+        SlotDescriptor* slot_desc = slots[i];
+        const Field* field = fields[i];
+        if (field->is_null(row)) {
+            tuple->set_null(slot_desc->null_indicator_offset());
+            continue;
+        }
+        char* ptr = (char*)field->get_ptr(row);
+        size_t len = field->size();
+        switch (slot_desc->type().type) {
+        case TYPE_CHAR: {
+            StringSlice* slice = reinterpret_cast<StringSlice*>(ptr);
+            StringValue *slot = tuple->get_string_slot(slot_desc->tuple_offset());
+            slot->ptr = slice->data;
+            slot->len = strnlen(slot->ptr, slice->size);
+            break;
+        }
+        case TYPE_VARCHAR:
+        case TYPE_HLL: {
+            StringSlice* slice = reinterpret_cast<StringSlice*>(ptr);
+            StringValue *slot = tuple->get_string_slot(slot_desc->tuple_offset());
+            slot->ptr = slice->data;
+            slot->len = slice->size;
+            break;
+        }
+        case TYPE_DECIMAL: {
+            DecimalValue *slot = tuple->get_decimal_slot(slot_desc->tuple_offset());
+            int64_t int_value = *(int64_t*)(ptr);
+            int32_t frac_value = *(int32_t*)(ptr + sizeof(int64_t));
+            *slot = DecimalValue(int_value, frac_value);
+            break;
+        }
+        case TYPE_DECIMALV2: {
+            PackedInt128* slot = reinterpret_cast<PackedInt128*>(
+                tuple->get_slot(slot_desc->tuple_offset()));
+            int64_t int_value = *(int64_t*)(ptr);
+            int32_t frac_value = *(int32_t*)(ptr + sizeof(int64_t));
+            *slot = DecimalV2Value::from_olap_decimal(int_value, frac_value).value();
+            break;
+        }
+        case TYPE_DATETIME: {
+            DateTimeValue *slot = tuple->get_datetime_slot(slot_desc->tuple_offset());
+            uint64_t value = *reinterpret_cast<uint64_t*>(ptr);
+            if (!slot->from_olap_datetime(value)) {
+                tuple->set_null(slot_desc->null_indicator_offset());
+            }
+            break;
+        }
+        case TYPE_DATE: {
+            DateTimeValue *slot = tuple->get_datetime_slot(slot_desc->tuple_offset());
+            uint64_t value = 0;
+            value = *(unsigned char*)(ptr + 2);
+            value <<= 8;
+            value |= *(unsigned char*)(ptr + 1);
+            value <<= 8;
+            value |= *(unsigned char*)(ptr);
+            if (!slot->from_olap_date(value)) {
+                tuple->set_null(slot_desc->null_indicator_offset());
+            }
+            break;
+        }
+        default: {
+            void *slot = tuple->get_slot(slot_desc->tuple_offset());
+            memory_copy(slot, ptr, len);
+            break;
+        }
+        }
+    }
+}
+
+class OlapTupleConverterTest : public testing::Test {
+public:
+    OlapTupleConverterTest() { }
+    virtual ~OlapTupleConverterTest() { }
+
+    void SetUp() override;
+
+protected:
+    // add a nullable column to both tuple and tablet schema
+    void add_column(TPrimitiveType::type slot_type, int slot_size,
+                    FieldType field_type, uint32_t field_length);
+    // set value of column 'cid' in row, value is null if 'value' is nullptr
+    void set_value(int cid, const void* value, size_t size);
+    // convert row in both ways and compare tuples
+    void check_convert();
+
+    ObjectPool _obj_pool;
+    TDescriptorTable _t_desc_table;
+    int _byte_size = 0;
+    std::vector<FieldInfo> _tablet_schema;
+
+    std::vector<SlotDescriptor*> _slots;
+    std::vector<const Field*> _fields;
+    RowCursor _row;
+    OlapTupleConverter _converter;
+};
+
+// slots are aligned to 16 bytes after 2 null indicator bytes
+void OlapTupleConverterTest::add_column(TPrimitiveType::type slot_type, int slot_size,
+                                        FieldType field_type, uint32_t field_length) {
+    int id = _t_desc_table.slotDescriptors.size();
+    if (_byte_size == 0) {
+        _byte_size = 16;
+    }
+
+    TSlotDescriptor slot_desc;
+    slot_desc.id = id;
+    slot_desc.parent = 0;
+    TTypeDesc type;
+    {
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(slot_type);
+        if (slot_type == TPrimitiveType::CHAR || slot_type == TPrimitiveType::VARCHAR) {
+            scalar_type.__set_len(field_length);
+        } else if (slot_type == TPrimitiveType::DECIMAL
+                || slot_type == TPrimitiveType::DECIMALV2) {
+            scalar_type.__set_precision(27);
+            scalar_type.__set_scale(9);
+        }
+        node.__set_scalar_type(scalar_type);
+        type.types.push_back(node);
+    }
+    slot_desc.slotType = type;
+    slot_desc.columnPos = id;
+    slot_desc.byteOffset = _byte_size;
+    slot_desc.nullIndicatorByte = id / 8;
+    slot_desc.nullIndicatorBit = id % 8;
+    slot_desc.colName = "c" + std::to_string(id);
+    slot_desc.slotIdx = id;
+    slot_desc.isMaterialized = true;
+    _t_desc_table.slotDescriptors.push_back(slot_desc);
+    _byte_size += (slot_size + 15) / 16 * 16;
+
+    FieldInfo field;
+    field.name = slot_desc.colName;
+    field.type = field_type;
+    field.length = field_length;
+    field.index_length = field_length;
+    field.precision = 27;
+    field.frac = 9;
+    field.is_key = true;
+    field.is_allow_null = true;
+    _tablet_schema.push_back(field);
+}
+
+void OlapTupleConverterTest::SetUp() {
+    add_column(TPrimitiveType::TINYINT, 1, OLAP_FIELD_TYPE_TINYINT, 1);
+    add_column(TPrimitiveType::SMALLINT, 2, OLAP_FIELD_TYPE_SMALLINT, 2);
+    add_column(TPrimitiveType::INT, 4, OLAP_FIELD_TYPE_INT, 4);
+    add_column(TPrimitiveType::BIGINT, 8, OLAP_FIELD_TYPE_BIGINT, 8);
+    add_column(TPrimitiveType::LARGEINT, 16, OLAP_FIELD_TYPE_LARGEINT, 16);
+    add_column(TPrimitiveType::DOUBLE, 8, OLAP_FIELD_TYPE_DOUBLE, 8);
+    add_column(TPrimitiveType::CHAR, sizeof(StringValue), OLAP_FIELD_TYPE_CHAR, 8);
+    add_column(TPrimitiveType::VARCHAR, sizeof(StringValue), OLAP_FIELD_TYPE_VARCHAR,
+               16 + OLAP_STRING_MAX_BYTES);
+    add_column(TPrimitiveType::DATE, sizeof(DateTimeValue), OLAP_FIELD_TYPE_DATE, 3);
+    add_column(TPrimitiveType::DATETIME, sizeof(DateTimeValue), OLAP_FIELD_TYPE_DATETIME, 8);
+    add_column(TPrimitiveType::DECIMAL, sizeof(DecimalValue), OLAP_FIELD_TYPE_DECIMAL, 12);
+    add_column(TPrimitiveType::DECIMALV2, sizeof(PackedInt128), OLAP_FIELD_TYPE_DECIMAL, 12);
+
+    TTupleDescriptor t_tuple_desc;
+    t_tuple_desc.id = 0;
+    t_tuple_desc.byteSize = _byte_size;
+    t_tuple_desc.numNullBytes = 2;
+    _t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+    _t_desc_table.__isset.slotDescriptors = true;
+
+    DescriptorTbl* desc_tbl = nullptr;
+    ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, _t_desc_table, &desc_tbl).ok());
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    ASSERT_TRUE(tuple_desc != nullptr);
+    _slots = tuple_desc->slots();
+    ASSERT_EQ(_tablet_schema.size(), _slots.size());
+
+    ASSERT_EQ(OLAP_SUCCESS, _row.init(_tablet_schema));
+    for (int i = 0; i < _tablet_schema.size(); ++i) {
+        _fields.push_back(_row.get_field_by_index(i));
+    }
+    _converter.init(_slots, _fields);
+}
+
+void OlapTupleConverterTest::set_value(int cid, const void* value, size_t size) {
+    char* ptr = _row.get_buf() + _fields[cid]->get_offset();
+    if (value == nullptr) {
+        *reinterpret_cast<bool*>(ptr) = true;
+        return;
+    }
+    *reinterpret_cast<bool*>(ptr) = false;
+    memcpy(ptr + 1, value, size);
+}
+
+void OlapTupleConverterTest::check_convert() {
+    std::vector<char> expected_buf(_byte_size, 0);
+    std::vector<char> actual_buf(_byte_size, 0);
+    Tuple* expected = reinterpret_cast<Tuple*>(expected_buf.data());
+    Tuple* actual = reinterpret_cast<Tuple*>(actual_buf.data());
+    convert_by_slot_type(_row.get_buf(), _slots, _fields, expected);
+    _converter.convert(_row.get_buf(), actual);
+
+    for (SlotDescriptor* slot : _slots) {
+        bool is_null = expected->is_null(slot->null_indicator_offset());
+        ASSERT_EQ(is_null, actual->is_null(slot->null_indicator_offset()))
+            << "slot=" << slot->col_name();
+        if (is_null) {
+            continue;
+        }
+        void* expected_slot = expected->get_slot(slot->tuple_offset());
+        void* actual_slot = actual->get_slot(slot->tuple_offset());
+        switch (slot->type().type) {
+        case TYPE_CHAR:
+        case TYPE_VARCHAR: {
+            StringValue* expected_value = reinterpret_cast<StringValue*>(expected_slot);
+            StringValue* actual_value = reinterpret_cast<StringValue*>(actual_slot);
+            ASSERT_EQ(expected_value->ptr, actual_value->ptr) << "slot=" << slot->col_name();
+            ASSERT_EQ(expected_value->len, actual_value->len) << "slot=" << slot->col_name();
+            break;
+        }
+        case TYPE_DECIMAL:
+            ASSERT_TRUE(*reinterpret_cast<DecimalValue*>(expected_slot)
+                        == *reinterpret_cast<DecimalValue*>(actual_slot))
+                << "slot=" << slot->col_name();
+            break;
+        case TYPE_DATE:
+        case TYPE_DATETIME:
+            ASSERT_TRUE(*reinterpret_cast<DateTimeValue*>(expected_slot)
+                        == *reinterpret_cast<DateTimeValue*>(actual_slot))
+                << "slot=" << slot->col_name();
+            break;
+        default:
+            ASSERT_EQ(0, memcmp(expected_slot, actual_slot, slot->slot_size()))
+                << "slot=" << slot->col_name();
+            break;
+        }
+    }
+}
+
+TEST_F(OlapTupleConverterTest, normal_values) {
+    int8_t tinyint_value = -12;
+    int16_t smallint_value = 1234;
+    int32_t int_value = -123456;
+    int64_t bigint_value = 1234567890123L;
+    __int128 largeint_value = static_cast<__int128>(bigint_value) * bigint_value;
+    double double_value = 3.25;
+    // char is padded with zero bytes
+    char char_buf[8] = {'a', 'b', 'c', 0, 0, 0, 0, 0};
+    StringSlice char_value(char_buf, sizeof(char_buf));
+    char varchar_buf[] = "varchar";
+    StringSlice varchar_value(varchar_buf, 7);
+    // 2018-06-19
+    uint32_t date_value = (2018 << 9) | (6 << 5) | 19;
+    uint64_t datetime_value = 20180619123456L;
+    decimal12_t decimal_value(-123, 456000000);
+
+    set_value(0, &tinyint_value, sizeof(tinyint_value));
+    set_value(1, &smallint_value, sizeof(smallint_value));
+    set_value(2, &int_value, sizeof(int_value));
+    set_value(3, &bigint_value, sizeof(bigint_value));
+    set_value(4, &largeint_value, sizeof(largeint_value));
+    set_value(5, &double_value, sizeof(double_value));
+    set_value(6, &char_value, sizeof(char_value));
+    set_value(7, &varchar_value, sizeof(varchar_value));
+    set_value(8, &date_value, 3);
+    set_value(9, &datetime_value, sizeof(datetime_value));
+    set_value(10, &decimal_value, 12);
+    set_value(11, &decimal_value, 12);
+    check_convert();
+
+    std::vector<char> tuple_buf(_byte_size, 0);
+    Tuple* tuple = reinterpret_cast<Tuple*>(tuple_buf.data());
+    _converter.convert(_row.get_buf(), tuple);
+    ASSERT_EQ(3, tuple->get_string_slot(_slots[6]->tuple_offset())->len);
+    ASSERT_EQ(7, tuple->get_string_slot(_slots[7]->tuple_offset())->len);
+    ASSERT_TRUE(DecimalValue(-123, 456000000)
+                == *tuple->get_decimal_slot(_slots[10]->tuple_offset()));
+
+    // char without padding uses the whole field
+    char full_char_buf[8] = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'};
+    StringSlice full_char_value(full_char_buf, sizeof(full_char_buf));
+    set_value(6, &full_char_value, sizeof(full_char_value));
+    check_convert();
+}
+
+TEST_F(OlapTupleConverterTest, null_values) {
+    for (int i = 0; i < _slots.size(); ++i) {
+        set_value(i, nullptr, 0);
+    }
+    check_convert();
+}
+
+TEST_F(OlapTupleConverterTest, invalid_date) {
+    for (int i = 0; i < _slots.size(); ++i) {
+        set_value(i, nullptr, 0);
+    }
+    // 2018-13-19 and 2018-06-32 25:00:00 are converted to null
+    uint32_t date_value = (2018 << 9) | (13 << 5) | 19;
+    uint64_t datetime_value = 20180632250000L;
+    set_value(8, &date_value, 3);
+    set_value(9, &datetime_value, sizeof(datetime_value));
+    check_convert();
+
+    std::vector<char> tuple_buf(_byte_size, 0);
+    Tuple* tuple = reinterpret_cast<Tuple*>(tuple_buf.data());
+    _converter.convert(_row.get_buf(), tuple);
+    ASSERT_TRUE(tuple->is_null(_slots[8]->null_indicator_offset()));
+    ASSERT_TRUE(tuple->is_null(_slots[9]->null_indicator_offset()));
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
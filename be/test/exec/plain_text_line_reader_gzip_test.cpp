@@ -19,6 +19,7 @@
 
 #include "exec/local_file_reader.h"
 #include "exec/decompressor.h"
+#include "exec/decompress_prefetch_reader.h"
 #include "util/runtime_profile.h"
 
 namespace palo {
@@ -225,6 +226,63 @@ TEST_F(PlainTextLineReaderTest, gzip_test_limit5) {
     ASSERT_TRUE(st.ok());
 }
 
+TEST_F(PlainTextLineReaderTest, gzip_prefetch_decompress) {
+    LocalFileReader file_reader(
+            "./be/test/exec/test_data/plain_text_line_reader/test_file.csv.gz", 0);
+    auto st = file_reader.open();
+    ASSERT_TRUE(st.ok());
+
+    Decompressor* decompressor;
+    st = Decompressor::create_decompressor(CompressType::GZIP, &decompressor);
+    ASSERT_TRUE(st.ok());
+
+    // decompress in background, line reader reads plain text
+    DecompressPrefetchReader prefetch_reader(&_profile, &file_reader, decompressor, 1024);
+    st = prefetch_reader.open();
+    ASSERT_TRUE(st.ok());
+
+    PlainTextLineReader line_reader(&_profile, &prefetch_reader, nullptr, -1, '\n');
+    const uint8_t* ptr;
+    size_t size;
+    bool eof;
+
+    // 1,2
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(3, size);
+    ASSERT_FALSE(eof);
+
+    // Empty
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(0, size);
+    ASSERT_FALSE(eof);
+
+    // 1,2,3,4
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(7, size);
+    ASSERT_FALSE(eof);
+
+    // Empty
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_FALSE(eof);
+
+    // Empty
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_FALSE(eof);
+
+    // Empty
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+
+    prefetch_reader.close();
+    delete decompressor;
+}
+
 } // end namespace palo
 
 int main(int argc, char** argv) {
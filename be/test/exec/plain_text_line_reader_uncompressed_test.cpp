@@ -235,6 +235,64 @@ TEST_F(PlainTextLineReaderTest, uncompressed_test_limit5) {
     ASSERT_TRUE(eof);
 }
 
+TEST_F(PlainTextLineReaderTest, uncompressed_field_pos) {
+    LocalFileReader file_reader("./be/test/exec/test_data/plain_text_line_reader/field_pos.csv", 0);
+    auto st = file_reader.open();
+    ASSERT_TRUE(st.ok());
+
+    Decompressor* decompressor;
+    st = Decompressor::create_decompressor(CompressType::UNCOMPRESSED, &decompressor);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(decompressor == nullptr);
+
+    PlainTextLineReader line_reader(&_profile, &file_reader, decompressor, -1, '\n');
+    ASSERT_TRUE(line_reader.field_separator_pos() == nullptr);
+    line_reader.set_field_separator(',');
+    const uint8_t* ptr;
+    size_t size;
+    bool eof;
+
+    // aaaaaaaaaaaaaaaaaaaa,bbbbbbbbbbbbbbbbb,c,d
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(42, size);
+    ASSERT_FALSE(eof);
+    const std::vector<size_t>* field_pos = line_reader.field_separator_pos();
+    ASSERT_TRUE(field_pos != nullptr);
+    ASSERT_EQ(std::vector<size_t>({20, 38, 40}), *field_pos);
+
+    // ,,,,,,,,,,,,,,,,,,
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(18, size);
+    ASSERT_EQ(18, field_pos->size());
+    for (size_t i = 0; i < field_pos->size(); ++i) {
+        ASSERT_EQ(i, (*field_pos)[i]);
+    }
+
+    // Empty
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(0, size);
+    ASSERT_TRUE(field_pos->empty());
+
+    // xyz
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(3, size);
+    ASSERT_TRUE(field_pos->empty());
+
+    // 12345678901234,6
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(16, size);
+    ASSERT_EQ(std::vector<size_t>({14}), *field_pos);
+
+    st = line_reader.read_line(&ptr, &size, &eof);
+    ASSERT_TRUE(st.ok());
+    ASSERT_TRUE(eof);
+}
+
 } // end namespace palo
 
 int main(int argc, char** argv) {
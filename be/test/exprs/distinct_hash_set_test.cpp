@@ -0,0 +1,93 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/distinct_hash_set.h"
+
+#include <math.h>
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include "runtime/string_value.hpp"
+#include "util/cpu_info.h"
+
+namespace palo {
+
+TEST(DistinctHashSetTest, insert) {
+    DistinctHashSet<int64_t, DistinctBytesHash<int64_t>, DistinctBytesEqual<int64_t> > set;
+    std::set<int64_t> expected;
+    for (int i = 0; i < 100000; ++i) {
+        int64_t value = (i * 7919L) % 30011;
+        ASSERT_EQ(expected.insert(value).second, set.insert(value));
+    }
+    ASSERT_EQ(expected.size(), set.size());
+
+    std::set<int64_t> actual;
+    set.for_each([&actual](int64_t value) { actual.insert(value); });
+    ASSERT_EQ(expected, actual);
+}
+
+TEST(DistinctHashSetTest, reserve) {
+    DistinctHashSet<int32_t, DistinctBytesHash<int32_t>, DistinctBytesEqual<int32_t> > set;
+    set.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(set.insert(i));
+    }
+    // reserve never shrinks
+    set.reserve(10);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(set.insert(i));
+    }
+    ASSERT_EQ(1000, set.size());
+}
+
+TEST(DistinctHashSetTest, double_bytes) {
+    DistinctHashSet<double, DistinctBytesHash<double>, DistinctBytesEqual<double> > set;
+    ASSERT_TRUE(set.insert(NAN));
+    ASSERT_FALSE(set.insert(NAN));
+    ASSERT_TRUE(set.insert(1.5));
+    ASSERT_EQ(2, set.size());
+}
+
+struct TestStringHash {
+    size_t operator()(const StringValue& value) const {
+        return hash_value(value);
+    }
+};
+
+TEST(DistinctHashSetTest, find_or_insert) {
+    DistinctHashSet<StringValue, TestStringHash> set;
+    std::string a = "abc";
+    std::string b = "abc";
+    bool inserted = false;
+    StringValue* element = set.find_or_insert(StringValue(a), hash_value(StringValue(a)),
+                                              &inserted);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(a.data(), element->ptr);
+
+    element = set.find_or_insert(StringValue(b), hash_value(StringValue(b)), &inserted);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(a.data(), element->ptr);
+    ASSERT_EQ(1, set.size());
+}
+
+}
+
+int main(int argc, char** argv) {
+    palo::CpuInfo::init();
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
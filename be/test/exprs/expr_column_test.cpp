@@ -0,0 +1,113 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/expr_column.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+namespace palo {
+
+class ExprColumnTest : public testing::Test {
+public:
+    ExprColumnTest() : _tracker(-1), _pool(&_tracker) {
+    }
+
+protected:
+    MemTracker _tracker;
+    MemPool _pool;
+};
+
+TEST_F(ExprColumnTest, set) {
+    ExprColumn column;
+    ASSERT_TRUE(column.init(TYPE_INT, 4, &_pool).ok());
+    ASSERT_EQ(TYPE_INT, column.type());
+    ASSERT_EQ(4, column.num_rows());
+    ASSERT_FALSE(column.has_nulls());
+
+    column.set(0, palo_udf::IntVal(10));
+    column.set(1, palo_udf::IntVal::null());
+    column.set(2, palo_udf::IntVal(-3));
+
+    ASSERT_TRUE(column.has_nulls());
+    ASSERT_FALSE(column.is_null(0));
+    ASSERT_TRUE(column.is_null(1));
+    ASSERT_FALSE(column.is_null(3));
+    ASSERT_EQ(10, column.data<int32_t>()[0]);
+    ASSERT_EQ(-3, *reinterpret_cast<const int32_t*>(column.get_value(2)));
+    ASSERT_TRUE(column.get_value(1) == NULL);
+    // values of null and unset rows are zero
+    ASSERT_EQ(0, column.data<int32_t>()[1]);
+    ASSERT_EQ(0, column.data<int32_t>()[3]);
+}
+
+TEST_F(ExprColumnTest, string) {
+    ExprColumn column;
+    ASSERT_TRUE(column.init(TYPE_VARCHAR, 2, &_pool).ok());
+    column.set(0, palo_udf::StringVal("abc"));
+    column.set(1, palo_udf::StringVal::null());
+    ASSERT_EQ(StringValue("abc"), column.data<StringValue>()[0]);
+    ASSERT_TRUE(column.is_null(1));
+    ASSERT_EQ(0, column.data<StringValue>()[1].len);
+}
+
+TEST_F(ExprColumnTest, fill) {
+    ExprColumn column;
+    ASSERT_TRUE(column.init(TYPE_BIGINT, 3, &_pool).ok());
+    int64_t value = 42;
+    column.fill(&value);
+    ASSERT_FALSE(column.has_nulls());
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(42, column.data<int64_t>()[i]);
+    }
+
+    ExprColumn nulls;
+    ASSERT_TRUE(nulls.init(TYPE_BIGINT, 3, &_pool).ok());
+    nulls.fill(NULL);
+    ASSERT_TRUE(nulls.has_nulls());
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(nulls.is_null(i));
+        ASSERT_EQ(0, nulls.data<int64_t>()[i]);
+    }
+}
+
+TEST_F(ExprColumnTest, scatter) {
+    ExprColumn src;
+    ASSERT_TRUE(src.init(TYPE_SMALLINT, 2, &_pool).ok());
+    src.set(0, palo_udf::SmallIntVal(7));
+    src.set(1, palo_udf::SmallIntVal::null());
+
+    ExprColumn dst;
+    ASSERT_TRUE(dst.init(TYPE_SMALLINT, 4, &_pool).ok());
+    dst.set(0, palo_udf::SmallIntVal(1));
+    int positions[] = {3, 2};
+    dst.scatter(src, positions);
+
+    ASSERT_TRUE(dst.has_nulls());
+    ASSERT_EQ(1, dst.data<int16_t>()[0]);
+    ASSERT_FALSE(dst.is_null(1));
+    ASSERT_TRUE(dst.is_null(2));
+    ASSERT_EQ(0, dst.data<int16_t>()[2]);
+    ASSERT_EQ(7, dst.data<int16_t>()[3]);
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,202 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/hll_agg_state.h"
+
+#include <string.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+using palo_udf::FunctionContext;
+using palo_udf::StringVal;
+
+class HllAggStateTest : public testing::Test {
+public:
+    HllAggStateTest() : _ctx(NULL), _seed(0) { }
+
+protected:
+    virtual void SetUp() {
+        _ctx = FunctionContext::create_test_context();
+        _seed = 0;
+    }
+
+    virtual void TearDown() {
+        delete _ctx;
+    }
+
+    // splitmix64
+    uint64_t next_hash() {
+        uint64_t z = (_seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::vector<uint64_t> make_hashes(int num) {
+        std::vector<uint64_t> hashes;
+        for (int i = 0; i < num; ++i) {
+            hashes.push_back(next_hash());
+        }
+        return hashes;
+    }
+
+    // registers of older versions
+    static void set_dense(const std::vector<uint64_t>& hashes, uint8_t* registers) {
+        for (uint64_t hash_value : hashes) {
+            int idx = hash_value % HLL_REGISTERS_COUNT;
+            uint8_t first_one_bit = __builtin_ctzl(hash_value >> HLL_COLUMN_PRECISION) + 1;
+            registers[idx] = std::max(registers[idx], first_one_bit);
+        }
+    }
+
+    static int64_t dense_estimate(const std::vector<uint64_t>& hashes) {
+        std::vector<uint8_t> registers(HLL_REGISTERS_COUNT, 0);
+        set_dense(hashes, &registers[0]);
+        return HllAggState::estimate(StringVal(&registers[0], HLL_REGISTERS_COUNT));
+    }
+
+    StringVal make_state(const std::vector<uint64_t>& hashes) {
+        StringVal state;
+        HllAggState::init(_ctx, &state);
+        for (uint64_t hash_value : hashes) {
+            HllAggState::update(_ctx, hash_value, &state);
+        }
+        return state;
+    }
+
+    FunctionContext* _ctx;
+    uint64_t _seed;
+};
+
+TEST_F(HllAggStateTest, promote) {
+    StringVal state;
+    HllAggState::init(_ctx, &state);
+    ASSERT_EQ(1, state.len);
+    ASSERT_EQ(HLL_DATA_EMPTY, state.ptr[0]);
+    ASSERT_EQ(0, HllAggState::estimate(state));
+
+    std::vector<uint64_t> hashes = make_hashes(HLL_EXPLICLIT_INT64_NUM);
+    for (uint64_t hash_value : hashes) {
+        HllAggState::update(_ctx, hash_value, &state);
+        HllAggState::update(_ctx, hash_value, &state);
+    }
+    ASSERT_EQ(HLL_DATA_EXPLICIT, state.ptr[0]);
+    ASSERT_EQ(2 + HLL_EXPLICLIT_INT64_NUM * 8, state.len);
+    ASSERT_EQ(dense_estimate(hashes), HllAggState::estimate(state));
+
+    hashes.push_back(next_hash());
+    HllAggState::update(_ctx, hashes.back(), &state);
+    ASSERT_EQ(HLL_DATA_SPRASE, state.ptr[0]);
+    ASSERT_EQ(dense_estimate(hashes), HllAggState::estimate(state));
+
+    while (hashes.size() < 1000) {
+        hashes.push_back(next_hash());
+        HllAggState::update(_ctx, hashes.back(), &state);
+    }
+    ASSERT_EQ(HLL_DATA_SPRASE, state.ptr[0]);
+    ASSERT_EQ(dense_estimate(hashes), HllAggState::estimate(state));
+
+    while (hashes.size() < 2000) {
+        hashes.push_back(next_hash());
+        HllAggState::update(_ctx, hashes.back(), &state);
+    }
+    ASSERT_EQ(HLL_DATA_FULL, state.ptr[0]);
+    ASSERT_EQ(1 + HLL_REGISTERS_COUNT, state.len);
+    ASSERT_EQ(dense_estimate(hashes), HllAggState::estimate(state));
+
+    _ctx->free(state.ptr);
+}
+
+TEST_F(HllAggStateTest, accuracy) {
+    std::vector<uint64_t> hashes = make_hashes(1000000);
+    StringVal state = make_state(hashes);
+    int64_t estimate = HllAggState::estimate(state);
+    ASSERT_EQ(dense_estimate(hashes), estimate);
+    ASSERT_LT(std::abs(estimate - 1000000), 1000000 * 0.03);
+    _ctx->free(state.ptr);
+}
+
+TEST_F(HllAggStateTest, merge) {
+    // explicit, sparse and full
+    const int sizes[] = {0, 10, 100, 500, 5000};
+    for (int dst_size : sizes) {
+        for (int src_size : sizes) {
+            std::vector<uint64_t> dst_hashes = make_hashes(dst_size);
+            std::vector<uint64_t> src_hashes = make_hashes(src_size);
+            // half of src are in dst
+            for (int i = 0; i < src_size / 2 && i < dst_size; ++i) {
+                src_hashes[i] = dst_hashes[i];
+            }
+            StringVal dst = make_state(dst_hashes);
+            StringVal src = make_state(src_hashes);
+            HllAggState::merge(_ctx, src, &dst);
+
+            std::vector<uint64_t> all_hashes = dst_hashes;
+            all_hashes.insert(all_hashes.end(), src_hashes.begin(), src_hashes.end());
+            ASSERT_EQ(dense_estimate(all_hashes), HllAggState::estimate(dst))
+                << "dst_size=" << dst_size << " src_size=" << src_size;
+            _ctx->free(src.ptr);
+            _ctx->free(dst.ptr);
+        }
+    }
+}
+
+TEST_F(HllAggStateTest, merge_stored) {
+    std::vector<uint64_t> hashes = make_hashes(600);
+    std::set<uint64_t> hash_set(hashes.begin(), hashes.begin() + 100);
+    std::map<int, uint8_t> index_to_value;
+    std::vector<uint8_t> registers(HLL_REGISTERS_COUNT, 0);
+    set_dense(std::vector<uint64_t>(hashes.begin() + 100, hashes.begin() + 300),
+              &registers[0]);
+    for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
+        if (registers[i] != 0) {
+            index_to_value[i] = registers[i];
+        }
+    }
+
+    char buf[HLL_COLUMN_DEFAULT_LEN];
+    int len = 0;
+    StringVal dst;
+    HllAggState::init(_ctx, &dst);
+    HllSetHelper::set_expliclit(buf, hash_set, len);
+    HllAggState::merge(_ctx, StringVal((uint8_t*)buf, len), &dst);
+    HllSetHelper::set_sparse(buf, index_to_value, len);
+    HllAggState::merge(_ctx, StringVal((uint8_t*)buf, len), &dst);
+    ASSERT_EQ(HLL_DATA_SPRASE, dst.ptr[0]);
+    ASSERT_EQ(dense_estimate(std::vector<uint64_t>(hashes.begin(), hashes.begin() + 300)),
+              HllAggState::estimate(dst));
+
+    // registers of older versions
+    memset(&registers[0], 0, HLL_REGISTERS_COUNT);
+    set_dense(std::vector<uint64_t>(hashes.begin() + 300, hashes.end()), &registers[0]);
+    HllAggState::merge(_ctx, StringVal(&registers[0], HLL_REGISTERS_COUNT), &dst);
+    ASSERT_EQ(HLL_DATA_FULL, dst.ptr[0]);
+    ASSERT_EQ(dense_estimate(hashes), HllAggState::estimate(dst));
+
+    _ctx->free(dst.ptr);
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
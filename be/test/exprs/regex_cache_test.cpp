@@ -0,0 +1,120 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "exprs/regex_cache.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "util/cpu_info.h"
+
+namespace palo {
+
+TEST(RegexCacheTest, required_literal) {
+    ASSERT_EQ("abc", RegexCache::required_literal("abc"));
+    ASSERT_EQ("abc", RegexCache::required_literal(".*abc.*"));
+    ASSERT_EQ("hello", RegexCache::required_literal("^a.*hello\\d+x$"));
+    ASSERT_EQ("abc", RegexCache::required_literal("abcd?e"));
+    ASSERT_EQ("abc", RegexCache::required_literal("ab(x|y)*abc[0-9]{2,3}"));
+    ASSERT_EQ("a.b", RegexCache::required_literal("a\\.b+"));
+    ASSERT_EQ("xy", RegexCache::required_literal("[]xyz]+xy(ab)?"));
+    // optional multi-byte character is removed as a whole
+    ASSERT_EQ("ab", RegexCache::required_literal("ab\xe4\xb8\xad*"));
+    ASSERT_EQ("", RegexCache::required_literal("abc|def"));
+    ASSERT_EQ("", RegexCache::required_literal("(?i)abc"));
+    ASSERT_EQ("", RegexCache::required_literal("\\x41bc"));
+    ASSERT_EQ("", RegexCache::required_literal(".*"));
+}
+
+TEST(RegexCacheTest, get) {
+    RegexCache cache(2);
+    re2::RE2::Options options;
+    std::string error;
+    CachedRegexPtr re1 = cache.get("a+bc", options, &error);
+    ASSERT_TRUE(re1 != NULL);
+    ASSERT_EQ("bc", re1->literal());
+    ASSERT_EQ(re1.get(), cache.get("a+bc", options, &error).get());
+
+    // different options
+    options.set_case_sensitive(false);
+    CachedRegexPtr re2 = cache.get("a+bc", options, &error);
+    ASSERT_TRUE(re2 != NULL);
+    ASSERT_NE(re1.get(), re2.get());
+    ASSERT_EQ("", re2->literal());
+    ASSERT_TRUE(re2->partial_match("xxABC", 5));
+    ASSERT_EQ(2, cache.size());
+
+    // oldest is evicted, but still usable by holder
+    options.set_case_sensitive(true);
+    ASSERT_TRUE(cache.get("x", options, &error) != NULL);
+    ASSERT_EQ(2, cache.size());
+    ASSERT_NE(re1.get(), cache.get("a+bc", options, &error).get());
+    ASSERT_TRUE(re1->full_match("aabc", 4));
+
+    // invalid pattern is not cached
+    ASSERT_TRUE(cache.get("a(b", options, &error) == NULL);
+    ASSERT_FALSE(error.empty());
+    ASSERT_EQ(2, cache.size());
+}
+
+TEST(RegexCacheTest, match) {
+    RegexCache cache(16);
+    re2::RE2::Options options;
+    std::string error;
+    CachedRegexPtr re = cache.get(".*hello.*world", options, &error);
+    ASSERT_TRUE(re != NULL);
+    ASSERT_EQ("hello", re->literal());
+
+    std::string str = "say hello to the whole world";
+    ASSERT_TRUE(re->may_match(str.data(), str.size()));
+    ASSERT_TRUE(re->full_match(str.data(), str.size()));
+    str = "say hell to the world";
+    ASSERT_FALSE(re->may_match(str.data(), str.size()));
+    ASSERT_FALSE(re->full_match(str.data(), str.size()));
+    // literal is there but regex doesn't match
+    str = "world hello";
+    ASSERT_TRUE(re->may_match(str.data(), str.size()));
+    ASSERT_FALSE(re->partial_match(str.data(), str.size()));
+}
+
+TEST(RegexCacheTest, literal_search) {
+    // literal at every position of strings longer and shorter than 16 bytes,
+    // across boundary of 16 bytes
+    std::string literal = "abcdefghij";
+    RegexCache cache(16);
+    re2::RE2::Options options;
+    std::string error;
+    CachedRegexPtr re = cache.get(literal, options, &error);
+    ASSERT_TRUE(re != NULL);
+    for (int len = 0; len < 50; ++len) {
+        for (int pos = 0; pos + (int)literal.size() <= len; ++pos) {
+            std::string str(len, 'a');
+            str.replace(pos, literal.size(), literal);
+            ASSERT_TRUE(re->may_match(str.data(), str.size())) << len << " " << pos;
+            // last byte is different
+            str[pos + literal.size() - 1] = 'x';
+            ASSERT_FALSE(re->may_match(str.data(), str.size())) << len << " " << pos;
+        }
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    palo::CpuInfo::init();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,254 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/simd_string_util.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "util/cpu_info.h"
+#include "util/stopwatch.hpp"
+
+namespace palo {
+
+// Byte by byte implementations, which are what string builtins did before
+static void scalar_lower(const uint8_t* src, int len, uint8_t* dst) {
+    for (int i = 0; i < len; ++i) {
+        dst[i] = ::tolower(src[i]);
+    }
+}
+
+static void scalar_upper(const uint8_t* src, int len, uint8_t* dst) {
+    for (int i = 0; i < len; ++i) {
+        dst[i] = ::toupper(src[i]);
+    }
+}
+
+static int scalar_first_not_space(const uint8_t* str, int len) {
+    int i = 0;
+    while (i < len && str[i] == ' ') {
+        ++i;
+    }
+    return i;
+}
+
+static int scalar_last_not_space(const uint8_t* str, int len) {
+    int i = len - 1;
+    while (i >= 0 && str[i] == ' ') {
+        --i;
+    }
+    return i;
+}
+
+static int scalar_utf8_length(const uint8_t* str, int len) {
+    int count = 0;
+    for (int i = 0; i < len; ++i) {
+        if ((str[i] & 0xC0) != 0x80) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+static void scalar_reverse(const uint8_t* src, int len, uint8_t* dst) {
+    std::reverse_copy(src, src + len, dst);
+}
+
+class StringFunctionsSimdTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        srand(0);
+    }
+
+    // Random string of 'len' bytes, mixed with spaces, ASCII letters and
+    // multi-byte UTF-8 characters
+    std::string random_string(int len) {
+        static const char* const pieces[] = {
+            " ", " ", "a", "Z", "m", "@", "[", "`", "{", "0", "\xe4\xb8\xad", "\xc3\xa9"
+        };
+        std::string str;
+        while (str.size() < len) {
+            str.append(pieces[rand() % (sizeof(pieces) / sizeof(pieces[0]))]);
+        }
+        str.resize(len);
+        return str;
+    }
+
+    const uint8_t* bytes(const std::string& str) {
+        return reinterpret_cast<const uint8_t*>(str.data());
+    }
+};
+
+TEST_F(StringFunctionsSimdTest, case_conversion) {
+    for (int len = 0; len < 100; ++len) {
+        std::string str = random_string(len);
+        // all bytes
+        if (len == 99) {
+            str.resize(256);
+            for (int i = 0; i < 256; ++i) {
+                str[i] = i;
+            }
+            len = 256;
+        }
+        std::vector<uint8_t> expected(len + 1);
+        std::vector<uint8_t> actual(len + 1);
+        scalar_lower(bytes(str), len, &expected[0]);
+        SimdStringUtil::to_lower(bytes(str), len, &actual[0]);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + len, actual.begin()));
+        scalar_upper(bytes(str), len, &expected[0]);
+        SimdStringUtil::to_upper(bytes(str), len, &actual[0]);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + len, actual.begin()));
+    }
+}
+
+TEST_F(StringFunctionsSimdTest, trim) {
+    for (int len = 0; len < 80; ++len) {
+        for (int i = 0; i < 20; ++i) {
+            std::string str = random_string(len);
+            // long runs of spaces at both ends
+            int begin = rand() % (len + 1);
+            int end = begin + rand() % (len - begin + 1);
+            for (int j = 0; j < begin; ++j) {
+                str[j] = ' ';
+            }
+            for (int j = end; j < len; ++j) {
+                str[j] = ' ';
+            }
+            ASSERT_EQ(scalar_first_not_space(bytes(str), len),
+                      SimdStringUtil::find_first_not_space(bytes(str), len));
+            ASSERT_EQ(scalar_last_not_space(bytes(str), len),
+                      SimdStringUtil::find_last_not_space(bytes(str), len));
+        }
+    }
+}
+
+TEST_F(StringFunctionsSimdTest, utf8_length) {
+    ASSERT_EQ(0, SimdStringUtil::utf8_length(bytes(""), 0));
+    std::string str = "\xe4\xb8\xad\xe6\x96\x87" "abc" "\xc3\xa9";
+    ASSERT_EQ(6, SimdStringUtil::utf8_length(bytes(str), str.size()));
+    for (int len = 0; len < 100; ++len) {
+        std::string str = random_string(len);
+        ASSERT_EQ(scalar_utf8_length(bytes(str), len),
+                  SimdStringUtil::utf8_length(bytes(str), len));
+    }
+}
+
+TEST_F(StringFunctionsSimdTest, reverse) {
+    for (int len = 0; len < 100; ++len) {
+        std::string str = random_string(len);
+        std::vector<uint8_t> expected(len + 1);
+        std::vector<uint8_t> actual(len + 1);
+        scalar_reverse(bytes(str), len, &expected[0]);
+        SimdStringUtil::reverse(bytes(str), len, &actual[0]);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + len, actual.begin()));
+    }
+}
+
+// Micro benchmarks of kernels against byte by byte loops on rows of typical
+// lengths. Only time is reported, so they are disabled, run them with
+// --gtest_also_run_disabled_tests.
+class StringFunctionsBenchmark : public StringFunctionsSimdTest {
+protected:
+    static const int NUM_ROWS = 100000;
+    static const int NUM_ROUNDS = 10;
+
+    virtual void SetUp() {
+        StringFunctionsSimdTest::SetUp();
+        for (int i = 0; i < NUM_ROWS; ++i) {
+            // 8 to 72 bytes, with 0 to 8 spaces at both ends
+            std::string str = random_string(8 + rand() % 64);
+            _rows.push_back(std::string(rand() % 8, ' ') + str + std::string(rand() % 8, ' '));
+        }
+        _buffer.resize(256);
+    }
+
+    template <typename Fn>
+    uint64_t run(Fn fn) {
+        MonotonicStopWatch watch;
+        watch.start();
+        for (int round = 0; round < NUM_ROUNDS; ++round) {
+            for (const std::string& row : _rows) {
+                fn(bytes(row), row.size());
+            }
+        }
+        watch.stop();
+        return watch.elapsed_time();
+    }
+
+    void report(const std::string& name, uint64_t scalar_ns, uint64_t simd_ns) {
+        std::cout << name << ": scalar " << scalar_ns / NUM_ROUNDS / 1000
+            << "us, simd " << simd_ns / NUM_ROUNDS / 1000
+            << "us per " << NUM_ROWS << " rows" << std::endl;
+    }
+
+    std::vector<std::string> _rows;
+    std::vector<uint8_t> _buffer;
+    // sum of results, so that calls are not optimized out
+    int64_t _sum = 0;
+};
+
+TEST_F(StringFunctionsBenchmark, DISABLED_lower) {
+    uint8_t* dst = &_buffer[0];
+    uint64_t scalar_ns = run([dst](const uint8_t* s, int len) { scalar_lower(s, len, dst); });
+    uint64_t simd_ns = run([dst](const uint8_t* s, int len) {
+        SimdStringUtil::to_lower(s, len, dst);
+    });
+    report("lower", scalar_ns, simd_ns);
+}
+
+TEST_F(StringFunctionsBenchmark, DISABLED_trim) {
+    uint64_t scalar_ns = run([this](const uint8_t* s, int len) {
+        _sum += scalar_first_not_space(s, len) + scalar_last_not_space(s, len);
+    });
+    uint64_t simd_ns = run([this](const uint8_t* s, int len) {
+        _sum += SimdStringUtil::find_first_not_space(s, len)
+            + SimdStringUtil::find_last_not_space(s, len);
+    });
+    report("trim", scalar_ns, simd_ns);
+}
+
+TEST_F(StringFunctionsBenchmark, DISABLED_char_length) {
+    uint64_t scalar_ns = run([this](const uint8_t* s, int len) {
+        _sum += scalar_utf8_length(s, len);
+    });
+    uint64_t simd_ns = run([this](const uint8_t* s, int len) {
+        _sum += SimdStringUtil::utf8_length(s, len);
+    });
+    report("char_length", scalar_ns, simd_ns);
+}
+
+TEST_F(StringFunctionsBenchmark, DISABLED_reverse) {
+    uint8_t* dst = &_buffer[0];
+    uint64_t scalar_ns = run([dst](const uint8_t* s, int len) { scalar_reverse(s, len, dst); });
+    uint64_t simd_ns = run([dst](const uint8_t* s, int len) {
+        SimdStringUtil::reverse(s, len, dst);
+    });
+    report("reverse", scalar_ns, simd_ns);
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    palo::CpuInfo::init();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/download_action.h"
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+TEST(DownloadActionTest, parse_range) {
+    int64_t offset = 0;
+    int64_t length = 0;
+    ASSERT_TRUE(DownloadAction::parse_range("bytes=0-99", 1000, &offset, &length));
+    ASSERT_EQ(0, offset);
+    ASSERT_EQ(100, length);
+
+    ASSERT_TRUE(DownloadAction::parse_range("bytes=900-", 1000, &offset, &length));
+    ASSERT_EQ(900, offset);
+    ASSERT_EQ(100, length);
+
+    ASSERT_TRUE(DownloadAction::parse_range("bytes=-100", 1000, &offset, &length));
+    ASSERT_EQ(900, offset);
+    ASSERT_EQ(100, length);
+
+    // end is truncated to file size
+    ASSERT_TRUE(DownloadAction::parse_range("bytes=500-2000", 1000, &offset, &length));
+    ASSERT_EQ(500, offset);
+    ASSERT_EQ(500, length);
+}
+
+TEST(DownloadActionTest, parse_invalid_range) {
+    int64_t offset = 0;
+    int64_t length = 0;
+    ASSERT_FALSE(DownloadAction::parse_range("0-99", 1000, &offset, &length));
+    ASSERT_FALSE(DownloadAction::parse_range("bytes=1000-", 1000, &offset, &length));
+    ASSERT_FALSE(DownloadAction::parse_range("bytes=100-50", 1000, &offset, &length));
+    ASSERT_FALSE(DownloadAction::parse_range("bytes=0-9,20-29", 1000, &offset, &length));
+    ASSERT_FALSE(DownloadAction::parse_range("bytes=a-b", 1000, &offset, &length));
+    ASSERT_FALSE(DownloadAction::parse_range("bytes=-", 1000, &offset, &length));
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
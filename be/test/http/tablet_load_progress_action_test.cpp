@@ -0,0 +1,86 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "http/action/tablet_load_progress_action.h"
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "olap/olap_engine.h"
+
+namespace palo {
+
+class TabletLoadProgressActionTest : public testing::Test {
+public:
+    TabletLoadProgressActionTest() { }
+    virtual ~TabletLoadProgressActionTest() { }
+};
+
+TEST_F(TabletLoadProgressActionTest, to_json) {
+    std::vector<TabletLoadProgress> progress(2);
+    // special characters in path are escaped
+    progress[0].root_path = "/home/\"disk\\1\"";
+    progress[0].num_tablets = 10;
+    progress[0].num_loaded = 8;
+    progress[0].num_failed = 2;
+    progress[0].start_time = 100;
+    progress[0].finish_time = 105;
+    progress[1].root_path = "/home/disk2";
+    progress[1].num_tablets = 20;
+    progress[1].num_loaded = 5;
+    progress[1].start_time = 100;
+
+    std::string json = TabletLoadProgressAction::to_json(progress, 30, 3, 110);
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    ASSERT_FALSE(document.HasParseError()) << json;
+
+    const rapidjson::Value& root_paths = document["root_paths"];
+    ASSERT_TRUE(root_paths.IsArray());
+    ASSERT_EQ(2, root_paths.Size());
+    ASSERT_STREQ("/home/\"disk\\1\"", root_paths[0]["path"].GetString());
+    ASSERT_EQ(10, root_paths[0]["tablets"].GetInt64());
+    ASSERT_EQ(8, root_paths[0]["loaded"].GetInt64());
+    ASSERT_EQ(2, root_paths[0]["failed"].GetInt64());
+    ASSERT_TRUE(root_paths[0]["finished"].GetBool());
+    ASSERT_EQ(5, root_paths[0]["cost_seconds"].GetInt64());
+    ASSERT_STREQ("/home/disk2", root_paths[1]["path"].GetString());
+    ASSERT_FALSE(root_paths[1]["finished"].GetBool());
+    ASSERT_EQ(10, root_paths[1]["cost_seconds"].GetInt64());
+
+    ASSERT_STREQ("LOADING", document["status"].GetString());
+    ASSERT_EQ(30, document["tables"].GetInt64());
+    ASSERT_EQ(3, document["data_loaded_tables"].GetInt64());
+}
+
+TEST_F(TabletLoadProgressActionTest, finished) {
+    std::vector<TabletLoadProgress> progress(1);
+    progress[0].root_path = "/home/disk1";
+    progress[0].start_time = 100;
+    progress[0].finish_time = 101;
+
+    std::string json = TabletLoadProgressAction::to_json(progress, 0, 0, 110);
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    ASSERT_FALSE(document.HasParseError()) << json;
+    ASSERT_STREQ("FINISHED", document["status"].GetString());
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -54,7 +54,7 @@ public:
         ASSERT_EQ(OLAP_SUCCESS, _helper.open_with_mode("tmp_file", 
                 O_CREAT | O_EXCL | O_WRONLY, 
                 S_IRUSR | S_IWUSR));
-        _out_stream->write_to_file(&_helper, 0);
+        _out_stream->write_to_file(&_helper);
         _helper.close();
 
         ASSERT_EQ(OLAP_SUCCESS, _helper.open_with_mode("tmp_file", 
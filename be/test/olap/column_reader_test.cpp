@@ -169,7 +169,7 @@ public:
             
             ASSERT_TRUE(buffers != NULL);
             off.push_back(helper.tell());
-            out_stream->write_to_file(&helper, 0);
+            out_stream->write_to_file(&helper);
             length.push_back(out_stream->get_stream_length());
             buffer_size.push_back(out_stream->get_total_buffer_size());
             name.push_back(stream_name);
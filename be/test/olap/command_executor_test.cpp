@@ -28,12 +28,18 @@
 #include <gtest/gtest.h>
 
 #include "olap/command_executor.h"
+#include "olap/compaction_merger.h"
 #include "olap/field.h"
 #include "olap/olap_engine.h"
+#include "olap/olap_index.h"
 #include "olap/olap_main.cpp"
+#include "olap/merger.h"
 #include "olap/olap_table.h"
+#include "olap/reader.h"
+#include "olap/schema_change.h"
 #include "olap/utils.h"
 #include "util/logging.h"
+#include "util/palo_metrics.h"
 
 using std::nothrow;
 using std::stringstream;
@@ -791,6 +797,116 @@ TEST_F(TestPush, column_push) {
     ASSERT_EQ(BASE_TABLE_PUSH_DATA_BIG_ROW_COUNT, tablets_info[0].row_count);
 }
 
+TEST_F(TestPush, mem_index_pin_and_evict) {
+    OLAPStatus res = OLAP_SUCCESS;
+    TCreateTabletReq request;
+    set_default_create_tablet_request(&request);
+    request.tablet_id += 2;
+    request.tablet_schema.schema_hash += 2;
+    res = _command_executor->create_table(request);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    SmartOLAPTable tablet = _command_executor->get_table(
+            request.tablet_id, request.tablet_schema.schema_hash);
+    ASSERT_TRUE(tablet.get() != NULL);
+
+    TPushReq push_req;
+    set_default_push_request(request, &push_req);
+    push_req.tablet_id = request.tablet_id;
+    push_req.schema_hash = request.tablet_schema.schema_hash;
+    std::vector<TTabletInfo> tablets_info;
+    res = _command_executor->push(push_req, &tablets_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    std::vector<Version> versions(1, Version(push_req.version, push_req.version));
+    std::vector<IData*> olap_data_arr;
+    tablet->obtain_header_rdlock();
+    tablet->acquire_data_sources_by_versions(versions, &olap_data_arr);
+    tablet->release_header_lock();
+    ASSERT_EQ(1, olap_data_arr.size());
+    OLAPIndex* olap_index = olap_data_arr[0]->olap_index();
+    Cache* cache = OLAPEngine::get_instance()->mem_index_lru_cache();
+    cache->prune();
+
+    // entries are loaded once on first pin and shared by later pins
+    int64_t load_total = PaloMetrics::mem_index_load_total.value();
+    const MemIndex* mem_index = NULL;
+    {
+        MemIndexPin pin(olap_index);
+        ASSERT_EQ(OLAP_SUCCESS, pin.status());
+        ASSERT_TRUE(pin.mem_index() != NULL);
+        ASSERT_EQ(olap_index->num_index_entries(), pin.mem_index()->count());
+        ASSERT_EQ(load_total + 1, PaloMetrics::mem_index_load_total.value());
+        mem_index = pin.mem_index();
+
+        MemIndexPin other_pin(olap_index);
+        ASSERT_EQ(OLAP_SUCCESS, other_pin.status());
+        ASSERT_EQ(mem_index, other_pin.mem_index());
+        ASSERT_EQ(load_total + 1, PaloMetrics::mem_index_load_total.value());
+
+        // pinned entries are not evicted
+        cache->prune();
+        MemIndexPin pin_after_prune(olap_index);
+        ASSERT_EQ(mem_index, pin_after_prune.mem_index());
+        ASSERT_EQ(load_total + 1, PaloMetrics::mem_index_load_total.value());
+    }
+
+    // unpinned entries are evicted and loaded again when they're used
+    cache->prune();
+    RowBlockPosition pos;
+    ASSERT_EQ(OLAP_SUCCESS, olap_index->find_first_row_block(&pos));
+    ASSERT_EQ(load_total + 2, PaloMetrics::mem_index_load_total.value());
+    ASSERT_EQ(0, pos.segment);
+
+    tablet->release_data_sources(&olap_data_arr);
+    tablet.reset();
+    OLAPEngine::get_instance()->drop_table(
+            request.tablet_id, request.tablet_schema.schema_hash);
+}
+
+TEST_F(TestPush, push_by_memtable) {
+    OLAPStatus res = OLAP_SUCCESS;
+    TCreateTabletReq request;
+    set_default_create_tablet_request(&request);
+    request.tablet_id += 2;
+    request.tablet_schema.schema_hash += 2;
+    std::vector<uint32_t> checksums;
+    for (int i = 0; i < 2; ++i) {
+        request.tablet_id += 1;
+        request.tablet_schema.schema_hash += 1;
+        res = _command_executor->create_table(request);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+
+        TPushReq push_req;
+        set_default_push_request(request, &push_req);
+        push_req.tablet_id = request.tablet_id;
+        push_req.schema_hash = request.tablet_schema.schema_hash;
+        std::vector<TTabletInfo> tablets_info;
+        // second tablet sorts rows in memory, with a small buffer so
+        // that rows are flushed into several runs and merged
+        bool enable_push_memtable = config::enable_push_memtable;
+        int64_t write_buffer_size = config::write_buffer_size;
+        config::enable_push_memtable = (i == 1);
+        config::write_buffer_size = 4096;
+        res = _command_executor->push(push_req, &tablets_info);
+        config::enable_push_memtable = enable_push_memtable;
+        config::write_buffer_size = write_buffer_size;
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        ASSERT_EQ(1, tablets_info.size());
+
+        uint32_t checksum = 0;
+        res = _command_executor->compute_checksum(
+                push_req.tablet_id, push_req.schema_hash,
+                push_req.version, push_req.version_hash, &checksum);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        checksums.push_back(checksum);
+
+        OLAPEngine::get_instance()->drop_table(
+                request.tablet_id, request.tablet_schema.schema_hash);
+    }
+    // data read from both tablets is the same
+    ASSERT_EQ(checksums[0], checksums[1]);
+}
+
 class TestComputeChecksum : public ::testing::Test {
 public:
     TestComputeChecksum() : _command_executor(NULL) {}
@@ -920,6 +1036,154 @@ TEST_F(TestBaseCompaction, TestBaseCompaction) {
     ASSERT_EQ(OLAP_ERR_BE_NO_SUITABLE_VERSION, res);
 }
 
+// Merge data sources of given versions into a new index, then read all rows of it
+void merge_and_read_rows(SmartOLAPTable tablet,
+                         const std::vector<Version>& versions,
+                         ReaderType reader_type,
+                         VersionHash version_hash,
+                         bool use_compaction_merger,
+                         std::vector<std::string>* rows,
+                         uint64_t* row_count,
+                         uint64_t* merged_rows,
+                         uint64_t* filted_rows) {
+    std::vector<IData*> olap_data_arr;
+    tablet->obtain_header_rdlock();
+    tablet->acquire_data_sources_by_versions(versions, &olap_data_arr);
+    tablet->release_header_lock();
+    ASSERT_EQ(versions.size(), olap_data_arr.size());
+    ASSERT_TRUE(CompactionMerger::is_supported(tablet, olap_data_arr));
+
+    bool enable_compaction_merger = config::enable_compaction_merger;
+    config::enable_compaction_merger = use_compaction_merger;
+    Version version(versions.front().first, versions.back().second);
+    OLAPIndex* index = new OLAPIndex(tablet.get(), version, version_hash, false, 0, 0);
+    Merger merger(tablet, index, reader_type);
+    OLAPStatus res = merger.merge(olap_data_arr, false, merged_rows, filted_rows);
+    config::enable_compaction_merger = enable_compaction_merger;
+    tablet->release_data_sources(&olap_data_arr);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    *row_count = merger.row_count();
+    ASSERT_EQ(OLAP_SUCCESS, index->load());
+
+    IData* olap_data = IData::create(index);
+    ASSERT_TRUE(olap_data != NULL);
+    ASSERT_EQ(OLAP_SUCCESS, olap_data->init());
+    {
+        Reader reader;
+        ReaderParams reader_params;
+        reader_params.olap_table = tablet;
+        reader_params.reader_type = READER_ALTER_TABLE;
+        reader_params.olap_data_arr.push_back(olap_data);
+        ASSERT_EQ(OLAP_SUCCESS, reader.init(reader_params));
+
+        RowCursor row;
+        ASSERT_EQ(OLAP_SUCCESS, row.init(tablet->tablet_schema()));
+        bool eof = false;
+        while (true) {
+            ASSERT_EQ(OLAP_SUCCESS, reader.next_row_with_aggregation(&row, &eof));
+            if (eof) {
+                break;
+            }
+            rows->push_back(row.to_string());
+        }
+    }
+    SAFE_DELETE(olap_data);
+    index->delete_all_files();
+    SAFE_DELETE(index);
+}
+
+TEST_F(TestBaseCompaction, compaction_merger_same_as_reader) {
+    OLAPStatus res = OLAP_SUCCESS;
+    TCreateTabletReq request;
+    set_default_create_tablet_request(&request);
+    // small row blocks, so that rows of one key span several merging batches
+    int32_t num_rows_per_data_block = config::default_num_rows_per_data_block;
+    config::default_num_rows_per_data_block = 16;
+    res = _command_executor->create_table(request);
+    config::default_num_rows_per_data_block = num_rows_per_data_block;
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    SmartOLAPTable tablet = _command_executor->get_table(
+            request.tablet_id, request.tablet_schema.schema_hash);
+    ASSERT_TRUE(tablet.get() != NULL);
+
+    // 1. Push versions with the same keys, and a delete condition
+    // before the last version.
+    TPushReq push_req;
+    set_default_push_request(request, &push_req);
+    std::vector<TTabletInfo> tablets_info;
+    for (int i = 0; i < 2; ++i) {
+        res = _command_executor->push(push_req, &tablets_info);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        push_req.version += 1;
+        push_req.version_hash += 1;
+    }
+    push_req.version -= 1;
+    push_req.version_hash -= 1;
+
+    TPushReq delete_req = push_req;
+    delete_req.version += 1;
+    delete_req.version_hash += 1;
+    delete_req.__isset.http_file_path = false;
+    TCondition condition;
+    condition.column_name = "k1";
+    condition.condition_op = "=";
+    condition.condition_values.push_back("-120");
+    delete_req.delete_conditions.push_back(condition);
+    res = _command_executor->delete_data(delete_req, &tablets_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    push_req.version = delete_req.version + 1;
+    push_req.version_hash = delete_req.version_hash + 1;
+    res = _command_executor->push(push_req, &tablets_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    // 2. Cumulative compaction of pushed versions.
+    std::vector<Version> versions;
+    for (int64_t v = request.version + 1; v <= push_req.version; ++v) {
+        versions.push_back(Version(v, v));
+    }
+    std::vector<std::string> merger_rows;
+    std::vector<std::string> reader_rows;
+    uint64_t merger_row_count = 0;
+    uint64_t reader_row_count = 0;
+    uint64_t merger_merged_rows = 0;
+    uint64_t reader_merged_rows = 0;
+    uint64_t merger_filted_rows = 0;
+    uint64_t reader_filted_rows = 0;
+    merge_and_read_rows(tablet, versions, READER_CUMULATIVE_COMPACTION, 1001, true,
+                        &merger_rows, &merger_row_count,
+                        &merger_merged_rows, &merger_filted_rows);
+    merge_and_read_rows(tablet, versions, READER_CUMULATIVE_COMPACTION, 1002, false,
+                        &reader_rows, &reader_row_count,
+                        &reader_merged_rows, &reader_filted_rows);
+    ASSERT_FALSE(merger_rows.empty());
+    ASSERT_EQ(reader_row_count, merger_row_count);
+    ASSERT_EQ(reader_merged_rows, merger_merged_rows);
+    ASSERT_EQ(reader_filted_rows, merger_filted_rows);
+    ASSERT_TRUE(reader_rows == merger_rows);
+
+    // 3. Base compaction of all versions, deleted rows are filtered.
+    versions.insert(versions.begin(), Version(0, request.version));
+    merger_rows.clear();
+    reader_rows.clear();
+    merge_and_read_rows(tablet, versions, READER_BASE_COMPACTION, 1003, true,
+                        &merger_rows, &merger_row_count,
+                        &merger_merged_rows, &merger_filted_rows);
+    merge_and_read_rows(tablet, versions, READER_BASE_COMPACTION, 1004, false,
+                        &reader_rows, &reader_row_count,
+                        &reader_merged_rows, &reader_filted_rows);
+    ASSERT_FALSE(merger_rows.empty());
+    ASSERT_LT(0, merger_filted_rows);
+    ASSERT_EQ(reader_row_count, merger_row_count);
+    ASSERT_EQ(reader_merged_rows, merger_merged_rows);
+    ASSERT_EQ(reader_filted_rows, merger_filted_rows);
+    ASSERT_TRUE(reader_rows == merger_rows);
+
+    tablet.reset();
+    OLAPEngine::get_instance()->drop_table(
+            request.tablet_id, request.tablet_schema.schema_hash);
+}
+
 // ######################### ALTER TABLE TEST BEGIN #########################
 
 void set_create_tablet_request_1(const TCreateTabletReq& base_request, TCreateTabletReq* request) {
@@ -1338,6 +1602,378 @@ TEST_F(TestSchemaChange, schema_change) {
     ASSERT_EQ(100, tablet_info.row_count);
 }
 
+TEST_F(TestSchemaChange, schema_change_sorting_in_parallel) {
+    OLAPStatus res = OLAP_SUCCESS;
+    int32_t num_threads = config::schema_change_num_threads;
+    int32_t sorting_num_threads = config::schema_change_sorting_num_threads;
+
+    // 1. Prepare base tablet with several history versions.
+    TCreateTabletReq create_base_tablet;
+    set_default_create_tablet_request(&create_base_tablet);
+    res = _command_executor->create_table(create_base_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TPushReq push_req;
+    set_default_push_request(create_base_tablet, &push_req);
+    for (int i = 0; i < 3; ++i) {
+        std::vector<TTabletInfo> tablets_info;
+        res = _command_executor->push(push_req, &tablets_info);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        push_req.version += 1;
+        push_req.version_hash += 1;
+    }
+    push_req.version -= 1;
+    push_req.version_hash -= 1;
+
+    // 2. Convert by one thread, sorted runs are written in the converting thread.
+    config::schema_change_num_threads = 1;
+    config::schema_change_sorting_num_threads = 0;
+    TCreateTabletReq create_serial_tablet;
+    set_create_tablet_request_1(create_base_tablet, &create_serial_tablet);
+    TAlterTabletReq serial_request;
+    set_alter_tablet_request(create_base_tablet, &serial_request);
+    serial_request.__set_new_tablet_req(create_serial_tablet);
+    res = _command_executor->schema_change(serial_request);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(ALTER_TABLE_DONE, show_alter_table_status(_command_executor, serial_request));
+
+    // 3. Convert versions in parallel, sorted runs are written by background threads.
+    config::schema_change_num_threads = 3;
+    config::schema_change_sorting_num_threads = 2;
+    TCreateTabletReq create_parallel_tablet = create_serial_tablet;
+    create_parallel_tablet.tablet_id += 10;
+    create_parallel_tablet.tablet_schema.schema_hash += 10;
+    TAlterTabletReq parallel_request;
+    set_alter_tablet_request(create_base_tablet, &parallel_request);
+    parallel_request.__set_new_tablet_req(create_parallel_tablet);
+    res = _command_executor->schema_change(parallel_request);
+    config::schema_change_num_threads = num_threads;
+    config::schema_change_sorting_num_threads = sorting_num_threads;
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(ALTER_TABLE_DONE, show_alter_table_status(_command_executor, parallel_request));
+
+    // 4. Both new tablets have the same data.
+    TTabletInfo tablet_info;
+    tablet_info.tablet_id = create_parallel_tablet.tablet_id;
+    tablet_info.schema_hash = create_parallel_tablet.tablet_schema.schema_hash;
+    res = _command_executor->report_tablet_info(&tablet_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(push_req.version, tablet_info.version);
+    ASSERT_EQ(3 * BASE_TABLE_PUSH_DATA_ROW_COUNT, tablet_info.row_count);
+
+    uint32_t serial_checksum = 0;
+    res = _command_executor->compute_checksum(
+            create_serial_tablet.tablet_id, create_serial_tablet.tablet_schema.schema_hash,
+            push_req.version, push_req.version_hash, &serial_checksum);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    uint32_t parallel_checksum = 0;
+    res = _command_executor->compute_checksum(
+            create_parallel_tablet.tablet_id, create_parallel_tablet.tablet_schema.schema_hash,
+            push_req.version, push_req.version_hash, &parallel_checksum);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(serial_checksum, parallel_checksum);
+
+    SmartOLAPTable parallel_tablet = _command_executor->get_table(
+            create_parallel_tablet.tablet_id, create_parallel_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(parallel_tablet.get() != NULL);
+    ASSERT_EQ(99, parallel_tablet->alter_progress());
+    parallel_tablet.reset();
+
+    OLAPEngine::get_instance()->drop_table(
+            create_serial_tablet.tablet_id, create_serial_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_parallel_tablet.tablet_id, create_parallel_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+}
+
+TEST_F(TestSchemaChange, schema_change_directly_in_parallel) {
+    OLAPStatus res = OLAP_SUCCESS;
+    int32_t num_threads = config::schema_change_num_threads;
+
+    // 1. Prepare base tablet with several history versions.
+    TCreateTabletReq create_base_tablet;
+    set_default_create_tablet_request(&create_base_tablet);
+    res = _command_executor->create_table(create_base_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TPushReq push_req;
+    set_default_push_request(create_base_tablet, &push_req);
+    for (int i = 0; i < 3; ++i) {
+        std::vector<TTabletInfo> tablets_info;
+        res = _command_executor->push(push_req, &tablets_info);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        push_req.version += 1;
+        push_req.version_hash += 1;
+    }
+    push_req.version -= 1;
+    push_req.version_hash -= 1;
+
+    // 2. Convert versions one by one.
+    config::schema_change_num_threads = 1;
+    TCreateTabletReq create_serial_tablet;
+    set_create_tablet_request_2(create_base_tablet, &create_serial_tablet);
+    TAlterTabletReq serial_request;
+    set_alter_tablet_request(create_base_tablet, &serial_request);
+    serial_request.__set_new_tablet_req(create_serial_tablet);
+    res = _command_executor->schema_change(serial_request);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(ALTER_TABLE_DONE, show_alter_table_status(_command_executor, serial_request));
+
+    // 3. Convert versions in parallel.
+    config::schema_change_num_threads = 3;
+    TCreateTabletReq create_parallel_tablet = create_serial_tablet;
+    create_parallel_tablet.tablet_id += 10;
+    create_parallel_tablet.tablet_schema.schema_hash += 10;
+    TAlterTabletReq parallel_request;
+    set_alter_tablet_request(create_base_tablet, &parallel_request);
+    parallel_request.__set_new_tablet_req(create_parallel_tablet);
+    res = _command_executor->schema_change(parallel_request);
+    config::schema_change_num_threads = num_threads;
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(ALTER_TABLE_DONE, show_alter_table_status(_command_executor, parallel_request));
+
+    // 4. All versions are registered and both new tablets have the same data.
+    TTabletInfo tablet_info;
+    tablet_info.tablet_id = create_parallel_tablet.tablet_id;
+    tablet_info.schema_hash = create_parallel_tablet.tablet_schema.schema_hash;
+    res = _command_executor->report_tablet_info(&tablet_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(push_req.version, tablet_info.version);
+    ASSERT_EQ(push_req.version_hash, tablet_info.version_hash);
+
+    uint32_t serial_checksum = 0;
+    res = _command_executor->compute_checksum(
+            create_serial_tablet.tablet_id, create_serial_tablet.tablet_schema.schema_hash,
+            push_req.version, push_req.version_hash, &serial_checksum);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    uint32_t parallel_checksum = 0;
+    res = _command_executor->compute_checksum(
+            create_parallel_tablet.tablet_id, create_parallel_tablet.tablet_schema.schema_hash,
+            push_req.version, push_req.version_hash, &parallel_checksum);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(serial_checksum, parallel_checksum);
+
+    OLAPEngine::get_instance()->drop_table(
+            create_serial_tablet.tablet_id, create_serial_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_parallel_tablet.tablet_id, create_parallel_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+}
+
+TEST_F(TestSchemaChange, linked_schema_change_with_delete_conditions) {
+    OLAPStatus res = OLAP_SUCCESS;
+
+    // 1. Prepare base tablet with data and a delete condition on key column.
+    TCreateTabletReq create_base_tablet;
+    set_default_create_tablet_request(&create_base_tablet);
+    res = _command_executor->create_table(create_base_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TPushReq push_req;
+    set_default_push_request(create_base_tablet, &push_req);
+    std::vector<TTabletInfo> tablets_info;
+    res = _command_executor->push(push_req, &tablets_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TPushReq delete_req = push_req;
+    delete_req.version += 1;
+    delete_req.version_hash += 1;
+    delete_req.__isset.http_file_path = false;
+    TCondition condition;
+    condition.column_name = "k1";
+    condition.condition_op = "=";
+    condition.condition_values.push_back("-120");
+    delete_req.delete_conditions.push_back(condition);
+    tablets_info.clear();
+    res = _command_executor->delete_data(delete_req, &tablets_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    // 2. Add a value column, all key columns are kept.
+    TCreateTabletReq create_new_tablet = create_base_tablet;
+    create_new_tablet.tablet_id += 7;
+    create_new_tablet.tablet_schema.schema_hash += 7;
+    TColumn v2;
+    v2.column_name = "v2";
+    v2.column_type.type = TPrimitiveType::BIGINT;
+    v2.__set_is_key(false);
+    v2.__set_default_value("0");
+    v2.__set_aggregation_type(TAggregationType::SUM);
+    create_new_tablet.tablet_schema.columns.push_back(v2);
+
+    TAlterTabletReq request;
+    set_alter_tablet_request(create_base_tablet, &request);
+    request.__set_new_tablet_req(create_new_tablet);
+    res = _command_executor->schema_change(request);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(ALTER_TABLE_DONE, show_alter_table_status(_command_executor, request));
+
+    // 3. Data is linked and delete condition is copied into new tablet.
+    SmartOLAPTable base_tablet = _command_executor->get_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(base_tablet.get() != NULL);
+    SmartOLAPTable new_tablet = _command_executor->get_table(
+            create_new_tablet.tablet_id, create_new_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(new_tablet.get() != NULL);
+    {
+        RowBlockChanger rb_changer(new_tablet->tablet_schema(), base_tablet);
+        bool sc_sorting = false;
+        bool sc_directly = false;
+        res = SchemaChangeHandler::_parse_request(
+                base_tablet, new_tablet, &rb_changer, &sc_sorting, &sc_directly);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        ASSERT_FALSE(sc_sorting);
+        ASSERT_FALSE(sc_directly);
+    }
+    ASSERT_EQ(1, new_tablet->delete_data_conditions_size());
+    ASSERT_EQ(delete_req.version, new_tablet->delete_data_conditions().Get(0).version());
+
+    TTabletInfo tablet_info;
+    tablet_info.tablet_id = create_new_tablet.tablet_id;
+    tablet_info.schema_hash = create_new_tablet.tablet_schema.schema_hash;
+    res = _command_executor->report_tablet_info(&tablet_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(delete_req.version, tablet_info.version);
+    ASSERT_EQ(delete_req.version_hash, tablet_info.version_hash);
+
+    base_tablet.reset();
+    new_tablet.reset();
+    OLAPEngine::get_instance()->drop_table(
+            create_new_tablet.tablet_id, create_new_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+}
+
+TEST_F(TestSchemaChange, parse_request_widen_varchar) {
+    OLAPStatus res = OLAP_SUCCESS;
+
+    TCreateTabletReq create_base_tablet;
+    set_default_create_tablet_request(&create_base_tablet);
+    TColumn v2;
+    v2.column_name = "v2";
+    v2.column_type.type = TPrimitiveType::VARCHAR;
+    v2.column_type.__set_len(32);
+    v2.__set_is_key(false);
+    v2.__set_aggregation_type(TAggregationType::REPLACE);
+    create_base_tablet.tablet_schema.columns.push_back(v2);
+    res = _command_executor->create_table(create_base_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    SmartOLAPTable base_tablet = _command_executor->get_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(base_tablet.get() != NULL);
+
+    // varchar value column is made longer
+    TCreateTabletReq create_longer_tablet = create_base_tablet;
+    create_longer_tablet.tablet_id += 1;
+    create_longer_tablet.tablet_schema.schema_hash += 1;
+    create_longer_tablet.tablet_schema.columns.back().column_type.__set_len(64);
+    res = _command_executor->create_table(create_longer_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    SmartOLAPTable longer_tablet = _command_executor->get_table(
+            create_longer_tablet.tablet_id, create_longer_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(longer_tablet.get() != NULL);
+
+    // varchar value column is made shorter
+    TCreateTabletReq create_shorter_tablet = create_base_tablet;
+    create_shorter_tablet.tablet_id += 2;
+    create_shorter_tablet.tablet_schema.schema_hash += 2;
+    create_shorter_tablet.tablet_schema.columns.back().column_type.__set_len(16);
+    res = _command_executor->create_table(create_shorter_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    SmartOLAPTable shorter_tablet = _command_executor->get_table(
+            create_shorter_tablet.tablet_id, create_shorter_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(shorter_tablet.get() != NULL);
+
+    {
+        // values are stored by their real length, data is linked
+        RowBlockChanger rb_changer(longer_tablet->tablet_schema(), base_tablet);
+        bool sc_sorting = false;
+        bool sc_directly = false;
+        res = SchemaChangeHandler::_parse_request(
+                base_tablet, longer_tablet, &rb_changer, &sc_sorting, &sc_directly);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        ASSERT_FALSE(sc_sorting);
+        ASSERT_FALSE(sc_directly);
+    }
+    {
+        // values may be truncated, data is rewritten
+        RowBlockChanger rb_changer(shorter_tablet->tablet_schema(), base_tablet);
+        bool sc_sorting = false;
+        bool sc_directly = false;
+        res = SchemaChangeHandler::_parse_request(
+                base_tablet, shorter_tablet, &rb_changer, &sc_sorting, &sc_directly);
+        ASSERT_EQ(OLAP_SUCCESS, res);
+        ASSERT_FALSE(sc_sorting);
+        ASSERT_TRUE(sc_directly);
+    }
+
+    base_tablet.reset();
+    longer_tablet.reset();
+    shorter_tablet.reset();
+    OLAPEngine::get_instance()->drop_table(
+            create_shorter_tablet.tablet_id, create_shorter_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_longer_tablet.tablet_id, create_longer_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+}
+
+TEST_F(TestSchemaChange, schema_version_convert_without_alter_progress) {
+    OLAPStatus res = OLAP_SUCCESS;
+
+    TCreateTabletReq create_base_tablet;
+    set_default_create_tablet_request(&create_base_tablet);
+    res = _command_executor->create_table(create_base_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    SmartOLAPTable base_tablet = _command_executor->get_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(base_tablet.get() != NULL);
+
+    TPushReq push_req;
+    set_default_push_request(create_base_tablet, &push_req);
+    std::vector<TTabletInfo> tablets_info;
+    res = _command_executor->push(push_req, &tablets_info);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+
+    TCreateTabletReq create_new_tablet;
+    set_create_tablet_request_1(create_base_tablet, &create_new_tablet);
+    res = _command_executor->create_table(create_new_tablet);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    SmartOLAPTable new_tablet = _command_executor->get_table(
+            create_new_tablet.tablet_id, create_new_tablet.tablet_schema.schema_hash);
+    ASSERT_TRUE(new_tablet.get() != NULL);
+    new_tablet->set_alter_total_rows(10 * BASE_TABLE_PUSH_DATA_ROW_COUNT);
+
+    // pushed data converted for the new tablet is not history data
+    std::vector<Version> versions(1, Version(push_req.version, push_req.version));
+    std::vector<IData*> olap_data_arr;
+    base_tablet->obtain_header_rdlock();
+    base_tablet->acquire_data_sources_by_versions(versions, &olap_data_arr);
+    base_tablet->release_header_lock();
+    ASSERT_EQ(1, olap_data_arr.size());
+
+    std::vector<OLAPIndex*> ref_olap_indices(1, olap_data_arr[0]->olap_index());
+    std::vector<OLAPIndex*> new_olap_indices;
+    SchemaChangeHandler schema_change_handler;
+    res = schema_change_handler.schema_version_convert(
+            base_tablet, new_tablet, &ref_olap_indices, &new_olap_indices);
+    base_tablet->release_data_sources(&olap_data_arr);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(0, new_tablet->alter_progress());
+
+    for (OLAPIndex* olap_index : new_olap_indices) {
+        olap_index->delete_all_files();
+        SAFE_DELETE(olap_index);
+    }
+    base_tablet.reset();
+    new_tablet.reset();
+    OLAPEngine::get_instance()->drop_table(
+            create_new_tablet.tablet_id, create_new_tablet.tablet_schema.schema_hash);
+    OLAPEngine::get_instance()->drop_table(
+            create_base_tablet.tablet_id, create_base_tablet.tablet_schema.schema_hash);
+}
+
 class TestCreateRollupTable : public ::testing::Test {
 public:
     TestCreateRollupTable() : _command_executor(NULL) {}
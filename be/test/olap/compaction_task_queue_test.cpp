@@ -0,0 +1,150 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/compaction_task_queue.h"
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+static CompactionTask make_task(CompactionType type, TTabletId tablet_id,
+                                uint32_t score, int64_t data_size) {
+    CompactionTask task;
+    task.type = type;
+    task.tablet_id = tablet_id;
+    task.schema_hash = 1;
+    task.score = score;
+    task.data_size = data_size;
+    return task;
+}
+
+TEST(CompactionTaskQueueTest, pick_highest_score) {
+    CompactionTaskQueue queue(2, 1000);
+    ASSERT_TRUE(queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 3, 10)));
+    ASSERT_TRUE(queue.add("/data2", make_task(CUMULATIVE_COMPACTION, 2, 5, 10)));
+    ASSERT_TRUE(queue.add("/data1", make_task(BASE_COMPACTION, 3, 5, 10)));
+    // same score is not added again
+    ASSERT_FALSE(queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 3, 10)));
+
+    CompactionTask task;
+    std::string root_path;
+    // cumulative goes before base of the same score
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    ASSERT_EQ(2, task.tablet_id);
+    ASSERT_EQ("/data2", root_path);
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    ASSERT_EQ(3, task.tablet_id);
+    ASSERT_EQ(BASE_COMPACTION, task.type);
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    ASSERT_EQ(1, task.tablet_id);
+    ASSERT_FALSE(queue.pick(true, &task, &root_path));
+    ASSERT_EQ(3, queue.num_running());
+
+    // running task is not added
+    ASSERT_FALSE(queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 4, 10)));
+}
+
+TEST(CompactionTaskQueueTest, limits) {
+    CompactionTaskQueue queue(1, 100);
+    queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 5, 80));
+    queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 2, 4, 10));
+    queue.add("/data2", make_task(CUMULATIVE_COMPACTION, 3, 3, 30));
+    queue.add("/data2", make_task(CUMULATIVE_COMPACTION, 4, 2, 10));
+
+    CompactionTask task1;
+    CompactionTask task2;
+    CompactionTask task3;
+    std::string root_path1;
+    std::string root_path2;
+    std::string root_path3;
+    ASSERT_TRUE(queue.pick(true, &task1, &root_path1));
+    ASSERT_EQ(1, task1.tablet_id);
+    // only one task of each disk, and task 3 exceeds budget
+    ASSERT_FALSE(queue.pick(true, &task2, &root_path2));
+
+    queue.finish(task1, root_path1, true);
+    ASSERT_TRUE(queue.pick(true, &task2, &root_path2));
+    ASSERT_EQ(2, task2.tablet_id);
+    ASSERT_TRUE(queue.pick(true, &task3, &root_path3));
+    ASSERT_EQ(3, task3.tablet_id);
+    queue.finish(task2, root_path2, true);
+    queue.finish(task3, root_path3, true);
+
+    // task larger than budget runs when nothing is running
+    queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 5, 9, 1000));
+    ASSERT_TRUE(queue.pick(true, &task1, &root_path1));
+    ASSERT_EQ(5, task1.tablet_id);
+    ASSERT_FALSE(queue.pick(true, &task2, &root_path2));
+    queue.finish(task1, root_path1, true);
+    ASSERT_TRUE(queue.pick(true, &task2, &root_path2));
+    ASSERT_EQ(4, task2.tablet_id);
+}
+
+TEST(CompactionTaskQueueTest, failed_task) {
+    CompactionTaskQueue queue(2, 1000);
+    CompactionTask task;
+    std::string root_path;
+    queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 5, 10));
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    queue.finish(task, root_path, false);
+
+    // not retried with the same score until failed tasks are cleared
+    ASSERT_FALSE(queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 5, 10)));
+    ASSERT_TRUE(queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 6, 10)));
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    queue.finish(task, root_path, false);
+    queue.clear_failed();
+    ASSERT_TRUE(queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, 6, 10)));
+}
+
+TEST(CompactionTaskQueueTest, base_compaction_not_allowed) {
+    CompactionTaskQueue queue(2, 1000);
+    queue.add("/data1", make_task(BASE_COMPACTION, 1, 9, 10));
+    queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 2, 3, 10));
+
+    CompactionTask task;
+    std::string root_path;
+    ASSERT_TRUE(queue.pick(false, &task, &root_path));
+    ASSERT_EQ(2, task.tablet_id);
+    // base task is dropped, and it can be added by next rescan
+    ASSERT_FALSE(queue.pick(true, &task, &root_path));
+    ASSERT_EQ(0, queue.num_queued());
+    ASSERT_TRUE(queue.add("/data1", make_task(BASE_COMPACTION, 1, 9, 10)));
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    ASSERT_EQ(1, task.tablet_id);
+}
+
+TEST(CompactionTaskQueueTest, stale_tasks_removed) {
+    CompactionTaskQueue queue(2, 1000);
+    for (uint32_t score = 1; score <= 1000; ++score) {
+        queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 1, score % 7 + 1, 10));
+        queue.add("/data1", make_task(CUMULATIVE_COMPACTION, 2, score % 5 + 1, 10));
+    }
+    ASSERT_EQ(2, queue.num_queued());
+    ASSERT_LE(queue.queue_size("/data1"), 5);
+
+    CompactionTask task;
+    std::string root_path;
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    ASSERT_TRUE(queue.pick(true, &task, &root_path));
+    ASSERT_FALSE(queue.pick(true, &task, &root_path));
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1118,6 +1118,57 @@ TEST_F(TestDeleteHandler, FilterDataVersion) {
     _delete_handler.finalize();
 }
 
+TEST_F(TestDeleteHandler, UseDeleteBitmap) {
+    OLAPStatus res;
+    DeleteConditionHandler cond_handler;
+    std::vector<TCondition> conditions;
+
+    TCondition condition;
+    condition.column_name = "k1";
+    condition.condition_op = "=";
+    condition.condition_values.clear();
+    condition.condition_values.push_back("1");
+    conditions.push_back(condition);
+
+    res = cond_handler.store_cond(_olap_table, 3, conditions);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(OLAP_SUCCESS, push_empty_delta(3));
+    res = cond_handler.store_cond(_olap_table, 4, conditions);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(OLAP_SUCCESS, push_empty_delta(4));
+
+    // 不存在的删除条件
+    ASSERT_EQ(OLAP_ERR_DELETE_INVALID_VERSION, cond_handler.mark_delete_bitmap(_olap_table, 5));
+    ASSERT_EQ(OLAP_SUCCESS, cond_handler.mark_delete_bitmap(_olap_table, 3));
+
+    _delete_handler.init(_olap_table, 10);
+    const std::vector<DeleteConditions>& del_conds = _delete_handler.get_delete_conditions();
+    ASSERT_EQ(size_t(2), del_conds.size());
+    for (const DeleteConditions& del_cond : del_conds) {
+        EXPECT_EQ(del_cond.filter_version == 3, del_cond.use_delete_bitmap);
+    }
+
+    // 拷贝中移除删除条件，不影响原来的handler
+    DeleteHandler handler_copy = _delete_handler;
+    handler_copy.remove_conditions(std::vector<int32_t>(1, 3));
+    ASSERT_EQ(size_t(1), handler_copy.get_delete_conditions().size());
+    EXPECT_EQ(4, handler_copy.get_delete_conditions()[0].filter_version);
+    ASSERT_EQ(size_t(2), _delete_handler.get_delete_conditions().size());
+    _delete_handler.finalize();
+
+    // 重新存储删除条件后，需要重新生成delete bitmap
+    res = cond_handler.store_cond(_olap_table, 4, conditions);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    ASSERT_EQ(OLAP_SUCCESS, cond_handler.mark_delete_bitmap(_olap_table, 4));
+    res = cond_handler.store_cond(_olap_table, 4, conditions);
+    ASSERT_EQ(OLAP_SUCCESS, res);
+    const del_cond_array& delete_conditions = _olap_table->delete_data_conditions();
+    for (int i = 0; i < delete_conditions.size(); ++i) {
+        EXPECT_EQ(delete_conditions.Get(i).version() == 3,
+                  delete_conditions.Get(i).use_delete_bitmap());
+    }
+}
+
 }  // namespace palo
 
 int main(int argc, char** argv) {
@@ -0,0 +1,177 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/header_store.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace palo {
+
+class HeaderStoreTest : public testing::Test {
+public:
+    void SetUp() override {
+        _root_path = "./ut_dir/header_store_test";
+        remove_all_dir(_root_path);
+        ASSERT_EQ(OLAP_SUCCESS, create_dirs(_root_path));
+        _header_file = _root_path + DATA_PREFIX + "/0/10001/1234/10001.hdr";
+    }
+
+    void TearDown() override {
+        remove_all_dir(_root_path);
+    }
+
+protected:
+    std::string _root_path;
+    std::string _header_file;
+};
+
+TEST_F(HeaderStoreTest, put_and_remove) {
+    DiskHeaderStore store(_root_path);
+    ASSERT_EQ(OLAP_SUCCESS, store.open());
+
+    std::string value;
+    ASSERT_EQ(OLAP_ERR_HEADER_NOT_FOUND, store.get(_header_file, &value));
+    ASSERT_EQ(OLAP_SUCCESS, store.put(_header_file, "header1"));
+    ASSERT_EQ(OLAP_SUCCESS, store.put(_header_file, "header2"));
+    ASSERT_TRUE(store.contains(_header_file));
+    ASSERT_EQ(OLAP_SUCCESS, store.get(_header_file, &value));
+    ASSERT_EQ("header2", value);
+
+    ASSERT_EQ(OLAP_SUCCESS, store.remove(_header_file));
+    ASSERT_FALSE(store.contains(_header_file));
+}
+
+TEST_F(HeaderStoreTest, reopen) {
+    std::string other_file = _root_path + DATA_PREFIX + "/0/10002/1234/10002.hdr";
+    {
+        DiskHeaderStore store(_root_path);
+        ASSERT_EQ(OLAP_SUCCESS, store.open());
+        ASSERT_EQ(OLAP_SUCCESS, store.put(_header_file, "header1"));
+        ASSERT_EQ(OLAP_SUCCESS, store.put(other_file, "header2"));
+        ASSERT_EQ(OLAP_SUCCESS, store.remove(other_file));
+    }
+
+    // append an incomplete record, like crash when it's being written
+    FILE* fp = fopen((_root_path + HEADER_STORE_PREFIX + "/log_1").c_str(), "a");
+    ASSERT_TRUE(fp != NULL);
+    fwrite("\x20\x00", 1, 2, fp);
+    fclose(fp);
+
+    std::string value;
+    for (int i = 0; i < 2; ++i) {
+        DiskHeaderStore store(_root_path);
+        ASSERT_EQ(OLAP_SUCCESS, store.open());
+        ASSERT_EQ(OLAP_SUCCESS, store.get(_header_file, &value));
+        ASSERT_EQ("header1", value);
+        ASSERT_FALSE(store.contains(other_file));
+    }
+}
+
+TEST_F(HeaderStoreTest, corruption) {
+    std::string log_file = _root_path + HEADER_STORE_PREFIX + "/log_1";
+    {
+        DiskHeaderStore store(_root_path);
+        ASSERT_EQ(OLAP_SUCCESS, store.open());
+        ASSERT_EQ(OLAP_SUCCESS, store.put(_header_file, "header1"));
+        ASSERT_EQ(OLAP_SUCCESS, store.put(_header_file, "header2"));
+    }
+
+    // flip a byte of the first record, which is not the end of log
+    FILE* fp = fopen(log_file.c_str(), "r+");
+    ASSERT_TRUE(fp != NULL);
+    fseek(fp, 20, SEEK_SET);
+    fputc('x', fp);
+    fclose(fp);
+    {
+        DiskHeaderStore store(_root_path);
+        ASSERT_EQ(OLAP_ERR_CHECKSUM_ERROR, store.open());
+    }
+}
+
+TEST_F(HeaderStoreTest, incomplete_record_not_in_newest_log) {
+    {
+        DiskHeaderStore store(_root_path);
+        ASSERT_EQ(OLAP_SUCCESS, store.open());
+        ASSERT_EQ(OLAP_SUCCESS, store.put(_header_file, "header1"));
+    }
+    FILE* fp = fopen((_root_path + HEADER_STORE_PREFIX + "/log_1").c_str(), "a");
+    ASSERT_TRUE(fp != NULL);
+    fwrite("\x20\x00", 1, 2, fp);
+    fclose(fp);
+    // log_1 is not the newest log
+    fp = fopen((_root_path + HEADER_STORE_PREFIX + "/log_2").c_str(), "w");
+    ASSERT_TRUE(fp != NULL);
+    fclose(fp);
+
+    DiskHeaderStore store(_root_path);
+    ASSERT_EQ(OLAP_ERR_CHECKSUM_ERROR, store.open());
+}
+
+TEST_F(HeaderStoreTest, checkpoint) {
+    int64_t checkpoint_log_mbytes = config::header_store_checkpoint_log_mbytes;
+    config::header_store_checkpoint_log_mbytes = 1;
+    std::string value(100 * 1024, 'a');
+    std::string other_file = _root_path + DATA_PREFIX + "/0/10002/1234/10002.hdr";
+    {
+        DiskHeaderStore store(_root_path);
+        ASSERT_EQ(OLAP_SUCCESS, store.open());
+        for (int i = 0; i < 30; ++i) {
+            value[0] = 'a' + i;
+            ASSERT_EQ(OLAP_SUCCESS, store.put(_header_file, value));
+        }
+        // more than one chunk of checkpoint
+        for (int i = 0; i < 30; ++i) {
+            ASSERT_EQ(OLAP_SUCCESS, store.put(other_file + std::to_string(i), value));
+        }
+    }
+    config::header_store_checkpoint_log_mbytes = checkpoint_log_mbytes;
+
+    std::set<std::string> files;
+    ASSERT_EQ(OLAP_SUCCESS, dir_walk(_root_path + HEADER_STORE_PREFIX, NULL, &files));
+    ASSERT_TRUE(files.find("checkpoint") != files.end());
+    ASSERT_TRUE(files.find("log_1") == files.end());
+
+    DiskHeaderStore store(_root_path);
+    ASSERT_EQ(OLAP_SUCCESS, store.open());
+    std::string result;
+    ASSERT_EQ(OLAP_SUCCESS, store.get(_header_file, &result));
+    ASSERT_EQ(value, result);
+    for (int i = 0; i < 30; ++i) {
+        ASSERT_EQ(OLAP_SUCCESS, store.get(other_file + std::to_string(i), &result));
+        ASSERT_EQ(value, result);
+    }
+
+    std::set<std::string> header_files;
+    ASSERT_EQ(OLAP_SUCCESS, store.retain(header_files));
+    ASSERT_FALSE(store.contains(_header_file));
+}
+
+TEST_F(HeaderStoreTest, get_disk) {
+    HeaderStore* header_store = HeaderStore::get_instance();
+    std::vector<std::string> root_paths = {_root_path};
+    ASSERT_EQ(OLAP_SUCCESS, header_store->init(root_paths));
+    ASSERT_TRUE(header_store->get_disk(_header_file) != NULL);
+    ASSERT_TRUE(header_store->get_disk(_root_path + SNAPSHOT_PREFIX + "/1/10001.hdr") == NULL);
+    ASSERT_TRUE(header_store->get_disk(_root_path + "_other" + DATA_PREFIX + "/0/1.hdr") == NULL);
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/io_governor.h"
+
+#include <sys/time.h>
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+static int64_t now_us() {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec * 1000000L + now.tv_usec;
+}
+
+TEST(TokenBucketTest, refill) {
+    TokenBucket bucket;
+    bucket.init(1000, 1000, 0);
+    ASSERT_FALSE(bucket.unlimited());
+    ASSERT_EQ(1000, bucket.tokens());
+
+    bucket.consume(1500);
+    ASSERT_EQ(-500, bucket.tokens());
+    ASSERT_EQ(500000, bucket.wait_time_us());
+
+    bucket.refill(250000);
+    ASSERT_EQ(-250, bucket.tokens());
+    ASSERT_EQ(250000, bucket.wait_time_us());
+
+    // never more than burst
+    bucket.refill(10000000);
+    ASSERT_EQ(1000, bucket.tokens());
+    ASSERT_EQ(0, bucket.wait_time_us());
+
+    // never less than -burst
+    bucket.consume(100000);
+    ASSERT_EQ(-1000, bucket.tokens());
+    ASSERT_EQ(1000000, bucket.wait_time_us());
+}
+
+TEST(TokenBucketTest, unlimited) {
+    TokenBucket bucket;
+    bucket.init(0, 0, 0);
+    ASSERT_TRUE(bucket.unlimited());
+    bucket.consume(1000);
+    ASSERT_EQ(0, bucket.wait_time_us());
+}
+
+TEST(IOGovernorTest, priority_scope) {
+    ASSERT_EQ(IO_PRIORITY_QUERY, IOGovernor::thread_priority());
+    {
+        IOPriorityScope push(IO_PRIORITY_PUSH);
+        ASSERT_EQ(IO_PRIORITY_PUSH, IOGovernor::thread_priority());
+        {
+            IOPriorityScope clone(IO_PRIORITY_CLONE);
+            ASSERT_EQ(IO_PRIORITY_CLONE, IOGovernor::thread_priority());
+        }
+        ASSERT_EQ(IO_PRIORITY_PUSH, IOGovernor::thread_priority());
+    }
+    ASSERT_EQ(IO_PRIORITY_QUERY, IOGovernor::thread_priority());
+}
+
+TEST(IOGovernorTest, throttle) {
+    DiskIOGovernor disk("/data", 0, 1000, 0);
+
+    // query is never throttled
+    int64_t start = now_us();
+    disk.acquire(IO_WRITE, 3000);
+    ASSERT_LT(now_us() - start, 100000);
+
+    // wait until debt of query is paid
+    IOPriorityScope io_priority(IO_PRIORITY_BASE_COMPACTION);
+    start = now_us();
+    disk.acquire(IO_WRITE, 100);
+    ASSERT_GE(now_us() - start, 1900000);
+
+    // reads are not limited
+    start = now_us();
+    disk.acquire(IO_READ, 100000);
+    ASSERT_LT(now_us() - start, 100000);
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
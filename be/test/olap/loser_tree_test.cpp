@@ -0,0 +1,122 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/loser_tree.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+struct Input {
+    std::vector<int> values;
+    size_t pos = 0;
+};
+
+struct InputLess {
+    InputLess(std::vector<Input>* inputs) : inputs(inputs) { }
+    bool operator()(int a, int b) const {
+        const Input& first = (*inputs)[a];
+        const Input& second = (*inputs)[b];
+        return first.values[first.pos] < second.values[second.pos];
+    }
+    std::vector<Input>* inputs;
+};
+
+// Merge inputs, output is (value, input index)
+static std::vector<std::pair<int, int>> merge(std::vector<Input>* inputs) {
+    std::vector<std::pair<int, int>> output;
+    LoserTree<InputLess> tree((InputLess(inputs)));
+    tree.init(inputs->size());
+    while (!tree.empty()) {
+        int leaf = tree.top();
+        Input& input = (*inputs)[leaf];
+        output.emplace_back(input.values[input.pos], leaf);
+        if (++input.pos < input.values.size()) {
+            tree.update_top();
+        } else {
+            tree.pop_top();
+        }
+    }
+    return output;
+}
+
+class LoserTreeTest : public testing::Test {
+};
+
+TEST_F(LoserTreeTest, empty) {
+    std::vector<Input> inputs;
+    ASSERT_TRUE(merge(&inputs).empty());
+}
+
+TEST_F(LoserTreeTest, single) {
+    std::vector<Input> inputs(1);
+    inputs[0].values = {1, 3, 5};
+    auto output = merge(&inputs);
+    ASSERT_EQ(3, output.size());
+    ASSERT_EQ(1, output[0].first);
+    ASSERT_EQ(5, output[2].first);
+}
+
+TEST_F(LoserTreeTest, equal_in_order_of_leaf) {
+    std::vector<Input> inputs(3);
+    inputs[0].values = {1, 2};
+    inputs[1].values = {1, 2};
+    inputs[2].values = {1, 2};
+    auto output = merge(&inputs);
+    ASSERT_EQ(6, output.size());
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_EQ(i / 3 + 1, output[i].first);
+        ASSERT_EQ(i % 3, output[i].second);
+    }
+}
+
+TEST_F(LoserTreeTest, random) {
+    srand(1);
+    for (int num_inputs = 1; num_inputs <= 17; ++num_inputs) {
+        std::vector<Input> inputs(num_inputs);
+        std::vector<int> expected;
+        for (auto& input : inputs) {
+            int num_values = 1 + rand() % 100;
+            for (int i = 0; i < num_values; ++i) {
+                input.values.push_back(rand() % 50);
+            }
+            std::sort(input.values.begin(), input.values.end());
+            expected.insert(expected.end(), input.values.begin(), input.values.end());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        auto output = merge(&inputs);
+        ASSERT_EQ(expected.size(), output.size());
+        for (int i = 0; i < output.size(); ++i) {
+            ASSERT_EQ(expected[i], output[i].first);
+            if (i > 0 && output[i].first == output[i - 1].first) {
+                ASSERT_LE(output[i - 1].second, output[i].second);
+            }
+        }
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,217 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "olap/memtable.h"
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "olap/string_slice.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/descriptors.h"
+#include "runtime/string_value.h"
+#include "runtime/tuple.h"
+#include "util/types.h"
+
+namespace palo {
+
+class MemTableTest : public testing::Test {
+public:
+    MemTableTest() { }
+    virtual ~MemTableTest() { }
+
+    void SetUp() override;
+
+protected:
+    // add a nullable column to both tuple and tablet schema
+    void add_column(TPrimitiveType::type slot_type, int byte_offset,
+                    FieldType field_type, uint32_t field_length,
+                    FieldAggregationMethod aggregation);
+    // write a row of (k1, v1, v2) into _tuple_buf
+    Tuple* make_tuple(int32_t k1, const std::string& v1, int64_t v2_int, int32_t v2_frac);
+    // rows kept in mem table in key order
+    std::vector<char*> rows(MemTable* mem_table) {
+        std::vector<char*> result;
+        MemTable::Table::Iterator it(mem_table->_skip_list.get());
+        for (it.seek_to_first(); it.valid(); it.next()) {
+            result.push_back(it.key());
+        }
+        return result;
+    }
+
+    ObjectPool _obj_pool;
+    TDescriptorTable _t_desc_table;
+    std::vector<FieldInfo> _tablet_schema;
+    std::vector<const SlotDescriptor*> _col_slots;
+    std::vector<char> _tuple_buf;
+    std::string _v1;
+};
+
+void MemTableTest::add_column(TPrimitiveType::type slot_type, int byte_offset,
+                              FieldType field_type, uint32_t field_length,
+                              FieldAggregationMethod aggregation) {
+    int id = _t_desc_table.slotDescriptors.size();
+
+    TSlotDescriptor slot_desc;
+    slot_desc.id = id;
+    slot_desc.parent = 0;
+    TTypeDesc type;
+    {
+        TTypeNode node;
+        node.__set_type(TTypeNodeType::SCALAR);
+        TScalarType scalar_type;
+        scalar_type.__set_type(slot_type);
+        if (slot_type == TPrimitiveType::VARCHAR) {
+            scalar_type.__set_len(field_length - OLAP_STRING_MAX_BYTES);
+        } else if (slot_type == TPrimitiveType::DECIMALV2) {
+            scalar_type.__set_precision(27);
+            scalar_type.__set_scale(9);
+        }
+        node.__set_scalar_type(scalar_type);
+        type.types.push_back(node);
+    }
+    slot_desc.slotType = type;
+    slot_desc.columnPos = id;
+    slot_desc.byteOffset = byte_offset;
+    slot_desc.nullIndicatorByte = 0;
+    slot_desc.nullIndicatorBit = id;
+    slot_desc.colName = "c" + std::to_string(id);
+    slot_desc.slotIdx = id;
+    slot_desc.isMaterialized = true;
+    _t_desc_table.slotDescriptors.push_back(slot_desc);
+
+    FieldInfo field;
+    field.name = slot_desc.colName;
+    field.type = field_type;
+    field.length = field_length;
+    field.index_length = field_length;
+    field.precision = 27;
+    field.frac = 9;
+    field.is_key = (aggregation == OLAP_FIELD_AGGREGATION_NONE);
+    field.aggregation = aggregation;
+    field.is_allow_null = true;
+    _tablet_schema.push_back(field);
+}
+
+void MemTableTest::SetUp() {
+    // k1 INT, v1 VARCHAR(8) REPLACE, v2 DECIMALV2 SUM
+    add_column(TPrimitiveType::INT, 8, OLAP_FIELD_TYPE_INT, 4,
+               OLAP_FIELD_AGGREGATION_NONE);
+    add_column(TPrimitiveType::VARCHAR, 16, OLAP_FIELD_TYPE_VARCHAR, 8 + OLAP_STRING_MAX_BYTES,
+               OLAP_FIELD_AGGREGATION_REPLACE);
+    add_column(TPrimitiveType::DECIMALV2, 32, OLAP_FIELD_TYPE_DECIMAL, 12,
+               OLAP_FIELD_AGGREGATION_SUM);
+
+    TTupleDescriptor t_tuple_desc;
+    t_tuple_desc.id = 0;
+    t_tuple_desc.byteSize = 48;
+    t_tuple_desc.numNullBytes = 1;
+    _t_desc_table.tupleDescriptors.push_back(t_tuple_desc);
+    _t_desc_table.__isset.slotDescriptors = true;
+
+    DescriptorTbl* desc_tbl = nullptr;
+    ASSERT_TRUE(DescriptorTbl::create(&_obj_pool, _t_desc_table, &desc_tbl).ok());
+    TupleDescriptor* tuple_desc = desc_tbl->get_tuple_descriptor(0);
+    ASSERT_TRUE(tuple_desc != nullptr);
+    for (auto slot : tuple_desc->slots()) {
+        _col_slots.push_back(slot);
+    }
+    _tuple_buf.resize(48);
+}
+
+Tuple* MemTableTest::make_tuple(int32_t k1, const std::string& v1,
+                                int64_t v2_int, int32_t v2_frac) {
+    memset(_tuple_buf.data(), 0, _tuple_buf.size());
+    Tuple* tuple = reinterpret_cast<Tuple*>(_tuple_buf.data());
+    _v1 = v1;
+    *reinterpret_cast<int32_t*>(tuple->get_slot(_col_slots[0]->tuple_offset())) = k1;
+    StringValue* str = tuple->get_string_slot(_col_slots[1]->tuple_offset());
+    str->ptr = const_cast<char*>(_v1.data());
+    str->len = _v1.size();
+    *reinterpret_cast<PackedInt128*>(tuple->get_slot(_col_slots[2]->tuple_offset())) =
+        DecimalV2Value(v2_int, v2_frac).value();
+    return tuple;
+}
+
+TEST_F(MemTableTest, aggregate_tuples) {
+    MemTable mem_table(_tablet_schema, KeysType::AGG_KEYS, _col_slots);
+    ASSERT_EQ(OLAP_SUCCESS, mem_table.init());
+
+    ASSERT_EQ(OLAP_SUCCESS, mem_table.insert(make_tuple(2, "bb", 1, 500000000)));
+    ASSERT_EQ(OLAP_SUCCESS, mem_table.insert(make_tuple(1, "a", 2, 250000000)));
+    ASSERT_EQ(OLAP_SUCCESS, mem_table.insert(make_tuple(2, "12345678", -3, -100000000)));
+    ASSERT_EQ(2, mem_table.size());
+    ASSERT_EQ(0, mem_table.num_filtered_rows());
+
+    RowCursor row;
+    ASSERT_EQ(OLAP_SUCCESS, row.init(_tablet_schema));
+    std::vector<char*> bufs = rows(&mem_table);
+    ASSERT_EQ(2, bufs.size());
+
+    row.attach(bufs[0]);
+    ASSERT_EQ(1, *reinterpret_cast<int32_t*>(row.get_field_content_ptr(0)));
+    StringSlice* slice = reinterpret_cast<StringSlice*>(row.get_field_content_ptr(1));
+    ASSERT_EQ("a", std::string(slice->data, slice->size));
+    decimal12_t* dec = reinterpret_cast<decimal12_t*>(row.get_field_content_ptr(2));
+    ASSERT_EQ(2, dec->integer);
+    ASSERT_EQ(250000000, dec->fraction);
+
+    // v1 is replaced and v2 is summed, 1.5 + -3.1
+    row.attach(bufs[1]);
+    ASSERT_EQ(2, *reinterpret_cast<int32_t*>(row.get_field_content_ptr(0)));
+    slice = reinterpret_cast<StringSlice*>(row.get_field_content_ptr(1));
+    ASSERT_EQ("12345678", std::string(slice->data, slice->size));
+    dec = reinterpret_cast<decimal12_t*>(row.get_field_content_ptr(2));
+    ASSERT_EQ(-1, dec->integer);
+    ASSERT_EQ(-600000000, dec->fraction);
+}
+
+TEST_F(MemTableTest, filter_invalid_tuples) {
+    MemTable mem_table(_tablet_schema, KeysType::AGG_KEYS, _col_slots);
+    ASSERT_EQ(OLAP_SUCCESS, mem_table.init());
+
+    ASSERT_EQ(OLAP_SUCCESS, mem_table.insert(make_tuple(1, "a", 1, 0)));
+    // varchar longer than its column
+    ASSERT_EQ(OLAP_ERR_INPUT_PARAMETER_ERROR,
+              mem_table.insert(make_tuple(1, "123456789", 1, 0)));
+    // integer part of decimal doesn't fit in storage
+    Tuple* tuple = make_tuple(2, "b", 0, 0);
+    *reinterpret_cast<PackedInt128*>(tuple->get_slot(_col_slots[2]->tuple_offset())) =
+        DecimalV2Value::get_max_decimal().value();
+    ASSERT_EQ(OLAP_ERR_INPUT_PARAMETER_ERROR, mem_table.insert(tuple));
+    ASSERT_EQ(1, mem_table.size());
+    ASSERT_EQ(2, mem_table.num_filtered_rows());
+
+    // filtered rows leave nothing in mem table
+    std::vector<char*> bufs = rows(&mem_table);
+    ASSERT_EQ(1, bufs.size());
+    RowCursor row;
+    ASSERT_EQ(OLAP_SUCCESS, row.init(_tablet_schema));
+    row.attach(bufs[0]);
+    StringSlice* slice = reinterpret_cast<StringSlice*>(row.get_field_content_ptr(1));
+    ASSERT_EQ("a", std::string(slice->data, slice->size));
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
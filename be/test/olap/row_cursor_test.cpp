@@ -567,6 +567,84 @@ TEST_F(TestRowCursor, AggregateWithNull) {
     ASSERT_TRUE(is_null_varchar);
 }
 
+TEST_F(TestRowCursor, AggregateBitmapUnion) {
+    std::vector<FieldInfo> tablet_schema;
+    FieldInfo k1;
+    k1.name = "k1";
+    k1.type = OLAP_FIELD_TYPE_INT;
+    k1.length = 4;
+    k1.is_key = true;
+    k1.index_length = 4;
+    k1.is_allow_null = true;
+    tablet_schema.push_back(k1);
+
+    FieldInfo v1;
+    v1.name = "v1";
+    v1.type = OLAP_FIELD_TYPE_VARCHAR;
+    v1.length = 64 + OLAP_STRING_MAX_BYTES;
+    v1.aggregation = OLAP_FIELD_AGGREGATION_BITMAP_UNION;
+    v1.is_key = false;
+    v1.is_allow_null = true;
+    tablet_schema.push_back(v1);
+
+    RowCursor row;
+    OLAPStatus res = row.init(tablet_schema);
+    ASSERT_EQ(res, OLAP_SUCCESS);
+    ASSERT_EQ(row.get_variable_len(), 64 + sizeof(BitmapContext*));
+    row.allocate_memory_for_string_type(tablet_schema);
+
+    // serialized bitmaps of {1, 2} and {2, 3}
+    std::vector<uint8_t> bufs[2];
+    for (int i = 0; i < 2; ++i) {
+        RoaringBitmap bitmap;
+        bitmap.add(i + 1);
+        bitmap.add(i + 2);
+        bufs[i].resize(bitmap.serialized_size());
+        bitmap.serialize(bufs[i].data());
+    }
+
+    int32_t key = 10;
+    RowCursor left;
+    res = left.init(tablet_schema);
+    StringSlice l_bitmap(reinterpret_cast<char*>(bufs[0].data()), bufs[0].size());
+    left.set_field_content(0, reinterpret_cast<char*>(&key), _mem_pool.get());
+    left.set_field_content(1, reinterpret_cast<char*>(&l_bitmap), _mem_pool.get());
+    res = row.agg_init(left);
+    ASSERT_EQ(res, OLAP_SUCCESS);
+
+    RowCursor right;
+    res = right.init(tablet_schema);
+    StringSlice r_bitmap(reinterpret_cast<char*>(bufs[1].data()), bufs[1].size());
+    right.set_field_content(0, reinterpret_cast<char*>(&key), _mem_pool.get());
+    right.set_field_content(1, reinterpret_cast<char*>(&r_bitmap), _mem_pool.get());
+    row.aggregate(right);
+    right.set_null(1);
+    row.aggregate(right);
+    ASSERT_EQ(OLAP_SUCCESS, row.finalize_one_merge());
+
+    ASSERT_FALSE(row.is_null(1));
+    StringSlice* agg_bitmap = reinterpret_cast<StringSlice*>(row.get_field_content_ptr(1));
+    RoaringBitmap result;
+    ASSERT_TRUE(result.unserialize(reinterpret_cast<uint8_t*>(agg_bitmap->data),
+                                   agg_bitmap->size));
+    ASSERT_EQ(3, result.cardinality());
+
+    // bitmap larger than column can not be stored
+    res = row.agg_init(left);
+    ASSERT_EQ(res, OLAP_SUCCESS);
+    for (int i = 0; i < 10; ++i) {
+        RoaringBitmap bitmap;
+        bitmap.add(i * 65536);
+        std::vector<uint8_t> buf(bitmap.serialized_size());
+        bitmap.serialize(buf.data());
+        StringSlice slice(reinterpret_cast<char*>(buf.data()), buf.size());
+        right.set_not_null(1);
+        right.set_field_content(1, reinterpret_cast<char*>(&slice), _mem_pool.get());
+        row.aggregate(right);
+    }
+    ASSERT_EQ(OLAP_ERR_BUFFER_OVERFLOW, row.finalize_one_merge());
+}
+
 } // namespace palo
 
 int main(int argc, char** argv) {
@@ -681,7 +681,7 @@ public:
     void CreateReader() {
         ASSERT_EQ(OLAP_SUCCESS, helper.open_with_mode("tmp_file", 
                 O_CREAT | O_EXCL | O_WRONLY, S_IRUSR | S_IWUSR));
-        _out_stream->write_to_file(&helper, 0);
+        _out_stream->write_to_file(&helper);
         helper.close();
 
         ASSERT_EQ(OLAP_SUCCESS, helper.open_with_mode("tmp_file", 
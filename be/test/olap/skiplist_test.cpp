@@ -0,0 +1,115 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "olap/skiplist.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+namespace palo {
+
+// key is (sort key, insert sequence)
+typedef std::pair<int, int> TestKey;
+
+struct TestComparator {
+    int operator()(const TestKey& a, const TestKey& b) const {
+        if (a.first < b.first) {
+            return -1;
+        } else if (a.first > b.first) {
+            return 1;
+        }
+        return 0;
+    }
+};
+
+class SkipListTest : public testing::Test {
+public:
+    SkipListTest() : _tracker(-1), _pool(&_tracker) { }
+
+protected:
+    MemTracker _tracker;
+    MemPool _pool;
+};
+
+TEST_F(SkipListTest, empty) {
+    SkipList<TestKey, TestComparator> list(TestComparator(), &_pool);
+    ASSERT_EQ(0, list.size());
+    ASSERT_TRUE(list.find(TestKey(10, 0)) == nullptr);
+
+    SkipList<TestKey, TestComparator>::Iterator it(&list);
+    it.seek_to_first();
+    ASSERT_FALSE(it.valid());
+}
+
+TEST_F(SkipListTest, insert_and_find) {
+    SkipList<TestKey, TestComparator> list(TestComparator(), &_pool);
+    std::vector<TestKey> keys;
+    for (int i = 0; i < 2000; ++i) {
+        TestKey key(rand() % 500, i);
+        list.insert(key);
+        keys.push_back(key);
+    }
+    ASSERT_EQ(2000, list.size());
+
+    // equal keys are kept in insertion order
+    std::stable_sort(keys.begin(), keys.end(),
+                     [] (const TestKey& a, const TestKey& b) { return a.first < b.first; });
+    SkipList<TestKey, TestComparator>::Iterator it(&list);
+    size_t idx = 0;
+    for (it.seek_to_first(); it.valid(); it.next()) {
+        ASSERT_EQ(keys[idx].first, it.key().first);
+        ASSERT_EQ(keys[idx].second, it.key().second);
+        ++idx;
+    }
+    ASSERT_EQ(keys.size(), idx);
+
+    // find returns the first inserted one of equal keys
+    for (int k = 0; k < 500; ++k) {
+        auto pos = std::find_if(keys.begin(), keys.end(),
+                                [k] (const TestKey& key) { return key.first == k; });
+        TestKey* found = list.find(TestKey(k, -1));
+        if (pos == keys.end()) {
+            ASSERT_TRUE(found == nullptr);
+        } else {
+            ASSERT_TRUE(found != nullptr);
+            ASSERT_EQ(pos->second, found->second);
+        }
+    }
+    ASSERT_TRUE(list.find(TestKey(500, 0)) == nullptr);
+    ASSERT_TRUE(list.find(TestKey(-1, 0)) == nullptr);
+}
+
+TEST_F(SkipListTest, update_found) {
+    SkipList<TestKey, TestComparator> list(TestComparator(), &_pool);
+    list.insert(TestKey(1, 0));
+    list.insert(TestKey(2, 0));
+    TestKey* found = list.find(TestKey(2, 0));
+    ASSERT_TRUE(found != nullptr);
+    found->second = 100;
+    ASSERT_EQ(100, list.find(TestKey(2, 0))->second);
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -16,6 +16,7 @@
 #include "runtime/datetime_value.h"
 
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -1383,10 +1384,56 @@ TEST_F(DateTimeValueTest, packed_time) {
         v1.to_datetime_val(&tv2);
 
         ASSERT_TRUE(tv == tv2);
+        ASSERT_EQ(2001, DateTimeValue::year_of_packed(tv.packed_time));
+        ASSERT_EQ(2, DateTimeValue::month_of_packed(tv.packed_time));
+        ASSERT_EQ(3, DateTimeValue::day_of_packed(tv.packed_time));
     }
 
 }
 
+TEST_F(DateTimeValueTest, daynr_round_trip) {
+    DateTimeValue value;
+    // From 0000-01-01 to 9999-12-31
+    for (uint64_t daynr = 1; daynr <= 3652424; ++daynr) {
+        ASSERT_TRUE(value.from_date_daynr(daynr));
+        ASSERT_EQ(daynr, value.daynr());
+    }
+    ASSERT_EQ(3652424, DateTimeValue::calc_daynr(9999, 12, 31));
+    ASSERT_EQ(730120, DateTimeValue::calc_daynr(1999, 1, 1));
+    ASSERT_EQ(730544, DateTimeValue::calc_daynr(2000, 2, 29));
+    ASSERT_EQ(730545, DateTimeValue::calc_daynr(2000, 3, 1));
+}
+
+TEST_F(DateTimeValueTest, compiled_date_format) {
+    const char* formats[] = {
+        "%Y-%m-%d %H", "%Y%m%d", "%a %b %c %D %e %f %h %I %i %j %k %l %M %p %r %S %T",
+        "%u %U %v %V %w %W %x %X %y", "%%Y %Q%", "no specifier", ""
+    };
+    DateTimeValue values[3];
+    values[0].from_date_int64(20150215);
+    values[1].from_date_int64(20001231235959L);
+    values[2].from_date_int64(99991231000001L);
+    char expected[128];
+    for (const char* format : formats) {
+        int len = strlen(format);
+        CompiledDateFormat compiled;
+        ASSERT_TRUE(compiled.compile(format, len));
+        std::vector<char> buf(compiled.max_length() + 1);
+        for (const DateTimeValue& value : values) {
+            ASSERT_TRUE(value.to_format_string(format, len, expected));
+            char* end = compiled.format(value, buf.data());
+            ASSERT_TRUE(end != NULL);
+            ASSERT_LE(end - buf.data(), compiled.max_length());
+            ASSERT_EQ(std::string(expected), std::string(buf.data(), end - buf.data()));
+        }
+    }
+
+    // Too long
+    std::string format(200, 'a');
+    CompiledDateFormat compiled;
+    ASSERT_FALSE(compiled.compile(format.c_str(), format.size()));
+}
+
 }
 
 int main(int argc, char** argv) {
@@ -0,0 +1,104 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/decimalv2_value.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+TEST(DecimalV2ValueTest, parse_and_print) {
+    DecimalV2Value value(std::string("1.23"));
+    ASSERT_EQ("1.23", value.to_string());
+    ASSERT_EQ("1.230", value.to_string(3));
+    ASSERT_EQ("1", value.to_string(0));
+    ASSERT_EQ(1, value.int_value());
+    ASSERT_EQ(230000000, value.frac_value());
+
+    // no sign if printed digits are zero
+    ASSERT_EQ("-0.05", DecimalV2Value(std::string("-0.05")).to_string(2));
+    ASSERT_EQ("0", DecimalV2Value(std::string("-0.05")).to_string(0));
+
+    // fraction digits beyond 9 are truncated
+    DecimalV2Value truncated;
+    ASSERT_EQ(E_DEC_TRUNCATED, truncated.parse_from_str("0.1234567891", 12));
+    ASSERT_EQ("0.123456789", truncated.to_string());
+
+    DecimalV2Value bad;
+    ASSERT_EQ(E_DEC_BAD_NUM, bad.parse_from_str("abc", 3));
+    DecimalV2Value overflow;
+    ASSERT_EQ(E_DEC_OVERFLOW, overflow.parse_from_str("1000000000000000000000000000", 28));
+}
+
+TEST(DecimalV2ValueTest, arithmetic) {
+    DecimalV2Value a(std::string("12.5"));
+    DecimalV2Value b(std::string("-3.25"));
+    ASSERT_EQ("9.25", (a + b).to_string());
+    ASSERT_EQ("15.75", (a - b).to_string());
+    ASSERT_EQ("-40.625", (a * b).to_string());
+    ASSERT_EQ("-3.846153846", (a / b).to_string());
+    ASSERT_EQ("2.75", (a % b).to_string());
+    ASSERT_TRUE(b < a);
+    ASSERT_TRUE(a == DecimalV2Value(std::string("12.500")));
+
+    DecimalV2Value result;
+    ASSERT_EQ(E_DEC_OK, DecimalV2Value::div(DecimalV2Value(1), DecimalV2Value(3), &result));
+    ASSERT_EQ("0.333333333", result.to_string());
+    ASSERT_EQ(E_DEC_DIV_ZERO, DecimalV2Value::div(a, DecimalV2Value(), &result));
+    ASSERT_EQ(E_DEC_DIV_ZERO, DecimalV2Value::mod(a, DecimalV2Value(), &result));
+}
+
+TEST(DecimalV2ValueTest, overflow) {
+    DecimalV2Value max = DecimalV2Value::get_max_decimal();
+    ASSERT_EQ("999999999999999999999999999.999999999", max.to_string());
+
+    DecimalV2Value result;
+    ASSERT_EQ(E_DEC_OVERFLOW, DecimalV2Value::add(max, DecimalV2Value(1), &result));
+    ASSERT_TRUE(result == max);
+    ASSERT_EQ(E_DEC_OVERFLOW, DecimalV2Value::mul(max, DecimalV2Value(2), &result));
+    ASSERT_TRUE(result == max);
+    ASSERT_EQ(E_DEC_OVERFLOW, DecimalV2Value::sub(-max, DecimalV2Value(1), &result));
+    ASSERT_TRUE(result == DecimalV2Value::get_min_decimal());
+
+    // large operands of multiplication don't overflow int128
+    ASSERT_EQ(E_DEC_OK, DecimalV2Value::mul(max, DecimalV2Value(std::string("0.5")), &result));
+    ASSERT_EQ("499999999999999999999999999.999999999", result.to_string());
+}
+
+TEST(DecimalV2ValueTest, convert) {
+    DecimalV2Value value;
+    value.assign_from_double(0.3);
+    ASSERT_EQ("0.3", value.to_string());
+    value.assign_from_double(-1.5e10);
+    ASSERT_EQ("-15000000000", value.to_string());
+    ASSERT_EQ(-15000000000L, static_cast<int64_t>(value));
+
+    DecimalValue old_value(std::string("-123.456"));
+    ASSERT_EQ("-123.456", DecimalV2Value::from_decimal_value(old_value).to_string());
+    ASSERT_TRUE(DecimalV2Value(std::string("-123.456")).to_decimal_value() == old_value);
+
+    // the same format as decimal12_t of storage
+    DecimalV2Value olap_value = DecimalV2Value::from_olap_decimal(-5, -100000000);
+    ASSERT_EQ("-5.1", olap_value.to_string());
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
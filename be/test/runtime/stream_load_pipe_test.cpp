@@ -0,0 +1,113 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "runtime/stream_load_pipe.h"
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+#include <chrono>
+#include <thread>
+
+namespace palo {
+
+class StreamLoadPipeTest : public testing::Test {
+public:
+    StreamLoadPipeTest() { }
+    virtual ~StreamLoadPipeTest() { }
+    void SetUp() override { }
+};
+
+TEST_F(StreamLoadPipeTest, append_read) {
+    StreamLoadPipe pipe(66, 64);
+
+    auto appender = [&pipe] {
+        for (int i = 0; i < 128; ++i) {
+            char buf = '0' + (i % 10);
+            pipe.append(&buf, 1);
+        }
+        pipe.finish();
+    };
+    std::thread t1(appender);
+
+    char buf[256];
+    size_t buf_len = 256;
+    bool eof = false;
+    size_t total = 0;
+    while (!eof) {
+        size_t read_len = buf_len - total;
+        auto st = pipe.read((uint8_t*)buf + total, &read_len, &eof);
+        ASSERT_TRUE(st.ok());
+        total += read_len;
+    }
+    t1.join();
+
+    ASSERT_EQ(128, total);
+    for (int i = 0; i < 128; ++i) {
+        ASSERT_EQ('0' + (i % 10), buf[i]);
+    }
+}
+
+TEST_F(StreamLoadPipeTest, append_block) {
+    StreamLoadPipe pipe(10, 10);
+
+    // second append will be blocked until first is consumed
+    auto appender = [&pipe] {
+        ASSERT_TRUE(pipe.append("0123456789", 10).ok());
+        ASSERT_TRUE(pipe.append("abcdefghij", 10).ok());
+        pipe.finish();
+    };
+    std::thread t1(appender);
+
+    char buf[32];
+    size_t total = 0;
+    bool eof = false;
+    while (!eof) {
+        size_t read_len = 5;
+        auto st = pipe.read((uint8_t*)buf + total, &read_len, &eof);
+        ASSERT_TRUE(st.ok());
+        total += read_len;
+    }
+    t1.join();
+    ASSERT_EQ(20, total);
+    ASSERT_EQ(0, memcmp("0123456789abcdefghij", buf, 20));
+}
+
+TEST_F(StreamLoadPipeTest, cancel) {
+    StreamLoadPipe pipe(10, 10);
+
+    auto appender = [&pipe] {
+        ASSERT_TRUE(pipe.append("0123456789", 10).ok());
+        // blocked because buffer is full, until pipe is cancelled
+        ASSERT_FALSE(pipe.append("abcdefghij", 10).ok());
+    };
+    std::thread t1(appender);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pipe.cancel();
+    t1.join();
+
+    char buf[32];
+    size_t read_len = 32;
+    bool eof = false;
+    ASSERT_FALSE(pipe.read((uint8_t*)buf, &read_len, &eof).ok());
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
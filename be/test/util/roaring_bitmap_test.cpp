@@ -0,0 +1,98 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/roaring_bitmap.h"
+
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+TEST(RoaringBitmapTest, add) {
+    RoaringBitmap bitmap;
+    ASSERT_TRUE(bitmap.empty());
+    bitmap.add(1);
+    bitmap.add(1);
+    bitmap.add(65536 + 2);
+    bitmap.add(1ULL << 40);
+    ASSERT_EQ(3, bitmap.cardinality());
+    ASSERT_TRUE(bitmap.contains(1));
+    ASSERT_TRUE(bitmap.contains(65536 + 2));
+    ASSERT_TRUE(bitmap.contains(1ULL << 40));
+    ASSERT_FALSE(bitmap.contains(2));
+
+    // dense container is converted to bitset
+    for (uint64_t i = 0; i < 10000; ++i) {
+        bitmap.add(i * 3);
+    }
+    ASSERT_EQ(10000 + 3, bitmap.cardinality());
+    ASSERT_TRUE(bitmap.contains(9999 * 3));
+    ASSERT_FALSE(bitmap.contains(9999 * 3 + 1));
+}
+
+TEST(RoaringBitmapTest, merge) {
+    RoaringBitmap a;
+    RoaringBitmap b;
+    std::set<uint64_t> expected;
+    for (uint64_t i = 0; i < 20000; ++i) {
+        uint64_t value = i * 7 % 150000;
+        a.add(value);
+        expected.insert(value);
+        value = i * 13 % 300000;
+        b.add(value);
+        expected.insert(value);
+    }
+    RoaringBitmap c = a;
+    c.merge(b);
+    ASSERT_EQ(expected.size(), c.cardinality());
+
+    // merge serialized bitmap
+    std::vector<uint8_t> buf(b.serialized_size());
+    b.serialize(buf.data());
+    a.merge(buf.data(), buf.size());
+    ASSERT_EQ(expected.size(), a.cardinality());
+    for (uint64_t value : expected) {
+        ASSERT_TRUE(a.contains(value));
+    }
+}
+
+TEST(RoaringBitmapTest, serialize) {
+    RoaringBitmap bitmap;
+    ASSERT_TRUE(bitmap.unserialize(NULL, 0));
+    ASSERT_TRUE(bitmap.empty());
+
+    for (uint64_t i = 0; i < 5000; ++i) {
+        bitmap.add(i);
+        bitmap.add(i * 100);
+    }
+    std::vector<uint8_t> buf(bitmap.serialized_size());
+    bitmap.serialize(buf.data());
+    RoaringBitmap other;
+    ASSERT_TRUE(other.unserialize(buf.data(), buf.size()));
+    ASSERT_EQ(bitmap.cardinality(), other.cardinality());
+    ASSERT_EQ(buf.size(), other.serialized_size());
+
+    ASSERT_FALSE(other.unserialize(buf.data(), buf.size() - 1));
+    ASSERT_FALSE(other.unserialize(buf.data(), 2));
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
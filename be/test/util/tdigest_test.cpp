@@ -0,0 +1,90 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/tdigest.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+TEST(TDigestTest, empty) {
+    TDigest digest;
+    ASSERT_TRUE(isnan(digest.quantile(0.5)));
+
+    digest.add(3);
+    ASSERT_EQ(3, digest.quantile(0));
+    ASSERT_EQ(3, digest.quantile(0.5));
+    ASSERT_EQ(3, digest.quantile(1));
+}
+
+TEST(TDigestTest, uniform) {
+    TDigest digest;
+    for (int i = 1; i <= 100000; ++i) {
+        digest.add(i);
+    }
+    ASSERT_EQ(1, digest.quantile(0));
+    ASSERT_EQ(100000, digest.quantile(1));
+    ASSERT_NEAR(50000, digest.quantile(0.5), 100000 * 0.01);
+    ASSERT_NEAR(99000, digest.quantile(0.99), 100000 * 0.001);
+    ASSERT_NEAR(99900, digest.quantile(0.999), 100000 * 0.0002);
+    ASSERT_NEAR(1000, digest.quantile(0.01), 100000 * 0.001);
+}
+
+TEST(TDigestTest, merge_and_serialize) {
+    std::mt19937 gen(1);
+    std::exponential_distribution<double> dist(1);
+    std::vector<double> values;
+    TDigest merged;
+    for (int part = 0; part < 10; ++part) {
+        TDigest digest;
+        for (int i = 0; i < 10000; ++i) {
+            double value = dist(gen);
+            values.push_back(value);
+            digest.add(value);
+        }
+        std::vector<uint8_t> buf(digest.serialized_size());
+        digest.serialize(&buf[0]);
+
+        TDigest received;
+        ASSERT_TRUE(received.unserialize(&buf[0], buf.size()));
+        ASSERT_FALSE(received.unserialize(&buf[0], buf.size() - 1));
+        merged.merge(received);
+    }
+    ASSERT_EQ(values.size(), merged.total_weight());
+
+    std::sort(values.begin(), values.end());
+    for (double q : {0.1, 0.5, 0.9, 0.99}) {
+        double expected = values[static_cast<size_t>(q * values.size())];
+        ASSERT_NEAR(expected, merged.quantile(q), expected * 0.02) << "q=" << q;
+    }
+    ASSERT_EQ(values.front(), merged.quantile(0));
+    ASSERT_EQ(values.back(), merged.quantile(1));
+
+    // bounded size
+    ASSERT_LT(merged.serialized_size(), 16 * 1024);
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2018, Baidu.com, Inc. All Rights Reserved
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "util/topn_counter.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace palo {
+
+TEST(TopNCounterTest, exact) {
+    TopNCounter counter(10);
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            counter.add(std::to_string(i));
+        }
+    }
+    std::vector<std::pair<std::string, uint64_t> > top;
+    counter.top(3, &top);
+    ASSERT_EQ(3, top.size());
+    ASSERT_EQ("4", top[0].first);
+    ASSERT_EQ(5, top[0].second);
+    ASSERT_EQ("3", top[1].first);
+    ASSERT_EQ(4, top[1].second);
+    ASSERT_EQ("2", top[2].first);
+    ASSERT_EQ(3, top[2].second);
+}
+
+TEST(TopNCounterTest, skewed) {
+    // value i appears about 1/(i+1) of times, with a long tail
+    std::mt19937 gen(1);
+    std::vector<double> weights;
+    for (int i = 0; i < 10000; ++i) {
+        weights.push_back(1.0 / (i + 1));
+    }
+    std::discrete_distribution<int> dist(weights.begin(), weights.end());
+
+    TopNCounter merged(100);
+    for (int part = 0; part < 4; ++part) {
+        TopNCounter counter(100);
+        for (int i = 0; i < 50000; ++i) {
+            counter.add("v" + std::to_string(dist(gen)));
+        }
+        ASSERT_EQ(100, counter.size());
+        std::vector<uint8_t> buf(counter.serialized_size());
+        counter.serialize(&buf[0]);
+
+        TopNCounter received(1);
+        ASSERT_TRUE(received.unserialize(&buf[0], buf.size()));
+        ASSERT_FALSE(received.unserialize(&buf[0], buf.size() - 1));
+        ASSERT_EQ(100, received.capacity());
+        merged.merge(received);
+        ASSERT_EQ(100, merged.size());
+    }
+
+    std::vector<std::pair<std::string, uint64_t> > top;
+    merged.top(5, &top);
+    ASSERT_EQ(5, top.size());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ("v" + std::to_string(i), top[i].first);
+    }
+}
+
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -94,7 +94,8 @@ public class CastExpr extends Expr {
                     continue;
                 }
                 // Disable casting from boolean/timestamp to decimal
-                if ((fromType.isBoolean() || fromType.isDateType()) && toType == Type.DECIMAL) {
+                if ((fromType.isBoolean() || fromType.isDateType())
+                        && (toType == Type.DECIMAL || toType == Type.DECIMALV2)) {
                     continue;
                 }
 //                if (fromType.getPrimitiveType() == PrimitiveType.CHAR
@@ -138,7 +139,12 @@ public class CastExpr extends Expr {
                 if (fromType.equals(toType)) {
                     continue;
                 }
-                String beClass = toType.isDecimal() || fromType.isDecimal() ? "DecimalOperators" : "CastFunctions";
+                String beClass = "CastFunctions";
+                if (toType.isDecimalV2() || fromType.isDecimalV2()) {
+                    beClass = "DecimalV2Operators";
+                } else if (toType.isDecimal() || fromType.isDecimal()) {
+                    beClass = "DecimalOperators";
+                }
                 String typeName = Function.getUdfTypeName(toType.getPrimitiveType());
                 if (toType.getPrimitiveType() == PrimitiveType.DATE) {
                     typeName = "date_val";
@@ -133,6 +133,7 @@ public class DecimalLiteral extends LiteralExpr {
                 buffer.putLong(value.longValue());
                 break;
             case DECIMAL:
+            case DECIMALV2:
                 buffer = ByteBuffer.allocate(12);
                 buffer.order(ByteOrder.LITTLE_ENDIAN);
 
@@ -222,6 +223,11 @@ public class DecimalLiteral extends LiteralExpr {
             return new IntLiteral(value.longValue(), targetType);
         } else if (targetType.isStringType()) {
             return new StringLiteral(value.toString());
+        } else if (targetType.isDecimal() || targetType.isDecimalV2()) {
+            // BE parses the same literal string into either decimal type
+            DecimalLiteral literal = new DecimalLiteral(this);
+            literal.type = targetType;
+            return literal;
         }
         return super.uncheckedCastTo(targetType);
     }
@@ -155,7 +155,8 @@ public class FloatLiteral extends LiteralExpr {
 
     @Override
     protected Expr uncheckedCastTo(Type targetType) throws AnalysisException {
-        if (!(targetType.isFloatingPointType() || targetType.isDecimal())) {
+        if (!(targetType.isFloatingPointType() || targetType.isDecimal()
+                || targetType.isDecimalV2())) {
             return super.uncheckedCastTo(targetType);
         }
         if (targetType.isFloatingPointType()) {
@@ -163,6 +164,8 @@ public class FloatLiteral extends LiteralExpr {
             return this;
         } else if (targetType.isDecimal()) {
             return new DecimalLiteral(new BigDecimal(value));
+        } else if (targetType.isDecimalV2()) {
+            return new DecimalLiteral(new BigDecimal(value)).uncheckedCastTo(targetType);
         }
         return this;
     }
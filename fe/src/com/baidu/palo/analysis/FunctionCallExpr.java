@@ -321,6 +321,40 @@ public class FunctionCallExpr extends Expr {
             return;
         }
 
+        if (fnName.getFunction().equalsIgnoreCase("percentile_approx")) {
+            if (children.size() != 2) {
+                throw new AnalysisException(
+                        "percentile_approx requires two parameters: " + this.toSql());
+            }
+            if (getChild(0).type.isHllType()) {
+                throw new AnalysisException(
+                        "percentile_approx requires first parameter can't be of type HLL: " + this.toSql());
+            }
+            if (!getChild(1).isConstant()) {
+                throw new AnalysisException(
+                        "percentile_approx requires second parameter to be a constant: " + this.toSql());
+            }
+            return;
+        }
+
+        if (fnName.getFunction().equalsIgnoreCase("topn")) {
+            if (children.size() != 2 && children.size() != 3) {
+                throw new AnalysisException(
+                        "topn requires two or three parameters: " + this.toSql());
+            }
+            if (getChild(0).type.isHllType()) {
+                throw new AnalysisException(
+                        "topn requires first parameter can't be of type HLL: " + this.toSql());
+            }
+            for (int i = 1; i < children.size(); i++) {
+                if (!getChild(i).isConstant()) {
+                    throw new AnalysisException(
+                            "topn requires parameter " + (i + 1) + " to be a constant: " + this.toSql());
+                }
+            }
+            return;
+        }
+
         if (fnName.getFunction().equalsIgnoreCase("lag")
                 || fnName.getFunction().equalsIgnoreCase("lead")) {
             if (!isAnalyticFnCall) {
@@ -312,6 +312,8 @@ public class IntLiteral extends LiteralExpr {
             return new FloatLiteral(new Double(value), targetType);
         } else if (targetType.isDecimal()) {
             return new DecimalLiteral(new BigDecimal(value));
+        } else if (targetType.isDecimalV2()) {
+            return new DecimalLiteral(new BigDecimal(value)).uncheckedCastTo(targetType);
         }
         return this;
     }
@@ -192,6 +192,8 @@ public class LargeIntLiteral extends LiteralExpr {
             return new FloatLiteral(new Double(value.doubleValue()), targetType);
         } else if (targetType.isDecimal()) {
             return new DecimalLiteral(new BigDecimal(value));
+        } else if (targetType.isDecimalV2()) {
+            return new DecimalLiteral(new BigDecimal(value)).uncheckedCastTo(targetType);
         } else if (!targetType.isNumericType()) {
             return super.uncheckedCastTo(targetType);
         }
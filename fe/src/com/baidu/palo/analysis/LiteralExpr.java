@@ -73,6 +73,9 @@ public abstract class LiteralExpr extends Expr {
             case DECIMAL:
                 literalExpr = new DecimalLiteral(value);
                 break;
+            case DECIMALV2:
+                literalExpr = (LiteralExpr) new DecimalLiteral(value).uncheckedCastTo(type);
+                break;
             case CHAR:
             case VARCHAR:
             case HLL:
@@ -190,6 +190,8 @@ public class StringLiteral extends LiteralExpr {
                     break;
                 case DECIMAL:
                     return new DecimalLiteral(value);
+                case DECIMALV2:
+                    return new DecimalLiteral(value).uncheckedCastTo(targetType);
                 default:
                     break;
             }
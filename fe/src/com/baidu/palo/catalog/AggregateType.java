@@ -32,7 +32,8 @@ public enum AggregateType {
     MAX("MAX"),
     REPLACE("REPLACE"),
     HLL_UNION("HLL_UNION"),
-    NONE("NONE");
+    NONE("NONE"),
+    BITMAP_UNION("BITMAP_UNION");
 
     private static EnumMap<AggregateType, EnumSet<PrimitiveType>> compatibilityMap;
 
@@ -48,6 +49,7 @@ public enum AggregateType {
         primitiveTypeList.add(PrimitiveType.FLOAT);
         primitiveTypeList.add(PrimitiveType.DOUBLE);
         primitiveTypeList.add(PrimitiveType.DECIMAL);
+        primitiveTypeList.add(PrimitiveType.DECIMALV2);
         compatibilityMap.put(SUM, EnumSet.copyOf(primitiveTypeList));
 
         primitiveTypeList.clear();
@@ -59,6 +61,7 @@ public enum AggregateType {
         primitiveTypeList.add(PrimitiveType.FLOAT);
         primitiveTypeList.add(PrimitiveType.DOUBLE);
         primitiveTypeList.add(PrimitiveType.DECIMAL);
+        primitiveTypeList.add(PrimitiveType.DECIMALV2);
         primitiveTypeList.add(PrimitiveType.DATE);
         primitiveTypeList.add(PrimitiveType.DATETIME);
         compatibilityMap.put(MIN, EnumSet.copyOf(primitiveTypeList));
@@ -72,6 +75,7 @@ public enum AggregateType {
         primitiveTypeList.add(PrimitiveType.FLOAT);
         primitiveTypeList.add(PrimitiveType.DOUBLE);
         primitiveTypeList.add(PrimitiveType.DECIMAL);
+        primitiveTypeList.add(PrimitiveType.DECIMALV2);
         primitiveTypeList.add(PrimitiveType.DATE);
         primitiveTypeList.add(PrimitiveType.DATETIME);
         compatibilityMap.put(MAX, EnumSet.copyOf(primitiveTypeList));
@@ -82,6 +86,11 @@ public enum AggregateType {
         primitiveTypeList.clear();
         primitiveTypeList.add(PrimitiveType.HLL);
         compatibilityMap.put(HLL_UNION, EnumSet.copyOf(primitiveTypeList));
+
+        // bitmaps are serialized into varchar
+        primitiveTypeList.clear();
+        primitiveTypeList.add(PrimitiveType.VARCHAR);
+        compatibilityMap.put(BITMAP_UNION, EnumSet.copyOf(primitiveTypeList));
     
         compatibilityMap.put(NONE, EnumSet.allOf(PrimitiveType.class));
     }
@@ -122,6 +131,8 @@ public enum AggregateType {
                 return TAggregationType.NONE;
             case HLL_UNION:
                 return TAggregationType.HLL_UNION;
+            case BITMAP_UNION:
+                return TAggregationType.BITMAP_UNION;
             default:
                 return null;
         }
@@ -263,6 +263,7 @@ public class Column implements Writable {
                 FloatLiteral doubleLiteral = new FloatLiteral(defaultValue);
                 break;
             case DECIMAL:
+            case DECIMALV2:
                 DecimalLiteral decimalLiteral = new DecimalLiteral(defaultValue);
                 decimalLiteral.checkPrecisionAndScale(columnType.getPrecision(), columnType.getScale());
                 break;
@@ -123,6 +123,8 @@ public class ColumnType implements Writable {
                 return createType(type);
             case DECIMAL:
                 return createDecimal(27, 9);
+            case DECIMALV2:
+                return createDecimalV2(27, 9);
             case CHAR:
             case VARCHAR:
                 return createVarchar(64);
@@ -163,6 +165,13 @@ public class ColumnType implements Writable {
         return type;
     }
 
+    public static ColumnType createDecimalV2(int precision, int scale) {
+        ColumnType type = new ColumnType(PrimitiveType.DECIMALV2);
+        type.precision = precision;
+        type.scale = scale;
+        return type;
+    }
+
     public PrimitiveType getType() {
         return type;
     }
@@ -223,6 +232,8 @@ public class ColumnType implements Writable {
                 return 8;
             case DECIMAL:
                 return 40;
+            case DECIMALV2:
+                return 16;
             case CHAR:
             case VARCHAR:
                 return len;
@@ -281,6 +292,23 @@ public class ColumnType implements Writable {
                             + " Scale is " + scale + " and precision is " + precision);
                 }
                 break;
+            case DECIMALV2:
+                // precision: [1, 27]
+                if (precision < 1 || precision > ScalarType.MAX_DECIMALV2_PRECISION) {
+                    throw new AnalysisException("Precision of decimalv2 must between 1 and 27."
+                            + " Precision was set to: " + precision + ".");
+                }
+                // scale: [0, 9]
+                if (scale < 0 || scale > ScalarType.MAX_DECIMALV2_SCALE) {
+                    throw new AnalysisException("Scale of decimalv2 must between 0 and 9."
+                            + " Scale was set to: " + scale + ".");
+                }
+                // integer part is stored as int64
+                if (precision - scale > 18) {
+                    throw new AnalysisException("Integer digits of decimalv2 must not exceed 18."
+                            + " Scale is " + scale + " and precision is " + precision);
+                }
+                break;
             default:
                 // do nothing
         }
@@ -303,6 +331,9 @@ public class ColumnType implements Writable {
             case DECIMAL:
                 stringBuilder.append("decimal").append("(").append(precision).append(", ").append(scale).append(")");
                 break;
+            case DECIMALV2:
+                stringBuilder.append("decimalv2").append("(").append(precision).append(", ").append(scale).append(")");
+                break;
             case BOOLEAN:
                 stringBuilder.append("tinyint(1)");
                 break;
@@ -341,7 +372,7 @@ public class ColumnType implements Writable {
         if (type == PrimitiveType.CHAR || type == PrimitiveType.VARCHAR || type == PrimitiveType.HLL) {
             thrift.setLen(len);
         }
-        if (type == PrimitiveType.DECIMAL) {
+        if (type == PrimitiveType.DECIMAL || type == PrimitiveType.DECIMALV2) {
             thrift.setPrecision(precision);
             thrift.setScale(scale);
         }
@@ -357,7 +388,7 @@ public class ColumnType implements Writable {
         if (type != other.type) {
             return false;
         }
-        if (type == PrimitiveType.DECIMAL) {
+        if (type == PrimitiveType.DECIMAL || type == PrimitiveType.DECIMALV2) {
             return scale == other.scale && precision == other.precision;
         } else if (type == PrimitiveType.CHAR) {
             return len == other.len;
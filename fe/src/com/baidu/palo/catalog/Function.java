@@ -402,6 +402,8 @@ public class Function {
                 return "datetime_val";
             case DECIMAL:
                 return "decimal_val";
+            case DECIMALV2:
+                return "decimalv2_val";
             default:
                 Preconditions.checkState(false, t.toString());
                 return "";
@@ -437,6 +439,8 @@ public class Function {
                 return "DateTimeVal";
             case DECIMAL:
                 return "DecimalVal";
+            case DECIMALV2:
+                return "DecimalV2Val";
             default:
                 Preconditions.checkState(false, t.toString());
                 return "";
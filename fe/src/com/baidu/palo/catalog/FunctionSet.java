@@ -95,6 +95,8 @@ public class FunctionSet {
                     "3minIN8palo_udf11DateTimeValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.DECIMAL,
                     "3minIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextERKT_PS6_")
+                .put(Type.DECIMALV2,
+                    "3minIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.LARGEINT,
                     "3minIN8palo_udf11LargeIntValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .build();
@@ -125,6 +127,8 @@ public class FunctionSet {
                     "3maxIN8palo_udf11DateTimeValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.DECIMAL,
                     "3maxIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextERKT_PS6_")
+                .put(Type.DECIMALV2,
+                    "3maxIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.LARGEINT,
                     "3maxIN8palo_udf11LargeIntValEEEvPNS2_15FunctionContextERKT_PS6_")
                .build();
@@ -286,6 +290,8 @@ public class FunctionSet {
                     "10hll_updateIN8palo_udf11DateTimeValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
                 .put(Type.DECIMAL,
                     "10hll_updateIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
+                .put(Type.DECIMALV2,
+                    "10hll_updateIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
                 .put(Type.LARGEINT,
                     "10hll_updateIN8palo_udf11LargeIntValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
                 .build();
@@ -298,6 +304,18 @@ public class FunctionSet {
                 .put(Type.HLL,
                     "20hll_union_agg_updateEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_")
                 .build();
+
+    private static final Map<Type, String> BITMAP_UNION_INT_UPDATE_SYMBOL =
+        ImmutableMap.<Type, String>builder()
+                .put(Type.TINYINT,
+                    "17bitmap_update_intIN8palo_udf10TinyIntValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
+                .put(Type.SMALLINT,
+                    "17bitmap_update_intIN8palo_udf11SmallIntValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
+                .put(Type.INT,
+                    "17bitmap_update_intIN8palo_udf6IntValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
+                .put(Type.BIGINT,
+                    "17bitmap_update_intIN8palo_udf9BigIntValEEEvPNS2_15FunctionContextERKT_PNS2_9StringValE")
+                .build();
  
     private static final Map<Type, String> OFFSET_FN_INIT_SYMBOL =
         ImmutableMap.<Type, String>builder()
@@ -305,6 +323,8 @@ public class FunctionSet {
                      "14offset_fn_initIN8palo_udf10BooleanValEEEvPNS2_15FunctionContextEPT_")
                 .put(Type.DECIMAL,
                      "14offset_fn_initIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextEPT_")
+                .put(Type.DECIMALV2,
+                     "14offset_fn_initIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextEPT_")
                 .put(Type.TINYINT,
                      "14offset_fn_initIN8palo_udf10TinyIntValEEEvPNS2_15FunctionContextEPT_")
                 .put(Type.SMALLINT,
@@ -336,6 +356,8 @@ public class FunctionSet {
                      "16offset_fn_updateIN8palo_udf10BooleanValEEEvPNS2_15FunctionContextERKT_RKNS2_9BigIntValES8_PS6_")
                 .put(Type.DECIMAL,
                      "16offset_fn_updateIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextERKT_RKNS2_9BigIntValES8_PS6_")
+                .put(Type.DECIMALV2,
+                     "16offset_fn_updateIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextERKT_RKNS2_9BigIntValES8_PS6_")
                 .put(Type.TINYINT,
                      "16offset_fn_updateIN8palo_udf10TinyIntValEEEvPNS2_15"
                      + "FunctionContextERKT_RKNS2_9BigIntValES8_PS6_")
@@ -371,6 +393,8 @@ public class FunctionSet {
                      "15last_val_updateIN8palo_udf10BooleanValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.DECIMAL,
                      "15last_val_updateIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextERKT_PS6_")
+                .put(Type.DECIMALV2,
+                     "15last_val_updateIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.TINYINT,
                      "15last_val_updateIN8palo_udf10TinyIntValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.SMALLINT,
@@ -403,6 +427,9 @@ public class FunctionSet {
                 .put(Type.DECIMAL,
                      "24first_val_rewrite_updateIN8palo_udf10DecimalValEEEvPNS2_15"
                      + "FunctionContextERKT_RKNS2_9BigIntValEPS6_")
+                .put(Type.DECIMALV2,
+                     "24first_val_rewrite_updateIN8palo_udf12DecimalV2ValEEEvPNS2_15"
+                     + "FunctionContextERKT_RKNS2_9BigIntValEPS6_")
                 .put(Type.TINYINT,
                      "24first_val_rewrite_updateIN8palo_udf10TinyIntValEEEvPNS2_15"
                      + "FunctionContextERKT_RKNS2_9BigIntValEPS6_")
@@ -441,6 +468,8 @@ public class FunctionSet {
                      "15last_val_removeIN8palo_udf10BooleanValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.DECIMAL,
                      "15last_val_removeIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextERKT_PS6_")
+                .put(Type.DECIMALV2,
+                     "15last_val_removeIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.TINYINT,
                      "15last_val_removeIN8palo_udf10TinyIntValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.SMALLINT,
@@ -471,6 +500,8 @@ public class FunctionSet {
                      "16first_val_updateIN8palo_udf10BooleanValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.DECIMAL,
                      "16first_val_updateIN8palo_udf10DecimalValEEEvPNS2_15FunctionContextERKT_PS6_")
+                .put(Type.DECIMALV2,
+                     "16first_val_updateIN8palo_udf12DecimalV2ValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.TINYINT,
                      "16first_val_updateIN8palo_udf10TinyIntValEEEvPNS2_15FunctionContextERKT_PS6_")
                 .put(Type.SMALLINT,
@@ -771,6 +802,18 @@ public class FunctionSet {
                     prefix + "22hll_union_agg_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
                     true, false, true));
 
+            // BITMAP_UNION_INT, exact count distinct of integers
+            if (BITMAP_UNION_INT_UPDATE_SYMBOL.containsKey(t)) {
+                addBuiltin(AggregateFunction.createBuiltin("bitmap_union_int",
+                        Lists.newArrayList(t), Type.BIGINT, Type.VARCHAR,
+                        prefix + "11bitmap_initEPN8palo_udf15FunctionContextEPNS1_9StringValE",
+                        prefix + BITMAP_UNION_INT_UPDATE_SYMBOL.get(t),
+                        prefix + "12bitmap_mergeEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_",
+                        prefix + "16bitmap_serializeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                        prefix + "15bitmap_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                        true, false, true));
+            }
+
             if (STDDEV_UPDATE_SYMBOL.containsKey(t)) {
                 addBuiltin(AggregateFunction.createBuiltin("stddev",
                         Lists.newArrayList(t), Type.DOUBLE, Type.VARCHAR,
@@ -840,6 +883,44 @@ public class FunctionSet {
         }
 
 
+        // BITMAP_UNION_AGG, exact count distinct of serialized bitmaps
+        addBuiltin(AggregateFunction.createBuiltin("bitmap_union_agg",
+                Lists.<Type>newArrayList(Type.VARCHAR), Type.BIGINT, Type.VARCHAR,
+                prefix + "11bitmap_initEPN8palo_udf15FunctionContextEPNS1_9StringValE",
+                prefix + "12bitmap_mergeEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_",
+                prefix + "12bitmap_mergeEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_",
+                prefix + "16bitmap_serializeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                prefix + "15bitmap_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                true, false, true));
+
+        // PERCENTILE_APPROX
+        addBuiltin(AggregateFunction.createBuiltin("percentile_approx",
+                Lists.<Type>newArrayList(Type.DOUBLE, Type.DOUBLE), Type.DOUBLE, Type.VARCHAR,
+                prefix + "22percentile_approx_initEPN8palo_udf15FunctionContextEPNS1_9StringValE",
+                prefix + "24percentile_approx_updateEPN8palo_udf15FunctionContextERKNS1_9DoubleValES6_PNS1_9StringValE",
+                prefix + "23percentile_approx_mergeEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_",
+                prefix + "27percentile_approx_serializeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                prefix + "26percentile_approx_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                false, false, false));
+
+        // TOPN
+        addBuiltin(AggregateFunction.createBuiltin("topn",
+                Lists.<Type>newArrayList(Type.VARCHAR, Type.INT), Type.VARCHAR, Type.VARCHAR,
+                prefix + "9topn_initEPN8palo_udf15FunctionContextEPNS1_9StringValE",
+                prefix + "11topn_updateEPN8palo_udf15FunctionContextERKNS1_9StringValERKNS1_6IntValEPS4_",
+                prefix + "10topn_mergeEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_",
+                prefix + "14topn_serializeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                prefix + "13topn_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                false, false, false));
+        addBuiltin(AggregateFunction.createBuiltin("topn",
+                Lists.<Type>newArrayList(Type.VARCHAR, Type.INT, Type.INT), Type.VARCHAR, Type.VARCHAR,
+                prefix + "9topn_initEPN8palo_udf15FunctionContextEPNS1_9StringValE",
+                prefix + "11topn_updateEPN8palo_udf15FunctionContextERKNS1_9StringValERKNS1_6IntValES9_PS4_",
+                prefix + "10topn_mergeEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_",
+                prefix + "14topn_serializeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                prefix + "13topn_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                false, false, false));
+
         // Sum
         String []sumNames = {"sum", "sum_distinct"};
         for (String name : sumNames) {
@@ -864,6 +945,13 @@ public class FunctionSet {
                     null, null,
                     prefix + "10sum_removeIN8palo_udf10DecimalValES3_EEvPNS2_15FunctionContextERKT_PT0_",
                     null, false, true, false));
+            addBuiltin(AggregateFunction.createBuiltin(name,
+                    Lists.<Type>newArrayList(Type.DECIMALV2), Type.DECIMALV2, Type.DECIMALV2, initNull,
+                    prefix + "3sumIN8palo_udf12DecimalV2ValES3_EEvPNS2_15FunctionContextERKT_PT0_",
+                    prefix + "3sumIN8palo_udf12DecimalV2ValES3_EEvPNS2_15FunctionContextERKT_PT0_",
+                    null, null,
+                    prefix + "10sum_removeIN8palo_udf12DecimalV2ValES3_EEvPNS2_15FunctionContextERKT_PT0_",
+                    null, false, true, false));
             addBuiltin(AggregateFunction.createBuiltin(name,
                     Lists.<Type>newArrayList(Type.LARGEINT), Type.LARGEINT, Type.LARGEINT, initNull,
                     prefix + "3sumIN8palo_udf11LargeIntValES3_EEvPNS2_15FunctionContextERKT_PT0_",
@@ -906,6 +994,16 @@ public class FunctionSet {
                 prefix + "18decimal_avg_removeEPN8palo_udf15FunctionContextERKNS1_10DecimalValEPNS1_9StringValE",
                 prefix + "20decimal_avg_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
                 false, true, false));
+        addBuiltin(AggregateFunction.createBuiltin("avg",
+                Lists.<Type>newArrayList(Type.DECIMALV2), Type.DECIMALV2, Type.VARCHAR,
+                prefix + "18decimalv2_avg_initEPN8palo_udf15FunctionContextEPNS1_9StringValE",
+                prefix + "20decimalv2_avg_updateEPN8palo_udf15FunctionContextERKNS1_12DecimalV2ValEPNS1_9StringValE",
+                prefix + "19decimalv2_avg_mergeEPN8palo_udf15FunctionContextERKNS1_9StringValEPS4_",
+                stringValSerializeOrFinalize,
+                prefix + "23decimalv2_avg_get_valueEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                prefix + "20decimalv2_avg_removeEPN8palo_udf15FunctionContextERKNS1_12DecimalV2ValEPNS1_9StringValE",
+                prefix + "22decimalv2_avg_finalizeEPN8palo_udf15FunctionContextERKNS1_9StringValE",
+                false, true, false));
         // Avg(Timestamp)
         addBuiltin(AggregateFunction.createBuiltin("avg",
                 Lists.<Type>newArrayList(Type.DATE), Type.DATE, Type.VARCHAR,
@@ -53,6 +53,8 @@ public enum PrimitiveType {
     VARCHAR("VARCHAR", 16, TPrimitiveType.VARCHAR),
 
     DECIMAL("DECIMAL", 40, TPrimitiveType.DECIMAL),
+    // 27.9 fixed-point decimal kept as an int128 scaled by 10^9
+    DECIMALV2("DECIMALV2", 16, TPrimitiveType.DECIMALV2),
     
     HLL("HLL", 16, TPrimitiveType.HLL),
     // Unsupported scalar types.
@@ -78,6 +80,7 @@ public enum PrimitiveType {
         builder.put(NULL_TYPE, DATE);
         builder.put(NULL_TYPE, DATETIME);
         builder.put(NULL_TYPE, DECIMAL);
+        builder.put(NULL_TYPE, DECIMALV2);
         builder.put(NULL_TYPE, CHAR);
         builder.put(NULL_TYPE, VARCHAR);
         // Boolean
@@ -225,6 +228,7 @@ public enum PrimitiveType {
         builder.put(VARCHAR, DATE);
         builder.put(VARCHAR, DATETIME);
         builder.put(VARCHAR, DECIMAL);
+        builder.put(VARCHAR, DECIMALV2);
         builder.put(VARCHAR, VARCHAR);
         builder.put(VARCHAR, HLL);
         // Decimal
@@ -237,7 +241,20 @@ public enum PrimitiveType {
         builder.put(DECIMAL, FLOAT);
         builder.put(DECIMAL, DOUBLE);
         builder.put(DECIMAL, DECIMAL);
+        builder.put(DECIMAL, DECIMALV2);
         builder.put(DECIMAL, VARCHAR);
+        // DecimalV2
+        builder.put(DECIMALV2, BOOLEAN);
+        builder.put(DECIMALV2, TINYINT);
+        builder.put(DECIMALV2, SMALLINT);
+        builder.put(DECIMALV2, INT);
+        builder.put(DECIMALV2, BIGINT);
+        builder.put(DECIMALV2, LARGEINT);
+        builder.put(DECIMALV2, FLOAT);
+        builder.put(DECIMALV2, DOUBLE);
+        builder.put(DECIMALV2, DECIMAL);
+        builder.put(DECIMALV2, DECIMALV2);
+        builder.put(DECIMALV2, VARCHAR);
         
         // HLL
         builder.put(HLL, HLL);
@@ -267,6 +284,7 @@ public enum PrimitiveType {
         numericTypes.add(FLOAT);
         numericTypes.add(DOUBLE);
         numericTypes.add(DECIMAL);
+        numericTypes.add(DECIMALV2);
 
         supportedTypes = Lists.newArrayList();
         supportedTypes.add(NULL_TYPE);
@@ -284,6 +302,7 @@ public enum PrimitiveType {
         supportedTypes.add(DATE);
         supportedTypes.add(DATETIME);
         supportedTypes.add(DECIMAL);
+        supportedTypes.add(DECIMALV2);
     }
 
     public static ArrayList<PrimitiveType> getIntegerTypes() {
@@ -334,6 +353,7 @@ public enum PrimitiveType {
         compatibilityMatrix[NULL_TYPE.ordinal()][CHAR.ordinal()] = CHAR;
         compatibilityMatrix[NULL_TYPE.ordinal()][VARCHAR.ordinal()] = VARCHAR;
         compatibilityMatrix[NULL_TYPE.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[NULL_TYPE.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[BOOLEAN.ordinal()][BOOLEAN.ordinal()] = BOOLEAN;
         compatibilityMatrix[BOOLEAN.ordinal()][TINYINT.ordinal()] = TINYINT;
@@ -348,6 +368,7 @@ public enum PrimitiveType {
         compatibilityMatrix[BOOLEAN.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[BOOLEAN.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[BOOLEAN.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[BOOLEAN.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[TINYINT.ordinal()][TINYINT.ordinal()] = TINYINT;
         compatibilityMatrix[TINYINT.ordinal()][SMALLINT.ordinal()] = SMALLINT;
@@ -361,6 +382,7 @@ public enum PrimitiveType {
         compatibilityMatrix[TINYINT.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[TINYINT.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[TINYINT.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[TINYINT.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[SMALLINT.ordinal()][SMALLINT.ordinal()] = SMALLINT;
         compatibilityMatrix[SMALLINT.ordinal()][INT.ordinal()] = INT;
@@ -373,6 +395,7 @@ public enum PrimitiveType {
         compatibilityMatrix[SMALLINT.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[SMALLINT.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[SMALLINT.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[SMALLINT.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[INT.ordinal()][INT.ordinal()] = INT;
         compatibilityMatrix[INT.ordinal()][BIGINT.ordinal()] = BIGINT;
@@ -384,6 +407,7 @@ public enum PrimitiveType {
         compatibilityMatrix[INT.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[INT.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[INT.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[INT.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[BIGINT.ordinal()][BIGINT.ordinal()] = BIGINT;
         compatibilityMatrix[BIGINT.ordinal()][LARGEINT.ordinal()] = LARGEINT;
@@ -394,6 +418,7 @@ public enum PrimitiveType {
         compatibilityMatrix[BIGINT.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[BIGINT.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[BIGINT.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[BIGINT.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[LARGEINT.ordinal()][LARGEINT.ordinal()] = LARGEINT;
         compatibilityMatrix[LARGEINT.ordinal()][FLOAT.ordinal()] = DOUBLE;
@@ -403,6 +428,7 @@ public enum PrimitiveType {
         compatibilityMatrix[LARGEINT.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[LARGEINT.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[LARGEINT.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[LARGEINT.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[FLOAT.ordinal()][FLOAT.ordinal()] = FLOAT;
         compatibilityMatrix[FLOAT.ordinal()][DOUBLE.ordinal()] = DOUBLE;
@@ -411,6 +437,7 @@ public enum PrimitiveType {
         compatibilityMatrix[FLOAT.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[FLOAT.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[FLOAT.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[FLOAT.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[DOUBLE.ordinal()][DOUBLE.ordinal()] = DOUBLE;
         compatibilityMatrix[DOUBLE.ordinal()][DATE.ordinal()] = INVALID_TYPE;
@@ -418,26 +445,34 @@ public enum PrimitiveType {
         compatibilityMatrix[DOUBLE.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[DOUBLE.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[DOUBLE.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[DOUBLE.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
 
         compatibilityMatrix[DATE.ordinal()][DATE.ordinal()] = DATE;
         compatibilityMatrix[DATE.ordinal()][DATETIME.ordinal()] = DATETIME;
         compatibilityMatrix[DATE.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[DATE.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[DATE.ordinal()][DECIMAL.ordinal()] = INVALID_TYPE;
+        compatibilityMatrix[DATE.ordinal()][DECIMALV2.ordinal()] = INVALID_TYPE;
 
         compatibilityMatrix[DATETIME.ordinal()][DATETIME.ordinal()] = DATETIME;
         compatibilityMatrix[DATETIME.ordinal()][CHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[DATETIME.ordinal()][VARCHAR.ordinal()] = INVALID_TYPE;
         compatibilityMatrix[DATETIME.ordinal()][DECIMAL.ordinal()] = INVALID_TYPE;
+        compatibilityMatrix[DATETIME.ordinal()][DECIMALV2.ordinal()] = INVALID_TYPE;
 
         compatibilityMatrix[CHAR.ordinal()][CHAR.ordinal()] = CHAR;
         compatibilityMatrix[CHAR.ordinal()][VARCHAR.ordinal()] = VARCHAR;
         compatibilityMatrix[CHAR.ordinal()][DECIMAL.ordinal()] = INVALID_TYPE;
+        compatibilityMatrix[CHAR.ordinal()][DECIMALV2.ordinal()] = INVALID_TYPE;
 
         compatibilityMatrix[VARCHAR.ordinal()][VARCHAR.ordinal()] = VARCHAR;
         compatibilityMatrix[VARCHAR.ordinal()][DECIMAL.ordinal()] = INVALID_TYPE;
+        compatibilityMatrix[VARCHAR.ordinal()][DECIMALV2.ordinal()] = INVALID_TYPE;
 
         compatibilityMatrix[DECIMAL.ordinal()][DECIMAL.ordinal()] = DECIMAL;
+        compatibilityMatrix[DECIMAL.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
+
+        compatibilityMatrix[DECIMALV2.ordinal()][DECIMALV2.ordinal()] = DECIMALV2;
         
         compatibilityMatrix[HLL.ordinal()][HLL.ordinal()] = HLL;
     }
@@ -569,6 +604,10 @@ public enum PrimitiveType {
         return this == DECIMAL;
     }
 
+    public boolean isDecimalV2Type() {
+        return this == DECIMALV2;
+    }
+
     public PrimitiveType getNumResultType() {
         switch (this) {
             case BOOLEAN:
@@ -588,6 +627,8 @@ public enum PrimitiveType {
                 return DOUBLE;
             case DECIMAL:
                 return DECIMAL;
+            case DECIMALV2:
+                return DECIMALV2;
             case HLL:
                 return HLL;
             default:
@@ -616,6 +657,8 @@ public enum PrimitiveType {
                 return VARCHAR;
             case DECIMAL:
                 return DECIMAL;
+            case DECIMALV2:
+                return DECIMALV2;
             case HLL:
                 return HLL;
             default:
@@ -634,6 +677,8 @@ public enum PrimitiveType {
             return BIGINT;
         } else if (isDecimalType()) {
             return DECIMAL;
+        } else if (isDecimalV2Type()) {
+            return DECIMALV2;
         } else if (isDateType()) {
             return DATETIME;
             // Timestamps get summed as DOUBLE for AVG.
@@ -647,7 +692,7 @@ public enum PrimitiveType {
     }
 
     public boolean isNumericType() {
-        return isFixedPointType() || isFloatingPointType() || isDecimalType();
+        return isFixedPointType() || isFloatingPointType() || isDecimalType() || isDecimalV2Type();
     }
 
     public boolean isValid() {
@@ -698,6 +743,7 @@ public enum PrimitiveType {
                 }
             }
             case DECIMAL:
+            case DECIMALV2:
                 return MysqlColType.MYSQL_TYPE_DECIMAL;
             default:
                 return MysqlColType.MYSQL_TYPE_STRING;
@@ -716,6 +762,7 @@ public enum PrimitiveType {
                 // char index size is length
                 return -1;
             case DECIMAL:
+            case DECIMALV2:
                 return DECIMAL_INDEX_LEN;
             default:
                 return this.getSlotSize();
@@ -738,6 +785,16 @@ public enum PrimitiveType {
         if (t1ResultType == PrimitiveType.BIGINT && t2ResultType == PrimitiveType.BIGINT) {
             return getAssignmentCompatibleType(t1, t2);
         }
+        if ((t1ResultType == PrimitiveType.BIGINT
+                    || t1ResultType == PrimitiveType.DECIMAL
+                    || t1ResultType == PrimitiveType.DECIMALV2)
+                && (t2ResultType == PrimitiveType.BIGINT
+                    || t2ResultType == PrimitiveType.DECIMAL
+                    || t2ResultType == PrimitiveType.DECIMALV2)
+                && (t1ResultType == PrimitiveType.DECIMALV2
+                    || t2ResultType == PrimitiveType.DECIMALV2)) {
+            return PrimitiveType.DECIMALV2;
+        }
         if ((t1ResultType == PrimitiveType.BIGINT
                     || t1ResultType == PrimitiveType.DECIMAL)
                 && (t2ResultType == PrimitiveType.BIGINT
@@ -119,6 +119,7 @@ public class ScalarFunction extends Function {
         // Convert Add(TINYINT, TINYINT) --> Add_TinyIntVal_TinyIntVal
         String beFn = name;
         boolean usesDecimal = false;
+        boolean usesDecimalV2 = false;
         for (int i = 0; i < argTypes.size(); ++i) {
             switch (argTypes.get(i).getPrimitiveType()) {
                 case BOOLEAN:
@@ -158,11 +159,15 @@ public class ScalarFunction extends Function {
                     beFn += "_decimal_val";
                     usesDecimal = true;
                     break;
+                case DECIMALV2:
+                    beFn += "_decimalv2_val";
+                    usesDecimalV2 = true;
+                    break;
                 default:
                     Preconditions.checkState(false, "Argument type not supported: " + argTypes.get(i));
             }
         }
-        String beClass = usesDecimal ? "DecimalOperators" : "Operators";
+        String beClass = usesDecimalV2 ? "DecimalV2Operators" : usesDecimal ? "DecimalOperators" : "Operators";
         String symbol = "palo::" + beClass + "::" + beFn;
         return createBuiltinOperator(name, symbol, argTypes, retType);
     }
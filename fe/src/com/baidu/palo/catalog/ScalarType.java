@@ -77,12 +77,17 @@ public class ScalarType extends Type {
     public static final int MAX_PRECISION = 38;
     public static final int MAX_SCALE = MAX_PRECISION;
 
+    // DECIMALV2 keeps 9 fraction digits, and its integer part is stored as
+    // int64 by olap engine, so at most 18 integer digits are allowed.
+    public static final int MAX_DECIMALV2_PRECISION = 27;
+    public static final int MAX_DECIMALV2_SCALE = 9;
+
     private final PrimitiveType type;
 
     // Only used for type CHAR.
     private int len;
 
-    // Only used if type is DECIMAL. -1 (for both) is used to represent a
+    // Only used if type is DECIMAL or DECIMALV2. -1 (for both) is used to represent a
     // decimal with any precision and scale.
     // It is invalid to have one by -1 and not the other.
     // TODO: we could use that to store DECIMAL(8,*), indicating a decimal
@@ -126,6 +131,8 @@ public class ScalarType extends Type {
                 return DATETIME;
             case DECIMAL:
                 return (ScalarType) createDecimalType();
+            case DECIMALV2:
+                return DEFAULT_DECIMALV2;
             case LARGEINT:
                 return LARGEINT;
             default:
@@ -158,6 +165,15 @@ public class ScalarType extends Type {
         return type;
     }
 
+    public static ScalarType createDecimalV2Type(int precision, int scale) {
+        Preconditions.checkState(precision >= 0); // Enforced by parser
+        Preconditions.checkState(scale >= 0); // Enforced by parser.
+        ScalarType type = new ScalarType(PrimitiveType.DECIMALV2);
+        type.precision = precision;
+        type.scale = scale;
+        return type;
+    }
+
     // Identical to createDecimalType except that higher precisions are truncated
     // to the max storable precision. The BE will report overflow in these cases
     // (think of this as adding ints to BIGINT but BIGINT can still overflow).
@@ -197,6 +213,8 @@ public class ScalarType extends Type {
                 return "DECIMAL(*,*)";
             }
             return "DECIMAL(" + precision + "," + scale + ")";
+        } else if (type == PrimitiveType.DECIMALV2) {
+            return "DECIMALV2(" + precision + "," + scale + ")";
         } else if (type == PrimitiveType.VARCHAR) {
             if (isWildcardVarchar()) {
                 return "VARCHAR(*)";
@@ -216,6 +234,7 @@ public class ScalarType extends Type {
             case HLL:
                 return type.toString() + "(" + len + ")";
             case DECIMAL:
+            case DECIMALV2:
                 return String.format("%s(%s,%s)", type.toString(), precision, scale);
             default: return type.toString();
         }
@@ -241,7 +260,8 @@ public class ScalarType extends Type {
                 node.setScalar_type(scalarType);
                 break;
             }
-            case DECIMAL: {
+            case DECIMAL:
+            case DECIMALV2: {
                 node.setType(TTypeNodeType.SCALAR);
                 TScalarType scalarType = new TScalarType();
                 scalarType.setType(type.toThrift());
@@ -269,12 +289,12 @@ public class ScalarType extends Type {
     }
 
     public int decimalPrecision() {
-        Preconditions.checkState(type == PrimitiveType.DECIMAL);
+        Preconditions.checkState(type == PrimitiveType.DECIMAL || type == PrimitiveType.DECIMALV2);
         return precision;
     }
 
     public int decimalScale() {
-        Preconditions.checkState(type == PrimitiveType.DECIMAL);
+        Preconditions.checkState(type == PrimitiveType.DECIMAL || type == PrimitiveType.DECIMALV2);
         return scale;
     }
 
@@ -317,7 +337,8 @@ public class ScalarType extends Type {
                 || type == PrimitiveType.BIGINT || type == PrimitiveType.FLOAT
                 || type == PrimitiveType.DOUBLE || type == PrimitiveType.DATE
                 || type == PrimitiveType.DATETIME
-                || type == PrimitiveType.CHAR || type == PrimitiveType.DECIMAL;
+                || type == PrimitiveType.CHAR || type == PrimitiveType.DECIMAL
+                || type == PrimitiveType.DECIMALV2;
     }
 
     @Override
@@ -381,6 +402,9 @@ public class ScalarType extends Type {
         if (isDecimal() && scalarType.isDecimal()) {
             return true;
         }
+        if (isDecimalV2() && scalarType.isDecimalV2()) {
+            return true;
+        }
         return false;
     }
 
@@ -399,7 +423,7 @@ public class ScalarType extends Type {
         if (type == PrimitiveType.VARCHAR) {
             return len == other.len;
         }
-        if (type == PrimitiveType.DECIMAL) {
+        if (type == PrimitiveType.DECIMAL || type == PrimitiveType.DECIMALV2) {
             return precision == other.precision && scale == other.scale;
         }
         return true;
@@ -415,6 +439,8 @@ public class ScalarType extends Type {
             return ScalarType.NULL;
         } else if (isDecimal()) {
             return createDecimalTypeInternal(MAX_PRECISION, scale);
+        } else if (isDecimalV2()) {
+            return DEFAULT_DECIMALV2;
         } else if (isLargeIntType()) {
         return ScalarType.LARGEINT;
         } else {
@@ -428,6 +454,8 @@ public class ScalarType extends Type {
             return this;
         } else if (type == PrimitiveType.DECIMAL) {
             return createDecimalTypeInternal(MAX_PRECISION, scale);
+        } else if (type == PrimitiveType.DECIMALV2) {
+            return DEFAULT_DECIMALV2;
         }
         return createType(PrimitiveType.values()[type.ordinal() + 1]);
     }
@@ -518,6 +546,10 @@ public class ScalarType extends Type {
             return INVALID;
         }
 
+        if (t1.isDecimalV2() || t2.isDecimalV2()) {
+            return DECIMALV2;
+        }
+
         if (t1.isDecimal() || t2.isDecimal()) {
             return DECIMAL;
 //            // The case of decimal and float/double must be handled carefully. There are two
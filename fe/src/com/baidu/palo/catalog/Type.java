@@ -69,6 +69,10 @@ public abstract class Type {
                     ScalarType.DEFAULT_SCALE);
     public static final ScalarType DECIMAL = DEFAULT_DECIMAL;
            // (ScalarType) ScalarType.createDecimalTypeInternal(-1, -1);
+    public static final ScalarType DEFAULT_DECIMALV2 = (ScalarType)
+            ScalarType.createDecimalV2Type(ScalarType.MAX_DECIMALV2_PRECISION,
+                    ScalarType.MAX_DECIMALV2_SCALE);
+    public static final ScalarType DECIMALV2 = DEFAULT_DECIMALV2;
     public static final ScalarType DEFAULT_VARCHAR = ScalarType.createVarcharType(-1);
     public static final ScalarType VARCHAR = ScalarType.createVarcharType(-1);
     public static final ScalarType HLL = ScalarType.createHllType();
@@ -95,6 +99,7 @@ public abstract class Type {
         numericTypes.add(FLOAT);
         numericTypes.add(DOUBLE);
         numericTypes.add(DECIMAL);
+        numericTypes.add(DECIMALV2);
 
         supportedTypes = Lists.newArrayList();
         supportedTypes.add(NULL);
@@ -112,6 +117,7 @@ public abstract class Type {
         supportedTypes.add(DATE);
         supportedTypes.add(DATETIME);
         supportedTypes.add(DECIMAL);
+        supportedTypes.add(DECIMALV2);
     }
 
     public static ArrayList<ScalarType> getIntegerTypes() {
@@ -167,6 +173,10 @@ public abstract class Type {
         return isScalarType(PrimitiveType.DECIMAL);
     }
 
+    public boolean isDecimalV2() {
+        return isScalarType(PrimitiveType.DECIMALV2);
+    }
+
     public boolean isDecimalOrNull() { return isDecimal() || isNull(); }
     public boolean isFullySpecifiedDecimal() { return false; }
     public boolean isWildcardDecimal() { return false; }
@@ -214,7 +224,7 @@ public abstract class Type {
     }
 
     public boolean isNumericType() {
-        return isFixedPointType() || isFloatingPointType() || isDecimal();
+        return isFixedPointType() || isFloatingPointType() || isDecimal() || isDecimalV2();
     }
 
     public boolean isNativeType() {
@@ -450,6 +460,8 @@ public abstract class Type {
                 return Type.DATETIME;
             case DECIMAL:
                 return Type.DECIMAL;
+            case DECIMALV2:
+                return Type.DECIMALV2;
             case CHAR:
                 return Type.CHAR;
             case VARCHAR:
@@ -505,6 +517,11 @@ public abstract class Type {
                             && scalarType.isSetPrecision());
                     type = ScalarType.createDecimalType(scalarType.getPrecision(),
                             scalarType.getScale());
+                } else if (scalarType.getType() == TPrimitiveType.DECIMALV2) {
+                    Preconditions.checkState(scalarType.isSetPrecision()
+                            && scalarType.isSetScale());
+                    type = ScalarType.createDecimalV2Type(scalarType.getPrecision(),
+                            scalarType.getScale());
                 } else {
                     type = ScalarType.createType(
                             PrimitiveType.fromThrift(scalarType.getType()));
@@ -605,6 +622,7 @@ public abstract class Type {
             case DOUBLE:
                 return 15;
             case DECIMAL:
+            case DECIMALV2:
                 return t.decimalPrecision();
             default:
                 return null;
@@ -632,6 +650,7 @@ public abstract class Type {
             case DOUBLE:
                 return 15;
             case DECIMAL:
+            case DECIMALV2:
                 return t.decimalScale();
             default:
                 return null;
@@ -661,6 +680,7 @@ public abstract class Type {
             case FLOAT:
             case DOUBLE:
             case DECIMAL:
+            case DECIMALV2:
                 return 10;
             default:
                 // everything else (including boolean and string) is null
@@ -786,6 +806,7 @@ public abstract class Type {
         compatibilityMatrix[LARGEINT.ordinal()][CHAR.ordinal()] = PrimitiveType.INVALID_TYPE;
         compatibilityMatrix[LARGEINT.ordinal()][VARCHAR.ordinal()] = PrimitiveType.INVALID_TYPE;
         compatibilityMatrix[LARGEINT.ordinal()][DECIMAL.ordinal()] = PrimitiveType.DECIMAL;
+        compatibilityMatrix[LARGEINT.ordinal()][DECIMALV2.ordinal()] = PrimitiveType.DECIMALV2;
         compatibilityMatrix[LARGEINT.ordinal()][HLL.ordinal()] = PrimitiveType.INVALID_TYPE;
 
         compatibilityMatrix[FLOAT.ordinal()][DOUBLE.ordinal()] = PrimitiveType.DOUBLE;
@@ -827,11 +848,12 @@ public abstract class Type {
             for (int j = i; j < PrimitiveType.values().length - 1; ++j) {
                 PrimitiveType t1 = PrimitiveType.values()[i];
                 PrimitiveType t2 = PrimitiveType.values()[j];
-                // DECIMAL, NULL, and INVALID_TYPE  are handled separately.
+                // DECIMAL, DECIMALV2, NULL, and INVALID_TYPE  are handled separately.
                 if (t1 == PrimitiveType.INVALID_TYPE ||
                         t2 == PrimitiveType.INVALID_TYPE) continue;
                 if (t1 == PrimitiveType.NULL_TYPE || t2 == PrimitiveType.NULL_TYPE) continue;
                 if (t1 == PrimitiveType.DECIMAL || t2 == PrimitiveType.DECIMAL) continue;
+                if (t1 == PrimitiveType.DECIMALV2 || t2 == PrimitiveType.DECIMALV2) continue;
                 Preconditions.checkNotNull(compatibilityMatrix[i][j]);
             }
         }
@@ -859,6 +881,8 @@ public abstract class Type {
                 return VARCHAR;
             case DECIMAL:
                 return DECIMAL;
+            case DECIMALV2:
+                return DECIMALV2;
             default:
                 return INVALID;
 
@@ -876,6 +900,16 @@ public abstract class Type {
         if (t1ResultType == PrimitiveType.BIGINT && t2ResultType == PrimitiveType.BIGINT) {
             return getAssignmentCompatibleType(t1, t2, false);
         }
+        if ((t1ResultType == PrimitiveType.BIGINT
+                || t1ResultType == PrimitiveType.DECIMAL
+                || t1ResultType == PrimitiveType.DECIMALV2)
+                && (t2ResultType == PrimitiveType.BIGINT
+                || t2ResultType == PrimitiveType.DECIMAL
+                || t2ResultType == PrimitiveType.DECIMALV2)
+                && (t1ResultType == PrimitiveType.DECIMALV2
+                || t2ResultType == PrimitiveType.DECIMALV2)) {
+            return Type.DECIMALV2;
+        }
         if ((t1ResultType == PrimitiveType.BIGINT
                 || t1ResultType == PrimitiveType.DECIMAL)
                 && (t2ResultType == PrimitiveType.BIGINT
@@ -916,6 +950,8 @@ public abstract class Type {
                 return Type.DOUBLE;
             case DECIMAL:
                 return Type.DECIMAL;
+            case DECIMALV2:
+                return Type.DECIMALV2;
             default:
                 return Type.INVALID;
 
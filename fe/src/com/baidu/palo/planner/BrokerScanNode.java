@@ -330,11 +330,21 @@ public class BrokerScanNode extends ScanNode {
         TupleDescriptor srcTupleDesc = analyzer.getDescTbl().createTupleDescriptor();
         context.tupleDescriptor = srcTupleDesc;
 
+        // Values in columnar files are typed, they are read into slots of
+        // column's type directly instead of being parsed from string
+        boolean isTypedSource = isColumnarFileGroup(fileGroup);
+
         Map<String, SlotDescriptor> slotDescByName = Maps.newHashMap();
         context.slotDescByName = slotDescByName;
         for (String value : valueNames) {
             SlotDescriptor slotDesc = analyzer.getDescTbl().addSlotDescriptor(srcTupleDesc);
             slotDesc.setType(ScalarType.createType(PrimitiveType.VARCHAR));
+            if (isTypedSource) {
+                Column column = targetTable.getColumn(value);
+                if (column != null && isTypedSourceType(column.getDataType())) {
+                    slotDesc.setType(ScalarType.createType(column.getDataType()));
+                }
+            }
             slotDesc.setIsMaterialized(true);
             slotDesc.setIsNullable(false);
             slotDescByName.put(value, slotDesc);
@@ -532,9 +542,41 @@ public class BrokerScanNode extends ScanNode {
         Collections.shuffle(backends, random);
     }
 
+    private boolean isColumnarFileGroup(BrokerFileGroup fileGroup) {
+        List<String> filePathes = fileGroup.getFilePathes();
+        if (filePathes == null || filePathes.isEmpty()) {
+            return false;
+        }
+        for (String path : filePathes) {
+            if (formatType(path) != TFileFormatType.FORMAT_ARROW_STREAM) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Types which can be read from columnar file without conversion
+    private boolean isTypedSourceType(PrimitiveType type) {
+        switch (type) {
+            case TINYINT:
+            case SMALLINT:
+            case INT:
+            case BIGINT:
+            case FLOAT:
+            case DOUBLE:
+            case DATE:
+            case DATETIME:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     private TFileFormatType formatType(String path) {
         String lowerCasePath = path.toLowerCase();
-        if (lowerCasePath.endsWith(".gz")) {
+        if (lowerCasePath.endsWith(".arrow")) {
+            return TFileFormatType.FORMAT_ARROW_STREAM;
+        } else if (lowerCasePath.endsWith(".gz")) {
             return TFileFormatType.FORMAT_CSV_GZ;
         } else if (lowerCasePath.endsWith(".bz2")) {
             return TFileFormatType.FORMAT_CSV_BZ2;
@@ -571,6 +571,14 @@ public class SingleNodePlanner {
                             break;
                         }
                     } else if (aggExpr.getFnName().getFunction().equalsIgnoreCase("HLL_UNION_AGG")) {
+                    } else if (aggExpr.getFnName().getFunction().equalsIgnoreCase("BITMAP_UNION_AGG")) {
+                        if (col.getAggregationType() != AggregateType.BITMAP_UNION) {
+                            LOG.info(
+                                    logStr + "Aggregate Operator not match: BITMAP_UNION_AGG <--> " + col
+                                            .getAggregationType());
+                            returnColumnValidate = false;
+                            break;
+                        }
                     } else if (aggExpr.getFnName().getFunction().equalsIgnoreCase("NDV")) {
                         if ((!col.isKey())) {
                             returnColumnValidate = false;
@@ -519,6 +519,8 @@ public class HadoopLoadPendingTask extends LoadPendingTask {
                     columnType = "HLL";
                     break;
                 case DECIMAL:
+                case DECIMALV2:
+                    // DECIMALV2 shares the decimal12_t storage layout with DECIMAL
                     columnType = "DECIMAL";
                     break;
                 default:
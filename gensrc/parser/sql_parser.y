@@ -194,11 +194,11 @@ parser code {:
 
 // Total keywords of palo
 terminal String KW_ADD, KW_AFTER, KW_AGGREGATE, KW_ALL, KW_ALTER, KW_AND, KW_ANTI, KW_AS, KW_ASC, KW_AUTHORS, 
-    KW_BACKEND, KW_BACKUP, KW_BETWEEN, KW_BEGIN, KW_BIGINT, KW_BOOLEAN, KW_BOTH, KW_BROKER, KW_BACKENDS, KW_BY,
+    KW_BACKEND, KW_BACKUP, KW_BETWEEN, KW_BEGIN, KW_BIGINT, KW_BITMAP_UNION, KW_BOOLEAN, KW_BOTH, KW_BROKER, KW_BACKENDS, KW_BY,
     KW_CANCEL, KW_CASE, KW_CAST, KW_CHAIN, KW_CHAR, KW_CHARSET, KW_CLUSTER, KW_CLUSTERS,
     KW_COLLATE, KW_COLLATION, KW_COLUMN, KW_COLUMNS, KW_COMMENT, KW_COMMIT, KW_COMMITTED,
     KW_CONNECTION, KW_CONNECTION_ID, KW_CONSISTENT, KW_COUNT, KW_CREATE, KW_CROSS, KW_CURRENT, KW_CURRENT_USER,
-    KW_DATA, KW_DATABASE, KW_DATABASES, KW_DATE, KW_DATETIME, KW_DECIMAL, KW_DECOMMISSION, KW_DEFAULT, KW_DESC, KW_DESCRIBE,
+    KW_DATA, KW_DATABASE, KW_DATABASES, KW_DATE, KW_DATETIME, KW_DECIMAL, KW_DECIMALV2, KW_DECOMMISSION, KW_DEFAULT, KW_DESC, KW_DESCRIBE,
     KW_DELETE, KW_DISTINCT, KW_DISTINCTPC, KW_DISTINCTPCSA, KW_DISTRIBUTED, KW_BUCKETS, KW_DIV, KW_DOUBLE, KW_DROP, KW_DROPP, KW_DUPLICATE,
     KW_ELSE, KW_END, KW_ENGINE, KW_ENGINES, KW_ENTER, KW_ERRORS, KW_EVENTS, KW_EXISTS, KW_EXPORT, KW_EXTERNAL, KW_EXTRACT,
     KW_FALSE, KW_FOLLOWER, KW_FOLLOWING, KW_FREE, KW_FROM, KW_FIRST, KW_FLOAT, KW_FOR, KW_FULL, KW_FUNCTION,
@@ -1111,6 +1111,10 @@ opt_agg_type ::=
     {:
     RESULT = AggregateType.HLL_UNION;
     :}
+    | KW_BITMAP_UNION
+    {:
+    RESULT = AggregateType.BITMAP_UNION;
+    :}
     ;
 
 opt_partition ::=
@@ -1343,6 +1347,14 @@ column_type ::=
     {:
         RESULT = ColumnType.createDecimal(precision.intValue(), scale.intValue());
     :}
+    | KW_DECIMALV2
+    {:
+        RESULT = ColumnType.createDecimalV2(27, 9);
+    :}
+    | KW_DECIMALV2 LPAREN INTEGER_LITERAL:precision COMMA INTEGER_LITERAL:scale RPAREN
+    {:
+        RESULT = ColumnType.createDecimalV2(precision.intValue(), scale.intValue());
+    :}
     | KW_DATE
     {:
         RESULT = ColumnType.createType(PrimitiveType.DATE);
@@ -3304,6 +3316,8 @@ primitive_type ::=
   {: RESULT = PrimitiveType.DATETIME; :}
   | KW_DECIMAL
   {: RESULT = PrimitiveType.DECIMAL; :}
+  | KW_DECIMALV2
+  {: RESULT = PrimitiveType.DECIMALV2; :}
   | KW_HLL
   {: RESULT = PrimitiveType.HLL; :} 
   ;
@@ -116,6 +116,7 @@ cc_registry_preamble = '\
 #include "exprs/json_functions.h"\n\
 #include "exprs/encryption_functions.h"\n\
 #include "exprs/hll_hash_function.h"\n\
+#include "exprs/bitmap_function.h"\n\
 \n\
 using namespace boost::posix_time;\n\
 using namespace boost::gregorian;\n\
@@ -206,7 +206,11 @@ visible_functions = [
         '15FunctionContextERKNS1_9StringValES6_'],
     [['date_format'], 'VARCHAR', ['DATETIME', 'VARCHAR'],
         '_ZN4palo18TimestampFunctions11date_formatEPN8palo_udf'
-        '15FunctionContextERKNS1_11DateTimeValERKNS1_9StringValE'],
+        '15FunctionContextERKNS1_11DateTimeValERKNS1_9StringValE',
+        '_ZN4palo18TimestampFunctions19date_format_prepareEPN8palo_udf'
+        '15FunctionContextENS2_18FunctionStateScopeE',
+        '_ZN4palo18TimestampFunctions17date_format_closeEPN8palo_udf'
+        '15FunctionContextENS2_18FunctionStateScopeE'],
     [['date', 'to_date'], 'DATE', ['DATETIME'], 
         '_ZN4palo18TimestampFunctions7to_dateEPN8palo_udf15FunctionContextERKNS1_11DateTimeValE'],
 
@@ -324,6 +328,9 @@ visible_functions = [
     [['mod'], 'DECIMAL', ['DECIMAL', 'DECIMAL'], 
             '_ZN4palo16DecimalOperators27mod_decimal_val_decimal_valEPN8palo_udf'
             '15FunctionContextERKNS1_10DecimalValES6_'],
+    [['mod'], 'DECIMALV2', ['DECIMALV2', 'DECIMALV2'],
+            '_ZN4palo18DecimalV2Operators31mod_decimalv2_val_decimalv2_valEPN8palo_udf'
+            '15FunctionContextERKNS1_12DecimalV2ValES6_'],
     [['mod', 'fmod'], 'FLOAT', ['FLOAT', 'FLOAT'], 
         '_ZN4palo13MathFunctions10fmod_floatEPN8palo_udf15FunctionContextERKNS1_8FloatValES6_'],
     [['mod', 'fmod'], 'DOUBLE', ['DOUBLE', 'DOUBLE'], 
@@ -404,6 +411,7 @@ visible_functions = [
     [['if'], 'VARCHAR', ['BOOLEAN', 'VARCHAR', 'VARCHAR'], ''],
     [['if'], 'DATETIME', ['BOOLEAN', 'DATETIME', 'DATETIME'], ''],
     [['if'], 'DECIMAL', ['BOOLEAN', 'DECIMAL', 'DECIMAL'], ''],
+    [['if'], 'DECIMALV2', ['BOOLEAN', 'DECIMALV2', 'DECIMALV2'], ''],
 
     [['nullif'], 'BOOLEAN', ['BOOLEAN', 'BOOLEAN'], ''],
     [['nullif'], 'TINYINT', ['TINYINT', 'TINYINT'], ''],
@@ -416,6 +424,7 @@ visible_functions = [
     [['nullif'], 'VARCHAR', ['VARCHAR', 'VARCHAR'], ''],
     [['nullif'], 'DATETIME', ['DATETIME', 'DATETIME'], ''],
     [['nullif'], 'DECIMAL', ['DECIMAL', 'DECIMAL'], ''],
+    [['nullif'], 'DECIMALV2', ['DECIMALV2', 'DECIMALV2'], ''],
 
     [['ifnull'], 'BOOLEAN', ['BOOLEAN', 'BOOLEAN'], ''],
     [['ifnull'], 'TINYINT', ['TINYINT', 'TINYINT'], ''],
@@ -428,6 +437,7 @@ visible_functions = [
     [['ifnull'], 'VARCHAR', ['VARCHAR', 'VARCHAR'], ''],
     [['ifnull'], 'DATETIME', ['DATETIME', 'DATETIME'], ''],
     [['ifnull'], 'DECIMAL', ['DECIMAL', 'DECIMAL'], ''],
+    [['ifnull'], 'DECIMALV2', ['DECIMALV2', 'DECIMALV2'], ''],
 
     [['coalesce'], 'BOOLEAN', ['BOOLEAN', '...'], ''],
     [['coalesce'], 'TINYINT', ['TINYINT', '...'], ''],
@@ -440,6 +450,7 @@ visible_functions = [
     [['coalesce'], 'VARCHAR', ['VARCHAR', '...'], ''],
     [['coalesce'], 'DATETIME', ['DATETIME', '...'], ''],
     [['coalesce'], 'DECIMAL', ['DECIMAL', '...'], ''],
+    [['coalesce'], 'DECIMALV2', ['DECIMALV2', '...'], ''],
 
     # String builtin functions
     [['substr', 'substring'], 'VARCHAR', ['VARCHAR', 'INT'],
@@ -467,6 +478,8 @@ visible_functions = [
             '15FunctionContextERKNS1_9StringValERKNS1_6IntValES6_'],
     [['length'], 'INT', ['VARCHAR'], 
             '_ZN4palo15StringFunctions6lengthEPN8palo_udf15FunctionContextERKNS1_9StringValE'],
+    [['char_length', 'character_length'], 'INT', ['VARCHAR'],
+            '_ZN4palo15StringFunctions11char_lengthEPN8palo_udf15FunctionContextERKNS1_9StringValE'],
     [['lower', 'lcase'], 'VARCHAR', ['VARCHAR'], 
             '_ZN4palo15StringFunctions5lowerEPN8palo_udf15FunctionContextERKNS1_9StringValE'],
     [['upper', 'ucase'], 'VARCHAR', ['VARCHAR'],
@@ -547,6 +560,12 @@ visible_functions = [
         '15FunctionContextERKNS1_9StringValE'],
     [['hll_hash'], 'VARCHAR', ['VARCHAR'],
         '_ZN4palo16HllHashFunctions8hll_hashEPN8palo_udf15FunctionContextERKNS1_9StringValE'],
+
+    #bitmap function
+    [['to_bitmap'], 'VARCHAR', ['BIGINT'],
+        '_ZN4palo15BitmapFunctions9to_bitmapEPN8palo_udf15FunctionContextERKNS1_9BigIntValE'],
+    [['bitmap_count'], 'BIGINT', ['VARCHAR'],
+        '_ZN4palo15BitmapFunctions12bitmap_countEPN8palo_udf15FunctionContextERKNS1_9StringValE'],
     
     # aes and base64 function
     [['from_base64'], 'VARCHAR', ['VARCHAR'],
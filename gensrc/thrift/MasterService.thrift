@@ -34,6 +34,8 @@ struct TTabletInfo {
     5: required Types.TCount row_count
     6: required Types.TSize data_size
     7: optional Types.TStorageMedium storage_medium
+    // percentage of history data converted, only set when tablet is being altered
+    8: optional i32 alter_progress
 }
 
 struct TFinishTaskRequest {
@@ -95,7 +95,9 @@ enum TFileFormatType {
     FORMAT_CSV_LZO,
     FORMAT_CSV_BZ2,
     FORMAT_CSV_LZ4FRAME,
-    FORMAT_CSV_LZOP
+    FORMAT_CSV_LZOP,
+    // Apache Arrow IPC stream format
+    FORMAT_ARROW_STREAM
 }
 
 // One broker range information.
@@ -70,6 +70,7 @@ enum TPrimitiveType {
   LARGEINT,
   VARCHAR,
   HLL,
+  DECIMALV2,
 }
 
 enum TTypeNodeType {
@@ -125,7 +126,8 @@ enum TAggregationType {
     MIN,
     REPLACE,
     HLL_UNION,
-    NONE
+    NONE,
+    BITMAP_UNION
 }
 
 enum TPushType {
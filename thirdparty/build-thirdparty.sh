@@ -461,6 +461,26 @@ build_brpc() {
     make -j$PARALLEL && make install
 }
 
+# arrow
+build_arrow() {
+    check_if_source_exist $ARROW_SOURCE
+    if [ ! -f $CMAKE_CMD ]; then
+        echo "cmake executable does not exit"
+        exit 1
+    fi
+
+    cd $TP_SOURCE_DIR/$ARROW_SOURCE/cpp
+    mkdir build -p && cd build
+    rm -rf CMakeCache.txt CMakeFiles/
+    BOOST_ROOT=$TP_INSTALL_DIR \
+    $CMAKE_CMD -DCMAKE_INSTALL_PREFIX=$TP_INSTALL_DIR -DCMAKE_INSTALL_LIBDIR=lib \
+    -DARROW_BUILD_SHARED=OFF -DARROW_BUILD_TESTS=OFF -DARROW_BUILD_BENCHMARKS=OFF \
+    -DARROW_BOOST_USE_SHARED=OFF -DARROW_JEMALLOC=OFF -DARROW_IPC=ON \
+    -DARROW_COMPUTE=OFF -DARROW_PYTHON=OFF -DARROW_WITH_BROTLI=OFF -DARROW_WITH_ZSTD=OFF \
+    -DCMAKE_POSITION_INDEPENDENT_CODE=ON ..
+    make -j$PARALLEL && make install
+}
+
 build_libevent
 build_openssl
 build_zlib
@@ -483,5 +503,6 @@ build_mysql
 build_thrift
 build_leveldb
 build_brpc
+build_arrow
 
 echo "Finihsed to build all thirdparties"